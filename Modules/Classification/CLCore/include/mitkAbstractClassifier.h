@@ -49,6 +49,28 @@ public:
   ///
   virtual Eigen::MatrixXi Predict(const Eigen::MatrixXd &X) = 0;
 
+  ///
+  /// @brief Predict class for X, processing the samples in blocks.
+  /// Classifiers that support it evaluate a block of samples at once in a cache friendly way.
+  /// The results are the same as for Predict(). The default implementation simply calls Predict().
+  /// @param X The input samples.
+  /// @param blockSize Number of samples that are processed together.
+  /// @return The predicted classes. Y matrix of shape = [n_samples, 1]
+  ///
+  virtual Eigen::MatrixXi PredictBlocked(const Eigen::MatrixXd &X, unsigned int /*blockSize*/ = 256)
+  {
+    return this->Predict(X);
+  }
+
+  ///
+  /// @brief SupportsBlockedPrediction
+  /// @return True if the classifier has a dedicated implementation of PredictBlocked.
+  ///
+  virtual bool SupportsBlockedPrediction()
+  {
+    return false;
+  }
+
   ///
   /// @brief GetPointWiseWeightCopy
   /// @return return label matrix of shape = [n_samples , 1]
@@ -173,7 +173,7 @@ int main(int argc, char* argv[])
       time(&lastTimePoint);
 
       MITK_INFO << "Predict Test Data";
-      auto testDataNewY = forest->Predict(testDataX);
+      auto testDataNewY = forest->PredictBlocked(testDataX);
       auto testDataNewProb = forest->GetPointWiseProbabilities();
 
       auto maxClassValue = testDataNewProb.cols();
@@ -334,7 +334,7 @@ int main(int argc, char* argv[])
     // If required do test
     //////////////////////////////////////////////////////////////////////////////
     auto testDataX = mitk::DCUtilities::DC3dDToMatrixXd(testCollection,modalities, testMask);
-    auto testDataNewY = forest->Predict(testDataX);
+    auto testDataNewY = forest->PredictBlocked(testDataX);
     auto testDataNewProb = forest->GetPointWiseProbabilities();
     //MITK_INFO << testDataNewY;
 
@@ -359,7 +359,7 @@ int main(int argc, char* argv[])
     auto testDataX = mitk::DCUtilities::DC3dDToMatrixXd(testCollection,modalities, testMask);
 
     MITK_INFO << "Predict Test Data";
-    auto testDataNewY = forest->Predict(testDataX);
+    auto testDataNewY = forest->PredictBlocked(testDataX);
     auto testDataNewProb = forest->GetPointWiseProbabilities();
     //MITK_INFO << testDataNewY;
 
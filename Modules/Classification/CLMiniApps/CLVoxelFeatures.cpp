@@ -29,6 +29,13 @@ found in the LICENSE file.
 #include <itkMultiHistogramFilter.h>
 #include <itkSubtractImageFilter.h>
 #include <itkLocalStatisticFilter.h>
+#include <mitkCLSlabProcessing.h>
+#include <itkImageFileWriter.h>
+#include <itkImageIOFactory.h>
+#include <itkImageIORegion.h>
+#include <itkImageAlgorithm.h>
+
+#include <functional>
 
 static std::vector<double> splitDouble(std::string str, char delimiter) {
   std::vector<double> internal;
@@ -81,8 +88,8 @@ namespace Functor
 }
 
 template<typename TPixel, unsigned int VImageDimension>
-void
-  GaussianFilter(itk::Image<TPixel, VImageDimension>* itkImage, double variance, mitk::Image::Pointer &output)
+typename itk::Image<TPixel, VImageDimension>::Pointer
+  ComputeGaussian(itk::Image<TPixel, VImageDimension>* itkImage, double variance)
 {
   typedef itk::Image<TPixel, VImageDimension> ImageType;
   typedef itk::DiscreteGaussianImageFilter< ImageType, ImageType >  GaussFilterType;
@@ -91,12 +98,12 @@ void
   gaussianFilter->SetInput( itkImage );
   gaussianFilter->SetVariance(variance);
   gaussianFilter->Update();
-  mitk::CastToMitkImage(gaussianFilter->GetOutput(), output);
+  return gaussianFilter->GetOutput();
 }
 
 template<typename TPixel, unsigned int VImageDimension>
-void
-  DifferenceOfGaussFilter(itk::Image<TPixel, VImageDimension>* itkImage, double variance, mitk::Image::Pointer &output)
+typename itk::Image<TPixel, VImageDimension>::Pointer
+  ComputeDifferenceOfGauss(itk::Image<TPixel, VImageDimension>* itkImage, double variance)
 {
   typedef itk::Image<TPixel, VImageDimension> ImageType;
   typedef itk::DiscreteGaussianImageFilter< ImageType, ImageType >  GaussFilterType;
@@ -114,12 +121,12 @@ void
   subFilter->SetInput1(gaussianFilter1->GetOutput());
   subFilter->SetInput2(gaussianFilter2->GetOutput());
   subFilter->Update();
-  mitk::CastToMitkImage(subFilter->GetOutput(), output);
+  return subFilter->GetOutput();
 }
 
 template<typename TPixel, unsigned int VImageDimension>
-void
-  LaplacianOfGaussianFilter(itk::Image<TPixel, VImageDimension>* itkImage, double variance, mitk::Image::Pointer &output)
+typename itk::Image<TPixel, VImageDimension>::Pointer
+  ComputeLaplacianOfGaussian(itk::Image<TPixel, VImageDimension>* itkImage, double variance)
 {
   typedef itk::Image<TPixel, VImageDimension> ImageType;
   typedef itk::DiscreteGaussianImageFilter< ImageType, ImageType >  GaussFilterType;
@@ -132,12 +139,12 @@ void
   typename LaplacianFilter::Pointer laplaceFilter = LaplacianFilter::New();
   laplaceFilter->SetInput(gaussianFilter->GetOutput());
   laplaceFilter->Update();
-  mitk::CastToMitkImage(laplaceFilter->GetOutput(), output);
+  return laplaceFilter->GetOutput();
 }
 
 template<typename TPixel, unsigned int VImageDimension>
-void
-  HessianOfGaussianFilter(itk::Image<TPixel, VImageDimension>* itkImage, double variance, std::vector<mitk::Image::Pointer> &out)
+std::vector<typename itk::Image<double, VImageDimension>::Pointer>
+  ComputeHessianOfGaussian(itk::Image<TPixel, VImageDimension>* itkImage, double variance)
 {
   typedef itk::Image<TPixel, VImageDimension> ImageType;
   typedef itk::Image<double, VImageDimension> FloatImageType;
@@ -146,6 +153,7 @@ void
   typedef Functor::MatrixFirstEigenvalue<typename VectorImageType::PixelType, double> DeterminantFunctorType;
   typedef itk::UnaryFunctorImageFilter<VectorImageType, FloatImageType, DeterminantFunctorType> DetFilterType;
 
+  std::vector<typename FloatImageType::Pointer> out;
   typename HessianFilterType::Pointer hessianFilter = HessianFilterType::New();
   hessianFilter->SetInput(itkImage);
   hessianFilter->SetSigma(std::sqrt(variance));
@@ -155,17 +163,92 @@ void
     detFilter->SetInput(hessianFilter->GetOutput());
     detFilter->GetFunctor().order = i;
     detFilter->Update();
-    mitk::CastToMitkImage(detFilter->GetOutput(), out[i]);
+    out.push_back(detFilter->GetOutput());
   }
+  return out;
 }
 
 template<typename TPixel, unsigned int VImageDimension>
-void
-LocalHistograms2(itk::Image<TPixel, VImageDimension>* itkImage, std::vector<mitk::Image::Pointer> &out, std::vector<double> params)
+std::vector<typename itk::Image<TPixel, VImageDimension>::Pointer>
+  ComputeLocalHistograms(itk::Image<TPixel, VImageDimension>* itkImage, double offset, double delta, int bins)
+{
+  typedef itk::Image<TPixel, VImageDimension> ImageType;
+  typedef itk::MultiHistogramFilter <ImageType,ImageType> MultiHistogramType;
+
+  typename MultiHistogramType::Pointer filter = MultiHistogramType::New();
+  filter->SetInput(itkImage);
+  filter->SetOffset(offset);
+  filter->SetDelta(delta);
+  if (bins > 0)
+  {
+    filter->SetBins(bins);
+  }
+  filter->Update();
+
+  std::vector<typename ImageType::Pointer> out;
+  for (int i = 0; i < (bins > 0 ? bins : 11); ++i)
+  {
+    out.push_back(filter->GetOutput(i));
+  }
+  return out;
+}
+
+template<typename TPixel, unsigned int VImageDimension>
+std::vector<typename itk::Image<TPixel, VImageDimension>::Pointer>
+  ComputeLocalStatistic(itk::Image<TPixel, VImageDimension>* itkImage, int size)
 {
   typedef itk::Image<TPixel, VImageDimension> ImageType;
-  typedef itk::MultiHistogramFilter <ImageType, ImageType> MultiHistogramType;
+  typedef itk::LocalStatisticFilter <ImageType, ImageType> MultiHistogramType;
+
+  typename MultiHistogramType::Pointer filter = MultiHistogramType::New();
+  filter->SetInput(itkImage);
+  filter->SetSize(size);
+  filter->Update();
+
+  std::vector<typename ImageType::Pointer> out;
+  for (int i = 0; i < 5; ++i)
+  {
+    out.push_back(filter->GetOutput(i));
+  }
+  return out;
+}
+
+template<typename TPixel, unsigned int VImageDimension>
+void
+  GaussianFilter(itk::Image<TPixel, VImageDimension>* itkImage, double variance, mitk::Image::Pointer &output)
+{
+  mitk::CastToMitkImage(ComputeGaussian(itkImage, variance), output);
+}
+
+template<typename TPixel, unsigned int VImageDimension>
+void
+  DifferenceOfGaussFilter(itk::Image<TPixel, VImageDimension>* itkImage, double variance, mitk::Image::Pointer &output)
+{
+  mitk::CastToMitkImage(ComputeDifferenceOfGauss(itkImage, variance), output);
+}
+
+template<typename TPixel, unsigned int VImageDimension>
+void
+  LaplacianOfGaussianFilter(itk::Image<TPixel, VImageDimension>* itkImage, double variance, mitk::Image::Pointer &output)
+{
+  mitk::CastToMitkImage(ComputeLaplacianOfGaussian(itkImage, variance), output);
+}
+
+template<typename TPixel, unsigned int VImageDimension>
+void
+  HessianOfGaussianFilter(itk::Image<TPixel, VImageDimension>* itkImage, double variance, std::vector<mitk::Image::Pointer> &out)
+{
+  auto eigenvalues = ComputeHessianOfGaussian(itkImage, variance);
+  for (unsigned int i = 0; i < VImageDimension; ++i)
+  {
+    mitk::CastToMitkImage(eigenvalues[i], out[i]);
+  }
+}
 
+template<typename TPixel, unsigned int VImageDimension>
+void
+LocalHistograms2(itk::Image<TPixel, VImageDimension>* itkImage, std::vector<mitk::Image::Pointer> &out, std::vector<double> params)
+{
   double minimum = params[0];
   double maximum = params[1];
   int bins = std::round(params[2]);
@@ -173,16 +256,10 @@ LocalHistograms2(itk::Image<TPixel, VImageDimension>* itkImage, std::vector<mitk
   double offset = minimum;
   double delta = (maximum - minimum) / bins;
 
-  typename MultiHistogramType::Pointer filter = MultiHistogramType::New();
-  filter->SetInput(itkImage);
-  filter->SetOffset(offset);
-  filter->SetDelta(delta);
-  filter->SetBins(bins);
-  filter->Update();
-  for (int i = 0; i < bins; ++i)
+  for (auto histogram : ComputeLocalHistograms(itkImage, offset, delta, bins))
   {
     mitk::Image::Pointer img = mitk::Image::New();
-    mitk::CastToMitkImage(filter->GetOutput(i), img);
+    mitk::CastToMitkImage(histogram, img);
     out.push_back(img);
   }
 }
@@ -191,18 +268,10 @@ template<typename TPixel, unsigned int VImageDimension>
 void
   LocalHistograms(itk::Image<TPixel, VImageDimension>* itkImage, std::vector<mitk::Image::Pointer> &out, double offset, double delta)
 {
-  typedef itk::Image<TPixel, VImageDimension> ImageType;
-  typedef itk::MultiHistogramFilter <ImageType,ImageType> MultiHistogramType;
-
-  typename MultiHistogramType::Pointer filter = MultiHistogramType::New();
-  filter->SetInput(itkImage);
-  filter->SetOffset(offset);
-  filter->SetDelta(delta);
-  filter->Update();
-  for (int i = 0; i < 11; ++i)
+  for (auto histogram : ComputeLocalHistograms(itkImage, offset, delta, 0))
   {
     mitk::Image::Pointer img = mitk::Image::New();
-    mitk::CastToMitkImage(filter->GetOutput(i), img);
+    mitk::CastToMitkImage(histogram, img);
     out.push_back(img);
   }
 }
@@ -211,21 +280,164 @@ template<typename TPixel, unsigned int VImageDimension>
 void
 localStatistic(itk::Image<TPixel, VImageDimension>* itkImage, std::vector<mitk::Image::Pointer> &out, int size)
 {
-  typedef itk::Image<TPixel, VImageDimension> ImageType;
-  typedef itk::LocalStatisticFilter <ImageType, ImageType> MultiHistogramType;
-
-  typename MultiHistogramType::Pointer filter = MultiHistogramType::New();
-  filter->SetInput(itkImage);
-  filter->SetSize(size);
-  filter->Update();
-  for (int i = 0; i < 5; ++i)
+  for (auto statistic : ComputeLocalStatistic(itkImage, size))
   {
     mitk::Image::Pointer img = mitk::Image::New();
-    mitk::CastToMitkImage(filter->GetOutput(i), img);
+    mitk::CastToMitkImage(statistic, img);
     out.push_back(img);
   }
 }
 
+////////////////////////////////////////////////////////////////
+// Block streaming
+//
+// The volume is processed in slabs along the last image axis. Every slab is
+// extended by a halo that covers the support of the feature filter, the filter
+// is run on the extended slab and only the core of the slab is pasted into the
+// output files. Thus only one slab of each feature is kept in memory.
+// For filters with finite support (discrete Gaussian, local histograms and
+// statistics) the results are identical to the full volume computation.
+// The recursive (IIR) Gaussian derivatives used by LoG and HoG have an
+// infinite support and are initialized from the border values of their input.
+// Their block results are therefore only an approximation of the full volume
+// results: the halo of 8 sigma keeps the deviation close to the slab borders
+// small, but it is not zero.
+////////////////////////////////////////////////////////////////
+
+// Upper bound of the kernel radius of itk::DiscreteGaussianImageFilter (MaximumKernelWidth / 2).
+static const unsigned int DiscreteGaussianHalo = 16;
+// Halo of recursive Gaussian filters in multiples of sigma (approximation, see above).
+static const double RecursiveGaussianHaloFactor = 8.0;
+// Neighborhood radius used by itk::MultiHistogramFilter.
+static const unsigned int LocalHistogramHalo = 5;
+
+template<typename TImage>
+unsigned int RecursiveGaussianHalo(const TImage* image, double sigma)
+{
+  const double spacing = image->GetSpacing()[TImage::ImageDimension - 1];
+  return static_cast<unsigned int>(std::ceil(RecursiveGaussianHaloFactor * sigma / spacing));
+}
+
+template<typename TInputImage, typename TOutputImage>
+void StreamFeatures(TInputImage* image,
+                    std::function<std::vector<typename TOutputImage::Pointer>(TInputImage*)> computeFeatures,
+                    unsigned int halo,
+                    unsigned int slabSize,
+                    const std::vector<std::string> &fileNames)
+{
+  const unsigned int dimension = TInputImage::ImageDimension;
+  typedef typename TInputImage::RegionType RegionType;
+  typedef itk::ImageFileWriter<TOutputImage> WriterType;
+
+  const RegionType largestRegion = image->GetLargestPossibleRegion();
+
+  std::vector<typename WriterType::Pointer> writers;
+  for (const auto &fileName : fileNames)
+  {
+    auto imageIO = itk::ImageIOFactory::CreateImageIO(fileName.c_str(), itk::IOFileModeEnum::WriteMode);
+    if (imageIO.IsNull() || !imageIO->CanStreamWrite())
+    {
+      mitkThrow() << "Cannot stream features into \"" << fileName << "\". Block streaming requires an uncompressed file format that supports streamed writing, e.g. \".nii\" or \".mha\".";
+    }
+    typename WriterType::Pointer writer = WriterType::New();
+    writer->SetFileName(fileName);
+    writer->SetImageIO(imageIO);
+    writer->UseCompressionOff();
+    writers.push_back(writer);
+  }
+
+  mitk::ProcessImageInSlabs<TInputImage, TOutputImage>(image, computeFeatures, halo, slabSize,
+    [&](std::size_t i, TOutputImage* feature, const RegionType &coreRegion)
+  {
+    if (i >= writers.size())
+    {
+      mitkThrow() << "Feature computation returned more than the expected " << writers.size() << " images.";
+    }
+
+    typename TOutputImage::Pointer core = TOutputImage::New();
+    core->CopyInformation(image);
+    core->SetLargestPossibleRegion(largestRegion);
+    core->SetBufferedRegion(coreRegion);
+    core->SetRequestedRegion(coreRegion);
+    core->Allocate();
+    itk::ImageAlgorithm::Copy(feature, core.GetPointer(), coreRegion, coreRegion);
+
+    itk::ImageIORegion ioRegion(dimension);
+    for (unsigned int d = 0; d < dimension; ++d)
+    {
+      ioRegion.SetIndex(d, coreRegion.GetIndex(d) - largestRegion.GetIndex(d));
+      ioRegion.SetSize(d, coreRegion.GetSize(d));
+    }
+
+    writers[i]->SetInput(core);
+    writers[i]->SetIORegion(ioRegion);
+    writers[i]->Update();
+  });
+}
+
+template<typename TPixel, unsigned int VImageDimension>
+void
+  StreamedGaussianFilter(itk::Image<TPixel, VImageDimension>* itkImage, double variance, const std::string &fileName, unsigned int slabSize)
+{
+  typedef itk::Image<TPixel, VImageDimension> ImageType;
+  StreamFeatures<ImageType, ImageType>(itkImage,
+    [variance](ImageType* slab) { return std::vector<typename ImageType::Pointer>{ ComputeGaussian(slab, variance) }; },
+    DiscreteGaussianHalo, slabSize, { fileName });
+}
+
+template<typename TPixel, unsigned int VImageDimension>
+void
+  StreamedDifferenceOfGaussFilter(itk::Image<TPixel, VImageDimension>* itkImage, double variance, const std::string &fileName, unsigned int slabSize)
+{
+  typedef itk::Image<TPixel, VImageDimension> ImageType;
+  StreamFeatures<ImageType, ImageType>(itkImage,
+    [variance](ImageType* slab) { return std::vector<typename ImageType::Pointer>{ ComputeDifferenceOfGauss(slab, variance) }; },
+    DiscreteGaussianHalo, slabSize, { fileName });
+}
+
+template<typename TPixel, unsigned int VImageDimension>
+void
+  StreamedLaplacianOfGaussianFilter(itk::Image<TPixel, VImageDimension>* itkImage, double variance, const std::string &fileName, unsigned int slabSize)
+{
+  typedef itk::Image<TPixel, VImageDimension> ImageType;
+  // the recursive Laplacian filter uses its default sigma of 1.0
+  StreamFeatures<ImageType, ImageType>(itkImage,
+    [variance](ImageType* slab) { return std::vector<typename ImageType::Pointer>{ ComputeLaplacianOfGaussian(slab, variance) }; },
+    DiscreteGaussianHalo + RecursiveGaussianHalo(itkImage, 1.0), slabSize, { fileName });
+}
+
+template<typename TPixel, unsigned int VImageDimension>
+void
+  StreamedHessianOfGaussianFilter(itk::Image<TPixel, VImageDimension>* itkImage, double variance, const std::vector<std::string> &fileNames, unsigned int slabSize)
+{
+  typedef itk::Image<TPixel, VImageDimension> ImageType;
+  typedef itk::Image<double, VImageDimension> FloatImageType;
+  StreamFeatures<ImageType, FloatImageType>(itkImage,
+    [variance](ImageType* slab) { return ComputeHessianOfGaussian(slab, variance); },
+    RecursiveGaussianHalo(itkImage, std::sqrt(variance)), slabSize, fileNames);
+}
+
+template<typename TPixel, unsigned int VImageDimension>
+void
+  StreamedLocalHistograms(itk::Image<TPixel, VImageDimension>* itkImage, double offset, double delta, int bins, const std::vector<std::string> &fileNames, unsigned int slabSize)
+{
+  typedef itk::Image<TPixel, VImageDimension> ImageType;
+  StreamFeatures<ImageType, ImageType>(itkImage,
+    [offset, delta, bins](ImageType* slab) { return ComputeLocalHistograms(slab, offset, delta, bins); },
+    LocalHistogramHalo, slabSize, fileNames);
+}
+
+template<typename TPixel, unsigned int VImageDimension>
+void
+  StreamedLocalStatistic(itk::Image<TPixel, VImageDimension>* itkImage, int size, const std::vector<std::string> &fileNames, unsigned int slabSize)
+{
+  typedef itk::Image<TPixel, VImageDimension> ImageType;
+  // itk::LocalStatisticFilter does not use a neighborhood along the third axis of 3D images
+  const unsigned int halo = (VImageDimension == 3) ? 0 : size;
+  StreamFeatures<ImageType, ImageType>(itkImage,
+    [size](ImageType* slab) { return ComputeLocalStatistic(slab, size); },
+    halo, slabSize, fileNames);
+}
 
 int main(int argc, char* argv[])
 {
@@ -243,6 +455,7 @@ int main(int argc, char* argv[])
   parser.addArgument("local-histogram", "lh", mitkCommandLineParser::String, "Local Histograms", "Calculate the local histogram based feature. Specify Offset and Delta, for exampel -3;0.6 ", us::Any());
   parser.addArgument("local-histogram2", "lh2", mitkCommandLineParser::String, "Local Histograms", "Calculate the local histogram based feature. Specify Minimum;Maximum;Bins, for exampel -3;3;6 ", us::Any());
   parser.addArgument("local-statistic", "ls", mitkCommandLineParser::String, "Local Histograms", "Calculate the local histogram based feature. Specify Offset and Delta, for exampel -3;0.6 ", us::Any());
+  parser.addArgument("block-size", "bs", mitkCommandLineParser::Int, "Block size", "Enables block streaming: the image is processed in blocks of the given number of slices (along the last image axis) and the features are written incrementally. Requires an uncompressed extension that supports streamed writing, e.g. .nii or .mha. LoG and HoG results are approximated close to the block borders", us::Any());
   // Miniapp Infos
   parser.setCategory("Classification Tools");
   parser.setTitle("Global Image Feature calculator");
@@ -269,6 +482,19 @@ int main(int argc, char* argv[])
     extension = parsedArgs["extension"].ToString();
   }
 
+  unsigned int blockSize = 0;
+  if (parsedArgs.count("block-size"))
+  {
+    const int requestedBlockSize = us::any_cast<int>(parsedArgs["block-size"]);
+    if (requestedBlockSize < 0)
+    {
+      MITK_ERROR << "Invalid block size " << requestedBlockSize << ". The block size has to be a positive number of slices.";
+      return EXIT_FAILURE;
+    }
+    blockSize = static_cast<unsigned int>(requestedBlockSize);
+    MITK_INFO << "Block streaming with " << blockSize << " slices per block";
+  }
+
   ////////////////////////////////////////////////////////////////
   // CAlculate Local Histogram
   ////////////////////////////////////////////////////////////////
@@ -283,11 +509,21 @@ int main(int argc, char* argv[])
     }
     else
     {
-      AccessByItk_3(image, LocalHistograms, outs, ranges[0], ranges[1]);
-      for (std::size_t i = 0; i < outs.size(); ++i)
+      if (blockSize > 0)
       {
-        std::string name = filename + "-lh" + us::any_value_to_string<int>(i)+extension;
-        mitk::IOUtil::Save(outs[i], name);
+        std::vector<std::string> names;
+        for (int i = 0; i < 11; ++i)
+          names.push_back(filename + "-lh" + us::any_value_to_string<int>(i)+extension);
+        AccessByItk_n(image, StreamedLocalHistograms, (ranges[0], ranges[1], 0, names, blockSize));
+      }
+      else
+      {
+        AccessByItk_3(image, LocalHistograms, outs, ranges[0], ranges[1]);
+        for (std::size_t i = 0; i < outs.size(); ++i)
+        {
+          std::string name = filename + "-lh" + us::any_value_to_string<int>(i)+extension;
+          mitk::IOUtil::Save(outs[i], name);
+        }
       }
     }
   }
@@ -306,11 +542,22 @@ int main(int argc, char* argv[])
     }
     else
     {
-      AccessByItk_2(image, LocalHistograms2, outs, ranges);
-      for (std::size_t i = 0; i < outs.size(); ++i)
+      if (blockSize > 0)
       {
-        std::string name = filename + "-lh2" + us::any_value_to_string<int>(i)+extension;
-        mitk::IOUtil::Save(outs[i], name);
+        int bins = std::round(ranges[2]);
+        std::vector<std::string> names;
+        for (int i = 0; i < bins; ++i)
+          names.push_back(filename + "-lh2" + us::any_value_to_string<int>(i)+extension);
+        AccessByItk_n(image, StreamedLocalHistograms, (ranges[0], (ranges[1] - ranges[0]) / bins, bins, names, blockSize));
+      }
+      else
+      {
+        AccessByItk_2(image, LocalHistograms2, outs, ranges);
+        for (std::size_t i = 0; i < outs.size(); ++i)
+        {
+          std::string name = filename + "-lh2" + us::any_value_to_string<int>(i)+extension;
+          mitk::IOUtil::Save(outs[i], name);
+        }
       }
     }
   }
@@ -331,6 +578,14 @@ int main(int argc, char* argv[])
     {
       for (std::size_t j = 0; j < ranges.size(); ++j)
       {
+        if (blockSize > 0)
+        {
+          std::vector<std::string> names;
+          for (int i = 0; i < 5; ++i)
+            names.push_back(filename + "-lstat" + us::any_value_to_string<int>(ranges[j])+ "_" +us::any_value_to_string<int>(i)+extension);
+          AccessByItk_n(image, StreamedLocalStatistic, (ranges[j], names, blockSize));
+          continue;
+        }
         AccessByItk_2(image, localStatistic, outs, ranges[j]);
         for (std::size_t i = 0; i < outs.size(); ++i)
         {
@@ -355,6 +610,12 @@ int main(int argc, char* argv[])
     for (std::size_t i = 0; i < ranges.size(); ++i)
     {
       MITK_INFO << "Gaussian with sigma: " << ranges[i];
+      if (blockSize > 0)
+      {
+        std::string name = filename + "-gaussian-" + us::any_value_to_string(ranges[i]) + extension;
+        AccessByItk_n(image, StreamedGaussianFilter, (ranges[i], name, blockSize));
+        continue;
+      }
       mitk::Image::Pointer output;
       AccessByItk_2(image, GaussianFilter, ranges[i], output);
       MITK_INFO << "Write output:";
@@ -374,6 +635,12 @@ int main(int argc, char* argv[])
 
     for (std::size_t i = 0; i < ranges.size(); ++i)
     {
+      if (blockSize > 0)
+      {
+        std::string name = filename + "-dog-" + us::any_value_to_string(ranges[i]) + extension;
+        AccessByItk_n(image, StreamedDifferenceOfGaussFilter, (ranges[i], name, blockSize));
+        continue;
+      }
       mitk::Image::Pointer output;
       AccessByItk_2(image, DifferenceOfGaussFilter, ranges[i], output);
       std::string name = filename + "-dog-" + us::any_value_to_string(ranges[i]) + extension;
@@ -392,6 +659,12 @@ int main(int argc, char* argv[])
 
     for (std::size_t i = 0; i < ranges.size(); ++i)
     {
+      if (blockSize > 0)
+      {
+        std::string name = filename + "-log-" + us::any_value_to_string(ranges[i]) + extension;
+        AccessByItk_n(image, StreamedLaplacianOfGaussianFilter, (ranges[i], name, blockSize));
+        continue;
+      }
       mitk::Image::Pointer output;
       AccessByItk_2(image, LaplacianOfGaussianFilter, ranges[i], output);
       std::string name = filename + "-log-" + us::any_value_to_string(ranges[i]) + extension;
@@ -410,6 +683,14 @@ int main(int argc, char* argv[])
 
     for (std::size_t i = 0; i < ranges.size(); ++i)
     {
+      if (blockSize > 0)
+      {
+        std::vector<std::string> names;
+        for (unsigned int j = 0; j < image->GetDimension(); ++j)
+          names.push_back(filename + "-hog" + us::any_value_to_string(j) + "-" + us::any_value_to_string(ranges[i]) + extension);
+        AccessByItk_n(image, StreamedHessianOfGaussianFilter, (ranges[i], names, blockSize));
+        continue;
+      }
       std::vector<mitk::Image::Pointer> outs;
       outs.push_back(mitk::Image::New());
       outs.push_back(mitk::Image::New());
@@ -0,0 +1,87 @@
+/*============================================================================
+
+The Medical Imaging Interaction Toolkit (MITK)
+
+Copyright (c) German Cancer Research Center (DKFZ)
+All rights reserved.
+
+Use of this source code is governed by a 3-clause BSD license that can be
+found in the LICENSE file.
+
+============================================================================*/
+
+#ifndef mitkCLSlabProcessing_h
+#define mitkCLSlabProcessing_h
+
+#include <mitkExceptionMacro.h>
+
+#include <itkExtractImageFilter.h>
+
+#include <algorithm>
+#include <functional>
+#include <vector>
+
+namespace mitk
+{
+  /**
+   * @brief Computes voxel features of an image slab by slab along the last image axis.
+   *
+   * Every slab of @a slabSize slices is extended by @a halo slices on both sides (cropped at the
+   * image borders), @a computeFeatures is run on the extended slab and @a consumeCore is called
+   * for every returned feature image together with the region of the slab core. Only the core of
+   * a feature image may be used by the consumer.
+   *
+   * The result equals the computation on the whole image if the support of the feature filter
+   * along the last axis does not exceed the halo.
+   */
+  template <typename TInputImage, typename TOutputImage>
+  void ProcessImageInSlabs(
+    TInputImage *image,
+    std::function<std::vector<typename TOutputImage::Pointer>(TInputImage *)> computeFeatures,
+    unsigned int halo,
+    unsigned int slabSize,
+    std::function<void(std::size_t, TOutputImage *, const typename TInputImage::RegionType &)> consumeCore)
+  {
+    typedef typename TInputImage::RegionType RegionType;
+    typedef itk::ExtractImageFilter<TInputImage, TInputImage> ExtractFilterType;
+
+    if (0 == slabSize)
+      mitkThrow() << "Slab size must be greater than 0.";
+
+    const unsigned int axis = TInputImage::ImageDimension - 1;
+    const RegionType largestRegion = image->GetLargestPossibleRegion();
+    const itk::IndexValueType firstSlice = largestRegion.GetIndex(axis);
+    const itk::IndexValueType endSlice = firstSlice + static_cast<itk::IndexValueType>(largestRegion.GetSize(axis));
+
+    for (itk::IndexValueType slice = firstSlice; slice < endSlice; slice += slabSize)
+    {
+      RegionType coreRegion = largestRegion;
+      coreRegion.SetIndex(axis, slice);
+      coreRegion.SetSize(axis, std::min<itk::SizeValueType>(slabSize, endSlice - slice));
+
+      RegionType haloRegion = coreRegion;
+      haloRegion.SetIndex(axis, coreRegion.GetIndex(axis) - static_cast<itk::IndexValueType>(halo));
+      haloRegion.SetSize(axis, coreRegion.GetSize(axis) + 2 * halo);
+      haloRegion.Crop(largestRegion);
+
+      typename ExtractFilterType::Pointer extractFilter = ExtractFilterType::New();
+      extractFilter->SetInput(image);
+      extractFilter->SetExtractionRegion(haloRegion);
+      extractFilter->SetDirectionCollapseToSubmatrix();
+      extractFilter->Update();
+      typename TInputImage::Pointer slab = extractFilter->GetOutput();
+      slab->DisconnectPipeline();
+
+      auto features = computeFeatures(slab);
+      slab = nullptr;
+
+      for (std::size_t i = 0; i < features.size(); ++i)
+      {
+        consumeCore(i, features[i], coreRegion);
+        features[i] = nullptr;
+      }
+    }
+  }
+}
+
+#endif
@@ -1,4 +1,5 @@
 set(MODULE_TESTS
+  mitkCLSlabProcessingTest.cpp
   mitkGIFCooc2Test.cpp
   mitkGIFCurvatureStatisticTest.cpp
   mitkGIFFirstOrderHistogramStatisticsTest.cpp
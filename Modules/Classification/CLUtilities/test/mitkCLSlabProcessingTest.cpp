@@ -0,0 +1,115 @@
+/*============================================================================
+
+The Medical Imaging Interaction Toolkit (MITK)
+
+Copyright (c) German Cancer Research Center (DKFZ)
+All rights reserved.
+
+Use of this source code is governed by a 3-clause BSD license that can be
+found in the LICENSE file.
+
+============================================================================*/
+
+#include <mitkTestingMacros.h>
+#include <mitkTestFixture.h>
+
+#include <mitkCLSlabProcessing.h>
+
+#include <itkDiscreteGaussianImageFilter.h>
+#include <itkImageAlgorithm.h>
+#include <itkImageRegionConstIterator.h>
+#include <itkImageRegionIterator.h>
+
+class mitkCLSlabProcessingTestSuite : public mitk::TestFixture
+{
+  CPPUNIT_TEST_SUITE(mitkCLSlabProcessingTestSuite);
+
+  MITK_TEST(DiscreteGaussian_SlabsEqualWholeImage);
+  MITK_TEST(CoresCoverImageOnce);
+
+  CPPUNIT_TEST_SUITE_END();
+
+private:
+  typedef itk::Image<float, 3> ImageType;
+
+  ImageType::Pointer m_Image;
+
+  static std::vector<ImageType::Pointer> ComputeGaussian(ImageType *image)
+  {
+    auto filter = itk::DiscreteGaussianImageFilter<ImageType, ImageType>::New();
+    filter->SetInput(image);
+    filter->SetVariance(2.0);
+    filter->Update();
+    return { filter->GetOutput() };
+  }
+
+public:
+  void setUp() override
+  {
+    ImageType::SizeType size = { { 12, 10, 37 } };
+    ImageType::SpacingType spacing;
+    spacing.Fill(1.0);
+
+    m_Image = ImageType::New();
+    m_Image->SetRegions(ImageType::RegionType(size));
+    m_Image->SetSpacing(spacing);
+    m_Image->Allocate();
+
+    for (itk::ImageRegionIterator<ImageType> iter(m_Image, m_Image->GetLargestPossibleRegion()); !iter.IsAtEnd(); ++iter)
+    {
+      const auto index = iter.GetIndex();
+      iter.Set(static_cast<float>((index[0] * 7 + index[1] * 13 + index[2] * index[2] * 29) % 17));
+    }
+  }
+
+  void tearDown() override
+  {
+    m_Image = nullptr;
+  }
+
+  void DiscreteGaussian_SlabsEqualWholeImage()
+  {
+    auto expected = ComputeGaussian(m_Image)[0];
+
+    auto result = ImageType::New();
+    result->CopyInformation(m_Image);
+    result->SetRegions(m_Image->GetLargestPossibleRegion());
+    result->Allocate();
+
+    // The kernel radius for a variance of 2 is well below the halo of 8 slices
+    mitk::ProcessImageInSlabs<ImageType, ImageType>(m_Image, &ComputeGaussian, 8, 5,
+      [&result](std::size_t, ImageType *feature, const ImageType::RegionType &coreRegion) {
+        itk::ImageAlgorithm::Copy(feature, result.GetPointer(), coreRegion, coreRegion);
+      });
+
+    itk::ImageRegionConstIterator<ImageType> expectedIter(expected, expected->GetLargestPossibleRegion());
+    itk::ImageRegionConstIterator<ImageType> resultIter(result, result->GetLargestPossibleRegion());
+
+    for (; !expectedIter.IsAtEnd(); ++expectedIter, ++resultIter)
+      CPPUNIT_ASSERT_DOUBLES_EQUAL(expectedIter.Get(), resultIter.Get(), 1e-6);
+  }
+
+  void CoresCoverImageOnce()
+  {
+    std::vector<int> visits(m_Image->GetLargestPossibleRegion().GetSize(2), 0);
+
+    mitk::ProcessImageInSlabs<ImageType, ImageType>(m_Image,
+      [](ImageType *slab) { return std::vector<ImageType::Pointer>{ slab }; }, 3, 4,
+      [&visits](std::size_t i, ImageType *feature, const ImageType::RegionType &coreRegion) {
+        CPPUNIT_ASSERT_EQUAL(std::size_t(0), i);
+        CPPUNIT_ASSERT(feature->GetLargestPossibleRegion().IsInside(coreRegion));
+        CPPUNIT_ASSERT(coreRegion.GetSize(2) <= 4);
+
+        for (itk::SizeValueType z = 0; z < coreRegion.GetSize(2); ++z)
+          ++visits[coreRegion.GetIndex(2) + z];
+      });
+
+    for (auto count : visits)
+      CPPUNIT_ASSERT_EQUAL(1, count);
+
+    CPPUNIT_ASSERT_THROW(mitk::ProcessImageInSlabs<ImageType, ImageType>(m_Image, &ComputeGaussian, 8, 0,
+      [](std::size_t, ImageType *, const ImageType::RegionType &) {}), mitk::Exception);
+  }
+};
+
+MITK_TEST_SUITE_REGISTRATION(mitkCLSlabProcessing)
@@ -0,0 +1,97 @@
+/*============================================================================
+
+The Medical Imaging Interaction Toolkit (MITK)
+
+Copyright (c) German Cancer Research Center (DKFZ)
+All rights reserved.
+
+Use of this source code is governed by a 3-clause BSD license that can be
+found in the LICENSE file.
+
+============================================================================*/
+
+#ifndef mitkFlatRandomForest_h
+#define mitkFlatRandomForest_h
+
+#include <MitkCLVigraRandomForestExports.h>
+
+#include <vigra/random_forest.hxx>
+
+#include <Eigen/Dense>
+
+#include <vector>
+
+namespace mitk
+{
+  /**
+   * \brief Read-only, cache friendly representation of a trained vigra::RandomForest<int>.
+   *
+   * vigra stores every tree as its own topology and parameter array and resolves each
+   * node through a proxy object during traversal. FlatRandomForest compiles all trees of
+   * a forest into one contiguous node array. Each tree is laid out breadth-first and the
+   * two children of a split node are stored next to each other, so a split node only
+   * needs the index of its left child. Leaf class weights are kept in a separate array.
+   *
+   * Prediction processes the samples in blocks: for every block all trees are evaluated
+   * one after another, so the upper levels of a tree stay in cache while the samples of
+   * the block are pushed through it. Work is distributed over the ITK work units by rows.
+   *
+   * The results (labels and probabilities) are identical to vigra::RandomForest::predictLabels()
+   * and vigra::RandomForest::predictProbabilities(), including the summation order.
+   * Only forests consisting of threshold split nodes and constant probability leaves
+   * (i.e. forests trained with mitk::ThresholdSplit or vigra's default splits) can be compiled.
+   */
+  class MITKCLVIGRARANDOMFOREST_EXPORT FlatRandomForest
+  {
+  public:
+    FlatRandomForest();
+
+    /** Compiles the passed forest. Returns false (and leaves the instance empty) if the
+     * forest contains node types that are not supported.*/
+    bool Compile(const vigra::RandomForest<int> &rf);
+
+    /** Removes the compiled forest.*/
+    void Clear();
+
+    /** True if a forest was compiled successfully.*/
+    bool IsValid() const;
+
+    unsigned int GetTreeCount() const;
+    unsigned int GetClassCount() const;
+    std::size_t GetNodeCount() const;
+
+    /**
+     * @brief Predicts labels and class probabilities for all rows of X.
+     * @param X Sample matrix of shape = [n_samples, n_features]
+     * @param probabilities Output, resized to [n_samples, n_classes]
+     * @param labels Output, resized to [n_samples, 1]
+     * @param blockSize Number of samples that are pushed through all trees together.
+     */
+    void Predict(const Eigen::MatrixXd &X, Eigen::MatrixXd &probabilities, Eigen::MatrixXi &labels, unsigned int blockSize = 256) const;
+
+    /** Predicts the rows [firstRow, lastRow) of X. The output matrices must already have
+     * the correct size. Only the rows in the range are written, so disjoint ranges may be
+     * processed concurrently.*/
+    void PredictBlock(const Eigen::MatrixXd &X, Eigen::Index firstRow, Eigen::Index lastRow, Eigen::MatrixXd &probabilities, Eigen::MatrixXi &labels) const;
+
+  private:
+    struct Node
+    {
+      /** Split threshold; samples with feature < threshold go to the left child.*/
+      double Threshold;
+      /** Feature column of the split; -1 marks a leaf node.*/
+      int Feature;
+      /** Index of the left child (right child is Child+1) or, for leaves, offset into m_LeafValues.*/
+      int Child;
+    };
+
+    std::vector<Node> m_Nodes;
+    std::vector<int> m_TreeRoots;
+    /** Class weights of all leaves, already multiplied with the leaf weight if the forest predicts weighted.*/
+    std::vector<double> m_LeafValues;
+    std::vector<int> m_ClassLabels;
+    unsigned int m_ClassCount;
+  };
+}
+
+#endif
@@ -15,6 +15,7 @@ found in the LICENSE file.
 
 #include <MitkCLVigraRandomForestExports.h>
 #include <mitkAbstractClassifier.h>
+#include <mitkFlatRandomForest.h>
 
 //#include <vigra/multi_array.hxx>
 #include <vigra/random_forest.hxx>
@@ -42,6 +43,12 @@ namespace mitk
     Eigen::MatrixXi Predict(const Eigen::MatrixXd &X) override;
     Eigen::MatrixXi PredictWeighted(const Eigen::MatrixXd &X);
 
+    /** Predicts X with a flattened copy of the forest (see mitk::FlatRandomForest).
+     * Labels and probabilities are identical to Predict(). Falls back to Predict()
+     * if the forest cannot be flattened.*/
+    Eigen::MatrixXi PredictBlocked(const Eigen::MatrixXd &X, unsigned int blockSize = 256) override;
+    bool SupportsBlockedPrediction() override;
+
 
     bool SupportsPointWiseWeight() override;
     bool SupportsPointWiseProbability() override;
@@ -82,6 +89,10 @@ namespace mitk
     Parameter * m_Parameter;
     vigra::RandomForest<int> m_RandomForest;
 
+    /** Flattened forest used by PredictBlocked. Compiled on demand and reset whenever m_RandomForest changes.*/
+    FlatRandomForest m_FlatRandomForest;
+    bool m_FlatRandomForestIsUpToDate;
+
     static itk::ITK_THREAD_RETURN_TYPE TrainTreesCallback(void *);
     static itk::ITK_THREAD_RETURN_TYPE PredictCallback(void *);
     static itk::ITK_THREAD_RETURN_TYPE PredictWeightedCallback(void *);
@@ -0,0 +1,273 @@
+/*============================================================================
+
+The Medical Imaging Interaction Toolkit (MITK)
+
+Copyright (c) German Cancer Research Center (DKFZ)
+All rights reserved.
+
+Use of this source code is governed by a 3-clause BSD license that can be
+found in the LICENSE file.
+
+============================================================================*/
+
+// MITK includes
+#include <mitkFlatRandomForest.h>
+#include <mitkLogMacros.h>
+
+// Vigra includes
+#include <vigra/random_forest/rf_nodeproxy.hxx>
+
+// ITK include
+#include <itkMultiThreaderBase.h>
+
+#include <algorithm>
+#include <cmath>
+#include <deque>
+#include <utility>
+
+namespace
+{
+  struct BlockedPredictionData
+  {
+    const mitk::FlatRandomForest *m_Forest;
+    const Eigen::MatrixXd *m_Feature;
+    Eigen::MatrixXd *m_Probabilities;
+    Eigen::MatrixXi *m_Label;
+    Eigen::Index m_BlockSize;
+  };
+
+  itk::ITK_THREAD_RETURN_TYPE PredictBlockedCallback(void *arg)
+  {
+    typedef itk::MultiThreaderBase::WorkUnitInfo ThreadInfoType;
+    ThreadInfoType *infoStruct = static_cast<ThreadInfoType *>(arg);
+    const unsigned int threadId = infoStruct->WorkUnitID;
+
+    auto data = static_cast<BlockedPredictionData *>(infoStruct->UserData);
+
+    const Eigen::Index rows = data->m_Feature->rows();
+    const Eigen::Index rowsPerThread = rows / infoStruct->NumberOfWorkUnits;
+
+    Eigen::Index startIndex = rowsPerThread * threadId;
+    Eigen::Index endIndex = rowsPerThread * (threadId + 1);
+
+    // the last thread takes the residuals
+    if (threadId == infoStruct->NumberOfWorkUnits - 1)
+      endIndex = rows;
+
+    for (Eigen::Index first = startIndex; first < endIndex; first += data->m_BlockSize)
+    {
+      const Eigen::Index last = std::min(first + data->m_BlockSize, endIndex);
+      data->m_Forest->PredictBlock(*(data->m_Feature), first, last, *(data->m_Probabilities), *(data->m_Label));
+    }
+
+    return ITK_THREAD_RETURN_DEFAULT_VALUE;
+  }
+}
+
+mitk::FlatRandomForest::FlatRandomForest()
+  : m_ClassCount(0)
+{
+}
+
+void mitk::FlatRandomForest::Clear()
+{
+  m_Nodes.clear();
+  m_TreeRoots.clear();
+  m_LeafValues.clear();
+  m_ClassLabels.clear();
+  m_ClassCount = 0;
+}
+
+bool mitk::FlatRandomForest::IsValid() const
+{
+  return !m_TreeRoots.empty();
+}
+
+unsigned int mitk::FlatRandomForest::GetTreeCount() const
+{
+  return static_cast<unsigned int>(m_TreeRoots.size());
+}
+
+unsigned int mitk::FlatRandomForest::GetClassCount() const
+{
+  return m_ClassCount;
+}
+
+std::size_t mitk::FlatRandomForest::GetNodeCount() const
+{
+  return m_Nodes.size();
+}
+
+bool mitk::FlatRandomForest::Compile(const vigra::RandomForest<int> &rf)
+{
+  this->Clear();
+
+  const int treeCount = rf.tree_count();
+  const int classCount = rf.class_count();
+  if (treeCount <= 0 || classCount <= 0 || static_cast<int>(rf.trees_.size()) < treeCount)
+    return false;
+
+  m_ClassCount = classCount;
+  for (int l = 0; l < classCount; ++l)
+  {
+    int label;
+    rf.ext_param_.to_classlabel(l, label);
+    m_ClassLabels.push_back(label);
+  }
+
+  const int weighted = rf.options_.predict_weighted_;
+
+  // pairs of (vigra topology index, flat node index)
+  std::deque<std::pair<int, int>> queue;
+
+  for (int k = 0; k < treeCount; ++k)
+  {
+    const auto &tree = rf.trees_[k];
+
+    const int root = static_cast<int>(m_Nodes.size());
+    m_Nodes.push_back(Node());
+    m_TreeRoots.push_back(root);
+
+    // the root node of a vigra decision tree is located behind the feature and class count
+    queue.emplace_back(2, root);
+
+    while (!queue.empty())
+    {
+      const int topologyIndex = queue.front().first;
+      const int flatIndex = queue.front().second;
+      queue.pop_front();
+
+      const int typeID = tree.topology_[topologyIndex];
+
+      if (typeID == vigra::e_ConstProbNode)
+      {
+        vigra::Node<vigra::e_ConstProbNode> leaf(tree.topology_, tree.parameters_, topologyIndex);
+        auto weights = leaf.prob_begin();
+        const double factor = weighted * (*(weights - 1)) + (1 - weighted);
+
+        m_Nodes[flatIndex].Threshold = 0.0;
+        m_Nodes[flatIndex].Feature = -1;
+        m_Nodes[flatIndex].Child = static_cast<int>(m_LeafValues.size());
+        for (int l = 0; l < classCount; ++l)
+          m_LeafValues.push_back(weights[l] * factor);
+      }
+      else if (typeID == vigra::i_ThresholdNode)
+      {
+        vigra::Node<vigra::i_ThresholdNode> node(tree.topology_, tree.parameters_, topologyIndex);
+        const int left = static_cast<int>(m_Nodes.size());
+        m_Nodes.push_back(Node());
+        m_Nodes.push_back(Node());
+
+        m_Nodes[flatIndex].Threshold = node.threshold();
+        m_Nodes[flatIndex].Feature = node.column();
+        m_Nodes[flatIndex].Child = left;
+
+        queue.emplace_back(node.child(0), left);
+        queue.emplace_back(node.child(1), left + 1);
+      }
+      else
+      {
+        MITK_WARN("FlatRandomForest") << "Unsupported node type " << typeID << " in tree " << k << ". Forest cannot be compiled.";
+        this->Clear();
+        return false;
+      }
+    }
+  }
+
+  return true;
+}
+
+void mitk::FlatRandomForest::PredictBlock(const Eigen::MatrixXd &X,
+                                          Eigen::Index firstRow,
+                                          Eigen::Index lastRow,
+                                          Eigen::MatrixXd &probabilities,
+                                          Eigen::MatrixXi &labels) const
+{
+  const Eigen::Index blockSize = lastRow - firstRow;
+  if (blockSize <= 0)
+    return;
+
+  std::vector<double> totalWeight(blockSize, 0.0);
+  std::vector<char> containsNaN(blockSize, 0);
+
+  for (Eigen::Index i = 0; i < blockSize; ++i)
+  {
+    probabilities.row(firstRow + i).setZero();
+    for (Eigen::Index col = 0; col < X.cols(); ++col)
+    {
+      if (std::isnan(X(firstRow + i, col)))
+      {
+        containsNaN[i] = 1;
+        break;
+      }
+    }
+  }
+
+  // Tree by tree over the whole block, so that the nodes of one tree are reused
+  // for all samples of the block. The accumulation order per sample is the same as
+  // in vigra::RandomForest::predictProbabilities.
+  for (const int root : m_TreeRoots)
+  {
+    for (Eigen::Index i = 0; i < blockSize; ++i)
+    {
+      if (containsNaN[i])
+        continue;
+
+      const Eigen::Index row = firstRow + i;
+      const Node *node = &m_Nodes[root];
+      while (node->Feature >= 0)
+      {
+        node = &m_Nodes[node->Child + (X(row, node->Feature) < node->Threshold ? 0 : 1)];
+      }
+
+      const double *leafValues = &m_LeafValues[node->Child];
+      for (unsigned int l = 0; l < m_ClassCount; ++l)
+      {
+        probabilities(row, l) += leafValues[l];
+        totalWeight[i] += leafValues[l];
+      }
+    }
+  }
+
+  for (Eigen::Index i = 0; i < blockSize; ++i)
+  {
+    const Eigen::Index row = firstRow + i;
+    if (!containsNaN[i])
+    {
+      for (unsigned int l = 0; l < m_ClassCount; ++l)
+        probabilities(row, l) /= totalWeight[i];
+    }
+
+    // first maximum wins, as in vigra::argMax
+    unsigned int maxCol = 0;
+    for (unsigned int l = 1; l < m_ClassCount; ++l)
+    {
+      if (probabilities(row, l) > probabilities(row, maxCol))
+        maxCol = l;
+    }
+    labels(row, 0) = m_ClassLabels[maxCol];
+  }
+}
+
+void mitk::FlatRandomForest::Predict(const Eigen::MatrixXd &X,
+                                     Eigen::MatrixXd &probabilities,
+                                     Eigen::MatrixXi &labels,
+                                     unsigned int blockSize) const
+{
+  probabilities = Eigen::MatrixXd::Zero(X.rows(), m_ClassCount);
+  labels = Eigen::MatrixXi::Zero(X.rows(), 1);
+
+  if (!this->IsValid() || X.rows() == 0)
+    return;
+
+  BlockedPredictionData data;
+  data.m_Forest = this;
+  data.m_Feature = &X;
+  data.m_Probabilities = &probabilities;
+  data.m_Label = &labels;
+  data.m_BlockSize = std::max(1u, blockSize);
+
+  auto threader = itk::MultiThreaderBase::New();
+  threader->SetSingleMethod(PredictBlockedCallback, &data);
+  threader->SingleMethodExecute();
+}
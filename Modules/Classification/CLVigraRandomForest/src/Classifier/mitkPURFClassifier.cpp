@@ -95,7 +95,8 @@ struct mitk::PURFClassifier::PredictionData
 };
 
 mitk::PURFClassifier::PURFClassifier()
-  :m_Parameter(nullptr)
+  :m_Parameter(nullptr),
+  m_FlatRandomForestIsUpToDate(false)
 {
   itk::SimpleMemberCommand<mitk::PURFClassifier>::Pointer command = itk::SimpleMemberCommand<mitk::PURFClassifier>::New();
   command->SetCallbackFunction(this, &mitk::PURFClassifier::ConvertParameter);
@@ -197,6 +198,7 @@ void mitk::PURFClassifier::Train(const Eigen::MatrixXd & X_in, const Eigen::Matr
   m_RandomForest.set_options().tree_count(m_Parameter->TreeCount);
   m_RandomForest.ext_param_.class_count_ = data->m_ClassCount;
   m_RandomForest.trees_ = data->trees_;
+  m_FlatRandomForestIsUpToDate = false;
 
   // Set Tree Weights to default
   m_TreeWeights = Eigen::MatrixXd(m_Parameter->TreeCount,1);
@@ -235,6 +237,26 @@ Eigen::MatrixXi mitk::PURFClassifier::Predict(const Eigen::MatrixXd &X_in)
   return m_OutLabel;
 }
 
+bool mitk::PURFClassifier::SupportsBlockedPrediction()
+{
+  return true;
+}
+
+Eigen::MatrixXi mitk::PURFClassifier::PredictBlocked(const Eigen::MatrixXd &X_in, unsigned int blockSize)
+{
+  if (!m_FlatRandomForestIsUpToDate)
+  {
+    m_FlatRandomForest.Compile(m_RandomForest);
+    m_FlatRandomForestIsUpToDate = true;
+  }
+
+  if (!m_FlatRandomForest.IsValid())
+    return this->Predict(X_in);
+
+  m_FlatRandomForest.Predict(X_in, m_OutProbability, m_OutLabel, blockSize);
+  return m_OutLabel;
+}
+
 itk::ITK_THREAD_RETURN_TYPE mitk::PURFClassifier::TrainTreesCallback(void * arg)
 {
   // Get the ThreadInfoStruct
@@ -466,6 +488,7 @@ void mitk::PURFClassifier::SetRandomForest(const vigra::RandomForest<int> & rf)
   this->SetSamplesPerTree(rf.options().training_set_proportion_);
   this->UseSampleWithReplacement(rf.options().sample_with_replacement_);
   this->m_RandomForest = rf;
+  m_FlatRandomForestIsUpToDate = false;
 }
 
 const vigra::RandomForest<int> & mitk::PURFClassifier::GetRandomForest() const
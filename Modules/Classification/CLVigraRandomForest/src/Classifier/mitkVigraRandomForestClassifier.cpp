@@ -94,7 +94,8 @@ struct mitk::VigraRandomForestClassifier::PredictionData
 };
 
 mitk::VigraRandomForestClassifier::VigraRandomForestClassifier()
-  :m_Parameter(nullptr)
+  :m_Parameter(nullptr),
+  m_FlatRandomForestIsUpToDate(false)
 {
   itk::SimpleMemberCommand<mitk::VigraRandomForestClassifier>::Pointer command = itk::SimpleMemberCommand<mitk::VigraRandomForestClassifier>::New();
   command->SetCallbackFunction(this, &mitk::VigraRandomForestClassifier::ConvertParameter);
@@ -120,6 +121,7 @@ void mitk::VigraRandomForestClassifier::OnlineTrain(const Eigen::MatrixXd & X_in
   vigra::MultiArrayView<2, double> X(vigra::Shape2(X_in.rows(),X_in.cols()),X_in.data());
   vigra::MultiArrayView<2, int> Y(vigra::Shape2(Y_in.rows(),Y_in.cols()),Y_in.data());
   m_RandomForest.onlineLearn(X,Y,0,true);
+  m_FlatRandomForestIsUpToDate = false;
 }
 
 void mitk::VigraRandomForestClassifier::Train(const Eigen::MatrixXd & X_in, const Eigen::MatrixXi &Y_in)
@@ -164,6 +166,7 @@ void mitk::VigraRandomForestClassifier::Train(const Eigen::MatrixXd & X_in, cons
   m_RandomForest.set_options().tree_count(m_Parameter->TreeCount);
   m_RandomForest.ext_param_.class_count_ = data->m_ClassCount;
   m_RandomForest.trees_ = data->trees_;
+  m_FlatRandomForestIsUpToDate = false;
 
   // Set Tree Weights to default
   m_TreeWeights = Eigen::MatrixXd(m_Parameter->TreeCount,1);
@@ -202,6 +205,26 @@ Eigen::MatrixXi mitk::VigraRandomForestClassifier::Predict(const Eigen::MatrixXd
   return m_OutLabel;
 }
 
+bool mitk::VigraRandomForestClassifier::SupportsBlockedPrediction()
+{
+  return true;
+}
+
+Eigen::MatrixXi mitk::VigraRandomForestClassifier::PredictBlocked(const Eigen::MatrixXd &X_in, unsigned int blockSize)
+{
+  if (!m_FlatRandomForestIsUpToDate)
+  {
+    m_FlatRandomForest.Compile(m_RandomForest);
+    m_FlatRandomForestIsUpToDate = true;
+  }
+
+  if (!m_FlatRandomForest.IsValid())
+    return this->Predict(X_in);
+
+  m_FlatRandomForest.Predict(X_in, m_OutProbability, m_OutLabel, blockSize);
+  return m_OutLabel;
+}
+
 Eigen::MatrixXi mitk::VigraRandomForestClassifier::PredictWeighted(const Eigen::MatrixXd &X_in)
 {
   // Initialize output Eigen matrices
@@ -581,6 +604,7 @@ void mitk::VigraRandomForestClassifier::SetRandomForest(const vigra::RandomFores
   this->SetSamplesPerTree(rf.options().training_set_proportion_);
   this->UseSampleWithReplacement(rf.options().sample_with_replacement_);
   this->m_RandomForest = rf;
+  m_FlatRandomForestIsUpToDate = false;
 }
 
 const vigra::RandomForest<int> & mitk::VigraRandomForestClassifier::GetRandomForest() const
@@ -1,5 +1,9 @@
 set(MODULE_TESTS "")
+set(MODULE_CUSTOM_TESTS "")
 
 if(NOT APPLE)
   list(APPEND MODULE_TESTS mitkVigraRandomForestTest.cpp)
+
+  # Benchmarks are not run by CTest, call the test driver with their name to run them
+  list(APPEND MODULE_CUSTOM_TESTS mitkVigraRandomForestBenchmark.cpp)
 endif()
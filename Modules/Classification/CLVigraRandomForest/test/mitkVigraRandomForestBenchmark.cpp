@@ -0,0 +1,93 @@
+/*============================================================================
+
+The Medical Imaging Interaction Toolkit (MITK)
+
+Copyright (c) German Cancer Research Center (DKFZ)
+All rights reserved.
+
+Use of this source code is governed by a 3-clause BSD license that can be
+found in the LICENSE file.
+
+============================================================================*/
+
+#include <mitkTestingMacros.h>
+#include <mitkTestFixture.h>
+
+#include <mitkVigraRandomForestClassifier.h>
+
+#include <itkTimeProbe.h>
+
+#include <random>
+
+/** Compares the runtime of Predict() and PredictBlocked() on a large synthetic data set.
+  Not run by CTest; call the test driver with mitkVigraRandomForestBenchmark to run it.*/
+class mitkVigraRandomForestBenchmarkSuite : public mitk::TestFixture
+{
+  CPPUNIT_TEST_SUITE(mitkVigraRandomForestBenchmarkSuite);
+  MITK_TEST(PredictBlocked_LargeDataSet_FasterThanPredict);
+  CPPUNIT_TEST_SUITE_END();
+
+private:
+  static constexpr int NumberOfFeatures = 32;
+  static constexpr int NumberOfClasses = 4;
+
+  /** Samples of each class are normally distributed around a class specific center.*/
+  static void CreateSamples(int numberOfSamples, unsigned int seed, Eigen::MatrixXd &X, Eigen::MatrixXi &Y)
+  {
+    std::mt19937 generator(seed);
+    std::normal_distribution<double> noise(0.0, 1.5);
+
+    X.resize(numberOfSamples, NumberOfFeatures);
+    Y.resize(numberOfSamples, 1);
+
+    for (int i = 0; i < numberOfSamples; ++i)
+    {
+      const int label = i % NumberOfClasses;
+      Y(i, 0) = label;
+
+      for (int j = 0; j < NumberOfFeatures; ++j)
+        X(i, j) = ((j + label) % NumberOfClasses) + noise(generator);
+    }
+  }
+
+public:
+  void PredictBlocked_LargeDataSet_FasterThanPredict()
+  {
+    Eigen::MatrixXd trainingFeatures;
+    Eigen::MatrixXi trainingLabels;
+    CreateSamples(5000, 1, trainingFeatures, trainingLabels);
+
+    Eigen::MatrixXd X;
+    Eigen::MatrixXi labels;
+    CreateSamples(500000, 2, X, labels);
+
+    auto classifier = mitk::VigraRandomForestClassifier::New();
+    classifier->SetTreeCount(100);
+    classifier->Train(trainingFeatures, trainingLabels);
+    CPPUNIT_ASSERT(classifier->SupportsBlockedPrediction());
+
+    // The first call compiles the flattened forest, which is not part of the comparison
+    classifier->PredictBlocked(trainingFeatures);
+
+    itk::TimeProbe vigraProbe;
+    vigraProbe.Start();
+    Eigen::MatrixXi classes = classifier->Predict(X);
+    vigraProbe.Stop();
+    Eigen::MatrixXd probabilities = classifier->GetPointWiseProbabilities();
+
+    itk::TimeProbe blockedProbe;
+    blockedProbe.Start();
+    Eigen::MatrixXi blockedClasses = classifier->PredictBlocked(X);
+    blockedProbe.Stop();
+    Eigen::MatrixXd blockedProbabilities = classifier->GetPointWiseProbabilities();
+
+    MITK_INFO << "Prediction of " << X.rows() << " samples with " << NumberOfFeatures << " features. Predict: "
+              << vigraProbe.GetTotal() << " s; PredictBlocked: " << blockedProbe.GetTotal() << " s";
+
+    CPPUNIT_ASSERT_MESSAGE("Blocked prediction returns the same labels as Predict()", classes == blockedClasses);
+    CPPUNIT_ASSERT_MESSAGE("Blocked prediction returns the same probabilities as Predict()", probabilities == blockedProbabilities);
+    CPPUNIT_ASSERT_MESSAGE("Blocked prediction is faster than Predict()", blockedProbe.GetTotal() < vigraProbe.GetTotal());
+  }
+};
+
+MITK_TEST_SUITE_REGISTRATION(mitkVigraRandomForestBenchmark)
@@ -35,6 +35,7 @@ class mitkVigraRandomForestTestSuite : public mitk::TestFixture
   MITK_TEST(TrainThreadedDecisionForest_MatlabDataSet_shouldReturnTrue);
   MITK_TEST(PredictWeightedDecisionForest_SetWeightsToZero_shouldReturnTrue);
   MITK_TEST(TrainThreadedDecisionForest_BreastCancerDataSet_shouldReturnTrue);
+  MITK_TEST(PredictBlocked_BreastCancerDataSet_EqualsPredict);
   CPPUNIT_TEST_SUITE_END();
 
 private:
@@ -172,6 +173,37 @@ public:
   }
 
 
+  // ------------------------------------------------------------------------------------------------------
+  // ------------------------------------------------------------------------------------------------------
+  /*
+  The blocked prediction uses a flattened copy of the forest and has to return exactly
+  the same labels and probabilities as the vigra based prediction. The test data is
+  replicated to get more samples than fit into a single block.
+  */
+  void PredictBlocked_BreastCancerDataSet_EqualsPredict()
+  {
+    auto & Features_Training = FeatureData_Cancer.first;
+    auto & Features_Testing = FeatureData_Cancer.second;
+    auto & Labels_Training = LabelData_Cancer.first;
+
+    classifier->Train(Features_Training,Labels_Training);
+    CPPUNIT_ASSERT(classifier->SupportsBlockedPrediction());
+
+    const int replications = 4;
+    MatrixDoubleType X(Features_Testing.rows() * replications, Features_Testing.cols());
+    for (int i = 0; i < replications; ++i)
+      X.block(i * Features_Testing.rows(), 0, Features_Testing.rows(), Features_Testing.cols()) = Features_Testing;
+
+    Eigen::MatrixXi classes = classifier->Predict(X);
+    Eigen::MatrixXd probabilities = classifier->GetPointWiseProbabilities();
+
+    Eigen::MatrixXi blockedClasses = classifier->PredictBlocked(X);
+    Eigen::MatrixXd blockedProbabilities = classifier->GetPointWiseProbabilities();
+
+    CPPUNIT_ASSERT_MESSAGE("Blocked prediction returns the same labels as Predict()", classes == blockedClasses);
+    CPPUNIT_ASSERT_MESSAGE("Blocked prediction returns the same probabilities as Predict()", probabilities == blockedProbabilities);
+  }
+
   // ------------------------------------------------------------------------------------------------------
   // ------------------------------------------------------------------------------------------------------
   /*Reading an file, which includes the trainingdataset and the testdataset, and convert the
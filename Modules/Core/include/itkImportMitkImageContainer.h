@@ -16,6 +16,7 @@ found in the LICENSE file.
 #include <itkImportImageContainer.h>
 #include <mitkImageAccessorBase.h>
 #include <mitkImageDataItem.h>
+#include <mitkImageSnapshot.h>
 
 namespace itk
 {
@@ -61,6 +62,9 @@ namespace itk
     // void SetImageDataItem(mitk::ImageDataItem* imageDataItem);
     void SetImageAccessor(mitk::ImageAccessorBase *imageAccess, size_t noBytes);
 
+    /** \brief Set the mitk::ImageSnapshot to be imported. The container keeps the data of the snapshot alive.  */
+    void SetImageSnapshot(const mitk::ImageSnapshot &snapshot, const void *data, size_t noBytes);
+
   protected:
     ImportMitkImageContainer();
     ~ImportMitkImageContainer() override;
@@ -76,6 +80,7 @@ namespace itk
 
     // mitk::ImageDataItem::Pointer m_ImageDataItem;
     mitk::ImageAccessorBase *m_imageAccess;
+    mitk::ImageSnapshot m_ImageSnapshot;
   };
 
 } // end namespace itk
@@ -55,6 +55,18 @@ namespace itk
     this->Modified();
   }
 
+  template <typename TElementIdentifier, typename TElement>
+  void ImportMitkImageContainer<TElementIdentifier, TElement>::SetImageSnapshot(const mitk::ImageSnapshot &snapshot,
+                                                                                const void *data,
+                                                                                size_t noOfBytes)
+  {
+    m_ImageSnapshot = snapshot;
+
+    this->SetImportPointer((TElement *)const_cast<void *>(data), noOfBytes / sizeof(Element), false);
+
+    this->Modified();
+  }
+
   template <typename TElementIdentifier, typename TElement>
   void ImportMitkImageContainer<TElementIdentifier, TElement>::PrintSelf(std::ostream &os, Indent indent) const
   {
@@ -0,0 +1,93 @@
+/*============================================================================
+
+The Medical Imaging Interaction Toolkit (MITK)
+
+Copyright (c) German Cancer Research Center (DKFZ)
+All rights reserved.
+
+Use of this source code is governed by a 3-clause BSD license that can be
+found in the LICENSE file.
+
+============================================================================*/
+
+#ifndef mitkAsynchronousReslicer_h
+#define mitkAsynchronousReslicer_h
+
+#include <MitkCoreExports.h>
+#include <mitkImage.h>
+#include <mitkResliceCache.h>
+
+#include <memory>
+
+class vtkImageReslice;
+class vtkRenderWindow;
+
+namespace mitk
+{
+  class RenderingManager;
+
+  /** \brief Computes a slice on a dedicated background thread.
+
+    Used by 2D image mappers for progressive refinement (see RenderingManager::SetAsynchronousSliceRendering()):
+    the mapper reslices with nearest neighbor interpolation to show a preview immediately and starts the
+    reslicing with the requested interpolation here. The worker only uses VTK objects that are owned by the
+    request. Once the slice is finished, an update of the render window is requested via
+    RenderingManager::RequestAsynchronousUpdate() and the mapper picks up the result with TakeResult().
+
+    Only the latest request is of interest: starting a new request or calling Abort() aborts the running
+    request and its result is discarded.
+
+    The requests of all reslicers share one background thread. A request reads the image under an
+    ImageReadAccessor and therefore waits for running writers; on a thread of the ITK thread pool this could
+    deadlock with writers that run ITK filters.
+  */
+  class MITKCORE_EXPORT AsynchronousReslicer
+  {
+  public:
+    AsynchronousReslicer();
+    ~AsynchronousReslicer();
+
+    AsynchronousReslicer(const AsynchronousReslicer &) = delete;
+    AsynchronousReslicer &operator=(const AsynchronousReslicer &) = delete;
+
+    /** \brief Starts reslicing in the background.
+      \param key Identifies the requested slice. It is passed to TakeResult() to get the slice.
+      \param image Image to reslice; kept alive until the request is finished.
+      \param timeStep Time step of the image.
+      \param previewReslicer Executed reslicer of the preview; output geometry and reslice transformation are copied.
+      \param interpolation Interpolation mode of the requested slice (VTK_RESLICE_LINEAR or VTK_RESLICE_CUBIC).
+      \param clippedPlaneBounds Bounds of the slice, stored with the result.
+      \param spacing Spacing of the slice, stored with the result.
+      \param renderingManager Rendering manager that is notified when the slice is finished.
+      \param renderWindow Render window to update when the slice is finished.
+      \return false if the preview reslicer cannot be copied (e.g. a non-linear reslice transformation).*/
+    bool Start(const ResliceCache::Key &key,
+               const Image *image,
+               TimeStepType timeStep,
+               vtkImageReslice *previewReslicer,
+               int interpolation,
+               const double clippedPlaneBounds[6],
+               const ScalarType spacing[2],
+               RenderingManager *renderingManager,
+               vtkRenderWindow *renderWindow);
+
+    /** \brief Aborts the running request and discards a finished but not yet taken result.*/
+    void Abort();
+
+    /** \brief True if the slice identified by the key is currently computed.*/
+    bool IsRunning(const ResliceCache::Key &key) const;
+
+    /** \brief True if a finished slice is waiting to be taken.*/
+    bool HasResult() const;
+
+    /** \brief Returns the finished slice if it is identified by the key, otherwise nullptr. A returned slice is
+      removed, a result for another key is discarded.*/
+    ResliceCache::SliceConstPointer TakeResult(const ResliceCache::Key &key);
+
+  private:
+    struct State;
+    std::shared_ptr<State> m_State;
+  };
+}
+
+#endif
@@ -0,0 +1,85 @@
+/*============================================================================
+
+The Medical Imaging Interaction Toolkit (MITK)
+
+Copyright (c) German Cancer Research Center (DKFZ)
+All rights reserved.
+
+Use of this source code is governed by a 3-clause BSD license that can be
+found in the LICENSE file.
+
+============================================================================*/
+
+#ifndef mitkChunkedGzipCodec_h
+#define mitkChunkedGzipCodec_h
+
+#include <MitkCoreExports.h>
+
+#include <cstddef>
+#include <functional>
+#include <iosfwd>
+
+namespace mitk
+{
+  /**
+   * \brief Compresses and decompresses data as a multi-member gzip stream in parallel.
+   *
+   * The data is split into independent chunks that are compressed concurrently. Every chunk
+   * becomes a complete gzip member (RFC 1952), so the concatenated result is a valid gzip
+   * stream that any gzip-capable reader (e.g. zlib's gzread(), used by the NRRD reader) can
+   * decompress sequentially.
+   *
+   * Additionally, the header of every member carries an extra field with the compressed and
+   * uncompressed size of the chunk. Standard readers ignore it, but it allows Decompress()
+   * to locate all members without inflating them and to decompress them concurrently, too.
+   */
+  class MITKCORE_EXPORT ChunkedGzipCodec
+  {
+  public:
+    /** \brief Default number of uncompressed bytes per gzip member (4 MiB).*/
+    static const std::size_t DEFAULT_CHUNK_SIZE;
+
+    /** \brief Largest supported number of uncompressed bytes per gzip member (1 GiB).*/
+    static const std::size_t MAXIMUM_CHUNK_SIZE;
+
+    /**
+     * \brief Compresses size bytes of data into the stream.
+     *
+     * \param level zlib compression level from 0 (none) to 9 (best), -1 for the zlib default.
+     * \param chunkSize Number of uncompressed bytes per gzip member.
+     * \throw mitk::Exception if the parameters are invalid, the compression fails or the stream cannot be written.
+     */
+    static void Compress(const void* data, std::size_t size, std::ostream& stream, int level = -1, std::size_t chunkSize = DEFAULT_CHUNK_SIZE);
+
+    /** \brief Writes size bytes of a chunk starting at offset into buffer.*/
+    using FillFunction = std::function<void(std::size_t offset, std::size_t size, void* buffer)>;
+
+    /**
+     * \brief Compresses size bytes into the stream that are provided chunk by chunk by fill.
+     *
+     * Use this overload for data that does not exist as a contiguous buffer, e.g. data that
+     * is rearranged while it is written. fill is called concurrently for different chunks,
+     * and only the chunks that are compressed at the same time are held in memory.
+     *
+     * \throw mitk::Exception like Compress(const void*, std::size_t, std::ostream&, int, std::size_t).
+     */
+    static void Compress(std::size_t size, const FillFunction& fill, std::ostream& stream, int level = -1, std::size_t chunkSize = DEFAULT_CHUNK_SIZE);
+
+    /**
+     * \brief Checks if the stream continues with a gzip member written by Compress().
+     *
+     * The read position of the stream is restored.
+     */
+    static bool IsChunked(std::istream& stream);
+
+    /**
+     * \brief Decompresses size bytes from a stream written by Compress() into data.
+     *
+     * \throw mitk::Exception if the stream was not written by Compress(), is truncated or corrupt,
+     * or does not contain exactly size bytes of uncompressed data.
+     */
+    static void Decompress(std::istream& stream, void* data, std::size_t size);
+  };
+}
+
+#endif
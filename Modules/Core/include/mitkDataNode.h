@@ -65,7 +65,7 @@ namespace mitk
   public:
     typedef mitk::Geometry3D::Pointer Geometry3DPointer;
     typedef std::vector<itk::SmartPointer<Mapper>> MapperVector;
-    typedef std::map<std::string, mitk::PropertyList::Pointer> MapOfPropertyLists;
+    typedef std::map<std::string, mitk::PropertyList::Pointer, std::less<>> MapOfPropertyLists;
     typedef std::vector<MapOfPropertyLists::key_type> PropertyListKeyNames;
     typedef std::set<std::string> GroupTagList;
 
@@ -231,6 +231,15 @@ namespace mitk
      */
     mitk::BaseProperty *GetProperty(const char *propertyKey, const mitk::BaseRenderer *renderer = nullptr, bool fallBackOnDataProperties = true) const;
 
+    /**
+     * \brief Get the property by its interned key with the same lookup order as
+     * GetProperty(const char*, const mitk::BaseRenderer*, bool).
+     *
+     * Prefer this overload for properties that are read for every rendered frame.
+     * \sa PropertyKeys
+     */
+    mitk::BaseProperty *GetProperty(const PropertyKey &propertyKey, const mitk::BaseRenderer *renderer = nullptr, bool fallBackOnDataProperties = true) const;
+
     /**
      * \brief Get the property of type T with key \a propertyKey from the PropertyList
      * of the \a renderer, if available there, otherwise use the BaseRenderer-independent PropertyList.
@@ -296,6 +305,12 @@ namespace mitk
      */
     bool GetBoolProperty(const char *propertyKey, bool &boolValue, const mitk::BaseRenderer *renderer = nullptr) const;
 
+    /**
+     * \brief Convenience access method for bool properties by an interned key
+     * \return \a true property was found
+     */
+    bool GetBoolProperty(const PropertyKey &propertyKey, bool &boolValue, const mitk::BaseRenderer *renderer = nullptr) const;
+
     /**
      * \brief Convenience access method for int properties (instances of
      * IntProperty)
@@ -303,6 +318,12 @@ namespace mitk
      */
     bool GetIntProperty(const char *propertyKey, int &intValue, const mitk::BaseRenderer *renderer = nullptr) const;
 
+    /**
+     * \brief Convenience access method for int properties by an interned key
+     * \return \a true property was found
+     */
+    bool GetIntProperty(const PropertyKey &propertyKey, int &intValue, const mitk::BaseRenderer *renderer = nullptr) const;
+
     /**
      * \brief Convenience access method for float properties (instances of
      * FloatProperty)
@@ -312,6 +333,14 @@ namespace mitk
                           float &floatValue,
                           const mitk::BaseRenderer *renderer = nullptr) const;
 
+    /**
+     * \brief Convenience access method for float properties by an interned key
+     * \return \a true property was found
+     */
+    bool GetFloatProperty(const PropertyKey &propertyKey,
+                          float &floatValue,
+                          const mitk::BaseRenderer *renderer = nullptr) const;
+
     /**
      * \brief Convenience access method for double properties (instances of
      * DoubleProperty)
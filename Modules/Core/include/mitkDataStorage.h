@@ -418,6 +418,20 @@ namespace mitk
     DataStorage();
     ~DataStorage() override;
 
+    //##Documentation
+    //## @brief Returns the nodes that GetSubset() checks against the condition
+    //##
+    //## The default implementation returns GetAll(). Subclasses with secondary indexes may return a
+    //## smaller set, as long as it contains every node that meets the condition in the order of GetAll().
+    virtual SetOfObjects::ConstPointer GetSubsetCandidates(const NodePredicateBase *condition) const;
+
+    //##Documentation
+    //## @brief Returns the nodes that GetNamedNode() checks for the name
+    //##
+    //## The default implementation returns GetAll(). Subclasses with a name index may return a
+    //## smaller set, as long as it contains every node with this name in the order of GetAll().
+    virtual SetOfObjects::ConstPointer GetNamedNodeCandidates(const std::string &name) const;
+
     //##Documentation
     //## @brief Filters a SetOfObjects by the condition. If no condition is provided, the original set is returned
     SetOfObjects::ConstPointer FilterSetOfObjects(const SetOfObjects *set, const NodePredicateBase *condition) const;
@@ -0,0 +1,37 @@
+/*============================================================================
+
+The Medical Imaging Interaction Toolkit (MITK)
+
+Copyright (c) German Cancer Research Center (DKFZ)
+All rights reserved.
+
+Use of this source code is governed by a 3-clause BSD license that can be
+found in the LICENSE file.
+
+============================================================================*/
+
+#ifndef mitkDedicatedThreads_h
+#define mitkDedicatedThreads_h
+
+#include <MitkCoreExports.h>
+
+#include <cstddef>
+
+namespace mitk
+{
+  /**
+    \brief Number of dedicated threads (std::thread) to run independent tasks concurrently.
+
+    Tasks that run ITK filters themselves, like readers or surface and preview computations,
+    must not be distributed by the ITK thread pool: the filters queue their work units in the
+    same pool and would wait for work that is queued behind the tasks. Such tasks are run on
+    dedicated threads instead, and all of them use this function to decide how many.
+
+    The number follows itk::MultiThreaderBase::GetGlobalDefaultNumberOfThreads(), so that
+    the usual ITK settings (e.g. ITK_GLOBAL_DEFAULT_NUMBER_OF_THREADS=1) also serialize
+    these tasks. It is at least 1 and at most \c numberOfTasks (unless that is 0).
+  */
+  MITKCORE_EXPORT unsigned int GetNumberOfDedicatedThreads(std::size_t numberOfTasks);
+}
+
+#endif
@@ -65,6 +65,11 @@ namespace mitk
      * in a corresponding \c std::vector<std::string> value. the same option key
      * without the 'enum' segment is considered to hold the current selection from
      * the enumeration.
+     *
+     * If the first segment of a key is equal to the string 'advanced', the option
+     * has a default that suits almost every use case. A graphical user interface
+     * should not ask the user for options just because such an option exists, but
+     * only if there are other options or several readers or writers to choose from.
      */
     typedef std::map<std::string, us::Any> Options;
 
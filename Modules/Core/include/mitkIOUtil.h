@@ -69,10 +69,16 @@ namespace mitk
     /**Struct that is the base class for option callbacks used in load operations. The callback is used by IOUtil, if
     more than one suitable reader was found or the a reader contains options that can be set. The callback allows to
     change option settings and select the reader that should be used (via loadInfo).
+    A single reader whose options are all advanced (see IFileIO::Options) is no reason to call the callback, unless
+    CallForAdvancedOptions() returns true.
     */
     struct MITKCORE_EXPORT ReaderOptionsFunctorBase
     {
       virtual bool operator()(LoadInfo &loadInfo) const = 0;
+
+      /** Returns true if the callback also has to be called for a single reader with only advanced options,
+      e.g. because it sets options that were passed by the caller. The default returns false.*/
+      virtual bool CallForAdvancedOptions() const { return false; }
     };
 
     struct MITKCORE_EXPORT SaveInfo
@@ -97,10 +103,16 @@ namespace mitk
     /**Struct that is the base class for option callbacks used in save operations. The callback is used by IOUtil, if
     more than one suitable writer was found or the a writer contains options that can be set. The callback allows to
     change option settings and select the writer that should be used (via saveInfo).
+    A single writer whose options are all advanced (see IFileIO::Options) is no reason to call the callback, unless
+    CallForAdvancedOptions() returns true.
     */
     struct MITKCORE_EXPORT WriterOptionsFunctorBase
     {
       virtual bool operator()(SaveInfo &saveInfo) const = 0;
+
+      /** Returns true if the callback also has to be called for a single writer with only advanced options,
+      e.g. because it sets options that were passed by the caller. The default returns false.*/
+      virtual bool CallForAdvancedOptions() const { return false; }
     };
 
     /**
@@ -321,6 +333,44 @@ namespace mitk
     static std::vector<BaseData::Pointer> Load(const std::vector<std::string> &paths,
                                                const ReaderOptionsFunctorBase *optionsCallback = nullptr);
 
+    /**
+     * @brief Loads a list of file paths concurrently into the given DataStorage.
+     *
+     * Readers and their options are selected like in Load(const std::vector<std::string>&, DataStorage&,
+     * const ReaderOptionsFunctorBase*), in the calling thread. Afterwards, the files are read by their
+     * reader instances on up to \c numberOfThreads threads. Nodes are added to \c storage in the calling
+     * thread and in the order of \c paths.
+     *
+     * Use this method only for readers that do not depend on the content of \c storage while reading,
+     * since each reader reads into its own temporary DataStorage.
+     *
+     * Like Load(), files that were read together with another file (see IFileReader::GetReadFiles())
+     * are not read again. Files of the same reader type in the same directory are therefore read one
+     * after another until a read of them covers only its own file.
+     *
+     * @param paths A list of absolute file names including the file extension.
+     * @param storage A DataStorage object to which the loaded data will be added.
+     * @param optionsCallback Pointer to a callback instance. The callback is used by
+     * the load operation if more the suitable reader was found or the reader has options
+     * that can be set.
+     * @param numberOfThreads Maximum number of files read at once. 0 uses GetNumberOfDedicatedThreads().
+     * @return The set of added DataNode objects.
+     * @throws mitk::Exception listing all entries in \c paths that could not be loaded.
+     */
+    static DataStorage::SetOfObjects::Pointer LoadConcurrently(const std::vector<std::string> &paths,
+                                                               DataStorage &storage,
+                                                               const ReaderOptionsFunctorBase *optionsCallback = nullptr,
+                                                               unsigned int numberOfThreads = 0);
+
+    /**
+     * @brief Loads a list of file paths concurrently and returns the loaded data in the order of \c paths.
+     *
+     * @sa LoadConcurrently(const std::vector<std::string>&, DataStorage&, const ReaderOptionsFunctorBase*, unsigned int)
+     */
+    static std::vector<BaseData::Pointer> LoadConcurrently(const std::vector<std::string> &paths,
+                                                           const ReaderOptionsFunctorBase *optionsCallback = nullptr,
+                                                           unsigned int numberOfThreads = 0);
+
     /**
      * @brief Loads the contents of a us::ModuleResource and returns the corresponding mitk::BaseData
      * @param usResource a ModuleResource, representing a BaseData object
@@ -425,6 +475,12 @@ namespace mitk
                             DataStorage *ds,
                             const ReaderOptionsFunctorBase *optionsCallback);
 
+    static std::string LoadConcurrently(std::vector<LoadInfo> &loadInfos,
+                                        DataStorage::SetOfObjects *nodeResult,
+                                        DataStorage *ds,
+                                        const ReaderOptionsFunctorBase *optionsCallback,
+                                        unsigned int numberOfThreads);
+
     static std::string Save(const BaseData *data,
                             const std::string &mimeType,
                             const std::string &path,
@@ -17,6 +17,7 @@ found in the LICENSE file.
 #include "mitkImageAccessorBase.h"
 #include "mitkImageDataItem.h"
 #include "mitkImageDescriptor.h"
+#include "mitkImageSnapshot.h"
 #include "mitkImageVtkAccessor.h"
 #include "mitkLevelWindow.h"
 #include "mitkPlaneGeometry.h"
@@ -28,6 +29,9 @@ found in the LICENSE file.
 #include <itkHistogram.h>
 #endif
 
+#include <atomic>
+#include <memory>
+
 class vtkImageData;
 
 namespace itk
@@ -76,6 +80,7 @@ namespace mitk
     friend class ImageVtkWriteAccessor;
     friend class ImageReadAccessor;
     friend class ImageWriteAccessor;
+    friend class ImageSnapshot;
 
   public:
     mitkClassMacro(Image, SlicedData);
@@ -518,6 +523,13 @@ namespace mitk
       */
     StatisticsHolderPointer GetStatistics() const { return m_ImageStatistics; }
 
+    /** \brief Number of released ImageWriteAccessors.
+     *
+     * Writing through an accessor does not modify the image, so caches of the pixel data have to compare
+     * this count in addition to the modification time to detect changed data.
+     */
+    itk::SizeValueType GetWriteCount() const { return m_WriteCount.load(); }
+
   protected:
     mitkCloneMacro(Self);
 
@@ -613,6 +625,27 @@ namespace mitk
     mutable std::mutex m_ReadWriteLock;
     /** A mutex, which needs to be locked to manage m_VtkReaders */
     mutable std::mutex m_VtkReadersLock;
+
+    /** \brief Returns the buffer of the current data version. The buffer shares the data of the image.
+     * \sa ImageSnapshot */
+    std::shared_ptr<const ImageSnapshot::Buffer> GetSnapshotBuffer() const;
+
+    /** \brief Moves the data of the first channel to new memory if a snapshot still shares it, so that the
+     * snapshot keeps the data version it was taken of. Has to be called before the data is written.
+     * A call of this method is prohibited unless m_ReadWriteLock is locked. */
+    void DetachSnapshotData_unlocked();
+    void DetachSnapshotData();
+
+    /** Buffer of the current data version. It is only accessed by the atomic functions of std::shared_ptr,
+     *  so that snapshots of an unchanged image are taken without locking a mutex. */
+    mutable std::shared_ptr<const ImageSnapshot::Buffer> m_Snapshot;
+    /** A mutex, which serializes the creation of snapshot buffers, so that each data version is shared once */
+    mutable std::mutex m_SnapshotLock;
+    /** Previous memory of moved data, which is kept alive until the ImageReadAccessors and
+     *  ImageWriteAccessors, which may still use it, are released. Managed with m_ReadWriteLock locked */
+    mutable std::vector<std::shared_ptr<unsigned char>> m_RetiredData;
+    /** Number of released ImageWriteAccessors to detect changes of the data since the latest snapshot */
+    std::atomic<itk::SizeValueType> m_WriteCount;
   };
 
   /**
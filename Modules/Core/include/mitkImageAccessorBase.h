@@ -104,6 +104,10 @@ namespace mitk
     /** ImageAccessor has access to the image it belongs to. */
     // ImagePointer m_Image;
 
+    /** The accessed image part. Its memory may be moved by the copy-on-write of image snapshots as long as
+     * the accessor is not registered at the image (see UpdateAddresses()). */
+    const ImageDataItem *m_ImageDataItem;
+
     /** Contains a SubRegion (always represented in maximal possible dimension) */
     itk::ImageRegion<4> *m_SubRegion;
 
@@ -133,6 +137,10 @@ namespace mitk
       */
     bool Overlap(const ImageAccessorBase *iAB);
 
+    /** \brief Updates m_AddressBegin and m_AddressEnd from m_ImageDataItem. A call of this method is prohibited
+     * unless the Mutex m_ReadWriteLock in the mitk::Image class is Locked. */
+    void UpdateAddresses();
+
     /** \brief Uses the WaitLock to wait for another ImageAccessor*/
     void WaitForReleaseOf(ImageAccessorWaitLock *wL);
 
@@ -0,0 +1,106 @@
+/*============================================================================
+
+The Medical Imaging Interaction Toolkit (MITK)
+
+Copyright (c) German Cancer Research Center (DKFZ)
+All rights reserved.
+
+Use of this source code is governed by a 3-clause BSD license that can be
+found in the LICENSE file.
+
+============================================================================*/
+
+#ifndef mitkImageDataBufferPool_h
+#define mitkImageDataBufferPool_h
+
+#include <MitkCoreExports.h>
+
+#include <itkIntTypes.h>
+
+#include <cstddef>
+#include <map>
+#include <mutex>
+#include <vector>
+
+namespace mitk
+{
+  /**
+   * @brief Process wide pool of the data buffers that ImageDataItem allocates itself.
+   *
+   * Interactive tools create and destroy images of the same size at frame rate, e.g. extracted
+   * slices or previews. Instead of returning their buffers to the system allocator, released
+   * buffers are kept in free lists of size classes and handed out again for following requests
+   * of the same size class. Size classes are spaced by a quarter of a power of two, so a buffer
+   * is at most 25% larger than requested.
+   *
+   * Poolable buffers are allocated by new unsigned char[] with the size of their size class. Hence,
+   * they may still be deleted by delete[] instead of being released to the pool. Like memory from
+   * new[], buffers are not initialized.
+   *
+   * The pool keeps at most GetMaximumResidentSize() bytes in its free lists. Buffers larger than
+   * a quarter of this size are never kept, so they are allocated with the exact requested size.
+   * Setting the maximum resident size to 0 disables the pool.
+   *
+   * All methods are thread-safe.
+   *
+   * @ingroup Data
+   */
+  class MITKCORE_EXPORT ImageDataBufferPool
+  {
+  public:
+    struct Statistics
+    {
+      /** Number of calls to Allocate(). */
+      itk::SizeValueType Requests;
+      /** Number of calls to Allocate() that were served from a free list. */
+      itk::SizeValueType Hits;
+      /** Number of bytes currently kept in the free lists. */
+      std::size_t ResidentSize;
+      /** Number of buffers currently kept in the free lists. */
+      std::size_t ResidentBuffers;
+
+      double GetHitRate() const { return Requests > 0 ? static_cast<double>(Hits) / Requests : 0.0; }
+    };
+
+    static ImageDataBufferPool *GetInstance();
+
+    /** @brief Returns the size of the buffers that are allocated for requests of @a size bytes. */
+    static std::size_t GetSizeClass(std::size_t size);
+
+    /**
+     * @brief Returns a buffer of at least @a size bytes.
+     *
+     * @a pooled is set to whether the buffer has the size of its size class and may be released to the pool.
+     * Otherwise, e.g. if the pool is disabled, the buffer has exactly @a size bytes and has to be deleted by delete[].
+     */
+    unsigned char *Allocate(std::size_t size, bool &pooled);
+
+    /** @brief Takes back a buffer that was returned by Allocate() for the same @a size with @a pooled set to true. */
+    void Release(unsigned char *buffer, std::size_t size);
+
+    void SetMaximumResidentSize(std::size_t maximumResidentSize);
+    std::size_t GetMaximumResidentSize() const;
+
+    Statistics GetStatistics() const;
+    void ResetStatistics();
+
+    /** @brief Returns all buffers of the free lists to the system allocator. */
+    void Clear();
+
+  private:
+    ImageDataBufferPool();
+    ~ImageDataBufferPool();
+
+    ImageDataBufferPool(const ImageDataBufferPool &) = delete;
+    ImageDataBufferPool &operator=(const ImageDataBufferPool &) = delete;
+
+    void ShrinkToMaximumResidentSize();
+
+    mutable std::mutex m_Mutex;
+    std::map<std::size_t, std::vector<unsigned char *>> m_FreeBuffers;
+    std::size_t m_MaximumResidentSize;
+    Statistics m_Statistics;
+  };
+}
+
+#endif
@@ -17,6 +17,8 @@ found in the LICENSE file.
 #include <MitkCoreExports.h>
 #include "mitkImageDescriptor.h"
 
+#include <memory>
+
 class vtkImageData;
 
 namespace mitk
@@ -130,12 +132,35 @@ namespace mitk
     * to get access.*/
     void* GetData() const { return m_Data; }
 
+    /** Returns an owner of the memory of the root item, which keeps the memory alive independent of the item
+    * (see ImageSnapshot). Returns nullptr if the root item does not manage its memory.*/
+    std::shared_ptr<const unsigned char> ShareData() const;
+
+    /** Whether the memory of this root item is still referenced by an owner returned by ShareData().*/
+    bool IsDataShared() const;
+
+    /** Moves the data of this root item to new memory, which is owned by the item alone. Sub-items have to
+    * be moved by RebaseData(). Returns the owner of the previous memory, which is released with it.*/
+    std::shared_ptr<unsigned char> CopySharedData();
+
+    /** Points this item and its vtkImageData into the new memory of its root item, if it points into the
+    * previous memory [oldRootData, oldRootData + rootSize).*/
+    void RebaseData(const unsigned char *oldRootData, unsigned char *newRootData, size_t rootSize);
+
     unsigned char *m_Data;
 
+    /** Owner of m_Data of a root item once it is shared by ShareData(). The memory is then released with
+    * the last owner instead of the item.*/
+    mutable std::shared_ptr<unsigned char> m_SharedData;
+
     PixelType *m_PixelType;
 
     bool m_ManageMemory;
 
+    /** Whether m_Data was obtained from ImageDataBufferPool with the size of its size class and is released
+     * to the pool. Otherwise, it is deleted by delete[].*/
+    bool m_PooledMemory;
+
     mutable vtkImageData *m_VtkImageData;
     mutable ImageVtkReadAccessor *m_VtkImageReadAccessor;
     ImageVtkWriteAccessor *m_VtkImageWriteAccessor;
@@ -0,0 +1,132 @@
+/*============================================================================
+
+The Medical Imaging Interaction Toolkit (MITK)
+
+Copyright (c) German Cancer Research Center (DKFZ)
+All rights reserved.
+
+Use of this source code is governed by a 3-clause BSD license that can be
+found in the LICENSE file.
+
+============================================================================*/
+
+#ifndef mitkImageSnapshot_h
+#define mitkImageSnapshot_h
+
+#include <MitkCoreExports.h>
+#include <mitkPixelType.h>
+#include <mitkTimeGeometry.h>
+
+#include <itkIntTypes.h>
+
+#include <vtkSmartPointer.h>
+
+#include <cstddef>
+#include <memory>
+#include <vector>
+
+class vtkImageData;
+
+namespace mitk
+{
+  class Image;
+
+  /**
+   * @brief Immutable, read-only view of the data of an image at the time the snapshot was taken.
+   *
+   * In contrast to ImageReadAccessor, a snapshot is not registered at the image and holding it
+   * never blocks writers. A snapshot shares the memory of the image instead of copying it. The data
+   * is only copied when an ImageWriteAccessor is created or data is set by SetImportSlice(),
+   * SetImportVolume() or SetImportChannel() while a snapshot is still referenced: the image then
+   * continues on a copy, while the snapshots keep the previous memory, which is released with the
+   * last snapshot using it. Images, which do not manage their memory (see Image::ReferenceMemory),
+   * are copied once per data version.
+   *
+   * Snapshots of an unchanged image are taken without locking a mutex. Only the first snapshot after
+   * a change locks a mutex of the image and waits for running writers. Releasing a snapshot does not
+   * lock any mutex.
+   *
+   * The data is considered to be changed whenever an ImageWriteAccessor is released or the image
+   * is modified (see itk::Object::Modified()). Data written by other means, e.g. through
+   * vtkImageData or mitk::ImageVtkWriteAccessor, bypasses the copy-on-write and is visible in the
+   * snapshots sharing the memory.
+   *
+   * Snapshots are cheap to copy and may be passed between threads. VTK and ITK consumers get views
+   * of the data without copying it (see GetVtkImageData() and ImageToItkImage(const ImageSnapshot&)).
+   * \code
+   * mitk::ImageSnapshot snapshot(image);
+   * auto *data = static_cast<const unsigned short *>(snapshot.GetVolumeData(t));
+   * \endcode
+   *
+   * @ingroup Data
+   */
+  class MITKCORE_EXPORT ImageSnapshot
+  {
+  public:
+    /** @brief Shared buffer of a snapshot. Only created by mitk::Image. */
+    struct Buffer
+    {
+      Buffer(const PixelType &pixelType,
+             std::vector<unsigned int> dimensions,
+             const void *data,
+             std::size_t size,
+             std::shared_ptr<const void> owner,
+             TimeGeometry::ConstPointer timeGeometry,
+             itk::ModifiedTimeType modifiedTime,
+             itk::SizeValueType writeCount);
+
+      PixelType Type;
+      std::vector<unsigned int> Dimensions;
+      /** Points into the memory kept alive by Owner. */
+      const char *Data;
+      std::size_t Size;
+      /** The memory of the image or, if the image does not manage its memory, a copy of it. */
+      std::shared_ptr<const void> Owner;
+      TimeGeometry::ConstPointer Geometry;
+      itk::ModifiedTimeType ModifiedTime;
+      itk::SizeValueType WriteCount;
+    };
+
+    /** @brief Creates an empty snapshot. */
+    ImageSnapshot();
+
+    /**
+     * @brief Takes a snapshot of the first channel of the image.
+     * @throws mitk::Exception if the image is not initialized.
+     */
+    explicit ImageSnapshot(const Image *image);
+
+    bool IsNull() const { return nullptr == m_Buffer; }
+
+    /** @brief Data of all time steps. */
+    const void *GetData() const;
+
+    /** @brief Data of time step @a t. */
+    const void *GetVolumeData(unsigned int t) const;
+
+    /** @brief Size of the data of all time steps in bytes. */
+    std::size_t GetSize() const;
+
+    const PixelType &GetPixelType() const;
+
+    unsigned int GetDimension() const;
+    unsigned int GetDimension(unsigned int i) const;
+
+    /** @brief Geometry of the image at the time the snapshot was taken. */
+    const TimeGeometry *GetTimeGeometry() const;
+
+    /**
+     * @brief Creates a vtkImageData, which views the data of time step @a t without copying it.
+     *
+     * The vtkImageData keeps the data alive, also after the snapshot was released, and must not be
+     * written to. Like the vtkImageData of mitk::Image, it has the spacing of the image and the origin (0, 0, 0).
+     * @throws mitk::Exception if the snapshot is empty, @a t is out of range or VTK does not support the pixel type.
+     */
+    vtkSmartPointer<vtkImageData> GetVtkImageData(unsigned int t = 0) const;
+
+  private:
+    std::shared_ptr<const Buffer> m_Buffer;
+  };
+}
+
+#endif
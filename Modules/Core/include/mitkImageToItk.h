@@ -15,6 +15,7 @@ found in the LICENSE file.
 
 #include "mitkImage.h"
 #include "mitkImageDataItem.h"
+#include "mitkImageSnapshot.h"
 #include "mitkImageWriteAccessor.h"
 
 #include <itkImage.h>
@@ -174,6 +175,31 @@ namespace mitk
     return imagetoitk->GetOutput();
   }
 
+  /**
+   * @brief Convert a MITK image snapshot to an ITK image.
+   *
+   * This method creates a read-only itk::Image representation of time step
+   * @a t of the given snapshot, referencing the memory of the snapshot. In
+   * contrast to ImageToItkImage(const mitk::Image*), the image of the snapshot
+   * is not locked and the returned itk::Image keeps the data of the snapshot
+   * alive. The geometry is taken from the image at the time the snapshot was taken.
+   *
+   * @tparam TPixel The pixel type of the ITK image
+   * @tparam VDimension The image dimension of the ITK image
+   * @param snapshot The snapshot which is to be converted to an ITK image
+   * @param t The time step to be converted, if VDimension is less than 4
+   * @return An ITK image representation for the given snapshot
+   * @throws mitk::Exception if the snapshot is empty or the pixel type or
+   *         dimension does not match the snapshot.
+   *
+   * @sa ImageSnapshot
+   *
+   * @ingroup Adaptor
+   */
+  template <typename TPixel, unsigned int VDimension>
+  typename itk::Image<TPixel, VDimension>::ConstPointer ImageToItkImage(const mitk::ImageSnapshot &snapshot,
+                                                                         unsigned int t = 0);
+
 } // end namespace mitk
 
 #ifndef ITK_MANUAL_INSTANTIATION
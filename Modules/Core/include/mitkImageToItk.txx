@@ -287,4 +287,80 @@ void mitk::ImageToItk<TOutputImage>::PrintSelf(std::ostream &os, itk::Indent ind
   Superclass::PrintSelf(os, indent);
 }
 
+template <typename TPixel, unsigned int VDimension>
+typename itk::Image<TPixel, VDimension>::ConstPointer mitk::ImageToItkImage(const mitk::ImageSnapshot &snapshot,
+                                                                             unsigned int t)
+{
+  typedef itk::Image<TPixel, VDimension> ImageType;
+  typedef itk::ImportMitkImageContainer<itk::SizeValueType, typename ImageType::InternalPixelType> ContainerType;
+
+  if (snapshot.IsNull())
+    mitkThrow() << "Cannot convert an empty snapshot to an ITK image.";
+
+  // a 3D ITK image may view a single time step of a 4D snapshot
+  const bool volumeOfTimeSeries = VDimension == 3 && snapshot.GetDimension() == 4;
+
+  if (snapshot.GetDimension() != VDimension && !volumeOfTimeSeries)
+  {
+    mitkThrow() << "Snapshot has dimension " << snapshot.GetDimension() << " instead of " << VDimension;
+  }
+
+  if (!(snapshot.GetPixelType() ==
+        mitk::MakePixelType<ImageType>(snapshot.GetPixelType().GetNumberOfComponents())))
+  {
+    mitkThrow() << "Snapshot has wrong pixel type " << snapshot.GetPixelType().GetTypeAsString();
+  }
+
+  const unsigned int itkDimMax3 = (VDimension < 3 ? VDimension : 3);
+  const auto geometry = snapshot.GetTimeGeometry()->GetGeometryForTimeStep(volumeOfTimeSeries ? t : 0);
+
+  typename ImageType::SizeType size;
+  typename ImageType::SpacingType spacing;
+  typename ImageType::PointType origin;
+  typename ImageType::DirectionType direction;
+
+  origin.Fill(0.0);
+  spacing.Fill(1.0);
+  direction.SetIdentity();
+
+  unsigned int i;
+  for (i = 0; i < VDimension; ++i)
+    size[i] = snapshot.GetDimension(i);
+
+  for (i = 0; i < itkDimMax3; ++i)
+  {
+    spacing[i] = geometry->GetSpacing()[i];
+    origin[i] = geometry->GetOrigin()[i];
+  }
+
+  // as in ImageToItk, 2D images with a 3D rotation get no rotation at all
+  const AffineTransform3D::MatrixType &matrix = geometry->GetIndexToWorldTransform()->GetMatrix();
+  if (VDimension != 2 || ((matrix[0][2] == 0) && (matrix[1][2] == 0) && (matrix[2][0] == 0) &&
+                          (matrix[2][1] == 0) && ((matrix[2][2] == 1) || (matrix[2][2] == -1))))
+  {
+    for (i = 0; i < itkDimMax3; ++i)
+      for (unsigned int j = 0; j < itkDimMax3; ++j)
+        direction[i][j] = matrix[i][j] / spacing[j];
+  }
+
+  const void *data = volumeOfTimeSeries ? snapshot.GetVolumeData(t) : snapshot.GetData();
+  const std::size_t noBytes = volumeOfTimeSeries ? snapshot.GetSize() / snapshot.GetDimension(3) : snapshot.GetSize();
+
+  auto container = ContainerType::New();
+  container->SetImageSnapshot(snapshot, data, noBytes);
+
+  typename ImageType::IndexType start;
+  start.Fill(0);
+  typename ImageType::RegionType region(start, size);
+
+  auto image = ImageType::New();
+  image->SetRegions(region);
+  image->SetOrigin(origin);
+  image->SetSpacing(spacing);
+  image->SetDirection(direction);
+  image->SetPixelContainer(container);
+
+  return image.GetPointer();
+}
+
 #endif // IMAGETOITK_TXX_INCLUDED_C1C2FCD2
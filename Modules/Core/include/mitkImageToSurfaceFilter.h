@@ -23,8 +23,11 @@ found in the LICENSE file.
 #include <vtkImageData.h>
 
 #include <vtkMarchingCubes.h>
+#include <vtkSmartPointer.h>
 #include <vtkSmoothPolyDataFilter.h>
 
+#include <functional>
+
 namespace mitk
 {
   /**
@@ -170,6 +173,19 @@ namespace mitk
      */
     itkGetConstMacro(TargetReduction, float);
 
+    /**
+     * Set the maximum number of time steps that are processed at once. The default value 0
+     * uses the number of work units of the default ITK multi-threader. The value 1 runs the
+     * filter completely in the calling thread, e.g. if several filters already run concurrently.
+     * The created surface does not depend on this value.
+     */
+    itkSetMacro(NumberOfThreads, unsigned int);
+
+    /**
+     * Returns the maximum number of time steps that are processed at once.
+     */
+    itkGetConstMacro(NumberOfThreads, unsigned int);
+
     /**
      * Transforms a point by a 4x4 matrix
      */
@@ -208,6 +224,24 @@ namespace mitk
      */
     void CreateSurface(int time, vtkImageData *vtkimage, mitk::Surface *surface, const ScalarType threshold);
 
+    /**
+     * Creates the surface of a single time step like CreateSurface() but returns it instead of
+     * setting it at the output. Neither the filter nor the input image is modified, so this
+     * method may be called concurrently for different time steps.
+     *
+     * @param time selected slice or "0" for single
+     * @param *vtkimage input image
+     * @param threshold can be different from SetThreshold()
+     */
+    vtkSmartPointer<vtkPolyData> CreatePolyData(int time, vtkImageData *vtkimage, const ScalarType threshold);
+
+    /**
+     * Calls \a process for the indices of \a numberOfTimeSteps time steps. Several time steps are
+     * processed concurrently unless NumberOfThreads is 1. Only one level is parallel: the second
+     * argument of \a process is true if the pipeline of the time step must not use threads itself.
+     */
+    void ProcessTimeSteps(std::size_t numberOfTimeSteps, const std::function<void(std::size_t, bool)> &process) const;
+
     /**
     * Flag whether the created surface shall be smoothed or not (default is "false"). SetSmooth (bool _arg)
     * */
@@ -240,6 +274,11 @@ namespace mitk
     * smoothRelaxation)
     * */
     float m_SmoothRelaxation;
+
+    /**
+    * The maximum number of time steps that are processed at once. See also SetNumberOfThreads (unsigned int _arg)
+    * */
+    unsigned int m_NumberOfThreads;
   };
 
 } // namespace mitk
@@ -17,6 +17,7 @@ found in the LICENSE file.
 #include <mitkCommon.h>
 
 // MITK Rendering
+#include "mitkAsynchronousReslicer.h"
 #include "mitkBaseRenderer.h"
 #include "mitkExtractSliceFilter.h"
 #include "mitkVtkMapper.h"
@@ -32,6 +33,7 @@ class vtkImageData;
 class vtkLookupTable;
 class vtkImageExtractComponents;
 class vtkImageReslice;
+class vtkMatrix4x4;
 class vtkImageChangeInformation;
 class vtkPoints;
 class vtkMitkThickSlicesFilter;
@@ -70,6 +72,11 @@ namespace mitk
    * be directly rendered in a 2D view or just be calculated to be used later by another
    * rendering entity, e.g. in texture mapping in a 3D view.
    *
+   * If asynchronous slice rendering is enabled (see RenderingManager::SetAsynchronousSliceRendering()),
+   * slices with linear or cubic "reslice interpolation" are first resliced with nearest neighbor
+   * interpolation. The slice with the requested interpolation is computed on a worker thread
+   * (see AsynchronousReslicer) and replaces the preview with the next update of the render window.
+   *
    * Properties that can be set for images and influence the imageMapper2D are:
    *
    *   - \b "opacity": (FloatProperty) Opacity of the image
@@ -181,8 +188,16 @@ namespace mitk
       vtkSmartPointer<vtkLookupTable> m_ColorLookupTable;
       /** \brief The actual reslicer (one per renderer) */
       mitk::ExtractSliceFilter::Pointer m_Reslicer;
+      /** \brief The vtkImageReslice used by m_Reslicer. Its setup is copied for the asynchronous refinement. */
+      vtkSmartPointer<vtkImageReslice> m_ResliceAlgorithm;
+      /** \brief Computes the slice with the requested interpolation in the background, if
+        * asynchronous slice rendering is enabled (see RenderingManager::SetAsynchronousSliceRendering()). */
+      AsynchronousReslicer m_AsynchronousReslicer;
       /** \brief Filter for thick slices */
       vtkSmartPointer<vtkMitkThickSlicesFilter> m_TSFilter;
+      /** \brief Plane and cache key of the last thick slab, used to detect that the slab moved by one slice. */
+      mitk::PlaneGeometry::Pointer m_ThickSlabPlane;
+      ResliceCache::Key m_ThickSlabKey;
       /** \brief PolyData object containing all lines/points needed for outlining the contour.
             This container is used to save a computed contour for the next rendering execution.
             For instance, if you zoom or pann, there is no need to recompute the contour. */
@@ -193,6 +208,10 @@ namespace mitk
 
       /** \brief mmPerPixel relation between pixel and mm. (World spacing).*/
       mitk::ScalarType *m_mmPerPixel;
+      /** \brief Storage of the spacing m_mmPerPixel points to. Copied from the reslicer or the ResliceCache.*/
+      mitk::ScalarType m_SliceSpacing[2];
+      /** \brief Reslice axes of the current slice. Copied from the reslicer or the ResliceCache.*/
+      vtkSmartPointer<vtkMatrix4x4> m_ResliceAxes;
 
       /** \brief This filter is used to apply the level window to Grayvalue and RBG(A) images. */
       vtkSmartPointer<vtkMitkLevelWindowFilter> m_LevelWindowFilter;
@@ -14,6 +14,7 @@ found in the LICENSE file.
 #define mitkItkImageIO_h
 
 #include "mitkAbstractFileIO.h"
+#include <mitkChunkedGzipCodec.h>
 #include <mitkImage.h>
 #include <itkImageIOBase.h>
 
@@ -29,6 +30,12 @@ namespace mitk
    * For all ITK ImageIOs that support the serialization of MetaData
    * (e.g. nrrd or mhd) the ItkImageIO ensures the serialization
    * of Identification UID.
+   *
+   * The advanced writer options "Compression" (Default, Fast, Best or None) and
+   * "Parallel compression" control the compression of written images (see IFileIO::Options).
+   * With parallel compression, the data of attached NRRD files is compressed
+   * by ChunkedGzipCodec in independent chunks. The result stays a valid gzip
+   * encoded NRRD file and is decompressed in parallel again when read by this class.
    */
   class MITKCORE_EXPORT ItkImageIO : public AbstractFileIO
   {
@@ -66,6 +73,12 @@ namespace mitk
 
     static void SavePropertyListAsMetaData(itk::MetaDataDictionary& dictionary, const PropertyList* properties, const std::string& mimeTypeName);
 
+    /** Helper function that writes an attached NRRD file (.nrrd) whose data is compressed in parallel by ChunkedGzipCodec.
+    The image IO has to be prepared like for itk::ImageIOBase::Write(). The data is not passed as a buffer but requested
+    chunk by chunk from fill, so that data that is rearranged for writing never exists as a whole.
+    @throw mitk::Exception if the image IO is not an itk::NrrdImageIO, path is a detached header or writing fails.*/
+    static void WriteChunkedGzipNrrd(itk::ImageIOBase* imageIO, const std::string& path, const ChunkedGzipCodec::FillFunction& fill, int compressionLevel = -1);
+
 
   protected:
     virtual std::vector<std::string> FixUpImageIOExtensions(const std::string &imageIOName);
@@ -74,6 +87,9 @@ namespace mitk
     // Fills the m_DefaultMetaDataKeys vector with default values
     virtual void InitializeDefaultMetaDataKeys();
 
+    // Registers the compression options of the writer
+    void InitializeDefaultWriterOptions();
+
     // -------------- AbstractFileReader -------------
     std::vector<itk::SmartPointer<BaseData>> DoRead() override;
 
@@ -85,6 +101,8 @@ namespace mitk
     itk::ImageIOBase::Pointer m_ImageIO;
 
     std::vector<std::string> m_DefaultMetaDataKeys;
+
+    int m_DefaultCompressionLevel;
   };
 
   /**Helper function that converts the content of a meta data into a time point vector.
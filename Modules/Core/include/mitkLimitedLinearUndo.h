@@ -100,6 +100,22 @@ namespace mitk
     //## @param limit the maximum number of items on the stack
     void SetUndoLimit(std::size_t limit) override;
 
+    //##Documentation
+    //## @brief Gets the limit on the memory (in bytes) of the undo history.
+    //## If the value is 0 that means that there is no limit.
+    std::size_t GetMemoryLimit() const override;
+
+    //##Documentation
+    //## @brief Sets a limit on the memory (in bytes) of the undo history.
+    //## If the summed memory of the undo and redo items exceeds the limit, the oldest
+    //## undo items will be dropped from the bottom of the undo stack (the newest
+    //## undo item is always kept). The 0 value means that there is no limit.
+    void SetMemoryLimit(std::size_t limit) override;
+
+    //##Documentation
+    //## @brief Returns the summed memory (in bytes) of all undo and redo items.
+    std::size_t GetMemorySize() const;
+
     //##Documentation
     //## @brief Returns the ObjectEventId of the
     //## top element in the OperationHistory
@@ -128,6 +144,9 @@ namespace mitk
     //## elements in the list and to clear the list
     void ClearList(UndoContainer *list);
 
+    //## @brief Drops the oldest undo items until the memory limit is met.
+    void EnforceMemoryLimit();
+
     UndoContainer m_UndoList;
 
     UndoContainer m_RedoList;
@@ -137,6 +156,8 @@ namespace mitk
 
     std::size_t m_UndoLimit;
 
+    std::size_t m_MemoryLimit;
+
   };
 
 #pragma GCC visibility push(default)
@@ -39,6 +39,11 @@ namespace mitk
 
     OperationType GetOperationType();
 
+    //##Documentation
+    //## @brief Returns the memory (in bytes) that is kept alive by the operation.
+    //## Used by undo models to limit the memory of the undo history. The default implementation returns 0.
+    virtual std::size_t GetMemorySize() const;
+
   protected:
     OperationType m_OperationType;
   };
@@ -74,6 +74,10 @@ namespace mitk
     virtual void ReverseOperations();
     virtual void ReverseAndExecute();
 
+    //##Documentation
+    //## @brief Returns the memory (in bytes) that is kept alive by the item. The default implementation returns 0.
+    virtual std::size_t GetMemorySize() const;
+
     //##Documentation
     //## @brief Increases the current ObjectEventId
     //## For example if a button click generates operations the ObjectEventId has to be incremented to be able to undo
@@ -166,6 +170,9 @@ namespace mitk
     //##reverses and executes both operations (used, when moved from undo to redo stack)
     void ReverseAndExecute() override;
 
+    //## @brief Returns the summed memory size of operation and undo operation
+    std::size_t GetMemorySize() const override;
+
     //## @brief returns true if the destination still is present
     //## and false if it already has been deleted
     virtual bool IsValid();
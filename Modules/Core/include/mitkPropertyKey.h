@@ -0,0 +1,71 @@
+/*============================================================================
+
+The Medical Imaging Interaction Toolkit (MITK)
+
+Copyright (c) German Cancer Research Center (DKFZ)
+All rights reserved.
+
+Use of this source code is governed by a 3-clause BSD license that can be
+found in the LICENSE file.
+
+============================================================================*/
+
+#ifndef mitkPropertyKey_h
+#define mitkPropertyKey_h
+
+#include <cstddef>
+#include <string>
+
+#include <MitkCoreExports.h>
+
+namespace mitk
+{
+  /** @brief Interned handle of a property key.
+   *
+   * Creating a PropertyKey looks up the key string in a process wide table (and adds it
+   * if necessary). Afterwards, comparing and hashing a PropertyKey is a pointer operation
+   * and no string comparison. PropertyList and DataNode offer overloads of their lookup
+   * methods that take a PropertyKey.
+   *
+   * Since interning is not for free, keys that are read frequently should be created once
+   * and reused, e.g. as static variables or by the predefined keys in mitk::PropertyKeys:
+   * \code
+   * static const mitk::PropertyKey key("binary");
+   * bool isBinary = false;
+   * node->GetBoolProperty(key, isBinary, renderer);
+   * \endcode
+   *
+   * Interned key strings are never released. Do not create PropertyKey instances for
+   * arbitrary generated strings. PropertyList does not intern the keys of the properties
+   * it stores; it looks the interned key string up in its map, so no temporary string is
+   * created per lookup.
+   */
+  class MITKCORE_EXPORT PropertyKey final
+  {
+  public:
+    explicit PropertyKey(const std::string &key);
+    explicit PropertyKey(const char *key);
+
+    const std::string &GetString() const { return *m_Key; }
+    std::size_t GetHash() const { return m_Hash; }
+
+    bool operator==(const PropertyKey &other) const { return m_Key == other.m_Key; }
+    bool operator!=(const PropertyKey &other) const { return m_Key != other.m_Key; }
+
+  private:
+    const std::string *m_Key;
+    std::size_t m_Hash;
+  };
+
+  /** @brief Predefined keys of properties that are read by mappers for every rendered frame.*/
+  namespace PropertyKeys
+  {
+    MITKCORE_EXPORT const PropertyKey &Visible();
+    MITKCORE_EXPORT const PropertyKey &Opacity();
+    MITKCORE_EXPORT const PropertyKey &Color();
+    MITKCORE_EXPORT const PropertyKey &Layer();
+    MITKCORE_EXPORT const PropertyKey &LevelWindow();
+  }
+}
+
+#endif
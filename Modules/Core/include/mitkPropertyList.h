@@ -17,12 +17,14 @@ found in the LICENSE file.
 #include "mitkGenericProperty.h"
 #include "mitkUIDGenerator.h"
 #include "mitkIPropertyOwner.h"
+#include "mitkPropertyKey.h"
 #include <MitkCoreExports.h>
 
 #include <itkObjectFactory.h>
 
 #include <map>
 #include <string>
+#include <typeinfo>
 
 namespace mitk
 {
@@ -94,6 +96,33 @@ namespace mitk
      */
     mitk::BaseProperty *GetProperty(const std::string &propertyKey) const;
 
+    /**
+     * @brief Get a property by its interned key.
+     *
+     * Unlike GetProperty(const std::string&) called with a string literal, no temporary key string is created.
+     */
+    mitk::BaseProperty *GetProperty(const PropertyKey &propertyKey) const;
+
+    /**
+     * @brief Get a property of type T by its interned key.
+     *
+     * Properties whose dynamic type is exactly T are returned without a dynamic_cast.
+     * @return nullptr if the property does not exist or is no T.
+     */
+    template <typename T>
+    T *GetTypedProperty(const PropertyKey &propertyKey) const
+    {
+      auto property = this->GetProperty(propertyKey);
+
+      if (nullptr == property)
+        return nullptr;
+
+      if (typeid(*property) == typeid(T))
+        return static_cast<T *>(property);
+
+      return dynamic_cast<T *>(property);
+    }
+
     /**
      * @brief Set a property object in the list/map by reference.
      *
@@ -129,6 +158,11 @@ namespace mitk
     * @brief Convenience method to access the value of a BoolProperty
     */
     bool GetBoolProperty(const char *propertyKey, bool &boolValue) const;
+    /**
+    * @brief Convenience method to access the value of a BoolProperty by an interned key
+    */
+    bool GetBoolProperty(const PropertyKey &propertyKey, bool &boolValue) const;
+
     /**
     * @brief ShortCut for the above method
     */
@@ -147,6 +181,11 @@ namespace mitk
     * @brief Convenience method to access the value of an IntProperty
     */
     bool GetIntProperty(const char *propertyKey, int &intValue) const;
+    /**
+    * @brief Convenience method to access the value of an IntProperty by an interned key
+    */
+    bool GetIntProperty(const PropertyKey &propertyKey, int &intValue) const;
+
     /**
     * @brief ShortCut for the above method
     */
@@ -165,6 +204,11 @@ namespace mitk
     * @brief Convenience method to access the value of a FloatProperty
     */
     bool GetFloatProperty(const char *propertyKey, float &floatValue) const;
+    /**
+    * @brief Convenience method to access the value of a FloatProperty by an interned key
+    */
+    bool GetFloatProperty(const PropertyKey &propertyKey, float &floatValue) const;
+
     /**
     * @brief ShortCut for the above method
     */
@@ -25,6 +25,9 @@ found in the LICENSE file.
 #include <mitkTimeGeometry.h>
 #include <mitkAntiAliasing.h>
 
+#include <mutex>
+#include <set>
+
 class vtkRenderWindow;
 class vtkObject;
 
@@ -122,6 +125,11 @@ namespace mitk
    * soon as the main loop is ready for rendering. */
     void RequestUpdate(vtkRenderWindow *renderWindow);
 
+    /** Thread-safe variant of #RequestUpdate for worker threads, e.g. of mappers
+     * that generate their data asynchronously. The request is passed on to
+     * #RequestUpdate by the main thread when the pending requests are executed. */
+    void RequestAsynchronousUpdate(vtkRenderWindow *renderWindow);
+
     /** Immediately executes an update of the specified RenderWindow. */
     void ForceImmediateUpdate(vtkRenderWindow *renderWindow);
 
@@ -297,6 +305,18 @@ namespace mitk
     /** En-/Disable LOD abort mechanism. */
     itkBooleanMacro(LODAbortMechanismEnabled);
 
+    /** En-/Disable asynchronous slice rendering. If enabled, 2D image mappers show a
+     * nearest neighbor slice immediately and compute the slice with the requested
+     * interpolation on a worker thread. The refined slice replaces the preview with
+     * the next update, which is requested via #RequestAsynchronousUpdate. */
+    itkSetMacro(AsynchronousSliceRendering, bool);
+
+    /** En-/Disable asynchronous slice rendering. */
+    itkGetConstMacro(AsynchronousSliceRendering, bool);
+
+    /** En-/Disable asynchronous slice rendering. */
+    itkBooleanMacro(AsynchronousSliceRendering);
+
     /** Force a sub-class to start a timer for a pending hires-rendering request */
     virtual void StartOrResetTimer(){};
 
@@ -396,6 +416,12 @@ namespace mitk
 
     bool m_LODAbortMechanismEnabled;
 
+    bool m_AsynchronousSliceRendering;
+
+    /** Render windows of #RequestAsynchronousUpdate calls, passed to #RequestUpdate by the main thread. */
+    std::set<vtkRenderWindow *> m_AsynchronousRequests;
+    std::mutex m_AsynchronousRequestsMutex;
+
     BoolVector m_ShadingEnabled;
 
     bool m_ClippingPlaneEnabled;
@@ -0,0 +1,172 @@
+/*============================================================================
+
+The Medical Imaging Interaction Toolkit (MITK)
+
+Copyright (c) German Cancer Research Center (DKFZ)
+All rights reserved.
+
+Use of this source code is governed by a 3-clause BSD license that can be
+found in the LICENSE file.
+
+============================================================================*/
+
+#ifndef mitkResliceCache_h
+#define mitkResliceCache_h
+
+#include <MitkCoreExports.h>
+#include <mitkNumericTypes.h>
+
+#include <itkIntTypes.h>
+
+#include <vtkSmartPointer.h>
+
+#include <list>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <vector>
+
+class vtkImageData;
+class vtkMatrix4x4;
+
+namespace itk
+{
+  class EventObject;
+  class Object;
+}
+
+namespace mitk
+{
+  class Image;
+  class PlaneGeometry;
+
+  /** \brief Process-wide cache of resliced 2D images.
+
+    Render windows that show the same plane of the same image (e.g. linked or MxN layouts) and mappers that
+    are regenerated without a change of the image or the plane (e.g. because a rendering property changed)
+    request identical slices. The cache computes such a slice only once and shares it between all requesters.
+
+    An entry is identified by the image (address, modification time and write count), the geometry and time bounds
+    of the image time step, the plane geometry (including its reference geometry), the time step and the reslice
+    settings (interpolation, resample extent and thick slices). Any modification of the image changes its modification
+    time and any write through an ImageWriteAccessor its write count, so outdated entries are never returned; they are
+    dropped as soon as a newer slice of the same image is inserted, or by the least recently used eviction once the
+    memory limit is exceeded. All slices of an image are removed when the image is deleted.
+
+    Cached slices are shared and must be treated as read-only by all users.
+    Setting the memory limit to 0 disables the cache.
+  */
+  class MITKCORE_EXPORT ResliceCache
+  {
+  public:
+    /** Identifies a slice. Create keys via CreateKey().*/
+    struct Key
+    {
+      const Image* ImageAddress = nullptr;
+      itk::ModifiedTimeType ImageMTime = 0;
+      itk::SizeValueType ImageWriteCount = 0;
+      unsigned int TimeStep = 0;
+      int Interpolation = 0;
+      bool InPlaneResampleExtentByGeometry = false;
+      int ThickSlicesMode = 0;
+      int ThickSlicesNum = 0;
+      /** Transform and bounds of the plane geometry, of its reference geometry and of the image time step
+        as well as the time bounds of the time step.*/
+      std::vector<double> Geometry;
+
+      bool operator<(const Key& other) const;
+    };
+
+    /** A cached slice and the reslice information needed to display it.*/
+    struct Slice
+    {
+      vtkSmartPointer<vtkImageData> Image;
+      double ClippedPlaneBounds[6];
+      ScalarType Spacing[2];
+      vtkSmartPointer<vtkMatrix4x4> ResliceAxes;
+    };
+
+    using SliceConstPointer = std::shared_ptr<const Slice>;
+
+    static ResliceCache* GetInstance();
+
+    /** Creates the key of a slice. Returns false if the slice cannot be cached (missing image or geometry, or
+      a geometry that is not a plain PlaneGeometry, e.g. a curved AbstractTransformGeometry).*/
+    static bool CreateKey(const Image* image,
+                          const PlaneGeometry* planeGeometry,
+                          unsigned int timeStep,
+                          int interpolation,
+                          bool inPlaneResampleExtentByGeometry,
+                          int thickSlicesMode,
+                          int thickSlicesNum,
+                          Key& key);
+
+    /** Returns the cached slice or nullptr.*/
+    SliceConstPointer Get(const Key& key);
+
+    /** Stores the passed slice and returns the cached slice. Returns nullptr if the cache is disabled or if the slice
+      alone exceeds the memory limit.
+      The pixel data is not copied but shared with the passed image (shallow copy). The reslice output of a mapper
+      can be passed directly: VTK filters only reuse an output scalar array that is not referenced elsewhere, so the
+      next execution of the filter allocates a new array instead of overwriting the cached one. Other callers must
+      not write into the pixel data of the passed image afterwards.*/
+    SliceConstPointer Insert(const Key& key,
+                             vtkImageData* image,
+                             const double clippedPlaneBounds[6],
+                             const ScalarType spacing[2],
+                             vtkMatrix4x4* resliceAxes);
+
+    /** Removes all slices of the passed image.*/
+    void Remove(const Image* image);
+    void Clear();
+
+    /** Memory limit in bytes. Default is 256 MiB.*/
+    void SetMemoryLimit(std::size_t limit);
+    std::size_t GetMemoryLimit() const;
+
+    /** Memory (in bytes) occupied by the cached slices.*/
+    std::size_t GetMemorySize() const;
+    std::size_t GetNumberOfSlices() const;
+
+    std::size_t GetNumberOfHits() const;
+    std::size_t GetNumberOfMisses() const;
+
+    ResliceCache(const ResliceCache&) = delete;
+    ResliceCache& operator=(const ResliceCache&) = delete;
+
+  private:
+    ResliceCache();
+    ~ResliceCache();
+
+    struct Entry
+    {
+      Key EntryKey;
+      SliceConstPointer CachedSlice;
+      std::size_t MemorySize;
+    };
+
+    using EntryListType = std::list<Entry>;
+
+    void RemoveEntry(EntryListType::iterator entry);
+    void RemoveEntries(const Image* image);
+    void EnforceMemoryLimit();
+
+    /** Callback for the DeleteEvent of the images with cached slices.*/
+    void OnImageDeleted(const itk::Object* caller, const itk::EventObject& event);
+
+    /** Entries ordered from most to least recently used.*/
+    EntryListType m_Entries;
+    std::map<Key, EntryListType::iterator> m_Index;
+    /** Tags of the DeleteEvent observers of the images with cached slices.*/
+    std::map<const Image*, unsigned long> m_ImageObserverTags;
+
+    std::size_t m_MemoryLimit;
+    std::size_t m_MemorySize;
+    std::size_t m_NumberOfHits;
+    std::size_t m_NumberOfMisses;
+
+    mutable std::mutex m_Mutex;
+  };
+}
+
+#endif
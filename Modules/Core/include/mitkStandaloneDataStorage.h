@@ -17,7 +17,10 @@ found in the LICENSE file.
 #include "mitkDataStorage.h"
 #include "mitkMessage.h"
 #include <map>
+#include <memory>
 #include <mutex>
+#include <string>
+#include <vector>
 
 namespace mitk
 {
@@ -89,6 +92,19 @@ namespace mitk
     //##
     SetOfObjects::ConstPointer GetAll() const override;
 
+    //##Documentation
+    //## @brief Adds a property key to the secondary indexes
+    //##
+    //## GetSubset(), and thus GetNode() and GetNamedNode(), answer NodePredicateDataType queries,
+    //## NodePredicateProperty queries for a value of an indexed key and AND/OR combinations of them
+    //## from secondary indexes instead of checking the condition for every node. The "name" key is
+    //## always indexed. Only the renderer-independent property list of a node is indexed.
+    void AddIndexedPropertyKey(const std::string &propertyKey);
+
+    //##Documentation
+    //## @brief Returns the property keys of the secondary indexes
+    std::vector<std::string> GetIndexedPropertyKeys() const;
+
     mutable std::mutex m_Mutex;
 
   protected:
@@ -114,6 +130,16 @@ namespace mitk
     //## @brief deletes all references to a node in a given relation (used in Remove() and TreeListener)
     void RemoveFromRelation(const mitk::DataNode *node, AdjacencyList &relation);
 
+    //##Documentation
+    //## @brief Returns the nodes of the secondary indexes that may meet the condition or all nodes
+    //## if the condition cannot be answered from the indexes
+    SetOfObjects::ConstPointer GetSubsetCandidates(const NodePredicateBase *condition) const override;
+
+    //##Documentation
+    //## @brief Returns the nodes of the name index with the given name and the nodes without a name
+    //## in their own property list
+    SetOfObjects::ConstPointer GetNamedNodeCandidates(const std::string &name) const override;
+
     //##Documentation
     //## @brief Prints the contents of the StandaloneDataStorage to os. Do not call directly, call ->Print() instead
     void PrintSelf(std::ostream &os, itk::Indent indent) const override;
@@ -124,6 +150,13 @@ namespace mitk
     //##Documentation
     //## @brief Nodes are stored in reverse relation for easier traversal in the opposite direction of the relation
     AdjacencyList m_DerivedNodes;
+
+  private:
+    struct Index;
+
+    //##Documentation
+    //## @brief Secondary indexes by data type and property value, guarded by m_Mutex
+    std::unique_ptr<Index> m_Index;
   };
 } // namespace mitk
 #endif
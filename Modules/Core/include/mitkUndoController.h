@@ -38,6 +38,11 @@ namespace mitk
     //## @brief Default UndoModel to use.
     static const UndoType DEFAULTUNDOMODEL;
 
+    //##Documentation
+    //## @brief Memory limit (in bytes) that is set on the UndoModels created by the controller.
+    //## See UndoModel::SetMemoryLimit.
+    static const std::size_t DEFAULTMEMORYLIMIT;
+
     //##Documentation
     //## Constructor; Adds the new UndoType or if undoType exists ,
     //## switches it to undoType; for UndoTypes see definitionmitkInteractionConst.h
@@ -71,6 +71,20 @@ namespace mitk
     //## @param limit the maximum number of items on the stack
     virtual void SetUndoLimit(std::size_t limit) = 0;
 
+    //##Documentation
+    //## @brief Gets the limit on the memory (in bytes) of the undo history.
+    //## The value 0 means that there is no limit. The default implementation
+    //## does not support a memory limit and always returns 0.
+    virtual std::size_t GetMemoryLimit() const { return 0; }
+
+    //##Documentation
+    //## @brief Sets a limit on the memory (in bytes) of the undo history.
+    //## If the memory of the history exceeds the limit, the oldest undo items will
+    //## be dropped from the bottom of the undo stack. The memory of an item is
+    //## given by UndoStackItem::GetMemorySize(). The 0 value means that there is no limit.
+    //## The default implementation ignores the limit.
+    virtual void SetMemoryLimit(std::size_t /*limit*/) {}
+
     //##Documentation
     //## @brief returns the ObjectEventId of the
     //## top Element in the OperationHistory of the selected
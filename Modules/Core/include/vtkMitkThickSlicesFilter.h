@@ -25,6 +25,8 @@ found in the LICENSE file.
 
 #include "vtkThreadedImageAlgorithm.h"
 
+#include <vector>
+
 class MITKCORE_EXPORT vtkMitkThickSlicesFilter : public vtkThreadedImageAlgorithm
 {
 public:
@@ -46,6 +48,24 @@ public:
   vtkGetMacro(HandleBoundaries, int);
   vtkBooleanMacro(HandleBoundaries, int);
 
+  // Description:
+  // Get/Set whether SUM and MEAN projections are updated incrementally.
+  // If enabled, the filter keeps the running sum of the last execution.
+  // When the next input is the previous input moved by one slice along z
+  // (see SetSliceShift()) and has the same extent, only the slice leaving
+  // and the slice entering the slab are processed. All other projections
+  // and inputs are always computed from scratch.
+  vtkSetMacro(SlidingWindow, int);
+  vtkGetMacro(SlidingWindow, int);
+  vtkBooleanMacro(SlidingWindow, int);
+
+  // Description:
+  // Get/Set the number of slices the input moved along z since the last
+  // execution. Only +1 (the slab moved towards larger z) and -1 allow an
+  // incremental update. Reset to 0 after each execution.
+  vtkSetMacro(SliceShift, int);
+  vtkGetMacro(SliceShift, int);
+
   enum
   {
     MIP = 0,
@@ -61,6 +81,8 @@ protected:
 
   int HandleBoundaries;
   int Dimensionality;
+  int SlidingWindow;
+  int SliceShift;
 
   int RequestInformation(vtkInformation *, vtkInformationVector **, vtkInformationVector *) override;
   int RequestUpdateExtent(vtkInformation *, vtkInformationVector **, vtkInformationVector *) override;
@@ -76,6 +98,16 @@ protected:
 
   int m_CurrentMode;
 
+  // State of the sliding window: running sum of all input slices and copies of the first
+  // and the last input slice of the last execution, each with one value per output pixel.
+  std::vector<double> m_SlidingWindowSum;
+  std::vector<double> m_SlidingWindowFirstSlice;
+  std::vector<double> m_SlidingWindowLastSlice;
+  int m_SlidingWindowExtent[6];
+  bool m_SlidingWindowValid;
+  int m_IncrementalSliceShift;
+  unsigned int m_IncrementalUpdateCount;
+
 private:
   vtkMitkThickSlicesFilter(const vtkMitkThickSlicesFilter &); // Not implemented.
   void operator=(const vtkMitkThickSlicesFilter &);           // Not implemented.
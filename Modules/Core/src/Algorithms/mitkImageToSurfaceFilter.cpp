@@ -24,6 +24,10 @@ found in the LICENSE file.
 #include <vtkPolyDataNormals.h>
 #include <vtkSmartPointer.h>
 
+#include <itkMultiThreaderBase.h>
+
+#include <vector>
+
 #include "mitkProgressBar.h"
 
 mitk::ImageToSurfaceFilter::ImageToSurfaceFilter()
@@ -32,7 +36,8 @@ mitk::ImageToSurfaceFilter::ImageToSurfaceFilter()
     m_Threshold(1.0),
     m_TargetReduction(0.95f),
     m_SmoothIteration(50),
-    m_SmoothRelaxation(0.1)
+    m_SmoothRelaxation(0.1),
+    m_NumberOfThreads(0)
 {
 }
 
@@ -44,6 +49,13 @@ void mitk::ImageToSurfaceFilter::CreateSurface(int time,
                                                vtkImageData *vtkimage,
                                                mitk::Surface *surface,
                                                const ScalarType threshold)
+{
+  surface->SetVtkPolyData(this->CreatePolyData(time, vtkimage, threshold), time);
+}
+
+vtkSmartPointer<vtkPolyData> mitk::ImageToSurfaceFilter::CreatePolyData(int time,
+                                                                        vtkImageData *vtkimage,
+                                                                        const ScalarType threshold)
 {
   vtkImageChangeInformation *indexCoordinatesImageFilter = vtkImageChangeInformation::New();
   indexCoordinatesImageFilter->SetInputData(vtkimage);
@@ -158,8 +170,9 @@ void mitk::ImageToSurfaceFilter::CreateSurface(int time,
   cleanPolyDataFilter->PointMergingOn();
   cleanPolyDataFilter->Update();
 
-  surface->SetVtkPolyData(cleanPolyDataFilter->GetOutput(), time);
   polydata->UnRegister(nullptr);
+
+  return cleanPolyDataFilter->GetOutput();
 }
 
 void mitk::ImageToSurfaceFilter::GenerateData()
@@ -179,15 +192,51 @@ void mitk::ImageToSurfaceFilter::GenerateData()
     ProgressBar::GetInstance()->AddStepsToDo(4 * (tmax - tstart));
   }
 
-  int t;
-  for (t = tstart; t < tmax; ++t)
+  // The VTK image data of an mitk::Image is created on demand, hence it is requested
+  // for all time steps before they are processed concurrently.
+  std::vector<int> timeSteps;
+  std::vector<vtkSmartPointer<vtkImageData>> vtkimages;
+
+  for (int t = tstart; t < tmax; ++t)
   {
-    vtkImageData *vtkimagedata = image->GetVtkImageData(t);
-    CreateSurface(t, vtkimagedata, surface, m_Threshold);
+    timeSteps.push_back(t);
+    vtkimages.push_back(image->GetVtkImageData(t));
+  }
+
+  std::vector<vtkSmartPointer<vtkPolyData>> polyDatas(timeSteps.size());
+
+  this->ProcessTimeSteps(timeSteps.size(), [&](std::size_t i, bool) {
+    polyDatas[i] = this->CreatePolyData(timeSteps[i], vtkimages[i], m_Threshold);
+  });
+
+  for (std::size_t i = 0; i < timeSteps.size(); ++i)
+  {
+    surface->SetVtkPolyData(polyDatas[i], timeSteps[i]);
     ProgressBar::GetInstance()->Progress();
   }
 }
 
+void mitk::ImageToSurfaceFilter::ProcessTimeSteps(std::size_t numberOfTimeSteps,
+                                                  const std::function<void(std::size_t, bool)> &process) const
+{
+  if (numberOfTimeSteps < 2 || 1 == m_NumberOfThreads)
+  {
+    for (std::size_t i = 0; i < numberOfTimeSteps; ++i)
+      process(i, 1 == m_NumberOfThreads);
+
+    return;
+  }
+
+  // Each time step runs its own VTK pipeline and is processed completely by a single
+  // work unit, so the result does not depend on the number of threads.
+  auto multiThreader = itk::MultiThreaderBase::New();
+  if (m_NumberOfThreads > 0)
+    multiThreader->SetNumberOfWorkUnits(m_NumberOfThreads);
+
+  multiThreader->ParallelizeArray(
+    0, numberOfTimeSteps, [&process](itk::SizeValueType i) { process(i, true); }, nullptr);
+}
+
 void mitk::ImageToSurfaceFilter::SetSmoothIteration(int smoothIteration)
 {
   m_SmoothIteration = smoothIteration;
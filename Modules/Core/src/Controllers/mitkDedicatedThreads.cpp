@@ -0,0 +1,27 @@
+/*============================================================================
+
+The Medical Imaging Interaction Toolkit (MITK)
+
+Copyright (c) German Cancer Research Center (DKFZ)
+All rights reserved.
+
+Use of this source code is governed by a 3-clause BSD license that can be
+found in the LICENSE file.
+
+============================================================================*/
+
+#include <mitkDedicatedThreads.h>
+
+#include <itkMultiThreaderBase.h>
+
+#include <algorithm>
+
+unsigned int mitk::GetNumberOfDedicatedThreads(std::size_t numberOfTasks)
+{
+  std::size_t numberOfThreads = std::max<itk::ThreadIdType>(1, itk::MultiThreaderBase::GetGlobalDefaultNumberOfThreads());
+
+  if (0 != numberOfTasks)
+    numberOfThreads = std::min(numberOfThreads, numberOfTasks);
+
+  return static_cast<unsigned int>(numberOfThreads);
+}
@@ -13,6 +13,8 @@ found in the LICENSE file.
 #include "mitkLimitedLinearUndo.h"
 #include <mitkRenderingManager.h>
 
+#include <algorithm>
+
 namespace mitk
 {
   itkEventMacroDefinition(UndoStackEvent, itk::ModifiedEvent);
@@ -25,7 +27,7 @@ namespace mitk
 }
 
 mitk::LimitedLinearUndo::LimitedLinearUndo()
-: m_UndoLimit(0)
+: m_UndoLimit(0), m_MemoryLimit(0)
 {
   // nothing to do
 }
@@ -67,6 +69,7 @@ bool mitk::LimitedLinearUndo::SetOperationEvent(UndoStackItem *stackItem)
     delete item;
   }
   m_UndoList.push_back(operationEvent);
+  this->EnforceMemoryLimit();
 
   InvokeEvent(UndoNotEmptyEvent());
 
@@ -201,6 +204,45 @@ void mitk::LimitedLinearUndo::SetUndoLimit(std::size_t undoLimit)
   }
 }
 
+std::size_t mitk::LimitedLinearUndo::GetMemoryLimit() const
+{
+  return m_MemoryLimit;
+}
+
+void mitk::LimitedLinearUndo::SetMemoryLimit(std::size_t memoryLimit)
+{
+  if (memoryLimit != m_MemoryLimit)
+  {
+    m_MemoryLimit = memoryLimit;
+    this->EnforceMemoryLimit();
+  }
+}
+
+std::size_t mitk::LimitedLinearUndo::GetMemorySize() const
+{
+  std::size_t size = 0;
+  for (const auto *item : m_UndoList)
+    size += item->GetMemorySize();
+  for (const auto *item : m_RedoList)
+    size += item->GetMemorySize();
+  return size;
+}
+
+void mitk::LimitedLinearUndo::EnforceMemoryLimit()
+{
+  if (0 == m_MemoryLimit)
+    return;
+
+  std::size_t size = this->GetMemorySize();
+  while (size > m_MemoryLimit && m_UndoList.size() > 1)
+  {
+    auto item = m_UndoList.front();
+    m_UndoList.pop_front();
+    size -= std::min(size, item->GetMemorySize());
+    delete item;
+  }
+}
+
 int mitk::LimitedLinearUndo::GetLastObjectEventIdInList()
 {
   return m_UndoList.back()->GetObjectEventId();
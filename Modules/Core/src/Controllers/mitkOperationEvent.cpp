@@ -72,6 +72,11 @@ void mitk::UndoStackItem::ReverseAndExecute()
   ReverseOperations();
 }
 
+std::size_t mitk::UndoStackItem::GetMemorySize() const
+{
+  return 0;
+}
+
 // ******************** mitk::OperationEvent ********************
 
 mitk::Operation *mitk::OperationEvent::GetOperation()
@@ -127,6 +132,16 @@ void mitk::OperationEvent::ReverseOperations()
   UndoStackItem::ReverseOperations();
 }
 
+std::size_t mitk::OperationEvent::GetMemorySize() const
+{
+  std::size_t size = 0;
+  if (m_Operation)
+    size += m_Operation->GetMemorySize();
+  if (m_UndoOperation)
+    size += m_UndoOperation->GetMemorySize();
+  return size;
+}
+
 void mitk::OperationEvent::ReverseAndExecute()
 {
   ReverseOperations();
@@ -40,6 +40,7 @@ namespace mitk
       m_MaxLOD(1),
       m_LODIncreaseBlocked(false),
       m_LODAbortMechanismEnabled(false),
+      m_AsynchronousSliceRendering(false),
       m_ClippingPlaneEnabled(false),
       m_TimeNavigationController(SliceNavigationController::New()),
       m_DataStorage(nullptr),
@@ -210,6 +211,22 @@ namespace mitk
     }
   }
 
+  void RenderingManager::RequestAsynchronousUpdate(vtkRenderWindow *renderWindow)
+  {
+    bool isFirstRequest = false;
+
+    {
+      std::lock_guard<std::mutex> lock(m_AsynchronousRequestsMutex);
+      isFirstRequest = m_AsynchronousRequests.empty();
+      m_AsynchronousRequests.insert(renderWindow);
+    }
+
+    // Only the event generation is required to be thread-safe (e.g. posting
+    // an event to the main loop). All further processing is done there.
+    if (isFirstRequest)
+      this->GenerateRenderingRequestEvent();
+  }
+
   void RenderingManager::ForceImmediateUpdate(vtkRenderWindow *renderWindow)
   {
     // If the renderWindow is not valid, we do not want to inadvertently create
@@ -541,6 +558,16 @@ namespace mitk
 
   void RenderingManager::ExecutePendingRequests()
   {
+    std::set<vtkRenderWindow *> asynchronousRequests;
+
+    {
+      std::lock_guard<std::mutex> lock(m_AsynchronousRequestsMutex);
+      asynchronousRequests.swap(m_AsynchronousRequests);
+    }
+
+    for (auto renderWindow : asynchronousRequests)
+      this->RequestUpdate(renderWindow);
+
     m_UpdatePending = false;
 
     // Satisfy all pending update requests
@@ -24,6 +24,9 @@ mitk::UndoController::UndoType mitk::UndoController::m_CurUndoType;
 // const mitk::UndoController::UndoType mitk::UndoController::DEFAULTUNDOMODEL = LIMITEDLINEARUNDO;
 const mitk::UndoController::UndoType mitk::UndoController::DEFAULTUNDOMODEL = VERBOSE_LIMITEDLINEARUNDO;
 
+// 1 GiB; only operations that report their memory (e.g. segmentation slice edits) count against it
+const std::size_t mitk::UndoController::DEFAULTMEMORYLIMIT = 1024 * 1024 * 1024;
+
 mitk::UndoController::UndoController(UndoType undoType)
 {
   if (SwitchUndoModel(undoType) == false) // existiert noch nicht in static-Liste
@@ -48,6 +51,7 @@ mitk::UndoController::UndoController(UndoType undoType)
         m_CurUndoType = undoType;
         m_UndoModelList.insert(UndoModelMap::value_type(undoType, m_CurUndoModel));
     }
+    m_CurUndoModel->SetMemoryLimit(DEFAULTMEMORYLIMIT);
   }
 }
 
@@ -153,6 +157,7 @@ bool mitk::UndoController::AddUndoModel(UndoType undoType)
       // that undoType is not implemented!
       return false;
   }
+  m_CurUndoModel->SetMemoryLimit(DEFAULTMEMORYLIMIT);
   return true;
 }
 
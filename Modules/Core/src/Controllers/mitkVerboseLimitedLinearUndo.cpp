@@ -41,6 +41,7 @@ bool mitk::VerboseLimitedLinearUndo::SetOperationEvent(UndoStackItem *undoStackI
     delete item;
   }
   m_UndoList.push_back(undoStackItem);
+  this->EnforceMemoryLimit();
 
   InvokeEvent(UndoNotEmptyEvent());
 
@@ -26,12 +26,33 @@ found in the LICENSE file.
 #include "mitkImageSource.h"
 #include "mitkLevelWindowProperty.h"
 #include "mitkRenderingManager.h"
+#include <typeinfo>
 
 namespace mitk
 {
   itkEventMacroDefinition(InteractorChangedEvent, itk::AnyEvent);
 }
 
+namespace
+{
+  bool IsKey(const char *propertyKey, const mitk::PropertyKey &key)
+  {
+    return nullptr != propertyKey && key.GetString() == propertyKey;
+  }
+
+  /** Properties of the requested type are by far the common case, so they are checked without dynamic_cast.*/
+  template <class T>
+  T *CastProperty(mitk::BaseProperty *property)
+  {
+    if (nullptr == property)
+      return nullptr;
+
+    return typeid(*property) == typeid(T)
+      ? static_cast<T *>(property)
+      : dynamic_cast<T *>(property);
+  }
+}
+
 mitk::Mapper *mitk::DataNode::GetMapper(MapperSlotId id) const
 {
   if ((id >= m_Mappers.size()) || (m_Mappers[id].IsNull()))
@@ -226,7 +247,7 @@ mitk::BaseProperty *mitk::DataNode::GetProperty(const char *propertyKey, const m
   if (nullptr == propertyKey)
     return nullptr;
 
-  if (nullptr != renderer)
+  if (nullptr != renderer && !m_MapOfPropertyLists.empty())
   {
     auto it = m_MapOfPropertyLists.find(renderer->GetName());
 
@@ -247,6 +268,29 @@ mitk::BaseProperty *mitk::DataNode::GetProperty(const char *propertyKey, const m
   return property;
 }
 
+mitk::BaseProperty *mitk::DataNode::GetProperty(const PropertyKey &propertyKey, const mitk::BaseRenderer *renderer, bool fallBackOnDataProperties) const
+{
+  if (nullptr != renderer && !m_MapOfPropertyLists.empty())
+  {
+    auto it = m_MapOfPropertyLists.find(renderer->GetName());
+
+    if (m_MapOfPropertyLists.end() != it)
+    {
+      auto property = it->second->GetProperty(propertyKey);
+
+      if (nullptr != property)
+        return property;
+    }
+  }
+
+  auto property = m_PropertyList->GetProperty(propertyKey);
+
+  if (nullptr == property && fallBackOnDataProperties && m_Data.IsNotNull())
+    property = m_Data->GetPropertyList()->GetProperty(propertyKey);
+
+  return property;
+}
+
 mitk::DataNode::GroupTagList mitk::DataNode::GetGroupTags() const
 {
   GroupTagList groups;
@@ -269,6 +313,9 @@ mitk::DataNode::GroupTagList mitk::DataNode::GetGroupTags() const
 
 bool mitk::DataNode::GetBoolProperty(const char *propertyKey, bool &boolValue, const mitk::BaseRenderer *renderer) const
 {
+  if (IsKey(propertyKey, PropertyKeys::Visible()))
+    return this->GetBoolProperty(PropertyKeys::Visible(), boolValue, renderer);
+
   mitk::BoolProperty::Pointer boolprop = dynamic_cast<mitk::BoolProperty *>(GetProperty(propertyKey, renderer));
   if (boolprop.IsNull())
     return false;
@@ -277,8 +324,21 @@ bool mitk::DataNode::GetBoolProperty(const char *propertyKey, bool &boolValue, c
   return true;
 }
 
+bool mitk::DataNode::GetBoolProperty(const PropertyKey &propertyKey, bool &boolValue, const mitk::BaseRenderer *renderer) const
+{
+  auto boolprop = CastProperty<BoolProperty>(this->GetProperty(propertyKey, renderer));
+  if (nullptr == boolprop)
+    return false;
+
+  boolValue = boolprop->GetValue();
+  return true;
+}
+
 bool mitk::DataNode::GetIntProperty(const char *propertyKey, int &intValue, const mitk::BaseRenderer *renderer) const
 {
+  if (IsKey(propertyKey, PropertyKeys::Layer()))
+    return this->GetIntProperty(PropertyKeys::Layer(), intValue, renderer);
+
   mitk::IntProperty::Pointer intprop = dynamic_cast<mitk::IntProperty *>(GetProperty(propertyKey, renderer));
   if (intprop.IsNull())
     return false;
@@ -287,10 +347,23 @@ bool mitk::DataNode::GetIntProperty(const char *propertyKey, int &intValue, cons
   return true;
 }
 
+bool mitk::DataNode::GetIntProperty(const PropertyKey &propertyKey, int &intValue, const mitk::BaseRenderer *renderer) const
+{
+  auto intprop = CastProperty<IntProperty>(this->GetProperty(propertyKey, renderer));
+  if (nullptr == intprop)
+    return false;
+
+  intValue = intprop->GetValue();
+  return true;
+}
+
 bool mitk::DataNode::GetFloatProperty(const char *propertyKey,
                                       float &floatValue,
                                       const mitk::BaseRenderer *renderer) const
 {
+  if (IsKey(propertyKey, PropertyKeys::Opacity()))
+    return this->GetFloatProperty(PropertyKeys::Opacity(), floatValue, renderer);
+
   mitk::FloatProperty::Pointer floatprop = dynamic_cast<mitk::FloatProperty *>(GetProperty(propertyKey, renderer));
   if (floatprop.IsNull())
     return false;
@@ -299,6 +372,18 @@ bool mitk::DataNode::GetFloatProperty(const char *propertyKey,
   return true;
 }
 
+bool mitk::DataNode::GetFloatProperty(const PropertyKey &propertyKey,
+                                      float &floatValue,
+                                      const mitk::BaseRenderer *renderer) const
+{
+  auto floatprop = CastProperty<FloatProperty>(this->GetProperty(propertyKey, renderer));
+  if (nullptr == floatprop)
+    return false;
+
+  floatValue = floatprop->GetValue();
+  return true;
+}
+
 bool mitk::DataNode::GetDoubleProperty(const char *propertyKey,
                                        double &doubleValue,
                                        const mitk::BaseRenderer *renderer) const
@@ -339,8 +424,10 @@ bool mitk::DataNode::GetStringProperty(const char *propertyKey,
 
 bool mitk::DataNode::GetColor(float rgb[3], const mitk::BaseRenderer *renderer, const char *propertyKey) const
 {
-  mitk::ColorProperty::Pointer colorprop = dynamic_cast<mitk::ColorProperty *>(GetProperty(propertyKey, renderer));
-  if (colorprop.IsNull())
+  auto colorprop = IsKey(propertyKey, PropertyKeys::Color())
+    ? CastProperty<ColorProperty>(this->GetProperty(PropertyKeys::Color(), renderer))
+    : dynamic_cast<ColorProperty *>(this->GetProperty(propertyKey, renderer));
+  if (nullptr == colorprop)
     return false;
 
   memcpy(rgb, colorprop->GetColor().GetDataPointer(), 3 * sizeof(float));
@@ -349,6 +436,9 @@ bool mitk::DataNode::GetColor(float rgb[3], const mitk::BaseRenderer *renderer,
 
 bool mitk::DataNode::GetOpacity(float &opacity, const mitk::BaseRenderer *renderer, const char *propertyKey) const
 {
+  if (IsKey(propertyKey, PropertyKeys::Opacity()))
+    return this->GetFloatProperty(PropertyKeys::Opacity(), opacity, renderer);
+
   mitk::FloatProperty::Pointer opacityprop = dynamic_cast<mitk::FloatProperty *>(GetProperty(propertyKey, renderer));
   if (opacityprop.IsNull())
     return false;
@@ -361,9 +451,10 @@ bool mitk::DataNode::GetLevelWindow(mitk::LevelWindow &levelWindow,
                                     const mitk::BaseRenderer *renderer,
                                     const char *propertyKey) const
 {
-  mitk::LevelWindowProperty::Pointer levWinProp =
-    dynamic_cast<mitk::LevelWindowProperty *>(GetProperty(propertyKey, renderer));
-  if (levWinProp.IsNull())
+  auto levWinProp = IsKey(propertyKey, PropertyKeys::LevelWindow())
+    ? CastProperty<LevelWindowProperty>(this->GetProperty(PropertyKeys::LevelWindow(), renderer))
+    : dynamic_cast<LevelWindowProperty *>(this->GetProperty(propertyKey, renderer));
+  if (nullptr == levWinProp)
     return false;
 
   levelWindow = levWinProp->GetLevelWindow();
@@ -21,6 +21,8 @@ found in the LICENSE file.
 #include "mitkProperties.h"
 #include "mitkArbitraryTimeGeometry.h"
 
+#include <typeinfo>
+
 mitk::DataStorage::DataStorage() : itk::Object(), m_BlockNodeModifiedEvents(false)
 {
 }
@@ -53,23 +55,38 @@ void mitk::DataStorage::Remove(const DataStorage::SetOfObjects *nodes)
 
 mitk::DataStorage::SetOfObjects::ConstPointer mitk::DataStorage::GetSubset(const NodePredicateBase *condition) const
 {
-  DataStorage::SetOfObjects::ConstPointer result = this->FilterSetOfObjects(this->GetAll(), condition);
+  DataStorage::SetOfObjects::ConstPointer result = this->FilterSetOfObjects(this->GetSubsetCandidates(condition), condition);
   return result;
 }
 
+mitk::DataStorage::SetOfObjects::ConstPointer mitk::DataStorage::GetSubsetCandidates(const NodePredicateBase *) const
+{
+  return this->GetAll();
+}
+
+mitk::DataStorage::SetOfObjects::ConstPointer mitk::DataStorage::GetNamedNodeCandidates(const std::string &) const
+{
+  return this->GetAll();
+}
+
 mitk::DataNode *mitk::DataStorage::GetNamedNode(const char *name) const
 
 {
   if (name == nullptr)
     return nullptr;
 
-  StringProperty::Pointer s(StringProperty::New(name));
-  NodePredicateProperty::Pointer p = NodePredicateProperty::New("name", s);
-  DataStorage::SetOfObjects::ConstPointer rs = this->GetSubset(p);
-  if (rs->Size() >= 1)
-    return rs->GetElement(0);
-  else
-    return nullptr;
+  // same check as a NodePredicateProperty for a StringProperty "name"
+  DataStorage::SetOfObjects::ConstPointer rs = this->GetNamedNodeCandidates(name);
+  for (auto it = rs->Begin(); it != rs->End(); ++it)
+  {
+    const auto *property = it->Value()->GetProperty("name");
+
+    if (nullptr != property && typeid(*property) == typeid(StringProperty) &&
+        static_cast<const StringProperty *>(property)->GetValueAsString() == name)
+      return it->Value();
+  }
+
+  return nullptr;
 }
 
 mitk::DataNode *mitk::DataStorage::GetNode(const NodePredicateBase *condition) const
@@ -13,6 +13,7 @@ found in the LICENSE file.
 // MITK
 #include "mitkImage.h"
 #include "mitkCompareImageDataFilter.h"
+#include "mitkImageReadAccessor.h"
 #include "mitkImageStatisticsHolder.h"
 #include "mitkImageVtkReadAccessor.h"
 #include "mitkImageVtkWriteAccessor.h"
@@ -24,6 +25,7 @@ found in the LICENSE file.
 
 // Other
 #include <cmath>
+#include <cstring>
 
 #define FILL_C_ARRAY(_arr, _size, _value)                                                                              \
   for (unsigned int i = 0u; i < _size; i++)                                                                            \
@@ -38,7 +40,8 @@ mitk::Image::Image()
     m_ImageDescriptor(nullptr),
     m_OffsetTable(nullptr),
     m_CompleteData(nullptr),
-    m_ImageStatistics(nullptr)
+    m_ImageStatistics(nullptr),
+    m_WriteCount(0)
 {
   m_Dimensions = new unsigned int[MAX_IMAGE_DIMENSIONS];
   FILL_C_ARRAY(m_Dimensions, MAX_IMAGE_DIMENSIONS, 0u);
@@ -53,7 +56,8 @@ mitk::Image::Image(const Image &other)
     m_ImageDescriptor(nullptr),
     m_OffsetTable(nullptr),
     m_CompleteData(nullptr),
-    m_ImageStatistics(nullptr)
+    m_ImageStatistics(nullptr),
+    m_WriteCount(0)
 {
   m_Dimensions = new unsigned int[MAX_IMAGE_DIMENSIONS];
   FILL_C_ARRAY(m_Dimensions, MAX_IMAGE_DIMENSIONS, 0u);
@@ -591,6 +595,10 @@ bool mitk::Image::SetImportSlice(void *data, int s, int t, int n, ImportMemoryMa
 {
   if (IsValidSlice(s, t, n) == false)
     return false;
+
+  // the data is written in place, snapshots sharing it keep their version
+  this->DetachSnapshotData();
+
   ImageDataItemPointer sl;
   const size_t ptypeSize = this->m_ImageDescriptor->GetChannelTypeById(n).GetSize();
 
@@ -627,6 +635,9 @@ bool mitk::Image::SetImportVolume(void *data, int t, int n, ImportMemoryManageme
   if (IsValidVolume(t, n) == false)
     return false;
 
+  // the data is written in place, snapshots sharing it keep their version
+  this->DetachSnapshotData();
+
   const size_t ptypeSize = this->m_ImageDescriptor->GetChannelTypeById(n).GetSize();
   ImageDataItemPointer vol;
   if (IsVolumeSet(t, n))
@@ -672,6 +683,9 @@ bool mitk::Image::SetImportChannel(void *data, int n, ImportMemoryManagementType
   if (IsValidChannel(n) == false)
     return false;
 
+  // the data is written in place, snapshots sharing it keep their version
+  this->DetachSnapshotData();
+
   // channel descriptor
 
   const size_t ptypeSize = this->m_ImageDescriptor->GetChannelTypeById(n).GetSize();
@@ -726,6 +740,8 @@ void mitk::Image::Initialize()
   }
   m_CompleteData = nullptr;
 
+  std::atomic_store(&m_Snapshot, std::shared_ptr<const ImageSnapshot::Buffer>());
+
   if (m_ImageStatistics == nullptr)
   {
     m_ImageStatistics = new mitk::ImageStatisticsHolder(this);
@@ -1194,10 +1210,119 @@ unsigned int *mitk::Image::GetDimensions() const
 void mitk::Image::Clear()
 {
   Superclass::Clear();
+
+  std::atomic_store(&m_Snapshot, std::shared_ptr<const ImageSnapshot::Buffer>());
+
   delete[] m_Dimensions;
   m_Dimensions = nullptr;
 }
 
+std::shared_ptr<const mitk::ImageSnapshot::Buffer> mitk::Image::GetSnapshotBuffer() const
+{
+  if (!this->IsInitialized())
+    mitkThrow() << "Cannot take a snapshot of an uninitialized image.";
+
+  auto isCurrent = [this](const std::shared_ptr<const ImageSnapshot::Buffer> &buffer) {
+    return nullptr != buffer && buffer->WriteCount == m_WriteCount.load() && buffer->ModifiedTime == this->GetMTime();
+  };
+
+  auto snapshot = std::atomic_load(&m_Snapshot);
+
+  if (isCurrent(snapshot))
+    return snapshot;
+
+  MutexHolder lock(m_SnapshotLock);
+
+  snapshot = std::atomic_load(&m_Snapshot);
+
+  if (isCurrent(snapshot))
+    return snapshot;
+
+  // Waits for running writers. The version is determined afterwards, so that changes
+  // by writers, which start later, are detected by the next request
+  ImageReadAccessor accessor(this);
+
+  const auto writeCount = m_WriteCount.load();
+  const auto modifiedTime = this->GetMTime();
+
+  std::vector<unsigned int> dimensions(m_Dimensions, m_Dimensions + m_Dimension);
+
+  std::size_t size = this->GetPixelType().GetSize();
+  for (auto dimension : dimensions)
+    size *= dimension;
+
+  std::shared_ptr<const void> owner;
+  {
+    MutexHolder arraysLock(m_ImageDataArraysLock);
+    owner = m_Channels[0]->ShareData();
+  }
+
+  const void *data = accessor.GetData();
+
+  if (nullptr == owner)
+  {
+    // The image does not manage its memory, e.g. memory imported with ReferenceMemory,
+    // hence the snapshot cannot keep it alive and has to copy it
+    std::shared_ptr<char> copy(new char[size], std::default_delete<char[]>());
+    std::memcpy(copy.get(), data, size);
+    data = copy.get();
+    owner = copy;
+  }
+
+  TimeGeometry::ConstPointer timeGeometry = this->GetTimeGeometry()->Clone().GetPointer();
+
+  snapshot = std::make_shared<ImageSnapshot::Buffer>(
+    this->GetPixelType(), dimensions, data, size, owner, timeGeometry, modifiedTime, writeCount);
+
+  std::atomic_store(&m_Snapshot, snapshot);
+
+  return snapshot;
+}
+
+void mitk::Image::DetachSnapshotData()
+{
+  MutexHolder lock(m_ReadWriteLock);
+  this->DetachSnapshotData_unlocked();
+}
+
+void mitk::Image::DetachSnapshotData_unlocked()
+{
+  // Snapshots taken from now on wait for the writer and share the new data version
+  std::atomic_store(&m_Snapshot, std::shared_ptr<const ImageSnapshot::Buffer>());
+
+  MutexHolder lock(m_ImageDataArraysLock);
+
+  if (m_Channels.empty() || m_Channels[0].IsNull())
+    return;
+
+  auto root = m_Channels[0].GetPointer();
+  while (root->GetParent().IsNotNull())
+    root = const_cast<ImageDataItem *>(root->GetParent().GetPointer());
+
+  if (!root->IsDataShared())
+    return;
+
+  auto previousData = root->CopySharedData();
+
+  for (auto *items : {&m_Slices, &m_Volumes, &m_Channels})
+  {
+    for (auto &item : *items)
+    {
+      if (item.IsNotNull() && item.GetPointer() != root)
+        item->RebaseData(previousData.get(), root->m_Data, root->m_Size);
+    }
+  }
+
+  if (m_CompleteData.IsNotNull() && m_CompleteData.GetPointer() != root)
+    m_CompleteData->RebaseData(previousData.get(), root->m_Data, root->m_Size);
+
+  this->m_ImageDescriptor->GetChannelDescriptor(0).SetData(m_Channels[0]->m_Data);
+
+  // Accessors of the image may still use the previous memory
+  if (!m_Readers.empty() || !m_Writers.empty())
+    m_RetiredData.push_back(previousData);
+}
+
 void mitk::Image::SetGeometry(BaseGeometry *aGeometry3D)
 {
   // Please be aware of the 0.5 offset/pixel-center issue! See Geometry documentation for further information
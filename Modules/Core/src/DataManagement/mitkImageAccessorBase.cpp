@@ -43,6 +43,7 @@ mitk::ImageAccessorBase::ImageAccessorBase(ImageConstPointer image,
                                            int OptionFlags)
   : // m_Image(iP)
     //, imageDataItem(iDI)
+    m_ImageDataItem(nullptr),
     m_SubRegion(nullptr),
     m_Options(OptionFlags),
     m_CoherentMemory(false)
@@ -94,6 +95,7 @@ mitk::ImageAccessorBase::ImageAccessorBase(ImageConstPointer image,
     image->m_ReadWriteLock.unlock();
 
     // Set memory area
+    m_ImageDataItem = imageDataItem;
     m_AddressBegin = imageDataItem->m_Data;
     m_AddressEnd = (unsigned char *)m_AddressBegin + imageDataItem->m_Size;
   }
@@ -104,6 +106,7 @@ mitk::ImageAccessorBase::ImageAccessorBase(ImageConstPointer image,
     m_CoherentMemory = true;
 
     // Set memory area
+    m_ImageDataItem = imageDataItem;
     m_AddressBegin = imageDataItem->m_Data;
     m_AddressEnd = (unsigned char *)m_AddressBegin + imageDataItem->m_Size;
   }
@@ -121,6 +124,15 @@ mitk::ImageAccessorBase::ImageAccessorBase(ImageConstPointer image,
   }
 }
 
+void mitk::ImageAccessorBase::UpdateAddresses()
+{
+  if (m_ImageDataItem == nullptr)
+    return;
+
+  m_AddressBegin = m_ImageDataItem->m_Data;
+  m_AddressEnd = (unsigned char *)m_AddressBegin + m_ImageDataItem->m_Size;
+}
+
 /** \brief Computes if there is an Overlap of the image part between this instantiation and another ImageAccessor object
  * \throws mitk::Exception if memory area is incoherent (not supported yet)
  */
@@ -0,0 +1,173 @@
+/*============================================================================
+
+The Medical Imaging Interaction Toolkit (MITK)
+
+Copyright (c) German Cancer Research Center (DKFZ)
+All rights reserved.
+
+Use of this source code is governed by a 3-clause BSD license that can be
+found in the LICENSE file.
+
+============================================================================*/
+
+#include <mitkImageDataBufferPool.h>
+
+namespace
+{
+  constexpr std::size_t MinimumSizeClass = 64;
+  constexpr std::size_t DefaultMaximumResidentSize = 256 * 1024 * 1024;
+}
+
+mitk::ImageDataBufferPool *mitk::ImageDataBufferPool::GetInstance()
+{
+  // Intentionally never destroyed: images held by static objects may release their buffers
+  // after all function-local statics have been destroyed.
+  static auto *instance = new ImageDataBufferPool;
+  return instance;
+}
+
+std::size_t mitk::ImageDataBufferPool::GetSizeClass(std::size_t size)
+{
+  if (size <= MinimumSizeClass)
+    return MinimumSizeClass;
+
+  // Largest power of two below size
+  std::size_t powerOfTwo = MinimumSizeClass;
+  while (powerOfTwo < (size - 1) / 2 + 1)
+    powerOfTwo *= 2;
+
+  const auto step = powerOfTwo / 4;
+  return (size + step - 1) / step * step;
+}
+
+mitk::ImageDataBufferPool::ImageDataBufferPool()
+  : m_MaximumResidentSize(DefaultMaximumResidentSize),
+    m_Statistics{0, 0, 0, 0}
+{
+}
+
+mitk::ImageDataBufferPool::~ImageDataBufferPool()
+{
+  this->Clear();
+}
+
+unsigned char *mitk::ImageDataBufferPool::Allocate(std::size_t size, bool &pooled)
+{
+  const auto sizeClass = GetSizeClass(size);
+
+  {
+    std::lock_guard<std::mutex> lock(m_Mutex);
+    ++m_Statistics.Requests;
+
+    // Buffers, which would never be kept by Release(), do not pay for the rounding to their size class
+    pooled = sizeClass <= m_MaximumResidentSize / 4;
+
+    if (!pooled)
+      return new unsigned char[size];
+
+    auto iter = m_FreeBuffers.find(sizeClass);
+
+    if (iter != m_FreeBuffers.end() && !iter->second.empty())
+    {
+      auto *buffer = iter->second.back();
+      iter->second.pop_back();
+
+      ++m_Statistics.Hits;
+      m_Statistics.ResidentSize -= sizeClass;
+      --m_Statistics.ResidentBuffers;
+
+      return buffer;
+    }
+  }
+
+  return new unsigned char[sizeClass];
+}
+
+void mitk::ImageDataBufferPool::Release(unsigned char *buffer, std::size_t size)
+{
+  if (nullptr == buffer)
+    return;
+
+  const auto sizeClass = GetSizeClass(size);
+
+  {
+    std::lock_guard<std::mutex> lock(m_Mutex);
+
+    if (sizeClass <= m_MaximumResidentSize / 4 && m_Statistics.ResidentSize + sizeClass <= m_MaximumResidentSize)
+    {
+      m_FreeBuffers[sizeClass].push_back(buffer);
+
+      m_Statistics.ResidentSize += sizeClass;
+      ++m_Statistics.ResidentBuffers;
+
+      return;
+    }
+  }
+
+  delete[] buffer;
+}
+
+void mitk::ImageDataBufferPool::SetMaximumResidentSize(std::size_t maximumResidentSize)
+{
+  std::lock_guard<std::mutex> lock(m_Mutex);
+  m_MaximumResidentSize = maximumResidentSize;
+  this->ShrinkToMaximumResidentSize();
+}
+
+std::size_t mitk::ImageDataBufferPool::GetMaximumResidentSize() const
+{
+  std::lock_guard<std::mutex> lock(m_Mutex);
+  return m_MaximumResidentSize;
+}
+
+mitk::ImageDataBufferPool::Statistics mitk::ImageDataBufferPool::GetStatistics() const
+{
+  std::lock_guard<std::mutex> lock(m_Mutex);
+  return m_Statistics;
+}
+
+void mitk::ImageDataBufferPool::ResetStatistics()
+{
+  std::lock_guard<std::mutex> lock(m_Mutex);
+  m_Statistics.Requests = 0;
+  m_Statistics.Hits = 0;
+}
+
+void mitk::ImageDataBufferPool::Clear()
+{
+  std::lock_guard<std::mutex> lock(m_Mutex);
+
+  for (auto &freeBuffers : m_FreeBuffers)
+  {
+    for (auto *buffer : freeBuffers.second)
+      delete[] buffer;
+  }
+
+  m_FreeBuffers.clear();
+  m_Statistics.ResidentSize = 0;
+  m_Statistics.ResidentBuffers = 0;
+}
+
+void mitk::ImageDataBufferPool::ShrinkToMaximumResidentSize()
+{
+  // Free the largest buffers first, they are the most expensive to keep
+  auto iter = m_FreeBuffers.rbegin();
+
+  while (iter != m_FreeBuffers.rend() &&
+         (m_Statistics.ResidentSize > m_MaximumResidentSize || iter->first > m_MaximumResidentSize / 4))
+  {
+    auto &freeBuffers = iter->second;
+
+    while (!freeBuffers.empty() &&
+           (m_Statistics.ResidentSize > m_MaximumResidentSize || iter->first > m_MaximumResidentSize / 4))
+    {
+      delete[] freeBuffers.back();
+      freeBuffers.pop_back();
+
+      m_Statistics.ResidentSize -= iter->first;
+      --m_Statistics.ResidentBuffers;
+    }
+
+    ++iter;
+  }
+}
@@ -27,9 +27,12 @@ found in the LICENSE file.
 #include <vtkUnsignedShortArray.h>
 
 #include <mitkImage.h>
+#include <mitkImageDataBufferPool.h>
 #include <mitkImageVtkReadAccessor.h>
 #include <mitkImageVtkWriteAccessor.h>
 
+#include <functional>
+
 mitk::ImageDataItem::ImageDataItem(const ImageDataItem &aParent,
                                    const mitk::ImageDescriptor::Pointer desc,
                                    int timestep,
@@ -40,6 +43,7 @@ mitk::ImageDataItem::ImageDataItem(const ImageDataItem &aParent,
   : m_Data(static_cast<unsigned char *>(aParent.m_Data) + offset),
     m_PixelType(new mitk::PixelType(aParent.GetPixelType())),
     m_ManageMemory(false),
+    m_PooledMemory(false),
     m_VtkImageData(nullptr),
     m_VtkImageReadAccessor(nullptr),
     m_VtkImageWriteAccessor(nullptr),
@@ -88,8 +92,13 @@ mitk::ImageDataItem::~ImageDataItem()
 
   if (m_Parent.IsNull())
   {
-    if (m_ManageMemory)
-      delete[] m_Data;
+    if (m_ManageMemory && nullptr == m_SharedData)
+    {
+      if (m_PooledMemory)
+        ImageDataBufferPool::GetInstance()->Release(m_Data, m_Size);
+      else
+        delete[] m_Data;
+    }
   }
   delete m_PixelType;
 }
@@ -101,6 +110,7 @@ mitk::ImageDataItem::ImageDataItem(const mitk::ImageDescriptor::Pointer desc,
   : m_Data(static_cast<unsigned char *>(data)),
     m_PixelType(new mitk::PixelType(desc->GetChannelDescriptor(0).GetPixelType())),
     m_ManageMemory(manageMemory),
+    m_PooledMemory(false),
     m_VtkImageData(nullptr),
     m_VtkImageReadAccessor(nullptr),
     m_VtkImageWriteAccessor(nullptr),
@@ -121,7 +131,7 @@ mitk::ImageDataItem::ImageDataItem(const mitk::ImageDescriptor::Pointer desc,
 
   if (m_Data == nullptr)
   {
-    m_Data = new unsigned char[m_Size];
+    m_Data = ImageDataBufferPool::GetInstance()->Allocate(m_Size, m_PooledMemory);
     m_ManageMemory = true;
   }
 
@@ -137,6 +147,7 @@ mitk::ImageDataItem::ImageDataItem(const mitk::PixelType &type,
   : m_Data(static_cast<unsigned char *>(data)),
     m_PixelType(new mitk::PixelType(type)),
     m_ManageMemory(manageMemory),
+    m_PooledMemory(false),
     m_VtkImageData(nullptr),
     m_VtkImageReadAccessor(nullptr),
     m_VtkImageWriteAccessor(nullptr),
@@ -156,7 +167,7 @@ mitk::ImageDataItem::ImageDataItem(const mitk::PixelType &type,
 
   if (m_Data == nullptr)
   {
-    m_Data = new unsigned char[m_Size];
+    m_Data = ImageDataBufferPool::GetInstance()->Allocate(m_Size, m_PooledMemory);
     m_ManageMemory = true;
   }
 
@@ -168,6 +179,7 @@ mitk::ImageDataItem::ImageDataItem(const ImageDataItem &other)
     m_Data(other.m_Data),
     m_PixelType(new mitk::PixelType(*other.m_PixelType)),
     m_ManageMemory(other.m_ManageMemory),
+    m_PooledMemory(other.m_PooledMemory),
     m_VtkImageData(nullptr),
     m_VtkImageReadAccessor(nullptr),
     m_VtkImageWriteAccessor(nullptr),
@@ -300,6 +312,68 @@ void mitk::ImageDataItem::ConstructVtkImageData(ImageConstPointer iP) const
   scalars->Delete();
 }
 
+std::shared_ptr<const unsigned char> mitk::ImageDataItem::ShareData() const
+{
+  if (m_Parent.IsNotNull())
+    return m_Parent->ShareData();
+
+  if (!m_ManageMemory)
+    return nullptr;
+
+  if (nullptr == m_SharedData)
+  {
+    const auto size = m_Size;
+
+    if (m_PooledMemory)
+    {
+      m_SharedData.reset(m_Data, [size](unsigned char *data) { ImageDataBufferPool::GetInstance()->Release(data, size); });
+    }
+    else
+    {
+      m_SharedData.reset(m_Data, std::default_delete<unsigned char[]>());
+    }
+  }
+
+  return m_SharedData;
+}
+
+bool mitk::ImageDataItem::IsDataShared() const
+{
+  return nullptr != m_SharedData && m_SharedData.use_count() > 1;
+}
+
+std::shared_ptr<unsigned char> mitk::ImageDataItem::CopySharedData()
+{
+  bool pooled = false;
+  auto data = ImageDataBufferPool::GetInstance()->Allocate(m_Size, pooled);
+  memcpy(data, m_Data, m_Size);
+
+  std::shared_ptr<unsigned char> previousData;
+  previousData.swap(m_SharedData);
+
+  m_PooledMemory = pooled;
+  this->RebaseData(previousData.get(), data, m_Size);
+
+  return previousData;
+}
+
+void mitk::ImageDataItem::RebaseData(const unsigned char *oldRootData, unsigned char *newRootData, size_t rootSize)
+{
+  const std::less<const unsigned char *> less;
+
+  if (less(m_Data, oldRootData) || !less(m_Data, oldRootData + rootSize))
+    return;
+
+  m_Data = newRootData + (m_Data - oldRootData);
+
+  if (nullptr != m_VtkImageData)
+  {
+    auto scalars = m_VtkImageData->GetPointData()->GetScalars();
+    scalars->SetVoidArray(m_Data, scalars->GetNumberOfValues(), 1);
+    m_VtkImageData->Modified();
+  }
+}
+
 void mitk::ImageDataItem::Modified() const
 {
   if (m_VtkImageData)
@@ -66,6 +66,10 @@ mitk::ImageReadAccessor::~ImageReadAccessor()
     auto it = std::find(m_Image->m_Readers.begin(), m_Image->m_Readers.end(), this);
     m_Image->m_Readers.erase(it);
 
+    // memory of snapshots, which was moved while this accessor used it, is released with the last accessor
+    if (m_Image->m_Readers.empty() && m_Image->m_Writers.empty())
+      m_Image->m_RetiredData.clear();
+
     // delete lock, if there are no waiting ImageAccessors
     if (m_WaitLock->m_WaiterCount <= 0)
     {
@@ -94,6 +98,9 @@ void mitk::ImageReadAccessor::OrganizeReadAccess()
 {
   m_Image->m_ReadWriteLock.lock();
 
+  // a writer may have moved the data for the snapshots of the image since the construction or the last wait
+  UpdateAddresses();
+
   // Check, if there is any Write-Access going on
   if (m_Image->m_Writers.size() > 0)
   {
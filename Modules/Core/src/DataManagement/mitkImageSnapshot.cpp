@@ -0,0 +1,180 @@
+/*============================================================================
+
+The Medical Imaging Interaction Toolkit (MITK)
+
+Copyright (c) German Cancer Research Center (DKFZ)
+All rights reserved.
+
+Use of this source code is governed by a 3-clause BSD license that can be
+found in the LICENSE file.
+
+============================================================================*/
+
+#include <mitkImageSnapshot.h>
+
+#include <mitkException.h>
+#include <mitkImage.h>
+
+#include <vtkCommand.h>
+#include <vtkDataArray.h>
+#include <vtkImageData.h>
+#include <vtkPointData.h>
+
+#include <algorithm>
+#include <utility>
+
+namespace
+{
+  /** Keeps the buffer of a snapshot alive until the vtkDataArray, which views it, is deleted. */
+  class BufferHolder : public vtkCommand
+  {
+  public:
+    static BufferHolder *New() { return new BufferHolder; }
+
+    void Execute(vtkObject *, unsigned long, void *) override { m_Buffer.reset(); }
+
+    std::shared_ptr<const mitk::ImageSnapshot::Buffer> m_Buffer;
+  };
+
+  int GetVtkDataType(const mitk::PixelType &pixelType)
+  {
+    switch (pixelType.GetComponentType())
+    {
+      case itk::IOComponentEnum::CHAR:
+        return VTK_CHAR;
+      case itk::IOComponentEnum::UCHAR:
+        return VTK_UNSIGNED_CHAR;
+      case itk::IOComponentEnum::SHORT:
+        return VTK_SHORT;
+      case itk::IOComponentEnum::USHORT:
+        return VTK_UNSIGNED_SHORT;
+      case itk::IOComponentEnum::INT:
+        return VTK_INT;
+      case itk::IOComponentEnum::UINT:
+        return VTK_UNSIGNED_INT;
+      case itk::IOComponentEnum::LONG:
+        return VTK_LONG;
+      case itk::IOComponentEnum::ULONG:
+        return VTK_UNSIGNED_LONG;
+      case itk::IOComponentEnum::FLOAT:
+        return VTK_FLOAT;
+      case itk::IOComponentEnum::DOUBLE:
+        return VTK_DOUBLE;
+      default:
+        mitkThrow() << "Pixel type " << pixelType.GetTypeAsString() << " is not supported by VTK.";
+    }
+  }
+}
+
+mitk::ImageSnapshot::Buffer::Buffer(const PixelType &pixelType,
+                                    std::vector<unsigned int> dimensions,
+                                    const void *data,
+                                    std::size_t size,
+                                    std::shared_ptr<const void> owner,
+                                    TimeGeometry::ConstPointer timeGeometry,
+                                    itk::ModifiedTimeType modifiedTime,
+                                    itk::SizeValueType writeCount)
+  : Type(pixelType),
+    Dimensions(std::move(dimensions)),
+    Data(static_cast<const char *>(data)),
+    Size(size),
+    Owner(std::move(owner)),
+    Geometry(std::move(timeGeometry)),
+    ModifiedTime(modifiedTime),
+    WriteCount(writeCount)
+{
+}
+
+mitk::ImageSnapshot::ImageSnapshot()
+{
+}
+
+mitk::ImageSnapshot::ImageSnapshot(const Image *image)
+{
+  if (nullptr == image)
+    mitkThrow() << "Cannot take a snapshot of a null image.";
+
+  m_Buffer = image->GetSnapshotBuffer();
+}
+
+const void *mitk::ImageSnapshot::GetData() const
+{
+  return nullptr != m_Buffer ? m_Buffer->Data : nullptr;
+}
+
+const void *mitk::ImageSnapshot::GetVolumeData(unsigned int t) const
+{
+  if (nullptr == m_Buffer)
+    return nullptr;
+
+  const auto timeSteps = m_Buffer->Dimensions.size() > 3 ? m_Buffer->Dimensions[3] : 1u;
+
+  if (t >= timeSteps)
+    mitkThrow() << "Time step " << t << " is out of range, the snapshot has " << timeSteps << " time steps.";
+
+  return m_Buffer->Data + t * (m_Buffer->Size / timeSteps);
+}
+
+std::size_t mitk::ImageSnapshot::GetSize() const
+{
+  return nullptr != m_Buffer ? m_Buffer->Size : 0;
+}
+
+const mitk::PixelType &mitk::ImageSnapshot::GetPixelType() const
+{
+  if (nullptr == m_Buffer)
+    mitkThrow() << "The snapshot is empty.";
+
+  return m_Buffer->Type;
+}
+
+unsigned int mitk::ImageSnapshot::GetDimension() const
+{
+  return nullptr != m_Buffer ? static_cast<unsigned int>(m_Buffer->Dimensions.size()) : 0;
+}
+
+unsigned int mitk::ImageSnapshot::GetDimension(unsigned int i) const
+{
+  return nullptr != m_Buffer && i < m_Buffer->Dimensions.size() ? m_Buffer->Dimensions[i] : 0;
+}
+
+const mitk::TimeGeometry *mitk::ImageSnapshot::GetTimeGeometry() const
+{
+  return nullptr != m_Buffer ? m_Buffer->Geometry.GetPointer() : nullptr;
+}
+
+vtkSmartPointer<vtkImageData> mitk::ImageSnapshot::GetVtkImageData(unsigned int t) const
+{
+  if (nullptr == m_Buffer)
+    mitkThrow() << "The snapshot is empty.";
+
+  auto data = this->GetVolumeData(t);
+  auto scalars = vtkSmartPointer<vtkDataArray>::Take(vtkDataArray::CreateDataArray(GetVtkDataType(m_Buffer->Type)));
+
+  const auto numberOfComponents = static_cast<vtkIdType>(m_Buffer->Type.GetNumberOfComponents());
+  const auto numberOfPoints = static_cast<vtkIdType>(this->GetDimension(0)) *
+                              std::max(this->GetDimension(1), 1u) * std::max(this->GetDimension(2), 1u);
+
+  // the array does not free the data, the holder keeps the buffer alive as long as the array exists
+  scalars->SetNumberOfComponents(static_cast<int>(numberOfComponents));
+  scalars->SetVoidArray(const_cast<void *>(data), numberOfPoints * numberOfComponents, 1);
+
+  auto holder = vtkSmartPointer<BufferHolder>::New();
+  holder->m_Buffer = m_Buffer;
+  scalars->AddObserver(vtkCommand::DeleteEvent, holder);
+
+  auto vtkImage = vtkSmartPointer<vtkImageData>::New();
+  vtkImage->SetDimensions(this->GetDimension(0), std::max(this->GetDimension(1), 1u), std::max(this->GetDimension(2), 1u));
+  vtkImage->SetOrigin(0, 0, 0);
+
+  auto geometry = m_Buffer->Geometry->GetGeometryForTimeStep(t);
+  if (geometry.IsNotNull())
+  {
+    const auto &spacing = geometry->GetSpacing();
+    vtkImage->SetSpacing(spacing[0], spacing[1], spacing[2]);
+  }
+
+  vtkImage->GetPointData()->SetScalars(scalars);
+
+  return vtkImage;
+}
@@ -24,12 +24,19 @@ mitk::ImageWriteAccessor::~ImageWriteAccessor()
   // In case of non-coherent memory, copied area needs to be written back
   // TODO
 
+  // The data may have been changed, hence the next snapshot has to copy it again
+  ++m_Image->m_WriteCount;
+
   m_Image->m_ReadWriteLock.lock();
 
   // delete self from list of ImageReadAccessors in Image
   auto it = std::find(m_Image->m_Writers.begin(), m_Image->m_Writers.end(), this);
   m_Image->m_Writers.erase(it);
 
+  // memory of snapshots, which was moved while this accessor used it, is released with the last accessor
+  if (m_Image->m_Readers.empty() && m_Image->m_Writers.empty())
+    m_Image->m_RetiredData.clear();
+
   // delete lock, if there are no waiting ImageAccessors
   if (m_WaitLock->m_WaiterCount <= 0)
   {
@@ -53,6 +60,9 @@ void mitk::ImageWriteAccessor::OrganizeWriteAccess()
 {
   m_Image->m_ReadWriteLock.lock();
 
+  // a writer may have moved the data for the snapshots of the image since the construction or the last wait
+  UpdateAddresses();
+
   bool readOverlap = false;
   bool writeOverlap = false;
 
@@ -134,7 +144,11 @@ void mitk::ImageWriteAccessor::OrganizeWriteAccess()
     }
   }
 
-  // Now, we know, that there is no conflict with a Read- or Write-Access
+  // Now, we know, that there is no conflict with a Read- or Write-Access.
+  // Snapshots must not see the changes, hence the data is moved if a snapshot still shares it
+  m_Image->DetachSnapshotData_unlocked();
+  UpdateAddresses();
+
   // Lock the Mutex in ImageAccessorBase, to make sure that every other ImageAccessor has to wait
   m_WaitLock->m_Mutex.lock();
 
@@ -0,0 +1,80 @@
+/*============================================================================
+
+The Medical Imaging Interaction Toolkit (MITK)
+
+Copyright (c) German Cancer Research Center (DKFZ)
+All rights reserved.
+
+Use of this source code is governed by a 3-clause BSD license that can be
+found in the LICENSE file.
+
+============================================================================*/
+
+#include <mitkPropertyKey.h>
+
+#include <mutex>
+#include <unordered_set>
+
+namespace
+{
+  // Elements of an unordered_set are never moved, so pointers to interned keys stay valid.
+  struct KeyTable
+  {
+    std::mutex Mutex;
+    std::unordered_set<std::string> Keys;
+  };
+
+  KeyTable &GetKeyTable()
+  {
+    static KeyTable table;
+    return table;
+  }
+
+  const std::string *Intern(const std::string &key)
+  {
+    auto &table = GetKeyTable();
+    std::lock_guard<std::mutex> lock(table.Mutex);
+    return &*table.Keys.insert(key).first;
+  }
+}
+
+mitk::PropertyKey::PropertyKey(const std::string &key)
+  : m_Key(Intern(key)),
+    m_Hash(std::hash<std::string>()(*m_Key))
+{
+}
+
+mitk::PropertyKey::PropertyKey(const char *key)
+  : PropertyKey(std::string(nullptr != key ? key : ""))
+{
+}
+
+const mitk::PropertyKey &mitk::PropertyKeys::Visible()
+{
+  static const PropertyKey key("visible");
+  return key;
+}
+
+const mitk::PropertyKey &mitk::PropertyKeys::Opacity()
+{
+  static const PropertyKey key("opacity");
+  return key;
+}
+
+const mitk::PropertyKey &mitk::PropertyKeys::Color()
+{
+  static const PropertyKey key("color");
+  return key;
+}
+
+const mitk::PropertyKey &mitk::PropertyKeys::Layer()
+{
+  static const PropertyKey key("layer");
+  return key;
+}
+
+const mitk::PropertyKey &mitk::PropertyKeys::LevelWindow()
+{
+  static const PropertyKey key("levelwindow");
+  return key;
+}
@@ -56,6 +56,15 @@ mitk::BaseProperty *mitk::PropertyList::GetProperty(const std::string &propertyK
     return nullptr;
 }
 
+mitk::BaseProperty *mitk::PropertyList::GetProperty(const PropertyKey &propertyKey) const
+{
+  auto it = m_Properties.find(propertyKey.GetString());
+
+  return it != m_Properties.cend()
+    ? it->second.GetPointer()
+    : nullptr;
+}
+
 mitk::BaseProperty * mitk::PropertyList::GetNonConstProperty(const std::string &propertyKey, const std::string &/*contextName*/, bool /*fallBackOnDefaultContext*/)
 {
   return this->GetProperty(propertyKey);
@@ -247,6 +256,17 @@ bool mitk::PropertyList::GetBoolProperty(const char *propertyKey, bool &boolValu
   // return GetPropertyValue<bool>(propertyKey, boolValue);
 }
 
+bool mitk::PropertyList::GetBoolProperty(const PropertyKey &propertyKey, bool &boolValue) const
+{
+  auto gp = this->GetTypedProperty<BoolProperty>(propertyKey);
+  if (gp != nullptr)
+  {
+    boolValue = gp->GetValue();
+    return true;
+  }
+  return false;
+}
+
 bool mitk::PropertyList::GetIntProperty(const char *propertyKey, int &intValue) const
 {
   IntProperty *gp = dynamic_cast<IntProperty *>(GetProperty(propertyKey));
@@ -260,6 +280,17 @@ bool mitk::PropertyList::GetIntProperty(const char *propertyKey, int &intValue)
   // return GetPropertyValue<int>(propertyKey, intValue);
 }
 
+bool mitk::PropertyList::GetIntProperty(const PropertyKey &propertyKey, int &intValue) const
+{
+  auto gp = this->GetTypedProperty<IntProperty>(propertyKey);
+  if (gp != nullptr)
+  {
+    intValue = gp->GetValue();
+    return true;
+  }
+  return false;
+}
+
 bool mitk::PropertyList::GetFloatProperty(const char *propertyKey, float &floatValue) const
 {
   FloatProperty *gp = dynamic_cast<FloatProperty *>(GetProperty(propertyKey));
@@ -273,6 +304,17 @@ bool mitk::PropertyList::GetFloatProperty(const char *propertyKey, float &floatV
   // return GetPropertyValue<float>(propertyKey, floatValue);
 }
 
+bool mitk::PropertyList::GetFloatProperty(const PropertyKey &propertyKey, float &floatValue) const
+{
+  auto gp = this->GetTypedProperty<FloatProperty>(propertyKey);
+  if (gp != nullptr)
+  {
+    floatValue = gp->GetValue();
+    return true;
+  }
+  return false;
+}
+
 bool mitk::PropertyList::GetStringProperty(const char *propertyKey, std::string &stringValue) const
 {
   StringProperty *sp = dynamic_cast<StringProperty *>(GetProperty(propertyKey));
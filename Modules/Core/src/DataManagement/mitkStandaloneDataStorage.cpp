@@ -14,11 +14,308 @@ found in the LICENSE file.
 
 #include "mitkDataNode.h"
 #include "mitkGroupTagProperty.h"
+#include "mitkNodePredicateAnd.h"
 #include "mitkNodePredicateBase.h"
+#include "mitkNodePredicateDataType.h"
+#include "mitkNodePredicateOr.h"
 #include "mitkNodePredicateProperty.h"
 #include "mitkProperties.h"
 
-mitk::StandaloneDataStorage::StandaloneDataStorage() : mitk::DataStorage()
+#include <itkCommand.h>
+
+#include <algorithm>
+#include <functional>
+#include <iterator>
+#include <set>
+#include <typeinfo>
+
+namespace
+{
+  /** Command that marks a node as modified in the index when the node or one of its indexed properties changes.*/
+  class IndexedObjectModifiedCommand : public itk::Command
+  {
+  public:
+    typedef IndexedObjectModifiedCommand Self;
+    typedef itk::Command Superclass;
+    typedef itk::SmartPointer<Self> Pointer;
+
+    itkNewMacro(Self);
+
+    void SetCallback(const std::function<void()> &callback) { m_Callback = callback; }
+
+    void Execute(itk::Object *, const itk::EventObject &) override { m_Callback(); }
+    void Execute(const itk::Object *, const itk::EventObject &) override { m_Callback(); }
+
+  private:
+    std::function<void()> m_Callback;
+  };
+}
+
+struct mitk::StandaloneDataStorage::Index
+{
+  typedef std::set<const DataNode *> NodeSet;
+
+  struct NodeEntry
+  {
+    unsigned long NodeObserverTag = 0;
+    std::string DataType;
+    std::map<std::string, std::string> PropertyValues;
+    std::vector<std::pair<BaseProperty::Pointer, unsigned long>> PropertyObserverTags;
+  };
+
+  std::set<std::string> PropertyKeys = { "name" };
+  std::map<const DataNode *, NodeEntry> Entries;
+
+  std::map<std::string, NodeSet> NodesByDataType;
+  std::map<std::string, std::map<std::string, NodeSet>> NodesByPropertyValue;
+
+  // Nodes without an indexed key in their own property list. They are candidates of every query
+  // for the key, as DataNode::GetProperty() falls back on the property list of the data.
+  std::map<std::string, NodeSet> NodesWithoutProperty;
+
+  // Nodes are reindexed lazily before the next query. Modified events may arrive from any
+  // thread and while m_Mutex is locked, so the modified nodes are guarded separately.
+  std::mutex ModifiedNodesMutex;
+  NodeSet ModifiedNodes;
+
+  ~Index()
+  {
+    while (!Entries.empty())
+      this->Erase(Entries.begin()->first);
+  }
+
+  void MarkModified(const DataNode *node)
+  {
+    std::lock_guard<std::mutex> lock(ModifiedNodesMutex);
+    ModifiedNodes.insert(node);
+  }
+
+  void MarkAllModified()
+  {
+    std::lock_guard<std::mutex> lock(ModifiedNodesMutex);
+
+    for (const auto &entry : Entries)
+      ModifiedNodes.insert(entry.first);
+  }
+
+  IndexedObjectModifiedCommand::Pointer CreateCommand(const DataNode *node)
+  {
+    auto command = IndexedObjectModifiedCommand::New();
+    command->SetCallback([this, node]() { this->MarkModified(node); });
+    return command;
+  }
+
+  void Insert(const DataNode *node)
+  {
+    Entries[node].NodeObserverTag = node->AddObserver(itk::ModifiedEvent(), this->CreateCommand(node));
+    this->MarkModified(node);
+  }
+
+  void Erase(const DataNode *node)
+  {
+    auto iter = Entries.find(node);
+
+    if (iter == Entries.end())
+      return;
+
+    this->Unindex(node, iter->second);
+    const_cast<DataNode *>(node)->RemoveObserver(iter->second.NodeObserverTag);
+    Entries.erase(iter);
+  }
+
+  void Update()
+  {
+    NodeSet modifiedNodes;
+
+    {
+      std::lock_guard<std::mutex> lock(ModifiedNodesMutex);
+      modifiedNodes.swap(ModifiedNodes);
+    }
+
+    for (auto node : modifiedNodes)
+    {
+      auto iter = Entries.find(node);
+
+      if (iter != Entries.end())
+        this->Reindex(node, iter->second);
+    }
+  }
+
+  /** Collects a superset of the nodes that meet the condition. Returns false if the condition cannot be answered from the index.*/
+  bool CollectCandidates(const NodePredicateBase *condition, NodeSet &candidates) const
+  {
+    if (nullptr == condition)
+      return false;
+
+    // Exact type checks, as subclasses may change the meaning of a predicate
+    const auto &type = typeid(*condition);
+
+    if (type == typeid(NodePredicateDataType))
+    {
+      auto iter = NodesByDataType.find(static_cast<const NodePredicateDataType *>(condition)->GetValidDataType());
+      candidates = iter != NodesByDataType.end() ? iter->second : NodeSet();
+      return true;
+    }
+
+    if (type == typeid(NodePredicateProperty))
+    {
+      const auto *predicate = static_cast<const NodePredicateProperty *>(condition);
+      const auto &key = predicate->GetValidPropertyName();
+
+      if (nullptr != predicate->GetRenderer() || nullptr == predicate->GetValidProperty() || 0 == PropertyKeys.count(key))
+        return false;
+
+      this->CollectPropertyCandidates(key, predicate->GetValidProperty()->GetValueAsString(), candidates);
+      return true;
+    }
+
+    if (type == typeid(NodePredicateAnd))
+    {
+      bool isIndexed = false;
+
+      for (const auto &child : static_cast<const NodePredicateAnd *>(condition)->GetPredicates())
+      {
+        NodeSet childCandidates;
+
+        if (!this->CollectCandidates(child, childCandidates))
+          continue;
+
+        if (isIndexed)
+        {
+          NodeSet intersection;
+          std::set_intersection(candidates.begin(), candidates.end(), childCandidates.begin(), childCandidates.end(),
+            std::inserter(intersection, intersection.end()));
+          candidates.swap(intersection);
+        }
+        else
+        {
+          candidates.swap(childCandidates);
+          isIndexed = true;
+        }
+      }
+
+      return isIndexed;
+    }
+
+    if (type == typeid(NodePredicateOr))
+    {
+      const auto children = static_cast<const NodePredicateOr *>(condition)->GetPredicates();
+
+      if (children.empty())
+        return false;
+
+      NodeSet result;
+
+      for (const auto &child : children)
+      {
+        NodeSet childCandidates;
+
+        if (!this->CollectCandidates(child, childCandidates))
+          return false;
+
+        result.insert(childCandidates.begin(), childCandidates.end());
+      }
+
+      candidates.swap(result);
+      return true;
+    }
+
+    return false;
+  }
+
+  /** Collects the nodes with the value of an indexed key and the nodes without the key in their own property list.*/
+  void CollectPropertyCandidates(const std::string &key, const std::string &value, NodeSet &candidates) const
+  {
+    candidates.clear();
+
+    auto values = NodesByPropertyValue.find(key);
+
+    if (values != NodesByPropertyValue.end())
+    {
+      auto nodes = values->second.find(value);
+
+      if (nodes != values->second.end())
+        candidates = nodes->second;
+    }
+
+    auto nodesWithoutProperty = NodesWithoutProperty.find(key);
+
+    if (nodesWithoutProperty != NodesWithoutProperty.end())
+      candidates.insert(nodesWithoutProperty->second.begin(), nodesWithoutProperty->second.end());
+  }
+
+private:
+  static void EraseFromSet(std::map<std::string, NodeSet> &sets, const std::string &key, const DataNode *node)
+  {
+    auto iter = sets.find(key);
+
+    if (iter == sets.end())
+      return;
+
+    iter->second.erase(node);
+
+    if (iter->second.empty())
+      sets.erase(iter);
+  }
+
+  void Unindex(const DataNode *node, NodeEntry &entry)
+  {
+    if (!entry.DataType.empty())
+      EraseFromSet(NodesByDataType, entry.DataType, node);
+
+    for (const auto &key : PropertyKeys)
+      EraseFromSet(NodesWithoutProperty, key, node);
+
+    for (const auto &value : entry.PropertyValues)
+    {
+      auto values = NodesByPropertyValue.find(value.first);
+
+      if (values != NodesByPropertyValue.end())
+        EraseFromSet(values->second, value.second, node);
+    }
+
+    for (auto &propertyObserverTag : entry.PropertyObserverTags)
+      propertyObserverTag.first->RemoveObserver(propertyObserverTag.second);
+
+    entry.DataType.clear();
+    entry.PropertyValues.clear();
+    entry.PropertyObserverTags.clear();
+  }
+
+  void Reindex(const DataNode *node, NodeEntry &entry)
+  {
+    this->Unindex(node, entry);
+
+    if (const auto *data = node->GetData())
+    {
+      entry.DataType = data->GetNameOfClass();
+      NodesByDataType[entry.DataType].insert(node);
+    }
+
+    const auto *properties = node->GetPropertyList();
+
+    for (const auto &key : PropertyKeys)
+    {
+      auto *property = properties->GetProperty(key);
+
+      if (nullptr == property)
+      {
+        NodesWithoutProperty[key].insert(node);
+        continue;
+      }
+
+      auto value = property->GetValueAsString();
+      NodesByPropertyValue[key][value].insert(node);
+      entry.PropertyValues[key] = value;
+
+      // Values of existing properties may change without a modified event of the node
+      auto tag = property->AddObserver(itk::ModifiedEvent(), this->CreateCommand(node));
+      entry.PropertyObserverTags.emplace_back(property, tag);
+    }
+  }
+};
+
+mitk::StandaloneDataStorage::StandaloneDataStorage() : mitk::DataStorage(), m_Index(new Index)
 {
 }
 
@@ -79,6 +376,8 @@ void mitk::StandaloneDataStorage::Add(mitk::DataNode *node, const mitk::DataStor
 
     // register for ITK changed events
     this->AddListeners(node);
+
+    m_Index->Insert(node);
   }
 
   /* Notify observers */
@@ -107,6 +406,8 @@ void mitk::StandaloneDataStorage::Remove(const mitk::DataNode *node)
   EmitRemoveNodeEvent(node);
   {
     std::lock_guard<std::mutex> locked(m_Mutex);
+    m_Index->Erase(node);
+
     /* remove node from both relation adjacency lists */
     this->RemoveFromRelation(node, m_SourceNodes);
     this->RemoveFromRelation(node, m_DerivedNodes);
@@ -159,6 +460,64 @@ mitk::DataStorage::SetOfObjects::ConstPointer mitk::StandaloneDataStorage::GetAl
   return SetOfObjects::ConstPointer(resultset);
 }
 
+void mitk::StandaloneDataStorage::AddIndexedPropertyKey(const std::string &propertyKey)
+{
+  std::lock_guard<std::mutex> locked(m_Mutex);
+
+  if (m_Index->PropertyKeys.insert(propertyKey).second)
+    m_Index->MarkAllModified();
+}
+
+std::vector<std::string> mitk::StandaloneDataStorage::GetIndexedPropertyKeys() const
+{
+  std::lock_guard<std::mutex> locked(m_Mutex);
+  return std::vector<std::string>(m_Index->PropertyKeys.begin(), m_Index->PropertyKeys.end());
+}
+
+mitk::DataStorage::SetOfObjects::ConstPointer mitk::StandaloneDataStorage::GetSubsetCandidates(
+  const NodePredicateBase *condition) const
+{
+  {
+    std::lock_guard<std::mutex> locked(m_Mutex);
+    m_Index->Update();
+
+    Index::NodeSet candidates;
+
+    if (m_Index->CollectCandidates(condition, candidates))
+    {
+      /* the candidates are ordered by their address like the nodes returned by GetAll() */
+      mitk::DataStorage::SetOfObjects::Pointer resultset = mitk::DataStorage::SetOfObjects::New();
+      unsigned int index = 0;
+
+      for (const auto *node : candidates)
+        resultset->InsertElement(index++, const_cast<mitk::DataNode *>(node));
+
+      return SetOfObjects::ConstPointer(resultset);
+    }
+  }
+
+  return this->GetAll();
+}
+
+mitk::DataStorage::SetOfObjects::ConstPointer mitk::StandaloneDataStorage::GetNamedNodeCandidates(
+  const std::string &name) const
+{
+  std::lock_guard<std::mutex> locked(m_Mutex);
+  m_Index->Update();
+
+  Index::NodeSet candidates;
+  m_Index->CollectPropertyCandidates("name", name, candidates);
+
+  /* the candidates are ordered by their address like the nodes returned by GetAll() */
+  mitk::DataStorage::SetOfObjects::Pointer resultset = mitk::DataStorage::SetOfObjects::New();
+  unsigned int index = 0;
+
+  for (const auto *node : candidates)
+    resultset->InsertElement(index++, const_cast<mitk::DataNode *>(node));
+
+  return SetOfObjects::ConstPointer(resultset);
+}
+
 mitk::DataStorage::SetOfObjects::ConstPointer mitk::StandaloneDataStorage::GetRelations(
   const mitk::DataNode *node,
   const AdjacencyList &relation,
@@ -0,0 +1,340 @@
+/*============================================================================
+
+The Medical Imaging Interaction Toolkit (MITK)
+
+Copyright (c) German Cancer Research Center (DKFZ)
+All rights reserved.
+
+Use of this source code is governed by a 3-clause BSD license that can be
+found in the LICENSE file.
+
+============================================================================*/
+
+#include <mitkChunkedGzipCodec.h>
+
+#include <mitkExceptionMacro.h>
+
+#include <itkMultiThreaderBase.h>
+#include <itk_zlib.h>
+
+#include <algorithm>
+#include <cstdint>
+#include <functional>
+#include <istream>
+#include <ostream>
+#include <vector>
+
+namespace
+{
+  // Member header: ID1 ID2 CM FLG MTIME(4) XFL OS, XLEN(2), and one extra subfield
+  // SI1 SI2 LEN(2) with the compressed and uncompressed size of the member (4 each).
+  constexpr std::size_t HEADER_SIZE = 10 + 2 + 4 + 8;
+
+  // Member trailer: CRC32(4) ISIZE(4)
+  constexpr std::size_t TRAILER_SIZE = 8;
+
+  constexpr unsigned char GZIP_ID1 = 0x1f;
+  constexpr unsigned char GZIP_ID2 = 0x8b;
+  constexpr unsigned char GZIP_CM_DEFLATE = 8;
+  constexpr unsigned char GZIP_FLG_FEXTRA = 4;
+  constexpr unsigned char GZIP_OS_UNKNOWN = 255;
+
+  constexpr unsigned char SUBFIELD_ID1 = 'M';
+  constexpr unsigned char SUBFIELD_ID2 = 'K';
+  constexpr std::uint16_t SUBFIELD_LENGTH = 8;
+
+  void WriteUInt16(unsigned char* dest, std::uint16_t value)
+  {
+    dest[0] = static_cast<unsigned char>(value & 0xff);
+    dest[1] = static_cast<unsigned char>(value >> 8);
+  }
+
+  void WriteUInt32(unsigned char* dest, std::uint32_t value)
+  {
+    for (int i = 0; i < 4; ++i)
+      dest[i] = static_cast<unsigned char>((value >> (8 * i)) & 0xff);
+  }
+
+  std::uint16_t ReadUInt16(const unsigned char* src)
+  {
+    return static_cast<std::uint16_t>(src[0] | (src[1] << 8));
+  }
+
+  std::uint32_t ReadUInt32(const unsigned char* src)
+  {
+    std::uint32_t value = 0;
+    for (int i = 3; i >= 0; --i)
+      value = (value << 8) | src[i];
+
+    return value;
+  }
+
+  /** Parses a member header written by CompressChunk(). Returns false if it has a different layout.*/
+  bool ParseHeader(const unsigned char* header, std::uint32_t& compressedSize, std::uint32_t& size)
+  {
+    if (GZIP_ID1 != header[0] || GZIP_ID2 != header[1] || GZIP_CM_DEFLATE != header[2] || GZIP_FLG_FEXTRA != header[3])
+      return false;
+
+    if (4 + SUBFIELD_LENGTH != ReadUInt16(header + 10) || SUBFIELD_ID1 != header[12] || SUBFIELD_ID2 != header[13] ||
+        SUBFIELD_LENGTH != ReadUInt16(header + 14))
+      return false;
+
+    compressedSize = ReadUInt32(header + 16);
+    size = ReadUInt32(header + 20);
+
+    return true;
+  }
+
+  /** Compresses one chunk into a complete gzip member. Returns false if zlib fails.*/
+  bool CompressChunk(const unsigned char* src, std::size_t size, int level, std::vector<unsigned char>& member)
+  {
+    z_stream stream = {};
+
+    // Negative window bits produce raw deflate data, header and trailer are written manually
+    if (Z_OK != deflateInit2(&stream, level, Z_DEFLATED, -MAX_WBITS, 8, Z_DEFAULT_STRATEGY))
+      return false;
+
+    const auto bound = deflateBound(&stream, static_cast<uLong>(size));
+    member.resize(HEADER_SIZE + bound + TRAILER_SIZE);
+
+    stream.next_in = const_cast<Bytef*>(src);
+    stream.avail_in = static_cast<uInt>(size);
+    stream.next_out = member.data() + HEADER_SIZE;
+    stream.avail_out = static_cast<uInt>(bound);
+
+    const auto result = deflate(&stream, Z_FINISH);
+    const auto compressedSize = static_cast<std::uint32_t>(stream.total_out);
+    deflateEnd(&stream);
+
+    if (Z_STREAM_END != result)
+      return false;
+
+    auto header = member.data();
+    header[0] = GZIP_ID1;
+    header[1] = GZIP_ID2;
+    header[2] = GZIP_CM_DEFLATE;
+    header[3] = GZIP_FLG_FEXTRA;
+    WriteUInt32(header + 4, 0); // MTIME
+    header[8] = 0; // XFL
+    header[9] = GZIP_OS_UNKNOWN;
+    WriteUInt16(header + 10, 4 + SUBFIELD_LENGTH);
+    header[12] = SUBFIELD_ID1;
+    header[13] = SUBFIELD_ID2;
+    WriteUInt16(header + 14, SUBFIELD_LENGTH);
+    WriteUInt32(header + 16, compressedSize);
+    WriteUInt32(header + 20, static_cast<std::uint32_t>(size));
+
+    auto trailer = header + HEADER_SIZE + compressedSize;
+    WriteUInt32(trailer, static_cast<std::uint32_t>(crc32(crc32(0L, Z_NULL, 0), src, static_cast<uInt>(size))));
+    WriteUInt32(trailer + 4, static_cast<std::uint32_t>(size));
+
+    member.resize(HEADER_SIZE + compressedSize + TRAILER_SIZE);
+    return true;
+  }
+
+  /** Inflates the raw deflate data of one member and verifies its checksum. Returns false on any mismatch.*/
+  bool DecompressChunk(const unsigned char* src, std::size_t compressedSize, unsigned char* dest, std::size_t size, std::uint32_t crc)
+  {
+    z_stream stream = {};
+
+    if (Z_OK != inflateInit2(&stream, -MAX_WBITS))
+      return false;
+
+    // zlib rejects a null output buffer even if nothing is written to it
+    unsigned char emptyDest = 0;
+
+    stream.next_in = const_cast<Bytef*>(src);
+    stream.avail_in = static_cast<uInt>(compressedSize);
+    stream.next_out = 0 != size ? dest : &emptyDest;
+    stream.avail_out = static_cast<uInt>(size);
+
+    const auto result = inflate(&stream, Z_FINISH);
+    const auto decompressedSize = stream.total_out;
+    inflateEnd(&stream);
+
+    return Z_STREAM_END == result && size == decompressedSize &&
+           crc == static_cast<std::uint32_t>(crc32(crc32(0L, Z_NULL, 0), dest, static_cast<uInt>(size)));
+  }
+
+  /** Returns the uncompressed bytes of a chunk, either from the data or filled into the buffer of the chunk.*/
+  using GetChunkFunction = std::function<const unsigned char*(std::size_t offset, std::size_t size, std::vector<unsigned char>& buffer)>;
+
+  void CompressChunks(std::size_t size, std::ostream& stream, int level, std::size_t chunkSize, const GetChunkFunction& getChunk)
+  {
+    if (0 == chunkSize || mitk::ChunkedGzipCodec::MAXIMUM_CHUNK_SIZE < chunkSize)
+      mitkThrow() << "Cannot compress data: invalid chunk size " << chunkSize << '.';
+
+    if (level < Z_DEFAULT_COMPRESSION || level > Z_BEST_COMPRESSION)
+      mitkThrow() << "Cannot compress data: invalid compression level " << level << '.';
+
+    // Empty data is still written as a single empty member to produce a valid gzip stream.
+    const auto numberOfChunks = std::max<std::size_t>(1, (size + chunkSize - 1) / chunkSize);
+
+    // Chunks are compressed in batches to bound the memory of the compressed members that
+    // wait to be written.
+    const std::size_t batchSize = 2 * std::max(1u, itk::MultiThreaderBase::GetGlobalDefaultNumberOfThreads());
+    std::vector<std::vector<unsigned char>> members(std::min(batchSize, numberOfChunks));
+    std::vector<std::vector<unsigned char>> buffers(members.size());
+    std::vector<char> succeeded(members.size());
+
+    for (std::size_t first = 0; first < numberOfChunks; first += members.size())
+    {
+      const auto count = std::min(members.size(), numberOfChunks - first);
+
+      auto compressChunk = [&](itk::SizeValueType i)
+      {
+        const auto offset = (first + i) * chunkSize;
+        const auto chunkBytes = std::min(chunkSize, size - std::min(size, offset));
+        succeeded[i] = CompressChunk(getChunk(offset, chunkBytes, buffers[i]), chunkBytes, level, members[i]);
+      };
+
+      if (1 == count)
+      {
+        compressChunk(0);
+      }
+      else
+      {
+        auto threader = itk::MultiThreaderBase::New();
+        threader->ParallelizeArray(0, count, compressChunk, nullptr);
+      }
+
+      for (std::size_t i = 0; i < count; ++i)
+      {
+        if (!succeeded[i])
+          mitkThrow() << "Cannot compress data: zlib failed to compress chunk " << first + i << '.';
+
+        stream.write(reinterpret_cast<const char*>(members[i].data()), static_cast<std::streamsize>(members[i].size()));
+      }
+
+      if (!stream)
+        mitkThrow() << "Cannot compress data: writing to the stream failed.";
+    }
+  }
+}
+
+const std::size_t mitk::ChunkedGzipCodec::DEFAULT_CHUNK_SIZE = 4 * 1024 * 1024;
+const std::size_t mitk::ChunkedGzipCodec::MAXIMUM_CHUNK_SIZE = 1024 * 1024 * 1024;
+
+void mitk::ChunkedGzipCodec::Compress(const void* data, std::size_t size, std::ostream& stream, int level, std::size_t chunkSize)
+{
+  if (nullptr == data && 0 != size)
+    mitkThrow() << "Cannot compress data: data is nullptr.";
+
+  const auto src = static_cast<const unsigned char*>(data);
+
+  CompressChunks(size, stream, level, chunkSize, [src](std::size_t offset, std::size_t, std::vector<unsigned char>&) {
+    return src + offset;
+  });
+}
+
+void mitk::ChunkedGzipCodec::Compress(std::size_t size, const FillFunction& fill, std::ostream& stream, int level, std::size_t chunkSize)
+{
+  if (!fill)
+    mitkThrow() << "Cannot compress data: fill function is empty.";
+
+  CompressChunks(size, stream, level, chunkSize, [&fill](std::size_t offset, std::size_t chunkBytes, std::vector<unsigned char>& buffer) {
+    buffer.resize(chunkBytes);
+
+    if (0 != chunkBytes)
+      fill(offset, chunkBytes, buffer.data());
+
+    return buffer.data();
+  });
+}
+
+bool mitk::ChunkedGzipCodec::IsChunked(std::istream& stream)
+{
+  const auto position = stream.tellg();
+
+  unsigned char header[HEADER_SIZE];
+  stream.read(reinterpret_cast<char*>(header), HEADER_SIZE);
+  const bool isComplete = stream.gcount() == static_cast<std::streamsize>(HEADER_SIZE);
+
+  stream.clear();
+  stream.seekg(position);
+
+  std::uint32_t compressedSize = 0;
+  std::uint32_t size = 0;
+
+  return isComplete && ParseHeader(header, compressedSize, size);
+}
+
+void mitk::ChunkedGzipCodec::Decompress(std::istream& stream, void* data, std::size_t size)
+{
+  if (nullptr == data && 0 != size)
+    mitkThrow() << "Cannot decompress data: data is nullptr.";
+
+  struct Member
+  {
+    std::size_t Offset;
+    std::size_t CompressedSize;
+    std::size_t Destination;
+    std::size_t Size;
+    std::uint32_t Crc;
+  };
+
+  // Members are located sequentially by their headers and read as a whole. Only the
+  // inflation, which is the expensive part, runs concurrently.
+  std::vector<Member> members;
+  std::vector<unsigned char> compressedData;
+  std::size_t destination = 0;
+
+  do
+  {
+    unsigned char header[HEADER_SIZE];
+    std::uint32_t compressedSize = 0;
+    std::uint32_t memberSize = 0;
+
+    if (!stream.read(reinterpret_cast<char*>(header), HEADER_SIZE))
+      mitkThrow() << "Cannot decompress data: unexpected end of stream.";
+
+    if (!ParseHeader(header, compressedSize, memberSize))
+      mitkThrow() << "Cannot decompress data: stream was not written by ChunkedGzipCodec.";
+
+    if (memberSize > size - destination)
+      mitkThrow() << "Cannot decompress data: stream contains more data than expected.";
+
+    const auto offset = compressedData.size();
+    compressedData.resize(offset + compressedSize + TRAILER_SIZE);
+
+    if (!stream.read(reinterpret_cast<char*>(compressedData.data() + offset), static_cast<std::streamsize>(compressedSize + TRAILER_SIZE)))
+      mitkThrow() << "Cannot decompress data: unexpected end of stream.";
+
+    const auto trailer = compressedData.data() + offset + compressedSize;
+
+    if (ReadUInt32(trailer + 4) != memberSize)
+      mitkThrow() << "Cannot decompress data: corrupt gzip member.";
+
+    members.push_back({ offset, compressedSize, destination, memberSize, ReadUInt32(trailer) });
+    destination += memberSize;
+
+    if (0 == memberSize)
+      break;
+  } while (destination < size);
+
+  if (destination != size)
+    mitkThrow() << "Cannot decompress data: stream contains less data than expected.";
+
+  auto dest = static_cast<unsigned char*>(data);
+  std::vector<char> succeeded(members.size());
+
+  auto decompressChunk = [&](itk::SizeValueType i)
+  {
+    const auto& member = members[i];
+    succeeded[i] = DecompressChunk(compressedData.data() + member.Offset, member.CompressedSize,
+                                   dest + member.Destination, member.Size, member.Crc);
+  };
+
+  if (1 == members.size())
+  {
+    decompressChunk(0);
+  }
+  else
+  {
+    auto threader = itk::MultiThreaderBase::New();
+    threader->ParallelizeArray(0, members.size(), decompressChunk, nullptr);
+  }
+
+  if (std::find(succeeded.begin(), succeeded.end(), 0) != succeeded.end())
+    mitkThrow() << "Cannot decompress data: corrupt gzip member.";
+}
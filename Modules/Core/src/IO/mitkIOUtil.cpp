@@ -14,6 +14,7 @@ found in the LICENSE file.
 
 #include <mitkCoreObjectFactory.h>
 #include <mitkCoreServices.h>
+#include <mitkDedicatedThreads.h>
 #include <mitkExceptionMacro.h>
 #include <mitkFileReaderRegistry.h>
 #include <mitkFileWriterRegistry.h>
@@ -26,6 +27,7 @@ found in the LICENSE file.
 #include <usModuleResource.h>
 #include <usModuleResourceStream.h>
 #include <mitkAbstractFileReader.h>
+#include <mitkLocaleSwitch.h>
 #include <mitkUtf8Util.h>
 
 // ITK
@@ -36,8 +38,16 @@ found in the LICENSE file.
 #include <vtkSmartPointer.h>
 #include <vtkTriangleFilter.h>
 
+#include <algorithm>
 #include <cerrno>
+#include <condition_variable>
 #include <cstdlib>
+#include <deque>
+#include <functional>
+#include <mutex>
+#include <set>
+#include <thread>
+#include <typeinfo>
 
 static std::string GetLastErrorStr()
 {
@@ -291,6 +301,8 @@ namespace mitk
         return false;
       }
 
+      bool CallForAdvancedOptions() const override { return true; }
+
     private:
       const IFileReader::Options &m_Options;
     };
@@ -308,11 +320,43 @@ namespace mitk
         return false;
       }
 
+      bool CallForAdvancedOptions() const override { return true; }
+
     private:
       const IFileWriter::Options &m_Options;
     };
 
+    //! Return 'true' if the options of a single reader or writer are a reason to call the options callback,
+    //! i.e. if it has options that are not advanced options (see mitk::IFileIO::Options).
+    static bool HasOptionsForCallback(const IFileIO::Options &options, bool callForAdvancedOptions)
+    {
+      return std::any_of(options.begin(), options.end(), [callForAdvancedOptions](const IFileIO::Options::value_type &option) {
+        return callForAdvancedOptions || 0 != option.first.compare(0, 9, "advanced.");
+      });
+    }
+
     static BaseData::Pointer LoadBaseDataFromFile(const std::string &path, const ReaderOptionsFunctorBase* optionsCallback = nullptr);
+
+    /** Selects the reader for loadInfo. The options of a reader used before for the same mime type
+     * are re-used, otherwise the options callback is called if necessary. Returns nullptr and extends
+     * errMsg if the file cannot be read. cancel is set if no further files must be read.*/
+    static IFileReader *SelectReader(LoadInfo &loadInfo,
+                                     std::map<std::string, FileReaderSelector::Item> &usedReaderItems,
+                                     const ReaderOptionsFunctorBase *optionsCallback,
+                                     std::string &errMsg,
+                                     bool &cancel);
+
+    /** Reads the nodes with reader. If ds is not nullptr, the reader adds them to ds.*/
+    static DataStorage::SetOfObjects::Pointer ReadNodes(IFileReader *reader, DataStorage *ds);
+
+    /** Adds the data of the read nodes to the output of loadInfo and the nodes to nodeResult.*/
+    static void AddOutput(LoadInfo &loadInfo,
+                          const DataStorage::SetOfObjects *nodes,
+                          DataStorage::SetOfObjects *nodeResult,
+                          std::string &errMsg);
+
+    /** Adds the nodes of source to target. Sources of nodes are added first to keep the node relations.*/
+    static void TransferNodes(const DataStorage::SetOfObjects *nodes, const DataStorage &source, DataStorage &target);
   };
 
   BaseData::Pointer IOUtil::Impl::LoadBaseDataFromFile(const std::string &path,
@@ -325,6 +369,175 @@ namespace mitk
     return baseDataList.front();
   }
 
+  IFileReader *IOUtil::Impl::SelectReader(LoadInfo &loadInfo,
+                                          std::map<std::string, FileReaderSelector::Item> &usedReaderItems,
+                                          const ReaderOptionsFunctorBase *optionsCallback,
+                                          std::string &errMsg,
+                                          bool &cancel)
+  {
+    cancel = false;
+
+    std::vector<FileReaderSelector::Item> readers = loadInfo.m_ReaderSelector.Get();
+
+    if (readers.empty())
+    {
+      if (!itksys::SystemTools::FileExists(Utf8Util::Local8BitToUtf8(loadInfo.m_Path).c_str()))
+      {
+        errMsg += "File '" + loadInfo.m_Path + "' does not exist\n";
+      }
+      else
+      {
+        errMsg += "No reader available for '" + loadInfo.m_Path + "'\n";
+      }
+      return nullptr;
+    }
+
+    bool callOptionsCallback = nullptr != optionsCallback && (readers.size() > 1 ||
+      HasOptionsForCallback(readers.front().GetReader()->GetOptions(), optionsCallback->CallForAdvancedOptions()));
+
+    // check if we already used a reader which should be re-used
+    std::vector<MimeType> currMimeTypes = loadInfo.m_ReaderSelector.GetMimeTypes();
+    std::string selectedMimeType;
+    for (std::vector<MimeType>::const_iterator mimeTypeIter = currMimeTypes.begin(),
+                                               mimeTypeIterEnd = currMimeTypes.end();
+         mimeTypeIter != mimeTypeIterEnd;
+         ++mimeTypeIter)
+    {
+      std::map<std::string, FileReaderSelector::Item>::const_iterator oldSelectedItemIter =
+        usedReaderItems.find(mimeTypeIter->GetName());
+      if (oldSelectedItemIter != usedReaderItems.end())
+      {
+        // we found an already used item for a mime-type which is contained
+        // in the current reader set, check all current readers if there service
+        // id equals the old reader
+        for (std::vector<FileReaderSelector::Item>::const_iterator currReaderItem = readers.begin(),
+                                                                   currReaderItemEnd = readers.end();
+             currReaderItem != currReaderItemEnd;
+             ++currReaderItem)
+        {
+          if (currReaderItem->GetMimeType().GetName() == mimeTypeIter->GetName() &&
+              currReaderItem->GetServiceId() == oldSelectedItemIter->second.GetServiceId() &&
+              currReaderItem->GetConfidenceLevel() >= oldSelectedItemIter->second.GetConfidenceLevel())
+          {
+            // okay, we used the same reader already, re-use its options
+            selectedMimeType = mimeTypeIter->GetName();
+            callOptionsCallback = false;
+            loadInfo.m_ReaderSelector.Select(oldSelectedItemIter->second.GetServiceId());
+            loadInfo.m_ReaderSelector.GetSelected().GetReader()->SetOptions(
+              oldSelectedItemIter->second.GetReader()->GetOptions());
+            break;
+          }
+        }
+        if (!selectedMimeType.empty())
+          break;
+      }
+    }
+
+    if (callOptionsCallback && optionsCallback)
+    {
+      callOptionsCallback = (*optionsCallback)(loadInfo);
+      if (!callOptionsCallback && !loadInfo.m_Cancel)
+      {
+        usedReaderItems.erase(selectedMimeType);
+        FileReaderSelector::Item selectedItem = loadInfo.m_ReaderSelector.GetSelected();
+        usedReaderItems.insert(std::make_pair(selectedItem.GetMimeType().GetName(), selectedItem));
+      }
+    }
+
+    if (loadInfo.m_Cancel)
+    {
+      errMsg += "Reading operation(s) cancelled.";
+      cancel = true;
+      return nullptr;
+    }
+
+    IFileReader *reader = loadInfo.m_ReaderSelector.GetSelected().GetReader();
+    if (reader == nullptr)
+    {
+      errMsg += "Unexpected nullptr reader.";
+      cancel = true;
+      return nullptr;
+    }
+
+    reader->SetProperties(loadInfo.m_Properties);
+
+    return reader;
+  }
+
+  DataStorage::SetOfObjects::Pointer IOUtil::Impl::ReadNodes(IFileReader *reader, DataStorage *ds)
+  {
+    if (ds != nullptr)
+      return reader->Read(*ds);
+
+    DataStorage::SetOfObjects::Pointer nodes = DataStorage::SetOfObjects::New();
+    std::vector<mitk::BaseData::Pointer> baseData = reader->Read();
+    for (auto iter = baseData.begin(); iter != baseData.end(); ++iter)
+    {
+      if (iter->IsNotNull())
+      {
+        mitk::DataNode::Pointer node = mitk::DataNode::New();
+        node->SetData(*iter);
+        nodes->InsertElement(nodes->Size(), node);
+      }
+    }
+
+    return nodes;
+  }
+
+  void IOUtil::Impl::AddOutput(LoadInfo &loadInfo,
+                               const DataStorage::SetOfObjects *nodes,
+                               DataStorage::SetOfObjects *nodeResult,
+                               std::string &errMsg)
+  {
+    for (DataStorage::SetOfObjects::ConstIterator nodeIter = nodes->Begin(), nodeIterEnd = nodes->End();
+         nodeIter != nodeIterEnd;
+         ++nodeIter)
+    {
+      const mitk::DataNode::Pointer &node = nodeIter->Value();
+      mitk::BaseData::Pointer data = node->GetData();
+      if (data.IsNull())
+      {
+        continue;
+      }
+
+      data->SetProperty("path", mitk::StringProperty::New(Utf8Util::Local8BitToUtf8(loadInfo.m_Path)));
+
+      loadInfo.m_Output.push_back(data);
+      if (nodeResult)
+      {
+        nodeResult->push_back(nodeIter->Value());
+      }
+    }
+
+    if (loadInfo.m_Output.empty() || (nodeResult && nodeResult->Size() == 0))
+    {
+      errMsg += "Unknown read error occurred reading " + loadInfo.m_Path;
+    }
+  }
+
+  void IOUtil::Impl::TransferNodes(const DataStorage::SetOfObjects *nodes, const DataStorage &source, DataStorage &target)
+  {
+    std::function<void(DataNode *)> transferNode = [&](DataNode *node)
+    {
+      if (target.Exists(node))
+        return;
+
+      auto sources = source.GetSources(node, nullptr, true);
+      for (auto iter = sources->Begin(); iter != sources->End(); ++iter)
+        transferNode(iter->Value());
+
+      target.Add(node, sources);
+    };
+
+    // The nodes returned by the reader keep their order, further nodes follow
+    for (auto iter = nodes->Begin(); iter != nodes->End(); ++iter)
+      transferNode(iter->Value());
+
+    auto allNodes = source.GetAll();
+    for (auto iter = allNodes->Begin(); iter != allNodes->End(); ++iter)
+      transferNode(iter->Value());
+  }
+
 #ifdef US_PLATFORM_WINDOWS
   std::string IOUtil::GetProgramPath()
   {
@@ -566,6 +779,48 @@ namespace mitk
     return result;
   }
 
+  DataStorage::SetOfObjects::Pointer IOUtil::LoadConcurrently(const std::vector<std::string> &paths,
+                                                              DataStorage &storage,
+                                                              const ReaderOptionsFunctorBase *optionsCallback,
+                                                              unsigned int numberOfThreads)
+  {
+    DataStorage::SetOfObjects::Pointer nodeResult = DataStorage::SetOfObjects::New();
+    std::vector<LoadInfo> loadInfos;
+    for (const auto &loadInfo : paths)
+    {
+      loadInfos.emplace_back(loadInfo);
+    }
+    std::string errMsg = LoadConcurrently(loadInfos, nodeResult, &storage, optionsCallback, numberOfThreads);
+    if (!errMsg.empty())
+    {
+      mitkThrow() << errMsg;
+    }
+    return nodeResult;
+  }
+
+  std::vector<BaseData::Pointer> IOUtil::LoadConcurrently(const std::vector<std::string> &paths,
+                                                          const ReaderOptionsFunctorBase *optionsCallback,
+                                                          unsigned int numberOfThreads)
+  {
+    std::vector<BaseData::Pointer> result;
+    std::vector<LoadInfo> loadInfos;
+    for (const auto &loadInfo : paths)
+    {
+      loadInfos.emplace_back(loadInfo);
+    }
+    std::string errMsg = LoadConcurrently(loadInfos, nullptr, nullptr, optionsCallback, numberOfThreads);
+    if (!errMsg.empty())
+    {
+      mitkThrow() << errMsg;
+    }
+
+    for (const auto &loadInfo : loadInfos)
+    {
+      result.insert(result.end(), loadInfo.m_Output.begin(), loadInfo.m_Output.end());
+    }
+    return result;
+  }
+
   std::string IOUtil::Load(std::vector<LoadInfo> &loadInfos,
                            DataStorage::SetOfObjects *nodeResult,
                            DataStorage *ds,
@@ -589,147 +844,279 @@ namespace mitk
       if(std::find(read_files.begin(), read_files.end(), loadInfo.m_Path) != read_files.end())
         continue;
 
-      std::vector<FileReaderSelector::Item> readers = loadInfo.m_ReaderSelector.Get();
+      bool cancel = false;
+      IFileReader *reader = Impl::SelectReader(loadInfo, usedReaderItems, optionsCallback, errMsg, cancel);
 
-      if (readers.empty())
-      {
-        if (!itksys::SystemTools::FileExists(Utf8Util::Local8BitToUtf8(loadInfo.m_Path).c_str()))
-        {
-          errMsg += "File '" + loadInfo.m_Path + "' does not exist\n";
-        }
-        else
-        {
-          errMsg += "No reader available for '" + loadInfo.m_Path + "'\n";
-        }
-        continue;
-      }
+      if (cancel)
+        break;
 
-      bool callOptionsCallback = readers.size() > 1 || !readers.front().GetReader()->GetOptions().empty();
+      if (reader == nullptr)
+        continue;
 
-      // check if we already used a reader which should be re-used
-      std::vector<MimeType> currMimeTypes = loadInfo.m_ReaderSelector.GetMimeTypes();
-      std::string selectedMimeType;
-      for (std::vector<MimeType>::const_iterator mimeTypeIter = currMimeTypes.begin(),
-                                                 mimeTypeIterEnd = currMimeTypes.end();
-           mimeTypeIter != mimeTypeIterEnd;
-           ++mimeTypeIter)
+      // Do the actual reading
+      try
       {
-        std::map<std::string, FileReaderSelector::Item>::const_iterator oldSelectedItemIter =
-          usedReaderItems.find(mimeTypeIter->GetName());
-        if (oldSelectedItemIter != usedReaderItems.end())
-        {
-          // we found an already used item for a mime-type which is contained
-          // in the current reader set, check all current readers if there service
-          // id equals the old reader
-          for (std::vector<FileReaderSelector::Item>::const_iterator currReaderItem = readers.begin(),
-                                                                     currReaderItemEnd = readers.end();
-               currReaderItem != currReaderItemEnd;
-               ++currReaderItem)
-          {
-            if (currReaderItem->GetMimeType().GetName() == mimeTypeIter->GetName() &&
-                currReaderItem->GetServiceId() == oldSelectedItemIter->second.GetServiceId() &&
-                currReaderItem->GetConfidenceLevel() >= oldSelectedItemIter->second.GetConfidenceLevel())
-            {
-              // okay, we used the same reader already, re-use its options
-              selectedMimeType = mimeTypeIter->GetName();
-              callOptionsCallback = false;
-              loadInfo.m_ReaderSelector.Select(oldSelectedItemIter->second.GetServiceId());
-              loadInfo.m_ReaderSelector.GetSelected().GetReader()->SetOptions(
-                oldSelectedItemIter->second.GetReader()->GetOptions());
-              break;
-            }
-          }
-          if (!selectedMimeType.empty())
-            break;
-        }
-      }
+        DataStorage::SetOfObjects::Pointer nodes = Impl::ReadNodes(reader, ds);
 
-      if (callOptionsCallback && optionsCallback)
-      {
-        callOptionsCallback = (*optionsCallback)(loadInfo);
-        if (!callOptionsCallback && !loadInfo.m_Cancel)
-        {
-          usedReaderItems.erase(selectedMimeType);
-          FileReaderSelector::Item selectedItem = loadInfo.m_ReaderSelector.GetSelected();
-          usedReaderItems.insert(std::make_pair(selectedItem.GetMimeType().GetName(), selectedItem));
-        }
-      }
+        std::vector< std::string > new_files =  reader->GetReadFiles();
+        read_files.insert( read_files.end(), new_files.begin(), new_files.end() );
 
-      if (loadInfo.m_Cancel)
+        Impl::AddOutput(loadInfo, nodes, nodeResult, errMsg);
+      }
+      catch (const std::exception &e)
       {
-        errMsg += "Reading operation(s) cancelled.";
-        break;
+        errMsg += "Exception occurred when reading file " + loadInfo.m_Path + ":\n" + e.what() + "\n\n";
       }
+      mitk::ProgressBar::GetInstance()->Progress(2);
+      --filesToRead;
+    }
 
-      IFileReader *reader = loadInfo.m_ReaderSelector.GetSelected().GetReader();
-      if (reader == nullptr)
-      {
-        errMsg += "Unexpected nullptr reader.";
+    if (!errMsg.empty())
+    {
+      MITK_ERROR << errMsg;
+    }
+
+    mitk::ProgressBar::GetInstance()->Progress(2 * filesToRead);
+
+    return errMsg;
+  }
+
+  std::string IOUtil::LoadConcurrently(std::vector<LoadInfo> &loadInfos,
+                                       DataStorage::SetOfObjects *nodeResult,
+                                       DataStorage *ds,
+                                       const ReaderOptionsFunctorBase *optionsCallback,
+                                       unsigned int numberOfThreads)
+  {
+    if (loadInfos.empty())
+    {
+      return "No input files given";
+    }
+
+    const auto numberOfFiles = loadInfos.size();
+    mitk::ProgressBar::GetInstance()->AddStepsToDo(2 * numberOfFiles);
+
+    std::string errMsg;
+
+    // Readers are selected up front in the calling thread, as the options callback may
+    // interact with the user and selected options are re-used for the following files.
+    std::map<std::string, FileReaderSelector::Item> usedReaderItems;
+    std::vector<IFileReader *> readers;
+    std::vector<std::size_t> filesToRead;
+
+    for (auto &loadInfo : loadInfos)
+    {
+      bool cancel = false;
+      IFileReader *reader = Impl::SelectReader(loadInfo, usedReaderItems, optionsCallback, errMsg, cancel);
+
+      if (cancel)
         break;
-      }
 
-      reader->SetProperties(loadInfo.m_Properties);
+      if (reader != nullptr)
+        filesToRead.push_back(readers.size());
 
-      // Do the actual reading
-      try
+      readers.push_back(reader);
+    }
+
+    struct ReadResult
+    {
+      DataStorage::SetOfObjects::Pointer Nodes;
+      StandaloneDataStorage::Pointer Storage;
+      std::vector<std::string> ReadFiles;
+      std::string Error;
+      bool Succeeded = false;
+      bool Skipped = false;
+    };
+
+    std::vector<ReadResult> results(readers.size());
+
+    // Some readers (e.g. for DICOM series) read several files for one path and report them by
+    // GetReadFiles(). Like Load(), such files must not be read again. As this is only known after
+    // reading, files of the same reader type in the same directory form a group. Only one file
+    // of a group is read at a time while its reads cover further files. After a read that only
+    // covered its own file, the remaining files of the group are read concurrently.
+    struct ReadGroup
+    {
+      std::deque<std::size_t> PendingFiles;
+      bool Serial = true;
+    };
+
+    std::map<std::string, ReadGroup> groups;
+    std::vector<ReadGroup *> groupOfFile(readers.size(), nullptr);
+
+    for (auto i : filesToRead)
+    {
+      const auto groupKey = std::string(typeid(*readers[i]).name()) + '\n' +
+                            itksys::SystemTools::GetFilenamePath(loadInfos[i].m_Path);
+      auto &group = groups[groupKey];
+      group.PendingFiles.push_back(i);
+      groupOfFile[i] = &group;
+    }
+
+    // Many readers switch to the "C" locale themselves. Since setlocale() is not thread-safe,
+    // it is installed once here so that their switches become no-ops.
+    LocaleSwitch localeSwitch("C");
+
+    // Each file has its own reader instance (see GetNumberOfDedicatedThreads()). Readers that add their nodes
+    // to a DataStorage get a private one. Its nodes are moved to ds in the calling thread,
+    // so that observers of ds are not notified from other threads. The calling thread also
+    // schedules the files, so the following members are only accessed with mutex locked.
+    std::mutex mutex;
+    std::condition_variable fileScheduled;
+    std::condition_variable fileRead;
+    std::deque<std::size_t> scheduledFiles;
+    std::vector<std::size_t> finishedFiles;
+    bool allFilesScheduled = false;
+
+    auto readScheduledFiles = [&]()
+    {
+      while (true)
       {
-        DataStorage::SetOfObjects::Pointer nodes;
-        if (ds != nullptr)
+        std::size_t i = 0;
+
         {
-          nodes = reader->Read(*ds);
+          std::unique_lock<std::mutex> lock(mutex);
+          fileScheduled.wait(lock, [&]() { return !scheduledFiles.empty() || allFilesScheduled; });
+
+          if (scheduledFiles.empty())
+            return;
 
-          std::vector< std::string > new_files =  reader->GetReadFiles();
-          read_files.insert( read_files.end(), new_files.begin(), new_files.end() );
+          i = scheduledFiles.front();
+          scheduledFiles.pop_front();
         }
-        else
+
+        auto &result = results[i];
+
+        try
         {
-          nodes = DataStorage::SetOfObjects::New();
-          std::vector<mitk::BaseData::Pointer> baseData = reader->Read();
-          for (auto iter = baseData.begin(); iter != baseData.end(); ++iter)
-          {
-            if (iter->IsNotNull())
-            {
-              mitk::DataNode::Pointer node = mitk::DataNode::New();
-              node->SetData(*iter);
-              nodes->InsertElement(nodes->Size(), node);
-            }
-          }
+          if (ds != nullptr)
+            result.Storage = StandaloneDataStorage::New();
 
-          std::vector< std::string > new_files =  reader->GetReadFiles();
-          read_files.insert( read_files.end(), new_files.begin(), new_files.end() );
+          result.Nodes = Impl::ReadNodes(readers[i], result.Storage);
+          result.ReadFiles = readers[i]->GetReadFiles();
+          result.Succeeded = true;
+        }
+        catch (const std::exception &e)
+        {
+          result.Error = e.what();
+        }
+        catch (...)
+        {
+          result.Error = "Unknown exception";
         }
 
-        for (DataStorage::SetOfObjects::ConstIterator nodeIter = nodes->Begin(), nodeIterEnd = nodes->End();
-             nodeIter != nodeIterEnd;
-             ++nodeIter)
         {
-          const mitk::DataNode::Pointer &node = nodeIter->Value();
-          mitk::BaseData::Pointer data = node->GetData();
-          if (data.IsNull())
-          {
-            continue;
-          }
+          std::lock_guard<std::mutex> lock(mutex);
+          finishedFiles.push_back(i);
+        }
+
+        fileRead.notify_one();
+      }
+    };
 
-          data->SetProperty("path", mitk::StringProperty::New(Utf8Util::Local8BitToUtf8(loadInfo.m_Path)));
+    // Files covered by finished reads of any group
+    std::set<std::string> coveredFiles;
 
-          loadInfo.m_Output.push_back(data);
-          if (nodeResult)
-          {
-            nodeResult->push_back(nodeIter->Value());
-          }
-        }
+    // Schedules the next file of a serial group or all files of a concurrent group. Returns
+    // the number of files skipped because they are covered by finished reads.
+    auto scheduleGroup = [&](ReadGroup &group)
+    {
+      std::size_t numberOfSkippedFiles = 0;
+
+      while (!group.PendingFiles.empty())
+      {
+        const auto i = group.PendingFiles.front();
+        group.PendingFiles.pop_front();
 
-        if (loadInfo.m_Output.empty() || (nodeResult && nodeResult->Size() == 0))
+        if (0 != coveredFiles.count(loadInfos[i].m_Path))
         {
-          errMsg += "Unknown read error occurred reading " + loadInfo.m_Path;
+          results[i].Skipped = true;
+          ++numberOfSkippedFiles;
+          continue;
         }
+
+        scheduledFiles.push_back(i);
+
+        if (group.Serial)
+          break;
       }
-      catch (const std::exception &e)
+
+      return numberOfSkippedFiles;
+    };
+
+    for (auto &group : groups)
+      scheduleGroup(group.second);
+
+    if (0 == numberOfThreads)
+      numberOfThreads = GetNumberOfDedicatedThreads(filesToRead.size());
+
+    std::vector<std::thread> threads;
+    for (std::size_t i = 0; i < std::min<std::size_t>(numberOfThreads, filesToRead.size()); ++i)
+      threads.emplace_back(readScheduledFiles);
+
+    for (std::size_t handledFiles = 0; handledFiles < filesToRead.size();)
+    {
+      std::unique_lock<std::mutex> lock(mutex);
+      fileRead.wait(lock, [&]() { return !finishedFiles.empty(); });
+
+      std::size_t newlyHandledFiles = 0;
+
+      for (auto i : finishedFiles)
       {
-        errMsg += "Exception occurred when reading file " + loadInfo.m_Path + ":\n" + e.what() + "\n\n";
+        const auto &result = results[i];
+        auto &group = *groupOfFile[i];
+
+        const bool coveredFurtherFiles = std::any_of(result.ReadFiles.begin(), result.ReadFiles.end(),
+          [&](const std::string &file) { return file != loadInfos[i].m_Path; });
+
+        if (result.Succeeded && !coveredFurtherFiles)
+          group.Serial = false;
+
+        coveredFiles.insert(result.ReadFiles.begin(), result.ReadFiles.end());
+        newlyHandledFiles += 1 + scheduleGroup(group);
       }
-      mitk::ProgressBar::GetInstance()->Progress(2);
-      --filesToRead;
+
+      finishedFiles.clear();
+      handledFiles += newlyHandledFiles;
+      lock.unlock();
+
+      fileScheduled.notify_all();
+      mitk::ProgressBar::GetInstance()->Progress(2 * newlyHandledFiles);
+    }
+
+    {
+      std::lock_guard<std::mutex> lock(mutex);
+      allFilesScheduled = true;
+    }
+
+    fileScheduled.notify_all();
+
+    for (auto &thread : threads)
+      thread.join();
+
+    // Collect the results in the order of loadInfos. Like Load(), a file that was already
+    // read together with a previous file is skipped.
+    std::vector<std::string> read_files;
+    for (std::size_t i = 0; i < readers.size(); ++i)
+    {
+      auto &loadInfo = loadInfos[i];
+      auto &result = results[i];
+
+      if (readers[i] == nullptr || result.Skipped ||
+          std::find(read_files.begin(), read_files.end(), loadInfo.m_Path) != read_files.end())
+        continue;
+
+      if (!result.Succeeded)
+      {
+        errMsg += "Exception occurred when reading file " + loadInfo.m_Path + ":\n" + result.Error + "\n\n";
+        continue;
+      }
+
+      if (ds != nullptr)
+        Impl::TransferNodes(result.Nodes, *result.Storage, *ds);
+
+      read_files.insert(read_files.end(), result.ReadFiles.begin(), result.ReadFiles.end());
+
+      Impl::AddOutput(loadInfo, result.Nodes, nodeResult, errMsg);
     }
 
     if (!errMsg.empty())
@@ -737,7 +1124,7 @@ namespace mitk
       MITK_ERROR << errMsg;
     }
 
-    mitk::ProgressBar::GetInstance()->Progress(2 * filesToRead);
+    mitk::ProgressBar::GetInstance()->Progress(2 * (numberOfFiles - filesToRead.size()));
 
     return errMsg;
   }
@@ -900,7 +1287,8 @@ namespace mitk
         continue;
       }
 
-      bool callOptionsCallback = writers.size() > 1 || !writers[0].GetWriter()->GetOptions().empty();
+      bool callOptionsCallback = nullptr != optionsCallback && (writers.size() > 1 ||
+        Impl::HasOptionsForCallback(writers[0].GetWriter()->GetOptions(), optionsCallback->CallForAdvancedOptions()));
 
       // check if we already used a writer for this base data type
       // which should be re-used
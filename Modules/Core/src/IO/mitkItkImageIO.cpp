@@ -13,22 +13,30 @@ found in the LICENSE file.
 #include "mitkItkImageIO.h"
 
 #include <mitkArbitraryTimeGeometry.h>
+#include <mitkChunkedGzipCodec.h>
 #include <mitkCoreServices.h>
 #include <mitkCustomMimeType.h>
 #include <mitkIOMimeTypes.h>
+#include <mitkIOUtil.h>
 #include <mitkIPropertyPersistence.h>
 #include <mitkImage.h>
 #include <mitkImageReadAccessor.h>
 #include <mitkLocaleSwitch.h>
 #include <mitkUIDManipulator.h>
 
+#include <itkByteSwapper.h>
 #include <itkImage.h>
 #include <itkImageFileReader.h>
 #include <itkImageIOFactory.h>
 #include <itkImageIORegion.h>
 #include <itkMetaDataObject.h>
 
+#include <itksys/SystemTools.hxx>
+
 #include <algorithm>
+#include <fstream>
+#include <functional>
+#include <sstream>
 
 namespace mitk
 {
@@ -38,8 +46,198 @@ namespace mitk
   const char *const PROPERTY_KEY_TIMEGEOMETRY_TIMEPOINTS = "org_mitk_timegeometry_timepoints";
   const char* const PROPERTY_KEY_UID = "org_mitk_uid";
 
+  // advanced options do not make the user interface ask for options on every save (see IFileIO::Options)
+  const char* const OPTION_NAME_COMPRESSION = "advanced.Compression";
+  const char* const OPTION_NAME_PARALLEL_COMPRESSION = "advanced.Parallel compression";
+  const char* const COMPRESSION_DEFAULT = "Default";
+  const char* const COMPRESSION_FAST = "Fast";
+  const char* const COMPRESSION_BEST = "Best";
+  const char* const COMPRESSION_NONE = "None";
+
+  namespace
+  {
+    /** Reads the header lines of a NRRD file up to the empty line that separates them from the data.*/
+    bool ReadNrrdHeader(std::istream& stream, std::vector<std::string>& lines)
+    {
+      std::string line;
+
+      while (std::getline(stream, line))
+      {
+        if (line.empty())
+          return !lines.empty() && 0 == lines.front().compare(0, 4, "NRRD");
+
+        lines.push_back(line);
+      }
+
+      return false;
+    }
+
+    /** Returns true if the NRRD header line is the given field. Its value is returned without surrounding whitespace.*/
+    bool IsNrrdField(const std::string& line, const std::string& field, std::string& value)
+    {
+      if (0 != line.compare(0, field.size() + 1, field + ':'))
+        return false;
+
+      const auto begin = line.find_first_not_of(" \t", field.size() + 1);
+      const auto end = line.find_last_not_of(" \t");
+      value = std::string::npos != begin ? line.substr(begin, end - begin + 1) : std::string();
+
+      return true;
+    }
+
+    /** The data of attached NRRD files is a plain gzip stream and can be replaced by a chunked one.
+     * Detached headers (.nhdr) are written with a separate data file by ITK and are left to it.*/
+    bool SupportsChunkedGzip(const itk::ImageIOBase* imageIO, const std::string& path)
+    {
+      return std::string("NrrdImageIO") == imageIO->GetNameOfClass() &&
+             itksys::SystemTools::LowerCase(itksys::SystemTools::GetFilenameLastExtension(path)) != ".nhdr";
+    }
+
+    /** Writes an attached NRRD file whose data is compressed by ChunkedGzipCodec. The header is generated by ITK
+     * for an image of a single voxel with the same meta data (written to a temporary file, as ITK cannot write a
+     * header only), then the sizes are corrected. compressData streams the compressed chunks after the header,
+     * so the image data is written only once.*/
+    void WriteChunkedGzipNrrdFile(itk::ImageIOBase* imageIO, const std::string& path, const std::function<void(std::ostream&)>& compressData)
+    {
+      const auto dimension = imageIO->GetNumberOfDimensions();
+
+      std::vector<itk::SizeValueType> sizes(dimension);
+      for (unsigned int i = 0; i < dimension; ++i)
+      {
+        sizes[i] = imageIO->GetDimensions(i);
+        imageIO->SetDimensions(i, 1);
+      }
+
+      const auto headerPath = IOUtil::CreateTemporaryFile("XXXXXX.nrrd");
+      std::vector<std::string> header;
+      bool headerRead = false;
+
+      try
+      {
+        const std::vector<char> voxel(imageIO->GetImageSizeInBytes(), 0);
+
+        imageIO->UseCompressionOff();
+        imageIO->SetFileName(headerPath);
+        imageIO->Write(voxel.data());
+
+        std::ifstream headerFile(headerPath, std::ios::binary);
+        headerRead = ReadNrrdHeader(headerFile, header);
+      }
+      catch (...)
+      {
+        for (unsigned int i = 0; i < dimension; ++i)
+          imageIO->SetDimensions(i, sizes[i]);
+
+        itksys::SystemTools::RemoveFile(headerPath);
+        throw;
+      }
+
+      for (unsigned int i = 0; i < dimension; ++i)
+        imageIO->SetDimensions(i, sizes[i]);
+
+      imageIO->SetFileName(path);
+      itksys::SystemTools::RemoveFile(headerPath);
+
+      if (!headerRead)
+        mitkThrow() << "Cannot generate the NRRD header of " << path;
+
+      std::string value;
+      auto encoding = std::find_if(header.begin(), header.end(), [&value](const std::string& line) {
+        return IsNrrdField(line, "encoding", value);
+      });
+
+      if (header.end() == encoding || "raw" != value)
+        mitkThrow() << "Unexpected encoding in the NRRD header of " << path;
+
+      *encoding = "encoding: gzip";
+
+      // the sizes of the image axes are the last ones, a leading axis holds the pixel components
+      auto sizesLine = std::find_if(header.begin(), header.end(), [&value](const std::string& line) {
+        return IsNrrdField(line, "sizes", value);
+      });
+
+      std::vector<std::string> axisSizes;
+      if (header.end() != sizesLine)
+      {
+        std::istringstream stream(value);
+        std::string axisSize;
+
+        while (stream >> axisSize)
+          axisSizes.push_back(axisSize);
+      }
+
+      if (axisSizes.size() < dimension)
+        mitkThrow() << "Unexpected sizes in the NRRD header of " << path;
+
+      for (unsigned int i = 0; i < dimension; ++i)
+        axisSizes[axisSizes.size() - dimension + i] = std::to_string(sizes[i]);
+
+      *sizesLine = "sizes:";
+      for (const auto& axisSize : axisSizes)
+        *sizesLine += ' ' + axisSize;
+
+      std::ofstream file(path, std::ios::binary | std::ios::trunc);
+
+      for (const auto& line : header)
+        file << line << '\n';
+
+      file << '\n';
+
+      compressData(file);
+
+      if (!file)
+        mitkThrow() << "Cannot write " << path;
+    }
+
+    /** Reads the data of an attached NRRD file written by WriteChunkedGzipNrrdFile() with parallel decompression.
+     * Returns false for any other NRRD file, which is then read by ITK.*/
+    bool ReadChunkedGzipNrrdData(const itk::ImageIOBase* imageIO, const std::string& path, void* buffer)
+    {
+      if (!SupportsChunkedGzip(imageIO, path))
+        return false;
+
+      std::ifstream file(path, std::ios::binary);
+      std::vector<std::string> header;
+
+      if (!ReadNrrdHeader(file, header))
+        return false;
+
+      const std::string nativeEndian = itk::ByteSwapper<int>::SystemIsLittleEndian() ? "little" : "big";
+      bool isGzipEncoded = false;
+
+      for (const auto& line : header)
+      {
+        std::string value;
+
+        if (IsNrrdField(line, "encoding", value))
+        {
+          isGzipEncoded = "gzip" == value || "gz" == value;
+        }
+        else if (IsNrrdField(line, "endian", value))
+        {
+          if (nativeEndian != value)
+            return false; // requires byte swapping
+        }
+        else if (IsNrrdField(line, "data file", value) || IsNrrdField(line, "datafile", value) ||
+                 IsNrrdField(line, "line skip", value) || IsNrrdField(line, "lineskip", value) ||
+                 IsNrrdField(line, "byte skip", value) || IsNrrdField(line, "byteskip", value))
+        {
+          return false;
+        }
+      }
+
+      if (!isGzipEncoded || !ChunkedGzipCodec::IsChunked(file))
+        return false;
+
+      ChunkedGzipCodec::Decompress(file, buffer, imageIO->GetImageSizeInBytes());
+      return true;
+    }
+  }
+
   ItkImageIO::ItkImageIO(const ItkImageIO &other)
-    : AbstractFileIO(other), m_ImageIO(dynamic_cast<itk::ImageIOBase *>(other.m_ImageIO->Clone().GetPointer()))
+    : AbstractFileIO(other),
+      m_ImageIO(dynamic_cast<itk::ImageIOBase *>(other.m_ImageIO->Clone().GetPointer())),
+      m_DefaultCompressionLevel(other.m_DefaultCompressionLevel)
   {
     this->InitializeDefaultMetaDataKeys();
   }
@@ -193,6 +391,8 @@ namespace mitk
     this->SetReaderDescription(description);
     this->SetWriterDescription(description);
 
+    this->InitializeDefaultWriterOptions();
+
     this->RegisterService();
   }
 
@@ -214,6 +414,8 @@ namespace mitk
       this->AbstractFileWriter::SetRanking(rank);
     }
 
+    this->InitializeDefaultWriterOptions();
+
     this->RegisterService();
   }
 
@@ -310,7 +512,9 @@ namespace mitk
     MITK_INFO << "ioRegion: " << ioRegion << std::endl;
     imageIO->SetIORegion(ioRegion);
     void* buffer = new unsigned char[imageIO->GetImageSizeInBytes()];
-    imageIO->Read(buffer);
+
+    if (!ReadChunkedGzipNrrdData(imageIO, path, buffer))
+      imageIO->Read(buffer);
 
     image->Initialize(MakePixelType(imageIO), ndim, dimensions);
     image->SetImportChannel(buffer, 0, Image::ManageMemory);
@@ -706,6 +910,18 @@ namespace mitk
     }
   }
 
+  void ItkImageIO::WriteChunkedGzipNrrd(itk::ImageIOBase* imageIO, const std::string& path, const ChunkedGzipCodec::FillFunction& fill, int compressionLevel)
+  {
+    if (!SupportsChunkedGzip(imageIO, path))
+      mitkThrow() << "Cannot write " << path << " with chunked gzip compression: only attached NRRD files are supported.";
+
+    const auto sizeInBytes = imageIO->GetImageSizeInBytes();
+
+    WriteChunkedGzipNrrdFile(imageIO, path, [sizeInBytes, &fill, compressionLevel](std::ostream& file) {
+      ChunkedGzipCodec::Compress(sizeInBytes, fill, file, compressionLevel);
+    });
+  }
+
   void ItkImageIO::Write()
   {
     const auto *image = dynamic_cast<const mitk::Image *>(this->GetInput());
@@ -729,13 +945,42 @@ namespace mitk
       // Handle UID
       itk::EncapsulateMetaData<std::string>(m_ImageIO->GetMetaDataDictionary(), PROPERTY_KEY_UID, image->GetUID());
 
-      // use compression if available
-      m_ImageIO->UseCompressionOn();
-      m_ImageIO->SetFileName(path);
+      const auto compressionOption = this->GetWriterOption(OPTION_NAME_COMPRESSION);
+      const auto compression = compressionOption.Empty() ? std::string(COMPRESSION_DEFAULT) : compressionOption.ToString();
+      const auto parallelCompressionOption = this->GetWriterOption(OPTION_NAME_PARALLEL_COMPRESSION);
+      const bool parallelCompression = parallelCompressionOption.Empty() || us::any_cast<bool>(parallelCompressionOption);
+
+      int compressionLevel = -1;
+
+      if (COMPRESSION_FAST == compression)
+      {
+        compressionLevel = 1;
+      }
+      else if (COMPRESSION_BEST == compression)
+      {
+        compressionLevel = 9;
+      }
 
       ImageReadAccessor imageAccess(image);
       LocaleSwitch localeSwitch2("C");
-      m_ImageIO->Write(imageAccess.GetData());
+
+      if (COMPRESSION_NONE != compression && parallelCompression && SupportsChunkedGzip(m_ImageIO, path))
+      {
+        const auto* data = imageAccess.GetData();
+        const auto sizeInBytes = m_ImageIO->GetImageSizeInBytes();
+
+        WriteChunkedGzipNrrdFile(m_ImageIO, path, [data, sizeInBytes, compressionLevel](std::ostream& file) {
+          ChunkedGzipCodec::Compress(data, sizeInBytes, file, compressionLevel);
+        });
+      }
+      else
+      {
+        // use compression if available
+        m_ImageIO->SetUseCompression(COMPRESSION_NONE != compression);
+        m_ImageIO->SetCompressionLevel(-1 != compressionLevel ? compressionLevel : m_DefaultCompressionLevel);
+        m_ImageIO->SetFileName(path);
+        m_ImageIO->Write(imageAccess.GetData());
+      }
     }
     catch (const std::exception &e)
     {
@@ -782,6 +1027,20 @@ namespace mitk
   }
 
   ItkImageIO *ItkImageIO::IOClone() const { return new ItkImageIO(*this); }
+
+  void ItkImageIO::InitializeDefaultWriterOptions()
+  {
+    m_DefaultCompressionLevel = m_ImageIO->GetCompressionLevel();
+
+    Options defaultOptions;
+    defaultOptions[OPTION_NAME_COMPRESSION] = std::string(COMPRESSION_DEFAULT);
+    defaultOptions[std::string(OPTION_NAME_COMPRESSION) + ".enum"] =
+      std::vector<std::string>{ COMPRESSION_DEFAULT, COMPRESSION_FAST, COMPRESSION_BEST, COMPRESSION_NONE };
+    defaultOptions[OPTION_NAME_PARALLEL_COMPRESSION] = true;
+
+    this->SetDefaultWriterOptions(defaultOptions);
+  }
+
   void ItkImageIO::InitializeDefaultMetaDataKeys()
   {
     this->m_DefaultMetaDataKeys.push_back("NRRD.space");
@@ -0,0 +1,272 @@
+/*============================================================================
+
+The Medical Imaging Interaction Toolkit (MITK)
+
+Copyright (c) German Cancer Research Center (DKFZ)
+All rights reserved.
+
+Use of this source code is governed by a 3-clause BSD license that can be
+found in the LICENSE file.
+
+============================================================================*/
+
+#include "mitkAsynchronousReslicer.h"
+
+#include <mitkImageReadAccessor.h>
+#include <mitkRenderingManager.h>
+
+#include <vtkImageData.h>
+#include <vtkImageReslice.h>
+#include <vtkLinearTransform.h>
+#include <vtkMatrix4x4.h>
+#include <vtkTransform.h>
+
+#include <algorithm>
+#include <condition_variable>
+#include <deque>
+#include <functional>
+#include <mutex>
+#include <thread>
+
+namespace
+{
+  bool IsEqual(const mitk::ResliceCache::Key &lhs, const mitk::ResliceCache::Key &rhs)
+  {
+    return !(lhs < rhs) && !(rhs < lhs);
+  }
+
+  /** Single thread that executes the reslice jobs of all asynchronous reslicers in order.*/
+  class ResliceWorker
+  {
+  public:
+    static ResliceWorker &GetInstance()
+    {
+      static ResliceWorker instance;
+      return instance;
+    }
+
+    void AddJob(std::function<void()> job)
+    {
+      {
+        std::lock_guard<std::mutex> lock(m_Mutex);
+        m_Jobs.push_back(std::move(job));
+      }
+      m_Condition.notify_one();
+    }
+
+  private:
+    ResliceWorker()
+      : m_Stop(false), m_Thread(&ResliceWorker::Run, this)
+    {
+    }
+
+    ~ResliceWorker()
+    {
+      {
+        std::lock_guard<std::mutex> lock(m_Mutex);
+        m_Stop = true;
+        m_Jobs.clear();
+      }
+      m_Condition.notify_one();
+      m_Thread.join();
+    }
+
+    void Run()
+    {
+      std::unique_lock<std::mutex> lock(m_Mutex);
+      while (true)
+      {
+        m_Condition.wait(lock, [this] { return m_Stop || !m_Jobs.empty(); });
+        if (m_Stop)
+          return;
+
+        auto job = std::move(m_Jobs.front());
+        m_Jobs.pop_front();
+
+        lock.unlock();
+        job();
+        lock.lock();
+      }
+    }
+
+    std::mutex m_Mutex;
+    std::condition_variable m_Condition;
+    std::deque<std::function<void()>> m_Jobs;
+    bool m_Stop;
+    std::thread m_Thread;
+  };
+}
+
+struct mitk::AsynchronousReslicer::State
+{
+  mutable std::mutex Mutex;
+
+  /** Incremented by every Start() and Abort(). Workers of older generations discard their result.*/
+  unsigned long Generation = 0;
+
+  ResliceCache::Key Key;
+  vtkSmartPointer<vtkImageReslice> RunningReslicer;
+  ResliceCache::SliceConstPointer Result;
+
+  void AbortRunningReslicer()
+  {
+    if (nullptr != RunningReslicer)
+      RunningReslicer->SetAbortExecute(1);
+
+    RunningReslicer = nullptr;
+    Result = nullptr;
+    ++Generation;
+  }
+};
+
+mitk::AsynchronousReslicer::AsynchronousReslicer()
+  : m_State(std::make_shared<State>())
+{
+}
+
+mitk::AsynchronousReslicer::~AsynchronousReslicer()
+{
+  // the worker keeps the state alive, it only has to know that its result is not needed anymore
+  this->Abort();
+}
+
+bool mitk::AsynchronousReslicer::Start(const ResliceCache::Key &key,
+                                       const Image *image,
+                                       TimeStepType timeStep,
+                                       vtkImageReslice *previewReslicer,
+                                       int interpolation,
+                                       const double clippedPlaneBounds[6],
+                                       const ScalarType spacing[2],
+                                       RenderingManager *renderingManager,
+                                       vtkRenderWindow *renderWindow)
+{
+  if (nullptr == image || nullptr == previewReslicer || nullptr == renderingManager)
+    return false;
+
+  // Copy everything the worker needs, so that it does not share any (not thread-safe) VTK or MITK pipeline
+  // object with the main thread. Only the pixel data of the image volume is shared. The worker reads it
+  // under an ImageReadAccessor, so writers of the volume wait for the running reslice and vice versa.
+  ImageDataItem::Pointer volumeData = image->GetVolumeData(timeStep);
+  if (volumeData.IsNull())
+    return false;
+
+  auto reslicer = vtkSmartPointer<vtkImageReslice>::New();
+  auto input = vtkSmartPointer<vtkImageData>::New();
+  input->ShallowCopy(const_cast<Image *>(image)->GetVtkImageData(timeStep));
+
+  if (nullptr != previewReslicer->GetResliceTransform())
+  {
+    auto *linearTransform = vtkLinearTransform::SafeDownCast(previewReslicer->GetResliceTransform());
+    if (nullptr == linearTransform)
+      return false;
+
+    auto resliceTransform = vtkSmartPointer<vtkTransform>::New();
+    resliceTransform->SetMatrix(linearTransform->GetMatrix());
+    reslicer->SetResliceTransform(resliceTransform);
+
+    // same as the unit spacing filter of ExtractSliceFilter, the transform already contains the spacing
+    input->SetSpacing(1.0, 1.0, 1.0);
+  }
+
+  auto resliceAxes = vtkSmartPointer<vtkMatrix4x4>::New();
+  resliceAxes->DeepCopy(previewReslicer->GetResliceAxes());
+
+  reslicer->SetInputData(input);
+  reslicer->SetResliceAxes(resliceAxes);
+  reslicer->SetOutputDimensionality(previewReslicer->GetOutputDimensionality());
+  reslicer->SetOutputExtent(previewReslicer->GetOutputExtent());
+  reslicer->SetOutputOrigin(previewReslicer->GetOutputOrigin());
+  reslicer->SetOutputSpacing(previewReslicer->GetOutputSpacing());
+  reslicer->SetBackgroundLevel(previewReslicer->GetBackgroundLevel());
+  reslicer->SetInterpolationMode(interpolation);
+
+  auto slice = std::make_shared<ResliceCache::Slice>();
+  std::copy(clippedPlaneBounds, clippedPlaneBounds + 6, slice->ClippedPlaneBounds);
+  std::copy(spacing, spacing + 2, slice->Spacing);
+  slice->ResliceAxes = resliceAxes;
+
+  unsigned long generation = 0;
+
+  {
+    std::lock_guard<std::mutex> lock(m_State->Mutex);
+    m_State->AbortRunningReslicer();
+    m_State->Key = key;
+    m_State->RunningReslicer = reslicer;
+    generation = m_State->Generation;
+  }
+
+  auto state = m_State;
+  Image::ConstPointer imageHolder = image;
+  RenderingManager::Pointer renderingManagerHolder = renderingManager;
+
+  ResliceWorker::GetInstance().AddJob(
+    [state, generation, reslicer, slice, imageHolder, volumeData, renderingManagerHolder, renderWindow]()
+    {
+      {
+        std::lock_guard<std::mutex> lock(state->Mutex);
+        if (generation != state->Generation)
+          return;
+      }
+
+      try
+      {
+        // The accessor is created by the worker thread, so a write access of the main thread waits for
+        // the reslice instead of being rejected as a recursive access of the same thread.
+        ImageReadAccessor accessor(imageHolder, volumeData);
+        reslicer->Update();
+      }
+      catch (const Exception &e)
+      {
+        MITK_WARN << "Asynchronous reslicing failed: " << e.GetDescription();
+
+        std::lock_guard<std::mutex> lock(state->Mutex);
+        if (generation == state->Generation)
+          state->RunningReslicer = nullptr;
+        return;
+      }
+
+      {
+        std::lock_guard<std::mutex> lock(state->Mutex);
+        if (generation != state->Generation || 0 != reslicer->GetAbortExecute())
+          return;
+
+        slice->Image = reslicer->GetOutput();
+        state->RunningReslicer = nullptr;
+        state->Result = slice;
+      }
+
+      renderingManagerHolder->RequestAsynchronousUpdate(renderWindow);
+    });
+
+  return true;
+}
+
+void mitk::AsynchronousReslicer::Abort()
+{
+  std::lock_guard<std::mutex> lock(m_State->Mutex);
+  m_State->AbortRunningReslicer();
+}
+
+bool mitk::AsynchronousReslicer::IsRunning(const ResliceCache::Key &key) const
+{
+  std::lock_guard<std::mutex> lock(m_State->Mutex);
+  return nullptr != m_State->RunningReslicer && IsEqual(key, m_State->Key);
+}
+
+bool mitk::AsynchronousReslicer::HasResult() const
+{
+  std::lock_guard<std::mutex> lock(m_State->Mutex);
+  return nullptr != m_State->Result;
+}
+
+mitk::ResliceCache::SliceConstPointer mitk::AsynchronousReslicer::TakeResult(const ResliceCache::Key &key)
+{
+  std::lock_guard<std::mutex> lock(m_State->Mutex);
+
+  ResliceCache::SliceConstPointer result;
+  if (nullptr != m_State->Result && IsEqual(key, m_State->Key))
+    result = m_State->Result;
+
+  m_State->Result = nullptr;
+  return result;
+}
@@ -20,6 +20,8 @@ found in the LICENSE file.
 #include <mitkPlaneGeometry.h>
 #include <mitkProperties.h>
 #include <mitkPropertyNameHelper.h>
+#include <mitkRenderingManager.h>
+#include <mitkResliceCache.h>
 #include <mitkResliceMethodProperty.h>
 #include <mitkVtkResliceInterpolationProperty.h>
 
@@ -51,6 +53,9 @@ found in the LICENSE file.
 #include <vtkProperty.h>
 #include <vtkTransform.h>
 
+// STL
+#include <algorithm>
+
 // ITK
 #include <itkRGBAPixel.h>
 #include <mitkRenderingModeProperty.h>
@@ -97,6 +102,31 @@ namespace
 
     return false;
   }
+
+  /** Returns 1 (-1) if the plane is the previous plane moved by one slice in (against) normal direction, otherwise 0.*/
+  int GetThickSlabShift(const mitk::PlaneGeometry* previousPlane, const mitk::PlaneGeometry* plane, double sliceDistance)
+  {
+    if (nullptr == previousPlane || nullptr == plane || sliceDistance <= 0.0)
+      return 0;
+
+    const auto tolerance = 0.001 * sliceDistance;
+
+    if (!mitk::Equal(previousPlane->GetAxisVector(0), plane->GetAxisVector(0), tolerance) ||
+        !mitk::Equal(previousPlane->GetAxisVector(1), plane->GetAxisVector(1), tolerance))
+      return 0;
+
+    auto normal = plane->GetNormal();
+    normal.Normalize();
+
+    const mitk::Vector3D translation = plane->GetOrigin() - previousPlane->GetOrigin();
+    const double distance = translation * normal;
+    const int shift = distance > 0.0 ? 1 : -1;
+
+    if (std::abs(distance - shift * sliceDistance) > tolerance || !mitk::Equal(translation, normal * distance, tolerance))
+      return 0;
+
+    return shift;
+  }
 }
 
 mitk::ImageVtkMapper2D::ImageVtkMapper2D()
@@ -134,7 +164,7 @@ float mitk::ImageVtkMapper2D::CalculateLayerDepth(mitk::BaseRenderer *renderer)
   // Due to a VTK bug, we cannot use the whole clipping range. /100 is empirically determined
   float depth = -maxRange * 0.01; // divide by 100
   int layer = 0;
-  GetDataNode()->GetIntProperty("layer", layer, renderer);
+  GetDataNode()->GetIntProperty(PropertyKeys::Layer(), layer, renderer);
   // add the layer property for each image to render images with a higher layer on top of the others
   depth += layer * 10; //*10: keep some room for each image (e.g. for ODFs in between)
   if (depth > 0.0f)
@@ -204,6 +234,7 @@ void mitk::ImageVtkMapper2D::GenerateDataForRenderer(mitk::BaseRenderer *rendere
 
   // Initialize the interpolation mode for resampling; switch to nearest
   // neighbor if the input image is too small.
+  auto interpolation = ExtractSliceFilter::RESLICE_NEAREST;
   if ((image->GetDimension() >= 3) && (image->GetDimension(2) > 1))
   {
     VtkResliceInterpolationProperty *resliceInterpolationProperty;
@@ -218,20 +249,17 @@ void mitk::ImageVtkMapper2D::GenerateDataForRenderer(mitk::BaseRenderer *rendere
     switch (interpolationMode)
     {
       case VTK_RESLICE_NEAREST:
-        localStorage->m_Reslicer->SetInterpolationMode(ExtractSliceFilter::RESLICE_NEAREST);
+        interpolation = ExtractSliceFilter::RESLICE_NEAREST;
         break;
       case VTK_RESLICE_LINEAR:
-        localStorage->m_Reslicer->SetInterpolationMode(ExtractSliceFilter::RESLICE_LINEAR);
+        interpolation = ExtractSliceFilter::RESLICE_LINEAR;
         break;
       case VTK_RESLICE_CUBIC:
-        localStorage->m_Reslicer->SetInterpolationMode(ExtractSliceFilter::RESLICE_CUBIC);
+        interpolation = ExtractSliceFilter::RESLICE_CUBIC;
         break;
     }
   }
-  else
-  {
-    localStorage->m_Reslicer->SetInterpolationMode(ExtractSliceFilter::RESLICE_NEAREST);
-  }
+  localStorage->m_Reslicer->SetInterpolationMode(interpolation);
 
   // set the vtk output property to true, makes sure that no unneeded mitk image conversion
   // is done.
@@ -267,7 +295,58 @@ void mitk::ImageVtkMapper2D::GenerateDataForRenderer(mitk::BaseRenderer *rendere
 
   const auto *planeGeometry = dynamic_cast<const PlaneGeometry *>(worldGeometry);
 
-  if (thickSlicesMode > 0)
+  // Bounds information for reslicing (only reuqired if reference geometry
+  // is present)
+  // this used for generating a vtkPLaneSource with the right size
+  double sliceBounds[6];
+  for (auto &sliceBound : sliceBounds)
+  {
+    sliceBound = 0.0;
+  }
+
+  // Other render windows showing the same plane (or a previous update with unchanged
+  // image and plane) may already have resliced the image.
+  ResliceCache::Key cacheKey;
+  const bool useCache = ResliceCache::CreateKey(image,
+                                                planeGeometry,
+                                                this->GetTimestep(),
+                                                interpolation,
+                                                inPlaneResampleExtentByGeometry,
+                                                thickSlicesMode,
+                                                thickSlicesNum,
+                                                cacheKey);
+  auto cachedSlice = useCache ? ResliceCache::GetInstance()->Get(cacheKey) : nullptr;
+
+  // a finished asynchronous refinement of this slice is used like a cached slice
+  if (nullptr == cachedSlice && useCache)
+  {
+    cachedSlice = localStorage->m_AsynchronousReslicer.TakeResult(cacheKey);
+
+    if (nullptr != cachedSlice)
+    {
+      ResliceCache::GetInstance()->Insert(
+        cacheKey, cachedSlice->Image, cachedSlice->ClippedPlaneBounds, cachedSlice->Spacing, cachedSlice->ResliceAxes);
+    }
+  }
+
+  // In asynchronous mode a nearest neighbor preview is shown first. The slice with the requested
+  // interpolation is computed in the background and replaces the preview with the next update.
+  auto *renderingManager = renderer->GetRenderingManager();
+  const bool refineAsynchronously = nullptr == cachedSlice && useCache && 0 == thickSlicesMode &&
+                                    ExtractSliceFilter::RESLICE_NEAREST != interpolation &&
+                                    nullptr != renderingManager && renderingManager->GetAsynchronousSliceRendering();
+
+  if (!refineAsynchronously)
+    localStorage->m_AsynchronousReslicer.Abort();
+
+  if (nullptr != cachedSlice)
+  {
+    localStorage->m_ReslicedImage = cachedSlice->Image;
+    std::copy(cachedSlice->ClippedPlaneBounds, cachedSlice->ClippedPlaneBounds + 6, sliceBounds);
+    std::copy(cachedSlice->Spacing, cachedSlice->Spacing + 2, localStorage->m_SliceSpacing);
+    localStorage->m_ResliceAxes->DeepCopy(cachedSlice->ResliceAxes);
+  }
+  else if (thickSlicesMode > 0)
   {
     double dataZSpacing = 1.0;
 
@@ -292,6 +371,27 @@ void mitk::ImageVtkMapper2D::GenerateDataForRenderer(mitk::BaseRenderer *rendere
 
     dataZSpacing = 1.0 / normInIndex.GetNorm();
 
+    // Stepping through the image moves the slab by one slice. The thick slices filter then
+    // only processes the slices that leave and enter the slab (sliding window).
+    int sliceShift = 0;
+    if (useCache && nullptr == abstractGeometry)
+    {
+      auto previousKey = localStorage->m_ThickSlabKey;
+      auto currentKey = cacheKey;
+      previousKey.Geometry.clear();
+      currentKey.Geometry.clear();
+
+      if (!(previousKey < currentKey) && !(currentKey < previousKey))
+        sliceShift = GetThickSlabShift(localStorage->m_ThickSlabPlane, planeGeometry, dataZSpacing);
+
+      localStorage->m_ThickSlabKey = cacheKey;
+      localStorage->m_ThickSlabPlane = planeGeometry->Clone();
+    }
+    else
+    {
+      localStorage->m_ThickSlabPlane = nullptr;
+    }
+
     localStorage->m_Reslicer->SetOutputDimensionality(3);
     localStorage->m_Reslicer->SetOutputSpacingZDirection(dataZSpacing);
     localStorage->m_Reslicer->SetOutputExtentZDirection(-thickSlicesNum, 0 + thickSlicesNum);
@@ -300,6 +400,7 @@ void mitk::ImageVtkMapper2D::GenerateDataForRenderer(mitk::BaseRenderer *rendere
     // executed even though the input geometry information did not change; this
     // is necessary when the input /em data, but not the /em geometry changes.
     localStorage->m_TSFilter->SetThickSliceMode(thickSlicesMode - 1);
+    localStorage->m_TSFilter->SetSliceShift(sliceShift);
     localStorage->m_TSFilter->SetInputData(localStorage->m_Reslicer->GetVtkOutput());
 
     // vtkFilter=>mitkFilter=>vtkFilter update mechanism will fail without calling manually
@@ -317,24 +418,52 @@ void mitk::ImageVtkMapper2D::GenerateDataForRenderer(mitk::BaseRenderer *rendere
     localStorage->m_Reslicer->SetOutputSpacingZDirection(1.0);
     localStorage->m_Reslicer->SetOutputExtentZDirection(0, 0);
 
+    if (refineAsynchronously)
+      localStorage->m_Reslicer->SetInterpolationMode(ExtractSliceFilter::RESLICE_NEAREST);
+
     localStorage->m_Reslicer->Modified();
     // start the pipeline with updating the largest possible, needed if the geometry of the input has changed
     localStorage->m_Reslicer->UpdateLargestPossibleRegion();
     localStorage->m_ReslicedImage = localStorage->m_Reslicer->GetVtkOutput();
   }
 
-  // Bounds information for reslicing (only reuqired if reference geometry
-  // is present)
-  // this used for generating a vtkPLaneSource with the right size
-  double sliceBounds[6];
-  for (auto &sliceBound : sliceBounds)
+  if (nullptr == cachedSlice)
   {
-    sliceBound = 0.0;
+    localStorage->m_Reslicer->GetClippedPlaneBounds(sliceBounds);
+
+    // get the spacing of the slice
+    const auto *outputSpacing = localStorage->m_Reslicer->GetOutputSpacing();
+    std::copy(outputSpacing, outputSpacing + 2, localStorage->m_SliceSpacing);
+    localStorage->m_ResliceAxes->DeepCopy(localStorage->m_Reslicer->GetResliceAxes());
+
+    if (refineAsynchronously)
+    {
+      if (!localStorage->m_AsynchronousReslicer.IsRunning(cacheKey) &&
+          !localStorage->m_AsynchronousReslicer.Start(cacheKey,
+                                                      image,
+                                                      this->GetTimestep(),
+                                                      localStorage->m_ResliceAlgorithm,
+                                                      interpolation,
+                                                      sliceBounds,
+                                                      localStorage->m_SliceSpacing,
+                                                      renderingManager,
+                                                      renderer->GetRenderWindow()))
+      {
+        // the slice cannot be refined in the background, so the requested interpolation is applied right away
+        localStorage->m_Reslicer->SetInterpolationMode(interpolation);
+        localStorage->m_Reslicer->Modified();
+        localStorage->m_Reslicer->UpdateLargestPossibleRegion();
+        localStorage->m_ReslicedImage = localStorage->m_Reslicer->GetVtkOutput();
+      }
+    }
+    else if (useCache)
+    {
+      ResliceCache::GetInstance()->Insert(
+        cacheKey, localStorage->m_ReslicedImage, sliceBounds, localStorage->m_SliceSpacing, localStorage->m_ResliceAxes);
+    }
   }
-  localStorage->m_Reslicer->GetClippedPlaneBounds(sliceBounds);
 
-  // get the spacing of the slice
-  localStorage->m_mmPerPixel = localStorage->m_Reslicer->GetOutputSpacing();
+  localStorage->m_mmPerPixel = localStorage->m_SliceSpacing;
 
   // calculate minimum bounding rect of IMAGE in texture
   {
@@ -711,7 +840,8 @@ void mitk::ImageVtkMapper2D::Update(mitk::BaseRenderer *renderer)
       (localStorage->m_LastUpdateTime < renderer->GetCurrentWorldPlaneGeometry()->GetMTime()) ||
       (localStorage->m_LastUpdateTime < node->GetPropertyList()->GetMTime()) ||
       (localStorage->m_LastUpdateTime < node->GetPropertyList(renderer)->GetMTime()) ||
-      (localStorage->m_LastUpdateTime < data->GetPropertyList()->GetMTime()))
+      (localStorage->m_LastUpdateTime < data->GetPropertyList()->GetMTime()) ||
+      localStorage->m_AsynchronousReslicer.HasResult())
   {
     this->GenerateDataForRenderer(renderer);
   }
@@ -1058,8 +1188,7 @@ void mitk::ImageVtkMapper2D::TransformActor(mitk::BaseRenderer *renderer)
   LocalStorage *localStorage = m_LSH.GetLocalStorage(renderer);
   // get the transformation matrix of the reslicer in order to render the slice as axial, coronal or sagittal
   vtkSmartPointer<vtkTransform> trans = vtkSmartPointer<vtkTransform>::New();
-  vtkSmartPointer<vtkMatrix4x4> matrix = localStorage->m_Reslicer->GetResliceAxes();
-  trans->SetMatrix(matrix);
+  trans->SetMatrix(localStorage->m_ResliceAxes);
   // transform the plane/contour (the actual actor) to the corresponding view (axial, coronal or sagittal)
   localStorage->m_ImageActor->SetUserTransform(trans);
   // transform the origin to center based coordinates, because MITK is center based.
@@ -1118,15 +1247,20 @@ mitk::ImageVtkMapper2D::LocalStorage::LocalStorage()
   m_ShadowOutlineActor = vtkSmartPointer<vtkActor>::New();
   m_Actors = vtkSmartPointer<vtkPropAssembly>::New();
   m_EmptyActors = vtkSmartPointer<vtkPropAssembly>::New();
-  m_Reslicer = mitk::ExtractSliceFilter::New();
+  m_ResliceAlgorithm = vtkSmartPointer<vtkImageReslice>::New();
+  m_Reslicer = mitk::ExtractSliceFilter::New(m_ResliceAlgorithm);
   m_TSFilter = vtkSmartPointer<vtkMitkThickSlicesFilter>::New();
   m_OutlinePolyData = vtkSmartPointer<vtkPolyData>::New();
   m_ReslicedImage = vtkSmartPointer<vtkImageData>::New();
+  m_ResliceAxes = vtkSmartPointer<vtkMatrix4x4>::New();
+  m_SliceSpacing[0] = m_SliceSpacing[1] = 1.0;
+  m_mmPerPixel = m_SliceSpacing;
   m_EmptyPolyData = vtkSmartPointer<vtkPolyData>::New();
 
   // the following actions are always the same and thus can be performed
   // in the constructor for each image (i.e. the image-corresponding local storage)
   m_TSFilter->ReleaseDataFlagOn();
+  m_TSFilter->SlidingWindowOn();
 
   mitk::LookupTable::Pointer mitkLUT = mitk::LookupTable::New();
   // built a default lookuptable
@@ -0,0 +1,295 @@
+/*============================================================================
+
+The Medical Imaging Interaction Toolkit (MITK)
+
+Copyright (c) German Cancer Research Center (DKFZ)
+All rights reserved.
+
+Use of this source code is governed by a 3-clause BSD license that can be
+found in the LICENSE file.
+
+============================================================================*/
+
+#include "mitkResliceCache.h"
+
+#include <mitkAbstractTransformGeometry.h>
+#include <mitkImage.h>
+#include <mitkPlaneGeometry.h>
+
+#include <itkCommand.h>
+
+#include <vtkImageData.h>
+#include <vtkMatrix4x4.h>
+
+#include <algorithm>
+#include <iterator>
+#include <tuple>
+
+namespace
+{
+  void AppendGeometry(const mitk::BaseGeometry* geometry, std::vector<double>& values)
+  {
+    const auto* transform = geometry->GetIndexToWorldTransform();
+    const auto& matrix = transform->GetMatrix();
+    const auto& offset = transform->GetOffset();
+
+    for (unsigned int i = 0; i < 3; ++i)
+    {
+      for (unsigned int j = 0; j < 3; ++j)
+        values.push_back(matrix[i][j]);
+
+      values.push_back(offset[i]);
+    }
+
+    const auto bounds = geometry->GetBounds();
+    for (unsigned int i = 0; i < 6; ++i)
+      values.push_back(bounds[i]);
+
+    values.push_back(geometry->GetImageGeometry() ? 1.0 : 0.0);
+  }
+}
+
+bool mitk::ResliceCache::Key::operator<(const Key& other) const
+{
+  return std::tie(ImageAddress, ImageMTime, ImageWriteCount, TimeStep, Interpolation, InPlaneResampleExtentByGeometry, ThickSlicesMode, ThickSlicesNum, Geometry) <
+         std::tie(other.ImageAddress, other.ImageMTime, other.ImageWriteCount, other.TimeStep, other.Interpolation, other.InPlaneResampleExtentByGeometry, other.ThickSlicesMode, other.ThickSlicesNum, other.Geometry);
+}
+
+mitk::ResliceCache* mitk::ResliceCache::GetInstance()
+{
+  static ResliceCache instance;
+  return &instance;
+}
+
+mitk::ResliceCache::ResliceCache()
+  : m_MemoryLimit(256 * 1024 * 1024),
+    m_MemorySize(0),
+    m_NumberOfHits(0),
+    m_NumberOfMisses(0)
+{
+}
+
+mitk::ResliceCache::~ResliceCache()
+{
+  // images that are still alive must not call back into the destroyed cache
+  for (const auto& imageObserverTag : m_ImageObserverTags)
+    imageObserverTag.first->RemoveObserver(imageObserverTag.second);
+}
+
+bool mitk::ResliceCache::CreateKey(const Image* image,
+                                   const PlaneGeometry* planeGeometry,
+                                   unsigned int timeStep,
+                                   int interpolation,
+                                   bool inPlaneResampleExtentByGeometry,
+                                   int thickSlicesMode,
+                                   int thickSlicesNum,
+                                   Key& key)
+{
+  if (nullptr == image || nullptr == planeGeometry || nullptr != dynamic_cast<const AbstractTransformGeometry*>(planeGeometry))
+    return false;
+
+  key.ImageAddress = image;
+  key.ImageMTime = image->GetMTime();
+  key.ImageWriteCount = image->GetWriteCount();
+  key.TimeStep = timeStep;
+  key.Interpolation = interpolation;
+  key.InPlaneResampleExtentByGeometry = inPlaneResampleExtentByGeometry;
+  key.ThickSlicesMode = thickSlicesMode;
+  key.ThickSlicesNum = thickSlicesMode > 0 ? thickSlicesNum : 0;
+
+  key.Geometry.clear();
+  key.Geometry.reserve(3 * 19 + 2);
+  AppendGeometry(planeGeometry, key.Geometry);
+
+  // the reference geometry determines the clipped extent of the slice
+  if (nullptr != planeGeometry->GetReferenceGeometry())
+    AppendGeometry(planeGeometry->GetReferenceGeometry(), key.Geometry);
+
+  // the time geometry may be exchanged or changed without modifying the image
+  const auto* timeGeometry = image->GetTimeGeometry();
+  if (nullptr == timeGeometry || !timeGeometry->IsValidTimeStep(timeStep))
+    return false;
+
+  AppendGeometry(timeGeometry->GetGeometryForTimeStep(timeStep), key.Geometry);
+
+  const auto timeBounds = timeGeometry->GetTimeBounds(timeStep);
+  key.Geometry.push_back(timeBounds[0]);
+  key.Geometry.push_back(timeBounds[1]);
+
+  return true;
+}
+
+mitk::ResliceCache::SliceConstPointer mitk::ResliceCache::Get(const Key& key)
+{
+  std::lock_guard<std::mutex> lock(m_Mutex);
+
+  auto finding = m_Index.find(key);
+  if (finding == m_Index.end())
+  {
+    ++m_NumberOfMisses;
+    return nullptr;
+  }
+
+  ++m_NumberOfHits;
+
+  // mark as most recently used
+  m_Entries.splice(m_Entries.begin(), m_Entries, finding->second);
+  return finding->second->CachedSlice;
+}
+
+mitk::ResliceCache::SliceConstPointer mitk::ResliceCache::Insert(const Key& key,
+                                                                 vtkImageData* image,
+                                                                 const double clippedPlaneBounds[6],
+                                                                 const ScalarType spacing[2],
+                                                                 vtkMatrix4x4* resliceAxes)
+{
+  if (nullptr == image || nullptr == resliceAxes)
+    return nullptr;
+
+  const std::size_t memorySize = static_cast<std::size_t>(image->GetActualMemorySize()) * 1024;
+
+  {
+    std::lock_guard<std::mutex> lock(m_Mutex);
+    if (memorySize > m_MemoryLimit)
+      return nullptr;
+  }
+
+  // the pixel data is shared read-only from now on
+  auto slice = std::make_shared<Slice>();
+  slice->Image = vtkSmartPointer<vtkImageData>::New();
+  slice->Image->ShallowCopy(image);
+  std::copy(clippedPlaneBounds, clippedPlaneBounds + 6, slice->ClippedPlaneBounds);
+  std::copy(spacing, spacing + 2, slice->Spacing);
+  slice->ResliceAxes = vtkSmartPointer<vtkMatrix4x4>::New();
+  slice->ResliceAxes->DeepCopy(resliceAxes);
+
+  std::lock_guard<std::mutex> lock(m_Mutex);
+
+  auto finding = m_Index.find(key);
+  if (finding != m_Index.end())
+    this->RemoveEntry(finding->second);
+
+  // slices of older versions of the image will never be requested again
+  for (auto entry = m_Entries.begin(); entry != m_Entries.end();)
+  {
+    auto current = entry++;
+    if (current->EntryKey.ImageAddress == key.ImageAddress &&
+        (current->EntryKey.ImageMTime < key.ImageMTime || current->EntryKey.ImageWriteCount < key.ImageWriteCount))
+      this->RemoveEntry(current);
+  }
+
+  m_Entries.push_front({ key, slice, memorySize });
+  m_Index[key] = m_Entries.begin();
+  m_MemorySize += memorySize;
+
+  // the slices must not outlive the image; a new image at the same address must not hit them
+  if (m_ImageObserverTags.find(key.ImageAddress) == m_ImageObserverTags.end())
+  {
+    auto command = itk::MemberCommand<ResliceCache>::New();
+    command->SetCallbackFunction(this, &ResliceCache::OnImageDeleted);
+    m_ImageObserverTags[key.ImageAddress] = key.ImageAddress->AddObserver(itk::DeleteEvent(), command);
+  }
+
+  this->EnforceMemoryLimit();
+
+  return slice;
+}
+
+void mitk::ResliceCache::RemoveEntry(EntryListType::iterator entry)
+{
+  m_MemorySize -= entry->MemorySize;
+  m_Index.erase(entry->EntryKey);
+  m_Entries.erase(entry);
+}
+
+void mitk::ResliceCache::EnforceMemoryLimit()
+{
+  while (m_MemorySize > m_MemoryLimit && !m_Entries.empty())
+    this->RemoveEntry(std::prev(m_Entries.end()));
+}
+
+void mitk::ResliceCache::RemoveEntries(const Image* image)
+{
+  for (auto entry = m_Entries.begin(); entry != m_Entries.end();)
+  {
+    auto current = entry++;
+    if (current->EntryKey.ImageAddress == image)
+      this->RemoveEntry(current);
+  }
+}
+
+void mitk::ResliceCache::OnImageDeleted(const itk::Object* caller, const itk::EventObject&)
+{
+  const auto* image = static_cast<const Image*>(caller);
+
+  std::lock_guard<std::mutex> lock(m_Mutex);
+
+  // the observer is removed together with the image
+  m_ImageObserverTags.erase(image);
+  this->RemoveEntries(image);
+}
+
+void mitk::ResliceCache::Remove(const Image* image)
+{
+  std::lock_guard<std::mutex> lock(m_Mutex);
+
+  this->RemoveEntries(image);
+
+  auto finding = m_ImageObserverTags.find(image);
+  if (finding != m_ImageObserverTags.end())
+  {
+    image->RemoveObserver(finding->second);
+    m_ImageObserverTags.erase(finding);
+  }
+}
+
+void mitk::ResliceCache::Clear()
+{
+  std::lock_guard<std::mutex> lock(m_Mutex);
+
+  for (const auto& imageObserverTag : m_ImageObserverTags)
+    imageObserverTag.first->RemoveObserver(imageObserverTag.second);
+  m_ImageObserverTags.clear();
+
+  m_Entries.clear();
+  m_Index.clear();
+  m_MemorySize = 0;
+}
+
+void mitk::ResliceCache::SetMemoryLimit(std::size_t limit)
+{
+  std::lock_guard<std::mutex> lock(m_Mutex);
+
+  m_MemoryLimit = limit;
+  this->EnforceMemoryLimit();
+}
+
+std::size_t mitk::ResliceCache::GetMemoryLimit() const
+{
+  std::lock_guard<std::mutex> lock(m_Mutex);
+  return m_MemoryLimit;
+}
+
+std::size_t mitk::ResliceCache::GetMemorySize() const
+{
+  std::lock_guard<std::mutex> lock(m_Mutex);
+  return m_MemorySize;
+}
+
+std::size_t mitk::ResliceCache::GetNumberOfSlices() const
+{
+  std::lock_guard<std::mutex> lock(m_Mutex);
+  return m_Entries.size();
+}
+
+std::size_t mitk::ResliceCache::GetNumberOfHits() const
+{
+  std::lock_guard<std::mutex> lock(m_Mutex);
+  return m_NumberOfHits;
+}
+
+std::size_t mitk::ResliceCache::GetNumberOfMisses() const
+{
+  std::lock_guard<std::mutex> lock(m_Mutex);
+  return m_NumberOfMisses;
+}
@@ -250,7 +250,7 @@ void mitk::VtkPropRenderer::PrepareMapperQueue()
     }
     // mapper without a layer property get layer number 1
     int layer = 1;
-    node->GetIntProperty("layer", layer, this);
+    node->GetIntProperty(PropertyKeys::Layer(), layer, this);
     int nr = (layer << 16) + mapperNo;
     m_MappersMap.insert(std::pair<int, Mapper *>(nr, mapper));
     mapperNo++;
@@ -20,9 +20,18 @@ found in the LICENSE file.
 #include "vtkPointData.h"
 #include "vtkStreamingDemandDrivenPipeline.h"
 
+#include <algorithm>
 #include <cmath>
+#include <cstdlib>
 #include <sstream>
 
+namespace
+{
+  // Incremental updates of floating point sums accumulate rounding errors,
+  // so the sum is recomputed from scratch after this many updates.
+  const unsigned int MaximumNumberOfIncrementalUpdates = 64;
+}
+
 vtkStandardNewMacro(vtkMitkThickSlicesFilter);
 
 //----------------------------------------------------------------------------
@@ -31,8 +40,17 @@ vtkMitkThickSlicesFilter::vtkMitkThickSlicesFilter()
 {
   this->HandleBoundaries = 1;
   this->Dimensionality = 2;
+  this->SlidingWindow = 0;
+  this->SliceShift = 0;
 
   this->m_CurrentMode = MIP;
+  std::fill_n(this->m_SlidingWindowExtent, 6, 0);
+  this->m_SlidingWindowValid = false;
+  this->m_IncrementalSliceShift = 0;
+  this->m_IncrementalUpdateCount = 0;
+
+  // Pieces of the 2D output are blocks of rows.
+  this->SetSplitModeToSlab();
 
   // by default process active point scalars
   this->SetInputArrayToProcess(0, 0, 0, vtkDataObject::FIELD_ASSOCIATION_POINTS, vtkDataSetAttributes::SCALARS);
@@ -44,6 +62,8 @@ void vtkMitkThickSlicesFilter::PrintSelf(ostream &os, vtkIndent indent)
   this->Superclass::PrintSelf(os, indent);
   os << indent << "HandleBoundaries: " << this->HandleBoundaries << "\n";
   os << indent << "Dimensionality: " << this->Dimensionality << "\n";
+  os << indent << "SlidingWindow: " << this->SlidingWindow << "\n";
+  os << indent << "SliceShift: " << this->SliceShift << "\n";
 }
 
 //----------------------------------------------------------------------------
@@ -105,9 +125,61 @@ int vtkMitkThickSlicesFilter::RequestUpdateExtent(vtkInformation *,
 }
 
 //----------------------------------------------------------------------------
-// This execute method handles boundaries.
-// it handles boundaries. Pixels are just replicated to get values
-// out of extent.
+// The projections are computed row by row and slice by slice. The inner loops
+// run over contiguous memory without branches, so that the compiler can
+// vectorize them for every pixel type.
+namespace
+{
+  // Running sum of the sliding window and first and last slice of the last
+  // execution, each for the whole output extent.
+  struct SlidingWindowRows
+  {
+    double *Sum;
+    double *FirstSlice;
+    double *LastSlice;
+    vtkIdType Offset;
+    vtkIdType RowLength;
+    int SliceShift; // 0 if the sum is computed from scratch
+  };
+
+  template <class T>
+  void MaximumRow(const T *in, T *out, int length)
+  {
+    for (int x = 0; x < length; ++x)
+      out[x] = in[x] > out[x] ? in[x] : out[x];
+  }
+
+  template <class T>
+  void MinimumRow(const T *in, T *out, int length)
+  {
+    for (int x = 0; x < length; ++x)
+      out[x] = in[x] < out[x] ? in[x] : out[x];
+  }
+
+  template <class T>
+  void AddRow(const T *in, double *sum, int length)
+  {
+    for (int x = 0; x < length; ++x)
+      sum[x] += in[x];
+  }
+
+  template <class T>
+  void AddWeightedRow(const T *in, double weight, double *sum, int length)
+  {
+    for (int x = 0; x < length; ++x)
+      sum[x] += weight * in[x];
+  }
+
+  template <class T>
+  void CopyRow(const T *in, double *out, int length)
+  {
+    for (int x = 0; x < length; ++x)
+      out[x] = in[x];
+  }
+}
+
+//----------------------------------------------------------------------------
+// Projects all input slices of the rows in outExt.
 template <class T>
 void vtkMitkThickSlicesFilterExecute(vtkMitkThickSlicesFilter *self,
                                      vtkImageData *inData,
@@ -115,222 +187,154 @@ void vtkMitkThickSlicesFilterExecute(vtkMitkThickSlicesFilter *self,
                                      vtkImageData *outData,
                                      T *outPtr,
                                      int outExt[6],
-                                     int /*id*/)
+                                     SlidingWindowRows *slidingWindow)
 {
-  int idxX, idxY;
-  int maxX, maxY;
-  vtkIdType inIncX, inIncY, inIncZ;
-  vtkIdType outIncX, outIncY, outIncZ;
-  // int axesNum;
   int *inExt = inData->GetExtent();
-  int *wholeExtent;
-  vtkIdType *inIncs;
-  // int useYMin, useYMax, useXMin, useXMax;
-
-  // find the region to loop over
-  maxX = outExt[1] - outExt[0];
-  maxY = outExt[3] - outExt[2];
-
-  //  maxZ = outExt[5] - outExt[4];
-
-  // Get the dimensionality of the gradient.
-  // axesNum = self->GetDimensionality();
+  vtkIdType *inIncs = inData->GetIncrements();
+  const vtkIdType outIncY = outData->GetIncrements()[1];
 
-  // Get increments to march through data
-  inData->GetContinuousIncrements(outExt, inIncX, inIncY, inIncZ);
-  outData->GetContinuousIncrements(outExt, outIncX, outIncY, outIncZ);
-  /*
-// The data spacing is important for computing the gradient.
-// central differences (2 * ratio).
-// Negative because below we have (min - max) for dx ...
-inData->GetSpacing(r);
-r[0] = -0.5 / r[0];
-r[1] = -0.5 / r[1];
-r[2] = -0.5 / r[2];
-    */
-  // get some other info we need
-  inIncs = inData->GetIncrements();
-  wholeExtent = inData->GetExtent();
-
-  // Move the pointer to the correct starting position.
-  inPtr += (outExt[0] - inExt[0]) * inIncs[0] + (outExt[2] - inExt[2]) * inIncs[1] + (outExt[4] - inExt[4]) * inIncs[2];
-
-  // Loop through output pixels
+  const int length = outExt[1] - outExt[0] + 1;
+  const int numberOfRows = outExt[3] - outExt[2] + 1;
+  const int numberOfSlices = inExt[5] - inExt[4] + 1;
 
-  int _minZ = /*-5 + outExt[4];  if( _minZ  < wholeExtent[4]) _minZ=*/wholeExtent[4];
-  int _maxZ = /* 5 + outExt[4];  if( _maxZ  > wholeExtent[5]) _maxZ=*/wholeExtent[5];
-
-  if (_maxZ < _minZ)
+  if (length <= 0 || numberOfRows <= 0 || numberOfSlices <= 0)
     return;
 
-  double invNum = 1.0 / (_maxZ - _minZ + 1);
+  // Move the pointer to the first row of the first input slice.
+  inPtr += (outExt[0] - inExt[0]) * inIncs[0] + (outExt[2] - inExt[2]) * inIncs[1];
+
+  auto inRow = [inPtr, inIncs](int y, int z) -> const T * { return inPtr + y * inIncs[1] + z * inIncs[2]; };
 
   switch (self->GetThickSliceMode())
   {
     default:
     case vtkMitkThickSlicesFilter::MIP:
     {
-      // MIP
-      for (idxY = 0; idxY <= maxY; idxY++)
+      for (int y = 0; y < numberOfRows; ++y)
       {
-        // useYMin = ((idxY + outExt[2]) <= wholeExtent[2]) ? 0 : -inIncs[1];
-        // useYMax = ((idxY + outExt[2]) >= wholeExtent[3]) ? 0 : inIncs[1];
-        for (idxX = 0; idxX <= maxX; idxX++)
-        {
-          // useXMin = ((idxX + outExt[0]) <= wholeExtent[0]) ? 0 : -inIncs[0];
-          // useXMax = ((idxX + outExt[0]) >= wholeExtent[1]) ? 0 : inIncs[0];
+        T *outRow = outPtr + y * outIncY;
+        std::copy(inRow(y, 0), inRow(y, 0) + length, outRow);
 
-          T mip = inPtr[_minZ * inIncs[2]];
+        for (int z = 1; z < numberOfSlices; ++z)
+          MaximumRow(inRow(y, z), outRow, length);
+      }
+    }
+    break;
 
-          for (int z = _minZ + 1; z <= _maxZ; z++)
-          {
-            T value = inPtr[z * inIncs[2]];
-            if (value > mip)
-              mip = value;
-          }
+    case vtkMitkThickSlicesFilter::MINIP:
+    {
+      for (int y = 0; y < numberOfRows; ++y)
+      {
+        T *outRow = outPtr + y * outIncY;
+        std::copy(inRow(y, 0), inRow(y, 0) + length, outRow);
 
-          // do X axis
-          *outPtr = mip;
-          outPtr++;
-          inPtr++;
-        }
-        outPtr += outIncY;
-        inPtr += inIncY;
+        for (int z = 1; z < numberOfSlices; ++z)
+          MinimumRow(inRow(y, z), outRow, length);
       }
     }
     break;
 
     case vtkMitkThickSlicesFilter::SUM:
+    case vtkMitkThickSlicesFilter::MEAN:
     {
-      // MIP
-      for (idxY = 0; idxY <= maxY; idxY++)
+      // SUM is normalized by the number of slices, MEAN by the number of slices minus one
+      const bool isSum = vtkMitkThickSlicesFilter::SUM == self->GetThickSliceMode();
+      const double invNum = 1.0 / numberOfSlices;
+      const double size = std::max(numberOfSlices - 1, 1);
+
+      std::vector<double> rowSum;
+      if (nullptr == slidingWindow)
+        rowSum.resize(length);
+
+      for (int y = 0; y < numberOfRows; ++y)
       {
-        // useYMin = ((idxY + outExt[2]) <= wholeExtent[2]) ? 0 : -inIncs[1];
-        // useYMax = ((idxY + outExt[2]) >= wholeExtent[3]) ? 0 : inIncs[1];
-        for (idxX = 0; idxX <= maxX; idxX++)
-        {
-          // useXMin = ((idxX + outExt[0]) <= wholeExtent[0]) ? 0 : -inIncs[0];
-          // useXMax = ((idxX + outExt[0]) >= wholeExtent[1]) ? 0 : inIncs[0];
+        double *sum = rowSum.data();
+        const T *firstRow = inRow(y, 0);
+        const T *lastRow = inRow(y, numberOfSlices - 1);
 
-          double sum = 0;
+        if (nullptr != slidingWindow)
+        {
+          const vtkIdType offset = slidingWindow->Offset + y * slidingWindow->RowLength;
+          sum = slidingWindow->Sum + offset;
+          double *previousFirstRow = slidingWindow->FirstSlice + offset;
+          double *previousLastRow = slidingWindow->LastSlice + offset;
 
-          for (int z = _minZ; z <= _maxZ; z++)
+          if (0 != slidingWindow->SliceShift)
+          {
+            // only the slice leaving and the slice entering the slab change the sum
+            if (slidingWindow->SliceShift > 0)
+            {
+              for (int x = 0; x < length; ++x)
+                sum[x] += lastRow[x] - previousFirstRow[x];
+            }
+            else
+            {
+              for (int x = 0; x < length; ++x)
+                sum[x] += firstRow[x] - previousLastRow[x];
+            }
+          }
+          else
           {
-            T value = inPtr[z * inIncs[2]];
-            sum += value;
+            std::fill_n(sum, length, 0.0);
+            for (int z = 0; z < numberOfSlices; ++z)
+              AddRow(inRow(y, z), sum, length);
           }
 
-          // do X axis
-          *outPtr = static_cast<T>(invNum * sum);
-          outPtr++;
-          inPtr++;
+          CopyRow(firstRow, previousFirstRow, length);
+          CopyRow(lastRow, previousLastRow, length);
+        }
+        else
+        {
+          std::fill_n(sum, length, 0.0);
+          for (int z = 0; z < numberOfSlices; ++z)
+            AddRow(inRow(y, z), sum, length);
+        }
+
+        T *outRow = outPtr + y * outIncY;
+        if (isSum)
+        {
+          for (int x = 0; x < length; ++x)
+            outRow[x] = static_cast<T>(invNum * sum[x]);
+        }
+        else
+        {
+          for (int x = 0; x < length; ++x)
+            outRow[x] = static_cast<T>(sum[x] / size);
         }
-        outPtr += outIncY;
-        inPtr += inIncY;
       }
     }
     break;
 
     case vtkMitkThickSlicesFilter::WEIGHTED:
     {
-      const int size = _maxZ - _minZ;
+      const int size = numberOfSlices - 1;
       std::vector<double> weights(size);
-      double mean = 0.5 * double(_minZ + _maxZ);
+      double mean = 0.5 * size;
       double sigma_sq = double(size) / 6.0;
       sigma_sq *= sigma_sq;
       double sum = 0;
-      int i = 0;
-      for (int z = _minZ + 1; z <= _maxZ; z++)
+      for (int z = 1; z <= size; z++)
       {
         double val = exp(-(((double)z - mean) / sigma_sq));
-        weights[i++] = val;
+        weights[z - 1] = val;
         sum += val;
       }
-      for (i = 0; i < size; i++)
+      for (auto &weight : weights)
       {
-        weights[i] /= sum;
+        weight /= sum;
       }
 
-      for (idxY = 0; idxY <= maxY; idxY++)
-      {
-        // useYMin = ((idxY + outExt[2]) <= wholeExtent[2]) ? 0 : -inIncs[1];
-        // useYMax = ((idxY + outExt[2]) >= wholeExtent[3]) ? 0 : inIncs[1];
-        for (idxX = 0; idxX <= maxX; idxX++)
-        {
-          // useXMin = ((idxX + outExt[0]) <= wholeExtent[0]) ? 0 : -inIncs[0];
-          // useXMax = ((idxX + outExt[0]) >= wholeExtent[1]) ? 0 : inIncs[0];
-
-          T mip = inPtr[_minZ * inIncs[2]];
-          i = 0;
-          double mymip = 0;
-          for (int z = _minZ + 1; z <= _maxZ; z++)
-          {
-            double value = inPtr[z * inIncs[2]];
-            mymip += value * weights[i++];
-          }
-          mip = static_cast<T>(mymip);
-          // do X axis
-          *outPtr = mip;
-          outPtr++;
-          inPtr++;
-        }
-        outPtr += outIncY;
-        inPtr += inIncY;
-      }
-    }
-    break;
+      std::vector<double> rowSum(length);
 
-    case vtkMitkThickSlicesFilter::MINIP:
-    {
-      for (idxY = 0; idxY <= maxY; idxY++)
+      for (int y = 0; y < numberOfRows; ++y)
       {
-        for (idxX = 0; idxX <= maxX; idxX++)
-        {
-          T mip = inPtr[_minZ * inIncs[2]];
+        std::fill(rowSum.begin(), rowSum.end(), 0.0);
+        for (int z = 1; z < numberOfSlices; ++z)
+          AddWeightedRow(inRow(y, z), weights[z - 1], rowSum.data(), length);
 
-          for (int z = _minZ + 1; z <= _maxZ; z++)
-          {
-            T value = inPtr[z * inIncs[2]];
-            if (value < mip)
-              mip = value;
-          }
-
-          // do X axis
-          *outPtr = mip;
-          outPtr++;
-          inPtr++;
-        }
-        outPtr += outIncY;
-        inPtr += inIncY;
-      }
-    }
-    break;
-
-    case vtkMitkThickSlicesFilter::MEAN:
-    {
-      const int size = _maxZ - _minZ;
-
-      // MEAN
-      for (idxY = 0; idxY <= maxY; idxY++)
-      {
-        for (idxX = 0; idxX <= maxX; idxX++)
-        {
-          long double sum = 0;
-          for (int z = _minZ; z <= _maxZ; z++)
-          {
-            T value = inPtr[z * inIncs[2]];
-            sum += value;
-          }
-
-          T mip = static_cast<T>(sum / size);
-
-          // do X axis
-          *outPtr = mip;
-          outPtr++;
-          inPtr++;
-        }
-        outPtr += outIncY;
-        inPtr += inIncY;
+        T *outRow = outPtr + y * outIncY;
+        for (int x = 0; x < length; ++x)
+          outRow[x] = static_cast<T>(rowSum[x]);
       }
     }
     break;
@@ -341,10 +345,45 @@ int vtkMitkThickSlicesFilter::RequestData(vtkInformation *request,
                                           vtkInformationVector **inputVector,
                                           vtkInformationVector *outputVector)
 {
+  const bool useSlidingWindow = 0 != this->SlidingWindow && (SUM == this->m_CurrentMode || MEAN == this->m_CurrentMode);
+  this->m_IncrementalSliceShift = 0;
+
+  if (useSlidingWindow)
+  {
+    int extent[6];
+    vtkImageData::GetData(inputVector[0])->GetExtent(extent);
+
+    if (this->m_SlidingWindowValid && std::equal(extent, extent + 6, this->m_SlidingWindowExtent) &&
+        1 == std::abs(this->SliceShift) && this->m_IncrementalUpdateCount < MaximumNumberOfIncrementalUpdates)
+    {
+      this->m_IncrementalSliceShift = this->SliceShift;
+    }
+
+    this->m_IncrementalUpdateCount = 0 != this->m_IncrementalSliceShift ? this->m_IncrementalUpdateCount + 1 : 0;
+    std::copy(extent, extent + 6, this->m_SlidingWindowExtent);
+
+    const auto size = static_cast<std::size_t>(std::max(0, extent[1] - extent[0] + 1)) * std::max(0, extent[3] - extent[2] + 1);
+    this->m_SlidingWindowSum.resize(size);
+    this->m_SlidingWindowFirstSlice.resize(size);
+    this->m_SlidingWindowLastSlice.resize(size);
+  }
+  else
+  {
+    this->m_SlidingWindowSum.clear();
+    this->m_SlidingWindowFirstSlice.clear();
+    this->m_SlidingWindowLastSlice.clear();
+  }
+
+  // the shift only refers to the input of this execution
+  this->SliceShift = 0;
+  this->m_SlidingWindowValid = false;
+
   if (!this->Superclass::RequestData(request, inputVector, outputVector))
   {
     return 0;
   }
+
+  this->m_SlidingWindowValid = useSlidingWindow;
   vtkImageData *output = vtkImageData::GetData(outputVector);
   vtkDataArray *outArray = output->GetPointData()->GetScalars();
   std::ostringstream newname;
@@ -368,7 +407,7 @@ void vtkMitkThickSlicesFilter::ThreadedRequestData(vtkInformation *,
                                                    vtkImageData ***inData,
                                                    vtkImageData **outData,
                                                    int outExt[6],
-                                                   int threadId)
+                                                   int)
 {
   // Get the input and output data objects.
   vtkImageData *input = inData[0][0];
@@ -405,10 +444,26 @@ void vtkMitkThickSlicesFilter::ThreadedRequestData(vtkInformation *,
   void *inPtr = inputArray->GetVoidPointer(0);
   void *outPtr = output->GetScalarPointerForExtent(outExt);
 
+  // The pieces of all threads are disjoint blocks of rows, so they share the sliding window buffers.
+  SlidingWindowRows slidingWindowRows;
+  SlidingWindowRows *slidingWindow = nullptr;
+
+  if (!this->m_SlidingWindowSum.empty())
+  {
+    slidingWindowRows.RowLength = this->m_SlidingWindowExtent[1] - this->m_SlidingWindowExtent[0] + 1;
+    slidingWindowRows.Offset = (outExt[2] - this->m_SlidingWindowExtent[2]) * slidingWindowRows.RowLength +
+                               (outExt[0] - this->m_SlidingWindowExtent[0]);
+    slidingWindowRows.Sum = this->m_SlidingWindowSum.data();
+    slidingWindowRows.FirstSlice = this->m_SlidingWindowFirstSlice.data();
+    slidingWindowRows.LastSlice = this->m_SlidingWindowLastSlice.data();
+    slidingWindowRows.SliceShift = this->m_IncrementalSliceShift;
+    slidingWindow = &slidingWindowRows;
+  }
+
   switch (inputArray->GetDataType())
   {
     vtkTemplateMacro(vtkMitkThickSlicesFilterExecute(
-      this, input, static_cast<VTK_TT *>(inPtr), output, static_cast<VTK_TT *>(outPtr), outExt, threadId));
+      this, input, static_cast<VTK_TT *>(inPtr), output, static_cast<VTK_TT *>(outPtr), outExt, slidingWindow));
     default:
       vtkErrorMacro("Execute: Unknown ScalarType " << input->GetScalarType());
       return;
@@ -69,6 +69,7 @@ set(MODULE_TESTS
   mitkTimeGeometryTest.cpp
   mitkProportionalTimeGeometryTest.cpp
   mitkUndoControllerTest.cpp
+  mitkLimitedLinearUndoTest.cpp
   mitkVtkWidgetRenderingTest.cpp
   mitkVerboseLimitedLinearUndoTest.cpp
   mitkWeakPointerTest.cpp
@@ -83,6 +84,8 @@ set(MODULE_TESTS
   mitkClippedSurfaceBoundsCalculatorTest.cpp
   mitkExceptionTest.cpp
   mitkExtractSliceFilterTest.cpp
+  mitkResliceCacheTest.cpp
+  mitkAsynchronousReslicerTest.cpp
   mitkLogTest.cpp
   mitkImageDimensionConverterTest.cpp
   mitkLoggingAdapterTest.cpp
@@ -121,6 +124,11 @@ set(MODULE_TESTS
   mitkSourceImageRelationRuleTest.cpp
   mitkTemporalJoinImagesFilterTest.cpp
   mitkPreferencesTest.cpp
+  mitkChunkedGzipCodecTest.cpp
+  mitkStandaloneDataStorageIndexTest.cpp
+  mitkPropertyKeyTest.cpp
+  mitkImageSnapshotTest.cpp
+  mitkImageDataBufferPoolTest.cpp
 )
 
 set(MODULE_RENDERING_TESTS
@@ -182,6 +190,8 @@ set(MODULE_CUSTOM_TESTS
     mitkImageEqualTest.cpp
     mitkRotatedSlice4DTest.cpp
     mitkPlaneGeometryDataMapper2DTest.cpp
+    mitkStandaloneDataStorageIndexBenchmark.cpp
+    mitkPropertyKeyBenchmark.cpp
 )
 
 # Currently not working on windows because of a rendering timing issue
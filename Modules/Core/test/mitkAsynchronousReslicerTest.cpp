@@ -0,0 +1,168 @@
+/*============================================================================
+
+The Medical Imaging Interaction Toolkit (MITK)
+
+Copyright (c) German Cancer Research Center (DKFZ)
+All rights reserved.
+
+Use of this source code is governed by a 3-clause BSD license that can be
+found in the LICENSE file.
+
+============================================================================*/
+
+// Testing
+#include "mitkTestFixture.h"
+#include "mitkTestingMacros.h"
+
+#include <mitkAsynchronousReslicer.h>
+#include <mitkImageWriteAccessor.h>
+#include <mitkPlaneGeometry.h>
+#include <mitkRenderingManager.h>
+
+#include <vtkImageData.h>
+#include <vtkImageReslice.h>
+#include <vtkMatrix4x4.h>
+
+#include <chrono>
+#include <thread>
+
+class mitkAsynchronousReslicerTestSuite : public mitk::TestFixture
+{
+  CPPUNIT_TEST_SUITE(mitkAsynchronousReslicerTestSuite);
+  MITK_TEST(Start_LinearInterpolation_RefinedSlice);
+  MITK_TEST(Abort_ResultDiscarded);
+  MITK_TEST(TakeResult_OtherKey_NoSlice);
+  CPPUNIT_TEST_SUITE_END();
+
+private:
+  mitk::Image::Pointer m_Image;
+  vtkSmartPointer<vtkImageReslice> m_PreviewReslicer;
+  mitk::ResliceCache::Key m_Key;
+  double m_Bounds[6];
+  mitk::ScalarType m_Spacing[2];
+
+  mitk::ResliceCache::Key CreateKey(mitk::ScalarType zPosition) const
+  {
+    auto plane = mitk::PlaneGeometry::New();
+    plane->InitializeStandardPlane(m_Image->GetGeometry(), mitk::AnatomicalPlane::Axial, zPosition);
+
+    mitk::ResliceCache::Key key;
+    CPPUNIT_ASSERT(mitk::ResliceCache::CreateKey(m_Image, plane, 0, VTK_RESLICE_LINEAR, false, 0, 1, key));
+    return key;
+  }
+
+  static bool WaitForResult(const mitk::AsynchronousReslicer &reslicer)
+  {
+    for (int i = 0; i < 1000 && !reslicer.HasResult(); ++i)
+      std::this_thread::sleep_for(std::chrono::milliseconds(10));
+
+    return reslicer.HasResult();
+  }
+
+  bool Start(mitk::AsynchronousReslicer &reslicer)
+  {
+    return reslicer.Start(m_Key,
+                          m_Image,
+                          0,
+                          m_PreviewReslicer,
+                          VTK_RESLICE_LINEAR,
+                          m_Bounds,
+                          m_Spacing,
+                          mitk::RenderingManager::GetInstance(),
+                          nullptr);
+  }
+
+public:
+  void setUp() override
+  {
+    // gray value z * 100 + y + x, so linear interpolation between two slices is exactly predictable
+    unsigned int dimensions[3] = { 32, 32, 8 };
+    m_Image = mitk::Image::New();
+    m_Image->Initialize(mitk::MakeScalarPixelType<float>(), 3, dimensions);
+
+    {
+      mitk::ImageWriteAccessor accessor(m_Image);
+      auto *data = static_cast<float *>(accessor.GetData());
+      for (unsigned int z = 0; z < 8; ++z)
+        for (unsigned int y = 0; y < 32; ++y)
+          for (unsigned int x = 0; x < 32; ++x)
+            *data++ = z * 100.0f + y + x;
+    }
+
+    // axial nearest neighbor preview half way between the slices 3 and 4
+    auto resliceAxes = vtkSmartPointer<vtkMatrix4x4>::New();
+    resliceAxes->SetElement(2, 3, 3.5);
+
+    m_PreviewReslicer = vtkSmartPointer<vtkImageReslice>::New();
+    m_PreviewReslicer->SetInputData(m_Image->GetVtkImageData(0));
+    m_PreviewReslicer->SetResliceAxes(resliceAxes);
+    m_PreviewReslicer->SetOutputDimensionality(2);
+    m_PreviewReslicer->SetOutputExtent(0, 31, 0, 31, 0, 0);
+    m_PreviewReslicer->SetOutputOrigin(0.0, 0.0, 0.0);
+    m_PreviewReslicer->SetOutputSpacing(1.0, 1.0, 1.0);
+    m_PreviewReslicer->SetInterpolationModeToNearestNeighbor();
+    m_PreviewReslicer->Update();
+
+    m_Key = this->CreateKey(3);
+    std::fill_n(m_Bounds, 6, 0.0);
+    m_Spacing[0] = m_Spacing[1] = 1.0;
+  }
+
+  void tearDown() override
+  {
+    m_PreviewReslicer = nullptr;
+    m_Image = nullptr;
+  }
+
+  void Start_LinearInterpolation_RefinedSlice()
+  {
+    mitk::AsynchronousReslicer reslicer;
+    CPPUNIT_ASSERT(this->Start(reslicer));
+    CPPUNIT_ASSERT_MESSAGE("Refined slice is not finished in time", WaitForResult(reslicer));
+    CPPUNIT_ASSERT(!reslicer.IsRunning(m_Key));
+
+    auto slice = reslicer.TakeResult(m_Key);
+    CPPUNIT_ASSERT(nullptr != slice);
+    CPPUNIT_ASSERT(nullptr != slice->Image);
+    CPPUNIT_ASSERT_MESSAGE("Result is only taken once", !reslicer.HasResult());
+
+    int dimensions[3];
+    slice->Image->GetDimensions(dimensions);
+    CPPUNIT_ASSERT_EQUAL(32, dimensions[0]);
+    CPPUNIT_ASSERT_EQUAL(32, dimensions[1]);
+
+    for (int y = 0; y < 32; y += 7)
+    {
+      for (int x = 0; x < 32; x += 5)
+      {
+        const auto value = slice->Image->GetScalarComponentAsDouble(x, y, 0, 0);
+        CPPUNIT_ASSERT_DOUBLES_EQUAL(350.0 + x + y, value, mitk::eps);
+      }
+    }
+  }
+
+  void Abort_ResultDiscarded()
+  {
+    mitk::AsynchronousReslicer reslicer;
+    CPPUNIT_ASSERT(this->Start(reslicer));
+    reslicer.Abort();
+
+    std::this_thread::sleep_for(std::chrono::milliseconds(200));
+
+    CPPUNIT_ASSERT(!reslicer.IsRunning(m_Key));
+    CPPUNIT_ASSERT(!reslicer.HasResult());
+    CPPUNIT_ASSERT(nullptr == reslicer.TakeResult(m_Key));
+  }
+
+  void TakeResult_OtherKey_NoSlice()
+  {
+    mitk::AsynchronousReslicer reslicer;
+    CPPUNIT_ASSERT(this->Start(reslicer));
+    CPPUNIT_ASSERT(WaitForResult(reslicer));
+
+    CPPUNIT_ASSERT(nullptr == reslicer.TakeResult(this->CreateKey(5)));
+    CPPUNIT_ASSERT_MESSAGE("Result of an outdated slice is discarded", !reslicer.HasResult());
+  }
+};
+
+MITK_TEST_SUITE_REGISTRATION(mitkAsynchronousReslicer)
@@ -0,0 +1,156 @@
+/*============================================================================
+
+The Medical Imaging Interaction Toolkit (MITK)
+
+Copyright (c) German Cancer Research Center (DKFZ)
+All rights reserved.
+
+Use of this source code is governed by a 3-clause BSD license that can be
+found in the LICENSE file.
+
+============================================================================*/
+
+#include <mitkChunkedGzipCodec.h>
+#include <mitkException.h>
+
+#include <mitkTestFixture.h>
+#include <mitkTestingMacros.h>
+
+#include <algorithm>
+#include <sstream>
+#include <vector>
+
+class mitkChunkedGzipCodecTestSuite : public mitk::TestFixture
+{
+  CPPUNIT_TEST_SUITE(mitkChunkedGzipCodecTestSuite);
+
+  MITK_TEST(CompressDecompress_MultipleChunks);
+  MITK_TEST(CompressDecompress_Levels);
+  MITK_TEST(CompressFill_EqualsCompress);
+  MITK_TEST(CompressDecompress_Empty);
+  MITK_TEST(IsChunked);
+  MITK_TEST(Decompress_WrongSize_Throws);
+  MITK_TEST(Decompress_Corrupt_Throws);
+  MITK_TEST(Compress_InvalidParameters_Throws);
+
+  CPPUNIT_TEST_SUITE_END();
+
+  std::vector<char> m_Data;
+
+public:
+  void setUp() override
+  {
+    // Partly compressible data whose size is no multiple of the chunk size
+    m_Data.resize(10007);
+    unsigned int state = 42;
+
+    for (std::size_t i = 0; i < m_Data.size(); ++i)
+    {
+      state = state * 1103515245u + 12345u;
+      m_Data[i] = 0 == (i / 100) % 2 ? static_cast<char>(state >> 16) : static_cast<char>(i / 100);
+    }
+  }
+
+  void tearDown() override
+  {
+    m_Data.clear();
+  }
+
+  std::string Compress(int level = -1, std::size_t chunkSize = 1000)
+  {
+    std::ostringstream stream;
+    mitk::ChunkedGzipCodec::Compress(m_Data.data(), m_Data.size(), stream, level, chunkSize);
+    return stream.str();
+  }
+
+  void CompressDecompress_MultipleChunks()
+  {
+    std::istringstream stream(this->Compress());
+
+    std::vector<char> result(m_Data.size());
+    mitk::ChunkedGzipCodec::Decompress(stream, result.data(), result.size());
+
+    CPPUNIT_ASSERT(m_Data == result);
+  }
+
+  void CompressFill_EqualsCompress()
+  {
+    std::ostringstream stream;
+    mitk::ChunkedGzipCodec::Compress(m_Data.size(), [this](std::size_t offset, std::size_t size, void* buffer) {
+      std::copy(m_Data.begin() + offset, m_Data.begin() + offset + size, static_cast<char*>(buffer));
+    }, stream, -1, 1000);
+
+    CPPUNIT_ASSERT(this->Compress() == stream.str());
+  }
+
+  void CompressDecompress_Levels()
+  {
+    for (int level : { 0, 1, 9 })
+    {
+      std::istringstream stream(this->Compress(level, 4096));
+
+      std::vector<char> result(m_Data.size());
+      mitk::ChunkedGzipCodec::Decompress(stream, result.data(), result.size());
+
+      CPPUNIT_ASSERT_MESSAGE("Level " + std::to_string(level), m_Data == result);
+    }
+  }
+
+  void CompressDecompress_Empty()
+  {
+    std::ostringstream outStream;
+    mitk::ChunkedGzipCodec::Compress(nullptr, 0, outStream);
+
+    std::istringstream inStream(outStream.str());
+    CPPUNIT_ASSERT(mitk::ChunkedGzipCodec::IsChunked(inStream));
+    CPPUNIT_ASSERT_NO_THROW(mitk::ChunkedGzipCodec::Decompress(inStream, nullptr, 0));
+  }
+
+  void IsChunked()
+  {
+    std::istringstream stream(this->Compress());
+    CPPUNIT_ASSERT(mitk::ChunkedGzipCodec::IsChunked(stream));
+    CPPUNIT_ASSERT_MESSAGE("Read position is restored", 0 == stream.tellg());
+
+    std::istringstream plainStream(std::string(m_Data.begin(), m_Data.end()));
+    CPPUNIT_ASSERT(!mitk::ChunkedGzipCodec::IsChunked(plainStream));
+
+    std::istringstream emptyStream;
+    CPPUNIT_ASSERT(!mitk::ChunkedGzipCodec::IsChunked(emptyStream));
+  }
+
+  void Decompress_WrongSize_Throws()
+  {
+    const auto compressedData = this->Compress();
+
+    std::istringstream tooSmallStream(compressedData);
+    std::vector<char> tooSmall(m_Data.size() - 1);
+    CPPUNIT_ASSERT_THROW(mitk::ChunkedGzipCodec::Decompress(tooSmallStream, tooSmall.data(), tooSmall.size()), mitk::Exception);
+
+    std::istringstream tooLargeStream(compressedData);
+    std::vector<char> tooLarge(m_Data.size() + 1);
+    CPPUNIT_ASSERT_THROW(mitk::ChunkedGzipCodec::Decompress(tooLargeStream, tooLarge.data(), tooLarge.size()), mitk::Exception);
+  }
+
+  void Decompress_Corrupt_Throws()
+  {
+    auto compressedData = this->Compress();
+    compressedData[compressedData.size() / 2] ^= 0x5a;
+
+    std::istringstream stream(compressedData);
+    std::vector<char> result(m_Data.size());
+    CPPUNIT_ASSERT_THROW(mitk::ChunkedGzipCodec::Decompress(stream, result.data(), result.size()), mitk::Exception);
+
+    std::istringstream truncatedStream(compressedData.substr(0, compressedData.size() - 1));
+    CPPUNIT_ASSERT_THROW(mitk::ChunkedGzipCodec::Decompress(truncatedStream, result.data(), result.size()), mitk::Exception);
+  }
+
+  void Compress_InvalidParameters_Throws()
+  {
+    CPPUNIT_ASSERT_THROW(this->Compress(-1, 0), mitk::Exception);
+    CPPUNIT_ASSERT_THROW(this->Compress(-1, mitk::ChunkedGzipCodec::MAXIMUM_CHUNK_SIZE + 1), mitk::Exception);
+    CPPUNIT_ASSERT_THROW(this->Compress(10), mitk::Exception);
+  }
+};
+
+MITK_TEST_SUITE_REGISTRATION(mitkChunkedGzipCodec)
@@ -14,16 +14,74 @@ found in the LICENSE file.
 #include <mitkTestFixture.h>
 #include <mitkTestingConfig.h>
 
+#include <mitkAbstractFileReader.h>
+#include <mitkCustomMimeType.h>
 #include <mitkIOUtil.h>
 #include <mitkUtf8Util.h>
 #include <mitkImageGenerator.h>
 #include <mitkIOMetaInformationPropertyConstants.h>
+#include <mitkPointSet.h>
+#include <mitkStandaloneDataStorage.h>
 #include <mitkVersion.h>
 
 #include <itkMetaDataObject.h>
 #include <itkNrrdImageIO.h>
 #include <itksys/SystemTools.hxx>
 
+#include <algorithm>
+#include <atomic>
+#include <fstream>
+
+namespace
+{
+  std::atomic<int> g_NumberOfSeriesReads(0);
+  std::vector<std::vector<std::string>> g_Series;
+
+  /** Reads all files of the series in g_Series that contains the input, like the readers of DICOM series.
+    Files of no series are read on their own.*/
+  class SeriesReader : public mitk::AbstractFileReader
+  {
+  public:
+    SeriesReader(const SeriesReader &other) : mitk::AbstractFileReader(other) {}
+
+    SeriesReader() : mitk::AbstractFileReader()
+    {
+      mitk::CustomMimeType mimeType("application/vnd.mitk.iotest.series");
+      mimeType.AddExtension("iotestseries");
+      mimeType.SetComment("Series of test files");
+      this->SetMimeType(mimeType);
+      this->SetDescription("Series of test files");
+      m_ServiceReg = this->RegisterService();
+    }
+
+    ~SeriesReader() override
+    {
+      if (m_ServiceReg)
+        m_ServiceReg.Unregister();
+    }
+
+    using mitk::AbstractFileReader::Read;
+
+  protected:
+    std::vector<itk::SmartPointer<mitk::BaseData>> DoRead() override
+    {
+      ++g_NumberOfSeriesReads;
+
+      for (const auto &series : g_Series)
+      {
+        if (std::find(series.begin(), series.end(), this->GetInputLocation()) != series.end())
+          m_ReadFiles = series;
+      }
+
+      return { mitk::PointSet::New().GetPointer() };
+    }
+
+  private:
+    SeriesReader *Clone() const override { return new SeriesReader(*this); }
+    us::ServiceRegistration<mitk::IFileReader> m_ServiceReg;
+  };
+}
+
 class mitkIOUtilTestSuite : public mitk::TestFixture
 {
   CPPUNIT_TEST_SUITE(mitkIOUtilTestSuite);
@@ -38,6 +96,10 @@ class mitkIOUtilTestSuite : public mitk::TestFixture
   MITK_TEST(TestTempMethodsForUniqueFilenames);
   MITK_TEST(TestIOMetaInformation);
   MITK_TEST(TestUtf8);
+  MITK_TEST(TestLoadConcurrently);
+  MITK_TEST(TestLoadConcurrentlyIntoDataStorage);
+  MITK_TEST(TestLoadConcurrentlyWithInvalidPath);
+  MITK_TEST(TestLoadConcurrentlyReadsSeriesOnce);
   CPPUNIT_TEST_SUITE_END();
 
 private:
@@ -307,6 +369,92 @@ public:
     CPPUNIT_ASSERT(image.IsNotNull());
   }
 
+  void TestLoadConcurrently()
+  {
+    const std::vector<std::string> paths = { m_SurfacePath, m_PointSetPath, m_ImagePath };
+
+    auto sequential = mitk::IOUtil::Load(paths);
+    auto concurrent = mitk::IOUtil::LoadConcurrently(paths, nullptr, 2);
+
+    CPPUNIT_ASSERT_EQUAL(sequential.size(), concurrent.size());
+
+    for (std::size_t i = 0; i < sequential.size(); ++i)
+    {
+      CPPUNIT_ASSERT(concurrent[i].IsNotNull());
+      CPPUNIT_ASSERT_EQUAL(std::string(sequential[i]->GetNameOfClass()), std::string(concurrent[i]->GetNameOfClass()));
+    }
+
+    MITK_ASSERT_EQUAL(dynamic_cast<mitk::Image *>(sequential.back().GetPointer()),
+                      dynamic_cast<mitk::Image *>(concurrent.back().GetPointer()),
+                      "Concurrently loaded image differs from sequentially loaded one");
+  }
+
+  void TestLoadConcurrentlyIntoDataStorage()
+  {
+    const std::vector<std::string> paths = { m_PointSetPath, m_ImagePath, m_SurfacePath };
+
+    auto dataStorage = mitk::StandaloneDataStorage::New();
+    auto nodes = mitk::IOUtil::LoadConcurrently(paths, *dataStorage);
+
+    CPPUNIT_ASSERT_EQUAL(paths.size(), static_cast<std::size_t>(nodes->Size()));
+    CPPUNIT_ASSERT_EQUAL(nodes->Size(), dataStorage->GetAll()->Size());
+
+    CPPUNIT_ASSERT(nullptr != dynamic_cast<mitk::PointSet *>(nodes->GetElement(0)->GetData()));
+    CPPUNIT_ASSERT(nullptr != dynamic_cast<mitk::Image *>(nodes->GetElement(1)->GetData()));
+    CPPUNIT_ASSERT(nullptr != dynamic_cast<mitk::Surface *>(nodes->GetElement(2)->GetData()));
+
+    for (auto iter = nodes->Begin(); iter != nodes->End(); ++iter)
+      CPPUNIT_ASSERT(dataStorage->Exists(iter->Value()));
+  }
+
+  void TestLoadConcurrentlyWithInvalidPath()
+  {
+    const std::vector<std::string> paths = { m_PointSetPath, "/no/such/file.nrrd" };
+
+    CPPUNIT_ASSERT_THROW(mitk::IOUtil::LoadConcurrently(paths), mitk::Exception);
+
+    // Successfully read files are added although the exception is thrown
+    auto dataStorage = mitk::StandaloneDataStorage::New();
+    CPPUNIT_ASSERT_THROW(mitk::IOUtil::LoadConcurrently(paths, *dataStorage), mitk::Exception);
+    CPPUNIT_ASSERT_EQUAL(1u, dataStorage->GetAll()->Size());
+  }
+
+  void TestLoadConcurrentlyReadsSeriesOnce()
+  {
+    SeriesReader reader;
+    const std::string tmpDir = mitk::IOUtil::CreateTemporaryDirectory();
+
+    std::vector<std::string> paths;
+    for (int i = 0; i < 6; ++i)
+    {
+      paths.push_back(tmpDir + "/file" + std::to_string(i) + ".iotestseries");
+      std::ofstream file(paths.back());
+      file << i;
+    }
+
+    // All files form one series
+    g_Series = { paths };
+    g_NumberOfSeriesReads = 0;
+    auto series = mitk::IOUtil::LoadConcurrently(paths, nullptr, 4);
+    CPPUNIT_ASSERT_EQUAL(1, g_NumberOfSeriesReads.load());
+    CPPUNIT_ASSERT_EQUAL(mitk::IOUtil::Load(paths).size(), series.size());
+
+    // Two series of three files
+    g_Series = { { paths[0], paths[1], paths[2] }, { paths[3], paths[4], paths[5] } };
+    g_NumberOfSeriesReads = 0;
+    auto dataStorage = mitk::StandaloneDataStorage::New();
+    mitk::IOUtil::LoadConcurrently(paths, *dataStorage, nullptr, 4);
+    CPPUNIT_ASSERT_EQUAL(2, g_NumberOfSeriesReads.load());
+    CPPUNIT_ASSERT_EQUAL(2u, dataStorage->GetAll()->Size());
+
+    // Files that are read on their own
+    g_Series.clear();
+    g_NumberOfSeriesReads = 0;
+    CPPUNIT_ASSERT_EQUAL(paths.size(), mitk::IOUtil::LoadConcurrently(paths, nullptr, 4).size());
+    CPPUNIT_ASSERT_EQUAL(static_cast<int>(paths.size()), g_NumberOfSeriesReads.load());
+
+    itksys::SystemTools::RemoveADirectory(tmpDir);
+  }
 };
 
 MITK_TEST_SUITE_REGISTRATION(mitkIOUtil)
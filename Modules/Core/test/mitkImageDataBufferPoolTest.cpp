@@ -0,0 +1,197 @@
+/*============================================================================
+
+The Medical Imaging Interaction Toolkit (MITK)
+
+Copyright (c) German Cancer Research Center (DKFZ)
+All rights reserved.
+
+Use of this source code is governed by a 3-clause BSD license that can be
+found in the LICENSE file.
+
+============================================================================*/
+
+#include <mitkImage.h>
+#include <mitkImageDataBufferPool.h>
+#include <mitkImageWriteAccessor.h>
+
+#include <mitkTestFixture.h>
+#include <mitkTestingMacros.h>
+
+#include <cstring>
+#include <vector>
+
+class mitkImageDataBufferPoolTestSuite : public mitk::TestFixture
+{
+  CPPUNIT_TEST_SUITE(mitkImageDataBufferPoolTestSuite);
+
+  MITK_TEST(SizeClasses);
+  MITK_TEST(ReleasedBuffersAreReused);
+  MITK_TEST(MaximumResidentSize);
+  MITK_TEST(Allocate_NotPoolable_ExactSize);
+  MITK_TEST(Image_RepeatedSlicesAreServedFromPool);
+  MITK_TEST(Image_UnpooledBufferIsNotReleasedToPool);
+
+  CPPUNIT_TEST_SUITE_END();
+
+  mitk::ImageDataBufferPool *m_Pool;
+  std::size_t m_MaximumResidentSize;
+
+public:
+  void setUp() override
+  {
+    m_Pool = mitk::ImageDataBufferPool::GetInstance();
+    m_MaximumResidentSize = m_Pool->GetMaximumResidentSize();
+    m_Pool->Clear();
+    m_Pool->ResetStatistics();
+  }
+
+  void tearDown() override
+  {
+    m_Pool->SetMaximumResidentSize(m_MaximumResidentSize);
+    m_Pool->Clear();
+  }
+
+  void SizeClasses()
+  {
+    CPPUNIT_ASSERT_EQUAL(std::size_t(64), mitk::ImageDataBufferPool::GetSizeClass(0));
+    CPPUNIT_ASSERT_EQUAL(std::size_t(64), mitk::ImageDataBufferPool::GetSizeClass(64));
+    CPPUNIT_ASSERT_EQUAL(std::size_t(80), mitk::ImageDataBufferPool::GetSizeClass(65));
+    CPPUNIT_ASSERT_EQUAL(std::size_t(128), mitk::ImageDataBufferPool::GetSizeClass(128));
+    CPPUNIT_ASSERT_EQUAL(std::size_t(160), mitk::ImageDataBufferPool::GetSizeClass(129));
+    CPPUNIT_ASSERT_EQUAL(std::size_t(512 * 512 * 2), mitk::ImageDataBufferPool::GetSizeClass(512 * 512 * 2));
+
+    for (std::size_t size = 1; size < 100000; size += 37)
+    {
+      const auto sizeClass = mitk::ImageDataBufferPool::GetSizeClass(size);
+      CPPUNIT_ASSERT(sizeClass >= size);
+      CPPUNIT_ASSERT(size <= 64 || sizeClass < size + size / 4 + 1);
+    }
+  }
+
+  void ReleasedBuffersAreReused()
+  {
+    bool pooled = false;
+    auto *buffer = m_Pool->Allocate(1000, pooled);
+    CPPUNIT_ASSERT(pooled);
+    std::memset(buffer, 1, 1000);
+    m_Pool->Release(buffer, 1000);
+
+    auto statistics = m_Pool->GetStatistics();
+    CPPUNIT_ASSERT_EQUAL(itk::SizeValueType(1), statistics.Requests);
+    CPPUNIT_ASSERT_EQUAL(itk::SizeValueType(0), statistics.Hits);
+    CPPUNIT_ASSERT_EQUAL(mitk::ImageDataBufferPool::GetSizeClass(1000), statistics.ResidentSize);
+    CPPUNIT_ASSERT_EQUAL(std::size_t(1), statistics.ResidentBuffers);
+
+    // Same size class
+    auto *reused = m_Pool->Allocate(990, pooled);
+    CPPUNIT_ASSERT(buffer == reused);
+    CPPUNIT_ASSERT(pooled);
+
+    // Other size class
+    auto *other = m_Pool->Allocate(5000, pooled);
+    CPPUNIT_ASSERT(buffer != other);
+
+    statistics = m_Pool->GetStatistics();
+    CPPUNIT_ASSERT_EQUAL(itk::SizeValueType(3), statistics.Requests);
+    CPPUNIT_ASSERT_EQUAL(itk::SizeValueType(1), statistics.Hits);
+    CPPUNIT_ASSERT_EQUAL(std::size_t(0), statistics.ResidentSize);
+    CPPUNIT_ASSERT_DOUBLES_EQUAL(1.0 / 3.0, statistics.GetHitRate(), 1e-9);
+
+    m_Pool->Release(reused, 990);
+    m_Pool->Release(other, 5000);
+    CPPUNIT_ASSERT_EQUAL(std::size_t(2), m_Pool->GetStatistics().ResidentBuffers);
+
+    m_Pool->Clear();
+    CPPUNIT_ASSERT_EQUAL(std::size_t(0), m_Pool->GetStatistics().ResidentSize);
+    CPPUNIT_ASSERT_EQUAL(std::size_t(0), m_Pool->GetStatistics().ResidentBuffers);
+  }
+
+  void MaximumResidentSize()
+  {
+    m_Pool->SetMaximumResidentSize(4096);
+
+    bool pooled = false;
+    std::vector<unsigned char *> buffers;
+    for (int i = 0; i < 20; ++i)
+    {
+      buffers.push_back(m_Pool->Allocate(256, pooled));
+      CPPUNIT_ASSERT(pooled);
+    }
+
+    for (auto *buffer : buffers)
+      m_Pool->Release(buffer, 256);
+
+    CPPUNIT_ASSERT_EQUAL(std::size_t(4096), m_Pool->GetStatistics().ResidentSize);
+
+    m_Pool->SetMaximumResidentSize(2048);
+    CPPUNIT_ASSERT_EQUAL(std::size_t(2048), m_Pool->GetStatistics().ResidentSize);
+
+    m_Pool->SetMaximumResidentSize(0);
+    CPPUNIT_ASSERT_EQUAL(std::size_t(0), m_Pool->GetStatistics().ResidentSize);
+  }
+
+  void Allocate_NotPoolable_ExactSize()
+  {
+    m_Pool->SetMaximumResidentSize(4096);
+
+    // Larger than a quarter of the maximum resident size
+    bool pooled = true;
+    auto *buffer = m_Pool->Allocate(1030, pooled);
+    CPPUNIT_ASSERT(!pooled);
+    delete[] buffer;
+
+    // Disabled pool
+    m_Pool->SetMaximumResidentSize(0);
+    pooled = true;
+    buffer = m_Pool->Allocate(65, pooled);
+    CPPUNIT_ASSERT(!pooled);
+    delete[] buffer;
+
+    CPPUNIT_ASSERT_EQUAL(std::size_t(0), m_Pool->GetStatistics().ResidentBuffers);
+  }
+
+  void Image_RepeatedSlicesAreServedFromPool()
+  {
+    unsigned int dimensions[] = { 256, 256 };
+    const int numberOfSlices = 100;
+
+    for (int i = 0; i < numberOfSlices; ++i)
+    {
+      auto slice = mitk::Image::New();
+      slice->Initialize(mitk::MakeScalarPixelType<short>(), 2, dimensions);
+
+      mitk::ImageWriteAccessor accessor(slice);
+      static_cast<short *>(accessor.GetData())[256 * 256 - 1] = static_cast<short>(i);
+    }
+
+    const auto statistics = m_Pool->GetStatistics();
+
+    // Only the first slice needs memory of the system allocator
+    CPPUNIT_ASSERT(statistics.Requests >= static_cast<itk::SizeValueType>(numberOfSlices));
+    CPPUNIT_ASSERT_EQUAL(statistics.Requests - 1, statistics.Hits);
+    CPPUNIT_ASSERT(statistics.ResidentSize >= 256 * 256 * sizeof(short));
+  }
+
+  void Image_UnpooledBufferIsNotReleasedToPool()
+  {
+    unsigned int dimensions[] = { 33, 33 };
+
+    // The buffer of the slice is allocated with its exact size while the pool is disabled
+    m_Pool->SetMaximumResidentSize(0);
+
+    auto slice = mitk::Image::New();
+    slice->Initialize(mitk::MakeScalarPixelType<char>(), 2, dimensions);
+    {
+      mitk::ImageWriteAccessor accessor(slice);
+      std::memset(accessor.GetData(), 1, 33 * 33);
+    }
+
+    m_Pool->SetMaximumResidentSize(m_MaximumResidentSize);
+    slice = nullptr;
+
+    // A buffer smaller than its size class would be handed out for requests of the whole class
+    CPPUNIT_ASSERT_EQUAL(std::size_t(0), m_Pool->GetStatistics().ResidentBuffers);
+  }
+};
+
+MITK_TEST_SUITE_REGISTRATION(mitkImageDataBufferPool)
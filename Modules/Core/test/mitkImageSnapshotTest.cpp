@@ -0,0 +1,264 @@
+/*============================================================================
+
+The Medical Imaging Interaction Toolkit (MITK)
+
+Copyright (c) German Cancer Research Center (DKFZ)
+All rights reserved.
+
+Use of this source code is governed by a 3-clause BSD license that can be
+found in the LICENSE file.
+
+============================================================================*/
+
+#include <mitkImageGenerator.h>
+#include <mitkImageReadAccessor.h>
+#include <mitkImageSnapshot.h>
+#include <mitkImageToItk.h>
+#include <mitkImageWriteAccessor.h>
+
+#include <mitkTestFixture.h>
+#include <mitkTestingMacros.h>
+
+#include <vtkImageData.h>
+
+#include <algorithm>
+#include <cstring>
+#include <thread>
+#include <vector>
+
+class mitkImageSnapshotTestSuite : public mitk::TestFixture
+{
+  CPPUNIT_TEST_SUITE(mitkImageSnapshotTestSuite);
+
+  MITK_TEST(Snapshot_EqualsData);
+  MITK_TEST(Snapshot_SharesImageData);
+  MITK_TEST(Snapshot_SharedUntilChanged);
+  MITK_TEST(Snapshot_Released_WritesInPlace);
+  MITK_TEST(Snapshot_DoesNotBlockWriters);
+  MITK_TEST(Snapshot_Modified);
+  MITK_TEST(Snapshot_Empty);
+  MITK_TEST(Snapshot_ConcurrentReadsShareData);
+  MITK_TEST(Snapshot_VtkImageData_ViewsData);
+  MITK_TEST(Snapshot_ItkImage_ViewsData);
+
+  CPPUNIT_TEST_SUITE_END();
+
+  mitk::Image::Pointer m_Image;
+
+  bool EqualsImageData(const mitk::ImageSnapshot &snapshot) const
+  {
+    mitk::ImageReadAccessor accessor(m_Image);
+    return snapshot.GetSize() == sizeof(int) * 32 * 32 * 16 &&
+           0 == std::memcmp(snapshot.GetData(), accessor.GetData(), snapshot.GetSize());
+  }
+
+  void SetFirstPixel(int value)
+  {
+    mitk::ImageWriteAccessor accessor(m_Image);
+    *static_cast<int *>(accessor.GetData()) = value;
+  }
+
+  static int GetFirstPixel(const mitk::ImageSnapshot &snapshot)
+  {
+    return *static_cast<const int *>(snapshot.GetData());
+  }
+
+  const void *GetImageData() const
+  {
+    mitk::ImageReadAccessor accessor(m_Image);
+    return accessor.GetData();
+  }
+
+public:
+  void setUp() override
+  {
+    m_Image = mitk::ImageGenerator::GenerateGradientImage<int>(32, 32, 16);
+    this->SetFirstPixel(1);
+  }
+
+  void tearDown() override
+  {
+    m_Image = nullptr;
+  }
+
+  void Snapshot_EqualsData()
+  {
+    mitk::ImageSnapshot snapshot(m_Image);
+
+    CPPUNIT_ASSERT(!snapshot.IsNull());
+    CPPUNIT_ASSERT(this->EqualsImageData(snapshot));
+    CPPUNIT_ASSERT(m_Image->GetPixelType() == snapshot.GetPixelType());
+    CPPUNIT_ASSERT_EQUAL(3u, snapshot.GetDimension());
+    CPPUNIT_ASSERT_EQUAL(32u, snapshot.GetDimension(0));
+    CPPUNIT_ASSERT_EQUAL(16u, snapshot.GetDimension(2));
+    CPPUNIT_ASSERT(snapshot.GetData() == snapshot.GetVolumeData(0));
+    CPPUNIT_ASSERT_THROW(snapshot.GetVolumeData(1), mitk::Exception);
+  }
+
+  void Snapshot_SharesImageData()
+  {
+    mitk::ImageSnapshot snapshot(m_Image);
+
+    // The snapshot views the memory of the image instead of copying it
+    CPPUNIT_ASSERT(snapshot.GetData() == this->GetImageData());
+  }
+
+  void Snapshot_SharedUntilChanged()
+  {
+    mitk::ImageSnapshot first(m_Image);
+    mitk::ImageSnapshot second(m_Image);
+
+    // Snapshots of the same data version share the memory of the image
+    CPPUNIT_ASSERT(first.GetData() == second.GetData());
+
+    // The writer copies the data, because it is still referenced by the snapshots
+    this->SetFirstPixel(2);
+
+    mitk::ImageSnapshot third(m_Image);
+
+    CPPUNIT_ASSERT(first.GetData() != this->GetImageData());
+    CPPUNIT_ASSERT(third.GetData() == this->GetImageData());
+    CPPUNIT_ASSERT_EQUAL(1, GetFirstPixel(first));
+    CPPUNIT_ASSERT_EQUAL(2, GetFirstPixel(third));
+    CPPUNIT_ASSERT(this->EqualsImageData(third));
+  }
+
+  void Snapshot_Released_WritesInPlace()
+  {
+    const void *snapshotData = nullptr;
+    {
+      mitk::ImageSnapshot snapshot(m_Image);
+      snapshotData = snapshot.GetData();
+    }
+
+    // Without referenced snapshots, the data is not copied
+    this->SetFirstPixel(2);
+
+    CPPUNIT_ASSERT(snapshotData == this->GetImageData());
+
+    mitk::ImageSnapshot snapshot(m_Image);
+    CPPUNIT_ASSERT_EQUAL(2, GetFirstPixel(snapshot));
+  }
+
+  void Snapshot_DoesNotBlockWriters()
+  {
+    mitk::ImageSnapshot snapshot(m_Image);
+
+    // Throws if the memory is locked by any reader
+    mitk::ImageWriteAccessor accessor(m_Image, nullptr, mitk::ImageAccessorBase::ExceptionIfLocked);
+    *static_cast<int *>(accessor.GetData()) = 3;
+
+    CPPUNIT_ASSERT(snapshot.GetData() != accessor.GetData());
+    CPPUNIT_ASSERT_EQUAL(1, GetFirstPixel(snapshot));
+  }
+
+  void Snapshot_Modified()
+  {
+    mitk::ImageSnapshot first(m_Image);
+
+    m_Image->Modified();
+
+    mitk::ImageSnapshot second(m_Image);
+
+    // The new data version is not copied either, until a writer changes it
+    CPPUNIT_ASSERT(first.GetData() == second.GetData());
+    CPPUNIT_ASSERT(this->EqualsImageData(second));
+  }
+
+  void Snapshot_Empty()
+  {
+    mitk::ImageSnapshot snapshot;
+
+    CPPUNIT_ASSERT(snapshot.IsNull());
+    CPPUNIT_ASSERT(nullptr == snapshot.GetData());
+    CPPUNIT_ASSERT_EQUAL(std::size_t(0), snapshot.GetSize());
+
+    auto uninitializedImage = mitk::Image::New();
+    CPPUNIT_ASSERT_THROW(mitk::ImageSnapshot{ uninitializedImage.GetPointer() }, mitk::Exception);
+  }
+
+  /** Many threads taking snapshots of the same data version all read the same memory.*/
+  void Snapshot_ConcurrentReadsShareData()
+  {
+    const unsigned int numberOfThreads = std::max(2u, std::thread::hardware_concurrency());
+    const int numberOfReads = 1000;
+
+    mitk::ImageSnapshot snapshot(m_Image);
+    std::vector<int> sharedReads(numberOfThreads, 0);
+    std::vector<std::thread> threads;
+
+    for (unsigned int i = 0; i < numberOfThreads; ++i)
+    {
+      threads.emplace_back([&, i]() {
+        for (int j = 0; j < numberOfReads; ++j)
+        {
+          mitk::ImageSnapshot threadSnapshot(m_Image);
+
+          if (threadSnapshot.GetData() == snapshot.GetData() && 1 == GetFirstPixel(threadSnapshot))
+            ++sharedReads[i];
+        }
+      });
+    }
+
+    for (auto &thread : threads)
+      thread.join();
+
+    for (unsigned int i = 0; i < numberOfThreads; ++i)
+      CPPUNIT_ASSERT_EQUAL_MESSAGE("Reads of thread " + std::to_string(i), numberOfReads, sharedReads[i]);
+  }
+
+  void Snapshot_VtkImageData_ViewsData()
+  {
+    vtkSmartPointer<vtkImageData> vtkImage;
+    const void *snapshotData = nullptr;
+    {
+      mitk::ImageSnapshot snapshot(m_Image);
+      snapshotData = snapshot.GetData();
+      vtkImage = snapshot.GetVtkImageData();
+    }
+
+    // The vtkImageData keeps the data of the released snapshot alive
+    this->SetFirstPixel(2);
+
+    int dimensions[3];
+    vtkImage->GetDimensions(dimensions);
+
+    CPPUNIT_ASSERT(snapshotData == vtkImage->GetScalarPointer());
+    CPPUNIT_ASSERT(snapshotData != this->GetImageData());
+    CPPUNIT_ASSERT_EQUAL(1, *static_cast<int *>(vtkImage->GetScalarPointer()));
+    CPPUNIT_ASSERT_EQUAL(VTK_INT, vtkImage->GetScalarType());
+    CPPUNIT_ASSERT_EQUAL(32, dimensions[0]);
+    CPPUNIT_ASSERT_EQUAL(16, dimensions[2]);
+    CPPUNIT_ASSERT_EQUAL(m_Image->GetGeometry()->GetSpacing()[2], vtkImage->GetSpacing()[2]);
+  }
+
+  void Snapshot_ItkImage_ViewsData()
+  {
+    itk::Image<int, 3>::ConstPointer itkImage;
+    const void *snapshotData = nullptr;
+    {
+      mitk::ImageSnapshot snapshot(m_Image);
+      snapshotData = snapshot.GetData();
+      itkImage = mitk::ImageToItkImage<int, 3>(snapshot);
+
+      CPPUNIT_ASSERT_THROW((mitk::ImageToItkImage<float, 3>(snapshot)), mitk::Exception);
+      CPPUNIT_ASSERT_THROW((mitk::ImageToItkImage<int, 2>(snapshot)), mitk::Exception);
+    }
+
+    // The ITK image keeps the data of the released snapshot alive
+    this->SetFirstPixel(2);
+
+    CPPUNIT_ASSERT(snapshotData == itkImage->GetBufferPointer());
+    CPPUNIT_ASSERT(snapshotData != this->GetImageData());
+    CPPUNIT_ASSERT_EQUAL(1, *itkImage->GetBufferPointer());
+    CPPUNIT_ASSERT_EQUAL(itk::SizeValueType(32 * 32 * 16), itkImage->GetLargestPossibleRegion().GetNumberOfPixels());
+
+    const mitk::Image *image = m_Image;
+    auto itkGeometryImage = mitk::ImageToItkImage<int, 3>(image);
+    CPPUNIT_ASSERT(itkGeometryImage->GetSpacing() == itkImage->GetSpacing());
+    CPPUNIT_ASSERT(itkGeometryImage->GetOrigin() == itkImage->GetOrigin());
+    CPPUNIT_ASSERT(itkGeometryImage->GetDirection() == itkImage->GetDirection());
+  }
+};
+
+MITK_TEST_SUITE_REGISTRATION(mitkImageSnapshot)
@@ -15,6 +15,7 @@ found in the LICENSE file.
 #include "mitkTestingMacros.h"
 
 #include <mitkIOUtil.h>
+#include <mitkImageReadAccessor.h>
 
 bool CompareSurfacePointPositions(mitk::Surface::Pointer s1, mitk::Surface::Pointer s2)
 {
@@ -44,6 +45,7 @@ class mitkImageToSurfaceFilterTestSuite : public mitk::TestFixture
   MITK_TEST(testDecimatePromeshDecimation);
   MITK_TEST(testQuadricDecimation);
   MITK_TEST(testSmoothingOfSurface);
+  MITK_TEST(testTimeStepsIndependentOfNumberOfThreads);
   CPPUNIT_TEST_SUITE_END();
 
 private:
@@ -145,6 +147,51 @@ public:
     CPPUNIT_ASSERT_MESSAGE("Testing smoothing of surface changes point data!",
                            CompareSurfacePointPositions(testSurface1, testSurface4));
   }
+
+  void testTimeStepsIndependentOfNumberOfThreads()
+  {
+    const unsigned int numberOfTimeSteps = 4;
+
+    auto image = mitk::Image::New();
+    image->Initialize(m_BallImage->GetPixelType(), *m_BallImage->GetGeometry(), 1, numberOfTimeSteps);
+
+    mitk::ImageReadAccessor ballAccessor(m_BallImage);
+    for (unsigned int t = 0; t < numberOfTimeSteps; ++t)
+      image->SetVolume(ballAccessor.GetData(), t);
+
+    auto createSurface = [&](unsigned int numberOfThreads) {
+      mitk::ImageToSurfaceFilter::Pointer testObject = mitk::ImageToSurfaceFilter::New();
+      testObject->SetInput(image);
+      testObject->SetSmooth(true);
+      testObject->SetDecimate(mitk::ImageToSurfaceFilter::DecimatePro);
+      testObject->SetTargetReduction(0.5f);
+      testObject->SetNumberOfThreads(numberOfThreads);
+      testObject->Update();
+      return testObject->GetOutput()->Clone();
+    };
+
+    auto sequentialSurface = createSurface(1);
+    auto concurrentSurface = createSurface(numberOfTimeSteps);
+
+    CPPUNIT_ASSERT_EQUAL(numberOfTimeSteps, sequentialSurface->GetTimeSteps());
+    CPPUNIT_ASSERT_EQUAL(numberOfTimeSteps, concurrentSurface->GetTimeSteps());
+
+    for (unsigned int t = 0; t < numberOfTimeSteps; ++t)
+    {
+      auto *sequentialPolyData = sequentialSurface->GetVtkPolyData(t);
+      auto *concurrentPolyData = concurrentSurface->GetVtkPolyData(t);
+
+      CPPUNIT_ASSERT(sequentialPolyData->GetNumberOfPoints() > 0);
+      CPPUNIT_ASSERT_EQUAL(sequentialPolyData->GetNumberOfPoints(), concurrentPolyData->GetNumberOfPoints());
+      CPPUNIT_ASSERT_EQUAL(sequentialPolyData->GetNumberOfCells(), concurrentPolyData->GetNumberOfCells());
+
+      for (vtkIdType i = 0; i < sequentialPolyData->GetNumberOfPoints(); ++i)
+      {
+        for (int j = 0; j < 3; ++j)
+          CPPUNIT_ASSERT_EQUAL(sequentialPolyData->GetPoint(i)[j], concurrentPolyData->GetPoint(i)[j]);
+      }
+    }
+  }
 };
 
 MITK_TEST_SUITE_REGISTRATION(mitkImageToSurfaceFilter)
@@ -18,10 +18,16 @@ found in the LICENSE file.
 #include "mitkIOUtil.h"
 #include <mitkUtf8Util.h>
 #include "mitkITKImageImport.h"
+#include <mitkChunkedGzipCodec.h>
 #include <mitkExtractSliceFilter.h>
+#include <mitkImageReadAccessor.h>
 
 #include "itksys/SystemTools.hxx"
+#include <itkImageFileReader.h>
 #include <itkImageRegionIterator.h>
+#include <itkNrrdImageIO.h>
+
+#include <cstring>
 
 #include <fstream>
 #include <iostream>
@@ -44,6 +50,7 @@ class mitkItkImageIOTestSuite : public mitk::TestFixture
   MITK_TEST(TestWrite3DImageWithTwoPlanes);
   MITK_TEST(TestWrite3DplusT_ArbitraryTG);
   MITK_TEST(TestWrite3DplusT_ProportionalTG);
+  MITK_TEST(TestWriteNrrdParallelCompression);
   CPPUNIT_TEST_SUITE_END();
 
 public:
@@ -423,6 +430,79 @@ public:
     CPPUNIT_ASSERT_THROW(mitk::IOUtil::Save(image, mitk::IOUtil::CreateTemporaryFile("3Dto2DTestImageXXXXXX.png")),
                          mitk::Exception);
   }
+
+  /**
+  * Writes NRRD files with parallel compression (the default) and reads them back with the plain ITK reader,
+  * which has to decompress the chunked gzip stream sequentially.
+  */
+  void TestWriteNrrdParallelCompression()
+  {
+    typedef itk::Image<short, 3> ImageType;
+
+    // more than one chunk of ChunkedGzipCodec::DEFAULT_CHUNK_SIZE
+    ImageType::SizeType size;
+    size[0] = 160;
+    size[1] = 128;
+    size[2] = 120;
+
+    ImageType::Pointer itkImage = ImageType::New();
+    itkImage->SetRegions(ImageType::RegionType(size));
+    itkImage->Allocate();
+
+    for (itk::ImageRegionIterator<ImageType> iter(itkImage, itkImage->GetLargestPossibleRegion()); !iter.IsAtEnd(); ++iter)
+    {
+      const auto index = iter.GetIndex();
+      iter.Set(static_cast<short>((index[0] * index[1] + 7 * index[2]) % 1013 - 500));
+    }
+
+    mitk::Image::Pointer image = mitk::ImportItkImage(itkImage)->Clone();
+    const std::size_t imageBytes = size[0] * size[1] * size[2] * sizeof(short);
+    CPPUNIT_ASSERT(imageBytes > mitk::ChunkedGzipCodec::DEFAULT_CHUNK_SIZE);
+
+    const std::string tempDir = mitk::IOUtil::CreateTemporaryDirectory("ParallelCompressionTest_XXXXXX");
+
+    for (const std::string compression : { "", "Fast", "Best" })
+    {
+      const std::string path = tempDir + "/image" + compression + ".nrrd";
+
+      if (compression.empty())
+      {
+        mitk::IOUtil::Save(image, path);
+      }
+      else
+      {
+        mitk::IFileWriter::Options options;
+        options["advanced.Compression"] = compression;
+        mitk::IOUtil::Save(image, path, options);
+      }
+
+      {
+        std::ifstream file(path, std::ios::binary);
+        std::string line;
+        bool gzipEncoding = false;
+
+        while (std::getline(file, line) && !line.empty())
+          gzipEncoding = gzipEncoding || "encoding: gzip" == line;
+
+        CPPUNIT_ASSERT_MESSAGE("NRRD header has gzip encoding", gzipEncoding);
+        CPPUNIT_ASSERT_MESSAGE("NRRD data is chunked", mitk::ChunkedGzipCodec::IsChunked(file));
+      }
+
+      auto reader = itk::ImageFileReader<ImageType>::New();
+      reader->SetImageIO(itk::NrrdImageIO::New());
+      reader->SetFileName(path);
+      reader->Update();
+      ImageType::Pointer readImage = reader->GetOutput();
+
+      CPPUNIT_ASSERT(size == readImage->GetLargestPossibleRegion().GetSize());
+
+      mitk::ImageReadAccessor accessor(image);
+      CPPUNIT_ASSERT_MESSAGE("ITK reads the pixel data written with compression '" + compression + "'",
+                             0 == std::memcmp(accessor.GetData(), readImage->GetBufferPointer(), imageBytes));
+    }
+
+    itksys::SystemTools::RemoveADirectory(tempDir);
+  }
 };
 
 MITK_TEST_SUITE_REGISTRATION(mitkItkImageIO)
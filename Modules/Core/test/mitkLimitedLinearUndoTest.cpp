@@ -0,0 +1,133 @@
+/*============================================================================
+
+The Medical Imaging Interaction Toolkit (MITK)
+
+Copyright (c) German Cancer Research Center (DKFZ)
+All rights reserved.
+
+Use of this source code is governed by a 3-clause BSD license that can be
+found in the LICENSE file.
+
+============================================================================*/
+
+#include <mitkInteractionConst.h>
+#include <mitkLimitedLinearUndo.h>
+#include <mitkOperation.h>
+#include <mitkOperationEvent.h>
+#include <mitkUndoController.h>
+
+#include <mitkTestFixture.h>
+#include <mitkTestingMacros.h>
+
+namespace
+{
+  int g_LivingOperations = 0;
+
+  class SizedTestOperation : public mitk::Operation
+  {
+  public:
+    SizedTestOperation(std::size_t memorySize) : Operation(mitk::OpTEST), m_MemorySize(memorySize) { ++g_LivingOperations; }
+    ~SizedTestOperation() override { --g_LivingOperations; }
+
+    std::size_t GetMemorySize() const override { return m_MemorySize; }
+
+  private:
+    std::size_t m_MemorySize;
+  };
+}
+
+class mitkLimitedLinearUndoTestSuite : public mitk::TestFixture
+{
+  CPPUNIT_TEST_SUITE(mitkLimitedLinearUndoTestSuite);
+  MITK_TEST(MemorySize_SumOfOperations);
+  MITK_TEST(SetOperationEvent_EvictsOldestItems);
+  MITK_TEST(SetMemoryLimit_EvictsOldestItems);
+  MITK_TEST(SetMemoryLimit_NewestItemIsKept);
+  MITK_TEST(UndoController_SetsDefaultMemoryLimit);
+  CPPUNIT_TEST_SUITE_END();
+
+  mitk::LimitedLinearUndo::Pointer m_Undo;
+
+  void AddItem(std::size_t doSize, std::size_t undoSize)
+  {
+    m_Undo->SetOperationEvent(
+      new mitk::OperationEvent(nullptr, new SizedTestOperation(doSize), new SizedTestOperation(undoSize), "Test"));
+    mitk::OperationEvent::IncCurrObjectEventId();
+    mitk::OperationEvent::IncCurrGroupEventId();
+  }
+
+public:
+  void setUp() override
+  {
+    g_LivingOperations = 0;
+    m_Undo = mitk::LimitedLinearUndo::New();
+  }
+
+  void tearDown() override
+  {
+    m_Undo = nullptr;
+    CPPUNIT_ASSERT_EQUAL_MESSAGE("All operations are deleted with the undo model", 0, g_LivingOperations);
+  }
+
+  void MemorySize_SumOfOperations()
+  {
+    CPPUNIT_ASSERT_EQUAL(std::size_t(0), m_Undo->GetMemoryLimit());
+
+    this->AddItem(100, 50);
+    this->AddItem(0, 30);
+    CPPUNIT_ASSERT_EQUAL(std::size_t(180), m_Undo->GetMemorySize());
+  }
+
+  void SetOperationEvent_EvictsOldestItems()
+  {
+    m_Undo->SetMemoryLimit(1000);
+
+    for (int i = 0; i < 10; ++i)
+      this->AddItem(100, 100);
+
+    // five items of 200 bytes fit into the limit
+    CPPUNIT_ASSERT_EQUAL(std::size_t(1000), m_Undo->GetMemorySize());
+    CPPUNIT_ASSERT_EQUAL(10, g_LivingOperations);
+
+    this->AddItem(300, 0);
+    CPPUNIT_ASSERT_EQUAL(std::size_t(900), m_Undo->GetMemorySize());
+    CPPUNIT_ASSERT_EQUAL(8, g_LivingOperations);
+  }
+
+  void SetMemoryLimit_EvictsOldestItems()
+  {
+    for (int i = 0; i < 10; ++i)
+      this->AddItem(100, 100);
+    CPPUNIT_ASSERT_EQUAL(std::size_t(2000), m_Undo->GetMemorySize());
+
+    m_Undo->SetMemoryLimit(700);
+    CPPUNIT_ASSERT_EQUAL(std::size_t(700), m_Undo->GetMemoryLimit());
+    CPPUNIT_ASSERT_EQUAL(std::size_t(600), m_Undo->GetMemorySize());
+    CPPUNIT_ASSERT_EQUAL(6, g_LivingOperations);
+
+    // removing the limit does not bring anything back, but allows the history to grow again
+    m_Undo->SetMemoryLimit(0);
+    this->AddItem(1000, 1000);
+    CPPUNIT_ASSERT_EQUAL(std::size_t(2600), m_Undo->GetMemorySize());
+  }
+
+  void SetMemoryLimit_NewestItemIsKept()
+  {
+    m_Undo->SetMemoryLimit(100);
+
+    this->AddItem(10, 10);
+    this->AddItem(500, 500);
+
+    CPPUNIT_ASSERT_EQUAL(std::size_t(1000), m_Undo->GetMemorySize());
+    CPPUNIT_ASSERT_EQUAL(2, g_LivingOperations);
+  }
+
+  void UndoController_SetsDefaultMemoryLimit()
+  {
+    mitk::UndoController undoController;
+    CPPUNIT_ASSERT(nullptr != mitk::UndoController::GetCurrentUndoModel());
+    CPPUNIT_ASSERT_EQUAL(mitk::UndoController::DEFAULTMEMORYLIMIT, mitk::UndoController::GetCurrentUndoModel()->GetMemoryLimit());
+  }
+};
+
+MITK_TEST_SUITE_REGISTRATION(mitkLimitedLinearUndo)
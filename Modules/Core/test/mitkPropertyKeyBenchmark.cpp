@@ -0,0 +1,128 @@
+/*============================================================================
+
+The Medical Imaging Interaction Toolkit (MITK)
+
+Copyright (c) German Cancer Research Center (DKFZ)
+All rights reserved.
+
+Use of this source code is governed by a 3-clause BSD license that can be
+found in the LICENSE file.
+
+============================================================================*/
+
+#include <mitkColorProperty.h>
+#include <mitkDataNode.h>
+#include <mitkLevelWindowProperty.h>
+#include <mitkPointSet.h>
+#include <mitkProperties.h>
+#include <mitkPropertyKey.h>
+
+#include <mitkTestFixture.h>
+#include <mitkTestingMacros.h>
+
+#include <itkTimeProbe.h>
+
+#include <string>
+#include <vector>
+
+/** Compares the property reads of a mapper for every rendered frame by generic string lookups
+  and by the accessors that use interned keys.
+  Not run by CTest; call the test driver with mitkPropertyKeyBenchmark to run it.*/
+class mitkPropertyKeyBenchmarkSuite : public mitk::TestFixture
+{
+  CPPUNIT_TEST_SUITE(mitkPropertyKeyBenchmarkSuite);
+  MITK_TEST(MapperPropertyReads);
+  CPPUNIT_TEST_SUITE_END();
+
+private:
+  /** Creates a node with the properties a mapper typically finds on it.*/
+  static mitk::DataNode::Pointer CreateRenderedNode(int index)
+  {
+    auto node = mitk::DataNode::New();
+    node->SetData(mitk::PointSet::New());
+    node->SetName("node" + std::to_string(index));
+    node->SetVisibility(true);
+    node->SetOpacity(0.5f);
+    node->SetColor(1.0f, 0.0f, 0.0f);
+    node->SetIntProperty("layer", index % 10);
+    node->SetProperty("levelwindow", mitk::LevelWindowProperty::New());
+    node->SetBoolProperty("binary", false);
+    node->SetBoolProperty("helper object", false);
+    node->SetBoolProperty("includeInBoundingBox", true);
+    node->SetFloatProperty("pointsize", 1.0f);
+    node->SetFloatProperty("line width", 1.0f);
+    node->SetIntProperty("selected", 0);
+    node->SetStringProperty("label", "label");
+    node->SetBoolProperty("show contour", false);
+    node->SetBoolProperty("show points", true);
+    node->SetBoolProperty("show distances", false);
+    node->SetBoolProperty("show angles", false);
+    node->SetBoolProperty("updateDataOnRender", true);
+    return node;
+  }
+
+public:
+  void MapperPropertyReads()
+  {
+    const int numberOfNodes = 100;
+    const int numberOfFrames = 1000;
+
+    std::vector<mitk::DataNode::Pointer> nodes;
+    for (int i = 0; i < numberOfNodes; ++i)
+      nodes.push_back(CreateRenderedNode(i));
+
+    itk::TimeProbe stringProbe;
+    itk::TimeProbe keyProbe;
+    int stringChecksum = 0;
+    int keyChecksum = 0;
+
+    // The generic lookup that the accessors used before they took interned keys
+    stringProbe.Start();
+    for (int frame = 0; frame < numberOfFrames; ++frame)
+    {
+      for (const auto &node : nodes)
+      {
+        auto visible = dynamic_cast<mitk::BoolProperty *>(node->GetProperty("visible"));
+        auto opacity = dynamic_cast<mitk::FloatProperty *>(node->GetProperty("opacity"));
+        auto color = dynamic_cast<mitk::ColorProperty *>(node->GetProperty("color"));
+        auto layer = dynamic_cast<mitk::IntProperty *>(node->GetProperty("layer"));
+        auto levelWindow = dynamic_cast<mitk::LevelWindowProperty *>(node->GetProperty("levelwindow"));
+
+        CPPUNIT_ASSERT(nullptr != levelWindow);
+        stringChecksum += visible->GetValue() + layer->GetValue() +
+                          static_cast<int>(opacity->GetValue() * 2 + color->GetColor()[0]);
+      }
+    }
+    stringProbe.Stop();
+
+    keyProbe.Start();
+    for (int frame = 0; frame < numberOfFrames; ++frame)
+    {
+      for (const auto &node : nodes)
+      {
+        bool visible = true;
+        float opacity = 1.0f;
+        float rgb[3] = { 1.0f, 1.0f, 1.0f };
+        int layer = 0;
+        mitk::LevelWindow levelWindow;
+
+        node->GetVisibility(visible, nullptr);
+        node->GetOpacity(opacity, nullptr);
+        node->GetColor(rgb);
+        node->GetIntProperty(mitk::PropertyKeys::Layer(), layer);
+        CPPUNIT_ASSERT(node->GetLevelWindow(levelWindow));
+
+        keyChecksum += visible + layer + static_cast<int>(opacity * 2 + rgb[0]);
+      }
+    }
+    keyProbe.Stop();
+
+    CPPUNIT_ASSERT_EQUAL(stringChecksum, keyChecksum);
+
+    MITK_INFO << "Property reads of " << numberOfNodes << " nodes in " << numberOfFrames
+              << " frames. String keys: " << stringProbe.GetTotal() << " s; Interned keys: " << keyProbe.GetTotal()
+              << " s";
+  }
+};
+
+MITK_TEST_SUITE_REGISTRATION(mitkPropertyKeyBenchmark)
@@ -0,0 +1,196 @@
+/*============================================================================
+
+The Medical Imaging Interaction Toolkit (MITK)
+
+Copyright (c) German Cancer Research Center (DKFZ)
+All rights reserved.
+
+Use of this source code is governed by a 3-clause BSD license that can be
+found in the LICENSE file.
+
+============================================================================*/
+
+#include <mitkColorProperty.h>
+#include <mitkDataNode.h>
+#include <mitkLevelWindowProperty.h>
+#include <mitkPointSet.h>
+#include <mitkProperties.h>
+#include <mitkPropertyKey.h>
+#include <mitkPropertyList.h>
+#include <mitkStringProperty.h>
+
+#include <mitkTestFixture.h>
+#include <mitkTestingMacros.h>
+
+#include <string>
+#include <vector>
+
+class mitkPropertyKeyTestSuite : public mitk::TestFixture
+{
+  CPPUNIT_TEST_SUITE(mitkPropertyKeyTestSuite);
+
+  MITK_TEST(Interning);
+  MITK_TEST(PropertyList_LookupFollowsModifications);
+  MITK_TEST(PropertyList_TypedLookup);
+  MITK_TEST(PropertyList_Clone);
+  MITK_TEST(DataNode_Lookup);
+
+  CPPUNIT_TEST_SUITE_END();
+
+  /** Checks that the lookups by string and by interned key agree for all passed keys.*/
+  static void AssertConsistent(const mitk::PropertyList *propertyList, const std::vector<std::string> &keys)
+  {
+    for (const auto &key : keys)
+      CPPUNIT_ASSERT_MESSAGE(key, propertyList->GetProperty(key) == propertyList->GetProperty(mitk::PropertyKey(key)));
+  }
+
+public:
+  void Interning()
+  {
+    mitk::PropertyKey a("visible");
+    mitk::PropertyKey b(std::string("visible"));
+    mitk::PropertyKey c("opacity");
+
+    CPPUNIT_ASSERT(a == b);
+    CPPUNIT_ASSERT(a != c);
+    CPPUNIT_ASSERT(a == mitk::PropertyKeys::Visible());
+    CPPUNIT_ASSERT(&a.GetString() == &b.GetString());
+    CPPUNIT_ASSERT_EQUAL(std::string("visible"), a.GetString());
+    CPPUNIT_ASSERT_EQUAL(a.GetHash(), b.GetHash());
+  }
+
+  void PropertyList_LookupFollowsModifications()
+  {
+    auto propertyList = mitk::PropertyList::New();
+    std::vector<std::string> keys;
+
+    for (int i = 0; i < 200; ++i)
+    {
+      keys.push_back("key" + std::to_string(i));
+      propertyList->SetIntProperty(keys.back().c_str(), i);
+    }
+
+    AssertConsistent(propertyList, keys);
+
+    for (int i = 0; i < 200; i += 3)
+      propertyList->RemoveProperty(keys[i]);
+
+    for (int i = 1; i < 200; i += 7)
+      propertyList->DeleteProperty(keys[i]);
+
+    AssertConsistent(propertyList, keys);
+
+    for (int i = 0; i < 200; i += 5)
+      propertyList->ReplaceProperty(keys[i], mitk::StringProperty::New(keys[i]));
+
+    AssertConsistent(propertyList, keys);
+    CPPUNIT_ASSERT(nullptr != dynamic_cast<mitk::StringProperty *>(propertyList->GetProperty(mitk::PropertyKey("key5"))));
+    CPPUNIT_ASSERT(nullptr == propertyList->GetProperty(mitk::PropertyKey("key3")));
+
+    propertyList->Clear();
+    AssertConsistent(propertyList, keys);
+
+    propertyList->SetBoolProperty("key0", true);
+    AssertConsistent(propertyList, keys);
+  }
+
+  void PropertyList_TypedLookup()
+  {
+    auto propertyList = mitk::PropertyList::New();
+    propertyList->SetBoolProperty("visible", false);
+    propertyList->SetFloatProperty("opacity", 0.25f);
+    propertyList->SetIntProperty("layer", 3);
+
+    bool visible = true;
+    CPPUNIT_ASSERT(propertyList->GetBoolProperty(mitk::PropertyKeys::Visible(), visible));
+    CPPUNIT_ASSERT(!visible);
+
+    float opacity = 0.0f;
+    CPPUNIT_ASSERT(propertyList->GetFloatProperty(mitk::PropertyKeys::Opacity(), opacity));
+    CPPUNIT_ASSERT_EQUAL(0.25f, opacity);
+
+    int layer = 0;
+    CPPUNIT_ASSERT(propertyList->GetIntProperty(mitk::PropertyKeys::Layer(), layer));
+    CPPUNIT_ASSERT_EQUAL(3, layer);
+
+    // Wrong type
+    CPPUNIT_ASSERT(!propertyList->GetIntProperty(mitk::PropertyKeys::Opacity(), layer));
+    CPPUNIT_ASSERT(nullptr == propertyList->GetTypedProperty<mitk::StringProperty>(mitk::PropertyKeys::Visible()));
+
+    // Casts to base classes still work
+    CPPUNIT_ASSERT(nullptr != propertyList->GetTypedProperty<mitk::BaseProperty>(mitk::PropertyKeys::Visible()));
+
+    // Value changes of existing properties are visible through the interned key
+    propertyList->SetBoolProperty("visible", true);
+    CPPUNIT_ASSERT(propertyList->GetBoolProperty(mitk::PropertyKeys::Visible(), visible));
+    CPPUNIT_ASSERT(visible);
+  }
+
+  void PropertyList_Clone()
+  {
+    auto propertyList = mitk::PropertyList::New();
+    propertyList->SetBoolProperty("visible", true);
+
+    auto clone = propertyList->Clone();
+    auto property = clone->GetProperty(mitk::PropertyKeys::Visible());
+
+    CPPUNIT_ASSERT(nullptr != property);
+    CPPUNIT_ASSERT(property == clone->GetProperty("visible"));
+    CPPUNIT_ASSERT(property != propertyList->GetProperty("visible"));
+  }
+
+  void DataNode_Lookup()
+  {
+    auto node = mitk::DataNode::New();
+    auto pointSet = mitk::PointSet::New();
+    node->SetData(pointSet);
+
+    CPPUNIT_ASSERT(node->IsVisible(nullptr));
+    node->SetVisibility(false);
+    CPPUNIT_ASSERT(!node->IsVisible(nullptr));
+
+    bool visible = true;
+    CPPUNIT_ASSERT(node->GetVisibility(visible, nullptr));
+    CPPUNIT_ASSERT(!visible);
+
+    node->SetOpacity(0.75f);
+    float opacity = 0.0f;
+    CPPUNIT_ASSERT(node->GetOpacity(opacity, nullptr));
+    CPPUNIT_ASSERT_EQUAL(0.75f, opacity);
+
+    node->SetColor(0.0f, 1.0f, 0.0f);
+    float rgb[3] = { 0.0f, 0.0f, 0.0f };
+    CPPUNIT_ASSERT(node->GetColor(rgb));
+    CPPUNIT_ASSERT_EQUAL(1.0f, rgb[1]);
+
+    mitk::LevelWindow levelWindow;
+    CPPUNIT_ASSERT(!node->GetLevelWindow(levelWindow));
+    node->SetProperty("levelwindow", mitk::LevelWindowProperty::New(mitk::LevelWindow(100, 50)));
+    CPPUNIT_ASSERT(node->GetLevelWindow(levelWindow));
+    CPPUNIT_ASSERT_EQUAL(100.0, levelWindow.GetLevel());
+
+    // Other keys than the default ones
+    node->SetColor(1.0f, 0.0f, 0.0f, nullptr, "contour color");
+    CPPUNIT_ASSERT(node->GetColor(rgb, nullptr, "contour color"));
+    CPPUNIT_ASSERT_EQUAL(1.0f, rgb[0]);
+    CPPUNIT_ASSERT(node->GetColor(rgb));
+    CPPUNIT_ASSERT_EQUAL(0.0f, rgb[0]);
+    CPPUNIT_ASSERT(node->IsVisible(nullptr, "contour visible"));
+    CPPUNIT_ASSERT(!node->IsVisible(nullptr, "contour visible", false));
+
+    // Fall back on the data properties
+    int layer = 0;
+    CPPUNIT_ASSERT(!node->GetIntProperty(mitk::PropertyKeys::Layer(), layer));
+    pointSet->SetProperty("layer", mitk::IntProperty::New(7));
+    CPPUNIT_ASSERT(node->GetIntProperty(mitk::PropertyKeys::Layer(), layer));
+    CPPUNIT_ASSERT_EQUAL(7, layer);
+    CPPUNIT_ASSERT(nullptr == node->GetProperty(mitk::PropertyKeys::Layer(), nullptr, false));
+
+    // Node properties take precedence over data properties
+    node->SetIntProperty("layer", 2);
+    CPPUNIT_ASSERT(node->GetIntProperty(mitk::PropertyKeys::Layer(), layer));
+    CPPUNIT_ASSERT_EQUAL(2, layer);
+  }
+};
+
+MITK_TEST_SUITE_REGISTRATION(mitkPropertyKey)
@@ -0,0 +1,245 @@
+/*============================================================================
+
+The Medical Imaging Interaction Toolkit (MITK)
+
+Copyright (c) German Cancer Research Center (DKFZ)
+All rights reserved.
+
+Use of this source code is governed by a 3-clause BSD license that can be
+found in the LICENSE file.
+
+============================================================================*/
+
+// Testing
+#include "mitkTestFixture.h"
+#include "mitkTestingMacros.h"
+
+#include <mitkImage.h>
+#include <mitkImageWriteAccessor.h>
+#include <mitkPlaneGeometry.h>
+#include <mitkResliceCache.h>
+
+#include <vtkImageData.h>
+#include <vtkMatrix4x4.h>
+
+#include <algorithm>
+
+class mitkResliceCacheTestSuite : public mitk::TestFixture
+{
+  CPPUNIT_TEST_SUITE(mitkResliceCacheTestSuite);
+  MITK_TEST(CreateKey_EqualPlanes_EqualKeys);
+  MITK_TEST(CreateKey_InvalidInput_NoKey);
+  MITK_TEST(CreateKey_TimeGeometryIsPartOfKey);
+  MITK_TEST(Insert_Get_SharedPixelData);
+  MITK_TEST(ModifiedImage_OutdatedSlicesRemoved);
+  MITK_TEST(WrittenImage_OutdatedSlicesRemoved);
+  MITK_TEST(MemoryLimit_LeastRecentlyUsedEvicted);
+  MITK_TEST(DeletedImage_SlicesRemoved);
+  CPPUNIT_TEST_SUITE_END();
+
+private:
+  mitk::ResliceCache *m_Cache;
+  std::size_t m_OriginalMemoryLimit;
+  mitk::Image::Pointer m_Image;
+  vtkSmartPointer<vtkImageData> m_Slice;
+  vtkSmartPointer<vtkMatrix4x4> m_ResliceAxes;
+  double m_Bounds[6];
+  mitk::ScalarType m_Spacing[2];
+
+  mitk::PlaneGeometry::Pointer CreatePlane(mitk::ScalarType zPosition) const
+  {
+    auto plane = mitk::PlaneGeometry::New();
+    plane->InitializeStandardPlane(m_Image->GetGeometry(), mitk::AnatomicalPlane::Axial, zPosition);
+    return plane;
+  }
+
+  mitk::ResliceCache::Key CreateKey(const mitk::PlaneGeometry *plane) const
+  {
+    mitk::ResliceCache::Key key;
+    CPPUNIT_ASSERT(mitk::ResliceCache::CreateKey(m_Image, plane, 0, 0, false, 0, 1, key));
+    return key;
+  }
+
+public:
+  void setUp() override
+  {
+    m_Cache = mitk::ResliceCache::GetInstance();
+    m_OriginalMemoryLimit = m_Cache->GetMemoryLimit();
+    m_Cache->Clear();
+
+    unsigned int dimensions[3] = { 64, 64, 8 };
+    m_Image = mitk::Image::New();
+    m_Image->Initialize(mitk::MakeScalarPixelType<unsigned char>(), 3, dimensions);
+
+    m_Slice = vtkSmartPointer<vtkImageData>::New();
+    m_Slice->SetDimensions(64, 64, 1);
+    m_Slice->AllocateScalars(VTK_UNSIGNED_CHAR, 1);
+    std::fill_n(static_cast<unsigned char *>(m_Slice->GetScalarPointer()), 64 * 64, 7);
+
+    m_ResliceAxes = vtkSmartPointer<vtkMatrix4x4>::New();
+    std::fill_n(m_Bounds, 6, 0.0);
+    m_Spacing[0] = m_Spacing[1] = 1.0;
+  }
+
+  void tearDown() override
+  {
+    m_Cache->Clear();
+    m_Cache->SetMemoryLimit(m_OriginalMemoryLimit);
+    m_Image = nullptr;
+    m_Slice = nullptr;
+    m_ResliceAxes = nullptr;
+  }
+
+  void CreateKey_EqualPlanes_EqualKeys()
+  {
+    auto key1 = this->CreateKey(this->CreatePlane(2));
+    auto key2 = this->CreateKey(this->CreatePlane(2));
+    auto key3 = this->CreateKey(this->CreatePlane(3));
+
+    CPPUNIT_ASSERT_MESSAGE("Different plane objects at the same position share a key", !(key1 < key2) && !(key2 < key1));
+    CPPUNIT_ASSERT_MESSAGE("Different plane positions have different keys", key1 < key3 || key3 < key1);
+
+    mitk::ResliceCache::Key linearKey;
+    mitk::ResliceCache::CreateKey(m_Image, this->CreatePlane(2), 0, 1, false, 0, 1, linearKey);
+    CPPUNIT_ASSERT_MESSAGE("Interpolation is part of the key", key1 < linearKey || linearKey < key1);
+  }
+
+  void CreateKey_InvalidInput_NoKey()
+  {
+    mitk::ResliceCache::Key key;
+    CPPUNIT_ASSERT(!mitk::ResliceCache::CreateKey(nullptr, this->CreatePlane(2), 0, 0, false, 0, 1, key));
+    CPPUNIT_ASSERT(!mitk::ResliceCache::CreateKey(m_Image, nullptr, 0, 0, false, 0, 1, key));
+  }
+
+  void CreateKey_TimeGeometryIsPartOfKey()
+  {
+    auto plane = this->CreatePlane(2);
+    auto key1 = this->CreateKey(plane);
+
+    // a changed time step geometry does not necessarily modify the image
+    auto timeGeometry = m_Image->GetTimeGeometry()->Clone();
+    mitk::Vector3D spacing;
+    mitk::FillVector3D(spacing, 2.0, 2.0, 2.0);
+    timeGeometry->GetGeometryForTimeStep(0)->SetSpacing(spacing);
+    m_Image->SetTimeGeometry(timeGeometry);
+
+    auto key2 = this->CreateKey(plane);
+    CPPUNIT_ASSERT_MESSAGE("Time step geometry is part of the key", key1 < key2 || key2 < key1);
+
+    mitk::ResliceCache::Key key;
+    CPPUNIT_ASSERT_MESSAGE("Invalid time step has no key", !mitk::ResliceCache::CreateKey(m_Image, plane, 5, 0, false, 0, 1, key));
+  }
+
+  void Insert_Get_SharedPixelData()
+  {
+    auto key = this->CreateKey(this->CreatePlane(2));
+    CPPUNIT_ASSERT(nullptr == m_Cache->Get(key));
+
+    auto inserted = m_Cache->Insert(key, m_Slice, m_Bounds, m_Spacing, m_ResliceAxes);
+    CPPUNIT_ASSERT(nullptr != inserted);
+    CPPUNIT_ASSERT(inserted->Image.GetPointer() != m_Slice.GetPointer());
+    CPPUNIT_ASSERT_MESSAGE("Pixel data is not copied", inserted->Image->GetScalarPointer() == m_Slice->GetScalarPointer());
+
+    // a filter executing again allocates new scalars for its output, like the reslicer of a mapper
+    m_Slice->AllocateScalars(VTK_UNSIGNED_CHAR, 1);
+    static_cast<unsigned char *>(m_Slice->GetScalarPointer())[0] = 42;
+
+    auto cached = m_Cache->Get(this->CreateKey(this->CreatePlane(2)));
+    CPPUNIT_ASSERT(cached == inserted);
+    CPPUNIT_ASSERT_EQUAL(7, static_cast<int>(static_cast<unsigned char *>(cached->Image->GetScalarPointer())[0]));
+    CPPUNIT_ASSERT_EQUAL(std::size_t(1), m_Cache->GetNumberOfSlices());
+  }
+
+  void ModifiedImage_OutdatedSlicesRemoved()
+  {
+    auto oldKey = this->CreateKey(this->CreatePlane(2));
+    m_Cache->Insert(oldKey, m_Slice, m_Bounds, m_Spacing, m_ResliceAxes);
+    m_Cache->Insert(this->CreateKey(this->CreatePlane(3)), m_Slice, m_Bounds, m_Spacing, m_ResliceAxes);
+
+    m_Image->Modified();
+
+    auto newKey = this->CreateKey(this->CreatePlane(2));
+    CPPUNIT_ASSERT_MESSAGE("Modified image must not hit outdated slice", nullptr == m_Cache->Get(newKey));
+
+    m_Cache->Insert(newKey, m_Slice, m_Bounds, m_Spacing, m_ResliceAxes);
+    CPPUNIT_ASSERT_EQUAL(std::size_t(1), m_Cache->GetNumberOfSlices());
+    CPPUNIT_ASSERT(nullptr == m_Cache->Get(oldKey));
+    CPPUNIT_ASSERT(nullptr != m_Cache->Get(newKey));
+
+    m_Cache->Remove(m_Image);
+    CPPUNIT_ASSERT_EQUAL(std::size_t(0), m_Cache->GetNumberOfSlices());
+    CPPUNIT_ASSERT_EQUAL(std::size_t(0), m_Cache->GetMemorySize());
+  }
+
+  void WrittenImage_OutdatedSlicesRemoved()
+  {
+    auto oldKey = this->CreateKey(this->CreatePlane(2));
+    m_Cache->Insert(oldKey, m_Slice, m_Bounds, m_Spacing, m_ResliceAxes);
+
+    {
+      // writing through an accessor does not change the modification time of the image
+      mitk::ImageWriteAccessor accessor(m_Image);
+      static_cast<unsigned char *>(accessor.GetData())[0] = 1;
+    }
+
+    auto newKey = this->CreateKey(this->CreatePlane(2));
+    CPPUNIT_ASSERT_MESSAGE("Written image must not hit outdated slice", nullptr == m_Cache->Get(newKey));
+
+    m_Cache->Insert(newKey, m_Slice, m_Bounds, m_Spacing, m_ResliceAxes);
+    CPPUNIT_ASSERT_EQUAL(std::size_t(1), m_Cache->GetNumberOfSlices());
+    CPPUNIT_ASSERT(nullptr == m_Cache->Get(oldKey));
+  }
+
+  void MemoryLimit_LeastRecentlyUsedEvicted()
+  {
+    auto key0 = this->CreateKey(this->CreatePlane(0));
+    auto key1 = this->CreateKey(this->CreatePlane(1));
+    auto key2 = this->CreateKey(this->CreatePlane(2));
+
+    m_Cache->Insert(key0, m_Slice, m_Bounds, m_Spacing, m_ResliceAxes);
+    const auto sliceSize = m_Cache->GetMemorySize();
+    CPPUNIT_ASSERT(sliceSize > 0);
+
+    m_Cache->SetMemoryLimit(2 * sliceSize);
+    m_Cache->Insert(key1, m_Slice, m_Bounds, m_Spacing, m_ResliceAxes);
+
+    // use key0, so key1 is the least recently used slice
+    CPPUNIT_ASSERT(nullptr != m_Cache->Get(key0));
+    m_Cache->Insert(key2, m_Slice, m_Bounds, m_Spacing, m_ResliceAxes);
+
+    CPPUNIT_ASSERT_EQUAL(std::size_t(2), m_Cache->GetNumberOfSlices());
+    CPPUNIT_ASSERT(m_Cache->GetMemorySize() <= m_Cache->GetMemoryLimit());
+    CPPUNIT_ASSERT(nullptr != m_Cache->Get(key0));
+    CPPUNIT_ASSERT(nullptr == m_Cache->Get(key1));
+    CPPUNIT_ASSERT(nullptr != m_Cache->Get(key2));
+
+    m_Cache->SetMemoryLimit(0);
+    CPPUNIT_ASSERT_EQUAL(std::size_t(0), m_Cache->GetNumberOfSlices());
+    CPPUNIT_ASSERT_MESSAGE("A memory limit of 0 disables the cache",
+                           nullptr == m_Cache->Insert(key0, m_Slice, m_Bounds, m_Spacing, m_ResliceAxes));
+  }
+
+  void DeletedImage_SlicesRemoved()
+  {
+    m_Cache->Insert(this->CreateKey(this->CreatePlane(2)), m_Slice, m_Bounds, m_Spacing, m_ResliceAxes);
+
+    unsigned int dimensions[3] = { 64, 64, 8 };
+    auto otherImage = mitk::Image::New();
+    otherImage->Initialize(mitk::MakeScalarPixelType<unsigned char>(), 3, dimensions);
+
+    mitk::ResliceCache::Key otherKey;
+    CPPUNIT_ASSERT(mitk::ResliceCache::CreateKey(otherImage, this->CreatePlane(2), 0, 0, false, 0, 1, otherKey));
+    m_Cache->Insert(otherKey, m_Slice, m_Bounds, m_Spacing, m_ResliceAxes);
+    CPPUNIT_ASSERT_EQUAL(std::size_t(2), m_Cache->GetNumberOfSlices());
+
+    otherImage = nullptr;
+    CPPUNIT_ASSERT_EQUAL_MESSAGE("Slices of a deleted image are removed", std::size_t(1), m_Cache->GetNumberOfSlices());
+    CPPUNIT_ASSERT(nullptr != m_Cache->Get(this->CreateKey(this->CreatePlane(2))));
+
+    m_Image = nullptr;
+    CPPUNIT_ASSERT_EQUAL(std::size_t(0), m_Cache->GetNumberOfSlices());
+    CPPUNIT_ASSERT_EQUAL(std::size_t(0), m_Cache->GetMemorySize());
+  }
+};
+
+MITK_TEST_SUITE_REGISTRATION(mitkResliceCache)
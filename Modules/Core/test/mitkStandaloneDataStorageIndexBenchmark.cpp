@@ -0,0 +1,131 @@
+/*============================================================================
+
+The Medical Imaging Interaction Toolkit (MITK)
+
+Copyright (c) German Cancer Research Center (DKFZ)
+All rights reserved.
+
+Use of this source code is governed by a 3-clause BSD license that can be
+found in the LICENSE file.
+
+============================================================================*/
+
+#include <mitkDataNode.h>
+#include <mitkNodePredicateAnd.h>
+#include <mitkNodePredicateDataType.h>
+#include <mitkNodePredicateProperty.h>
+#include <mitkPointSet.h>
+#include <mitkStandaloneDataStorage.h>
+#include <mitkStringProperty.h>
+#include <mitkSurface.h>
+
+#include <mitkTestFixture.h>
+#include <mitkTestingMacros.h>
+
+#include <itkTimeProbe.h>
+
+#include <string>
+#include <vector>
+
+/** Compares the runtime of indexed data storage queries with checking the condition for every node.
+  Not run by CTest; call the test driver with mitkStandaloneDataStorageIndexBenchmark to run it.*/
+class mitkStandaloneDataStorageIndexBenchmarkSuite : public mitk::TestFixture
+{
+  CPPUNIT_TEST_SUITE(mitkStandaloneDataStorageIndexBenchmarkSuite);
+  MITK_TEST(Queries_ManyNodes_IndexedFasterThanLinear);
+  CPPUNIT_TEST_SUITE_END();
+
+  mitk::StandaloneDataStorage::Pointer m_DataStorage;
+
+  /** Checks the condition for every node like DataStorage::GetSubset() without indexes.*/
+  std::vector<const mitk::DataNode *> GetSubsetLinear(const mitk::NodePredicateBase *condition) const
+  {
+    std::vector<const mitk::DataNode *> result;
+    auto all = m_DataStorage->GetAll();
+
+    for (auto iter = all->Begin(); iter != all->End(); ++iter)
+    {
+      if (condition->CheckNode(iter->Value()))
+        result.push_back(iter->Value());
+    }
+
+    return result;
+  }
+
+  std::vector<const mitk::DataNode *> GetSubset(const mitk::NodePredicateBase *condition) const
+  {
+    std::vector<const mitk::DataNode *> result;
+    auto subset = m_DataStorage->GetSubset(condition);
+
+    for (auto iter = subset->Begin(); iter != subset->End(); ++iter)
+      result.push_back(iter->Value());
+
+    return result;
+  }
+
+public:
+  void setUp() override
+  {
+    m_DataStorage = mitk::StandaloneDataStorage::New();
+    m_DataStorage->AddIndexedPropertyKey("organ");
+  }
+
+  void tearDown() override
+  {
+    m_DataStorage = nullptr;
+  }
+
+  void Queries_ManyNodes_IndexedFasterThanLinear()
+  {
+    const int numberOfNodes = 2000;
+
+    for (int i = 0; i < numberOfNodes; ++i)
+    {
+      mitk::BaseData::Pointer data;
+
+      if (0 == i % 2)
+        data = mitk::PointSet::New();
+      else
+        data = mitk::Surface::New();
+
+      auto node = mitk::DataNode::New();
+      node->SetData(data);
+      node->SetName("node" + std::to_string(i));
+      node->SetStringProperty("organ", 0 == i % 3 ? "liver" : "spleen");
+      m_DataStorage->Add(node);
+    }
+
+    itk::TimeProbe linearProbe;
+    itk::TimeProbe indexedProbe;
+
+    auto isLiverSurface = mitk::NodePredicateAnd::New(mitk::NodePredicateDataType::New("Surface"),
+      mitk::NodePredicateProperty::New("organ", mitk::StringProperty::New("liver")));
+
+    for (int i = 0; i < numberOfNodes; i += 10)
+    {
+      const auto name = "node" + std::to_string(i);
+      auto hasName = mitk::NodePredicateProperty::New("name", mitk::StringProperty::New(name));
+
+      linearProbe.Start();
+      auto linearResult = this->GetSubsetLinear(hasName);
+      auto linearLiverSurfaces = this->GetSubsetLinear(isLiverSurface);
+      linearProbe.Stop();
+
+      indexedProbe.Start();
+      auto *namedNode = m_DataStorage->GetNamedNode(name);
+      auto liverSurfaces = this->GetSubset(isLiverSurface);
+      indexedProbe.Stop();
+
+      CPPUNIT_ASSERT_EQUAL(std::size_t(1), linearResult.size());
+      CPPUNIT_ASSERT(linearResult.front() == namedNode);
+      CPPUNIT_ASSERT(linearLiverSurfaces == liverSurfaces);
+    }
+
+    MITK_INFO << "Queries on " << numberOfNodes << " nodes. Linear: " << linearProbe.GetTotal()
+              << " s; Indexed: " << indexedProbe.GetTotal() << " s";
+
+    CPPUNIT_ASSERT_MESSAGE("Indexed queries are faster than linear ones", indexedProbe.GetTotal() < linearProbe.GetTotal());
+  }
+};
+
+MITK_TEST_SUITE_REGISTRATION(mitkStandaloneDataStorageIndexBenchmark)
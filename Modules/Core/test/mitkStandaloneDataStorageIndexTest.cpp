@@ -0,0 +1,266 @@
+/*============================================================================
+
+The Medical Imaging Interaction Toolkit (MITK)
+
+Copyright (c) German Cancer Research Center (DKFZ)
+All rights reserved.
+
+Use of this source code is governed by a 3-clause BSD license that can be
+found in the LICENSE file.
+
+============================================================================*/
+
+#include <mitkDataNode.h>
+#include <mitkNodePredicateAnd.h>
+#include <mitkNodePredicateDataType.h>
+#include <mitkNodePredicateNot.h>
+#include <mitkNodePredicateOr.h>
+#include <mitkNodePredicateProperty.h>
+#include <mitkPointSet.h>
+#include <mitkStandaloneDataStorage.h>
+#include <mitkStringProperty.h>
+#include <mitkSurface.h>
+
+#include <mitkTestFixture.h>
+#include <mitkTestingMacros.h>
+
+#include <string>
+#include <vector>
+
+class mitkStandaloneDataStorageIndexTestSuite : public mitk::TestFixture
+{
+  CPPUNIT_TEST_SUITE(mitkStandaloneDataStorageIndexTestSuite);
+
+  MITK_TEST(GetNamedNode_AfterRename);
+  MITK_TEST(GetNamedNode_AfterPropertyValueChange);
+  MITK_TEST(GetSubset_DataType);
+  MITK_TEST(GetSubset_IndexedProperty);
+  MITK_TEST(GetSubset_DataPropertyFallback);
+  MITK_TEST(GetSubset_Combinations);
+  MITK_TEST(GetSubset_AfterRemove);
+  MITK_TEST(GetSubset_ManyNodes);
+
+  CPPUNIT_TEST_SUITE_END();
+
+  mitk::StandaloneDataStorage::Pointer m_DataStorage;
+
+  mitk::DataNode::Pointer AddNode(const std::string &name, mitk::BaseData *data, const std::string &organ = "")
+  {
+    auto node = mitk::DataNode::New();
+    node->SetData(data);
+    node->SetName(name);
+
+    if (!organ.empty())
+      node->SetStringProperty("organ", organ.c_str());
+
+    m_DataStorage->Add(node);
+    return node;
+  }
+
+  /** Checks the condition for every node like DataStorage::GetSubset() without indexes.*/
+  std::vector<const mitk::DataNode *> GetSubsetLinear(const mitk::NodePredicateBase *condition) const
+  {
+    std::vector<const mitk::DataNode *> result;
+    auto all = m_DataStorage->GetAll();
+
+    for (auto iter = all->Begin(); iter != all->End(); ++iter)
+    {
+      if (condition->CheckNode(iter->Value()))
+        result.push_back(iter->Value());
+    }
+
+    return result;
+  }
+
+  std::vector<const mitk::DataNode *> GetSubset(const mitk::NodePredicateBase *condition) const
+  {
+    std::vector<const mitk::DataNode *> result;
+    auto subset = m_DataStorage->GetSubset(condition);
+
+    for (auto iter = subset->Begin(); iter != subset->End(); ++iter)
+      result.push_back(iter->Value());
+
+    return result;
+  }
+
+  void AssertSubset(const mitk::NodePredicateBase *condition, std::size_t expectedSize)
+  {
+    auto result = this->GetSubset(condition);
+    CPPUNIT_ASSERT_EQUAL(expectedSize, result.size());
+    CPPUNIT_ASSERT(this->GetSubsetLinear(condition) == result);
+  }
+
+  static mitk::NodePredicateProperty::Pointer HasOrgan(const char *organ)
+  {
+    return mitk::NodePredicateProperty::New("organ", mitk::StringProperty::New(organ));
+  }
+
+public:
+  void setUp() override
+  {
+    m_DataStorage = mitk::StandaloneDataStorage::New();
+    m_DataStorage->AddIndexedPropertyKey("organ");
+  }
+
+  void tearDown() override
+  {
+    m_DataStorage = nullptr;
+  }
+
+  void GetNamedNode_AfterRename()
+  {
+    auto node = this->AddNode("a", mitk::PointSet::New());
+    this->AddNode("b", mitk::PointSet::New());
+
+    CPPUNIT_ASSERT(node == m_DataStorage->GetNamedNode("a"));
+
+    node->SetName("c");
+
+    CPPUNIT_ASSERT(nullptr == m_DataStorage->GetNamedNode("a"));
+    CPPUNIT_ASSERT(node == m_DataStorage->GetNamedNode("c"));
+  }
+
+  void GetNamedNode_AfterPropertyValueChange()
+  {
+    auto node = this->AddNode("a", mitk::PointSet::New());
+    CPPUNIT_ASSERT(node == m_DataStorage->GetNamedNode("a"));
+
+    // Changes the value without a modified event of the node
+    auto *nameProperty = dynamic_cast<mitk::StringProperty *>(node->GetProperty("name"));
+    CPPUNIT_ASSERT(nullptr != nameProperty);
+    nameProperty->SetValue("b");
+
+    CPPUNIT_ASSERT(nullptr == m_DataStorage->GetNamedNode("a"));
+    CPPUNIT_ASSERT(node == m_DataStorage->GetNamedNode("b"));
+  }
+
+  void GetSubset_DataType()
+  {
+    auto node = this->AddNode("a", mitk::PointSet::New());
+    this->AddNode("b", mitk::Surface::New());
+    this->AddNode("c", nullptr);
+
+    auto isPointSet = mitk::NodePredicateDataType::New("PointSet");
+    auto isSurface = mitk::NodePredicateDataType::New("Surface");
+
+    this->AssertSubset(isPointSet, 1);
+    this->AssertSubset(isSurface, 1);
+
+    node->SetData(mitk::Surface::New());
+
+    this->AssertSubset(isPointSet, 0);
+    this->AssertSubset(isSurface, 2);
+  }
+
+  void GetSubset_IndexedProperty()
+  {
+    auto node = this->AddNode("a", mitk::PointSet::New(), "liver");
+    this->AddNode("b", mitk::PointSet::New(), "liver");
+    this->AddNode("c", mitk::PointSet::New(), "spleen");
+    this->AddNode("d", mitk::PointSet::New());
+
+    this->AssertSubset(HasOrgan("liver"), 2);
+    this->AssertSubset(HasOrgan("spleen"), 1);
+    this->AssertSubset(HasOrgan("heart"), 0);
+
+    node->SetStringProperty("organ", "spleen");
+    this->AssertSubset(HasOrgan("liver"), 1);
+    this->AssertSubset(HasOrgan("spleen"), 2);
+
+    node->GetPropertyList()->RemoveProperty("organ");
+    this->AssertSubset(HasOrgan("spleen"), 1);
+
+    // Queries for the existence of a property are not answered from the index
+    this->AssertSubset(mitk::NodePredicateProperty::New("organ"), 2);
+  }
+
+  void GetSubset_DataPropertyFallback()
+  {
+    auto pointSet = mitk::PointSet::New();
+    this->AddNode("a", pointSet);
+    this->AddNode("b", mitk::PointSet::New(), "liver");
+
+    pointSet->SetProperty("organ", mitk::StringProperty::New("liver"));
+
+    this->AssertSubset(HasOrgan("liver"), 2);
+
+    // the name of a node without its own name property is looked up in the data
+    auto unnamedNode = mitk::DataNode::New();
+    auto namedData = mitk::PointSet::New();
+    namedData->SetProperty("name", mitk::StringProperty::New("c"));
+    unnamedNode->SetData(namedData);
+    unnamedNode->GetPropertyList()->DeleteProperty("name");
+    m_DataStorage->Add(unnamedNode);
+
+    CPPUNIT_ASSERT(unnamedNode == m_DataStorage->GetNamedNode("c"));
+  }
+
+  void GetSubset_Combinations()
+  {
+    this->AddNode("a", mitk::PointSet::New(), "liver");
+    this->AddNode("b", mitk::Surface::New(), "liver");
+    this->AddNode("c", mitk::Surface::New(), "spleen");
+    this->AddNode("d", mitk::Surface::New());
+
+    auto isSurface = mitk::NodePredicateDataType::New("Surface");
+
+    this->AssertSubset(mitk::NodePredicateAnd::New(isSurface, HasOrgan("liver")), 1);
+    this->AssertSubset(mitk::NodePredicateOr::New(HasOrgan("liver"), HasOrgan("spleen")), 3);
+    this->AssertSubset(mitk::NodePredicateAnd::New(isSurface, mitk::NodePredicateNot::New(HasOrgan("liver"))), 2);
+    this->AssertSubset(mitk::NodePredicateOr::New(isSurface, mitk::NodePredicateNot::New(HasOrgan("liver"))), 3);
+  }
+
+  void GetSubset_AfterRemove()
+  {
+    auto node = this->AddNode("a", mitk::PointSet::New(), "liver");
+    this->AddNode("b", mitk::PointSet::New(), "liver");
+
+    m_DataStorage->Remove(node);
+
+    this->AssertSubset(HasOrgan("liver"), 1);
+    CPPUNIT_ASSERT(nullptr == m_DataStorage->GetNamedNode("a"));
+
+    node->SetName("b");
+    this->AssertSubset(mitk::NodePredicateProperty::New("name", mitk::StringProperty::New("b")), 1);
+  }
+
+  void GetSubset_ManyNodes()
+  {
+    const int numberOfNodes = 200;
+    std::vector<mitk::DataNode::Pointer> nodes;
+
+    for (int i = 0; i < numberOfNodes; ++i)
+    {
+      mitk::BaseData::Pointer data;
+
+      if (0 == i % 2)
+        data = mitk::PointSet::New();
+      else
+        data = mitk::Surface::New();
+
+      nodes.push_back(this->AddNode("node" + std::to_string(i), data, 0 == i % 3 ? "liver" : "spleen"));
+    }
+
+    auto isLiverSurface = mitk::NodePredicateAnd::New(mitk::NodePredicateDataType::New("Surface"), HasOrgan("liver"));
+    this->AssertSubset(isLiverSurface, numberOfNodes / 6);
+
+    // renaming and relabeling every fifth node must keep the indexes in sync with the nodes
+    for (int i = 0; i < numberOfNodes; i += 5)
+    {
+      nodes[i]->SetName("renamed" + std::to_string(i));
+      nodes[i]->SetStringProperty("organ", "heart");
+    }
+
+    for (int i = 0; i < numberOfNodes; ++i)
+    {
+      const auto name = (0 == i % 5 ? "renamed" : "node") + std::to_string(i);
+      CPPUNIT_ASSERT(nodes[i] == m_DataStorage->GetNamedNode(name));
+      this->AssertSubset(mitk::NodePredicateProperty::New("name", mitk::StringProperty::New(name)), 1);
+    }
+
+    this->AssertSubset(isLiverSurface, this->GetSubsetLinear(isLiverSurface).size());
+    this->AssertSubset(HasOrgan("heart"), numberOfNodes / 5);
+  }
+};
+
+MITK_TEST_SUITE_REGISTRATION(mitkStandaloneDataStorageIndex)
@@ -149,6 +149,36 @@ int vtkMitkThickSlicesFilterTest(int, char *[])
   thickSliceFilter->Update();
   vtkMitkThickSlicesFilterTestHelper::EvaluateResult(6, thickSliceFilter->GetOutput(), "Mean");
 
+  //////////////////////////////////////////////////////////////////////////
+  // Sliding window: the slab moves by one slice
+  // 0 1 2 -> 1 2 3 -> 0 1 2
+  thickSliceFilter->SlidingWindowOn();
+  thickSliceFilter->SetInputData(testImage1->GetVtkImageData());
+
+  // Sum
+  thickSliceFilter->SetThickSliceMode(1);
+  thickSliceFilter->Modified();
+  thickSliceFilter->Update();
+  vtkMitkThickSlicesFilterTestHelper::EvaluateResult(1, thickSliceFilter->GetOutput(), "Sum (sliding window)");
+
+  mitk::Image::Pointer testImage3 = vtkMitkThickSlicesFilterTestHelper::CreateTestImage(1, 3);
+  thickSliceFilter->SetInputData(testImage3->GetVtkImageData());
+  thickSliceFilter->SetSliceShift(1);
+  thickSliceFilter->Update();
+  vtkMitkThickSlicesFilterTestHelper::EvaluateResult(2, thickSliceFilter->GetOutput(), "Sum (slab moved forward)");
+  MITK_TEST_CONDITION(thickSliceFilter->GetSliceShift() == 0, "Slice shift is reset after the update");
+
+  // Mean
+  thickSliceFilter->SetThickSliceMode(4);
+  thickSliceFilter->Modified();
+  thickSliceFilter->Update();
+  vtkMitkThickSlicesFilterTestHelper::EvaluateResult(3, thickSliceFilter->GetOutput(), "Mean (sliding window)");
+
+  thickSliceFilter->SetInputData(testImage1->GetVtkImageData());
+  thickSliceFilter->SetSliceShift(-1);
+  thickSliceFilter->Update();
+  vtkMitkThickSlicesFilterTestHelper::EvaluateResult(1, thickSliceFilter->GetOutput(), "Mean (slab moved backward)");
+
   thickSliceFilter->Delete();
 
   MITK_TEST_END()
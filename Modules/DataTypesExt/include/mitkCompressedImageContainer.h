@@ -17,35 +17,75 @@ found in the LICENSE file.
 #include <mitkImage.h>
 #include <array>
 #include <memory>
-#include <utility>
+#include <vector>
 
 namespace mitk
 {
+  /** \brief Holds an LZ4 compressed copy of an image.
+
+    Every slice of every time step is compressed independently, so compression and decompression
+    of larger images are distributed over multiple threads. All compressed slices are stored
+    back to back in a single buffer. Single slices or time steps can be decompressed on demand
+    without decompressing the whole image.
+  */
   class MITKDATATYPESEXT_EXPORT CompressedImageContainer
   {
   public:
+    /** Fast: default LZ4 compression (high throughput, used for interactive undo).
+      HighRatio: LZ4 HC compression (smaller, but considerably slower to compress; decompression is equally fast).*/
+    enum class CompressionLevel
+    {
+      Fast,
+      HighRatio
+    };
+
     CompressedImageContainer();
     ~CompressedImageContainer();
 
     CompressedImageContainer(const CompressedImageContainer&) = delete;
     CompressedImageContainer& operator=(const CompressedImageContainer&) = delete;
 
-    void CompressImage(const Image* image);
+    void CompressImage(const Image* image, CompressionLevel level = CompressionLevel::Fast);
     Image::Pointer DecompressImage() const;
 
+    /** Decompresses a single time step. The geometry of the returned image is the geometry of the time step.
+      Returns nullptr if the container is empty, throws if the time step is out of range.*/
+    Image::Pointer DecompressTimeStep(unsigned int timeStep) const;
+
+    /** Decompresses a single (axial) slice of a time step into a 2D image that is located at the slice position.
+      Returns nullptr if the container is empty, throws if the slice or time step is out of range.*/
+    Image::Pointer DecompressSlice(unsigned int slice, unsigned int timeStep = 0) const;
+
+    unsigned int GetNumberOfSlices() const;
+    unsigned int GetNumberOfTimeSteps() const;
+    CompressionLevel GetCompressionLevel() const;
+
+    /** Returns the memory (in bytes) occupied by the compressed image data.*/
+    std::size_t GetMemorySize() const;
+
   private:
-    using CompressedSliceData = std::pair<int, char*>;
-    using CompressedTimeStepData = std::vector<CompressedSliceData>;
-    using CompressedImageData = std::vector<CompressedTimeStepData>;
+    struct CompressedSlice
+    {
+      std::size_t Offset;
+      int Size;
+    };
 
     void ClearCompressedImageData();
+    std::size_t GetNumberOfSliceBytes() const;
+    void DecompressSliceTo(std::size_t index, char* dest) const;
 
-    CompressedImageData m_CompressedImageData;
+    /** All compressed slices, ordered by time step and slice.*/
+    std::vector<char> m_CompressedData;
+    /** Location of every compressed slice in m_CompressedData (index: timeStep * numberOfSlices + slice).*/
+    std::vector<CompressedSlice> m_CompressedSlices;
 
     std::unique_ptr<PixelType> m_PixelType;
     TimeGeometry::Pointer m_TimeGeometry;
     std::array<unsigned int, 2> m_SliceDimensions;
+    unsigned int m_NumberOfSlices;
+    unsigned int m_NumberOfTimeSteps;
     unsigned int m_Dimension;
+    CompressionLevel m_CompressionLevel;
   };
 }
 
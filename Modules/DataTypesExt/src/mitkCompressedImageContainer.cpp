@@ -12,41 +12,68 @@ found in the LICENSE file.
 
 #include <mitkCompressedImageContainer.h>
 
+#include <mitkExceptionMacro.h>
+#include <mitkGeometry3D.h>
 #include <mitkImageReadAccessor.h>
 #include <mitkImageWriteAccessor.h>
 
+#include <itkMultiThreaderBase.h>
+
 #include <lz4.h>
+#include <lz4hc.h>
 
 #include <algorithm>
+#include <cstring>
+
+namespace
+{
+  /** Slices of one block are compressed sequentially by one work unit. More blocks than threads
+    keep the work units busy if the compressibility of the slices differs.*/
+  std::size_t GetNumberOfBlocks(std::size_t numberOfSlices)
+  {
+    const std::size_t numberOfThreads = std::max(1u, itk::MultiThreaderBase::GetGlobalDefaultNumberOfThreads());
+    return std::min(numberOfSlices, 4 * numberOfThreads);
+  }
+}
 
 mitk::CompressedImageContainer::CompressedImageContainer()
-  : m_Dimension(0)
+  : m_NumberOfSlices(0),
+    m_NumberOfTimeSteps(0),
+    m_Dimension(0),
+    m_CompressionLevel(CompressionLevel::Fast)
 {
+  m_SliceDimensions[0] = 0;
+  m_SliceDimensions[1] = 0;
 }
 
 mitk::CompressedImageContainer::~CompressedImageContainer()
 {
-  this->ClearCompressedImageData();
 }
 
 void mitk::CompressedImageContainer::ClearCompressedImageData()
 {
-  for (const auto& image : m_CompressedImageData)
-  {
-    for (auto slice : image)
-      delete[] slice.second;
-  }
-
-  m_CompressedImageData.clear();
+  // swap to really release the memory
+  std::vector<char>().swap(m_CompressedData);
+  std::vector<CompressedSlice>().swap(m_CompressedSlices);
 
   m_PixelType = nullptr;
   m_TimeGeometry = nullptr;
   m_SliceDimensions[0] = 0;
   m_SliceDimensions[1] = 0;
+  m_NumberOfSlices = 0;
+  m_NumberOfTimeSteps = 0;
   m_Dimension = 0;
+  m_CompressionLevel = CompressionLevel::Fast;
 }
 
-void mitk::CompressedImageContainer::CompressImage(const Image* image)
+std::size_t mitk::CompressedImageContainer::GetNumberOfSliceBytes() const
+{
+  return nullptr != m_PixelType
+    ? m_PixelType->GetSize() * m_SliceDimensions[0] * m_SliceDimensions[1]
+    : 0;
+}
+
+void mitk::CompressedImageContainer::CompressImage(const Image* image, CompressionLevel level)
 {
   this->ClearCompressedImageData();
 
@@ -57,76 +84,174 @@ void mitk::CompressedImageContainer::CompressImage(const Image* image)
   m_TimeGeometry = image->GetTimeGeometry()->Clone();
   m_SliceDimensions[0] = image->GetDimension(0);
   m_SliceDimensions[1] = image->GetDimension(1);
+  m_NumberOfSlices = image->GetDimension(2);
+  m_NumberOfTimeSteps = m_TimeGeometry->CountTimeSteps();
   m_Dimension = image->GetDimension();
+  m_CompressionLevel = level;
+
+  const std::size_t numberOfSlices = static_cast<std::size_t>(m_NumberOfSlices) * m_NumberOfTimeSteps;
+  const auto numSliceBytes = this->GetNumberOfSliceBytes();
+
+  if (0 == numberOfSlices)
+    return;
+
+  const auto compressBound = static_cast<std::size_t>(LZ4_compressBound(static_cast<int>(numSliceBytes)));
+  const auto numberOfBlocks = GetNumberOfBlocks(numberOfSlices);
 
-  const auto numTimeSteps = m_TimeGeometry->CountTimeSteps();
-  const auto numSlices = image->GetDimension(2);
-  const auto numSliceBytes = image->GetPixelType().GetSize() * image->GetDimension(0) * image->GetDimension(1);
+  m_CompressedSlices.resize(numberOfSlices);
 
-  m_CompressedImageData.reserve(numTimeSteps);
+  // Every time step is accessed through its own volume accessor. An accessor of the whole image
+  // would let a 4D image merge its time steps into one channel buffer as a side effect.
+  std::vector<std::unique_ptr<ImageReadAccessor>> accessors;
+  std::vector<const char*> timeStepData;
+  accessors.reserve(m_NumberOfTimeSteps);
+  timeStepData.reserve(m_NumberOfTimeSteps);
 
-  for (std::remove_const_t<decltype(numTimeSteps)> t = 0; t < numTimeSteps; ++t)
+  for (unsigned int t = 0; t < m_NumberOfTimeSteps; ++t)
   {
-    CompressedTimeStepData slices;
-    slices.reserve(numSlices);
+    accessors.push_back(std::make_unique<ImageReadAccessor>(image, image->GetVolumeData(t)));
+    timeStepData.push_back(static_cast<const char*>(accessors.back()->GetData()));
+  }
+
+  // Every block compresses its slices into its own staging buffer. Afterwards, the staging
+  // buffers are concatenated into the final buffer. Block boundaries are fixed, so the result
+  // does not depend on the number of threads.
+  std::vector<std::vector<char>> stagingBuffers(numberOfBlocks);
+
+  auto compressBlock = [&](itk::SizeValueType block)
+  {
+    const std::size_t first = block * numberOfSlices / numberOfBlocks;
+    const std::size_t last = (block + 1) * numberOfSlices / numberOfBlocks;
 
-    ImageReadAccessor accessor(image, image->GetVolumeData(t));
+    std::vector<char> state(CompressionLevel::HighRatio == level ? LZ4_sizeofStateHC() : LZ4_sizeofState());
+    auto& staging = stagingBuffers[block];
+    staging.reserve((last - first) * compressBound / 2);
 
-    for (std::remove_const_t<decltype(numSlices)> s = 0; s < numSlices; ++s)
+    for (std::size_t i = first; i < last; ++i)
     {
-      const auto* src = reinterpret_cast<const char*>(accessor.GetData()) + numSliceBytes * s;
-      char* dest = new char[numSliceBytes];
-      const auto destSize = LZ4_compress_default(src, dest, static_cast<int>(numSliceBytes), static_cast<int>(numSliceBytes));
-
-      if (0 == destSize)
-      {
-        MITK_ERROR << "LZ4 compression failed!";
-        delete[] dest;
-        slices.emplace_back(0, nullptr);
-      }
-      else
-      {
-        char* shrinkedDest = new char[destSize];
-        std::copy(dest, dest + destSize, shrinkedDest);
-        delete[] dest;
-        slices.emplace_back(destSize, shrinkedDest);
-      }
+      const std::size_t offset = staging.size();
+      staging.resize(offset + compressBound);
+
+      const auto* src = timeStepData[i / m_NumberOfSlices] + numSliceBytes * (i % m_NumberOfSlices);
+      auto* dest = staging.data() + offset;
+
+      const auto destSize = CompressionLevel::HighRatio == level
+        ? LZ4_compress_HC_extStateHC(state.data(), src, dest, static_cast<int>(numSliceBytes), static_cast<int>(compressBound), LZ4HC_CLEVEL_DEFAULT)
+        : LZ4_compress_fast_extState(state.data(), src, dest, static_cast<int>(numSliceBytes), static_cast<int>(compressBound), 1);
+
+      staging.resize(offset + static_cast<std::size_t>(std::max(destSize, 0)));
+      m_CompressedSlices[i] = { offset, destSize };
+    }
+  };
+
+  if (1 == numberOfBlocks)
+  {
+    compressBlock(0);
+  }
+  else
+  {
+    auto threader = itk::MultiThreaderBase::New();
+    threader->ParallelizeArray(0, numberOfBlocks, compressBlock, nullptr);
+  }
+
+  std::size_t totalSize = 0;
+  for (const auto& staging : stagingBuffers)
+    totalSize += staging.size();
+
+  m_CompressedData.resize(totalSize);
+
+  std::size_t blockOffset = 0;
+  for (std::size_t block = 0; block < numberOfBlocks; ++block)
+  {
+    const auto& staging = stagingBuffers[block];
+    std::copy(staging.begin(), staging.end(), m_CompressedData.begin() + blockOffset);
+
+    const std::size_t first = block * numberOfSlices / numberOfBlocks;
+    const std::size_t last = (block + 1) * numberOfSlices / numberOfBlocks;
+    for (std::size_t i = first; i < last; ++i)
+      m_CompressedSlices[i].Offset += blockOffset;
+
+    blockOffset += staging.size();
+  }
+
+  for (const auto& slice : m_CompressedSlices)
+  {
+    if (0 >= slice.Size)
+    {
+      MITK_ERROR << "LZ4 compression failed!";
+      break;
     }
+  }
+}
+
+std::size_t mitk::CompressedImageContainer::GetMemorySize() const
+{
+  return m_CompressedData.size();
+}
+
+unsigned int mitk::CompressedImageContainer::GetNumberOfSlices() const
+{
+  return m_NumberOfSlices;
+}
+
+unsigned int mitk::CompressedImageContainer::GetNumberOfTimeSteps() const
+{
+  return m_NumberOfTimeSteps;
+}
+
+mitk::CompressedImageContainer::CompressionLevel mitk::CompressedImageContainer::GetCompressionLevel() const
+{
+  return m_CompressionLevel;
+}
 
-    m_CompressedImageData.push_back(slices);
+void mitk::CompressedImageContainer::DecompressSliceTo(std::size_t index, char* dest) const
+{
+  const auto numSliceBytes = static_cast<int>(this->GetNumberOfSliceBytes());
+  const auto& slice = m_CompressedSlices[index];
+
+  if (0 >= slice.Size ||
+      numSliceBytes != LZ4_decompress_safe(m_CompressedData.data() + slice.Offset, dest, slice.Size, numSliceBytes))
+  {
+    // The slice is zeroed instead of leaving uninitialized memory behind.
+    std::memset(dest, 0, numSliceBytes);
+    MITK_ERROR << "LZ4 decompression failed!";
   }
 }
 
 mitk::Image::Pointer mitk::CompressedImageContainer::DecompressImage() const
 {
-  if (m_CompressedImageData.empty())
+  if (m_CompressedSlices.empty())
     return nullptr;
 
-  const auto numSlices = static_cast<unsigned int>(m_CompressedImageData[0].size());
-  const auto numTimeSteps = static_cast<unsigned int>(m_CompressedImageData.size());
-  const auto numSliceBytes = m_PixelType->GetSize() * m_SliceDimensions[0] * m_SliceDimensions[1];
+  const auto numSliceBytes = this->GetNumberOfSliceBytes();
 
   std::array<unsigned int, 4> dimensions;
   dimensions[0] = m_SliceDimensions[0];
   dimensions[1] = m_SliceDimensions[1];
-  dimensions[2] = numSlices;
-  dimensions[3] = numTimeSteps;
+  dimensions[2] = m_NumberOfSlices;
+  dimensions[3] = m_NumberOfTimeSteps;
 
   auto image = Image::New();
   image->Initialize(*m_PixelType, m_Dimension, dimensions.data());
 
-  for (std::remove_const_t<decltype(numTimeSteps)> t = 0; t < numTimeSteps; ++t)
   {
-    ImageWriteAccessor accessor(image, image->GetVolumeData(static_cast<int>(t)));
+    ImageWriteAccessor accessor(image);
+    auto* imageData = static_cast<char*>(accessor.GetData());
 
-    for (std::remove_const_t<decltype(numSlices)> s = 0; s < numSlices; ++s)
+    const std::size_t numberOfSlices = m_CompressedSlices.size();
+    auto decompressSlice = [&](itk::SizeValueType i)
     {
-      auto* dest = reinterpret_cast<char*>(accessor.GetData()) + numSliceBytes * s;
-      const auto& slice = m_CompressedImageData[t][s];
-      const auto destSize = LZ4_decompress_safe(slice.second, dest, slice.first, static_cast<int>(numSliceBytes));
+      this->DecompressSliceTo(i, imageData + numSliceBytes * i);
+    };
 
-      if (0 > destSize)
-        MITK_ERROR << "LZ4 decompression failed!";
+    if (1 == numberOfSlices)
+    {
+      decompressSlice(0);
+    }
+    else
+    {
+      auto threader = itk::MultiThreaderBase::New();
+      threader->ParallelizeArray(0, numberOfSlices, decompressSlice, nullptr);
     }
   }
 
@@ -134,3 +259,77 @@ mitk::Image::Pointer mitk::CompressedImageContainer::DecompressImage() const
 
   return image;
 }
+
+mitk::Image::Pointer mitk::CompressedImageContainer::DecompressTimeStep(unsigned int timeStep) const
+{
+  if (m_CompressedSlices.empty())
+    return nullptr;
+
+  if (timeStep >= m_NumberOfTimeSteps)
+    mitkThrow() << "Cannot decompress time step " << timeStep << ". Compressed image has only " << m_NumberOfTimeSteps << " time steps.";
+
+  const auto numSliceBytes = this->GetNumberOfSliceBytes();
+
+  auto image = Image::New();
+  image->Initialize(*m_PixelType, *(m_TimeGeometry->GetGeometryForTimeStep(timeStep)));
+
+  {
+    ImageWriteAccessor accessor(image);
+    auto* imageData = static_cast<char*>(accessor.GetData());
+
+    const std::size_t firstSlice = static_cast<std::size_t>(timeStep) * m_NumberOfSlices;
+    auto decompressSlice = [&](itk::SizeValueType s)
+    {
+      this->DecompressSliceTo(firstSlice + s, imageData + numSliceBytes * s);
+    };
+
+    if (1 == m_NumberOfSlices)
+    {
+      decompressSlice(0);
+    }
+    else
+    {
+      auto threader = itk::MultiThreaderBase::New();
+      threader->ParallelizeArray(0, m_NumberOfSlices, decompressSlice, nullptr);
+    }
+  }
+
+  return image;
+}
+
+mitk::Image::Pointer mitk::CompressedImageContainer::DecompressSlice(unsigned int slice, unsigned int timeStep) const
+{
+  if (m_CompressedSlices.empty())
+    return nullptr;
+
+  if (timeStep >= m_NumberOfTimeSteps || slice >= m_NumberOfSlices)
+    mitkThrow() << "Cannot decompress slice " << slice << " of time step " << timeStep << ". Compressed image has "
+                << m_NumberOfSlices << " slices and " << m_NumberOfTimeSteps << " time steps.";
+
+  // geometry of the slice: same orientation and spacing as the volume, moved to the slice position
+  const BaseGeometry::Pointer timeStepGeometry = m_TimeGeometry->GetGeometryForTimeStep(timeStep);
+
+  auto bounds = timeStepGeometry->GetBounds();
+  bounds[5] = bounds[4] + 1.0;
+
+  Point3D sliceIndex;
+  FillVector3D(sliceIndex, 0, 0, slice);
+  Point3D sliceOrigin;
+  timeStepGeometry->IndexToWorld(sliceIndex, sliceOrigin);
+
+  auto sliceGeometry = Geometry3D::New();
+  sliceGeometry->SetIndexToWorldTransform(timeStepGeometry->GetIndexToWorldTransform()->Clone());
+  sliceGeometry->SetBounds(bounds);
+  sliceGeometry->SetImageGeometry(timeStepGeometry->GetImageGeometry());
+  sliceGeometry->SetOrigin(sliceOrigin);
+
+  auto image = Image::New();
+  image->Initialize(*m_PixelType, *sliceGeometry);
+
+  {
+    ImageWriteAccessor accessor(image);
+    this->DecompressSliceTo(static_cast<std::size_t>(timeStep) * m_NumberOfSlices + slice, static_cast<char*>(accessor.GetData()));
+  }
+
+  return image;
+}
@@ -2,6 +2,11 @@ set(MODULE_TESTS
   mitkColorSequenceRainbowTest.cpp
   mitkMultiStepperTest.cpp
   mitkUnstructuredGridTest.cpp
+  mitkCompressedImageContainerLabelImageTest.cpp
+)
+
+set(MODULE_CUSTOM_TESTS
+  mitkCompressedImageContainerBenchmark.cpp
 )
 
 set(MODULE_IMAGE_TESTS
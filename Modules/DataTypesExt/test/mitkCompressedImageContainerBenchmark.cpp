@@ -0,0 +1,129 @@
+/*============================================================================
+
+The Medical Imaging Interaction Toolkit (MITK)
+
+Copyright (c) German Cancer Research Center (DKFZ)
+All rights reserved.
+
+Use of this source code is governed by a 3-clause BSD license that can be
+found in the LICENSE file.
+
+============================================================================*/
+
+// Testing
+#include "mitkTestFixture.h"
+#include "mitkTestingMacros.h"
+
+#include <mitkCompressedImageContainer.h>
+#include <mitkImageReadAccessor.h>
+#include <mitkImageWriteAccessor.h>
+
+#include <algorithm>
+#include <chrono>
+#include <cstring>
+
+/** Measures compression and decompression throughput on a segmentation of typical CT size
+  (512x512x600, unsigned short labels) and checks that the data survives the round trip.
+  Not run by CTest; call the test driver with mitkCompressedImageContainerBenchmark to run it.*/
+class mitkCompressedImageContainerBenchmarkSuite : public mitk::TestFixture
+{
+  CPPUNIT_TEST_SUITE(mitkCompressedImageContainerBenchmarkSuite);
+  MITK_TEST(FastLevel_RoundTrip);
+  MITK_TEST(HighRatioLevel_RoundTrip);
+  CPPUNIT_TEST_SUITE_END();
+
+private:
+  typedef unsigned short LabelType;
+  typedef std::chrono::steady_clock ClockType;
+
+  mitk::Image::Pointer m_Segmentation;
+
+  static double GetMegaBytesPerSecond(std::size_t bytes, ClockType::duration duration)
+  {
+    const double seconds = std::max(std::chrono::duration<double>(duration).count(), 1e-9);
+    return bytes / (1024.0 * 1024.0) / seconds;
+  }
+
+  void RoundTrip(mitk::CompressedImageContainer::CompressionLevel level, const std::string &levelName)
+  {
+    mitk::ImageReadAccessor segmentationAccessor(m_Segmentation);
+    const std::size_t imageBytes = 512 * 512 * 600 * sizeof(LabelType);
+
+    mitk::CompressedImageContainer container;
+
+    auto start = ClockType::now();
+    container.CompressImage(m_Segmentation, level);
+    const auto compressionTime = ClockType::now() - start;
+
+    start = ClockType::now();
+    auto decompressed = container.DecompressImage();
+    const auto decompressionTime = ClockType::now() - start;
+
+    start = ClockType::now();
+    auto slice = container.DecompressSlice(300);
+    const auto sliceTime = ClockType::now() - start;
+
+    MITK_INFO << "CompressedImageContainer (" << levelName << "): ratio "
+              << static_cast<double>(imageBytes) / container.GetMemorySize() << ", compression "
+              << GetMegaBytesPerSecond(imageBytes, compressionTime) << " MB/s, decompression "
+              << GetMegaBytesPerSecond(imageBytes, decompressionTime) << " MB/s, single slice "
+              << std::chrono::duration<double, std::milli>(sliceTime).count() << " ms";
+
+    CPPUNIT_ASSERT(container.GetMemorySize() < imageBytes);
+
+    mitk::ImageReadAccessor decompressedAccessor(decompressed);
+    CPPUNIT_ASSERT_MESSAGE("Decompressed image differs from original.",
+                           0 == std::memcmp(segmentationAccessor.GetData(), decompressedAccessor.GetData(), imageBytes));
+
+    const std::size_t sliceBytes = 512 * 512 * sizeof(LabelType);
+    mitk::ImageReadAccessor sliceAccessor(slice);
+    CPPUNIT_ASSERT_MESSAGE("Decompressed slice differs from original.",
+                           0 == std::memcmp(static_cast<const char *>(segmentationAccessor.GetData()) + 300 * sliceBytes,
+                                            sliceAccessor.GetData(),
+                                            sliceBytes));
+  }
+
+public:
+  void setUp() override
+  {
+    unsigned int dimensions[3] = { 512, 512, 600 };
+    m_Segmentation = mitk::Image::New();
+    m_Segmentation->Initialize(mitk::MakeScalarPixelType<LabelType>(), 3, dimensions);
+
+    // two nested "organs" and an irregular lesion, similar to the label distribution of real segmentations
+    mitk::ImageWriteAccessor accessor(m_Segmentation);
+    auto *data = static_cast<LabelType *>(accessor.GetData());
+    for (int z = 0; z < 600; ++z)
+      for (int y = 0; y < 512; ++y)
+        for (int x = 0; x < 512; ++x)
+        {
+          const int dx = x - 256, dy = y - 256, dz = (z - 300) / 2;
+          const int r2 = dx * dx + dy * dy + dz * dz;
+          LabelType label = 0;
+          if (r2 < 200 * 200)
+            label = 1;
+          if (r2 < 120 * 120)
+            label = 2;
+          if (r2 < 60 * 60 && (x + 3 * y + 7 * z) % 11 < 6)
+            label = 3;
+          *data++ = label;
+        }
+  }
+
+  void tearDown() override
+  {
+    m_Segmentation = nullptr;
+  }
+
+  void FastLevel_RoundTrip()
+  {
+    this->RoundTrip(mitk::CompressedImageContainer::CompressionLevel::Fast, "fast");
+  }
+
+  void HighRatioLevel_RoundTrip()
+  {
+    this->RoundTrip(mitk::CompressedImageContainer::CompressionLevel::HighRatio, "high ratio");
+  }
+};
+
+MITK_TEST_SUITE_REGISTRATION(mitkCompressedImageContainerBenchmark)
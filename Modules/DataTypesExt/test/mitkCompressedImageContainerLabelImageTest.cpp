@@ -0,0 +1,124 @@
+/*============================================================================
+
+The Medical Imaging Interaction Toolkit (MITK)
+
+Copyright (c) German Cancer Research Center (DKFZ)
+All rights reserved.
+
+Use of this source code is governed by a 3-clause BSD license that can be
+found in the LICENSE file.
+
+============================================================================*/
+
+// Testing
+#include "mitkTestFixture.h"
+#include "mitkTestingMacros.h"
+
+#include <mitkCompressedImageContainer.h>
+#include <mitkImageReadAccessor.h>
+#include <mitkImageWriteAccessor.h>
+
+#include <cstring>
+
+/** Round trip of a small 4D label image with the label distribution of a typical segmentation.
+  The image has more slices than work units, so the slices are distributed over several blocks.*/
+class mitkCompressedImageContainerLabelImageTestSuite : public mitk::TestFixture
+{
+  CPPUNIT_TEST_SUITE(mitkCompressedImageContainerLabelImageTestSuite);
+  MITK_TEST(FastLevel_RoundTrip);
+  MITK_TEST(HighRatioLevel_RoundTrip);
+  CPPUNIT_TEST_SUITE_END();
+
+private:
+  typedef unsigned short LabelType;
+
+  static constexpr unsigned int Size = 96;
+  static constexpr unsigned int NumberOfSlices = 40;
+  static constexpr unsigned int NumberOfTimeSteps = 3;
+
+  mitk::Image::Pointer m_Segmentation;
+
+  void RoundTrip(mitk::CompressedImageContainer::CompressionLevel level)
+  {
+    const std::size_t sliceBytes = Size * Size * sizeof(LabelType);
+    const std::size_t volumeBytes = sliceBytes * NumberOfSlices;
+
+    mitk::CompressedImageContainer container;
+    container.CompressImage(m_Segmentation, level);
+
+    CPPUNIT_ASSERT_EQUAL(NumberOfSlices, container.GetNumberOfSlices());
+    CPPUNIT_ASSERT_EQUAL(NumberOfTimeSteps, container.GetNumberOfTimeSteps());
+    CPPUNIT_ASSERT(level == container.GetCompressionLevel());
+    CPPUNIT_ASSERT(container.GetMemorySize() < volumeBytes * NumberOfTimeSteps / 4);
+
+    auto decompressed = container.DecompressImage();
+    CPPUNIT_ASSERT_EQUAL(4u, decompressed->GetDimension());
+
+    for (unsigned int t = 0; t < NumberOfTimeSteps; ++t)
+    {
+      mitk::ImageReadAccessor originalAccessor(m_Segmentation, m_Segmentation->GetVolumeData(t));
+      mitk::ImageReadAccessor decompressedAccessor(decompressed, decompressed->GetVolumeData(t));
+      CPPUNIT_ASSERT_MESSAGE("Decompressed image differs from original.",
+                             0 == std::memcmp(originalAccessor.GetData(), decompressedAccessor.GetData(), volumeBytes));
+
+      auto timeStep = container.DecompressTimeStep(t);
+      mitk::ImageReadAccessor timeStepAccessor(timeStep);
+      CPPUNIT_ASSERT_MESSAGE("Decompressed time step differs from original.",
+                             0 == std::memcmp(originalAccessor.GetData(), timeStepAccessor.GetData(), volumeBytes));
+
+      auto slice = container.DecompressSlice(NumberOfSlices / 2, t);
+      mitk::ImageReadAccessor sliceAccessor(slice);
+      CPPUNIT_ASSERT_MESSAGE("Decompressed slice differs from original.",
+                             0 == std::memcmp(static_cast<const char *>(originalAccessor.GetData()) + NumberOfSlices / 2 * sliceBytes,
+                                              sliceAccessor.GetData(),
+                                              sliceBytes));
+    }
+  }
+
+public:
+  void setUp() override
+  {
+    unsigned int dimensions[4] = { Size, Size, NumberOfSlices, NumberOfTimeSteps };
+    m_Segmentation = mitk::Image::New();
+    m_Segmentation->Initialize(mitk::MakeScalarPixelType<LabelType>(), 4, dimensions);
+
+    // two nested "organs" and an irregular lesion that grows over time
+    for (unsigned int t = 0; t < NumberOfTimeSteps; ++t)
+    {
+      mitk::ImageWriteAccessor accessor(m_Segmentation, m_Segmentation->GetVolumeData(t));
+      auto *data = static_cast<LabelType *>(accessor.GetData());
+      for (int z = 0; z < static_cast<int>(NumberOfSlices); ++z)
+        for (int y = 0; y < static_cast<int>(Size); ++y)
+          for (int x = 0; x < static_cast<int>(Size); ++x)
+          {
+            const int dx = x - 48, dy = y - 48, dz = z - 20;
+            const int r2 = dx * dx + dy * dy + dz * dz;
+            LabelType label = 0;
+            if (r2 < 40 * 40)
+              label = 1;
+            if (r2 < 24 * 24)
+              label = 2;
+            if (r2 < (10 + 2 * static_cast<int>(t)) * (10 + 2 * static_cast<int>(t)) && (x + 3 * y + 7 * z) % 11 < 6)
+              label = 3;
+            *data++ = label;
+          }
+    }
+  }
+
+  void tearDown() override
+  {
+    m_Segmentation = nullptr;
+  }
+
+  void FastLevel_RoundTrip()
+  {
+    this->RoundTrip(mitk::CompressedImageContainer::CompressionLevel::Fast);
+  }
+
+  void HighRatioLevel_RoundTrip()
+  {
+    this->RoundTrip(mitk::CompressedImageContainer::CompressionLevel::HighRatio);
+  }
+};
+
+MITK_TEST_SUITE_REGISTRATION(mitkCompressedImageContainerLabelImage)
@@ -16,12 +16,17 @@ found in the LICENSE file.
 #include "mitkImageDataItem.h"
 #include "mitkImageReadAccessor.h"
 
+#include <cstring>
+
 class mitkCompressedImageContainerTestClass
 {
 public:
-  static void Test(mitk::CompressedImageContainer *container, mitk::Image *image, unsigned int &numberFailed)
+  static void Test(mitk::CompressedImageContainer *container,
+                   mitk::Image *image,
+                   mitk::CompressedImageContainer::CompressionLevel level,
+                   unsigned int &numberFailed)
   {
-    container->CompressImage(image);
+    container->CompressImage(image, level);
     mitk::Image::Pointer uncompressedImage = container->DecompressImage();
 
     // check dimensions
@@ -106,6 +111,56 @@ public:
         break; // break "for timeStep"
       }
     }
+
+    TestPartialDecompression(container, image, oneTimeStepSizeInBytes, numberOfTimeSteps, numberFailed);
+  }
+
+  static void TestPartialDecompression(mitk::CompressedImageContainer *container,
+                                       mitk::Image *image,
+                                       unsigned long oneTimeStepSizeInBytes,
+                                       unsigned int numberOfTimeSteps,
+                                       unsigned int &numberFailed)
+  {
+    const unsigned int numberOfSlices = image->GetDimension() > 2 ? image->GetDimension(2) : 1;
+    const unsigned long oneSliceSizeInBytes = oneTimeStepSizeInBytes / numberOfSlices;
+
+    for (unsigned int timeStep = 0; timeStep < numberOfTimeSteps; ++timeStep)
+    {
+      mitk::ImageReadAccessor origImgAcc(image, image->GetVolumeData(timeStep));
+      auto *originalData((const unsigned char *)origImgAcc.GetData());
+
+      mitk::Image::Pointer timeStepImage = container->DecompressTimeStep(timeStep);
+      mitk::ImageReadAccessor timeStepAcc(timeStepImage);
+      if (0 != std::memcmp(originalData, timeStepAcc.GetData(), oneTimeStepSizeInBytes))
+      {
+        ++numberFailed;
+        std::cerr << "  (EE) Pixel data of separately decompressed timestep " << timeStep << " not identical." << std::endl;
+      }
+
+      // first, middle and last slice
+      for (unsigned int slice : {0u, numberOfSlices / 2, numberOfSlices - 1})
+      {
+        mitk::Image::Pointer sliceImage = container->DecompressSlice(slice, timeStep);
+        mitk::ImageReadAccessor sliceAcc(sliceImage);
+        if (0 != std::memcmp(originalData + slice * oneSliceSizeInBytes, sliceAcc.GetData(), oneSliceSizeInBytes))
+        {
+          ++numberFailed;
+          std::cerr << "  (EE) Pixel data of separately decompressed slice " << slice << " (timestep " << timeStep
+                    << ") not identical." << std::endl;
+        }
+
+        mitk::Point3D expectedOrigin;
+        mitk::Point3D sliceIndex;
+        mitk::FillVector3D(sliceIndex, 0, 0, slice);
+        image->GetGeometry(timeStep)->IndexToWorld(sliceIndex, expectedOrigin);
+        if (!mitk::Equal(expectedOrigin, sliceImage->GetGeometry()->GetOrigin()))
+        {
+          ++numberFailed;
+          std::cerr << "  (EE) Origin of separately decompressed slice " << slice << " (timestep " << timeStep
+                    << ") is wrong." << std::endl;
+        }
+      }
+    }
   }
 };
 
@@ -149,7 +204,10 @@ int mitkCompressedImageContainerTest(int argc, char *argv[])
     mitk::CompressedImageContainer container;
 
     // some real work
-    mitkCompressedImageContainerTestClass::Test(&container, image, numberFailed);
+    mitkCompressedImageContainerTestClass::Test(&container, image, mitk::CompressedImageContainer::CompressionLevel::Fast, numberFailed);
+
+    std::cout << "Testing high ratio compression" << std::endl;
+    mitkCompressedImageContainerTestClass::Test(&container, image, mitk::CompressedImageContainer::CompressionLevel::HighRatio, numberFailed);
 
     std::cout << "Testing destruction" << std::endl;
   }
@@ -38,6 +38,7 @@ std::string outFileName;
 std::string maskFileName;
 bool verbose(false);
 bool roibased(false);
+bool sparse(false);
 std::string functionName;
 std::string formular;
 mitk::Image::Pointer image;
@@ -95,6 +96,8 @@ void setupParser(mitkCommandLineParser& parser)
         "verbose", "v", mitkCommandLineParser::Bool, "Verbose Output", "Whether to produce verbose output");
     parser.addArgument(
         "roibased", "r", mitkCommandLineParser::Bool, "Roi based fitting", "Will compute a mean intesity signal over the ROI before fitting it. If this mode is used a mask must be specified.");
+    parser.addArgument(
+        "sparse", "s", mitkCommandLineParser::Bool, "Sparse result storage", "Only keeps the results of the voxels inside the mask while fitting. Reduces the memory needed for small masks. Is ignored if no mask is specified.");
     parser.addArgument("help", "h", mitkCommandLineParser::Bool, "Help:", "Show this help text");
     parser.endGroup();
     //! [add arguments]
@@ -131,6 +134,12 @@ bool configureApplicationSettings(std::map<std::string, us::Any> parsedArgs)
         roibased = us::any_cast<bool>(parsedArgs["roibased"]);
     }
 
+    sparse = false;
+    if (parsedArgs.count("sparse"))
+    {
+        sparse = us::any_cast<bool>(parsedArgs["sparse"]);
+    }
+
     if (parsedArgs.count("mask"))
     {
         maskFileName = us::any_cast<std::string>(parsedArgs["mask"]);
@@ -273,6 +282,7 @@ void doFitting()
         {
             std::cout << "Started fitting process..." << std::endl;
             generator->AddObserver(::itk::AnyEvent(), command);
+            generator->SetSparseOutput(sparse);
             generator->Generate();
             std::cout << std::endl << "Finished fitting process" << std::endl;
 
@@ -8,6 +8,7 @@ set(CPP_FILES
   Common/mitkModelFitParameter.cpp
   Common/mitkModelFitCmdAppsHelper.cpp
   Common/mitkParameterFitImageGeneratorBase.cpp
+  Common/mitkSparseParameterMapStore.cpp
   Common/mitkPixelBasedParameterFitImageGenerator.cpp
   Common/mitkROIBasedParameterFitImageGenerator.cpp
   Common/mitkModelFitInfo.cpp
@@ -59,6 +59,13 @@ namespace mitk
       return result;
     };
 
+    /* @remark this default implementation assumes no local static parameters exist.
+     * Reimplement it together with GetLocalStaticParameters().*/
+    bool HasLocalStaticParameters() const override
+    {
+      return false;
+    };
+
     /* Returns an newly generated instance of the concrete model.
      * It is parameterized by the static parameters (returns of GetGlobalParameter() and
      * GetLocalParameter()).
@@ -70,6 +70,7 @@ namespace mitk
     itk::LightObject::Pointer InternalClone() const override;
 
     ModelResultType ComputeModelfunction(const ParametersType& parameters) const override;
+    void ComputeModelfunctionInPlace(const ParametersType& parameters, ModelResultType& signal) const override;
     DerivedParameterMapType ComputeDerivedParameters(const mitk::ModelBase::ParametersType&
         parameters) const override;
 
@@ -66,6 +66,11 @@ protected:
 
     SignalType m_Sample;
 
+    /** Workspace the model signal is computed into by GetValue(), so that repeated evaluations
+     * during an optimization do not allocate. Cost functions are created per fit and
+     * are not shared between threads.*/
+    mutable SignalType m_SignalWorkspace;
+
 private:
     ModelBase::ConstPointer m_Model;
 
@@ -168,10 +168,26 @@ namespace mitk
 
     ModelResultType GetSignal(const ParametersType& parameters) const;
 
+    /** Variant of GetSignal() that writes the signal into the passed array.
+     * The array is only resized if its size does not equal the size of the time grid. Thus
+     * a caller can keep one array as workspace (e.g. per fit or per thread) and evaluate the
+     * model repeatedly. The model itself is not changed by the call, so one parameterized
+     * model instance can be shared by several threads.
+     * @remark The evaluation only avoids allocations if the model reimplements
+     * ComputeModelfunctionInPlace() (e.g. LinearModel, T2DecayModel, ExpDecayOffsetModel and
+     * the closed form models of the pharmacokinetics module). Otherwise the default
+     * implementation still allocates a temporary result per call.*/
+    void GetSignal(const ParametersType& parameters, ModelResultType& signal) const;
+
   protected:
 
     virtual ModelResultType ComputeModelfunction(const ParametersType& parameters) const = 0;
 
+    /** Computes the model function into signal, which already has the size of the time grid.
+     * Is called by GetSignal(parameters, signal). The default implementation copies the result of
+     * ComputeModelfunction(). Reimplement it in derived classes to avoid the temporary result array.*/
+    virtual void ComputeModelfunctionInPlace(const ParametersType& parameters, ModelResultType& signal) const;
+
     /** Member is called by GetSignal() before ComputeModelfunction(). It indicates if model is in a valid state and
      * ready to compute the signal. The default implementation checks nothing and always returns true.
      * Reimplement to realize special behavior for derived classes.
@@ -44,7 +44,9 @@ namespace  mitk
     typedef ModelBase::ModelResultType  SignalType;
     typedef itk::Array<ModelBase::ParameterValueType> ModelParametersType;
 
-    itkSetConstObjectMacro(ModelParameterizer, ModelParameterizerBase);
+    /** Sets the parameterizer and generates the model that is shared by all positions.
+     * Thus the parameterizer has to be configured completely before it is set.*/
+    void SetModelParameterizer(const ModelParameterizerBase* parameterizer);
     itkGetConstObjectMacro(ModelParameterizer, ModelParameterizerBase);
 
     SimpleFunctorBase::OutputPixelVectorType Compute(const InputPixelVectorType & value) const override;
@@ -59,6 +61,7 @@ namespace  mitk
 
   private:
     ModelParameterizerBase::ConstPointer m_ModelParameterizer;
+    ModelBase::ConstPointer m_SharedModel;
 
   };
 }
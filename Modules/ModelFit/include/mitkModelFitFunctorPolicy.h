@@ -45,7 +45,13 @@ namespace mitk
 
       if (m_Functor.IsNotNull() && m_ModelParameterizer.IsNotNull())
       {
-        ParameterizerType::ModelBasePointer tempModel = m_ModelParameterizer->GenerateParameterizedModel();
+        ParameterizerType::ModelBaseConstPointer tempModel = m_SharedModel;
+
+        if (tempModel.IsNull())
+        {
+          tempModel = m_ModelParameterizer->GenerateParameterizedModel().GetPointer();
+        }
+
         result =  m_Functor->GetNumberOfOutputs(tempModel);
       }
 
@@ -62,6 +68,10 @@ namespace mitk
       m_Functor = functor;
     }
 
+    /** Sets the parameterizer that generates the models for the fitted positions.
+     * If it has no local static parameters (see ModelParameterizerBase::HasLocalStaticParameters()),
+     * one model is generated here and shared read only by all positions and threads. Thus the
+     * parameterizer has to be configured completely before it is set.*/
     void SetModelParameterizer(const ParameterizerType* parameterizer)
     {
       if (!parameterizer)
@@ -70,6 +80,12 @@ namespace mitk
       }
 
       m_ModelParameterizer = parameterizer;
+      m_SharedModel = nullptr;
+
+      if (!parameterizer->HasLocalStaticParameters())
+      {
+        m_SharedModel = parameterizer->GenerateParameterizedModel().GetPointer();
+      }
     }
 
     bool operator!=(const ModelFitFunctorPolicy& other) const
@@ -96,8 +112,16 @@ namespace mitk
         itkGenericExceptionMacro( << "Error. Cannot process operator(). Parameterizer is Null.");
       }
 
-      ParameterizerType::ModelBasePointer parameterizedModel =
-        m_ModelParameterizer->GenerateParameterizedModel(currentIndex);
+      // The shared model is used by raw pointer to avoid contention on its reference count
+      const ModelBase* parameterizedModel = m_SharedModel.GetPointer();
+      ParameterizerType::ModelBaseConstPointer localModel;
+
+      if (nullptr == parameterizedModel)
+      {
+        localModel = m_ModelParameterizer->GenerateParameterizedModel(currentIndex).GetPointer();
+        parameterizedModel = localModel;
+      }
+
       ParameterizerType::ParametersType initialParams = m_ModelParameterizer->GetInitialParameterization(
             currentIndex);
       OutputPixelArrayType result = m_Functor->Compute(value, parameterizedModel, initialParams);
@@ -109,6 +133,8 @@ namespace mitk
 
     FunctorConstPointer m_Functor;
     ParameterizerConstPointer m_ModelParameterizer;
+    /** Model shared by all positions if the parameterizer has no local static parameters, otherwise null.*/
+    ParameterizerType::ModelBaseConstPointer m_SharedModel;
   };
 
 }
@@ -47,7 +47,9 @@ namespace  mitk
     typedef ModelBase::ModelResultType  SignalType;
     typedef itk::Array<ModelBase::ParameterValueType> ModelParametersType;
 
-    itkSetConstObjectMacro(ModelParameterizer, ModelParameterizerBase);
+    /** Sets the parameterizer. If it has no local static parameters, the model that is shared by all
+     * positions is generated here. Thus the parameterizer has to be configured completely before it is set.*/
+    void SetModelParameterizer(const ModelParameterizerBase* parameterizer);
     itkGetConstObjectMacro(ModelParameterizer, ModelParameterizerBase);
 
     itkSetConstObjectMacro(FitInfo, mitk::modelFit::ModelFitInfo);
@@ -73,6 +75,8 @@ namespace  mitk
 
   private:
     ModelParameterizerBase::ConstPointer m_ModelParameterizer;
+    /** Model shared by all positions if the parameterizer has no local static parameters, otherwise null.*/
+    ModelBase::ConstPointer m_SharedModel;
     modelFit::ModelFitInfo::ConstPointer m_FitInfo;
 
   };
@@ -45,6 +45,7 @@ namespace mitk
 
     typedef ModelBase ModelBaseType;
     typedef ModelBaseType::Pointer ModelBasePointer;
+    typedef ModelBaseType::ConstPointer ModelBaseConstPointer;
 
     typedef ModelBaseType::ParametersType ParametersType;
     typedef ModelBaseType::StaticParameterValueType StaticParameterValueType;
@@ -75,6 +76,13 @@ namespace mitk
      * Any local static parameter stay default.*/
     virtual ModelBasePointer GenerateParameterizedModel() const = 0;
 
+    /** Indicates if GetLocalStaticParameters() may return parameters for any position.
+     * If not, the models of all positions are parameterized identically. Voxel wise processing
+     * can then generate one model by GenerateParameterizedModel() before it starts and share it
+     * read only by all positions and threads, instead of generating a model per voxel.
+     * @remark The default implementation returns true.*/
+    virtual bool HasLocalStaticParameters() const;
+
     itkSetMacro(DefaultTimeGrid, TimeGridType);
     itkGetConstReferenceMacro(DefaultTimeGrid, TimeGridType);
 
@@ -89,6 +97,7 @@ namespace mitk
 
     /** The default time grid that should be set to generated models.*/
     TimeGridType m_DefaultTimeGrid;
+
   private:
 
     //No copy constructor allowed
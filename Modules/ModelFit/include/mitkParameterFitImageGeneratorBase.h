@@ -18,6 +18,7 @@ found in the LICENSE file.
 #include <mitkImage.h>
 
 #include "mitkModelBase.h"
+#include "mitkSparseParameterMapStore.h"
 
 #include "MitkModelFitExports.h"
 
@@ -30,6 +31,11 @@ namespace mitk
    * - criterion images: Images that encode the criterion value of the fitting strategy for the fitted parameters
    * - evaluation parameter images: Images that encode measures of additional evaluation cost functions defined by the user. (These were not part of the fitting strategy)
    * .
+   * If sparse output is activated (and supported by the generator, see SupportsSparseOutput()), the results are
+   * only stored for the voxels inside the mask (see SparseParameterMapStore). The images are then materialized
+   * on request: the Get...Images() methods generate the images of the respective group, GetResultImage()
+   * only generates the image of one parameter. Materialized images are kept until the next generation, so
+   * repeated requests return the same image instances.
    */
   class MITKMODELFIT_EXPORT ParameterFitImageGeneratorBase: public ::itk::Object
   {
@@ -67,6 +73,25 @@ namespace mitk
     /** Returns the generated evaluation parameter images. Triggers Generate() if result is outdated.*/
     ParameterImageMapType GetEvaluationParameterImages();
 
+    /** Returns the image of one result (parameter, derived parameter, criterion or evaluation parameter).
+    * In sparse output mode only this image is materialized. Triggers Generate() if result is outdated.
+    * Throws if no result of the passed name exists.*/
+    Image::Pointer GetResultImage(const ParameterNameType& name);
+
+    /** Returns the sparse result store of the last generation or nullptr if the results were generated densely.
+    * Triggers Generate() if result is outdated.*/
+    const SparseParameterMapStore* GetSparseResults();
+
+    /** Indicates if the generator should only store the results of masked voxels.
+    * It is ignored if the generator does not support sparse output in its current configuration.*/
+    itkSetMacro(SparseOutput, bool);
+    itkGetConstMacro(SparseOutput, bool);
+    itkBooleanMacro(SparseOutput);
+
+    /** Indicates if the generator can produce sparse output with its current configuration
+    * (e.g. because a mask is set). Default implementation returns false.*/
+    virtual bool SupportsSparseOutput() const;
+
     /** Returns the names of the fitted/generated parameters, that will be generated. These are also the keys of the related image map.*/
     virtual ParameterNamesType GetParameterNames() const = 0;
 
@@ -80,7 +105,7 @@ namespace mitk
     virtual ParameterNamesType GetEvaluationParameterNames() const = 0;
 
   protected:
-    ParameterFitImageGeneratorBase() {};
+    ParameterFitImageGeneratorBase() : m_SparseOutput(false) {};
     ~ParameterFitImageGeneratorBase() override {};
 
     virtual bool HasOutdatedResult() const;
@@ -88,10 +113,24 @@ namespace mitk
     * Throw an exception for a non valid or missing input.*/
     virtual void CheckValidInputs() const;
     virtual void DoFitAndGetResults(ParameterImageMapType& parameterImages, ParameterImageMapType& derivedParameterImages, ParameterImageMapType& criterionImages, ParameterImageMapType& evaluationParameterImages) = 0;
+    /** Sparse counterpart of DoFitAndGetResults. Implementations must initialize the passed store, add all results
+    * to it and return the names of the results of each group. Only called if SupportsSparseOutput() returns true.
+    * Default implementation throws.*/
+    virtual void DoSparseFitAndGetResults(SparseParameterMapStore* results, ParameterNamesType& parameterNames, ParameterNamesType& derivedParameterNames, ParameterNamesType& criterionNames, ParameterNamesType& evaluationParameterNames);
 
     itk::TimeStamp m_GenerationTimeStamp;
 
   private:
+    /** Adds the images of all passed sparse results to the image map that are not materialized yet.*/
+    void MaterializeSparseResults(const ParameterNamesType& names, ParameterImageMapType& imageMap) const;
+
+    bool m_SparseOutput;
+
+    SparseParameterMapStore::Pointer m_SparseResults;
+    ParameterNamesType m_SparseParameterNames;
+    ParameterNamesType m_SparseDerivedParameterNames;
+    ParameterNamesType m_SparseCriterionNames;
+    ParameterNamesType m_SparseEvaluationParameterNames;
 
     ParameterImageMapType m_ParameterImageMap;
     ParameterImageMapType m_DerivedParameterImageMap;
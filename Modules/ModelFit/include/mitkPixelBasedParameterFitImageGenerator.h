@@ -81,6 +81,9 @@ public:
 
     ParameterNamesType GetEvaluationParameterNames() const override;
 
+    /** Sparse output is supported if a mask is set.*/
+    bool SupportsSparseOutput() const override;
+
 protected:
   PixelBasedParameterFitImageGenerator() : m_Progress(0), m_TimeGridByParameterizer(false)
   {
@@ -94,14 +97,22 @@ protected:
     template <typename TPixel, unsigned int VDim>
     void DoParameterFit(itk::Image<TPixel, VDim>* image);
 
+    template <typename TPixel, unsigned int VDim>
+    void DoSparseParameterFit(itk::Image<TPixel, VDim>* image, SparseParameterMapStore* results);
+
     template <typename TPixel, unsigned int VDim>
     void DoPrepareMask(itk::Image<TPixel, VDim>* image);
 
+    /** Sets the time grid of the dynamic image as default time grid of the parameterizer
+    * or checks if the default time grid matches, if TimeGridByParameterizer is set.*/
+    void InitializeTimeGrid();
+
     void onFitProgressEvent(::itk::Object* caller, const ::itk::EventObject& eventObject);
 
     bool HasOutdatedResult() const override;
     void CheckValidInputs() const override;
     void DoFitAndGetResults(ParameterImageMapType& parameterImages, ParameterImageMapType& derivedParameterImages, ParameterImageMapType& criterionImages, ParameterImageMapType& evaluationParameterImages) override;
+    void DoSparseFitAndGetResults(SparseParameterMapStore* results, ParameterNamesType& parameterNames, ParameterNamesType& derivedParameterNames, ParameterNamesType& criterionNames, ParameterNamesType& evaluationParameterNames) override;
 
 private:
     Image::Pointer m_DynamicImage;
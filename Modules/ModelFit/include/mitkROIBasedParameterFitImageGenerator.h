@@ -84,6 +84,10 @@ public:
 
     ParameterNamesType GetEvaluationParameterNames() const override;
 
+    /** Sparse output is supported if a 3D mask is set. The results are stored as uniform parameters
+     * (one value per result for the whole ROI).*/
+    bool SupportsSparseOutput() const override;
+
 protected:
   ROIBasedParameterFitImageGenerator() : m_Progress(0)
   {
@@ -100,6 +104,10 @@ protected:
     bool HasOutdatedResult() const override;
     void CheckValidInputs() const override;
     void DoFitAndGetResults(ParameterImageMapType& parameterImages, ParameterImageMapType& derivedParameterImages, ParameterImageMapType& criterionImages, ParameterImageMapType& evaluationParameterImages) override;
+    void DoSparseFitAndGetResults(SparseParameterMapStore* results, ParameterNamesType& parameterNames, ParameterNamesType& derivedParameterNames, ParameterNamesType& criterionNames, ParameterNamesType& evaluationParameterNames) override;
+
+    /** Fits the signal and returns the fit functor output. The parameterized model used for the fit is returned by parameterizedModel.*/
+    ModelFitFunctorBase::OutputPixelArrayType FitSignal(ParameterizerType::ModelBasePointer& parameterizedModel);
 
 private:
     Image::Pointer m_Mask;
@@ -0,0 +1,127 @@
+/*============================================================================
+
+The Medical Imaging Interaction Toolkit (MITK)
+
+Copyright (c) German Cancer Research Center (DKFZ)
+All rights reserved.
+
+Use of this source code is governed by a 3-clause BSD license that can be
+found in the LICENSE file.
+
+============================================================================*/
+
+#ifndef mitkSparseParameterMapStore_h
+#define mitkSparseParameterMapStore_h
+
+#include <itkObject.h>
+
+#include "mitkBaseGeometry.h"
+#include "mitkImage.h"
+#include "mitkModelBase.h"
+
+#include "MitkModelFitExports.h"
+
+#include <map>
+#include <vector>
+
+namespace mitk
+{
+  /** Compact storage for the results of a masked model fit.
+   * Instead of one full image per result parameter, the store keeps the voxels inside the mask once as
+   * runs of consecutive linear buffer offsets and, for every parameter, one value per masked voxel (in the
+   * order of the runs). Parameters that have the same value for all masked voxels (e.g. the results of a
+   * ROI based fit) are stored as a single uniform value. Images are only materialized on request via
+   * GetImage(); voxels outside of the mask are set to 0 (like the images generated by the dense fit generators).
+   * For a mask covering a small part of the image this reduces the memory needed for the results
+   * from (#parameters * #voxels) to (#runs + #masked voxels * #voxel wise parameters) values.
+   */
+  class MITKMODELFIT_EXPORT SparseParameterMapStore : public ::itk::Object
+  {
+  public:
+    mitkClassMacroItkParent(SparseParameterMapStore, ::itk::Object);
+    itkFactorylessNewMacro(Self);
+
+    using ValueType = ScalarType;
+    using ValueVectorType = std::vector<ValueType>;
+    using OffsetType = std::size_t;
+
+    /** Consecutive voxels (along the first image axis) starting at the linear buffer offset Offset.*/
+    struct VoxelRun
+    {
+      OffsetType Offset;
+      std::size_t Length;
+    };
+    using RunVectorType = std::vector<VoxelRun>;
+
+    using ParameterNameType = ModelBase::ParameterNameType;
+    using ParameterNamesType = ModelBase::ParameterNamesType;
+
+    /** Resets the store. The geometry defines the geometry of the materialized images (it is cloned),
+     * runs are the voxel runs that should be stored. All parameters are removed.*/
+    void Initialize(const BaseGeometry* geometry, const RunVectorType& runs);
+
+    /** Convenience version of Initialize(). All voxels of the (3D) mask with a value > 0 are stored.
+     * If no geometry is passed, the geometry of the mask is used.*/
+    void InitializeByMask(const Image* mask, const BaseGeometry* geometry = nullptr);
+
+    /** Number of stored (masked) voxels.*/
+    std::size_t GetNumberOfVoxels() const;
+
+    const RunVectorType& GetRuns() const;
+
+    const BaseGeometry* GetGeometry() const;
+
+    /** Adds a parameter with one value per stored voxel (all initialized with 0) and returns its column index.
+     * If the parameter already exists, its index is returned.*/
+    std::size_t AddParameter(const ParameterNameType& name);
+
+    /** Adds a parameter that has the passed value for all stored voxels and returns its column index.
+     * If the parameter already exists, an exception is thrown.*/
+    std::size_t AddUniformParameter(const ParameterNameType& name, ValueType value);
+
+    bool HasParameter(const ParameterNameType& name) const;
+
+    /** Indicates if the parameter was added by AddUniformParameter(). Throws if the parameter does not exist.*/
+    bool IsUniformParameter(const ParameterNameType& name) const;
+
+    /** Returns the names of all parameters in the order they were added.*/
+    ParameterNamesType GetParameterNames() const;
+
+    /** Returns the values of the parameter. Value i belongs to the i-th voxel of the runs; uniform parameters
+     * only have one value. Throws if the parameter does not exist.*/
+    const ValueVectorType& GetValues(const ParameterNameType& name) const;
+
+    /** Sets the value of a voxel wise parameter (by column index, see AddParameter()) for the i-th stored voxel.
+     * Different voxels may be set concurrently.*/
+    void SetValue(std::size_t parameterIndex, std::size_t voxelIndex, ValueType value)
+    {
+      m_Values[parameterIndex][voxelIndex] = value;
+    };
+
+    /** Creates a new image for the passed parameter. Throws if the parameter does not exist.
+     * Every call generates a new image instance; the store itself does not keep the image.*/
+    Image::Pointer GetImage(const ParameterNameType& name) const;
+
+    /** Memory (in bytes) occupied by the stored runs and values.*/
+    std::size_t GetMemorySize() const;
+
+  protected:
+    SparseParameterMapStore() = default;
+    ~SparseParameterMapStore() override = default;
+
+  private:
+    std::size_t AddValues(const ParameterNameType& name, ValueVectorType values, bool uniform);
+
+    BaseGeometry::Pointer m_Geometry;
+    RunVectorType m_Runs;
+    std::size_t m_NumberOfVoxels = 0;
+
+    ParameterNamesType m_Names;
+    std::map<ParameterNameType, std::size_t> m_NameIndexMap;
+    std::vector<ValueVectorType> m_Values;
+    std::vector<bool> m_Uniform;
+  };
+
+}
+
+#endif
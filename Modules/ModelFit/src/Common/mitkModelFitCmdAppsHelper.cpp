@@ -75,21 +75,29 @@ MITKMODELFIT_EXPORT void mitk::storeModelFitGeneratorResults(const std::string&
 {
   if (generator)
   {
-    for (const auto &imageIterator : generator->GetParameterImages())
+    //In sparse output mode the results are materialized one by one directly from the sparse store (and
+    //not cached by the generator), so that only one result image exists at a time.
+    const SparseParameterMapStore* sparseResults = generator->GetSparseResults();
+    auto getResultImage = [generator, sparseResults](const std::string& name)
     {
-      storeModelFitResultImage(outputPathTemplate, imageIterator.first, imageIterator.second, mitk::modelFit::Parameter::ParameterType, fitSession);
+      return nullptr != sparseResults ? sparseResults->GetImage(name) : generator->GetResultImage(name);
+    };
+
+    for (const auto &aName : generator->GetParameterNames())
+    {
+      storeModelFitResultImage(outputPathTemplate, aName, getResultImage(aName), mitk::modelFit::Parameter::ParameterType, fitSession);
     }
-    for (const auto &imageIterator : generator->GetDerivedParameterImages())
+    for (const auto &aName : generator->GetDerivedParameterNames())
     {
-      storeModelFitResultImage(outputPathTemplate, imageIterator.first, imageIterator.second, mitk::modelFit::Parameter::DerivedType, fitSession);
+      storeModelFitResultImage(outputPathTemplate, aName, getResultImage(aName), mitk::modelFit::Parameter::DerivedType, fitSession);
     }
-    for (const auto &imageIterator : generator->GetCriterionImages())
+    for (const auto &aName : generator->GetCriterionNames())
     {
-      storeModelFitResultImage(outputPathTemplate, imageIterator.first, imageIterator.second, mitk::modelFit::Parameter::CriterionType, fitSession);
+      storeModelFitResultImage(outputPathTemplate, aName, getResultImage(aName), mitk::modelFit::Parameter::CriterionType, fitSession);
     }
-    for (const auto &imageIterator : generator->GetEvaluationParameterImages())
+    for (const auto &aName : generator->GetEvaluationParameterNames())
     {
-      storeModelFitResultImage(outputPathTemplate, imageIterator.first, imageIterator.second, mitk::modelFit::Parameter::EvaluationType, fitSession);
+      storeModelFitResultImage(outputPathTemplate, aName, getResultImage(aName), mitk::modelFit::Parameter::EvaluationType, fitSession);
     }
   }
 }
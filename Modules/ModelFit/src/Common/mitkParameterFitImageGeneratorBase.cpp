@@ -11,6 +11,9 @@ found in the LICENSE file.
 ============================================================================*/
 
 #include "mitkParameterFitImageGeneratorBase.h"
+#include "mitkExceptionMacro.h"
+
+#include <algorithm>
 
 bool
   mitk::ParameterFitImageGeneratorBase::HasOutdatedResult() const
@@ -41,12 +44,32 @@ void
   ParameterImageMapType criterionImages;
   ParameterImageMapType evaluationImages;
 
-  DoFitAndGetResults(paramImages, derivedImages, criterionImages, evaluationImages);
+  //release the old results before the new fit allocates its memory
+  m_ParameterImageMap.clear();
+  m_DerivedParameterImageMap.clear();
+  m_CriterionImageMap.clear();
+  m_EvaluationParameterImageMap.clear();
+  m_SparseResults = nullptr;
+  m_SparseParameterNames.clear();
+  m_SparseDerivedParameterNames.clear();
+  m_SparseCriterionNames.clear();
+  m_SparseEvaluationParameterNames.clear();
+
+  if (m_SparseOutput && this->SupportsSparseOutput())
+  {
+    SparseParameterMapStore::Pointer results = SparseParameterMapStore::New();
+    DoSparseFitAndGetResults(results, m_SparseParameterNames, m_SparseDerivedParameterNames, m_SparseCriterionNames, m_SparseEvaluationParameterNames);
+    m_SparseResults = results;
+  }
+  else
+  {
+    DoFitAndGetResults(paramImages, derivedImages, criterionImages, evaluationImages);
 
-  m_ParameterImageMap = paramImages;
-  m_DerivedParameterImageMap = derivedImages;
-  m_CriterionImageMap = criterionImages;
-  m_EvaluationParameterImageMap = evaluationImages;
+    m_ParameterImageMap = paramImages;
+    m_DerivedParameterImageMap = derivedImages;
+    m_CriterionImageMap = criterionImages;
+    m_EvaluationParameterImageMap = evaluationImages;
+  }
 
   this->m_GenerationTimeStamp.Modified();
 };
@@ -59,6 +82,11 @@ mitk::ParameterFitImageGeneratorBase::ParameterImageMapType
     Generate();
   }
 
+  if (m_SparseResults.IsNotNull())
+  {
+    this->MaterializeSparseResults(m_SparseParameterNames, m_ParameterImageMap);
+  }
+
   return m_ParameterImageMap;
 };
 
@@ -70,6 +98,11 @@ mitk::ParameterFitImageGeneratorBase::ParameterImageMapType
     Generate();
   }
 
+  if (m_SparseResults.IsNotNull())
+  {
+    this->MaterializeSparseResults(m_SparseDerivedParameterNames, m_DerivedParameterImageMap);
+  }
+
   return m_DerivedParameterImageMap;
 };
 
@@ -81,6 +114,11 @@ mitk::ParameterFitImageGeneratorBase::ParameterImageMapType
     Generate();
   }
 
+  if (m_SparseResults.IsNotNull())
+  {
+    this->MaterializeSparseResults(m_SparseCriterionNames, m_CriterionImageMap);
+  }
+
   return m_CriterionImageMap;
 };
 
@@ -92,5 +130,83 @@ mitk::ParameterFitImageGeneratorBase::ParameterImageMapType
     Generate();
   }
 
+  if (m_SparseResults.IsNotNull())
+  {
+    this->MaterializeSparseResults(m_SparseEvaluationParameterNames, m_EvaluationParameterImageMap);
+  }
+
   return m_EvaluationParameterImageMap;
 };
+
+mitk::Image::Pointer
+  mitk::ParameterFitImageGeneratorBase::GetResultImage(const ParameterNameType& name)
+{
+  if (this->HasOutdatedResult())
+  {
+    Generate();
+  }
+
+  for (const auto* imageMap : { &m_ParameterImageMap, &m_DerivedParameterImageMap, &m_CriterionImageMap, &m_EvaluationParameterImageMap })
+  {
+    auto finding = imageMap->find(name);
+    if (finding != imageMap->end())
+    {
+      return finding->second;
+    }
+  }
+
+  if (m_SparseResults.IsNotNull())
+  {
+    const std::pair<const ParameterNamesType*, ParameterImageMapType*> groups[] = {
+      { &m_SparseParameterNames, &m_ParameterImageMap },
+      { &m_SparseDerivedParameterNames, &m_DerivedParameterImageMap },
+      { &m_SparseCriterionNames, &m_CriterionImageMap },
+      { &m_SparseEvaluationParameterNames, &m_EvaluationParameterImageMap } };
+
+    for (const auto& group : groups)
+    {
+      if (std::find(group.first->begin(), group.first->end(), name) != group.first->end())
+      {
+        this->MaterializeSparseResults({ name }, *(group.second));
+        return (*(group.second))[name];
+      }
+    }
+  }
+
+  mitkThrow() << "Cannot get result image. Generator has no result with the requested name. Name: " << name;
+};
+
+const mitk::SparseParameterMapStore*
+  mitk::ParameterFitImageGeneratorBase::GetSparseResults()
+{
+  if (this->HasOutdatedResult())
+  {
+    Generate();
+  }
+
+  return m_SparseResults;
+};
+
+bool
+  mitk::ParameterFitImageGeneratorBase::SupportsSparseOutput() const
+{
+  return false;
+};
+
+void
+  mitk::ParameterFitImageGeneratorBase::DoSparseFitAndGetResults(SparseParameterMapStore* /*results*/, ParameterNamesType& /*parameterNames*/, ParameterNamesType& /*derivedParameterNames*/, ParameterNamesType& /*criterionNames*/, ParameterNamesType& /*evaluationParameterNames*/)
+{
+  mitkThrow() << "Generator does not support sparse output.";
+};
+
+void
+  mitk::ParameterFitImageGeneratorBase::MaterializeSparseResults(const ParameterNamesType& names, ParameterImageMapType& imageMap) const
+{
+  for (const auto& name : names)
+  {
+    if (imageMap.find(name) == imageMap.end())
+    {
+      imageMap.insert(std::make_pair(name, m_SparseResults->GetImage(name)));
+    }
+  }
+};
@@ -12,6 +12,7 @@ found in the LICENSE file.
 
 #include "itkCommand.h"
 #include "itkMultiOutputNaryFunctorImageFilter.h"
+#include "itkMultiThreaderBase.h"
 
 #include "mitkPixelBasedParameterFitImageGenerator.h"
 #include "mitkImageTimeSelector.h"
@@ -21,6 +22,8 @@ found in the LICENSE file.
 
 #include "mitkExtractTimeGrid.h"
 
+#include <algorithm>
+
 void
   mitk::PixelBasedParameterFitImageGenerator::
   onFitProgressEvent(::itk::Object* caller, const ::itk::EventObject& /*eventObject*/)
@@ -108,19 +111,7 @@ void
     fitFilter->SetInput(i,frameImage);
   }
 
-  ModelBaseType::TimeGridType timeGrid = ExtractTimeGrid(m_DynamicImage);
-  if (m_TimeGridByParameterizer)
-  {
-    if (timeGrid.GetSize() != m_ModelParameterizer->GetDefaultTimeGrid().GetSize())
-    {
-      mitkThrow() << "Cannot do fitting. Filter is set to use default time grid of the parameterizer, but grid size does not match the number of input image frames. Grid size: " << m_ModelParameterizer->GetDefaultTimeGrid().GetSize() << "; frame count: " << timeGrid.GetSize();
-    }
-
-  }
-  else
-  {
-    this->m_ModelParameterizer->SetDefaultTimeGrid(timeGrid);
-  }
+  this->InitializeTimeGrid();
 
   ModelFitFunctorPolicy functor;
 
@@ -158,6 +149,98 @@ void
   this->m_TempEvaluationResultMap.insert(debugMap.begin(), debugMap.end());
 }
 
+template <typename TPixel, unsigned int VDim>
+void
+  mitk::PixelBasedParameterFitImageGenerator::DoSparseParameterFit(itk::Image<TPixel, VDim>* image, SparseParameterMapStore* results)
+{
+  //the signals are read directly from the dynamic image, so only the masked voxels are visited
+  typename itk::Image<TPixel, VDim>::RegionType frameRegion = image->GetLargestPossibleRegion();
+  const unsigned int frameCount = frameRegion.GetSize(VDim - 1);
+  frameRegion.SetSize(VDim - 1, 1);
+  const std::size_t frameSize = frameRegion.GetNumberOfPixels();
+
+  if (frameSize != this->m_InternalMask->GetLargestPossibleRegion().GetNumberOfPixels())
+  {
+    mitkThrow() << "Cannot do fitting. Mask does not match the region of the dynamic image. Mask region: " << this->m_InternalMask->GetLargestPossibleRegion() << "; image region: " << image->GetLargestPossibleRegion();
+  }
+
+  this->InitializeTimeGrid();
+
+  ModelFitFunctorPolicy functor;
+
+  functor.SetModelFitFunctor(this->m_FitFunctor);
+  functor.SetModelParameterizer(this->m_ModelParameterizer);
+
+  const std::size_t outputCount = results->GetParameterNames().size();
+  if (functor.GetNumberOfOutputs() != outputCount)
+  {
+    mitkThrow() << "Error while generating fitted parameter images. Fit functor output size does not match expected parameter number. Output size: " << functor.GetNumberOfOutputs();
+  }
+
+  //fit the masked voxels run by run; the work is split into chunks to be able to report the progress.
+  const SparseParameterMapStore::RunVectorType& runs = results->GetRuns();
+  std::vector<std::size_t> runVoxelIndices(runs.size());
+  std::size_t voxelIndex = 0;
+  for (std::size_t r = 0; r < runs.size(); ++r)
+  {
+    runVoxelIndices[r] = voxelIndex;
+    voxelIndex += runs[r].Length;
+  }
+  const TPixel* buffer = image->GetBufferPointer();
+  const std::size_t chunkCount = std::min<std::size_t>(100, runs.size());
+
+  auto fitRun = [&](itk::SizeValueType r)
+  {
+    ModelFitFunctorPolicy::InputPixelArrayType values(frameCount);
+    for (std::size_t i = 0; i < runs[r].Length; ++i)
+    {
+      const std::size_t offset = runs[r].Offset + i;
+      const InternalMaskType::IndexType index = this->m_InternalMask->ComputeIndex(offset);
+
+      for (unsigned int t = 0; t < frameCount; ++t)
+      {
+        values[t] = buffer[offset + t * frameSize];
+      }
+
+      ModelFitFunctorPolicy::OutputPixelArrayType result = functor(values, index);
+      for (std::size_t p = 0; p < outputCount && p < result.size(); ++p)
+      {
+        results->SetValue(p, runVoxelIndices[r] + i, result[p]);
+      }
+    }
+  };
+
+  itk::MultiThreaderBase::Pointer threader = itk::MultiThreaderBase::New();
+  for (std::size_t chunk = 0; chunk < chunkCount; ++chunk)
+  {
+    const std::size_t begin = (chunk * runs.size()) / chunkCount;
+    const std::size_t end = ((chunk + 1) * runs.size()) / chunkCount;
+
+    threader->ParallelizeArray(begin, end, fitRun, nullptr);
+
+    this->m_Progress = static_cast<double>(end) / runs.size();
+    this->InvokeEvent(::itk::ProgressEvent());
+  }
+}
+
+void
+  mitk::PixelBasedParameterFitImageGenerator::InitializeTimeGrid()
+{
+  ModelBaseType::TimeGridType timeGrid = ExtractTimeGrid(m_DynamicImage);
+  if (m_TimeGridByParameterizer)
+  {
+    if (timeGrid.GetSize() != m_ModelParameterizer->GetDefaultTimeGrid().GetSize())
+    {
+      mitkThrow() << "Cannot do fitting. Filter is set to use default time grid of the parameterizer, but grid size does not match the number of input image frames. Grid size: " << m_ModelParameterizer->GetDefaultTimeGrid().GetSize() << "; frame count: " << timeGrid.GetSize();
+    }
+
+  }
+  else
+  {
+    this->m_ModelParameterizer->SetDefaultTimeGrid(timeGrid);
+  }
+}
+
 bool
   mitk::PixelBasedParameterFitImageGenerator::HasOutdatedResult() const
 {
@@ -233,6 +316,38 @@ void mitk::PixelBasedParameterFitImageGenerator::DoFitAndGetResults(ParameterIma
 
 };
 
+bool
+  mitk::PixelBasedParameterFitImageGenerator::SupportsSparseOutput() const
+{
+  return m_Mask.IsNotNull();
+};
+
+void mitk::PixelBasedParameterFitImageGenerator::DoSparseFitAndGetResults(SparseParameterMapStore* results, ParameterNamesType& parameterNames, ParameterNamesType& derivedParameterNames, ParameterNamesType& criterionNames, ParameterNamesType& evaluationParameterNames)
+{
+  this->m_Progress = 0;
+
+  AccessFixedDimensionByItk(m_Mask, mitk::PixelBasedParameterFitImageGenerator::DoPrepareMask, 3);
+
+  results->InitializeByMask(m_Mask, m_DynamicImage->GetGeometry());
+
+  parameterNames = this->GetParameterNames();
+  derivedParameterNames = this->GetDerivedParameterNames();
+  criterionNames = this->GetCriterionNames();
+  //contains also the debug parameters (if generated)
+  evaluationParameterNames = this->GetEvaluationParameterNames();
+
+  //the order of the parameters in the store must match the order of the fit functor outputs
+  for (const auto* names : { &parameterNames, &derivedParameterNames, &criterionNames, &evaluationParameterNames })
+  {
+    for (const auto& name : *names)
+    {
+      results->AddParameter(name);
+    }
+  }
+
+  AccessFixedDimensionByItk_n(m_DynamicImage, mitk::PixelBasedParameterFitImageGenerator::DoSparseParameterFit, 4, (results));
+};
+
 double
   mitk::PixelBasedParameterFitImageGenerator::GetProgress() const
 {
@@ -129,18 +129,13 @@ mitk::ROIBasedParameterFitImageGenerator::CheckValidInputs() const
 
 };
 
-void mitk::ROIBasedParameterFitImageGenerator::DoFitAndGetResults(ParameterImageMapType&
-    parameterImages, ParameterImageMapType& derivedParameterImages,
-    ParameterImageMapType& criterionImages, ParameterImageMapType& evaluationParameterImages)
+mitk::ModelFitFunctorBase::OutputPixelArrayType
+mitk::ROIBasedParameterFitImageGenerator::FitSignal(ParameterizerType::ModelBasePointer& parameterizedModel)
 {
-  this->m_Progress = 0;
-
-  //fit the signal
   ModelParameterizerBase::IndexType index;
   index.Fill(0);
   this->m_ModelParameterizer->SetDefaultTimeGrid(m_TimeGrid);
-  ParameterizerType::ModelBasePointer parameterizedModel =
-    m_ModelParameterizer->GenerateParameterizedModel(index);
+  parameterizedModel = m_ModelParameterizer->GenerateParameterizedModel(index);
   ParameterizerType::ParametersType initialParameters =
     m_ModelParameterizer->GetInitialParameterization(index);
 
@@ -151,8 +146,18 @@ void mitk::ROIBasedParameterFitImageGenerator::DoFitAndGetResults(ParameterImage
     inputValues.push_back(*pos);
   }
 
-  ModelFitFunctorBase::OutputPixelArrayType fitResult = m_FitFunctor->Compute(inputValues,
-      parameterizedModel, initialParameters);
+  return m_FitFunctor->Compute(inputValues, parameterizedModel, initialParameters);
+}
+
+void mitk::ROIBasedParameterFitImageGenerator::DoFitAndGetResults(ParameterImageMapType&
+    parameterImages, ParameterImageMapType& derivedParameterImages,
+    ParameterImageMapType& criterionImages, ParameterImageMapType& evaluationParameterImages)
+{
+  this->m_Progress = 0;
+
+  //fit the signal
+  ParameterizerType::ModelBasePointer parameterizedModel;
+  ModelFitFunctorBase::OutputPixelArrayType fitResult = this->FitSignal(parameterizedModel);
 
   //generate the results maps
   ParameterImageMapType tempResultMap;
@@ -222,6 +227,53 @@ void mitk::ROIBasedParameterFitImageGenerator::DoFitAndGetResults(ParameterImage
 
 };
 
+bool
+mitk::ROIBasedParameterFitImageGenerator::SupportsSparseOutput() const
+{
+  return m_Mask.IsNotNull() && m_Mask->GetDimension() == 3;
+};
+
+void mitk::ROIBasedParameterFitImageGenerator::DoSparseFitAndGetResults(SparseParameterMapStore* results,
+    ParameterNamesType& parameterNames, ParameterNamesType& derivedParameterNames,
+    ParameterNamesType& criterionNames, ParameterNamesType& evaluationParameterNames)
+{
+  this->m_Progress = 0;
+
+  //fit the signal
+  ParameterizerType::ModelBasePointer parameterizedModel;
+  ModelFitFunctorBase::OutputPixelArrayType fitResult = this->FitSignal(parameterizedModel);
+
+  parameterNames = parameterizedModel->GetParameterNames();
+  derivedParameterNames = parameterizedModel->GetDerivedParameterNames();
+  criterionNames = this->m_FitFunctor->GetCriterionNames();
+  evaluationParameterNames = this->m_FitFunctor->GetEvaluationParameterNames();
+  ModelFitFunctorBase::ParameterNamesType debugParamNames = this->m_FitFunctor->GetDebugParameterNames();
+  //add debug params (if they are generated) to the evaluation results
+  evaluationParameterNames.insert(evaluationParameterNames.end(), debugParamNames.begin(), debugParamNames.end());
+
+  if (fitResult.size() != (parameterNames.size() + derivedParameterNames.size() + criterionNames.size() +
+                           evaluationParameterNames.size()))
+  {
+    mitkThrow() <<
+                "Error while generating fitted parameter images. Fit functor output size does not match expected parameter number. Output size: "
+                << fitResult.size();
+  }
+
+  //the fit result is the same for every voxel of the mask, so it is stored once per parameter
+  results->InitializeByMask(m_Mask);
+
+  ModelFitFunctorBase::OutputPixelArrayType::size_type resultPos = 0;
+  for (const auto* names : { &parameterNames, &derivedParameterNames, &criterionNames, &evaluationParameterNames })
+  {
+    for (const auto& name : *names)
+    {
+      results->AddUniformParameter(name, fitResult[resultPos++]);
+    }
+  }
+
+  this->m_Progress = 1;
+};
+
 double
 mitk::ROIBasedParameterFitImageGenerator::GetProgress() const
 {
@@ -0,0 +1,235 @@
+/*============================================================================
+
+The Medical Imaging Interaction Toolkit (MITK)
+
+Copyright (c) German Cancer Research Center (DKFZ)
+All rights reserved.
+
+Use of this source code is governed by a 3-clause BSD license that can be
+found in the LICENSE file.
+
+============================================================================*/
+
+#include "mitkSparseParameterMapStore.h"
+
+#include "itkImageScanlineConstIterator.h"
+
+#include "mitkExceptionMacro.h"
+#include "mitkImageAccessByItk.h"
+#include "mitkImageWriteAccessor.h"
+
+#include <algorithm>
+#include <cstring>
+
+namespace
+{
+  /** Collects the runs of masked voxels line by line, so that consecutive masked voxels of a line form one run.*/
+  template <typename TPixel, unsigned int VDim>
+  void CollectMaskRuns(const itk::Image<TPixel, VDim>* mask, mitk::SparseParameterMapStore::RunVectorType& runs)
+  {
+    using MaskType = itk::Image<TPixel, VDim>;
+    itk::ImageScanlineConstIterator<MaskType> maskItr(mask, mask->GetBufferedRegion());
+
+    mitk::SparseParameterMapStore::OffsetType offset = 0;
+    while (!maskItr.IsAtEnd())
+    {
+      bool inRun = false;
+      while (!maskItr.IsAtEndOfLine())
+      {
+        if (maskItr.Get() > 0)
+        {
+          if (inRun)
+          {
+            ++runs.back().Length;
+          }
+          else
+          {
+            runs.push_back({ offset, 1 });
+            inRun = true;
+          }
+        }
+        else
+        {
+          inRun = false;
+        }
+        ++maskItr;
+        ++offset;
+      }
+      maskItr.NextLine();
+    }
+  }
+}
+
+void
+mitk::SparseParameterMapStore::Initialize(const BaseGeometry* geometry, const RunVectorType& runs)
+{
+  if (!geometry)
+  {
+    mitkThrow() << "Cannot initialize sparse parameter map store. Passed geometry is nullptr.";
+  }
+
+  m_Geometry = geometry->Clone();
+  m_Runs = runs;
+  m_NumberOfVoxels = 0;
+  for (const auto& run : m_Runs)
+  {
+    m_NumberOfVoxels += run.Length;
+  }
+  m_Names.clear();
+  m_NameIndexMap.clear();
+  m_Values.clear();
+  m_Uniform.clear();
+
+  this->Modified();
+}
+
+void
+mitk::SparseParameterMapStore::InitializeByMask(const Image* mask, const BaseGeometry* geometry)
+{
+  if (!mask)
+  {
+    mitkThrow() << "Cannot initialize sparse parameter map store. Passed mask is nullptr.";
+  }
+
+  RunVectorType runs;
+  AccessFixedDimensionByItk_n(mask, CollectMaskRuns, 3, (runs));
+
+  this->Initialize(geometry ? geometry : mask->GetGeometry(), runs);
+}
+
+std::size_t
+mitk::SparseParameterMapStore::GetNumberOfVoxels() const
+{
+  return m_NumberOfVoxels;
+}
+
+const mitk::SparseParameterMapStore::RunVectorType&
+mitk::SparseParameterMapStore::GetRuns() const
+{
+  return m_Runs;
+}
+
+const mitk::BaseGeometry*
+mitk::SparseParameterMapStore::GetGeometry() const
+{
+  return m_Geometry;
+}
+
+std::size_t
+mitk::SparseParameterMapStore::AddValues(const ParameterNameType& name, ValueVectorType values, bool uniform)
+{
+  const std::size_t index = m_Values.size();
+  m_Names.push_back(name);
+  m_NameIndexMap.insert(std::make_pair(name, index));
+  m_Values.push_back(std::move(values));
+  m_Uniform.push_back(uniform);
+
+  this->Modified();
+  return index;
+}
+
+std::size_t
+mitk::SparseParameterMapStore::AddParameter(const ParameterNameType& name)
+{
+  auto finding = m_NameIndexMap.find(name);
+  if (finding != m_NameIndexMap.end())
+  {
+    return finding->second;
+  }
+
+  return this->AddValues(name, ValueVectorType(m_NumberOfVoxels, 0.0), false);
+}
+
+std::size_t
+mitk::SparseParameterMapStore::AddUniformParameter(const ParameterNameType& name, ValueType value)
+{
+  if (this->HasParameter(name))
+  {
+    mitkThrow() << "Cannot add uniform parameter. Sparse parameter map store already contains the parameter. Parameter name: " << name;
+  }
+
+  return this->AddValues(name, ValueVectorType(1, value), true);
+}
+
+bool
+mitk::SparseParameterMapStore::HasParameter(const ParameterNameType& name) const
+{
+  return m_NameIndexMap.find(name) != m_NameIndexMap.end();
+}
+
+bool
+mitk::SparseParameterMapStore::IsUniformParameter(const ParameterNameType& name) const
+{
+  auto finding = m_NameIndexMap.find(name);
+  if (finding == m_NameIndexMap.end())
+  {
+    mitkThrow() << "Sparse parameter map store does not contain the requested parameter. Parameter name: " << name;
+  }
+
+  return m_Uniform[finding->second];
+}
+
+mitk::SparseParameterMapStore::ParameterNamesType
+mitk::SparseParameterMapStore::GetParameterNames() const
+{
+  return m_Names;
+}
+
+const mitk::SparseParameterMapStore::ValueVectorType&
+mitk::SparseParameterMapStore::GetValues(const ParameterNameType& name) const
+{
+  auto finding = m_NameIndexMap.find(name);
+  if (finding == m_NameIndexMap.end())
+  {
+    mitkThrow() << "Sparse parameter map store does not contain the requested parameter. Parameter name: " << name;
+  }
+
+  return m_Values[finding->second];
+}
+
+mitk::Image::Pointer
+mitk::SparseParameterMapStore::GetImage(const ParameterNameType& name) const
+{
+  const ValueVectorType& values = this->GetValues(name);
+  const bool uniform = this->IsUniformParameter(name);
+
+  Image::Pointer result = Image::New();
+  result->Initialize(MakeScalarPixelType<ValueType>(), *m_Geometry);
+
+  const std::size_t voxelCount = static_cast<std::size_t>(result->GetDimension(0)) * result->GetDimension(1) * result->GetDimension(2);
+  if (!m_Runs.empty() && m_Runs.back().Offset + m_Runs.back().Length > voxelCount)
+  {
+    mitkThrow() << "Cannot generate image for parameter \"" << name << "\". Stored voxel runs exceed the image defined by the geometry.";
+  }
+
+  ImageWriteAccessor accessor(result);
+  auto buffer = static_cast<ValueType*>(accessor.GetData());
+  std::memset(buffer, 0, voxelCount * sizeof(ValueType));
+
+  auto valueItr = values.cbegin();
+  for (const auto& run : m_Runs)
+  {
+    if (uniform)
+    {
+      std::fill_n(buffer + run.Offset, run.Length, values.front());
+    }
+    else
+    {
+      std::copy_n(valueItr, run.Length, buffer + run.Offset);
+      valueItr += run.Length;
+    }
+  }
+
+  return result;
+}
+
+std::size_t
+mitk::SparseParameterMapStore::GetMemorySize() const
+{
+  std::size_t size = m_Runs.size() * sizeof(VoxelRun);
+  for (const auto& values : m_Values)
+  {
+    size += values.size() * sizeof(ValueType);
+  }
+  return size;
+}
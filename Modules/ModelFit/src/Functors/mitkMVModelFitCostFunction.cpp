@@ -19,12 +19,12 @@ mitk::MVModelFitCostFunction::MeasureType mitk::MVModelFitCostFunction::GetValue
 {
   MeasureType measure;
 
-  SignalType signal = m_Model->GetSignal(parameter);
+  m_Model->GetSignal(parameter, m_SignalWorkspace);
 
-  if(signal.GetSize() != m_Sample.GetSize()) itkExceptionMacro("Signal size does not matche sample size!");
-  if(signal.GetSize() == 0)  itkExceptionMacro("Signal is empty!");
+  if(m_SignalWorkspace.GetSize() != m_Sample.GetSize()) itkExceptionMacro("Signal size does not matche sample size!");
+  if(m_SignalWorkspace.GetSize() == 0)  itkExceptionMacro("Signal is empty!");
 
-  measure = CalcMeasure(parameter, signal);
+  measure = CalcMeasure(parameter, m_SignalWorkspace);
 
   return measure;
 }
@@ -36,18 +36,20 @@ void mitk::MVModelFitCostFunction::GetDerivative (const ParametersType &paramete
 
   derivative.SetSize(paramCount,m_Sample.Size());
 
+  ParametersType newParameters = parameters;
+
   for ( ParametersType::SizeValueType i = 0; i < paramCount; i++ )
   {
-    ParametersType newParameters = parameters;
-    newParameters[i] -= m_DerivativeStepLength;
+    newParameters[i] = parameters[i] - m_DerivativeStepLength;
 
     MeasureType e0 = GetValue(newParameters);
 
-    newParameters = parameters;
-    newParameters[i] += m_DerivativeStepLength;
+    newParameters[i] = parameters[i] + m_DerivativeStepLength;
 
     MeasureType e1 = GetValue(newParameters);
 
+    newParameters[i] = parameters[i];
+
     for(MeasureType::SizeValueType j = 0; j<measureCount; ++j)
     {
       derivative[i][j] = (e1[j] - e0[j]) / ( 2 * m_DerivativeStepLength );
@@ -25,9 +25,7 @@ mitk::ModelDataGenerationFunctor::Compute(const InputPixelVectorType &value) con
     parameters[i] = value[i];
   }
 
-  ModelBase::Pointer model =
-      this->m_ModelParameterizer->GenerateParameterizedModel();
-  SignalType signal = model->GetSignal(parameters);
+  SignalType signal = m_SharedModel->GetSignal(parameters);
 
   OutputPixelVectorType result;
 
@@ -39,6 +37,19 @@ mitk::ModelDataGenerationFunctor::Compute(const InputPixelVectorType &value) con
   return result;
 };
 
+void mitk::ModelDataGenerationFunctor::SetModelParameterizer(const ModelParameterizerBase *parameterizer) {
+  if (m_ModelParameterizer != parameterizer) {
+    m_ModelParameterizer = parameterizer;
+    m_SharedModel = nullptr;
+
+    if (nullptr != parameterizer) {
+      m_SharedModel = parameterizer->GenerateParameterizedModel().GetPointer();
+    }
+
+    this->Modified();
+  }
+};
+
 unsigned int mitk::ModelDataGenerationFunctor::GetNumberOfOutputs() const {
   if (m_ModelParameterizer.IsNotNull()) {
     return m_ModelParameterizer->GetDefaultTimeGrid().GetSize();
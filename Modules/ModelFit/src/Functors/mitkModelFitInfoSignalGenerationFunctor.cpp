@@ -27,7 +27,14 @@ mitk::ModelFitInfoSignalGenerationFunctor::Compute(const IndexType& currentIndex
         itkExceptionMacro("Error. Cannot compute SignalCurve. No time grid is set in parameterizer!");
       }
 
-      ModelBase::Pointer model = this->m_ModelParameterizer->GenerateParameterizedModel(currentIndex);
+      const ModelBase* model = m_SharedModel.GetPointer();
+      ModelBase::ConstPointer localModel;
+
+      if (nullptr == model)
+      {
+        localModel = this->m_ModelParameterizer->GenerateParameterizedModel(currentIndex).GetPointer();
+        model = localModel;
+      }
 
       auto params = this->CompileModelParameters(currentIndex, model);
 
@@ -50,6 +57,23 @@ mitk::ModelFitInfoSignalGenerationFunctor::CompileModelParameters(const IndexTyp
   return mitk::ConvertParameterMapToParameterVector(paramMap, model);
 };
 
+void
+mitk::ModelFitInfoSignalGenerationFunctor::SetModelParameterizer(const ModelParameterizerBase* parameterizer)
+{
+  if (m_ModelParameterizer != parameterizer)
+  {
+    m_ModelParameterizer = parameterizer;
+    m_SharedModel = nullptr;
+
+    if (nullptr != parameterizer && !parameterizer->HasLocalStaticParameters())
+    {
+      m_SharedModel = parameterizer->GenerateParameterizedModel().GetPointer();
+    }
+
+    this->Modified();
+  }
+};
+
 unsigned int
 mitk::ModelFitInfoSignalGenerationFunctor::GetNumberOfOutputs() const
     {
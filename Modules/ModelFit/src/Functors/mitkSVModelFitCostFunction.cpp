@@ -20,12 +20,12 @@ mitk::SVModelFitCostFunction::MeasureType mitk::SVModelFitCostFunction::GetValue
 {
   MeasureType measure;
 
-  SignalType signal = m_Model->GetSignal(parameter);
+  m_Model->GetSignal(parameter, m_SignalWorkspace);
 
-  if(signal.GetSize() != m_Sample.GetSize()) itkExceptionMacro("Signal size does not matche sample size!");
-  if(signal.GetSize() == 0)  itkExceptionMacro("Signal is empty!");
+  if(m_SignalWorkspace.GetSize() != m_Sample.GetSize()) itkExceptionMacro("Signal size does not matche sample size!");
+  if(m_SignalWorkspace.GetSize() == 0)  itkExceptionMacro("Signal is empty!");
 
-  measure = CalcMeasure(parameter, signal);
+  measure = CalcMeasure(parameter, m_SignalWorkspace);
 
   return measure;
 }
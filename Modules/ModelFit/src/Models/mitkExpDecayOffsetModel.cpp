@@ -53,6 +53,14 @@ mitk::ExpDecayOffsetModel::ComputeModelfunction(const ParametersType& parameters
 {
   ModelResultType signal(m_TimeGrid.GetSize());
 
+  this->ComputeModelfunctionInPlace(parameters, signal);
+
+  return signal;
+};
+
+void
+mitk::ExpDecayOffsetModel::ComputeModelfunctionInPlace(const ParametersType& parameters, ModelResultType& signal) const
+{
   const auto timeGridEnd = m_TimeGrid.end();
   ModelResultType::iterator signalPos = signal.begin();
 
@@ -61,8 +69,6 @@ mitk::ExpDecayOffsetModel::ComputeModelfunction(const ParametersType& parameters
   {
     *signalPos = parameters[0] * exp(-1.0 * (*gridPos) * parameters[1]) + parameters[2];
   }
-
-  return signal;
 };
 
 mitk::ExpDecayOffsetModel::ParameterNamesType mitk::ExpDecayOffsetModel::GetStaticParameterNames() const
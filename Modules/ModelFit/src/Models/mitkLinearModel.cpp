@@ -66,6 +66,14 @@ mitk::LinearModel::ComputeModelfunction(const ParametersType& parameters) const
 {
   ModelResultType signal(m_TimeGrid.GetSize());
 
+  this->ComputeModelfunctionInPlace(parameters, signal);
+
+  return signal;
+};
+
+void
+mitk::LinearModel::ComputeModelfunctionInPlace(const ParametersType& parameters, ModelResultType& signal) const
+{
   TimeGridType::const_iterator timeGridEnd = m_TimeGrid.end();
   ModelResultType::iterator signalPos = signal.begin();
 
@@ -74,8 +82,6 @@ mitk::LinearModel::ComputeModelfunction(const ParametersType& parameters) const
   {
     *signalPos = parameters[0] * (*gridPos) + parameters[1];
   }
-
-  return signal;
 };
 
 mitk::LinearModel::ParameterNamesType mitk::LinearModel::GetStaticParameterNames() const
@@ -146,6 +146,42 @@ mitk::ModelBase::ModelResultType mitk::ModelBase::GetSignal(const ParametersType
   return signal;
 }
 
+void mitk::ModelBase::GetSignal(const ParametersType& parameters, ModelResultType& signal) const
+{
+  if (parameters.size() != this->GetNumberOfParameters())
+  {
+    itkExceptionMacro("Passed parameter set has wrong size for model. Cannot evaluate model. Required size: "
+                      << this->GetNumberOfParameters() << "; passed parameters: " << parameters);
+  }
+
+  std::string error;
+
+  if (!ValidateModel(error))
+  {
+    itkExceptionMacro("Cannot evaluate model and return signal. Model is in an invalid state. Validation error: "
+                      << error);
+  }
+
+  if (signal.GetSize() != m_TimeGrid.GetSize())
+  {
+    signal.SetSize(m_TimeGrid.GetSize());
+  }
+
+  ComputeModelfunctionInPlace(parameters, signal);
+}
+
+void mitk::ModelBase::ComputeModelfunctionInPlace(const ParametersType& parameters, ModelResultType& signal) const
+{
+  ModelResultType result = ComputeModelfunction(parameters);
+
+  if (result.GetSize() != signal.GetSize())
+  {
+    signal.SetSize(result.GetSize());
+  }
+
+  std::copy(result.begin(), result.end(), signal.begin());
+}
+
 bool mitk::ModelBase::ValidateModel(std::string& /*error*/) const
 {
   return true;
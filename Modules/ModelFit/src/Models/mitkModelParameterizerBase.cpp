@@ -45,6 +45,12 @@ mitk::ModelParameterizerBase::GetInitialParameterization(const IndexType& curren
   return this->GetDefaultInitialParameterization();
 }
 
+bool
+mitk::ModelParameterizerBase::HasLocalStaticParameters() const
+{
+  return true;
+}
+
 void
 mitk::ModelParameterizerBase::
 SetInitialParameterizationDelegate(const InitialParameterizationDelegateBase* delegate)
@@ -53,6 +53,14 @@ mitk::T2DecayModel::ComputeModelfunction(const ParametersType& parameters) const
 {
   ModelResultType signal(m_TimeGrid.GetSize());
 
+  this->ComputeModelfunctionInPlace(parameters, signal);
+
+  return signal;
+};
+
+void
+mitk::T2DecayModel::ComputeModelfunctionInPlace(const ParametersType& parameters, ModelResultType& signal) const
+{
   ModelResultType::iterator signalPos = signal.begin();
 
   for (const auto& gridPos : m_TimeGrid)
@@ -60,8 +68,6 @@ mitk::T2DecayModel::ComputeModelfunction(const ParametersType& parameters) const
     *signalPos = parameters[0] * exp(-1.0 * gridPos/ parameters[1]);
     ++signalPos;
   }
-
-  return signal;
 };
 
 mitk::T2DecayModel::ParameterNamesType mitk::T2DecayModel::GetStaticParameterNames() const
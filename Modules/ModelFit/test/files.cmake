@@ -11,6 +11,7 @@ SET(MODULE_TESTS
   mitkSimpleBarrierConstraintCheckerTest.cpp
   mitkMVConstrainedCostFunctionDecoratorTest.cpp
   mitkConcreteModelFactoryBaseTest.cpp
+  mitkModelParameterizerBaseTest.cpp
   mitkFormulaParserTest.cpp
   mitkModelFitResultRelationRuleTest.cpp
 )
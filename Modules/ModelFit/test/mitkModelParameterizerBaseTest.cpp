@@ -0,0 +1,128 @@
+/*============================================================================
+
+The Medical Imaging Interaction Toolkit (MITK)
+
+Copyright (c) German Cancer Research Center (DKFZ)
+All rights reserved.
+
+Use of this source code is governed by a 3-clause BSD license that can be
+found in the LICENSE file.
+
+============================================================================*/
+
+#include <iostream>
+#include "mitkTestingMacros.h"
+
+#include "mitkDummyModelFitFunctor.h"
+#include "mitkLinearModelParameterizer.h"
+#include "mitkModelFitFunctorPolicy.h"
+#include "mitkT2DecayModel.h"
+
+namespace
+{
+  /** Linear model parameterizer that counts the generated models.*/
+  class CountingLinearModelParameterizer : public mitk::LinearModelParameterizer
+  {
+  public:
+    typedef CountingLinearModelParameterizer Self;
+    typedef mitk::LinearModelParameterizer Superclass;
+    typedef itk::SmartPointer< Self > Pointer;
+    typedef itk::SmartPointer< const Self > ConstPointer;
+
+    itkNewMacro(Self);
+
+    ModelBasePointer GenerateParameterizedModel(const IndexType& currentPosition) const override
+    {
+      ++m_PositionModels;
+      return Superclass::GenerateParameterizedModel(currentPosition);
+    };
+
+    ModelBasePointer GenerateParameterizedModel() const override
+    {
+      ++m_GlobalModels;
+      return Superclass::GenerateParameterizedModel();
+    };
+
+    bool HasLocalStaticParameters() const override
+    {
+      return m_LocalStaticParameters;
+    };
+
+    bool m_LocalStaticParameters = false;
+    mutable int m_PositionModels = 0;
+    mutable int m_GlobalModels = 0;
+  };
+}
+
+int mitkModelParameterizerBaseTest(int  /*argc*/, char*[] /*argv[]*/)
+{
+  MITK_TEST_BEGIN("mitkModelParameterizerBaseTest")
+
+  mitk::LinearModelParameterizer::Pointer linearParameterizer = mitk::LinearModelParameterizer::New();
+  MITK_TEST_CONDITION(!linearParameterizer->HasLocalStaticParameters(), "Testing if concrete parameterizers have no local static parameters by default.");
+
+  mitk::ModelBase::TimeGridType grid(10);
+  for (unsigned int i = 0; i < grid.GetSize(); ++i)
+  {
+    grid[i] = i * 0.5;
+  }
+
+  mitk::ModelParameterizerBase::IndexType index;
+  index.Fill(3);
+
+  mitk::ModelFitFunctorPolicy::InputPixelArrayType value(grid.GetSize(), 1.0);
+
+  //check that the fit policy shares one model if there are no local static parameters
+  CountingLinearModelParameterizer::Pointer parameterizer = CountingLinearModelParameterizer::New();
+  parameterizer->SetDefaultTimeGrid(grid);
+
+  mitk::ModelFitFunctorPolicy policy;
+  policy.SetModelFitFunctor(mitk::DummyModelFitFunctor::New());
+  policy.SetModelParameterizer(parameterizer);
+  const int generatedModels = parameterizer->m_GlobalModels;
+
+  for (int i = 0; i < 5; ++i)
+  {
+    policy(value, index);
+  }
+  policy.GetNumberOfOutputs();
+
+  MITK_TEST_CONDITION(generatedModels == 1, "Testing if the shared model is generated when the parameterizer is set.");
+  MITK_TEST_CONDITION(parameterizer->m_GlobalModels == generatedModels && parameterizer->m_PositionModels == 0, "Testing if the fitted positions share the model.");
+
+  //check that positions get their own model if there are local static parameters
+  parameterizer->m_LocalStaticParameters = true;
+  policy.SetModelParameterizer(parameterizer);
+
+  for (int i = 0; i < 5; ++i)
+  {
+    policy(value, index);
+  }
+
+  MITK_TEST_CONDITION(parameterizer->m_PositionModels == 5, "Testing if each position with local static parameters gets its own model.");
+
+  //check reentrant signal computation
+  mitk::ModelBase::ConstPointer model = linearParameterizer->GenerateParameterizedModel().GetPointer();
+  mitk::ModelBase::ParametersType params(2);
+  params[0] = 2.5;
+  params[1] = -1.0;
+
+  mitk::ModelBase::ModelResultType signal = model->GetSignal(params);
+  mitk::ModelBase::ModelResultType workspace;
+  model->GetSignal(params, workspace);
+  MITK_TEST_CONDITION(signal == workspace, "Testing if reentrant GetSignal() computes the same signal (linear model).");
+
+  const double* workspaceBuffer = workspace.data_block();
+  model->GetSignal(params, workspace);
+  MITK_TEST_CONDITION(workspaceBuffer == workspace.data_block(), "Testing if reentrant GetSignal() reuses the workspace.");
+
+  mitk::T2DecayModel::Pointer t2Model = mitk::T2DecayModel::New();
+  t2Model->SetTimeGrid(grid);
+  params[0] = 100.;
+  params[1] = 3.;
+  signal = t2Model->GetSignal(params);
+  t2Model->GetSignal(params, workspace);
+  MITK_TEST_CONDITION(signal == workspace, "Testing if reentrant GetSignal() computes the same signal (T2 decay model).");
+
+  MITK_TEST_END()
+}
@@ -151,5 +151,35 @@ int mitkPixelBasedParameterFitImageGeneratorTest(int  /*argc*/, char*[] /*argv[]
     testValue = offsetAccessor2.GetPixelByIndex(testIndex6);
     MITK_TEST_CONDITION_REQUIRED(mitk::Equal(0,testValue, 1e-5, true)==true, "Check param #2 (offset) at index #6");
 
+    //Test sparse output (with mask set); results must equal the dense results
+    generator->SparseOutputOn();
+    MITK_TEST_CONDITION(generator->SupportsSparseOutput(), "Check if sparse output is supported with mask.");
+
+    generator->Generate();
+
+    const mitk::SparseParameterMapStore* sparseResults = generator->GetSparseResults();
+    MITK_TEST_CONDITION_REQUIRED(sparseResults != nullptr, "Check if sparse results exist.");
+    MITK_TEST_CONDITION(sparseResults->GetParameterNames().size() == 3 + generator->GetCriterionNames().size() + generator->GetEvaluationParameterNames().size(), "Check number of sparse results.");
+
+    mitk::PixelBasedParameterFitImageGenerator::ParameterImageMapType sparseResultImages = generator->GetParameterImages();
+    mitk::PixelBasedParameterFitImageGenerator::ParameterImageMapType sparseDerivedResultImages = generator->GetDerivedParameterImages();
+
+    CPPUNIT_ASSERT_MESSAGE("Check number of sparse parameter images", 2 == sparseResultImages.size());
+    CPPUNIT_ASSERT_MESSAGE("Check number of sparse derived parameter images", 1 == sparseDerivedResultImages.size());
+
+    MITK_TEST_CONDITION(mitk::Equal(*(resultImages["slope"]), *(sparseResultImages["slope"]), mitk::eps, true), "Check sparse param #1 (slope) equals dense result.");
+    MITK_TEST_CONDITION(mitk::Equal(*(resultImages["offset"]), *(sparseResultImages["offset"]), mitk::eps, true), "Check sparse param #2 (offset) equals dense result.");
+    MITK_TEST_CONDITION(mitk::Equal(*(derivedResultImages["x-intercept"]), *(generator->GetResultImage("x-intercept")), mitk::eps, true), "Check single sparse result image (x-intercept) equals dense result.");
+
+    //Materialized images are cached until the next generation
+    MITK_TEST_CONDITION(sparseResultImages["slope"] == generator->GetParameterImages()["slope"], "Check repeated requests return the same materialized image.");
+    MITK_TEST_CONDITION(sparseResultImages["offset"] == generator->GetResultImage("offset"), "Check single result request returns the materialized image of the group.");
+    MITK_TEST_CONDITION(generator->GetResultImage("x-intercept") == generator->GetDerivedParameterImages()["x-intercept"], "Check group request returns the materialized single result image.");
+
+    //Without mask the generator falls back to dense output
+    generator->SetMask(nullptr);
+    generator->Generate();
+    MITK_TEST_CONDITION(generator->GetSparseResults() == nullptr, "Check fallback to dense output without mask.");
+
   MITK_TEST_END()
 }
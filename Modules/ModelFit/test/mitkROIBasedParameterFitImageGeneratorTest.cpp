@@ -134,5 +134,35 @@ int mitkROIBasedParameterFitImageGeneratorTest(int  /*argc*/, char*[] /*argv[]*/
   testValue = offsetAccessor2.GetPixelByIndex(testIndex6);
   MITK_TEST_CONDITION_REQUIRED(mitk::Equal(0,testValue, 1e-5, true)==true, "Check param #2 (offset) at index #6");
 
+  //Test sparse output; the ROI fit result is stored once per result and must materialize to the dense results
+  generator->SparseOutputOn();
+  MITK_TEST_CONDITION(generator->SupportsSparseOutput(), "Check if sparse output is supported with 3D mask.");
+
+  generator->Generate();
+
+  const mitk::SparseParameterMapStore* sparseResults = generator->GetSparseResults();
+  MITK_TEST_CONDITION_REQUIRED(sparseResults != nullptr, "Check if sparse results exist.");
+  MITK_TEST_CONDITION_REQUIRED(sparseResults->GetNumberOfVoxels() > 0, "Check if masked voxels are stored.");
+  MITK_TEST_CONDITION(sparseResults->GetRuns().size() <= sparseResults->GetNumberOfVoxels(), "Check if masked voxels are stored as runs.");
+
+  MITK_TEST_CONDITION(sparseResults->IsUniformParameter("slope"), "Check if the ROI slope is stored as uniform parameter.");
+  const mitk::SparseParameterMapStore::ValueVectorType& sparseSlopes = sparseResults->GetValues("slope");
+  MITK_TEST_CONDITION_REQUIRED(sparseSlopes.size() == 1, "Check number of stored slope values.");
+  MITK_TEST_CONDITION(mitk::Equal(2, sparseSlopes.front(), 1e-4, true), "Check stored ROI slope.");
+
+  std::size_t expectedMemorySize = sparseResults->GetRuns().size() * sizeof(mitk::SparseParameterMapStore::VoxelRun) + sparseResults->GetParameterNames().size() * sizeof(mitk::SparseParameterMapStore::ValueType);
+  MITK_TEST_CONDITION(sparseResults->GetMemorySize() == expectedMemorySize, "Check that memory does not grow with the number of masked voxels.");
+
+  mitk::ROIBasedParameterFitImageGenerator::ParameterImageMapType sparseResultImages = generator->GetParameterImages();
+  CPPUNIT_ASSERT_MESSAGE("Check number of sparse parameter images", 2 == sparseResultImages.size());
+  MITK_TEST_CONDITION(mitk::Equal(*(resultImages["slope"]), *(sparseResultImages["slope"]), mitk::eps, true), "Check sparse param #1 (slope) equals dense result.");
+  MITK_TEST_CONDITION(mitk::Equal(*(resultImages["offset"]), *(sparseResultImages["offset"]), mitk::eps, true), "Check sparse param #2 (offset) equals dense result.");
+  MITK_TEST_CONDITION(mitk::Equal(*(derivedResultImages["x-intercept"]), *(generator->GetResultImage("x-intercept")), mitk::eps, true), "Check single sparse result image (x-intercept) equals dense result.");
+  MITK_TEST_CONDITION(sparseResultImages["slope"] == generator->GetParameterImages()["slope"], "Check repeated requests return the same materialized image.");
+
+  //A new generation invalidates the materialized images
+  generator->Modified();
+  MITK_TEST_CONDITION(sparseResultImages["slope"] != generator->GetParameterImages()["slope"], "Check that a new generation materializes new images.");
+
   MITK_TEST_END()
 }
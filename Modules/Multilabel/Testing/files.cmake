@@ -5,5 +5,6 @@ set(MODULE_TESTS
     mitkLegacyLabelSetImageIOTest.cpp
     mitkLabelSetImageSurfaceStampFilterTest.cpp
     mitkTransferLabelTest.cpp
+    mitkLabelSetImageSliceCompositorTest.cpp
 )
 
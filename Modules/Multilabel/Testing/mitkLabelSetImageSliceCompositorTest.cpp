@@ -0,0 +1,173 @@
+/*============================================================================
+
+The Medical Imaging Interaction Toolkit (MITK)
+
+Copyright (c) German Cancer Research Center (DKFZ)
+All rights reserved.
+
+Use of this source code is governed by a 3-clause BSD license that can be
+found in the LICENSE file.
+
+============================================================================*/
+
+#include <mitkImageWriteAccessor.h>
+#include <mitkLabelSetImageSliceCompositor.h>
+#include <mitkTestFixture.h>
+#include <mitkTestingMacros.h>
+
+#include <vtkImageData.h>
+#include <vtkLookupTable.h>
+#include <vtkMatrix4x4.h>
+#include <vtkSmartPointer.h>
+
+#include <algorithm>
+#include <cstdlib>
+#include <utility>
+
+class mitkLabelSetImageSliceCompositorTestSuite : public mitk::TestFixture
+{
+  CPPUNIT_TEST_SUITE(mitkLabelSetImageSliceCompositorTestSuite);
+  MITK_TEST(ComputeVoxelOffsets_AxialSlice);
+  MITK_TEST(ComputeVoxelOffsets_PixelsOutsideVolume);
+  MITK_TEST(CompositeLayer_LaterLayersOnTop);
+  CPPUNIT_TEST_SUITE_END();
+
+private:
+  mitk::Image::Pointer m_Volume;
+  vtkSmartPointer<vtkImageData> m_Slice;
+  vtkSmartPointer<vtkMatrix4x4> m_ResliceAxes;
+
+  /** Creates a 4x4x2 label volume (spacing 1, origin 0) with the given label at the voxels (x, y, 1).*/
+  mitk::Image::Pointer CreateVolume(std::initializer_list<std::pair<int, int>> voxels, mitk::Label::PixelType label)
+  {
+    unsigned int dimensions[3] = { 4, 4, 2 };
+    auto volume = mitk::Image::New();
+    volume->Initialize(mitk::MakeScalarPixelType<mitk::Label::PixelType>(), 3, dimensions);
+
+    mitk::ImageWriteAccessor accessor(volume);
+    auto *data = static_cast<mitk::Label::PixelType *>(accessor.GetData());
+    std::fill_n(data, 4 * 4 * 2, 0);
+
+    for (const auto &voxel : voxels)
+      data[16 + voxel.second * 4 + voxel.first] = label;
+
+    return volume;
+  }
+
+  /** Lookup table with transparent background, opaque red label 1 and half transparent green label 2.*/
+  static vtkSmartPointer<vtkLookupTable> CreateLookupTable()
+  {
+    auto lookupTable = vtkSmartPointer<vtkLookupTable>::New();
+    lookupTable->SetNumberOfTableValues(3);
+    lookupTable->SetTableRange(0, 3);
+    lookupTable->Build();
+    lookupTable->SetTableValue(0, 0.0, 0.0, 0.0, 0.0);
+    lookupTable->SetTableValue(1, 1.0, 0.0, 0.0, 1.0);
+    lookupTable->SetTableValue(2, 0.0, 1.0, 0.0, 0.5);
+    return lookupTable;
+  }
+
+  static const unsigned char *GetPixel(vtkImageData *image, int x, int y)
+  {
+    return static_cast<const unsigned char *>(image->GetScalarPointer(x, y, 0));
+  }
+
+  void SetSliceExtent(int xMin, int xMax, int yMin, int yMax)
+  {
+    m_Slice->SetExtent(xMin, xMax, yMin, yMax, 0, 0);
+    m_Slice->AllocateScalars(VTK_UNSIGNED_SHORT, 1);
+  }
+
+public:
+  void setUp() override
+  {
+    m_Volume = this->CreateVolume({ { 1, 2 } }, 1);
+
+    m_Slice = vtkSmartPointer<vtkImageData>::New();
+    m_Slice->SetSpacing(1.0, 1.0, 1.0);
+    m_Slice->SetOrigin(0.0, 0.0, 0.0);
+    this->SetSliceExtent(0, 3, 0, 3);
+
+    // axial plane through the second slice of the volume
+    m_ResliceAxes = vtkSmartPointer<vtkMatrix4x4>::New();
+    m_ResliceAxes->SetElement(2, 3, 1.0);
+  }
+
+  void tearDown() override
+  {
+    m_Volume = nullptr;
+    m_Slice = nullptr;
+    m_ResliceAxes = nullptr;
+  }
+
+  void ComputeVoxelOffsets_AxialSlice()
+  {
+    mitk::LabelSetImageSliceCompositor compositor;
+    compositor.ComputeVoxelOffsets(m_Slice, m_ResliceAxes, m_Volume, 0);
+
+    const auto &offsets = compositor.GetVoxelOffsets();
+    CPPUNIT_ASSERT_EQUAL(std::size_t(16), offsets.size());
+
+    for (int y = 0; y < 4; ++y)
+      for (int x = 0; x < 4; ++x)
+        CPPUNIT_ASSERT_EQUAL(itk::OffsetValueType(16 + y * 4 + x), offsets[y * 4 + x]);
+  }
+
+  void ComputeVoxelOffsets_PixelsOutsideVolume()
+  {
+    this->SetSliceExtent(-1, 4, 0, 3);
+
+    mitk::LabelSetImageSliceCompositor compositor;
+    compositor.ComputeVoxelOffsets(m_Slice, m_ResliceAxes, m_Volume, 0);
+
+    const auto &offsets = compositor.GetVoxelOffsets();
+    CPPUNIT_ASSERT_EQUAL(std::size_t(24), offsets.size());
+
+    for (int y = 0; y < 4; ++y)
+    {
+      CPPUNIT_ASSERT_EQUAL(itk::OffsetValueType(-1), offsets[y * 6]);
+      CPPUNIT_ASSERT_EQUAL(itk::OffsetValueType(16 + y * 4), offsets[y * 6 + 1]);
+      CPPUNIT_ASSERT_EQUAL(itk::OffsetValueType(-1), offsets[y * 6 + 5]);
+    }
+  }
+
+  void CompositeLayer_LaterLayersOnTop()
+  {
+    auto upperVolume = this->CreateVolume({ { 1, 2 }, { 3, 3 } }, 2);
+    auto lookupTable = CreateLookupTable();
+
+    mitk::LabelSetImageSliceCompositor compositor;
+    compositor.ComputeVoxelOffsets(m_Slice, m_ResliceAxes, m_Volume, 0);
+
+    auto output = vtkSmartPointer<vtkImageData>::New();
+    compositor.InitializeOutput(output);
+
+    {
+      mitk::ImageWriteAccessor lowerAccessor(m_Volume);
+      mitk::ImageWriteAccessor upperAccessor(upperVolume);
+      compositor.CompositeLayer(static_cast<const mitk::Label::PixelType *>(lowerAccessor.GetData()), lookupTable, output);
+      compositor.CompositeLayer(static_cast<const mitk::Label::PixelType *>(upperAccessor.GetData()), lookupTable, output);
+    }
+
+    CPPUNIT_ASSERT_EQUAL(vtkIdType(4 * 4), output->GetNumberOfPoints());
+    CPPUNIT_ASSERT_EQUAL(4, output->GetNumberOfScalarComponents());
+
+    // background of both layers
+    CPPUNIT_ASSERT_EQUAL(0, static_cast<int>(GetPixel(output, 0, 0)[3]));
+
+    // half transparent green over opaque red
+    const auto *blended = GetPixel(output, 1, 2);
+    CPPUNIT_ASSERT(std::abs(blended[0] - 127) <= 1);
+    CPPUNIT_ASSERT(std::abs(blended[1] - 127) <= 1);
+    CPPUNIT_ASSERT_EQUAL(0, static_cast<int>(blended[2]));
+    CPPUNIT_ASSERT_EQUAL(255, static_cast<int>(blended[3]));
+
+    // half transparent green over background keeps its color
+    const auto *upperOnly = GetPixel(output, 3, 3);
+    CPPUNIT_ASSERT_EQUAL(0, static_cast<int>(upperOnly[0]));
+    CPPUNIT_ASSERT_EQUAL(255, static_cast<int>(upperOnly[1]));
+    CPPUNIT_ASSERT(std::abs(upperOnly[3] - 127) <= 1);
+  }
+};
+
+MITK_TEST_SUITE_REGISTRATION(mitkLabelSetImageSliceCompositor)
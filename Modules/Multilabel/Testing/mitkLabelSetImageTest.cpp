@@ -11,13 +11,17 @@ found in the LICENSE file.
 ============================================================================*/
 
 #include <mitkIOUtil.h>
+#include <mitkImageReadAccessor.h>
 #include <mitkImageStatisticsHolder.h>
+#include <mitkImageWriteAccessor.h>
 #include <mitkLabelSetImage.h>
 #include <mitkTestFixture.h>
 #include <mitkTestingMacros.h>
 
 #include <mitkAutoCropImageFilter.h>
 
+#include <cstdio>
+
 class mitkLabelSetImageTestSuite : public mitk::TestFixture
 {
   CPPUNIT_TEST_SUITE(mitkLabelSetImageTestSuite);
@@ -26,6 +30,8 @@ class mitkLabelSetImageTestSuite : public mitk::TestFixture
   MITK_TEST(TestGetActiveLabelSet);
   MITK_TEST(TestGetActiveLabel);
   MITK_TEST(TestInitializeByLabeledImage);
+  MITK_TEST(TestInitializeByGroupImages);
+  MITK_TEST(TestWriteReadGroups);
   MITK_TEST(TestGetLabelSet);
   MITK_TEST(TestGetLabel);
   MITK_TEST(TestSetUnlabeledLabelLock);
@@ -44,6 +50,33 @@ private:
   mitk::LabelSetImage::Pointer m_LabelSetImage;
 
 public:
+  static mitk::Image::Pointer CreateGroupImage(mitk::Label::PixelType offset)
+  {
+    auto image = mitk::Image::New();
+    unsigned int dimensions[3] = { 20, 30, 10 };
+    image->Initialize(mitk::MakeScalarPixelType<mitk::Label::PixelType>(), 3, dimensions);
+
+    mitk::ImageWriteAccessor accessor(image);
+    auto data = static_cast<mitk::Label::PixelType *>(accessor.GetData());
+    for (unsigned int i = 0; i < 20 * 30 * 10; ++i)
+      data[i] = static_cast<mitk::Label::PixelType>(offset + i % 7);
+
+    return image;
+  }
+
+  static bool HasGroupData(const mitk::Image *image, mitk::Label::PixelType offset)
+  {
+    mitk::ImageReadAccessor accessor(image);
+    auto data = static_cast<const mitk::Label::PixelType *>(accessor.GetData());
+    for (unsigned int i = 0; i < 20 * 30 * 10; ++i)
+    {
+      if (data[i] != static_cast<mitk::Label::PixelType>(offset + i % 7))
+        return false;
+    }
+
+    return true;
+  }
+
   void setUp() override
   {
     // Create a new labelset image
@@ -179,6 +212,57 @@ public:
     CPPUNIT_ASSERT_MESSAGE("Image - number of labels is not 5", m_LabelSetImage->GetNumberOfLabels() == 5);
   }
 
+  void TestInitializeByGroupImages()
+  {
+    auto labelSetImage = mitk::LabelSetImage::New();
+    labelSetImage->InitializeByGroupImages({ CreateGroupImage(0), CreateGroupImage(10) });
+
+    CPPUNIT_ASSERT_EQUAL(2u, labelSetImage->GetNumberOfLayers());
+    CPPUNIT_ASSERT_EQUAL(1u, labelSetImage->GetActiveLayer());
+    CPPUNIT_ASSERT_EQUAL(0u, labelSetImage->GetTotalNumberOfLabels());
+    CPPUNIT_ASSERT_MESSAGE("Active group data is not in the image", HasGroupData(labelSetImage, 10));
+
+    labelSetImage->SetActiveLayer(0);
+    CPPUNIT_ASSERT_MESSAGE("Group 0 data is not in the image", HasGroupData(labelSetImage, 0));
+    CPPUNIT_ASSERT_MESSAGE("Group 1 data is not in the layer container", HasGroupData(labelSetImage->GetLayerImage(1), 10));
+
+    auto charImage = mitk::Image::New();
+    unsigned int dimensions[3] = { 20, 30, 10 };
+    charImage->Initialize(mitk::MakeScalarPixelType<char>(), 3, dimensions);
+    CPPUNIT_ASSERT_THROW(mitk::LabelSetImage::New()->InitializeByGroupImages({ charImage }), mitk::Exception);
+    CPPUNIT_ASSERT_THROW(mitk::LabelSetImage::New()->InitializeByGroupImages({}), mitk::Exception);
+  }
+
+  void TestWriteReadGroups()
+  {
+    auto labelSetImage = mitk::LabelSetImage::New();
+    labelSetImage->InitializeByGroupImages({ CreateGroupImage(0), CreateGroupImage(10), CreateGroupImage(20) });
+
+    for (unsigned int group = 0; group < 3; ++group)
+    {
+      auto label = mitk::Label::New();
+      label->SetName("Label" + std::to_string(group));
+      label->SetValue(1 + 10 * group);
+      labelSetImage->GetLabelSet(group)->AddLabel(label);
+    }
+    labelSetImage->SetActiveLayer(1);
+
+    const auto path = mitk::IOUtil::CreateTemporaryFile("LabelSetImageTest_XXXXXX.nrrd");
+    mitk::IOUtil::Save(labelSetImage, path);
+    auto loadedImage = mitk::IOUtil::Load<mitk::LabelSetImage>(path);
+    std::remove(path.c_str());
+
+    CPPUNIT_ASSERT_EQUAL(3u, loadedImage->GetNumberOfLayers());
+    CPPUNIT_ASSERT_EQUAL(3u, loadedImage->GetTotalNumberOfLabels());
+
+    for (unsigned int group = 0; group < 3; ++group)
+    {
+      loadedImage->SetActiveLayer(group);
+      CPPUNIT_ASSERT_MESSAGE("Group data is not equal", HasGroupData(loadedImage, 10 * group));
+      CPPUNIT_ASSERT(loadedImage->GetLabelSet(group)->ExistLabel(1 + 10 * group));
+    }
+  }
+
   void TestGetLabelSet()
   {
     // Test get non existing lset
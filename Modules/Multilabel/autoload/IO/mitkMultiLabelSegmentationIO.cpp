@@ -20,6 +20,7 @@ found in the LICENSE file.
 #include <mitkArbitraryTimeGeometry.h>
 #include <mitkIPropertyPersistence.h>
 #include <mitkCoreServices.h>
+#include <mitkImageReadAccessor.h>
 #include <mitkItkImageIO.h>
 #include <mitkUIDManipulator.h>
 
@@ -29,9 +30,91 @@ found in the LICENSE file.
 #include "itkMetaDataDictionary.h"
 #include "itkMetaDataObject.h"
 #include "itkNrrdImageIO.h"
+#include <itksys/SystemTools.hxx>
 
 #include <tinyxml2.h>
 
+#include <algorithm>
+#include <cstring>
+#include <memory>
+
+namespace
+{
+  /** Provides the pixels of all groups interleaved into the component layout of an itk::VectorImage.
+   * The active group is taken from the image itself, all other groups from the layer container.*/
+  class GroupInterleaver
+  {
+  public:
+    explicit GroupInterleaver(const mitk::LabelSetImage* image)
+      : m_ComponentSize(image->GetPixelType().GetSize()),
+        m_PixelSize(m_ComponentSize * image->GetNumberOfLayers())
+    {
+      const auto activeGroup = image->GetActiveLayer();
+
+      for (unsigned int group = 0; group < image->GetNumberOfLayers(); ++group)
+      {
+        const mitk::Image* groupImage = group != activeGroup ? image->GetLayerImage(group) : image;
+
+        if (groupImage->GetPixelType().GetSize() != m_ComponentSize || groupImage->GetDimension() != image->GetDimension() ||
+            !std::equal(image->GetDimensions(), image->GetDimensions() + image->GetDimension(), groupImage->GetDimensions()))
+        {
+          mitkThrow() << "Cannot write label set image: image of group " << group << " does not match the segmentation.";
+        }
+
+        m_Accessors.push_back(std::make_unique<mitk::ImageReadAccessor>(groupImage));
+        m_GroupData.push_back(static_cast<const char*>(m_Accessors.back()->GetData()));
+      }
+    }
+
+    /** Writes size bytes of the interleaved pixels starting at byte offset into buffer.*/
+    void Fill(std::size_t offset, std::size_t size, void* buffer) const
+    {
+      if (1 == m_GroupData.size())
+      {
+        std::memcpy(buffer, m_GroupData.front() + offset, size);
+        return;
+      }
+
+      auto dest = static_cast<char*>(buffer);
+      const auto end = offset + size;
+
+      // bytes of pixels that are cut by the chunk boundaries are copied one by one
+      const auto firstPixel = std::min(end, offset + (m_PixelSize - offset % m_PixelSize) % m_PixelSize) / m_PixelSize;
+      const auto lastPixel = std::max(firstPixel, end / m_PixelSize);
+
+      for (auto position = offset; position < std::min(end, firstPixel * m_PixelSize); ++position)
+        *dest++ = this->GetByte(position);
+
+      for (std::size_t group = 0; group < m_GroupData.size(); ++group)
+      {
+        const char* src = m_GroupData[group] + firstPixel * m_ComponentSize;
+        char* groupDest = dest + group * m_ComponentSize;
+
+        for (auto pixel = firstPixel; pixel < lastPixel; ++pixel, src += m_ComponentSize, groupDest += m_PixelSize)
+          std::memcpy(groupDest, src, m_ComponentSize);
+      }
+
+      dest += (lastPixel - firstPixel) * m_PixelSize;
+
+      for (auto position = std::max(offset, lastPixel * m_PixelSize); position < end; ++position)
+        *dest++ = this->GetByte(position);
+    }
+
+  private:
+    char GetByte(std::size_t position) const
+    {
+      const auto pixel = position / m_PixelSize;
+      const auto pixelByte = position % m_PixelSize;
+      return m_GroupData[pixelByte / m_ComponentSize][pixel * m_ComponentSize + pixelByte % m_ComponentSize];
+    }
+
+    std::size_t m_ComponentSize;
+    std::size_t m_PixelSize;
+    std::vector<std::unique_ptr<mitk::ImageReadAccessor>> m_Accessors;
+    std::vector<const char*> m_GroupData;
+  };
+}
+
 namespace mitk
 {
 
@@ -70,17 +153,26 @@ namespace mitk
 
     mitk::LocaleSwitch localeSwitch("C");
 
-    mitk::Image::Pointer inputVector = mitk::ConvertLabelSetImageToImage(input);
-
     // image write
-    if (inputVector.IsNull())
+    if (nullptr == input || 0 == input->GetNumberOfLayers())
     {
       mitkThrow() << "Cannot write non-image data";
     }
 
     itk::NrrdImageIO::Pointer nrrdImageIo = itk::NrrdImageIO::New();
 
-    ItkImageIO::PreparImageIOToWriteImage(nrrdImageIo, inputVector);
+    ItkImageIO::PreparImageIOToWriteImage(nrrdImageIo, input);
+
+    // Multiple groups are stored as components of a vector image. The group buffers are
+    // interleaved chunk by chunk while the chunks are compressed, a single group is
+    // compressed straight from the image memory.
+    const auto numberOfGroups = input->GetNumberOfLayers();
+
+    if (numberOfGroups > 1)
+    {
+      nrrdImageIo->SetPixelType(itk::IOPixelEnum::VECTOR);
+      nrrdImageIo->SetNumberOfComponents(numberOfGroups);
+    }
 
     LocalFile localFile(this);
     const std::string path = localFile.GetFileName();
@@ -111,12 +203,30 @@ namespace mitk
       // Handle UID
       itk::EncapsulateMetaData<std::string>(nrrdImageIo->GetMetaDataDictionary(), PROPERTY_KEY_UID, input->GetUID());
 
-      // use compression if available
-      nrrdImageIo->UseCompressionOn();
-      nrrdImageIo->SetFileName(path);
+      const GroupInterleaver groups(input);
+      auto fill = [&groups](std::size_t offset, std::size_t size, void* buffer) { groups.Fill(offset, size, buffer); };
 
-      ImageReadAccessor imageAccess(inputVector);
-      nrrdImageIo->Write(imageAccess.GetData());
+      if (itksys::SystemTools::LowerCase(itksys::SystemTools::GetFilenameLastExtension(path)) != ".nhdr")
+      {
+        ItkImageIO::WriteChunkedGzipNrrd(nrrdImageIo, path, fill);
+      }
+      else
+      {
+        // ITK writes the separate data file of a detached header, which needs the data as a whole
+        std::vector<char> interleavedGroups;
+
+        if (numberOfGroups > 1)
+        {
+          interleavedGroups.resize(nrrdImageIo->GetImageSizeInBytes());
+          fill(0, interleavedGroups.size(), interleavedGroups.data());
+        }
+
+        ImageReadAccessor imageAccess(input);
+
+        nrrdImageIo->UseCompressionOn();
+        nrrdImageIo->SetFileName(path);
+        nrrdImageIo->Write(numberOfGroups > 1 ? interleavedGroups.data() : imageAccess.GetData());
+      }
     }
     catch (const std::exception &e)
     {
@@ -162,7 +272,36 @@ namespace mitk
     }
 
     //generate multi label images
-    auto output = ConvertImageToLabelSetImage(rawimage);
+    std::vector<Image::Pointer> groupImages;
+    if (rawimage->GetChannelDescriptor().GetPixelType().GetPixelType() == itk::IOPixelEnum::VECTOR)
+    {
+      groupImages = SplitVectorImage(rawimage);
+    }
+    else
+    {
+      groupImages.push_back(rawimage);
+    }
+
+    auto timeGeometry = rawimage->GetTimeGeometry()->Clone();
+    rawimage = nullptr;
+
+    // Group images with the label pixel type are taken over without copying. The labels
+    // are defined by the meta data below, so they need not be generated from the pixels.
+    const auto labelPixelType = MakeScalarPixelType<LabelSetImage::PixelType>();
+    const auto canTakeOverGroupImages = std::all_of(groupImages.begin(), groupImages.end(), [&labelPixelType](const Image::Pointer& groupImage) {
+      return groupImage->GetPixelType() == labelPixelType && (3 == groupImage->GetDimension() || 4 == groupImage->GetDimension());
+    });
+
+    LabelSetImage::Pointer output;
+    if (canTakeOverGroupImages)
+    {
+      output = LabelSetImage::New();
+      output->InitializeByGroupImages(groupImages);
+    }
+    else
+    {
+      output = ConvertImageVectorToLabelSetImage(groupImages, timeGeometry);
+    }
 
     //get label set definitions
     auto jsonStr = MultiLabelIOHelper::GetStringByKey(dictionary, MULTILABEL_SEGMENTATION_LABELS_INFO_KEY);
@@ -37,6 +37,8 @@ found in the LICENSE file.
 
 #include <itkBinaryFunctorImageFilter.h>
 
+#include <algorithm>
+#include <cstring>
 
 template <typename TPixel, unsigned int VDimensions>
 void SetToZero(itk::Image<TPixel, VDimensions> *source)
@@ -775,6 +777,69 @@ void mitk::LabelSetImage::InitializeByLabeledImage(mitk::Image::Pointer image)
   this->Modified();
 }
 
+void mitk::LabelSetImage::InitializeByGroupImages(const std::vector<mitk::Image::Pointer>& groupImages)
+{
+  if (groupImages.empty())
+    mitkThrow() << "Cannot initialize label set image without group images.";
+
+  if (this->GetNumberOfLayers() != 0)
+    mitkThrow() << "Cannot initialize label set image by group images; label set image is already initialized.";
+
+  const auto firstImage = groupImages.front();
+
+  if (firstImage.IsNull() || !firstImage->IsInitialized() || (3 != firstImage->GetDimension() && 4 != firstImage->GetDimension()))
+    mitkThrow() << "Invalid group image.";
+
+  const auto pixelType = mitk::MakeScalarPixelType<LabelSetImage::PixelType>();
+  const auto dimension = firstImage->GetDimension();
+
+  for (const auto& groupImage : groupImages)
+  {
+    if (groupImage.IsNull() || !groupImage->IsInitialized() || groupImage->GetPixelType() != pixelType ||
+        groupImage->GetDimension() != dimension ||
+        !std::equal(firstImage->GetDimensions(), firstImage->GetDimensions() + dimension, groupImage->GetDimensions()))
+    {
+      mitkThrow() << "Invalid group image. All group images must have the label pixel type and the same dimensions.";
+    }
+  }
+
+  Superclass::Initialize(pixelType, dimension, firstImage->GetDimensions());
+  this->SetTimeGeometry(firstImage->GetTimeGeometry()->Clone());
+
+  for (const auto& groupImage : groupImages)
+  {
+    auto labelSet = mitk::LabelSet::New();
+    labelSet->SetActiveLabel(UnlabeledValue);
+    labelSet->SetLayer(m_LabelSetContainer.size());
+
+    m_LayerContainer.push_back(groupImage);
+    m_LabelSetContainer.push_back(labelSet);
+
+    this->RegisterLabelSet(labelSet);
+  }
+
+  this->ReinitMaps();
+
+  // The data of the active group is held by the image itself, see SetActiveLayer().
+  m_ActiveLayer = static_cast<unsigned int>(groupImages.size() - 1);
+
+  {
+    mitk::ImageReadAccessor source(groupImages.back());
+    mitk::ImageWriteAccessor target(this);
+
+    std::size_t byteSize = pixelType.GetSize();
+    for (unsigned int dim = 0; dim < dimension; ++dim)
+      byteSize *= this->GetDimension(dim);
+
+    std::memcpy(target.GetData(), source.GetData(), byteSize);
+  }
+
+  for (GroupIndexType groupIndex = 0; groupIndex < groupImages.size(); ++groupIndex)
+    this->OnGroupAdded(groupIndex);
+
+  this->Modified();
+}
+
 template <typename LabelSetImageType, typename ImageType>
 void mitk::LabelSetImage::InitializeByLabeledImageProcessing(LabelSetImageType *labelSetImage, ImageType *image)
 {
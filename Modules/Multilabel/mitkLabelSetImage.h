@@ -432,6 +432,18 @@ namespace mitk
      */
     void InitializeByLabeledImage(mitk::Image::Pointer image);
 
+    /**
+     * @brief Initialize a new mitk::LabelSetImage with one group per passed image.
+     * The images are taken over as layer images without copying their pixel data, so
+     * they must not be modified by the caller afterwards. Every group gets an empty
+     * label set; no labels are generated from the pixel values. The last group becomes
+     * the active one.
+     * All images must have the pixel type of the label set image and the same
+     * dimensions (3D or 4D). The time geometry is cloned from the first image.
+     * @param groupImages the images of the groups
+     */
+    void InitializeByGroupImages(const std::vector<mitk::Image::Pointer>& groupImages);
+
     /**
       * \brief  */
     void MaskStamp(mitk::Image *mask, bool forceOverwrite);
@@ -13,12 +13,16 @@ found in the LICENSE file.
 #include <mitkITKImageImport.h>
 #include <mitkImageAccessByItk.h>
 #include <mitkImageCast.h>
+#include <mitkImageWriteAccessor.h>
 #include <mitkLabelSetImageConverter.h>
 
 #include <itkComposeImageFilter.h>
 #include <itkExtractImageFilter.h>
 #include <itkImageDuplicator.h>
-#include <itkVectorIndexSelectionCastImageFilter.h>
+#include <itkMultiThreaderBase.h>
+
+#include <algorithm>
+#include <memory>
 
 template <typename TPixel, unsigned int VDimension>
 static void ConvertLabelSetImageToImage(const itk::Image<TPixel, VDimension> *,
@@ -89,21 +93,57 @@ template <typename TPixel, unsigned int VDimensions>
 static void SplitVectorImage(const itk::VectorImage<TPixel, VDimensions>* image,
   std::vector<mitk::Image::Pointer>& result)
 {
-  typedef itk::VectorImage<TPixel, VDimensions> VectorImageType;
-  typedef itk::Image<TPixel, VDimensions> ImageType;
-  typedef itk::VectorIndexSelectionCastImageFilter<VectorImageType, ImageType> VectorIndexSelectorType;
+  // The components are copied straight from the interleaved buffer into the
+  // memory of the layer images, which avoids an intermediate itk::Image per layer.
+  const auto numberOfLayers = image->GetVectorLength();
+  const auto size = image->GetBufferedRegion().GetSize();
+  const std::size_t numberOfPixels = image->GetBufferedRegion().GetNumberOfPixels();
+
+  unsigned int dimensions[VDimensions];
+  for (unsigned int dim = 0; dim < VDimensions; ++dim)
+    dimensions[dim] = size[dim];
+
+  std::vector<std::unique_ptr<mitk::ImageWriteAccessor>> accessors;
+  std::vector<TPixel*> layerData;
 
-  auto numberOfLayers = image->GetVectorLength();
   for (decltype(numberOfLayers) layer = 0; layer < numberOfLayers; ++layer)
   {
-    auto layerSelector = VectorIndexSelectorType::New();
-    layerSelector->SetInput(image);
-    layerSelector->SetIndex(layer);
-    layerSelector->Update();
+    auto layerImage = mitk::Image::New();
+    layerImage->Initialize(mitk::MakeScalarPixelType<TPixel>(), VDimensions, dimensions);
 
-    mitk::Image::Pointer layerImage = mitk::GrabItkImageMemoryChannel(layerSelector->GetOutput(), nullptr, nullptr, false);
+    accessors.push_back(std::make_unique<mitk::ImageWriteAccessor>(layerImage));
+    layerData.push_back(static_cast<TPixel*>(accessors.back()->GetData()));
     result.push_back(layerImage);
   }
+
+  const TPixel* src = image->GetBufferPointer();
+  const std::size_t blockSize = 1 << 16;
+  const auto numberOfBlocks = (numberOfPixels + blockSize - 1) / blockSize;
+
+  auto splitBlock = [&](itk::SizeValueType block)
+  {
+    const auto first = block * blockSize;
+    const auto last = std::min(numberOfPixels, first + blockSize);
+
+    for (decltype(numberOfLayers) layer = 0; layer < numberOfLayers; ++layer)
+    {
+      auto dest = layerData[layer];
+
+      for (auto i = first; i < last; ++i)
+        dest[i] = src[i * numberOfLayers + layer];
+    }
+  };
+
+  if (numberOfBlocks < 2)
+  {
+    if (1 == numberOfBlocks)
+      splitBlock(0);
+  }
+  else
+  {
+    auto threader = itk::MultiThreaderBase::New();
+    threader->ParallelizeArray(0, numberOfBlocks, splitBlock, nullptr);
+  }
 }
 
 std::vector<mitk::Image::Pointer> mitk::SplitVectorImage(const Image* vecImage)
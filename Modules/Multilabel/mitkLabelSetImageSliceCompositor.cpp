@@ -0,0 +1,165 @@
+/*============================================================================
+
+The Medical Imaging Interaction Toolkit (MITK)
+
+Copyright (c) German Cancer Research Center (DKFZ)
+All rights reserved.
+
+Use of this source code is governed by a 3-clause BSD license that can be
+found in the LICENSE file.
+
+============================================================================*/
+
+#include "mitkLabelSetImageSliceCompositor.h"
+
+#include <vtkImageData.h>
+#include <vtkLookupTable.h>
+#include <vtkMatrix4x4.h>
+
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+
+namespace
+{
+  mitk::Point3D SliceToWorld(vtkMatrix4x4 *resliceAxes, double x, double y, double z)
+  {
+    const double slicePoint[4] = { x, y, z, 1.0 };
+    double worldPoint[4];
+    resliceAxes->MultiplyPoint(slicePoint, worldPoint);
+
+    mitk::Point3D point;
+    mitk::FillVector3D(point, worldPoint[0], worldPoint[1], worldPoint[2]);
+    return point;
+  }
+}
+
+void mitk::LabelSetImageSliceCompositor::ComputeVoxelOffsets(vtkImageData *slice,
+                                                             vtkMatrix4x4 *resliceAxes,
+                                                             const Image *volume,
+                                                             TimeStepType timeStep)
+{
+  m_VoxelOffsets.clear();
+
+  if (nullptr == slice || nullptr == resliceAxes || nullptr == volume)
+    return;
+
+  slice->GetExtent(m_Extent);
+  slice->GetSpacing(m_Spacing);
+  slice->GetOrigin(m_Origin);
+
+  const int width = m_Extent[1] - m_Extent[0] + 1;
+  const int height = m_Extent[3] - m_Extent[2] + 1;
+
+  if (width <= 0 || height <= 0)
+    return;
+
+  m_VoxelOffsets.resize(static_cast<std::size_t>(width) * height, -1);
+
+  const BaseGeometry::Pointer geometry = volume->GetTimeGeometry()->GetGeometryForTimeStep(timeStep);
+  if (geometry.IsNull())
+    return;
+
+  const itk::IndexValueType dimensions[3] = { volume->GetDimension(0), volume->GetDimension(1), volume->GetDimension(2) };
+
+  // The mapping from slice pixels to continuous voxel indices is affine, so it is defined
+  // by the index of the first pixel and the index steps along the rows and columns.
+  const double x0 = m_Origin[0] + m_Extent[0] * m_Spacing[0];
+  const double y0 = m_Origin[1] + m_Extent[2] * m_Spacing[1];
+  const double z0 = m_Origin[2] + m_Extent[4] * m_Spacing[2];
+
+  Point3D firstIndex, nextColumnIndex, nextRowIndex;
+  geometry->WorldToIndex(SliceToWorld(resliceAxes, x0, y0, z0), firstIndex);
+  geometry->WorldToIndex(SliceToWorld(resliceAxes, x0 + m_Spacing[0], y0, z0), nextColumnIndex);
+  geometry->WorldToIndex(SliceToWorld(resliceAxes, x0, y0 + m_Spacing[1], z0), nextRowIndex);
+
+  const Vector3D columnStep = nextColumnIndex - firstIndex;
+  const Vector3D rowStep = nextRowIndex - firstIndex;
+
+  auto offset = m_VoxelOffsets.begin();
+  for (int y = 0; y < height; ++y)
+  {
+    Point3D index = firstIndex + rowStep * static_cast<ScalarType>(y);
+
+    for (int x = 0; x < width; ++x, ++offset, index += columnStep)
+    {
+      itk::IndexValueType voxel[3];
+      bool inside = true;
+
+      for (unsigned int i = 0; i < 3 && inside; ++i)
+      {
+        // same rounding as the nearest neighbor interpolation of vtkImageReslice
+        voxel[i] = static_cast<itk::IndexValueType>(std::floor(index[i] + 0.5));
+        inside = voxel[i] >= 0 && voxel[i] < dimensions[i];
+      }
+
+      if (inside)
+        *offset = (voxel[2] * dimensions[1] + voxel[1]) * dimensions[0] + voxel[0];
+    }
+  }
+}
+
+void mitk::LabelSetImageSliceCompositor::InitializeOutput(vtkImageData *output) const
+{
+  output->SetExtent(m_Extent[0], m_Extent[1], m_Extent[2], m_Extent[3], m_Extent[4], m_Extent[4]);
+  output->SetSpacing(m_Spacing);
+  output->SetOrigin(m_Origin);
+  output->AllocateScalars(VTK_UNSIGNED_CHAR, 4);
+
+  std::memset(output->GetScalarPointer(), 0, 4 * m_VoxelOffsets.size());
+}
+
+void mitk::LabelSetImageSliceCompositor::CompositeLayer(const Label::PixelType *volume,
+                                                        vtkLookupTable *lookupTable,
+                                                        vtkImageData *output) const
+{
+  if (nullptr == volume || nullptr == lookupTable || nullptr == output || m_VoxelOffsets.empty())
+    return;
+
+  lookupTable->Build();
+
+  // map label values to table indices the same way vtkMitkLevelWindowFilter does
+  double tableRange[2];
+  lookupTable->GetTableRange(tableRange);
+
+  const auto *table = lookupTable->GetPointer(0);
+  const auto maxIndex = static_cast<double>(lookupTable->GetNumberOfColors() - 1);
+  const double scale = tableRange[1] - tableRange[0] > 0 ? (maxIndex + 1) / (tableRange[1] - tableRange[0]) : 0.0;
+  const double bias = -tableRange[0] * scale + 0.5;
+
+  auto *rgba = static_cast<unsigned char *>(output->GetScalarPointer());
+
+  for (const auto offset : m_VoxelOffsets)
+  {
+    if (offset >= 0)
+    {
+      const auto index = static_cast<vtkIdType>(std::min(std::max(0.0, std::floor(volume[offset] * scale + bias)), maxIndex));
+      const auto *color = table + 4 * index;
+      const unsigned int alpha = color[3];
+
+      if (255 == alpha || 0 == rgba[3])
+      {
+        if (0 != alpha)
+          std::memcpy(rgba, color, 4);
+      }
+      else if (0 != alpha)
+      {
+        // "over" operator for non-premultiplied colors
+        const unsigned int remainingAlpha = rgba[3] * (255 - alpha);
+        const unsigned int resultAlpha = 255 * alpha + remainingAlpha;
+
+        for (unsigned int i = 0; i < 3; ++i)
+          rgba[i] = static_cast<unsigned char>((color[i] * alpha * 255 + rgba[i] * remainingAlpha + resultAlpha / 2) / resultAlpha);
+
+        rgba[3] = static_cast<unsigned char>((resultAlpha + 127) / 255);
+      }
+    }
+
+    rgba += 4;
+  }
+}
+
+const std::vector<itk::OffsetValueType> &mitk::LabelSetImageSliceCompositor::GetVoxelOffsets() const
+{
+  return m_VoxelOffsets;
+}
@@ -0,0 +1,70 @@
+/*============================================================================
+
+The Medical Imaging Interaction Toolkit (MITK)
+
+Copyright (c) German Cancer Research Center (DKFZ)
+All rights reserved.
+
+Use of this source code is governed by a 3-clause BSD license that can be
+found in the LICENSE file.
+
+============================================================================*/
+
+#ifndef mitkLabelSetImageSliceCompositor_h
+#define mitkLabelSetImageSliceCompositor_h
+
+#include <MitkMultilabelExports.h>
+
+#include <mitkImage.h>
+#include <mitkLabel.h>
+
+#include <vector>
+
+class vtkImageData;
+class vtkLookupTable;
+class vtkMatrix4x4;
+
+namespace mitk
+{
+  /** \brief Samples all layers of a LabelSetImage on one slice and blends their label colors into a single RGBA image.
+
+    All layers of a LabelSetImage share the same geometry. Thus the voxel that is sampled by each pixel of a
+    (nearest neighbor) slice is the same for all layers. ComputeVoxelOffsets() determines these voxels once per
+    slice geometry; each layer is then composited by a simple lookup of its voxel values and label colors, so the
+    costs of additional layers are independent of the orientation of the slice.
+
+    Layers are composited in the order of the CompositeLayer() calls, i.e. later layers are drawn on top of earlier ones.
+    Pixels outside of the volume stay transparent.
+  */
+  class MITKMULTILABEL_EXPORT LabelSetImageSliceCompositor
+  {
+  public:
+    /** \brief Determines the voxel sampled by each pixel of the slice.
+      \param slice Resliced image defining extent, spacing and origin of the slice.
+      \param resliceAxes Transformation from slice coordinates to world coordinates.
+      \param volume Any layer image, defines the geometry and the dimensions of the sampled volumes.
+      \param timeStep Time step of the volume geometry.*/
+    void ComputeVoxelOffsets(vtkImageData *slice, vtkMatrix4x4 *resliceAxes, const Image *volume, TimeStepType timeStep);
+
+    /** \brief Allocates the output as unsigned char RGBA image with the extent, spacing and origin of the slice
+      and resets it to fully transparent.*/
+    void InitializeOutput(vtkImageData *output) const;
+
+    /** \brief Blends the label colors of one layer over the output.
+      \param volume Pixel data of the layer volume (at the time step passed to ComputeVoxelOffsets()).
+      \param lookupTable Label colors and opacities of the layer, indexed by label value.
+      \param output Image initialized by InitializeOutput().*/
+    void CompositeLayer(const Label::PixelType *volume, vtkLookupTable *lookupTable, vtkImageData *output) const;
+
+    /** \brief Offsets of the sampled voxels in the volume (one per slice pixel, row by row); -1 for pixels outside.*/
+    const std::vector<itk::OffsetValueType> &GetVoxelOffsets() const;
+
+  private:
+    std::vector<itk::OffsetValueType> m_VoxelOffsets;
+    int m_Extent[6] = { 0, -1, 0, -1, 0, 0 };
+    double m_Spacing[3] = { 1.0, 1.0, 1.0 };
+    double m_Origin[3] = { 0.0, 0.0, 0.0 };
+  };
+}
+
+#endif
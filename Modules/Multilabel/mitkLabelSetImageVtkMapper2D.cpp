@@ -15,6 +15,7 @@ found in the LICENSE file.
 // MITK
 #include <mitkAbstractTransformGeometry.h>
 #include <mitkDataNode.h>
+#include <mitkImageReadAccessor.h>
 #include <mitkImageSliceSelector.h>
 #include <mitkImageStatisticsHolder.h>
 #include <mitkLevelWindowProperty.h>
@@ -28,7 +29,6 @@ found in the LICENSE file.
 #include <mitkVtkResliceInterpolationProperty.h>
 
 // MITK Rendering
-#include "vtkMitkLevelWindowFilter.h"
 #include "vtkMitkThickSlicesFilter.h"
 #include "vtkNeverTranslucentTexture.h"
 
@@ -51,6 +51,8 @@ found in the LICENSE file.
 #include <itkRGBAPixel.h>
 #include <mitkRenderingModeProperty.h>
 
+#include <algorithm>
+
 mitk::LabelSetImageVtkMapper2D::LabelSetImageVtkMapper2D()
 {
 }
@@ -91,40 +93,6 @@ void mitk::LabelSetImageVtkMapper2D::GenerateDataForRenderer(mitk::BaseRenderer
   float opacity = 1.0f;
   node->GetOpacity(opacity, renderer, "opacity");
 
-  if (numberOfLayers != localStorage->m_NumberOfLayers)
-  {
-    localStorage->m_NumberOfLayers = numberOfLayers;
-    localStorage->m_ReslicedImageVector.clear();
-    localStorage->m_ReslicerVector.clear();
-    localStorage->m_LayerTextureVector.clear();
-    localStorage->m_LevelWindowFilterVector.clear();
-    localStorage->m_LayerMapperVector.clear();
-    localStorage->m_LayerActorVector.clear();
-
-    localStorage->m_Actors = vtkSmartPointer<vtkPropAssembly>::New();
-
-    for (int lidx = 0; lidx < numberOfLayers; ++lidx)
-    {
-      localStorage->m_ReslicedImageVector.push_back(vtkSmartPointer<vtkImageData>::New());
-      localStorage->m_ReslicerVector.push_back(mitk::ExtractSliceFilter::New());
-      localStorage->m_LayerTextureVector.push_back(vtkSmartPointer<vtkNeverTranslucentTexture>::New());
-      localStorage->m_LevelWindowFilterVector.push_back(vtkSmartPointer<vtkMitkLevelWindowFilter>::New());
-      localStorage->m_LayerMapperVector.push_back(vtkSmartPointer<vtkPolyDataMapper>::New());
-      localStorage->m_LayerActorVector.push_back(vtkSmartPointer<vtkActor>::New());
-
-      // do not repeat the texture (the image)
-      localStorage->m_LayerTextureVector[lidx]->RepeatOff();
-
-      // set corresponding mappers for the actors
-      localStorage->m_LayerActorVector[lidx]->SetMapper(localStorage->m_LayerMapperVector[lidx]);
-
-      localStorage->m_Actors->AddPart(localStorage->m_LayerActorVector[lidx]);
-    }
-
-    localStorage->m_Actors->AddPart(localStorage->m_OutlineShadowActor);
-    localStorage->m_Actors->AddPart(localStorage->m_OutlineActor);
-  }
-
   // early out if there is no intersection of the current rendering geometry
   // and the geometry of the image that is to be rendered.
   if (!RenderingGeometryIntersectsImage(worldGeometry, image->GetSlicedGeometry()))
@@ -132,118 +100,94 @@ void mitk::LabelSetImageVtkMapper2D::GenerateDataForRenderer(mitk::BaseRenderer
     // set image to nullptr, to clear the texture in 3D, because
     // the latest image is used there if the plane is out of the geometry
     // see bug-13275
-    for (int lidx = 0; lidx < numberOfLayers; ++lidx)
-    {
-      localStorage->m_ReslicedImageVector[lidx] = nullptr;
-      localStorage->m_LayerMapperVector[lidx]->SetInputData(localStorage->m_EmptyPolyData);
-      localStorage->m_OutlineActor->SetVisibility(false);
-      localStorage->m_OutlineShadowActor->SetVisibility(false);
-    }
+    localStorage->m_ReslicedImage = nullptr;
+    localStorage->m_ImageMapper->SetInputData(localStorage->m_EmptyPolyData);
+    localStorage->m_OutlineActor->SetVisibility(false);
+    localStorage->m_OutlineShadowActor->SetVisibility(false);
     return;
   }
 
+  // The active layer is resliced by the ExtractSliceFilter. It is needed for the outline of the active
+  // label and defines the slice geometry that is shared by all layers.
+  localStorage->m_Reslicer->SetInput(image);
+  localStorage->m_Reslicer->SetWorldGeometry(worldGeometry);
+  localStorage->m_Reslicer->SetTimeStep(this->GetTimestep());
+
+  // set the transformation of the image to adapt reslice axis
+  localStorage->m_Reslicer->SetResliceTransformByGeometry(
+    image->GetTimeGeometry()->GetGeometryForTimeStep(this->GetTimestep()));
+
+  // is the geometry of the slice based on the image image or the worldgeometry?
+  bool inPlaneResampleExtentByGeometry = false;
+  node->GetBoolProperty("in plane resample extent by geometry", inPlaneResampleExtentByGeometry, renderer);
+  localStorage->m_Reslicer->SetInPlaneResampleExtentByGeometry(inPlaneResampleExtentByGeometry);
+  localStorage->m_Reslicer->SetInterpolationMode(ExtractSliceFilter::RESLICE_NEAREST);
+  localStorage->m_Reslicer->SetVtkOutputRequest(true);
+
+  // this is needed when thick mode was enabled before. These variables have to be reset to default values
+  localStorage->m_Reslicer->SetOutputDimensionality(2);
+  localStorage->m_Reslicer->SetOutputSpacingZDirection(1.0);
+  localStorage->m_Reslicer->SetOutputExtentZDirection(0, 0);
+
+  // Bounds information for reslicing (only required if reference geometry is present)
+  // this used for generating a vtkPLaneSource with the right size
+  double sliceBounds[6];
+  sliceBounds[0] = 0.0;
+  sliceBounds[1] = 0.0;
+  sliceBounds[2] = 0.0;
+  sliceBounds[3] = 0.0;
+  sliceBounds[4] = 0.0;
+  sliceBounds[5] = 0.0;
+
+  localStorage->m_Reslicer->GetClippedPlaneBounds(sliceBounds);
+
+  // setup the textured plane
+  this->GeneratePlane(renderer, sliceBounds);
+
+  // get the spacing of the slice
+  localStorage->m_mmPerPixel = localStorage->m_Reslicer->GetOutputSpacing();
+  localStorage->m_Reslicer->Modified();
+  // start the pipeline with updating the largest possible, needed if the geometry of the image has changed
+  localStorage->m_Reslicer->UpdateLargestPossibleRegion();
+  localStorage->m_ReslicedImage = localStorage->m_Reslicer->GetVtkOutput();
+
+  // All layers share the geometry of the image, so the voxels sampled by the slice are determined only once.
+  // Afterwards the label colors of all layers are blended into one RGBA image; later layers are drawn on top.
+  localStorage->m_Compositor.ComputeVoxelOffsets(
+    localStorage->m_ReslicedImage, localStorage->m_Reslicer->GetResliceAxes(), image, this->GetTimestep());
+  localStorage->m_Compositor.InitializeOutput(localStorage->m_CompositedImage);
+
   for (int lidx = 0; lidx < numberOfLayers; ++lidx)
   {
-    mitk::Image *layerImage = nullptr;
-
-    // set main input for ExtractSliceFilter
-    if (lidx == activeLayer)
-      layerImage = image;
-    else
-      layerImage = image->GetLayerImage(lidx);
-
-    localStorage->m_ReslicerVector[lidx]->SetInput(layerImage);
-    localStorage->m_ReslicerVector[lidx]->SetWorldGeometry(worldGeometry);
-    localStorage->m_ReslicerVector[lidx]->SetTimeStep(this->GetTimestep());
-
-    // set the transformation of the image to adapt reslice axis
-    localStorage->m_ReslicerVector[lidx]->SetResliceTransformByGeometry(
-      layerImage->GetTimeGeometry()->GetGeometryForTimeStep(this->GetTimestep()));
-
-    // is the geometry of the slice based on the image image or the worldgeometry?
-    bool inPlaneResampleExtentByGeometry = false;
-    node->GetBoolProperty("in plane resample extent by geometry", inPlaneResampleExtentByGeometry, renderer);
-    localStorage->m_ReslicerVector[lidx]->SetInPlaneResampleExtentByGeometry(inPlaneResampleExtentByGeometry);
-    localStorage->m_ReslicerVector[lidx]->SetInterpolationMode(ExtractSliceFilter::RESLICE_NEAREST);
-    localStorage->m_ReslicerVector[lidx]->SetVtkOutputRequest(true);
-
-    // this is needed when thick mode was enabled before. These variables have to be reset to default values
-    localStorage->m_ReslicerVector[lidx]->SetOutputDimensionality(2);
-    localStorage->m_ReslicerVector[lidx]->SetOutputSpacingZDirection(1.0);
-    localStorage->m_ReslicerVector[lidx]->SetOutputExtentZDirection(0, 0);
-
-    // Bounds information for reslicing (only required if reference geometry is present)
-    // this used for generating a vtkPLaneSource with the right size
-    double sliceBounds[6];
-    sliceBounds[0] = 0.0;
-    sliceBounds[1] = 0.0;
-    sliceBounds[2] = 0.0;
-    sliceBounds[3] = 0.0;
-    sliceBounds[4] = 0.0;
-    sliceBounds[5] = 0.0;
-
-    localStorage->m_ReslicerVector[lidx]->GetClippedPlaneBounds(sliceBounds);
-
-    // setup the textured plane
-    this->GeneratePlane(renderer, sliceBounds);
-
-    // get the spacing of the slice
-    localStorage->m_mmPerPixel = localStorage->m_ReslicerVector[lidx]->GetOutputSpacing();
-    localStorage->m_ReslicerVector[lidx]->Modified();
-    // start the pipeline with updating the largest possible, needed if the geometry of the image has changed
-    localStorage->m_ReslicerVector[lidx]->UpdateLargestPossibleRegion();
-    localStorage->m_ReslicedImageVector[lidx] = localStorage->m_ReslicerVector[lidx]->GetVtkOutput();
-
-    const auto *planeGeometry = dynamic_cast<const PlaneGeometry *>(worldGeometry);
-
-    double textureClippingBounds[6];
-    for (auto &textureClippingBound : textureClippingBounds)
-    {
-      textureClippingBound = 0.0;
-    }
+    const mitk::Image *layerImage = lidx == activeLayer ? image : image->GetLayerImage(lidx);
 
-    // Calculate the actual bounds of the transformed plane clipped by the
-    // dataset bounding box; this is required for drawing the texture at the
-    // correct position during 3D mapping.
-    mitk::PlaneClipping::CalculateClippedPlaneBounds(layerImage->GetGeometry(), planeGeometry, textureClippingBounds);
-
-    textureClippingBounds[0] = static_cast<int>(textureClippingBounds[0] / localStorage->m_mmPerPixel[0] + 0.5);
-    textureClippingBounds[1] = static_cast<int>(textureClippingBounds[1] / localStorage->m_mmPerPixel[0] + 0.5);
-    textureClippingBounds[2] = static_cast<int>(textureClippingBounds[2] / localStorage->m_mmPerPixel[1] + 0.5);
-    textureClippingBounds[3] = static_cast<int>(textureClippingBounds[3] / localStorage->m_mmPerPixel[1] + 0.5);
-
-    // clipping bounds for cutting the imageLayer
-    localStorage->m_LevelWindowFilterVector[lidx]->SetClippingBounds(textureClippingBounds);
-
-    localStorage->m_LevelWindowFilterVector[lidx]->SetLookupTable(
-      image->GetLabelSet(lidx)->GetLookupTable()->GetVtkLookupTable());
+    mitk::ImageReadAccessor layerAccessor(layerImage, layerImage->GetVolumeData(this->GetTimestep()));
+    localStorage->m_Compositor.CompositeLayer(static_cast<const mitk::Label::PixelType *>(layerAccessor.GetData()),
+                                              image->GetLabelSet(lidx)->GetLookupTable()->GetVtkLookupTable(),
+                                              localStorage->m_CompositedImage);
+  }
 
-    // do not use a VTK lookup table (we do that ourselves in m_LevelWindowFilter)
-    localStorage->m_LayerTextureVector[lidx]->SetColorModeToDirectScalars();
+  localStorage->m_CompositedImage->Modified();
 
-    // connect the imageLayer with the levelwindow filter
-    localStorage->m_LevelWindowFilterVector[lidx]->SetInputData(localStorage->m_ReslicedImageVector[lidx]);
-    // connect the texture with the output of the levelwindow filter
+  // the composited image already contains the colors (no VTK lookup table)
+  localStorage->m_ImageTexture->SetColorModeToDirectScalars();
+  localStorage->m_ImageTexture->SetInputData(localStorage->m_CompositedImage);
 
-    // check for texture interpolation property
-    bool textureInterpolation = false;
-    node->GetBoolProperty("texture interpolation", textureInterpolation, renderer);
+  // check for texture interpolation property
+  bool textureInterpolation = false;
+  node->GetBoolProperty("texture interpolation", textureInterpolation, renderer);
 
-    // set the interpolation modus according to the property
-    localStorage->m_LayerTextureVector[lidx]->SetInterpolate(textureInterpolation);
+  // set the interpolation modus according to the property
+  localStorage->m_ImageTexture->SetInterpolate(textureInterpolation);
 
-    localStorage->m_LayerTextureVector[lidx]->SetInputConnection(
-      localStorage->m_LevelWindowFilterVector[lidx]->GetOutputPort());
+  this->TransformActor(renderer);
 
-    this->TransformActor(renderer);
+  // set the plane as input for the mapper
+  localStorage->m_ImageMapper->SetInputConnection(localStorage->m_Plane->GetOutputPort());
 
-    // set the plane as input for the mapper
-    localStorage->m_LayerMapperVector[lidx]->SetInputConnection(localStorage->m_Plane->GetOutputPort());
-
-    // set the texture for the actor
-    localStorage->m_LayerActorVector[lidx]->SetTexture(localStorage->m_LayerTextureVector[lidx]);
-    localStorage->m_LayerActorVector[lidx]->GetProperty()->SetOpacity(opacity);
-  }
+  // set the texture for the actor
+  localStorage->m_ImageActor->SetTexture(localStorage->m_ImageTexture);
+  localStorage->m_ImageActor->GetProperty()->SetOpacity(opacity);
 
   mitk::Label* activeLabel = image->GetActiveLabel(activeLayer);
   if (nullptr != activeLabel)
@@ -254,7 +198,7 @@ void mitk::LabelSetImageVtkMapper2D::GenerateDataForRenderer(mitk::BaseRenderer
     {
       //generate contours/outlines
       localStorage->m_OutlinePolyData =
-        this->CreateOutlinePolyData(renderer, localStorage->m_ReslicedImageVector[activeLayer], activeLabel->GetValue());
+        this->CreateOutlinePolyData(renderer, localStorage->m_ReslicedImage, activeLabel->GetValue());
       localStorage->m_OutlineActor->SetVisibility(true);
       localStorage->m_OutlineShadowActor->SetVisibility(true);
       const mitk::Color& color = activeLabel->GetColor();
@@ -473,24 +417,16 @@ void mitk::LabelSetImageVtkMapper2D::ApplyColor(mitk::BaseRenderer *renderer, co
   localStorage->m_OutlineShadowActor->GetProperty()->SetColor(0, 0, 0);
 }
 
-void mitk::LabelSetImageVtkMapper2D::ApplyOpacity(mitk::BaseRenderer *renderer, int layer)
+void mitk::LabelSetImageVtkMapper2D::ApplyOpacity(mitk::BaseRenderer *renderer)
 {
   LocalStorage *localStorage = this->GetLocalStorage(renderer);
   float opacity = 1.0f;
   this->GetDataNode()->GetOpacity(opacity, renderer, "opacity");
-  localStorage->m_LayerActorVector[layer]->GetProperty()->SetOpacity(opacity);
+  localStorage->m_ImageActor->GetProperty()->SetOpacity(opacity);
   localStorage->m_OutlineActor->GetProperty()->SetOpacity(opacity);
   localStorage->m_OutlineShadowActor->GetProperty()->SetOpacity(opacity);
 }
 
-void mitk::LabelSetImageVtkMapper2D::ApplyLookuptable(mitk::BaseRenderer *renderer, int layer)
-{
-  LocalStorage *localStorage = m_LSH.GetLocalStorage(renderer);
-  auto *input = dynamic_cast<mitk::LabelSetImage *>(this->GetDataNode()->GetData());
-  localStorage->m_LevelWindowFilterVector[layer]->SetLookupTable(
-    input->GetLabelSet(layer)->GetLookupTable()->GetVtkLookupTable());
-}
-
 void mitk::LabelSetImageVtkMapper2D::Update(mitk::BaseRenderer *renderer)
 {
   bool visible = true;
@@ -519,9 +455,16 @@ void mitk::LabelSetImageVtkMapper2D::Update(mitk::BaseRenderer *renderer)
   image->UpdateOutputInformation();
   LocalStorage *localStorage = m_LSH.GetLocalStorage(renderer);
 
+  // the label colors are composited in GenerateDataForRenderer, so changes of the lookup tables
+  // (e.g. color, opacity or visibility of a label) require a re-render as well
+  itk::ModifiedTimeType lookupTableMTime = 0;
+  for (unsigned int lidx = 0; lidx < image->GetNumberOfLayers(); ++lidx)
+    lookupTableMTime = std::max(lookupTableMTime, image->GetLabelSet(lidx)->GetLookupTable()->GetVtkLookupTable()->GetMTime());
+
   // check if something important has changed and we need to re-render
 
   if ((localStorage->m_LastDataUpdateTime < image->GetMTime()) ||
+      (localStorage->m_LastDataUpdateTime < lookupTableMTime) ||
       (localStorage->m_LastDataUpdateTime < image->GetPipelineMTime()) ||
       (localStorage->m_LastDataUpdateTime < renderer->GetCurrentWorldPlaneGeometryUpdateTime()) ||
       (localStorage->m_LastDataUpdateTime < renderer->GetCurrentWorldPlaneGeometry()->GetMTime()))
@@ -578,17 +521,14 @@ void mitk::LabelSetImageVtkMapper2D::TransformActor(mitk::BaseRenderer *renderer
   LocalStorage *localStorage = m_LSH.GetLocalStorage(renderer);
   // get the transformation matrix of the reslicer in order to render the slice as axial, coronal or sagittal
   vtkSmartPointer<vtkTransform> trans = vtkSmartPointer<vtkTransform>::New();
-  vtkSmartPointer<vtkMatrix4x4> matrix = localStorage->m_ReslicerVector[0]->GetResliceAxes(); // same for all layers
+  vtkSmartPointer<vtkMatrix4x4> matrix = localStorage->m_Reslicer->GetResliceAxes();
   trans->SetMatrix(matrix);
 
-  for (int lidx = 0; lidx < localStorage->m_NumberOfLayers; ++lidx)
-  {
-    // transform the plane/contour (the actual actor) to the corresponding view (axial, coronal or sagittal)
-    localStorage->m_LayerActorVector[lidx]->SetUserTransform(trans);
-    // transform the origin to center based coordinates, because MITK is center based.
-    localStorage->m_LayerActorVector[lidx]->SetPosition(
-      -0.5 * localStorage->m_mmPerPixel[0], -0.5 * localStorage->m_mmPerPixel[1], 0.0);
-  }
+  // transform the plane/contour (the actual actor) to the corresponding view (axial, coronal or sagittal)
+  localStorage->m_ImageActor->SetUserTransform(trans);
+  // transform the origin to center based coordinates, because MITK is center based.
+  localStorage->m_ImageActor->SetPosition(
+    -0.5 * localStorage->m_mmPerPixel[0], -0.5 * localStorage->m_mmPerPixel[1], 0.0);
   // same for outline actor
   localStorage->m_OutlineActor->SetUserTransform(trans);
   localStorage->m_OutlineActor->SetPosition(
@@ -637,13 +577,26 @@ mitk::LabelSetImageVtkMapper2D::LocalStorage::LocalStorage()
   m_OutlineActor = vtkSmartPointer<vtkActor>::New();
   m_OutlineMapper = vtkSmartPointer<vtkPolyDataMapper>::New();
   m_OutlineShadowActor = vtkSmartPointer<vtkActor>::New();
+  m_ImageActor = vtkSmartPointer<vtkActor>::New();
+  m_ImageMapper = vtkSmartPointer<vtkPolyDataMapper>::New();
+  m_ImageTexture = vtkSmartPointer<vtkNeverTranslucentTexture>::New();
+  m_CompositedImage = vtkSmartPointer<vtkImageData>::New();
+  m_Reslicer = mitk::ExtractSliceFilter::New();
 
-  m_NumberOfLayers = 0;
   m_mmPerPixel = nullptr;
 
+  // do not repeat the texture (the image)
+  m_ImageTexture->RepeatOff();
+
+  m_ImageActor->SetMapper(m_ImageMapper);
+
   m_OutlineActor->SetMapper(m_OutlineMapper);
   m_OutlineShadowActor->SetMapper(m_OutlineMapper);
 
   m_OutlineActor->SetVisibility(false);
   m_OutlineShadowActor->SetVisibility(false);
+
+  m_Actors->AddPart(m_ImageActor);
+  m_Actors->AddPart(m_OutlineShadowActor);
+  m_Actors->AddPart(m_OutlineActor);
 }
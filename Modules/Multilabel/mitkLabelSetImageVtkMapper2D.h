@@ -21,6 +21,7 @@ found in the LICENSE file.
 #include "mitkBaseRenderer.h"
 #include "mitkExtractSliceFilter.h"
 #include "mitkLabelSetImage.h"
+#include "mitkLabelSetImageSliceCompositor.h"
 #include "mitkVtkMapper.h"
 
 // VTK
@@ -35,13 +36,16 @@ class vtkImageReslice;
 class vtkPoints;
 class vtkMitkThickSlicesFilter;
 class vtkPolyData;
-class vtkMitkLevelWindowFilter;
 class vtkNeverTranslucentTexture;
 
 namespace mitk
 {
 
   /** \brief Mapper to resample and display 2D slices of a 3D labelset image.
+   *
+   * The slice geometry is computed once by reslicing the active layer. All layers are sampled on this
+   * geometry and their label colors are blended on the CPU into a single RGBA texture (see
+   * LabelSetImageSliceCompositor), so only one texture has to be uploaded, regardless of the number of layers.
    *
    * Properties that can be set for labelset images and influence this mapper are:
    *
@@ -87,15 +91,24 @@ namespace mitk
     public:
       vtkSmartPointer<vtkPropAssembly> m_Actors;
 
-      std::vector<vtkSmartPointer<vtkActor>> m_LayerActorVector;
-      std::vector<vtkSmartPointer<vtkPolyDataMapper>> m_LayerMapperVector;
-      std::vector<vtkSmartPointer<vtkImageData>> m_ReslicedImageVector;
-      std::vector<vtkSmartPointer<vtkNeverTranslucentTexture>> m_LayerTextureVector;
+      /** \brief Actor of the textured plane showing the composited label colors of all layers. */
+      vtkSmartPointer<vtkActor> m_ImageActor;
+      vtkSmartPointer<vtkPolyDataMapper> m_ImageMapper;
+      vtkSmartPointer<vtkNeverTranslucentTexture> m_ImageTexture;
+      /** \brief RGBA image with the label colors of all layers blended on top of each other. */
+      vtkSmartPointer<vtkImageData> m_CompositedImage;
+
+      /** \brief Resliced active layer. Its geometry is shared by all layers. */
+      vtkSmartPointer<vtkImageData> m_ReslicedImage;
 
       vtkSmartPointer<vtkPolyData> m_EmptyPolyData;
       vtkSmartPointer<vtkPlaneSource> m_Plane;
 
-      std::vector<mitk::ExtractSliceFilter::Pointer> m_ReslicerVector;
+      /** \brief Reslices the active layer and defines the slice geometry. */
+      mitk::ExtractSliceFilter::Pointer m_Reslicer;
+
+      /** \brief Samples all layers on the slice geometry and blends their label colors. */
+      LabelSetImageSliceCompositor m_Compositor;
 
       vtkSmartPointer<vtkPolyData> m_OutlinePolyData;
       /** \brief An actor for the outline */
@@ -114,12 +127,6 @@ namespace mitk
       /** \brief mmPerPixel relation between pixel and mm. (World spacing).*/
       mitk::ScalarType *m_mmPerPixel;
 
-      int m_NumberOfLayers;
-
-      /** \brief This filter is used to apply the level window to Grayvalue and RBG(A) images. */
-      // vtkSmartPointer<vtkMitkLevelWindowFilter> m_LevelWindowFilter;
-      std::vector<vtkSmartPointer<vtkMitkLevelWindowFilter>> m_LevelWindowFilterVector;
-
       /** \brief Default constructor of the local storage. */
       LocalStorage();
       /** \brief Default deconstructor of the local storage. */
@@ -195,12 +202,6 @@ namespace mitk
       * to keep the correct order for the final VTK rendering.*/
     float CalculateLayerDepth(mitk::BaseRenderer *renderer);
 
-    /** \brief This method applies (or modifies) the lookuptable for all types of images.
-     * \warning To use the lookup table, the property 'Lookup Table' must be set and a 'Image Rendering.Mode'
-     * which uses the lookup table must be set.
-  */
-    void ApplyLookuptable(mitk::BaseRenderer *renderer, int layer);
-
     /** \brief This method applies a color transfer function.
      * Internally, a vtkColorTransferFunction is used. This is usefull for coloring continous
      * images (e.g. float)
@@ -221,7 +222,7 @@ namespace mitk
     void ApplyColor(mitk::BaseRenderer *renderer, const mitk::Color &color);
 
     /** \brief Set the opacity of the actor. */
-    void ApplyOpacity(mitk::BaseRenderer *renderer, int layer);
+    void ApplyOpacity(mitk::BaseRenderer *renderer);
 
     /**
       * \brief Calculates whether the given rendering geometry intersects the
@@ -64,6 +64,7 @@ mitk::Image::Pointer aifMask;
 bool useConstraints(false);
 bool verbose(false);
 bool roibased(false);
+bool sparse(false);
 bool preview(false);
 
 std::string modelName;
@@ -137,6 +138,8 @@ void setupParser(mitkCommandLineParser& parser)
         "verbose", "v", mitkCommandLineParser::Bool, "Verbose Output", "Whether to produce verbose output");
     parser.addArgument(
         "roibased", "r", mitkCommandLineParser::Bool, "Roi based fitting", "Will compute a mean intesity signal over the ROI before fitting it. If this mode is used a mask must be specified.");
+    parser.addArgument(
+        "sparse", "s", mitkCommandLineParser::Bool, "Sparse result storage", "Only keeps the results of the voxels inside the mask while fitting. Reduces the memory needed for small masks. Is ignored if no mask is specified.");
     parser.addArgument(
       "constraints", "c", mitkCommandLineParser::Bool, "Constraints", "Indicates if constraints should be used for the fitting (if flag is set the default contraints will be used.).", us::Any(false));
     parser.addArgument(
@@ -194,6 +197,12 @@ bool configureApplicationSettings(std::map<std::string, us::Any> parsedArgs)
         roibased = us::any_cast<bool>(parsedArgs["roibased"]);
     }
 
+    sparse = false;
+    if (parsedArgs.count("sparse"))
+    {
+        sparse = us::any_cast<bool>(parsedArgs["sparse"]);
+    }
+
     useConstraints = false;
     if (parsedArgs.count("constraints"))
     {
@@ -757,6 +766,7 @@ void doFitting()
         {
             std::cout << "Started fitting process..." << std::endl;
             generator->AddObserver(::itk::AnyEvent(), command);
+            generator->SetSparseOutput(sparse);
             generator->Generate();
             std::cout << std::endl << "Finished fitting process" << std::endl;
 
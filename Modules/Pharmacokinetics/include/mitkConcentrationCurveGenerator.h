@@ -13,7 +13,7 @@ found in the LICENSE file.
 #define mitkConcentrationCurveGenerator_h
 
 #include <mitkImage.h>
-#include <itkBinaryFunctorImageFilter.h>
+#include <itkImage.h>
 #include "mitkConvertToConcentrationAbsoluteFunctor.h"
 #include "mitkConvertToConcentrationRelativeFunctor.h"
 
@@ -24,9 +24,11 @@ namespace mitk {
 /** \class ConcentrationCurveGenerator
 * \brief Converts a given 4D mitk::Image with MR signal values into a 4D mitk::Image with corresponding contrast agent concentration values
 *
-* From a given 4D image, the Generator takes the 3D image of the first time point as baseline image. It then loops over all time steps, casts
-* the current 3D image to itk and passes it to the ConvertToconcentrationFunctor. The returned 3D image has now values of concentration type and is stored at its timepoint
-* in the return image.
+* The baseline signal of every voxel is either the signal of the first time step (if BaselineStartTimeStep == BaselineEndTimeStep)
+* or the average signal within the time step range [BaselineStartTimeStep, BaselineEndTimeStep]. The conversion is done in one
+* multi-threaded pass over the dynamic image: the voxels are processed in blocks, for each block the baseline is computed and then
+* all time steps of the block are converted with the conversion functor and written directly into the output image.
+* No intermediate baseline or per time step images are generated.
 */
 class MITKPHARMACOKINETICS_EXPORT ConcentrationCurveGenerator : public itk::Object
 {
@@ -102,29 +104,26 @@ protected:
      ~ConcentrationCurveGenerator() override;
 
 
-     template<class TPixel_input, class TPixel_baseline>
-     mitk::Image::Pointer convertToConcentration(const itk::Image<TPixel_input, 3> *itkInputImage, const itk::Image<TPixel_baseline, 3> *itkBaselineImage);
-
-    /** Calls ConvertToconcentrationFunctor for passed 3D itk::image*/
-    mitk::Image::Pointer ConvertSignalToConcentrationCurve(const mitk::Image* inputImage, const mitk::Image* baselineImage);
-
-
+    /** @brief Selects the baseline mode and pixel type of the dynamic image and converts it into m_ConvertedImage*/
+    template<class TPixel>
+    void ConvertDynamicImage(const itk::Image<TPixel, 4> *itkDynamicImage);
 
-    /** @brief Takes the 3D image of the first timepoint to set as baseline image*/
-    void PrepareBaselineImage();
+    /** @brief Selects the conversion functor according to the settings and calls ConvertVoxelCurves with it*/
+    template<class TPixel_input, class TPixel_baseline>
+    void ConvertWithSelectedFunctor(const itk::Image<TPixel_input, 4> *itkDynamicImage, unsigned int baselineStart, unsigned int baselineEnd, double *outputBuffer);
 
-    template<class TPixel>
-    void CalculateAverageBaselineImage(const itk::Image<TPixel,4> *itkBaselineImage);
+    /** @brief Converts the signal curves of all voxels. The baseline of a voxel is the mean of the time steps [baselineStart, baselineEnd].
+    * The conversion is called with (value, baseline, voxel offset) and returns the concentration.*/
+    template<class TPixel_input, class TPixel_baseline, class TConversion>
+    void ConvertVoxelCurves(const itk::Image<TPixel_input, 4> *itkDynamicImage, unsigned int baselineStart, unsigned int baselineEnd, const TConversion &conversion, double *outputBuffer);
 
-    /** @brief loops over all timepoints, casts the current timepoint 3D mitk::image to itk and passes it to ConvertSignalToConcentrationCurve */
+    /** @brief Generates the concentration image for all time steps of the dynamic image */
     virtual void Convert();
 
 
 private:
     Image::ConstPointer m_DynamicImage;
-    Image::ConstPointer m_BaselineImage;
     Image::ConstPointer m_T10Image;
-    Image::Pointer m_ConvertSignalToConcentrationCurve_OutputImage;
     Image::Pointer m_ConvertedImage;
 
     bool m_isT2weightedImage;
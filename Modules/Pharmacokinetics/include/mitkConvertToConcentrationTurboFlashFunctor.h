@@ -22,7 +22,7 @@ namespace mitk {
     {
 
     public:
-        ConvertToConcentrationTurboFlashFunctor() : m_Trec(0), m_alpha(0), m_T10(0) {};
+        ConvertToConcentrationTurboFlashFunctor() : m_Trec(0), m_alpha(0), m_T10(0), m_ExpTrecT10(0) {};
         ~ConvertToConcentrationTurboFlashFunctor() {};
 
         void initialize(double relaxationtime, double relaxivity, double recoverytime)
@@ -30,6 +30,8 @@ namespace mitk {
             m_Trec = relaxationtime;
             m_alpha = relaxivity;
             m_T10 = recoverytime;
+            //constant for all voxels and time steps
+            m_ExpTrecT10 = exp(m_Trec/m_T10);
         }
 
         bool operator!=( const ConvertToConcentrationTurboFlashFunctor & other)const
@@ -47,9 +49,14 @@ namespace mitk {
 
 
             //Only for TurboFLASH sequencen
-            if (baseline != 0 && ((double)value/baseline - exp(m_Trec/m_T10) * ((double)value/baseline - 1)) > 0 )
+            if (baseline != 0)
             {
-                concentration = -1 / (m_Trec * m_alpha) * log((double)value/baseline - exp(m_Trec/m_T10) * ((double)value/baseline - 1));
+                const double s = (double)value/baseline;
+                const double arg = s - m_ExpTrecT10 * (s - 1);
+                if (arg > 0)
+                {
+                    concentration = -1 / (m_Trec * m_alpha) * log(arg);
+                }
             }
 
 
@@ -60,6 +67,7 @@ namespace mitk {
         double m_Trec;
         double m_alpha;
         double m_T10;
+        double m_ExpTrecT10;
     };
 
 }
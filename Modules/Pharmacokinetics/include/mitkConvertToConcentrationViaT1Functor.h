@@ -24,7 +24,7 @@ namespace mitk {
     {
 
     public:
-        ConvertToConcentrationViaT1CalcFunctor(): m_relaxivity(0.0), m_TR(0.0),  m_flipangle(0.0) {};
+        ConvertToConcentrationViaT1CalcFunctor(): m_relaxivity(0.0), m_TR(0.0),  m_flipangle(0.0), m_cosflipangle(1.0) {};
 		~ConvertToConcentrationViaT1CalcFunctor() {};
 
         void initialize(double relaxivity, double TR, double flipangle)
@@ -33,6 +33,7 @@ namespace mitk {
 			m_relaxivity = relaxivity;
 			m_TR = TR;
             m_flipangle = flipangle;
+            m_cosflipangle = cos(flipangle);
         }
 
         bool operator!=( const ConvertToConcentrationViaT1CalcFunctor & other) const
@@ -54,8 +55,9 @@ namespace mitk {
             {
                 double s =  (double) value/baseline;
                 R10 = (double) 1/nativeT1;
-                double tmp1 = log(1-s + s*exp(-R10*m_TR) - exp(-R10*m_TR)* cos(m_flipangle));
-                double tmp2 = (1-s*cos(m_flipangle) + s*exp(-R10*m_TR)*cos(m_flipangle) - exp(-R10*m_TR)* cos(m_flipangle));
+                const double e10 = exp(-R10*m_TR);
+                double tmp1 = log(1-s + s*e10 - e10* m_cosflipangle);
+                double tmp2 = (1-s*m_cosflipangle + s*e10*m_cosflipangle - e10* m_cosflipangle);
 
                 R1 = (double) -1/m_TR * tmp1/tmp2 ;
 
@@ -72,6 +74,7 @@ namespace mitk {
 		double m_relaxivity;
 		double m_TR;
         double m_flipangle;
+        double m_cosflipangle;
 
     };
 
@@ -63,6 +63,12 @@ namespace mitk
      * Thus an empty map is returned.*/
     StaticParameterMapType GetLocalStaticParameters(const IndexType& currentPosition) const override;
 
+    /** Returns true, the parameter S0 is a local static parameter.*/
+    bool HasLocalStaticParameters() const override
+    {
+      return true;
+    };
+
     /** This function returns the default parameterization (e.g. initial parametrization for fitting)
      defined by the model developer for  for the given model.*/
     ParametersType GetDefaultInitialParameterization() const override;
@@ -85,6 +85,7 @@ namespace mitk
     virtual itk::LightObject::Pointer InternalClone() const;
 
     virtual ModelResultType ComputeModelfunction(const ParametersType& parameters) const;
+    void ComputeModelfunctionInPlace(const ParametersType& parameters, ModelResultType& signal) const override;
     virtual DerivedParameterMapType ComputeDerivedParameters(const mitk::ModelBase::ParametersType&
         parameters) const;
 
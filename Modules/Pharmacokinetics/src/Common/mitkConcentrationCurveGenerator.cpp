@@ -14,23 +14,24 @@ found in the LICENSE file.
 #include "mitkConvertToConcentrationTurboFlashFunctor.h"
 #include "mitkConvertT2ConcentrationFunctor.h"
 #include "mitkConvertToConcentrationViaT1Functor.h"
-#include "mitkImageTimeSelector.h"
 #include "mitkImageCast.h"
-#include "mitkITKImageImport.h"
-#include "mitkModelBase.h"
-#include "mitkExtractTimeGrid.h"
-#include "mitkArbitraryTimeGeometry.h"
-#include "itkNaryAddImageFilter.h"
 #include "mitkImageAccessByItk.h"
-#include "itkImageIOBase.h"
-#include "itkBinaryFunctorImageFilter.h"
-#include "itkTernaryFunctorImageFilter.h"
-#include <itkExtractImageFilter.h>
-#include "itkMeanProjectionImageFilter.h"
+#include "mitkImageWriteAccessor.h"
+#include "itkMultiThreaderBase.h"
+
+#include <algorithm>
+#include <vector>
+
+namespace
+{
+  /** Number of voxels that are converted together. The baselines of a block are kept in a small local buffer,
+   * input and output of one time step of a block are contiguous in memory.*/
+  const std::size_t ConversionBlockSize = 4096;
+}
 
 mitk::ConcentrationCurveGenerator::ConcentrationCurveGenerator() : m_isT2weightedImage(false), m_isTurboFlashSequence(false),
     m_AbsoluteSignalEnhancement(false), m_RelativeSignalEnhancement(0.0), m_UsingT1Map(false), m_Factor(0.0), m_RecoveryTime(0.0), m_RelaxationTime(0.0),
-    m_Relaxivity(0.0), m_FlipAngle(0.0), m_T2Factor(0.0), m_T2EchoTime(0.0)
+    m_Relaxivity(0.0), m_FlipAngle(0.0), m_T2Factor(0.0), m_T2EchoTime(0.0), m_BaselineStartTimeStep(0), m_BaselineEndTimeStep(0)
 {
 }
 
@@ -54,271 +55,173 @@ mitk::Image::Pointer mitk::ConcentrationCurveGenerator::GetConvertedImage()
 
 void mitk::ConcentrationCurveGenerator::Convert()
 {
+    AccessFixedDimensionByItk(this->m_DynamicImage, mitk::ConcentrationCurveGenerator::ConvertDynamicImage, 4);
+}
 
-    mitk::Image::Pointer tempImage = mitk::Image::New();
-    mitk::PixelType pixeltype = mitk::MakeScalarPixelType<double>();
-
-    tempImage->Initialize(pixeltype,*this->m_DynamicImage->GetTimeGeometry());
-
-    mitk::TimeGeometry::Pointer timeGeometry = (this->m_DynamicImage->GetTimeGeometry())->Clone();
-    tempImage->SetTimeGeometry(timeGeometry);
+template<class TPixel>
+void mitk::ConcentrationCurveGenerator::ConvertDynamicImage(const itk::Image<TPixel, 4> *itkDynamicImage)
+{
+  if (m_BaselineStartTimeStep > m_BaselineEndTimeStep)
+  {
+    mitkThrow() << "Error in ConcentrationCurveGenerator. Baseline end time point is before start time point.";
+  }
+  if (m_BaselineEndTimeStep >= itkDynamicImage->GetLargestPossibleRegion().GetSize()[3])
+  {
+    mitkThrow() << "Error in ConcentrationCurveGenerator. Baseline end time point is larger than total number of time points.";
+  }
 
-    PrepareBaselineImage();
-    mitk::ImageTimeSelector::Pointer imageTimeSelector = mitk::ImageTimeSelector::New();
-    imageTimeSelector->SetInput(this->m_DynamicImage);
+  mitk::Image::Pointer tempImage = mitk::Image::New();
+  mitk::PixelType pixeltype = mitk::MakeScalarPixelType<double>();
 
-    for(unsigned int i = 0; i< this->m_DynamicImage->GetTimeSteps(); ++i)
-    {
-        imageTimeSelector->SetTimeNr(i);
-        imageTimeSelector->UpdateLargestPossibleRegion();
+  tempImage->Initialize(pixeltype,*this->m_DynamicImage->GetTimeGeometry());
 
-        mitk::Image::Pointer mitkInputImage = imageTimeSelector->GetOutput();
-        mitk::Image::Pointer outputImage = mitk::Image::New();
+  mitk::TimeGeometry::Pointer timeGeometry = (this->m_DynamicImage->GetTimeGeometry())->Clone();
+  tempImage->SetTimeGeometry(timeGeometry);
 
-        outputImage = ConvertSignalToConcentrationCurve(mitkInputImage,this->m_BaselineImage);
+  {
+    mitk::ImageWriteAccessor accessor(tempImage);
+    auto outputBuffer = static_cast<double*>(accessor.GetData());
 
-        mitk::ImageReadAccessor accessor(outputImage);
-        tempImage->SetVolume(accessor.GetData(), i);
+    if (m_BaselineStartTimeStep == m_BaselineEndTimeStep)
+    {
+      // the signal of the first time step is used as baseline (in the pixel type of the signal)
+      this->ConvertWithSelectedFunctor<TPixel, TPixel>(itkDynamicImage, 0, 0, outputBuffer);
     }
+    else
+    {
+      this->ConvertWithSelectedFunctor<TPixel, double>(itkDynamicImage, m_BaselineStartTimeStep, m_BaselineEndTimeStep, outputBuffer);
+    }
+  }
 
-    this->m_ConvertedImage = tempImage;
-
+  this->m_ConvertedImage = tempImage;
 }
 
-void mitk::ConcentrationCurveGenerator::PrepareBaselineImage()
+template<class TPixel_input, class TPixel_baseline>
+void mitk::ConcentrationCurveGenerator::ConvertWithSelectedFunctor(const itk::Image<TPixel_input, 4> *itkDynamicImage, unsigned int baselineStart, unsigned int baselineEnd, double *outputBuffer)
 {
+  if (this->m_isT2weightedImage)
+  {
+    mitk::ConvertT2ConcentrationFunctor<TPixel_input, TPixel_baseline, double> functor;
+    functor.initialize(this->m_T2Factor, this->m_T2EchoTime);
 
-  mitk::ImageTimeSelector::Pointer imageTimeSelector = mitk::ImageTimeSelector::New();
-  imageTimeSelector->SetInput(this->m_DynamicImage);
-  imageTimeSelector->SetTimeNr(0);
-  imageTimeSelector->UpdateLargestPossibleRegion();
-  mitk::Image::Pointer baselineImage;
-  baselineImage = imageTimeSelector->GetOutput();
-  
-  if (m_BaselineStartTimeStep == m_BaselineEndTimeStep)
+    auto conversion = [functor](const TPixel_input &value, const TPixel_baseline &baseline, std::size_t) mutable
+    {
+      return functor(value, baseline);
+    };
+    this->ConvertVoxelCurves<TPixel_input, TPixel_baseline>(itkDynamicImage, baselineStart, baselineEnd, conversion, outputBuffer);
+  }
+  else if (this->m_isTurboFlashSequence)
   {
-    this->m_BaselineImage = imageTimeSelector->GetOutput();
+    mitk::ConvertToConcentrationTurboFlashFunctor<TPixel_input, TPixel_baseline, double> functor;
+    functor.initialize(this->m_RelaxationTime, this->m_Relaxivity, this->m_RecoveryTime);
+
+    auto conversion = [functor](const TPixel_input &value, const TPixel_baseline &baseline, std::size_t) mutable
+    {
+      return functor(value, baseline);
+    };
+    this->ConvertVoxelCurves<TPixel_input, TPixel_baseline>(itkDynamicImage, baselineStart, baselineEnd, conversion, outputBuffer);
   }
-  else
+  else if (this->m_UsingT1Map)
   {
-    try
+    if (this->m_T10Image.IsNull())
     {
-      AccessFixedDimensionByItk(this->m_DynamicImage, mitk::ConcentrationCurveGenerator::CalculateAverageBaselineImage, 4);
+      mitkThrow() << "Error in ConcentrationCurveGenerator. Conversion via T1 map is selected, but no T1 map is set.";
     }
-    catch (itk::ExceptionObject & err)
+
+    ConvertedImageType::Pointer itkT10Image = ConvertedImageType::New();
+    mitk::CastToItkImage(m_T10Image, itkT10Image);
+
+    const auto dynamicSize = itkDynamicImage->GetLargestPossibleRegion().GetSize();
+    const auto t10Size = itkT10Image->GetLargestPossibleRegion().GetSize();
+    if (dynamicSize[0] != t10Size[0] || dynamicSize[1] != t10Size[1] || dynamicSize[2] != t10Size[2])
     {
-      std::cerr << "ExceptionObject in ConcentrationCurveGenerator::CalculateAverageBaselineImage caught!" << std::endl;
-      std::cerr << err << std::endl;
+      mitkThrow() << "Error in ConcentrationCurveGenerator. Size of the T1 map does not match the dynamic image.";
     }
-  }
-}
 
-template<class TPixel>
-void mitk::ConcentrationCurveGenerator::CalculateAverageBaselineImage(const itk::Image<TPixel, 4> *itkBaselineImage)
-{
-  if (itkBaselineImage == NULL)
-  {
-    mitkThrow() << "Error in ConcentrationCurveGenerator::CalculateAverageBaselineImage. Input image is NULL.";
-  }
-  if (m_BaselineStartTimeStep > m_BaselineEndTimeStep)
-  {
-    mitkThrow() << "Error in ConcentrationCurveGenerator::CalculateAverageBaselineImage. End time point is before start time point.";
-  }
-  
-  typedef itk::Image<TPixel, 4> TPixel4DImageType;
-  typedef itk::Image<double, 3> Double3DImageType;
-  typedef itk::Image<double, 4> Double4DImageType;
-  typedef itk::ExtractImageFilter<TPixel4DImageType, TPixel4DImageType> ExtractImageFilterType;
-  typedef itk::ExtractImageFilter<Double4DImageType, Double3DImageType> Extract3DImageFilterType;
-  typedef itk::MeanProjectionImageFilter<TPixel4DImageType,Double4DImageType> MeanProjectionImageFilterType;
-
-  typename MeanProjectionImageFilterType::Pointer MeanProjectionImageFilter = MeanProjectionImageFilterType::New();
-  typename Extract3DImageFilterType::Pointer Extract3DImageFilter = Extract3DImageFilterType::New();
-  typename TPixel4DImageType::RegionType region_input = itkBaselineImage->GetLargestPossibleRegion();
-
-  if (m_BaselineEndTimeStep > region_input.GetSize()[3])
-  {
-    mitkThrow() << "Error in ConcentrationCurveGenerator::CalculateAverageBaselineImage. End time point is larger than total number of time points.";
-  }
+    mitk::ConvertToConcentrationViaT1CalcFunctor<TPixel_input, TPixel_baseline, double, double> functor;
+    functor.initialize(this->m_Relaxivity, this->m_RecoveryTime, this->m_FlipAngle);
 
-  typename ExtractImageFilterType::Pointer ExtractFilter = ExtractImageFilterType::New();
-  typename TPixel4DImageType::Pointer baselineTimeFrameImage = TPixel4DImageType::New();
-  typename TPixel4DImageType::RegionType extractionRegion;
-  typename TPixel4DImageType::SizeType size_input_aux = region_input.GetSize();
-  size_input_aux[3] = m_BaselineEndTimeStep - m_BaselineStartTimeStep + 1;
-  typename TPixel4DImageType::IndexType start_input_aux = region_input.GetIndex();
-  start_input_aux[3] = m_BaselineStartTimeStep;
-  extractionRegion.SetSize(size_input_aux);
-  extractionRegion.SetIndex(start_input_aux);
-  ExtractFilter->SetExtractionRegion(extractionRegion);
-  ExtractFilter->SetInput(itkBaselineImage);
-  ExtractFilter->SetDirectionCollapseToSubmatrix();
-  try
-  {
-    ExtractFilter->Update();
-  }
-  catch (itk::ExceptionObject & err)
-  {
-    std::cerr << "ExceptionObject caught!" << std::endl;
-    std::cerr << err << std::endl;
-  }
-  baselineTimeFrameImage = ExtractFilter->GetOutput();
-  MeanProjectionImageFilter->SetProjectionDimension(3);
-  MeanProjectionImageFilter->SetInput(baselineTimeFrameImage);
-  try
-  {
-    MeanProjectionImageFilter->Update();
+    const double *t10Buffer = itkT10Image->GetBufferPointer();
+    auto conversion = [functor, t10Buffer](const TPixel_input &value, const TPixel_baseline &baseline, std::size_t voxel) mutable
+    {
+      return functor(value, baseline, t10Buffer[voxel]);
+    };
+    this->ConvertVoxelCurves<TPixel_input, TPixel_baseline>(itkDynamicImage, baselineStart, baselineEnd, conversion, outputBuffer);
   }
-  catch (itk::ExceptionObject & err)
+  else if (this->m_AbsoluteSignalEnhancement)
   {
-    std::cerr << "ExceptionObject caught!" << std::endl;
-    std::cerr << err << std::endl;
+    mitk::ConvertToConcentrationAbsoluteFunctor<TPixel_input, TPixel_baseline, double> functor;
+    functor.initialize(this->m_Factor);
+
+    auto conversion = [functor](const TPixel_input &value, const TPixel_baseline &baseline, std::size_t) mutable
+    {
+      return functor(value, baseline);
+    };
+    this->ConvertVoxelCurves<TPixel_input, TPixel_baseline>(itkDynamicImage, baselineStart, baselineEnd, conversion, outputBuffer);
   }
-  Extract3DImageFilter->SetInput(MeanProjectionImageFilter->GetOutput());
-  size_input_aux[3] = 0;
-  start_input_aux[3] = 0;
-  extractionRegion.SetSize(size_input_aux);
-  extractionRegion.SetIndex(start_input_aux);
-  Extract3DImageFilter->SetExtractionRegion(extractionRegion);
-  Extract3DImageFilter->SetDirectionCollapseToSubmatrix();
-  try
+  else if (this->m_RelativeSignalEnhancement)
   {
-    Extract3DImageFilter->Update();
+    mitk::ConvertToConcentrationRelativeFunctor<TPixel_input, TPixel_baseline, double> functor;
+    functor.initialize(this->m_Factor);
+
+    auto conversion = [functor](const TPixel_input &value, const TPixel_baseline &baseline, std::size_t) mutable
+    {
+      return functor(value, baseline);
+    };
+    this->ConvertVoxelCurves<TPixel_input, TPixel_baseline>(itkDynamicImage, baselineStart, baselineEnd, conversion, outputBuffer);
   }
-  catch (itk::ExceptionObject & err)
+  else
   {
-    std::cerr << "ExceptionObject caught!" << std::endl;
-    std::cerr << err << std::endl;
+    mitkThrow() << "Error in ConcentrationCurveGenerator. No conversion method is selected.";
   }
-
-  Image::Pointer mitkBaselineImage = Image::New();
-  CastToMitkImage(Extract3DImageFilter->GetOutput(), mitkBaselineImage);
-  this->m_BaselineImage = mitkBaselineImage;
 }
 
-
-mitk::Image::Pointer mitk::ConcentrationCurveGenerator::ConvertSignalToConcentrationCurve(const mitk::Image* inputImage,const mitk::Image* baselineImage)
+template<class TPixel_input, class TPixel_baseline, class TConversion>
+void mitk::ConcentrationCurveGenerator::ConvertVoxelCurves(const itk::Image<TPixel_input, 4> *itkDynamicImage, unsigned int baselineStart, unsigned int baselineEnd, const TConversion &conversion, double *outputBuffer)
 {
-  mitk::PixelType m_PixelType = inputImage->GetPixelType();
-  AccessTwoImagesFixedDimensionByItk(inputImage, baselineImage, mitk::ConcentrationCurveGenerator::convertToConcentration, 3);
-  return m_ConvertSignalToConcentrationCurve_OutputImage;
-
-}
+  const auto size = itkDynamicImage->GetBufferedRegion().GetSize();
+  const std::size_t voxelCount = static_cast<std::size_t>(size[0]) * size[1] * size[2];
+  const std::size_t timeSteps = size[3];
+  const std::size_t baselineCount = baselineEnd - baselineStart + 1;
+  const TPixel_input *inputBuffer = itkDynamicImage->GetBufferPointer();
 
+  const std::size_t blockCount = (voxelCount + ConversionBlockSize - 1) / ConversionBlockSize;
 
-template<class TPixel_input, class TPixel_baseline>
-mitk::Image::Pointer mitk::ConcentrationCurveGenerator::convertToConcentration(const itk::Image<TPixel_input, 3> *itkInputImage, const itk::Image<TPixel_baseline, 3> *itkBaselineImage)
-{
-    typedef itk::Image<TPixel_input, 3> InputImageType;
-    typedef itk::Image<TPixel_baseline, 3> BaselineImageType;
-
+  auto convertBlock = [&](itk::SizeValueType block)
+  {
+    const std::size_t first = block * ConversionBlockSize;
+    const std::size_t last = std::min(first + ConversionBlockSize, voxelCount);
 
-    if (this->m_isT2weightedImage)
+    // baseline: mean over the baseline time steps (same summation order as itk::MeanProjectionImageFilter)
+    std::vector<double> sums(last - first, 0.0);
+    for (std::size_t t = baselineStart; t <= baselineEnd; ++t)
     {
-        typedef mitk::ConvertT2ConcentrationFunctor <TPixel_input, TPixel_baseline, double> ConversionFunctorT2Type;
-        typedef itk::BinaryFunctorImageFilter<InputImageType, BaselineImageType, ConvertedImageType, ConversionFunctorT2Type> FilterT2Type;
-
-
-        ConversionFunctorT2Type ConversionT2Functor;
-        ConversionT2Functor.initialize(this->m_T2Factor, this->m_T2EchoTime);
-
-        typename FilterT2Type::Pointer ConversionT2Filter = FilterT2Type::New();
-
-        ConversionT2Filter->SetFunctor(ConversionT2Functor);
-        ConversionT2Filter->SetInput1(itkInputImage);
-        ConversionT2Filter->SetInput2(itkBaselineImage);
-
-        ConversionT2Filter->Update();
-
-        m_ConvertSignalToConcentrationCurve_OutputImage = mitk::ImportItkImage(ConversionT2Filter->GetOutput())->Clone();
+      const TPixel_input *input = inputBuffer + t * voxelCount;
+      for (std::size_t i = first; i < last; ++i)
+      {
+        sums[i - first] += static_cast<double>(input[i]);
       }
+    }
 
-    else
+    std::vector<TPixel_baseline> baselines(last - first);
+    for (std::size_t i = 0; i < baselines.size(); ++i)
     {
-        if(this->m_isTurboFlashSequence)
-        {
-            typedef mitk::ConvertToConcentrationTurboFlashFunctor <TPixel_input, TPixel_baseline, double> ConversionFunctorTurboFlashType;
-            typedef itk::BinaryFunctorImageFilter<InputImageType, BaselineImageType, ConvertedImageType, ConversionFunctorTurboFlashType> FilterTurboFlashType;
-
-            ConversionFunctorTurboFlashType ConversionTurboFlashFunctor;
-            ConversionTurboFlashFunctor.initialize(this->m_RelaxationTime, this->m_Relaxivity, this->m_RecoveryTime);
-
-            typename FilterTurboFlashType::Pointer ConversionTurboFlashFilter = FilterTurboFlashType::New();
-
-            ConversionTurboFlashFilter->SetFunctor(ConversionTurboFlashFunctor);
-            ConversionTurboFlashFilter->SetInput1(itkInputImage);
-            ConversionTurboFlashFilter->SetInput2(itkBaselineImage);
-
-            ConversionTurboFlashFilter->Update();
-            m_ConvertSignalToConcentrationCurve_OutputImage = mitk::ImportItkImage(ConversionTurboFlashFilter->GetOutput())->Clone();
-
-
-        }
-        else if(this->m_UsingT1Map)
-        {
-            typename ConvertedImageType::Pointer itkT10Image = ConvertedImageType::New();
-            mitk::CastToItkImage(m_T10Image, itkT10Image);
-
-            typedef mitk::ConvertToConcentrationViaT1CalcFunctor <TPixel_input, TPixel_baseline, double, double> ConvertToConcentrationViaT1CalcFunctorType;
-            typedef itk::TernaryFunctorImageFilter<InputImageType, BaselineImageType, ConvertedImageType, ConvertedImageType, ConvertToConcentrationViaT1CalcFunctorType> FilterT1MapType;
-
-            ConvertToConcentrationViaT1CalcFunctorType ConversionT1MapFunctor;
-            ConversionT1MapFunctor.initialize(this->m_Relaxivity, this->m_RecoveryTime, this->m_FlipAngle);
-
-            typename FilterT1MapType::Pointer ConversionT1MapFilter = FilterT1MapType::New();
-
-            ConversionT1MapFilter->SetFunctor(ConversionT1MapFunctor);
-            ConversionT1MapFilter->SetInput1(itkInputImage);
-            ConversionT1MapFilter->SetInput2(itkBaselineImage);
-            ConversionT1MapFilter->SetInput3(itkT10Image);
-
-            ConversionT1MapFilter->Update();
-            m_ConvertSignalToConcentrationCurve_OutputImage = mitk::ImportItkImage(ConversionT1MapFilter->GetOutput())->Clone();
-
-
-        }
-
-        else if(this->m_AbsoluteSignalEnhancement)
-        {
-            typedef mitk::ConvertToConcentrationAbsoluteFunctor <TPixel_input, TPixel_baseline, double> ConversionFunctorAbsoluteType;
-            typedef itk::BinaryFunctorImageFilter<InputImageType, BaselineImageType, ConvertedImageType, ConversionFunctorAbsoluteType> FilterAbsoluteType;
-
-            ConversionFunctorAbsoluteType ConversionAbsoluteFunctor;
-            ConversionAbsoluteFunctor.initialize(this->m_Factor);
-
-            typename FilterAbsoluteType::Pointer ConversionAbsoluteFilter = FilterAbsoluteType::New();
-
-            ConversionAbsoluteFilter->SetFunctor(ConversionAbsoluteFunctor);
-            ConversionAbsoluteFilter->SetInput1(itkInputImage);
-            ConversionAbsoluteFilter->SetInput2(itkBaselineImage);
-
-            ConversionAbsoluteFilter->Update();
-
-            m_ConvertSignalToConcentrationCurve_OutputImage = mitk::ImportItkImage(ConversionAbsoluteFilter->GetOutput())->Clone();
-        }
-
-        else if(this->m_RelativeSignalEnhancement)
-        {
-            typedef mitk::ConvertToConcentrationRelativeFunctor <TPixel_input, TPixel_baseline, double> ConversionFunctorRelativeType;
-            typedef itk::BinaryFunctorImageFilter<InputImageType, BaselineImageType, ConvertedImageType, ConversionFunctorRelativeType> FilterRelativeType;
-
-            ConversionFunctorRelativeType ConversionRelativeFunctor;
-            ConversionRelativeFunctor.initialize(this->m_Factor);
-
-            typename FilterRelativeType::Pointer ConversionRelativeFilter = FilterRelativeType::New();
-
-            ConversionRelativeFilter->SetFunctor(ConversionRelativeFunctor);
-            ConversionRelativeFilter->SetInput1(itkInputImage);
-            ConversionRelativeFilter->SetInput2(itkBaselineImage);
-
-            ConversionRelativeFilter->Update();
-
-            m_ConvertSignalToConcentrationCurve_OutputImage = mitk::ImportItkImage(ConversionRelativeFilter->GetOutput())->Clone();
-        }
+      baselines[i] = static_cast<TPixel_baseline>(sums[i] / baselineCount);
+    }
 
+    // the functors are not const, so every block works on its own copy
+    TConversion localConversion = conversion;
+    for (std::size_t t = 0; t < timeSteps; ++t)
+    {
+      const TPixel_input *input = inputBuffer + t * voxelCount;
+      double *output = outputBuffer + t * voxelCount;
+      for (std::size_t i = first; i < last; ++i)
+      {
+        output[i] = localConversion(input[i], baselines[i - first], i);
+      }
     }
-    return m_ConvertSignalToConcentrationCurve_OutputImage;
+  };
 
+  itk::MultiThreaderBase::Pointer threader = itk::MultiThreaderBase::New();
+  threader->ParallelizeArray(0, blockCount, convertBlock, nullptr);
 }
-
-
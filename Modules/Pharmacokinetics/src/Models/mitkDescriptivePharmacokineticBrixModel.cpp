@@ -144,6 +144,17 @@ mitk::DescriptivePharmacokineticBrixModel::GetNumberOfStaticParameters() const
 mitk::DescriptivePharmacokineticBrixModel::ModelResultType
 mitk::DescriptivePharmacokineticBrixModel::ComputeModelfunction(const ParametersType& parameters)
 const
+{
+  ModelResultType signal(m_TimeGrid.GetSize());
+
+  this->ComputeModelfunctionInPlace(parameters, signal);
+
+  return signal;
+}
+
+void
+mitk::DescriptivePharmacokineticBrixModel::ComputeModelfunctionInPlace(const ParametersType& parameters,
+    ModelResultType& signal) const
 {
   if (m_TimeGrid.GetSize() == 0)
   {
@@ -155,9 +166,6 @@ const
     itkExceptionMacro("Injection time is 0! Cannot Calculate Signal");
   }
 
-
-  ModelResultType signal(m_TimeGrid.GetSize());
-
   double tx        = 0;
   double amplitude = parameters[POSITION_PARAMETER_A];
   double       kel = parameters[POSITION_PARAMETER_kel];
@@ -204,9 +212,6 @@ const
 
     *signalPos = value * m_S0;
   }
-
-  return signal;
-
 }
 
 void mitk::DescriptivePharmacokineticBrixModel::SetStaticParameter(const ParameterNameType& name,
@@ -128,6 +128,16 @@ mitk::ThreeStepLinearModel::ParamterUnitMapType mitk::ThreeStepLinearModel::GetD
 
 mitk::ThreeStepLinearModel::ModelResultType
 mitk::ThreeStepLinearModel::ComputeModelfunction(const ParametersType& parameters) const
+{
+  ModelResultType signal(m_TimeGrid.GetSize());
+
+  this->ComputeModelfunctionInPlace(parameters, signal);
+
+  return signal;
+};
+
+void
+mitk::ThreeStepLinearModel::ComputeModelfunctionInPlace(const ParametersType& parameters, ModelResultType& signal) const
 {
   //Model Parameters
   double     S0 = (double) parameters[POSITION_PARAMETER_S0];
@@ -140,8 +150,6 @@ mitk::ThreeStepLinearModel::ComputeModelfunction(const ParametersType& parameter
   double     b1 = S0-a1*t1 ;
   double     b2 = (a1*t2+ b1) - (a2*t2);
 
-  ModelResultType signal(m_TimeGrid.GetSize());
-
   TimeGridType::const_iterator timeGridEnd = m_TimeGrid.end();
   ModelResultType::iterator signalPos = signal.begin();
 
@@ -160,8 +168,6 @@ mitk::ThreeStepLinearModel::ComputeModelfunction(const ParametersType& parameter
           *signalPos = a2*(*gridPos)+b2;
       }
   }
-
-  return signal;
 };
 
 mitk::ThreeStepLinearModel::ParameterNamesType mitk::ThreeStepLinearModel::GetStaticParameterNames() const
@@ -87,7 +87,16 @@ mitk::TwoStepLinearModel::GetNumberOfDerivedParameters() const
 mitk::TwoStepLinearModel::ModelResultType
 mitk::TwoStepLinearModel::ComputeModelfunction(const ParametersType& parameters) const
 {
+  ModelResultType signal(m_TimeGrid.GetSize());
+
+  this->ComputeModelfunctionInPlace(parameters, signal);
+
+  return signal;
+};
 
+void
+mitk::TwoStepLinearModel::ComputeModelfunctionInPlace(const ParametersType& parameters, ModelResultType& signal) const
+{
   //Model Parameters
   const auto t = parameters[POSITION_PARAMETER_t] ;
   const auto a1 = parameters[POSITION_PARAMETER_a1] ;
@@ -95,8 +104,6 @@ mitk::TwoStepLinearModel::ComputeModelfunction(const ParametersType& parameters)
   const auto b1 = parameters[POSITION_PARAMETER_y1] ;
   const auto b2 = (a1 - a2)*t + b1;
 
-  ModelResultType signal(m_TimeGrid.GetSize());
-
   TimeGridType::const_iterator timeGridEnd = m_TimeGrid.end();
   ModelResultType::iterator signalPos = signal.begin();
 
@@ -111,8 +118,6 @@ mitk::TwoStepLinearModel::ComputeModelfunction(const ParametersType& parameters)
           *signalPos = a2*(*gridPos)+b2;
       }
   }
-
-  return signal;
 };
 
 mitk::TwoStepLinearModel::ParameterNamesType mitk::TwoStepLinearModel::GetStaticParameterNames() const
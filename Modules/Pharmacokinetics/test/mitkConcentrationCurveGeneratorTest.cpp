@@ -0,0 +1,177 @@
+/*============================================================================
+
+The Medical Imaging Interaction Toolkit (MITK)
+
+Copyright (c) German Cancer Research Center (DKFZ)
+All rights reserved.
+
+Use of this source code is governed by a 3-clause BSD license that can be
+found in the LICENSE file.
+
+============================================================================*/
+
+// Testing
+#include "mitkTestingMacros.h"
+#include "mitkTestFixture.h"
+
+//MITK includes
+#include "mitkConcentrationCurveGenerator.h"
+#include "mitkConvertToConcentrationTurboFlashFunctor.h"
+#include "mitkImageCast.h"
+#include "mitkImagePixelReadAccessor.h"
+
+#include "itkImageRegionIteratorWithIndex.h"
+
+#include <functional>
+
+class mitkConcentrationCurveGeneratorTestSuite : public mitk::TestFixture
+{
+  CPPUNIT_TEST_SUITE(mitkConcentrationCurveGeneratorTestSuite);
+  MITK_TEST(AbsoluteEnhancementFirstFrameBaselineTest);
+  MITK_TEST(RelativeEnhancementAveragedBaselineTest);
+  MITK_TEST(TurboFlashTest);
+  MITK_TEST(InvalidBaselineRangeTest);
+  CPPUNIT_TEST_SUITE_END();
+
+private:
+  typedef itk::Image<unsigned short, 4> SignalImageType;
+
+  mitk::Image::Pointer m_DynamicImage;
+  SignalImageType::Pointer m_ItkDynamicImage;
+  mitk::ConcentrationCurveGenerator::Pointer m_Generator;
+
+  double GetSignal(const itk::Index<3>& index, unsigned int timeStep) const
+  {
+    itk::Index<4> index4D;
+    index4D[0] = index[0];
+    index4D[1] = index[1];
+    index4D[2] = index[2];
+    index4D[3] = timeStep;
+    return m_ItkDynamicImage->GetPixel(index4D);
+  }
+
+  void CheckConvertedImage(const mitk::Image* converted, const std::function<double(const itk::Index<3>&, unsigned int)>& expected)
+  {
+    CPPUNIT_ASSERT_EQUAL(m_DynamicImage->GetTimeSteps(), converted->GetTimeSteps());
+
+    mitk::ImagePixelReadAccessor<double, 4> accessor(converted);
+    itk::Index<4> index;
+    for (index[3] = 0; index[3] < 6; ++index[3])
+      for (index[2] = 0; index[2] < 3; ++index[2])
+        for (index[1] = 0; index[1] < 4; ++index[1])
+          for (index[0] = 0; index[0] < 5; ++index[0])
+          {
+            itk::Index<3> index3D;
+            index3D[0] = index[0];
+            index3D[1] = index[1];
+            index3D[2] = index[2];
+            CPPUNIT_ASSERT_DOUBLES_EQUAL(expected(index3D, index[3]), accessor.GetPixelByIndex(index), 1e-12);
+          }
+  }
+
+public:
+  void setUp() override
+  {
+    SignalImageType::SizeType size;
+    size[0] = 5;
+    size[1] = 4;
+    size[2] = 3;
+    size[3] = 6;
+
+    m_ItkDynamicImage = SignalImageType::New();
+    m_ItkDynamicImage->SetRegions(size);
+    m_ItkDynamicImage->Allocate();
+
+    itk::ImageRegionIteratorWithIndex<SignalImageType> iter(m_ItkDynamicImage, m_ItkDynamicImage->GetLargestPossibleRegion());
+    for (iter.GoToBegin(); !iter.IsAtEnd(); ++iter)
+    {
+      const auto index = iter.GetIndex();
+      // voxels with index[0] == 0 have a zero signal to cover the special cases of the functors
+      const unsigned short value = index[0] == 0 ? 0 : static_cast<unsigned short>(100 + 10 * index[0] + 7 * index[1] + 3 * index[2] + 25 * index[3] * index[3]);
+      iter.Set(value);
+    }
+
+    m_DynamicImage = mitk::Image::New();
+    mitk::CastToMitkImage(m_ItkDynamicImage, m_DynamicImage);
+
+    m_Generator = mitk::ConcentrationCurveGenerator::New();
+    m_Generator->SetDynamicImage(m_DynamicImage);
+  }
+
+  void tearDown() override
+  {
+    m_Generator = nullptr;
+    m_DynamicImage = nullptr;
+    m_ItkDynamicImage = nullptr;
+  }
+
+  void AbsoluteEnhancementFirstFrameBaselineTest()
+  {
+    m_Generator->SetAbsoluteSignalEnhancement(true);
+    m_Generator->SetFactor(0.5);
+    m_Generator->SetBaselineStartTimeStep(0);
+    m_Generator->SetBaselineEndTimeStep(0);
+
+    mitk::Image::Pointer converted = m_Generator->GetConvertedImage();
+
+    CheckConvertedImage(converted, [this](const itk::Index<3>& index, unsigned int t)
+    {
+      return 0.5 * (this->GetSignal(index, t) - this->GetSignal(index, 0));
+    });
+  }
+
+  void RelativeEnhancementAveragedBaselineTest()
+  {
+    m_Generator->SetRelativeSignalEnhancement(true);
+    m_Generator->SetFactor(2.0);
+    m_Generator->SetBaselineStartTimeStep(1);
+    m_Generator->SetBaselineEndTimeStep(3);
+
+    mitk::Image::Pointer converted = m_Generator->GetConvertedImage();
+
+    CheckConvertedImage(converted, [this](const itk::Index<3>& index, unsigned int t)
+    {
+      double sum = 0.0;
+      for (unsigned int i = 1; i <= 3; ++i)
+      {
+        sum += this->GetSignal(index, i);
+      }
+      const double baseline = sum / 3;
+      return baseline != 0 ? 2.0 * (this->GetSignal(index, t) - baseline) / baseline : 0.0;
+    });
+  }
+
+  void TurboFlashTest()
+  {
+    m_Generator->SetisTurboFlashSequence(true);
+    m_Generator->SetRelaxationTime(1.2);
+    m_Generator->SetRelaxivity(4.3);
+    m_Generator->SetRecoveryTime(0.125);
+    m_Generator->SetBaselineStartTimeStep(0);
+    m_Generator->SetBaselineEndTimeStep(0);
+
+    mitk::Image::Pointer converted = m_Generator->GetConvertedImage();
+
+    mitk::ConvertToConcentrationTurboFlashFunctor<unsigned short, unsigned short, double> functor;
+    functor.initialize(1.2, 4.3, 0.125);
+
+    CheckConvertedImage(converted, [this, &functor](const itk::Index<3>& index, unsigned int t)
+    {
+      return functor(static_cast<unsigned short>(this->GetSignal(index, t)), static_cast<unsigned short>(this->GetSignal(index, 0)));
+    });
+  }
+
+  void InvalidBaselineRangeTest()
+  {
+    m_Generator->SetAbsoluteSignalEnhancement(true);
+    m_Generator->SetBaselineStartTimeStep(3);
+    m_Generator->SetBaselineEndTimeStep(2);
+    CPPUNIT_ASSERT_THROW(m_Generator->GetConvertedImage(), mitk::Exception);
+
+    m_Generator->SetBaselineStartTimeStep(0);
+    m_Generator->SetBaselineEndTimeStep(6);
+    CPPUNIT_ASSERT_THROW(m_Generator->GetConvertedImage(), mitk::Exception);
+  }
+};
+
+MITK_TEST_SUITE_REGISTRATION(mitkConcentrationCurveGenerator)
@@ -20,6 +20,14 @@ found in the LICENSE file.
 
 #include <Poco/Zip/ZipLocalFileHeader.h>
 
+namespace Poco
+{
+  namespace Zip
+  {
+    class Compress;
+  }
+}
+
 namespace tinyxml2
 {
   class XMLDocument;
@@ -48,6 +56,9 @@ namespace mitk
      * Attempts to read the provided file and create objects with
      * parent/child relations into a DataStorage.
      *
+     * The scene file is extracted into a temporary directory first, as the readers used by the
+     * deserializers work on files only.
+     *
      * \param filename full filename of the scene file
      * \param storage If given, this DataStorage is used instead of a newly created one
      * \param clearStorageFirst If set, the provided DataStorage will be cleared before populating it with the loaded
@@ -86,6 +97,15 @@ namespace mitk
      * Attempts to write a scene file, which contains the nodes of the
      * provided DataStorage, their parent/child relations, and properties.
      *
+     * The base data of each node is still serialized into a temporary file, as the writers used by
+     * the serializers work on files only. These files are moved into the scene file as soon as the
+     * node is serialized, so temporary disk space is only needed for one node at a time. Files that
+     * are compressed already (e.g. gzip encoded NRRD images) are stored without being deflated a
+     * second time. Property lists and the index are added to the scene file from memory.
+     *
+     * The scene file is written to a temporary file next to filename, which replaces filename
+     * only if saving succeeded. An existing file is left untouched by a failed save.
+     *
      * \param sceneNodes
      * \param storage a DataStorage containing all nodes that should be saved
      * \param filename
@@ -122,7 +142,7 @@ namespace mitk
     std::string CreateEmptyTempDirectory();
 
     tinyxml2::XMLElement *SaveBaseData(tinyxml2::XMLDocument &doc, BaseData *data, const std::string &filenamehint, bool &error);
-    tinyxml2::XMLElement *SavePropertyList(tinyxml2::XMLDocument &doc, PropertyList *propertyList, const std::string &filenamehint);
+    tinyxml2::XMLElement *SavePropertyList(tinyxml2::XMLDocument &doc, PropertyList *propertyList, const std::string &filenamehint, Poco::Zip::Compress &zipper);
 
     void OnUnzipError(const void *pSender, std::pair<const Poco::Zip::ZipLocalFileHeader, const std::string> &info);
     void OnUnzipOk(const void *pSender, std::pair<const Poco::Zip::ZipLocalFileHeader, const Poco::Path> &info);
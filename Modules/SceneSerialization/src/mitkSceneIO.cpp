@@ -10,8 +10,11 @@ found in the LICENSE file.
 
 ============================================================================*/
 
+#include <Poco/DateTime.h>
 #include <Poco/Delegate.h>
+#include <Poco/File.h>
 #include <Poco/Path.h>
+#include <Poco/String.h>
 #include <Poco/TemporaryFile.h>
 #include <Poco/Zip/Compress.h>
 #include <Poco/Zip/Decompress.h>
@@ -38,6 +41,96 @@ found in the LICENSE file.
 
 #include <tinyxml2.h>
 
+namespace
+{
+  /** Checks if a file written by a serializer is compressed already. Such files are
+   * stored in the scene file as they are instead of being deflated a second time.*/
+  bool IsCompressedPayload(const Poco::Path &path)
+  {
+    const auto extension = Poco::toLower(path.getExtension());
+
+    if ("gz" == extension || "bz2" == extension || "zip" == extension || "png" == extension ||
+        "jpg" == extension || "jpeg" == extension)
+      return true;
+
+    if ("nrrd" == extension)
+    {
+      // The data of a NRRD file is compressed if its header says so
+      std::ifstream file(path.toString(), std::ios::binary);
+      std::string line;
+
+      while (std::getline(file, line) && !line.empty())
+      {
+        if (0 == line.compare(0, 9, "encoding:"))
+        {
+          const auto encoding = Poco::trim(line.substr(9));
+          return "gzip" == encoding || "gz" == encoding || "bzip2" == encoding || "bz2" == encoding;
+        }
+      }
+    }
+
+    return false;
+  }
+
+  /** Moves all files of the directory into the zip file. Entries are named by their path relative
+   * to the directory of the initial call.*/
+  void MoveFilesToZip(Poco::Zip::Compress &zipper, const Poco::Path &directory, const Poco::Path &entryDirectory)
+  {
+    std::vector<Poco::File> files;
+    Poco::File(directory).list(files);
+
+    for (auto &file : files)
+    {
+      Poco::Path path(file.path());
+      Poco::Path entryName(entryDirectory);
+
+      if (file.isDirectory())
+      {
+        entryName.pushDirectory(path.getFileName());
+        MoveFilesToZip(zipper, path.makeDirectory(), entryName);
+      }
+      else
+      {
+        entryName.setFileName(path.getFileName());
+        const auto method = IsCompressedPayload(path) ? Poco::Zip::ZipCommon::CM_STORE : Poco::Zip::ZipCommon::CM_DEFLATE;
+        zipper.addFile(path, entryName, method);
+      }
+
+      file.remove(true);
+    }
+  }
+
+  /** Removes a file or directory (recursively) when going out of scope, if it still exists.*/
+  class TemporaryFileRemover
+  {
+  public:
+    explicit TemporaryFileRemover(const std::string &path) : m_Path(path) {}
+
+    ~TemporaryFileRemover()
+    {
+      if (m_Path.empty())
+        return;
+
+      try
+      {
+        Poco::File file(m_Path);
+        if (file.exists())
+          file.remove(true);
+      }
+      catch (const std::exception &e)
+      {
+        MITK_ERROR << "Could not delete temporary file " << m_Path << ": " << e.what();
+      }
+    }
+
+  private:
+    TemporaryFileRemover(const TemporaryFileRemover &) = delete;
+    TemporaryFileRemover &operator=(const TemporaryFileRemover &) = delete;
+
+    std::string m_Path;
+  };
+}
+
 mitk::SceneIO::SceneIO() : m_WorkingDirectory(""), m_UnzipErrors(0)
 {
 }
@@ -253,6 +346,33 @@ bool mitk::SceneIO::SaveScene(DataStorage::SetOfObjects::ConstPointer sceneNodes
     version->SetAttribute("FileVersion", 1);
     document.InsertEndChild(version);
 
+    // The base data serializers write into the working directory, as the writers they use work on
+    // files only. Their files are moved into the zip file node by node, so the working directory
+    // never holds more than one node. Property lists and index.xml are added from memory.
+    m_WorkingDirectory = CreateEmptyTempDirectory();
+    if (m_WorkingDirectory.empty())
+    {
+      MITK_ERROR << "Could not create temporary directory. Cannot create scene files.";
+      return false;
+    }
+
+    TemporaryFileRemover workingDirectoryRemover(m_WorkingDirectory);
+
+    // The zip file is written next to filename and only replaces an existing file at filename
+    // once it is complete. A failed save leaves such a file untouched.
+    const std::string temporaryFilename = filename + "." + UIDGenerator("tmp_").GetUID();
+    TemporaryFileRemover temporaryFileRemover(temporaryFilename);
+
+    std::ofstream file(temporaryFilename.c_str(), std::ios::binary | std::ios::out);
+    if (!file.good())
+    {
+      MITK_ERROR << "Could not open a zip file for writing: '" << temporaryFilename << "'";
+      return false;
+    }
+
+    Poco::Zip::Compress zipper(file, true);
+    const Poco::Path workingDirectory = Poco::Path(m_WorkingDirectory).makeDirectory();
+
     // DataStorage::SetOfObjects::ConstPointer sceneNodes = storage->GetSubset( predicate );
 
     if (sceneNodes.IsNull())
@@ -268,13 +388,6 @@ bool mitk::SceneIO::SaveScene(DataStorage::SetOfObjects::ConstPointer sceneNodes
 
       MITK_INFO << "Storing scene with " << sceneNodes->size() << " objects to " << filename;
 
-      m_WorkingDirectory = CreateEmptyTempDirectory();
-      if (m_WorkingDirectory.empty())
-      {
-        MITK_ERROR << "Could not create temporary directory. Cannot create scene files.";
-        return false;
-      }
-
       ProgressBar::GetInstance()->AddStepsToDo(sceneNodes->size());
 
       // find out about dependencies
@@ -367,7 +480,7 @@ bool mitk::SceneIO::SaveScene(DataStorage::SetOfObjects::ConstPointer sceneNodes
             if (propertyList && !propertyList->IsEmpty())
             {
               auto *baseDataPropertiesElement =
-                SavePropertyList(document, propertyList, filenameHint + "-data"); // returns a reference to a file
+                SavePropertyList(document, propertyList, filenameHint + "-data", zipper); // returns a reference to a file
               dataElement->InsertEndChild(baseDataPropertiesElement);
             }
 
@@ -382,7 +495,7 @@ bool mitk::SceneIO::SaveScene(DataStorage::SetOfObjects::ConstPointer sceneNodes
             if (propertyList && !propertyList->IsEmpty())
             {
               auto *renderWindowPropertiesElement =
-                SavePropertyList(document, propertyList, filenameHint + "-" + renderWindowName); // returns a reference to a file
+                SavePropertyList(document, propertyList, filenameHint + "-" + renderWindowName, zipper); // returns a reference to a file
               renderWindowPropertiesElement->SetAttribute("renderwindow", renderWindowName.c_str());
               nodeElement->InsertEndChild(renderWindowPropertiesElement);
             }
@@ -393,10 +506,12 @@ bool mitk::SceneIO::SaveScene(DataStorage::SetOfObjects::ConstPointer sceneNodes
           if (propertyList && !propertyList->IsEmpty())
           {
             auto *propertiesElement =
-              SavePropertyList(document, propertyList, filenameHint + "-node"); // returns a reference to a file
+              SavePropertyList(document, propertyList, filenameHint + "-node", zipper); // returns a reference to a file
             nodeElement->InsertEndChild(propertiesElement);
           }
           document.InsertEndChild(nodeElement);
+
+          MoveFilesToZip(zipper, workingDirectory, Poco::Path());
         }
         else
         {
@@ -407,57 +522,32 @@ bool mitk::SceneIO::SaveScene(DataStorage::SetOfObjects::ConstPointer sceneNodes
       } // end for all nodes
     }   // end if sceneNodes
 
-    std::string defaultLocale_WorkingDirectory = Poco::Path::transcode( m_WorkingDirectory );
+    // index.xml is written into the zip file directly
+    tinyxml2::XMLPrinter printer;
+    document.Print(&printer);
+    std::istringstream indexStream(printer.CStr());
 
-    auto xmlFilename = defaultLocale_WorkingDirectory + Poco::Path::separator() + "index.xml";
-    if (tinyxml2::XML_SUCCESS != document.SaveFile(xmlFilename.c_str()))
-    {
-      MITK_ERROR << "Could not write scene to " << defaultLocale_WorkingDirectory << Poco::Path::separator() << "index.xml"
-                 << "\nTinyXML reports '" << document.ErrorStr() << "'";
-      return false;
-    }
-    else
+    try
     {
-      try
-      {
-        Poco::File deleteFile(filename.c_str());
-        if (deleteFile.exists())
-        {
-          deleteFile.remove();
-        }
+      zipper.addFile(indexStream, Poco::DateTime(), Poco::Path("index.xml"));
+      zipper.close();
+      file.close();
 
-        // create zip at filename
-        std::ofstream file(filename.c_str(), std::ios::binary | std::ios::out);
-        if (!file.good())
-        {
-          MITK_ERROR << "Could not open a zip file for writing: '" << filename << "'";
-          return false;
-        }
-        else
-        {
-          Poco::Zip::Compress zipper(file, true);
-          Poco::Path tmpdir(m_WorkingDirectory);
-          zipper.addRecursive(tmpdir);
-          zipper.close();
-        }
-        try
-        {
-          Poco::File deleteDir(m_WorkingDirectory);
-          deleteDir.remove(true); // recursive
-        }
-        catch (...)
-        {
-          MITK_ERROR << "Could not delete temporary directory " << m_WorkingDirectory;
-          return false; // ok?
-        }
-      }
-      catch (std::exception &e)
+      if (file.fail())
       {
-        MITK_ERROR << "Could not create ZIP file from " << m_WorkingDirectory << "\nReason: " << e.what();
+        MITK_ERROR << "Could not write ZIP file " << temporaryFilename;
         return false;
       }
-      return true;
+
+      Poco::File(temporaryFilename).renameTo(filename);
+    }
+    catch (std::exception &e)
+    {
+      MITK_ERROR << "Could not create ZIP file " << filename << "\nReason: " << e.what();
+      return false;
     }
+
+    return true;
   }
   catch (std::exception &e)
   {
@@ -520,7 +610,7 @@ tinyxml2::XMLElement *mitk::SceneIO::SaveBaseData(tinyxml2::XMLDocument &doc, Ba
   return element;
 }
 
-tinyxml2::XMLElement *mitk::SceneIO::SavePropertyList(tinyxml2::XMLDocument &doc, PropertyList *propertyList, const std::string &filenamehint)
+tinyxml2::XMLElement *mitk::SceneIO::SavePropertyList(tinyxml2::XMLDocument &doc, PropertyList *propertyList, const std::string &filenamehint, Poco::Zip::Compress &zipper)
 {
   assert(propertyList);
 
@@ -532,11 +622,15 @@ tinyxml2::XMLElement *mitk::SceneIO::SavePropertyList(tinyxml2::XMLDocument &doc
 
   serializer->SetPropertyList(propertyList);
   serializer->SetFilenameHint(filenamehint);
-  std::string defaultLocale_WorkingDirectory = Poco::Path::transcode( m_WorkingDirectory );
-  serializer->SetWorkingDirectory(defaultLocale_WorkingDirectory);
   try
   {
-    std::string writtenfilename = serializer->Serialize();
+    // property lists are small, they are serialized into memory and added to the zip file directly
+    std::stringstream stream;
+    std::string writtenfilename = serializer->Serialize(stream);
+
+    if (!writtenfilename.empty())
+      zipper.addFile(stream, Poco::DateTime(), Poco::Path(writtenfilename));
+
     element->SetAttribute("file", writtenfilename.c_str());
     PropertyList::Pointer failedProperties = serializer->GetFailedProperties();
     if (failedProperties.IsNotNull())
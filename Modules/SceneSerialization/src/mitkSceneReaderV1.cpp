@@ -17,12 +17,20 @@ found in the LICENSE file.
 #include "mitkProgressBar.h"
 #include "mitkPropertyListDeserializer.h"
 #include "mitkSerializerMacros.h"
+#include <mitkLocaleSwitch.h>
 #include <mitkUIDManipulator.h>
 #include <mitkRenderingModeProperty.h>
 #include <tinyxml2.h>
 
+#include <mitkDedicatedThreads.h>
+
+#include <algorithm>
+#include <atomic>
+#include <condition_variable>
 #include <filesystem>
 #include <map>
+#include <mutex>
+#include <thread>
 
 MITK_REGISTER_SERIALIZER(SceneReaderV1)
 
@@ -105,88 +113,76 @@ bool mitk::SceneReaderV1::LoadScene(tinyxml2::XMLDocument &document, const std::
 
   // TODO prepare to detect errors (such as cycles) from wrongly written or edited xml files
 
-  // Get number of elements to initialze progress bar
-  //   1. if there is a <data type="..." file="..."> element,
-  //        - construct a name for the appropriate serializer
-  //        - try to instantiate this serializer via itk object factory
-  //        - if serializer could be created, use it to read the file into a BaseData object
-  //        - if successful, call the new node's SetData(..)
-
-  // create a node for the tag "data" and test if node was created
-  typedef std::vector<mitk::DataNode::Pointer> DataNodeVector;
-  DataNodeVector DataNodes;
-  unsigned int listSize = 0;
+  std::vector<const tinyxml2::XMLElement *> nodeElements;
   for (auto *element = document.FirstChildElement("node"); element != nullptr;
        element = element->NextSiblingElement("node"))
   {
-    ++listSize;
+    nodeElements.push_back(element);
   }
 
-  ProgressBar::GetInstance()->AddStepsToDo(listSize * 2);
-
-  // Deserialize base data properties before reading the actual data to be
-  // able to provide them as read-only meta data to the data reader.
-  std::map<std::string, PropertyList::Pointer> baseDataPropertyLists;
-
-  for (auto *nodeElement = document.FirstChildElement("node"); nodeElement != nullptr;
-       nodeElement = nodeElement->NextSiblingElement("node"))
-  {
-    const auto *uid = nodeElement->Attribute("UID");
-
-    if (uid == nullptr)
-      continue;
+  const auto numberOfNodes = nodeElements.size();
+  ProgressBar::GetInstance()->AddStepsToDo(numberOfNodes * 2);
 
-    auto *dataElement = nodeElement->FirstChildElement("data");
+  // The readers and property serializers switch to the "C" locale themselves. Since setlocale()
+  // is not thread-safe, it is installed once here so that their switches become no-ops.
+  LocaleSwitch localeSwitch("C");
 
-    if (dataElement != nullptr)
-    {
-      auto properties = DeserializeProperties(dataElement->FirstChildElement("properties"), workingDirectory);
+  // The data and properties of all nodes are independent of each other and are loaded
+  // concurrently (see GetNumberOfDedicatedThreads()). Progress is reported from this thread only.
+  std::vector<DataNode::Pointer> dataNodes(numberOfNodes);
+  std::vector<char> nodeErrors(numberOfNodes, 0);
 
-      if (properties.IsNotNull())
-        baseDataPropertyLists[uid] = properties;
-    }
-  }
+  std::atomic<std::size_t> nextNode(0);
+  std::size_t numberOfLoadedNodes = 0;
+  std::mutex mutex;
+  std::condition_variable nodeLoaded;
 
-  for (auto *element = document.FirstChildElement("node"); element != nullptr;
-       element = element->NextSiblingElement("node"))
+  auto loadNodes = [&]()
   {
-    mitk::PropertyList* properties = nullptr;
-    const auto *uid = element->Attribute("UID");
-
-    if (uid != nullptr)
+    for (auto i = nextNode++; i < numberOfNodes; i = nextNode++)
     {
-      auto iter = baseDataPropertyLists.find(uid);
+      bool nodeError = false;
+      dataNodes[i] = this->LoadNode(nodeElements[i], workingDirectory, nodeError);
+      nodeErrors[i] = nodeError;
 
-      if (iter != baseDataPropertyLists.end())
-        properties = iter->second;
-    }
+      {
+        std::lock_guard<std::mutex> lock(mutex);
+        ++numberOfLoadedNodes;
+      }
 
-    const auto *dataElement = element->FirstChildElement("data");
-    auto dataNode = this->LoadBaseDataFromDataTag(dataElement, properties, workingDirectory, error);
+      nodeLoaded.notify_one();
+    }
+  };
 
-    if (dataNode.IsNull())
-      continue;
+  const auto numberOfThreads = GetNumberOfDedicatedThreads(numberOfNodes);
+  std::vector<std::thread> threads;
 
-    auto* baseData = dataNode->GetData();
+  for (std::size_t i = 0; i < numberOfThreads; ++i)
+    threads.emplace_back(loadNodes);
 
-    if (baseData != nullptr && properties != nullptr)
-    {
-      baseData->SetPropertyList(properties);
-      ApplyProportionalTimeGeometryProperties(baseData);
-    }
+  for (std::size_t reportedNodes = 0; reportedNodes < numberOfNodes;)
+  {
+    std::unique_lock<std::mutex> lock(mutex);
+    nodeLoaded.wait(lock, [&]() { return numberOfLoadedNodes > reportedNodes; });
 
-    DataNodes.push_back(dataNode);
+    const auto newlyLoadedNodes = numberOfLoadedNodes - reportedNodes;
+    reportedNodes = numberOfLoadedNodes;
+    lock.unlock();
 
-    ProgressBar::GetInstance()->Progress();
+    ProgressBar::GetInstance()->Progress(newlyLoadedNodes);
   }
 
-  // iterate all nodes
-  // first level nodes should be <node> elements
-  auto nit = DataNodes.begin();
-  for (auto *element = document.FirstChildElement("node"); element != nullptr || nit != DataNodes.end();
-       element = element->NextSiblingElement("node"), ++nit)
+  for (auto &thread : threads)
+    thread.join();
+
+  // assemble the node relations in document order
+  for (std::size_t i = 0; i < numberOfNodes; ++i)
   {
-    mitk::DataNode::Pointer node = *nit;
+    const auto *element = nodeElements[i];
+    mitk::DataNode::Pointer node = dataNodes[i];
+
+    if (nodeErrors[i])
+      error = true;
 
     //   1. check child nodes
     const char *uida = element->Attribute("UID");
@@ -204,21 +200,10 @@ bool mitk::SceneReaderV1::LoadScene(tinyxml2::XMLDocument &document, const std::
       error = true;
     }
 
-    //   2. if there are <properties> nodes,
-    //        - instantiate the appropriate PropertyListDeSerializer
-    //        - use them to construct PropertyList objects
-    //        - add these properties to the node (if necessary, use renderwindow name)
-    bool success = DecorateNodeWithProperties(node, element, workingDirectory);
-    if (!success)
-    {
-      MITK_ERROR << "Could not load properties for node.";
-      error = true;
-    }
-
     // remember node for later adding to DataStorage
     m_OrderedNodePairs.push_back(std::make_pair(node, std::list<std::string>()));
 
-    //   3. if there are <source> elements, remember parent objects
+    //   2. if there are <source> elements, remember parent objects
     for (auto *source = element->FirstChildElement("source"); source != nullptr;
          source = source->NextSiblingElement("source"))
     {
@@ -320,6 +305,56 @@ bool mitk::SceneReaderV1::LoadScene(tinyxml2::XMLDocument &document, const std::
   return !error;
 }
 
+mitk::DataNode::Pointer mitk::SceneReaderV1::LoadNode(const tinyxml2::XMLElement *nodeElement,
+                                                      const std::string &workingDirectory,
+                                                      bool &error)
+{
+  try
+  {
+    //   1. if there is a <data type="..." file="..."> element,
+    //        - deserialize its properties before reading the actual data to be
+    //          able to provide them as read-only meta data to the data reader
+    //        - read the file into a BaseData object and call the new node's SetData(..)
+    const auto *dataElement = nodeElement->FirstChildElement("data");
+    PropertyList::Pointer properties;
+
+    if (dataElement != nullptr && nodeElement->Attribute("UID") != nullptr)
+      properties = DeserializeProperties(dataElement->FirstChildElement("properties"), workingDirectory);
+
+    auto node = this->LoadBaseDataFromDataTag(dataElement, properties, workingDirectory, error);
+    auto *baseData = node->GetData();
+
+    if (baseData != nullptr && properties.IsNotNull())
+    {
+      baseData->SetPropertyList(properties);
+      ApplyProportionalTimeGeometryProperties(baseData);
+    }
+
+    //   2. if there are <properties> nodes,
+    //        - instantiate the appropriate PropertyListDeSerializer
+    //        - use them to construct PropertyList objects
+    //        - add these properties to the node (if necessary, use renderwindow name)
+    if (!this->DecorateNodeWithProperties(node, nodeElement, workingDirectory))
+    {
+      MITK_ERROR << "Could not load properties for node.";
+      error = true;
+    }
+
+    return node;
+  }
+  catch (const std::exception &e)
+  {
+    MITK_ERROR << "Error during attempt to load node. Exception says: " << e.what();
+  }
+  catch (...)
+  {
+    MITK_ERROR << "Unknown error during attempt to load node.";
+  }
+
+  error = true;
+  return DataNode::New();
+}
+
 mitk::DataNode::Pointer mitk::SceneReaderV1::LoadBaseDataFromDataTag(const tinyxml2::XMLElement *dataElement,
                                                                      const PropertyList *properties,
                                                                      const std::string &workingDirectory,
@@ -34,6 +34,14 @@ namespace mitk
                              DataStorage *storage) override;
 
   protected:
+    /**
+      \brief Loads the data and all property lists of one XML \<node\> element
+
+      Does not touch any member, since LoadScene() calls it concurrently for all nodes.
+      Always returns a node, which is empty if the data could not be loaded.
+    */
+    DataNode::Pointer LoadNode(const tinyxml2::XMLElement *nodeElement, const std::string &workingDirectory, bool &error);
+
     /**
       \brief tries to create one DataNode from a given XML \<node\> element
     */
@@ -19,6 +19,73 @@ found in the LICENSE file.
 #include "mitkSceneIO.h"
 #include "mitkSceneIOTestScenarioProvider.h"
 
+#include "mitkBaseDataSerializer.h"
+#include "mitkImageGenerator.h"
+#include "mitkPointSet.h"
+#include "mitkSerializerMacros.h"
+#include "mitkStandaloneDataStorage.h"
+
+#include <itkMultiThreaderBase.h>
+
+#include <Poco/File.h>
+#include <Poco/Path.h>
+#include <Poco/Zip/ZipArchive.h>
+
+#include <algorithm>
+#include <fstream>
+#include <iterator>
+
+namespace mitk
+{
+  /** Data that is only serialized by SceneIOTestFailingDataSerializer.*/
+  class SceneIOTestFailingData : public BaseData
+  {
+  public:
+    mitkClassMacro(SceneIOTestFailingData, BaseData);
+    itkFactorylessNewMacro(Self);
+
+    void SetRequestedRegionToLargestPossibleRegion() override {}
+    bool RequestedRegionIsOutsideOfTheBufferedRegion() override { return false; }
+    bool VerifyRequestedRegion() override { return true; }
+    void SetRequestedRegion(const itk::DataObject *) override {}
+  };
+
+  /** Removes the working directory of SceneIO during serialization, like a cleanup of the
+    temporary directory would do, so that saving the scene fails.*/
+  class SceneIOTestFailingDataSerializer : public BaseDataSerializer
+  {
+  public:
+    mitkClassMacro(SceneIOTestFailingDataSerializer, BaseDataSerializer);
+    itkFactorylessNewMacro(Self);
+    itkCloneMacro(Self);
+
+    std::string Serialize() override
+    {
+      Poco::File(m_WorkingDirectory).remove(true);
+      return "failing_data.xml";
+    }
+  };
+}
+
+MITK_REGISTER_SERIALIZER(SceneIOTestFailingDataSerializer)
+
+namespace
+{
+  std::string ReadFile(const std::string &filename)
+  {
+    std::ifstream file(filename, std::ios::binary);
+    return std::string(std::istreambuf_iterator<char>(file), std::istreambuf_iterator<char>());
+  }
+
+  void AddNode(mitk::DataStorage *storage, mitk::BaseData *data, const std::string &name)
+  {
+    auto node = mitk::DataNode::New();
+    node->SetData(data);
+    node->SetName(name);
+    storage->Add(node);
+  }
+}
+
 /**
   \brief Test cases for SceneIO.
 
@@ -78,6 +145,9 @@ class mitkSceneIOTest2Suite : public mitk::TestFixture
   CPPUNIT_TEST_SUITE(mitkSceneIOTest2Suite);
   MITK_TEST(Test_SceneIOInterfaces);
   MITK_TEST(Test_ReconstructionOfScenes);
+  MITK_TEST(Test_ConcurrentLoadingEqualsSerialLoading);
+  MITK_TEST(Test_CompressedFilesAreStored);
+  MITK_TEST(Test_FailedSaveKeepsExistingFile);
   CPPUNIT_TEST_SUITE_END();
 
   mitk::SceneIOTestScenarioProvider m_TestCaseProvider;
@@ -125,6 +195,129 @@ public:
     }
   }
 
+  void Test_ConcurrentLoadingEqualsSerialLoading()
+  {
+    std::string tempDir = mitk::IOUtil::CreateTemporaryDirectory("SceneIOTest_XXXXXX");
+
+    // SceneReaderV1 loads the nodes with the global default number of ITK threads
+    const auto defaultNumberOfThreads = itk::MultiThreaderBase::GetGlobalDefaultNumberOfThreads();
+    const auto concurrentNumberOfThreads = std::max<itk::ThreadIdType>(4, defaultNumberOfThreads);
+
+    for (const auto& scenario : m_TestCaseProvider.GetAllScenarios())
+    {
+      if (!scenario.serializable)
+        continue;
+
+      MITK_TEST_OUTPUT(<< "\n===== Test_ConcurrentLoadingEqualsSerialLoading, scenario '" << scenario.key << "' =====");
+
+      std::string archiveFilename = mitk::IOUtil::CreateTemporaryFile("scene_XXXXXX.mitk", tempDir);
+      mitk::DataStorage::Pointer originalStorage = scenario.BuildDataStorage();
+      CPPUNIT_ASSERT(mitk::SceneIO::New()->SaveScene(originalStorage->GetAll(), originalStorage, archiveFilename));
+
+      mitk::DataStorage::Pointer serialStorage;
+      mitk::DataStorage::Pointer concurrentStorage;
+
+      try
+      {
+        itk::MultiThreaderBase::SetGlobalDefaultNumberOfThreads(1);
+        serialStorage = mitk::SceneIO::New()->LoadScene(archiveFilename);
+
+        itk::MultiThreaderBase::SetGlobalDefaultNumberOfThreads(concurrentNumberOfThreads);
+        concurrentStorage = mitk::SceneIO::New()->LoadScene(archiveFilename);
+      }
+      catch (...)
+      {
+        itk::MultiThreaderBase::SetGlobalDefaultNumberOfThreads(defaultNumberOfThreads);
+        throw;
+      }
+
+      itk::MultiThreaderBase::SetGlobalDefaultNumberOfThreads(defaultNumberOfThreads);
+
+      CPPUNIT_ASSERT_EQUAL(originalStorage->GetAll()->Size(), serialStorage->GetAll()->Size());
+      CPPUNIT_ASSERT_MESSAGE(
+        std::string("Comparing concurrently with serially loaded scenario '") + scenario.key + "'",
+        mitk::DataStorageCompare(serialStorage,
+                                 concurrentStorage,
+                                 mitk::DataStorageCompare::CMP_Hierarchy | mitk::DataStorageCompare::CMP_Data |
+                                   mitk::DataStorageCompare::CMP_Properties,
+                                 scenario.comparisonPrecision)
+          .CompareVerbose());
+    }
+  }
+
+  void Test_CompressedFilesAreStored()
+  {
+    std::string tempDir = mitk::IOUtil::CreateTemporaryDirectory("SceneIOTest_XXXXXX");
+    std::string archiveFilename = mitk::IOUtil::CreateTemporaryFile("scene_XXXXXX.mitk", tempDir);
+
+    auto pointSet = mitk::PointSet::New();
+    mitk::Point3D point;
+    mitk::FillVector3D(point, 1.0, 2.0, 3.0);
+    pointSet->InsertPoint(0, point);
+
+    mitk::DataStorage::Pointer storage = mitk::StandaloneDataStorage::New();
+    AddNode(storage, mitk::ImageGenerator::GenerateRandomImage<short>(20, 20, 20, 1, 1, 1, 1, 1000, -1000), "image");
+    AddNode(storage, pointSet, "points");
+    CPPUNIT_ASSERT(mitk::SceneIO::New()->SaveScene(storage->GetAll(), storage, archiveFilename));
+
+    // images are written as gzip encoded NRRD files and must not be deflated a second time
+    std::ifstream stream(archiveFilename, std::ios::binary);
+    Poco::Zip::ZipArchive archive(stream);
+    unsigned int numberOfImages = 0;
+    unsigned int numberOfOtherFiles = 0;
+
+    for (auto iter = archive.headerBegin(); iter != archive.headerEnd(); ++iter)
+    {
+      const auto &entry = iter->second;
+
+      if ("nrrd" == Poco::Path(entry.getFileName()).getExtension())
+      {
+        ++numberOfImages;
+        CPPUNIT_ASSERT_MESSAGE(entry.getFileName() + " is stored",
+                               Poco::Zip::ZipCommon::CM_STORE == entry.getCompressionMethod());
+      }
+      else
+      {
+        ++numberOfOtherFiles;
+        CPPUNIT_ASSERT_MESSAGE(entry.getFileName() + " is deflated",
+                               Poco::Zip::ZipCommon::CM_DEFLATE == entry.getCompressionMethod());
+      }
+    }
+
+    CPPUNIT_ASSERT_EQUAL(1u, numberOfImages);
+    CPPUNIT_ASSERT(numberOfOtherFiles >= 2); // point set and index.xml
+
+    stream.close();
+    Poco::File(tempDir).remove(true);
+  }
+
+  void Test_FailedSaveKeepsExistingFile()
+  {
+    std::string tempDir = mitk::IOUtil::CreateTemporaryDirectory("SceneIOTest_XXXXXX");
+    std::string archiveFilename = mitk::IOUtil::CreateTemporaryFile("scene_XXXXXX.mitk", tempDir);
+
+    mitk::DataStorage::Pointer storage = mitk::StandaloneDataStorage::New();
+    AddNode(storage, mitk::PointSet::New(), "points");
+    CPPUNIT_ASSERT(mitk::SceneIO::New()->SaveScene(storage->GetAll(), storage, archiveFilename));
+    const auto originalContent = ReadFile(archiveFilename);
+    CPPUNIT_ASSERT(!originalContent.empty());
+
+    mitk::DataStorage::Pointer failingStorage = mitk::StandaloneDataStorage::New();
+    AddNode(failingStorage, mitk::SceneIOTestFailingData::New(), "failing");
+    CPPUNIT_ASSERT_MESSAGE("Saving the scene fails",
+                           !mitk::SceneIO::New()->SaveScene(failingStorage->GetAll(), failingStorage, archiveFilename));
+
+    CPPUNIT_ASSERT_MESSAGE("Existing scene file is unchanged", originalContent == ReadFile(archiveFilename));
+
+    std::vector<std::string> files;
+    Poco::File(tempDir).list(files);
+    CPPUNIT_ASSERT_EQUAL_MESSAGE("No temporary file is left behind", std::size_t(1), files.size());
+
+    CPPUNIT_ASSERT_NO_THROW(mitk::SceneIO::New()->LoadScene(archiveFilename));
+
+    Poco::File(tempDir).remove(true);
+  }
+
 }; // class
 
 int mitkSceneIOTest2(int /*argc*/, char * /*argv*/ [])
@@ -432,3 +432,74 @@ mitk::DataStorage::Pointer mitk::SceneIOTestScenarioProvider::SpecialProperties(
 
   return storage;
 }
+
+mitk::DataStorage::Pointer mitk::SceneIOTestScenarioProvider::DerivedData() const
+{
+  mitk::DataStorage::Pointer storage = StandaloneDataStorage::New().GetPointer();
+
+  mitk::DataNode::Pointer image;
+  for (unsigned int i = 0; i < 4; ++i)
+  {
+    mitk::DataNode::Pointer node = DataNode::New();
+    node->SetName("Image #" + std::to_string(i));
+    node->SetData(mitk::ImageGenerator::GenerateRandomImage<short>(8 + i, 6, 5, 1 + i % 2, 0.5, 0.5, 1, 1000, -1000));
+    storage->Add(node, image);
+    image = node;
+  }
+
+  mitk::DataNode::Pointer surfaceSources[2] = { storage->GetNamedNode("Image #0"), storage->GetNamedNode("Image #2") };
+  for (unsigned int i = 0; i < 3; ++i)
+  {
+    vtkSmartPointer<vtkPoints> points = vtkSmartPointer<vtkPoints>::New();
+    points->InsertNextPoint(0.0, 0.0, i);
+    points->InsertNextPoint(1.0 + i, 0.0, 0.0);
+    points->InsertNextPoint(0.0, 1.0, 0.5 * i);
+
+    vtkSmartPointer<vtkPolygon> polygon = vtkSmartPointer<vtkPolygon>::New();
+    polygon->GetPointIds()->SetNumberOfIds(3);
+    for (vtkIdType id = 0; id < 3; ++id)
+      polygon->GetPointIds()->SetId(id, id);
+
+    vtkSmartPointer<vtkCellArray> polygonArray = vtkSmartPointer<vtkCellArray>::New();
+    polygonArray->InsertNextCell(polygon);
+
+    vtkSmartPointer<vtkPolyData> polyData = vtkSmartPointer<vtkPolyData>::New();
+    polyData->SetPoints(points);
+    polyData->SetPolys(polygonArray);
+
+    mitk::Surface::Pointer surface = mitk::Surface::New();
+    surface->SetVtkPolyData(polyData);
+
+    mitk::DataNode::Pointer node = DataNode::New();
+    node->SetName("Surface #" + std::to_string(i));
+    node->SetData(surface);
+    node->SetProperty("index", IntProperty::New(i));
+
+    mitk::DataStorage::SetOfObjects::Pointer sources = mitk::DataStorage::SetOfObjects::New();
+    sources->push_back(surfaceSources[0]);
+    sources->push_back(surfaceSources[1]);
+    storage->Add(node, sources);
+  }
+
+  for (unsigned int i = 0; i < 3; ++i)
+  {
+    mitk::PointSet::Pointer pointSet = mitk::PointSet::New();
+    for (unsigned int j = 0; j <= i; ++j)
+    {
+      mitk::PointSet::PointType p;
+      mitk::FillVector3D(p, 1.0 * i, -2.0 * j, 3.0 + i + j);
+      pointSet->SetPoint(j, p);
+    }
+
+    mitk::DataNode::Pointer node = DataNode::New();
+    node->SetName("PointSet #" + std::to_string(i));
+    node->SetData(pointSet);
+
+    mitk::DataStorage::SetOfObjects::Pointer sources = mitk::DataStorage::SetOfObjects::New();
+    sources->push_back(storage->GetNamedNode("Image #" + std::to_string(i + 1)));
+    sources->push_back(storage->GetNamedNode("Surface #" + std::to_string(i)));
+    storage->Add(node, sources);
+  }
+
+  return storage;
+}
@@ -174,6 +174,11 @@ namespace mitk
     */
     DataStorage::Pointer SpecialProperties() const;
 
+    /**
+      Several images, surfaces and point sets, some of them derived from multiple sources.
+    */
+    DataStorage::Pointer DerivedData() const;
+
   public:
 // Helper to simplify writing the registration
 #define AddSaveAndRestoreScenario(name) AddScenario(#name, &mitk::SceneIOTestScenarioProvider::name, true);
@@ -202,6 +207,7 @@ namespace mitk
         AddSaveAndRestoreScenario(GeometryData);
 
       AddSaveAndRestoreScenario(SpecialProperties);
+      AddSaveAndRestoreScenario(DerivedData);
 
       // AddScenario("GeometryData", &mitk::SceneIOTestScenarioProvider::GeometryData, true, std::string(), false,
       // mitk::eps);
@@ -19,6 +19,8 @@ found in the LICENSE file.
 
 #include <itkObjectFactoryBase.h>
 
+#include <iosfwd>
+
 namespace tinyxml2
 {
   class XMLDocument;
@@ -50,12 +52,21 @@ namespace mitk
       */
     virtual std::string Serialize();
 
+    /**
+      \brief Serializes given PropertyList object into the stream instead of a file in the working directory.
+      \return the filename by which the serialized PropertyList is referenced, empty if serialization failed.
+      */
+    virtual std::string Serialize(std::ostream &stream);
+
     PropertyList *GetFailedProperties();
 
   protected:
     PropertyListSerializer();
     ~PropertyListSerializer() override;
 
+    /** Fills the document with the properties and returns the filename for it, empty if there is nothing to serialize.*/
+    std::string CreateDocument(tinyxml2::XMLDocument &document);
+
     tinyxml2::XMLElement *SerializeOneProperty(tinyxml2::XMLDocument &doc, const std::string &key, const BaseProperty *property);
 
     std::string m_FilenameHint;
@@ -16,6 +16,8 @@ found in the LICENSE file.
 #include <itksys/SystemTools.hxx>
 #include <tinyxml2.h>
 
+#include <sstream>
+
 mitk::PropertyListSerializer::PropertyListSerializer() : m_FilenameHint("unnamed"), m_WorkingDirectory("")
 {
 }
@@ -25,6 +27,57 @@ mitk::PropertyListSerializer::~PropertyListSerializer()
 }
 
 std::string mitk::PropertyListSerializer::Serialize()
+{
+  tinyxml2::XMLDocument document;
+  const auto filename = this->CreateDocument(document);
+
+  if (filename.empty())
+    return filename;
+
+  std::string fullname(m_WorkingDirectory);
+  fullname += "/";
+  fullname += filename;
+  fullname = itksys::SystemTools::ConvertToOutputPath(fullname.c_str());
+
+  // Trim quotes
+  std::string::size_type length = fullname.length();
+
+  if (length >= 2 && fullname[0] == '"' && fullname[length - 1] == '"')
+    fullname = fullname.substr(1, length - 2);
+
+  // save XML file
+  if (tinyxml2::XML_SUCCESS != document.SaveFile(fullname.c_str()))
+  {
+    MITK_ERROR << "Could not write PropertyList to " << fullname << "\nTinyXML reports '" << document.ErrorStr()
+               << "'";
+    return "";
+  }
+
+  return filename;
+}
+
+std::string mitk::PropertyListSerializer::Serialize(std::ostream &stream)
+{
+  tinyxml2::XMLDocument document;
+  const auto filename = this->CreateDocument(document);
+
+  if (filename.empty())
+    return filename;
+
+  tinyxml2::XMLPrinter printer;
+  document.Print(&printer);
+  stream.write(printer.CStr(), printer.CStrSize() - 1);
+
+  if (!stream)
+  {
+    MITK_ERROR << "Could not write PropertyList " << filename << " to stream";
+    return "";
+  }
+
+  return filename;
+}
+
+std::string mitk::PropertyListSerializer::CreateDocument(tinyxml2::XMLDocument &document)
 {
   m_FailedProperties = PropertyList::New();
 
@@ -46,18 +99,6 @@ std::string mitk::PropertyListSerializer::Serialize()
   std::string filename;
   filename.append(name.str());
 
-  std::string fullname(m_WorkingDirectory);
-  fullname += "/";
-  fullname += filename;
-  fullname = itksys::SystemTools::ConvertToOutputPath(fullname.c_str());
-
-  // Trim quotes
-  std::string::size_type length = fullname.length();
-
-  if (length >= 2 && fullname[0] == '"' && fullname[length - 1] == '"')
-    fullname = fullname.substr(1, length - 2);
-
-  tinyxml2::XMLDocument document;
   document.InsertEndChild(document.NewDeclaration());
 
   auto *version = document.NewElement("Version");
@@ -84,14 +125,6 @@ std::string mitk::PropertyListSerializer::Serialize()
     }
   }
 
-  // save XML file
-  if (tinyxml2::XML_SUCCESS != document.SaveFile(fullname.c_str()))
-  {
-    MITK_ERROR << "Could not write PropertyList to " << fullname << "\nTinyXML reports '" << document.ErrorStr()
-               << "'";
-    return "";
-  }
-
   return filename;
 }
 
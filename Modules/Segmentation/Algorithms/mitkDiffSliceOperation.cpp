@@ -13,10 +13,11 @@ found in the LICENSE file.
 #include "mitkDiffSliceOperation.h"
 
 #include <mitkImage.h>
+#include <mitkSegTool2D.h>
 
 #include <itkCommand.h>
 
-mitk::DiffSliceOperation::DiffSliceOperation() : Operation(1)
+mitk::DiffSliceOperation::DiffSliceOperation() : Operation(1), m_DeltaContent(SparseSliceDelta::Content::New)
 {
   m_TimeStep = 0;
   m_Image = nullptr;
@@ -31,8 +32,29 @@ mitk::DiffSliceOperation::DiffSliceOperation(Image *imageVolume,
                                              const SlicedGeometry3D *sliceGeometry,
                                              TimeStepType timestep,
                                              const BaseGeometry *currentWorldGeometry)
-  : Operation(1)
+  : Operation(1), m_DeltaContent(SparseSliceDelta::Content::New)
 
+{
+  m_CompressedImageContainer.CompressImage(slice);
+
+  this->InitializeOperation(imageVolume, sliceGeometry, timestep, currentWorldGeometry);
+}
+
+mitk::DiffSliceOperation::DiffSliceOperation(Image *imageVolume,
+                                             std::shared_ptr<const SparseSliceDelta> delta,
+                                             SparseSliceDelta::Content content,
+                                             const SlicedGeometry3D *sliceGeometry,
+                                             TimeStepType timestep,
+                                             const BaseGeometry *currentWorldGeometry)
+  : Operation(1), m_Delta(delta), m_DeltaContent(content)
+{
+  this->InitializeOperation(imageVolume, sliceGeometry, timestep, currentWorldGeometry);
+}
+
+void mitk::DiffSliceOperation::InitializeOperation(Image *imageVolume,
+                                                   const SlicedGeometry3D *sliceGeometry,
+                                                   TimeStepType timestep,
+                                                   const BaseGeometry *currentWorldGeometry)
 {
   m_WorldGeometry = currentWorldGeometry->Clone();
 
@@ -47,8 +69,6 @@ mitk::DiffSliceOperation::DiffSliceOperation(Image *imageVolume,
 
   m_TimeStep = timestep;
 
-  m_CompressedImageContainer.CompressImage(slice);
-
   m_Image = imageVolume;
   m_DeleteObserverTag = 0;
 
@@ -81,7 +101,26 @@ mitk::DiffSliceOperation::~DiffSliceOperation()
 
 mitk::Image::Pointer mitk::DiffSliceOperation::GetSlice()
 {
-  return m_CompressedImageContainer.DecompressImage();
+  if (nullptr == m_Delta)
+    return m_CompressedImageContainer.DecompressImage();
+
+  if (!m_ImageIsValid)
+    return nullptr;
+
+  // the current content of the slice with the changed pixels set to the old or new values
+  auto slice = SegTool2D::GetAffectedImageSliceAs2DImage(dynamic_cast<const PlaneGeometry *>(m_WorldGeometry.GetPointer()), m_Image, m_TimeStep);
+  if (slice.IsNotNull())
+    m_Delta->ApplyTo(slice, m_DeltaContent);
+
+  return slice;
+}
+
+std::size_t mitk::DiffSliceOperation::GetMemorySize() const
+{
+  if (nullptr == m_Delta)
+    return m_CompressedImageContainer.GetMemorySize();
+
+  return SparseSliceDelta::Content::Old == m_DeltaContent ? m_Delta->GetMemorySize() : 0;
 }
 
 bool mitk::DiffSliceOperation::IsValid()
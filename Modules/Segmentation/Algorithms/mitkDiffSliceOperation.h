@@ -14,6 +14,7 @@ found in the LICENSE file.
 #define mitkDiffSliceOperation_h
 
 #include "mitkCompressedImageContainer.h"
+#include "mitkSparseSliceDelta.h"
 #include <MitkSegmentationExports.h>
 #include <mitkOperation.h>
 
@@ -34,6 +35,11 @@ namespace mitk
      currentWorldGeometry   specifies the axis where the slice has to be applied in the volume.
 
     This Operation can be used to realize undo-redo functionality for e.g. segmentation purposes.
+
+    Instead of the complete slice, the operation can also hold a SparseSliceDelta (old and new values of the pixels
+    changed by an edit). The slice to be applied is then the current content of the volume with the changed pixels
+    set to the old (undo) or the new (redo) values, so the undo and the redo operation of an edit share the same
+    delta. Pixels that were not changed by the edit keep their current content.
   */
   class MITKSEGMENTATION_EXPORT DiffSliceOperation : public Operation
   {
@@ -57,6 +63,15 @@ namespace mitk
                        const TimeStepType timestep,
                        const BaseGeometry *currentWorldGeometry);
 
+    /** \brief Creates an operation that writes the old or the new content of the passed delta into the current
+      content of the slice.*/
+    DiffSliceOperation(mitk::Image *imageVolume,
+                       std::shared_ptr<const SparseSliceDelta> delta,
+                       SparseSliceDelta::Content content,
+                       const SlicedGeometry3D *sliceGeometry,
+                       const TimeStepType timestep,
+                       const BaseGeometry *currentWorldGeometry);
+
     /** \brief Check if it is a valid operation.*/
     bool IsValid();
 
@@ -64,9 +79,17 @@ namespace mitk
     mitk::Image *GetImage() { return this->m_Image; }
     const mitk::Image* GetImage() const { return this->m_Image; }
 
-    /** \brief Get the slice that is applied in the operation.*/
+    /** \brief Get the slice that is applied in the operation.
+      In delta mode the slice is reconstructed from the current content of the image volume.*/
     Image::Pointer GetSlice();
 
+    /** \brief Returns the delta of the operation or nullptr, if the operation stores the complete slice.*/
+    const SparseSliceDelta *GetDelta() const { return this->m_Delta.get(); }
+
+    /** \brief Memory of the stored slice or delta. The delta shared by the undo and the redo operation of an edit
+      is only accounted to the operation that writes the old content.*/
+    std::size_t GetMemorySize() const override;
+
     /** \brief Set timeStep*/
     TimeStepType GetTimeStep() const { return this->m_TimeStep; }
     /** \brief Get the axis where the slice has to be applied in the volume.*/
@@ -76,11 +99,21 @@ namespace mitk
   protected:
     ~DiffSliceOperation() override;
 
+    /** \brief Sets the members shared by all constructors.*/
+    void InitializeOperation(mitk::Image *imageVolume,
+                             const SlicedGeometry3D *sliceGeometry,
+                             const TimeStepType timestep,
+                             const BaseGeometry *currentWorldGeometry);
+
     /** \brief Callback for image observer.*/
     void OnImageDeleted();
 
     CompressedImageContainer m_CompressedImageContainer;
 
+    std::shared_ptr<const SparseSliceDelta> m_Delta;
+
+    SparseSliceDelta::Content m_DeltaContent;
+
     mitk::Image *m_Image;
 
     vtkSmartPointer<vtkImageData> m_Slice;
@@ -79,6 +79,7 @@ void mitk::ImageToContourFilter::Itk2DContourExtraction(const itk::Image<TPixel,
   auto binaryFilter = BinaryFilter::New();
 
   binaryFilter->SetInput(sliceImage);
+  binaryFilter->SetNumberOfWorkUnits(this->GetNumberOfWorkUnits());
   binaryFilter->SetFunctor([this](TPixel pixVal) { return fabs(pixVal - m_ContourValue) < mitk::eps ? 1.0 : 0.0; });
 
   // Pad the mask since the contour extractor would not close contours along pixels at the border
@@ -89,6 +90,7 @@ void mitk::ImageToContourFilter::Itk2DContourExtraction(const itk::Image<TPixel,
   auto padFilter = PadFilter::New();
 
   padFilter->SetInput(binaryFilter->GetOutput());
+  padFilter->SetNumberOfWorkUnits(this->GetNumberOfWorkUnits());
   padFilter->SetPadLowerBound(bound);
   padFilter->SetPadUpperBound(bound);
 
@@ -34,7 +34,8 @@ namespace mitk
     This class takes an 2D mitk::Image as input and extracts all contours which are drawn it. The contour
     extraction is done by using the itk::ContourExtractor2DImageFilter.
 
-    The output is a mitk::Surface.
+    The output is a mitk::Surface. The number of work units of the filter is passed on to the ITK filters of the
+    extraction.
 
     $Author: fetzer$
   */
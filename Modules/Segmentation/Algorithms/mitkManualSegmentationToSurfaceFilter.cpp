@@ -11,6 +11,7 @@ found in the LICENSE file.
 ============================================================================*/
 
 #include <array>
+#include <vector>
 
 #include <mitkManualSegmentationToSurfaceFilter.h>
 
@@ -20,6 +21,18 @@ found in the LICENSE file.
 
 #include "mitkProgressBar.h"
 
+namespace
+{
+  void SetSingleThreaded(vtkThreadedImageAlgorithm *filter, bool singleThreaded)
+  {
+    if (singleThreaded)
+    {
+      filter->SetEnableSMP(false);
+      filter->SetNumberOfThreads(1);
+    }
+  }
+}
+
 mitk::ManualSegmentationToSurfaceFilter::ManualSegmentationToSurfaceFilter()
 {
   m_MedianFilter3D = false;
@@ -56,97 +69,27 @@ void mitk::ManualSegmentationToSurfaceFilter::GenerateData()
     ProgressBar::GetInstance()->AddStepsToDo(4);
   }
 
+  // The VTK image data of an mitk::Image is created on demand, hence it is requested
+  // for all time steps before they are processed concurrently.
+  std::vector<int> timeSteps;
+  std::vector<vtkSmartPointer<vtkImageData>> vtkimages;
+
   for (int t = tstart; t < tmax; ++t)
   {
-    vtkSmartPointer<vtkImageData> vtkimage = image->GetVtkImageData(t);
-
-    // If the image has a single slice, pad it with an empty slice to explicitly make it
-    // recognizable as 3-d by VTK. Otherwise, the vtkMarchingCubes filter will
-    // complain about dimensionality and won't produce any output.
-    if (2 == vtkimage->GetDataDimension())
-    {
-      std::array<int, 6> extent;
-      vtkimage->GetExtent(extent.data());
-      extent[5] = 1;
-
-      auto padFilter = vtkSmartPointer<vtkImageConstantPad>::New();
-      padFilter->SetInputData(vtkimage);
-      padFilter->SetOutputWholeExtent(extent.data());
-      padFilter->UpdateInformation();
-      padFilter->Update();
-      vtkimage = padFilter->GetOutput();
-    }
+    timeSteps.push_back(t);
+    vtkimages.push_back(image->GetVtkImageData(t));
+  }
 
-    // Median -->smooth 3D
-    // MITK_INFO << (m_MedianFilter3D ? "Applying median..." : "No median filtering");
-    if (m_MedianFilter3D)
-    {
-      vtkImageMedian3D *median = vtkImageMedian3D::New();
-      median->SetInputData(vtkimage);                                                       // RC++ (VTK < 5.0)
-      median->SetKernelSize(m_MedianKernelSizeX, m_MedianKernelSizeY, m_MedianKernelSizeZ); // Std: 3x3x3
-      median->ReleaseDataFlagOn();
-      median->UpdateInformation();
-      median->Update();
-      vtkimage = median->GetOutput(); //->Out
-      median->Delete();
-    }
-    ProgressBar::GetInstance()->Progress();
+  std::vector<vtkSmartPointer<vtkPolyData>> polyDatas(timeSteps.size());
 
-    // Interpolate image spacing
-    // MITK_INFO << (m_Interpolation ? "Resampling..." : "No resampling");
-    if (m_Interpolation)
-    {
-      vtkImageResample *imageresample = vtkImageResample::New();
-      imageresample->SetInputData(vtkimage);
-
-      // Set Spacing Manual to 1mm in each direction (Original spacing is lost during image processing)
-      imageresample->SetAxisOutputSpacing(0, m_InterpolationX);
-      imageresample->SetAxisOutputSpacing(1, m_InterpolationY);
-      imageresample->SetAxisOutputSpacing(2, m_InterpolationZ);
-      imageresample->UpdateInformation();
-      imageresample->Update();
-      vtkimage = imageresample->GetOutput(); //->Output
-      imageresample->Delete();
-    }
-    ProgressBar::GetInstance()->Progress();
-
-    // MITK_INFO << (m_UseGaussianImageSmooth ? "Applying gaussian smoothing..." : "No gaussian smoothing");
-    if (m_UseGaussianImageSmooth) // gauss
-    {
-      vtkImageShiftScale *scalefilter = vtkImageShiftScale::New();
-      scalefilter->SetScale(100);
-      scalefilter->SetInputData(vtkimage);
-      scalefilter->Update();
-
-      vtkImageGaussianSmooth *gaussian = vtkImageGaussianSmooth::New();
-      gaussian->SetInputConnection(scalefilter->GetOutputPort());
-      gaussian->SetDimensionality(3);
-      gaussian->SetRadiusFactor(0.49);
-      gaussian->SetStandardDeviation(m_GaussianStandardDeviation);
-      gaussian->ReleaseDataFlagOn();
-      gaussian->UpdateInformation();
-      gaussian->Update();
-
-      vtkimage = scalefilter->GetOutput();
-
-      double range[2];
-      vtkimage->GetScalarRange(range);
-
-      if (range[1] != 0) // too little slices, image smoothing eliminates all segmentation pixels
-      {
-        vtkimage = gaussian->GetOutput(); //->Out
-      }
-      else
-      {
-        MITK_INFO << "Smoothing would remove all pixels of the segmentation. Use unsmoothed result instead.";
-      }
-      gaussian->Delete();
-      scalefilter->Delete();
-    }
-    ProgressBar::GetInstance()->Progress();
+  this->ProcessTimeSteps(timeSteps.size(), [&](std::size_t i, bool singleThreaded) {
+    polyDatas[i] =
+      this->CreatePolyData(timeSteps[i], this->PreprocessImage(vtkimages[i], singleThreaded), thresholdExpanded);
+  });
 
-    // Create surface for t-Slice
-    CreateSurface(t, vtkimage, surface, thresholdExpanded);
+  for (std::size_t i = 0; i < timeSteps.size(); ++i)
+  {
+    surface->SetVtkPolyData(polyDatas[i], timeSteps[i]);
     ProgressBar::GetInstance()->Progress();
   }
 
@@ -169,6 +112,103 @@ void mitk::ManualSegmentationToSurfaceFilter::GenerateData()
   }
 };
 
+vtkSmartPointer<vtkImageData> mitk::ManualSegmentationToSurfaceFilter::PreprocessImage(vtkImageData *image,
+                                                                                       bool singleThreaded) const
+{
+  vtkSmartPointer<vtkImageData> vtkimage = image;
+
+  // If the image has a single slice, pad it with an empty slice to explicitly make it
+  // recognizable as 3-d by VTK. Otherwise, the vtkMarchingCubes filter will
+  // complain about dimensionality and won't produce any output.
+  if (2 == vtkimage->GetDataDimension())
+  {
+    std::array<int, 6> extent;
+    vtkimage->GetExtent(extent.data());
+    extent[5] = 1;
+
+    auto padFilter = vtkSmartPointer<vtkImageConstantPad>::New();
+    padFilter->SetInputData(vtkimage);
+    padFilter->SetOutputWholeExtent(extent.data());
+    padFilter->UpdateInformation();
+    padFilter->Update();
+    vtkimage = padFilter->GetOutput();
+  }
+
+  // Median -->smooth 3D
+  // MITK_INFO << (m_MedianFilter3D ? "Applying median..." : "No median filtering");
+  if (m_MedianFilter3D)
+  {
+    vtkImageMedian3D *median = vtkImageMedian3D::New();
+    median->SetInputData(vtkimage);                                                       // RC++ (VTK < 5.0)
+    median->SetKernelSize(m_MedianKernelSizeX, m_MedianKernelSizeY, m_MedianKernelSizeZ); // Std: 3x3x3
+    SetSingleThreaded(median, singleThreaded);
+    median->ReleaseDataFlagOn();
+    median->UpdateInformation();
+    median->Update();
+    vtkimage = median->GetOutput(); //->Out
+    median->Delete();
+  }
+  ProgressBar::GetInstance()->Progress();
+
+  // Interpolate image spacing
+  // MITK_INFO << (m_Interpolation ? "Resampling..." : "No resampling");
+  if (m_Interpolation)
+  {
+    vtkImageResample *imageresample = vtkImageResample::New();
+    imageresample->SetInputData(vtkimage);
+    SetSingleThreaded(imageresample, singleThreaded);
+
+    // Set Spacing Manual to 1mm in each direction (Original spacing is lost during image processing)
+    imageresample->SetAxisOutputSpacing(0, m_InterpolationX);
+    imageresample->SetAxisOutputSpacing(1, m_InterpolationY);
+    imageresample->SetAxisOutputSpacing(2, m_InterpolationZ);
+    imageresample->UpdateInformation();
+    imageresample->Update();
+    vtkimage = imageresample->GetOutput(); //->Output
+    imageresample->Delete();
+  }
+  ProgressBar::GetInstance()->Progress();
+
+  // MITK_INFO << (m_UseGaussianImageSmooth ? "Applying gaussian smoothing..." : "No gaussian smoothing");
+  if (m_UseGaussianImageSmooth) // gauss
+  {
+    vtkImageShiftScale *scalefilter = vtkImageShiftScale::New();
+    scalefilter->SetScale(100);
+    scalefilter->SetInputData(vtkimage);
+    SetSingleThreaded(scalefilter, singleThreaded);
+    scalefilter->Update();
+
+    vtkImageGaussianSmooth *gaussian = vtkImageGaussianSmooth::New();
+    gaussian->SetInputConnection(scalefilter->GetOutputPort());
+    gaussian->SetDimensionality(3);
+    gaussian->SetRadiusFactor(0.49);
+    gaussian->SetStandardDeviation(m_GaussianStandardDeviation);
+    SetSingleThreaded(gaussian, singleThreaded);
+    gaussian->ReleaseDataFlagOn();
+    gaussian->UpdateInformation();
+    gaussian->Update();
+
+    vtkimage = scalefilter->GetOutput();
+
+    double range[2];
+    vtkimage->GetScalarRange(range);
+
+    if (range[1] != 0) // too little slices, image smoothing eliminates all segmentation pixels
+    {
+      vtkimage = gaussian->GetOutput(); //->Out
+    }
+    else
+    {
+      MITK_INFO << "Smoothing would remove all pixels of the segmentation. Use unsmoothed result instead.";
+    }
+    gaussian->Delete();
+    scalefilter->Delete();
+  }
+  ProgressBar::GetInstance()->Progress();
+
+  return vtkimage;
+}
+
 void mitk::ManualSegmentationToSurfaceFilter::SetMedianKernelSize(int x, int y, int z)
 {
   m_MedianKernelSizeX = x;
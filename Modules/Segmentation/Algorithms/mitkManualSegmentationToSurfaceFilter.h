@@ -149,6 +149,13 @@ namespace mitk
     ManualSegmentationToSurfaceFilter();
     ~ManualSegmentationToSurfaceFilter() override;
 
+    /**
+     * Applies the optional median filter, resampling and gaussian smoothing to the image of a
+     * single time step. May be called concurrently for different time steps.
+     * \param singleThreaded runs the VTK image filters in the calling thread
+     */
+    vtkSmartPointer<vtkImageData> PreprocessImage(vtkImageData *image, bool singleThreaded) const;
+
     bool m_MedianFilter3D;
     int m_MedianKernelSizeX, m_MedianKernelSizeY, m_MedianKernelSizeZ;
     bool m_UseGaussianImageSmooth; // Gaussian Filter
@@ -14,9 +14,155 @@ found in the LICENSE file.
 #include "mitkManualSegmentationToSurfaceFilter.h"
 #include "mitkVtkRepresentationProperty.h"
 #include <mitkCoreObjectFactory.h>
+#include <mitkDedicatedThreads.h>
+#include <mitkImageReadAccessor.h>
+#include <mitkImageWriteAccessor.h>
 #include <mitkLabelSetImage.h>
 #include <vtkPolyDataNormals.h>
 
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <cmath>
+#include <exception>
+#include <limits>
+#include <memory>
+#include <thread>
+
+namespace
+{
+  struct LabelBoundingBox
+  {
+    LabelBoundingBox()
+      : Min{{std::numeric_limits<unsigned int>::max(),
+             std::numeric_limits<unsigned int>::max(),
+             std::numeric_limits<unsigned int>::max()}},
+        Max{{0, 0, 0}}
+    {
+    }
+
+    bool IsEmpty() const { return Min[0] > Max[0]; }
+
+    std::array<unsigned int, 3> Min;
+    std::array<unsigned int, 3> Max;
+  };
+
+  /** Returns the spatial size of the first three dimensions and the number of time steps of an image.*/
+  std::array<unsigned int, 4> GetSize(const mitk::Image *image)
+  {
+    std::array<unsigned int, 4> size = {{1, 1, 1, 1}};
+    const auto dimension = std::min(image->GetDimension(), 4u);
+
+    for (unsigned int i = 0; i < dimension; ++i)
+      size[i] = image->GetDimension(i);
+
+    return size;
+  }
+
+  /** Determines the bounding boxes of all labels of a layer, over all time steps, in a single pass.*/
+  std::vector<LabelBoundingBox> ComputeLabelBoundingBoxes(const mitk::LabelSetImage::PixelType *data,
+                                                          const std::array<unsigned int, 4> &size)
+  {
+    std::vector<LabelBoundingBox> boxes(std::numeric_limits<mitk::LabelSetImage::PixelType>::max() + 1);
+
+    for (unsigned int t = 0; t < size[3]; ++t)
+    {
+      for (unsigned int z = 0; z < size[2]; ++z)
+      {
+        for (unsigned int y = 0; y < size[1]; ++y)
+        {
+          for (unsigned int x = 0; x < size[0]; ++x, ++data)
+          {
+            auto &box = boxes[*data];
+
+            box.Min[0] = std::min(box.Min[0], x);
+            box.Min[1] = std::min(box.Min[1], y);
+            box.Min[2] = std::min(box.Min[2], z);
+            box.Max[0] = std::max(box.Max[0], x);
+            box.Max[1] = std::max(box.Max[1], y);
+            box.Max[2] = std::max(box.Max[2], z);
+          }
+        }
+      }
+    }
+
+    return boxes;
+  }
+
+  /** Creates the binary mask of a label restricted to its bounding box extended by a border.
+   *  The geometry of the mask is moved to the position of the cropped region in the layer image.
+   */
+  mitk::Image::Pointer CreateCroppedLabelMask(const mitk::Image *layerImage,
+                                              const mitk::LabelSetImage::PixelType *data,
+                                              mitk::LabelSetImage::PixelType label,
+                                              const LabelBoundingBox &box,
+                                              unsigned int border)
+  {
+    const auto size = GetSize(layerImage);
+    std::array<unsigned int, 3> min;
+    std::array<unsigned int, 3> cropSize;
+
+    for (int i = 0; i < 3; ++i)
+    {
+      min[i] = box.Min[i] > border ? box.Min[i] - border : 0;
+      cropSize[i] = std::min(box.Max[i] + border, size[i] - 1) - min[i] + 1;
+    }
+
+    const auto dimension = layerImage->GetDimension();
+    std::vector<unsigned int> dimensions(layerImage->GetDimensions(), layerImage->GetDimensions() + dimension);
+
+    for (unsigned int i = 0; i < std::min(dimension, 3u); ++i)
+      dimensions[i] = cropSize[i];
+
+    mitk::Point3D index;
+    for (int i = 0; i < 3; ++i)
+      index[i] = min[i];
+
+    auto timeGeometry = layerImage->GetTimeGeometry()->Clone();
+
+    for (mitk::TimeStepType t = 0; t < timeGeometry->CountTimeSteps(); ++t)
+    {
+      auto geometry = timeGeometry->GetGeometryForTimeStep(t);
+
+      mitk::Point3D origin;
+      geometry->IndexToWorld(index, origin);
+
+      auto bounds = geometry->GetBounds();
+      for (int i = 0; i < 3; ++i)
+        bounds[2 * i + 1] = bounds[2 * i] + cropSize[i];
+
+      geometry->SetBounds(bounds);
+      geometry->SetOrigin(origin);
+    }
+
+    timeGeometry->Update();
+
+    // See LabelSetImage::CreateLabelMask() for why the mask is not initialized by a geometry
+    auto mask = mitk::Image::New();
+    mask->Initialize(layerImage->GetPixelType(), dimension, dimensions.data());
+    mask->SetTimeGeometry(timeGeometry);
+
+    mitk::ImageWriteAccessor accessor(mask);
+    auto *maskData = static_cast<mitk::LabelSetImage::PixelType *>(accessor.GetData());
+
+    for (unsigned int t = 0; t < size[3]; ++t)
+    {
+      for (unsigned int z = min[2]; z < min[2] + cropSize[2]; ++z)
+      {
+        for (unsigned int y = min[1]; y < min[1] + cropSize[1]; ++y)
+        {
+          const auto *row = data + ((static_cast<std::size_t>(t) * size[2] + z) * size[1] + y) * size[0] + min[0];
+
+          for (unsigned int x = 0; x < cropSize[0]; ++x, ++maskData)
+            *maskData = label == row[x] ? 1 : 0;
+        }
+      }
+    }
+
+    return mask;
+  }
+}
+
 namespace mitk
 {
   ShowSegmentationAsSurface::ShowSegmentationAsSurface()
@@ -98,10 +244,38 @@ namespace mitk
 
     if (nullptr != labelSetImage)
     {
+      // The filters only see the neighborhood of a label within this border, which covers the
+      // median kernel, the gaussian kernel and the background needed to close the surface.
+      const auto border = 2 + (applyMedian ? medianKernelSize : 0u) +
+                          (smooth ? static_cast<unsigned int>(std::ceil(3.0 * gaussianSD)) : 0u);
+
+      struct LabelTask
+      {
+        const Image *LayerImage;
+        const LabelSetImage::PixelType *LayerData;
+        LabelSetImage::PixelType Value;
+        const Label *SourceLabel;
+        LabelBoundingBox BoundingBox;
+        Surface::Pointer Result;
+        std::exception_ptr Exception;
+      };
+
+      std::vector<std::unique_ptr<ImageReadAccessor>> layerAccessors;
+      std::vector<LabelTask> tasks;
+
       auto numberOfLayers = labelSetImage->GetNumberOfLayers();
 
       for (decltype(numberOfLayers) layerIndex = 0; layerIndex < numberOfLayers; ++layerIndex)
       {
+        // The data of the active layer is only up to date in the label set image itself
+        const Image *layerImage = layerIndex == labelSetImage->GetActiveLayer()
+          ? labelSetImage
+          : labelSetImage->GetLayerImage(layerIndex);
+
+        layerAccessors.emplace_back(new ImageReadAccessor(layerImage));
+        const auto *layerData = static_cast<const LabelSetImage::PixelType *>(layerAccessors.back()->GetData());
+        const auto boundingBoxes = ComputeLabelBoundingBoxes(layerData, GetSize(layerImage));
+
         auto labelSet = labelSetImage->GetLabelSet(layerIndex);
 
         for (auto labelIter = labelSet->IteratorConstBegin(); labelIter != labelSet->IteratorConstEnd(); ++labelIter)
@@ -109,31 +283,77 @@ namespace mitk
           if (0 == labelIter->first)
             continue; // Do not process background label
 
-          auto labelImage = labelSetImage->CreateLabelMask(labelIter->first, false, layerIndex);
-
-          if (labelImage.IsNull())
-            continue;
-
-          auto labelSurface = this->ConvertBinaryImageToSurface(labelImage);
+          tasks.push_back(
+            { layerImage, layerData, labelIter->first, labelIter->second, boundingBoxes[labelIter->first], nullptr, nullptr });
+        }
+      }
 
-          if (labelSurface.IsNull())
-            continue;
+      // Labels are independent of each other and are converted concurrently (see
+      // GetNumberOfDedicatedThreads()). Each surface only depends on its own label, so the
+      // result does not depend on the number of threads. This is the only parallel level:
+      // if several labels are converted at once, each filter runs in its label thread.
+      const auto numberOfThreads = GetNumberOfDedicatedThreads(tasks.size());
+      const auto numberOfFilterThreads = numberOfThreads > 1 ? 1u : 0u;
+      std::atomic<std::size_t> nextTask(0);
 
-          auto* polyData = labelSurface->GetVtkPolyData();
+      auto convertLabels = [&]()
+      {
+        for (auto i = nextTask++; i < tasks.size(); i = nextTask++)
+        {
+          auto &task = tasks[i];
 
-          if (smooth && (polyData->GetNumberOfPoints() < 1 || polyData->GetNumberOfCells() < 1))
+          try
           {
-            MITK_WARN << "Label \"" << labelIter->second->GetName() << "\" didn't produce any smoothed surface data (try again without smoothing).";
-            continue;
+            if (task.BoundingBox.IsEmpty())
+            {
+              task.Result = Surface::New();
+              task.Result->SetVtkPolyData(vtkSmartPointer<vtkPolyData>::New());
+            }
+            else
+            {
+              auto labelImage =
+                CreateCroppedLabelMask(task.LayerImage, task.LayerData, task.Value, task.BoundingBox, border);
+
+              task.Result = this->ConvertBinaryImageToSurface(labelImage, numberOfFilterThreads);
+            }
           }
+          catch (...)
+          {
+            task.Exception = std::current_exception();
+          }
+        }
+      };
 
-          auto node = DataNode::New();
-          node->SetData(labelSurface);
-          node->SetColor(labelIter->second->GetColor());
-          node->SetName(labelIter->second->GetName());
+      std::vector<std::thread> threads;
 
-          m_SurfaceNodes.push_back(node);
+      for (std::size_t i = 0; i < numberOfThreads; ++i)
+        threads.emplace_back(convertLabels);
+
+      for (auto &thread : threads)
+        thread.join();
+
+      for (const auto &task : tasks)
+      {
+        if (task.Exception)
+          std::rethrow_exception(task.Exception);
+
+        if (task.Result.IsNull())
+          continue;
+
+        auto* polyData = task.Result->GetVtkPolyData();
+
+        if (smooth && (polyData->GetNumberOfPoints() < 1 || polyData->GetNumberOfCells() < 1))
+        {
+          MITK_WARN << "Label \"" << task.SourceLabel->GetName() << "\" didn't produce any smoothed surface data (try again without smoothing).";
+          continue;
         }
+
+        auto node = DataNode::New();
+        node->SetData(task.Result);
+        node->SetColor(task.SourceLabel->GetColor());
+        node->SetName(task.SourceLabel->GetName());
+
+        m_SurfaceNodes.push_back(node);
       }
     }
     else
@@ -250,7 +470,8 @@ namespace mitk
     Superclass::ThreadedUpdateSuccessful();
   }
 
-  Surface::Pointer ShowSegmentationAsSurface::ConvertBinaryImageToSurface(Image::Pointer binaryImage)
+  Surface::Pointer ShowSegmentationAsSurface::ConvertBinaryImageToSurface(Image::Pointer binaryImage,
+                                                                          unsigned int numberOfThreads)
   {
     bool smooth = true;
     GetParameter("Smooth", smooth);
@@ -276,6 +497,7 @@ namespace mitk
     filter->SetUseGaussianImageSmooth(smooth);
     filter->SetSmooth(smooth);
     filter->SetMedianFilter3D(applyMedian);
+    filter->SetNumberOfThreads(numberOfThreads);
 
     if (smooth)
     {
@@ -38,7 +38,8 @@ namespace mitk
     void ThreadedUpdateSuccessful() override; // will be called from a thread after calling StartAlgorithm
 
   private:
-    mitk::Surface::Pointer ConvertBinaryImageToSurface(mitk::Image::Pointer binaryImage);
+    /** \param numberOfThreads see ImageToSurfaceFilter::SetNumberOfThreads()*/
+    mitk::Surface::Pointer ConvertBinaryImageToSurface(mitk::Image::Pointer binaryImage, unsigned int numberOfThreads = 0);
 
     UIDGenerator m_UIDGeneratorSurfaces;
 
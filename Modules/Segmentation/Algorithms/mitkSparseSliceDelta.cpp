@@ -0,0 +1,276 @@
+/*============================================================================
+
+The Medical Imaging Interaction Toolkit (MITK)
+
+Copyright (c) German Cancer Research Center (DKFZ)
+All rights reserved.
+
+Use of this source code is governed by a 3-clause BSD license that can be
+found in the LICENSE file.
+
+============================================================================*/
+
+#include "mitkSparseSliceDelta.h"
+
+#include <mitkExceptionMacro.h>
+#include <mitkImage.h>
+#include <mitkImageReadAccessor.h>
+#include <mitkImageWriteAccessor.h>
+
+#include <algorithm>
+#include <cstring>
+#include <limits>
+
+namespace
+{
+  bool IsSlice(const mitk::Image *image)
+  {
+    return nullptr != image && image->IsInitialized() && (image->GetDimension() == 2 || (image->GetDimension() == 3 && image->GetDimension(2) == 1)) &&
+           image->GetTimeSteps() == 1;
+  }
+
+  std::uint64_t ReadElement(const char *src, std::size_t elementSize)
+  {
+    std::uint64_t value = 0;
+    std::memcpy(&value, src, elementSize);
+    return value;
+  }
+}
+
+mitk::SparseSliceDelta::SparseSliceDelta()
+  : m_PixelSize(0), m_ElementSize(0)
+{
+  m_SliceDimensions[0] = m_SliceDimensions[1] = 0;
+  m_RegionIndex[0] = m_RegionIndex[1] = 0;
+  m_RegionSize[0] = m_RegionSize[1] = 0;
+}
+
+std::shared_ptr<const mitk::SparseSliceDelta> mitk::SparseSliceDelta::Compute(const Image *oldSlice, const Image *newSlice)
+{
+  if (!IsSlice(oldSlice) || !IsSlice(newSlice))
+    return nullptr;
+
+  if (oldSlice->GetDimension(0) != newSlice->GetDimension(0) || oldSlice->GetDimension(1) != newSlice->GetDimension(1) ||
+      oldSlice->GetPixelType().GetSize() != newSlice->GetPixelType().GetSize())
+    return nullptr;
+
+  std::shared_ptr<SparseSliceDelta> delta(new SparseSliceDelta);
+  delta->m_SliceDimensions[0] = oldSlice->GetDimension(0);
+  delta->m_SliceDimensions[1] = oldSlice->GetDimension(1);
+  delta->m_PixelSize = oldSlice->GetPixelType().GetSize();
+  delta->m_ElementSize = delta->m_PixelSize <= sizeof(std::uint64_t) ? delta->m_PixelSize : 1;
+
+  ImageReadAccessor oldAccessor(oldSlice);
+  ImageReadAccessor newAccessor(newSlice);
+
+  delta->EncodeBlock(static_cast<const char *>(oldAccessor.GetData()),
+                     static_cast<const char *>(newAccessor.GetData()),
+                     delta->m_SliceDimensions[0] * delta->m_PixelSize,
+                     0,
+                     0,
+                     delta->m_SliceDimensions[0],
+                     delta->m_SliceDimensions[1]);
+
+  return delta;
+}
+
+std::shared_ptr<const mitk::SparseSliceDelta> mitk::SparseSliceDelta::Compute(const void *oldRegion,
+                                                                             const void *newRegion,
+                                                                             const unsigned int sliceDimensions[2],
+                                                                             std::size_t pixelSize,
+                                                                             const unsigned int regionIndex[2],
+                                                                             const unsigned int regionSize[2])
+{
+  if (nullptr == oldRegion || nullptr == newRegion || 0 == pixelSize ||
+      regionIndex[0] + regionSize[0] > sliceDimensions[0] || regionIndex[1] + regionSize[1] > sliceDimensions[1])
+    return nullptr;
+
+  std::shared_ptr<SparseSliceDelta> delta(new SparseSliceDelta);
+  delta->m_SliceDimensions[0] = sliceDimensions[0];
+  delta->m_SliceDimensions[1] = sliceDimensions[1];
+  delta->m_PixelSize = pixelSize;
+  delta->m_ElementSize = delta->m_PixelSize <= sizeof(std::uint64_t) ? delta->m_PixelSize : 1;
+
+  delta->EncodeBlock(static_cast<const char *>(oldRegion),
+                     static_cast<const char *>(newRegion),
+                     regionSize[0] * pixelSize,
+                     regionIndex[0],
+                     regionIndex[1],
+                     regionSize[0],
+                     regionSize[1]);
+
+  return delta;
+}
+
+void mitk::SparseSliceDelta::EncodeBlock(const char *oldData,
+                                         const char *newData,
+                                         std::size_t rowBytes,
+                                         std::size_t blockX,
+                                         std::size_t blockY,
+                                         std::size_t width,
+                                         std::size_t height)
+{
+  const std::size_t blockRowBytes = width * m_PixelSize;
+
+  // bounding box of the changed pixels; unchanged rows are skipped with one memcmp
+  std::size_t minX = width, maxX = 0, minY = height, maxY = 0;
+  for (std::size_t y = 0; y < height; ++y)
+  {
+    const char *oldRow = oldData + y * rowBytes;
+    const char *newRow = newData + y * rowBytes;
+    if (0 == std::memcmp(oldRow, newRow, blockRowBytes))
+      continue;
+
+    minY = std::min(minY, y);
+    maxY = y;
+    for (std::size_t x = 0; x < width; ++x)
+    {
+      if (0 != std::memcmp(oldRow + x * m_PixelSize, newRow + x * m_PixelSize, m_PixelSize))
+      {
+        minX = std::min(minX, x);
+        maxX = std::max(maxX, x);
+      }
+    }
+  }
+
+  if (minY == height)
+    return;
+
+  m_RegionIndex[0] = static_cast<unsigned int>(blockX + minX);
+  m_RegionIndex[1] = static_cast<unsigned int>(blockY + minY);
+  m_RegionSize[0] = static_cast<unsigned int>(maxX - minX + 1);
+  m_RegionSize[1] = static_cast<unsigned int>(maxY - minY + 1);
+
+  // the run-length encoding is abandoned as soon as it needs more memory than the raw old and new region
+  const std::size_t regionRowBytes = m_RegionSize[0] * m_PixelSize;
+  const std::size_t rawBytes = 2 * regionRowBytes * m_RegionSize[1];
+  bool encoded = true;
+  for (std::size_t y = minY; y <= maxY && encoded; ++y)
+  {
+    const char *oldRow = oldData + y * rowBytes + minX * m_PixelSize;
+    const char *newRow = newData + y * rowBytes + minX * m_PixelSize;
+
+    for (std::size_t offset = 0; offset < regionRowBytes; offset += m_ElementSize)
+    {
+      const std::uint64_t oldValue = ReadElement(oldRow + offset, m_ElementSize);
+      const std::uint64_t newValue = ReadElement(newRow + offset, m_ElementSize);
+
+      if (!m_Runs.empty() && m_Runs.back().OldValue == oldValue && m_Runs.back().NewValue == newValue &&
+          m_Runs.back().Count < std::numeric_limits<std::uint32_t>::max())
+      {
+        ++m_Runs.back().Count;
+      }
+      else if ((m_Runs.size() + 1) * sizeof(Run) < rawBytes)
+      {
+        m_Runs.push_back({ 1, oldValue, newValue });
+      }
+      else
+      {
+        encoded = false;
+        break;
+      }
+    }
+  }
+
+  if (encoded)
+  {
+    m_Runs.shrink_to_fit();
+    return;
+  }
+
+  m_Runs = std::vector<Run>();
+  m_OldRegion.resize(rawBytes / 2);
+  m_NewRegion.resize(rawBytes / 2);
+  for (std::size_t y = minY; y <= maxY; ++y)
+  {
+    const std::size_t regionOffset = (y - minY) * regionRowBytes;
+    std::memcpy(m_OldRegion.data() + regionOffset, oldData + y * rowBytes + minX * m_PixelSize, regionRowBytes);
+    std::memcpy(m_NewRegion.data() + regionOffset, newData + y * rowBytes + minX * m_PixelSize, regionRowBytes);
+  }
+}
+
+void mitk::SparseSliceDelta::ApplyTo(Image *slice, Content content) const
+{
+  if (!IsSlice(slice) || slice->GetDimension(0) != m_SliceDimensions[0] || slice->GetDimension(1) != m_SliceDimensions[1] ||
+      slice->GetPixelType().GetSize() != m_PixelSize)
+  {
+    mitkThrow() << "Cannot apply slice delta. Slice does not match the slices the delta was computed from.";
+  }
+
+  if (this->IsEmpty())
+    return;
+
+  ImageWriteAccessor accessor(slice);
+  auto *data = static_cast<char *>(accessor.GetData());
+
+  const std::size_t rowBytes = m_SliceDimensions[0] * m_PixelSize;
+  const std::size_t regionRowBytes = m_RegionSize[0] * m_PixelSize;
+
+  if (!this->IsRunLengthEncoded())
+  {
+    const std::vector<char> &values = Content::Old == content ? m_OldRegion : m_NewRegion;
+    for (std::size_t y = 0; y < m_RegionSize[1]; ++y)
+    {
+      char *row = data + (m_RegionIndex[1] + y) * rowBytes + m_RegionIndex[0] * m_PixelSize;
+      const std::size_t regionOffset = y * regionRowBytes;
+
+      for (std::size_t offset = 0; offset < regionRowBytes; offset += m_ElementSize)
+      {
+        // pixels of the bounding box that were not changed by the edit keep their current value
+        if (0 != std::memcmp(m_OldRegion.data() + regionOffset + offset, m_NewRegion.data() + regionOffset + offset, m_ElementSize))
+          std::memcpy(row + offset, values.data() + regionOffset + offset, m_ElementSize);
+      }
+    }
+    return;
+  }
+
+  auto run = m_Runs.cbegin();
+  std::uint32_t remaining = run->Count;
+
+  for (std::size_t y = m_RegionIndex[1]; y < m_RegionIndex[1] + m_RegionSize[1]; ++y)
+  {
+    char *row = data + y * rowBytes + m_RegionIndex[0] * m_PixelSize;
+
+    for (std::size_t offset = 0; offset < regionRowBytes; offset += m_ElementSize)
+    {
+      if (0 == remaining)
+      {
+        ++run;
+        remaining = run->Count;
+      }
+      --remaining;
+
+      // pixels of the bounding box that were not changed by the edit keep their current value
+      if (run->OldValue != run->NewValue)
+      {
+        const std::uint64_t &value = Content::Old == content ? run->OldValue : run->NewValue;
+        std::memcpy(row + offset, &value, m_ElementSize);
+      }
+    }
+  }
+}
+
+bool mitk::SparseSliceDelta::IsEmpty() const
+{
+  return m_Runs.empty() && m_OldRegion.empty();
+}
+
+bool mitk::SparseSliceDelta::IsRunLengthEncoded() const
+{
+  return m_OldRegion.empty();
+}
+
+unsigned int mitk::SparseSliceDelta::GetRegionIndex(unsigned int axis) const
+{
+  return axis < 2 ? m_RegionIndex[axis] : 0;
+}
+
+unsigned int mitk::SparseSliceDelta::GetRegionSize(unsigned int axis) const
+{
+  return axis < 2 ? m_RegionSize[axis] : 0;
+}
+
+std::size_t mitk::SparseSliceDelta::GetMemorySize() const
+{
+  return sizeof(SparseSliceDelta) + m_Runs.capacity() * sizeof(Run) + m_OldRegion.capacity() + m_NewRegion.capacity();
+}
@@ -0,0 +1,122 @@
+/*============================================================================
+
+The Medical Imaging Interaction Toolkit (MITK)
+
+Copyright (c) German Cancer Research Center (DKFZ)
+All rights reserved.
+
+Use of this source code is governed by a 3-clause BSD license that can be
+found in the LICENSE file.
+
+============================================================================*/
+
+#ifndef mitkSparseSliceDelta_h
+#define mitkSparseSliceDelta_h
+
+#include <MitkSegmentationExports.h>
+
+#include <cstdint>
+#include <memory>
+#include <vector>
+
+namespace mitk
+{
+  class Image;
+
+  /** \brief Compact difference between two versions of a 2D slice.
+
+    The delta stores the old and the new values of the slice, restricted to the bounding box of the changed
+    pixels and run-length encoded pixel by pixel. Applying the delta writes either the old or the new values
+    of the changed pixels into a slice; all other pixels are left untouched. The result therefore does not
+    depend on the content the changed pixels have at the time the delta is applied, and one delta serves as
+    undo and redo information of a slice edit (see DiffSliceOperation).
+
+    For typical segmentation edits (a stroke changes a small region from one label value to another) the
+    value pairs inside the region are mostly constant, so the run-length encoding stores only a few runs.
+    If the encoding would not be smaller than the old and new content of the region (e.g. for noisy
+    pixel values), the raw content of the region is stored instead.
+  */
+  class MITKSEGMENTATION_EXPORT SparseSliceDelta
+  {
+  public:
+    /** Selects the slice version that is written by ApplyTo().*/
+    enum class Content
+    {
+      Old,
+      New
+    };
+
+    /** Computes the delta between the two passed slices.
+      Both slices must be 2D images (or 3D images with one slice) of the same size and pixel type,
+      otherwise nullptr is returned.*/
+    static std::shared_ptr<const SparseSliceDelta> Compute(const Image *oldSlice, const Image *newSlice);
+
+    /** Computes the delta of a slice that was only changed inside the passed region, e.g. by a brush stroke.
+      The buffers contain the old and the new content of the region row by row. Only the region is compared,
+      so the caller must ensure that the slice is unchanged outside of it. Returns nullptr if the region does
+      not fit into the slice.*/
+    static std::shared_ptr<const SparseSliceDelta> Compute(const void *oldRegion,
+                                                           const void *newRegion,
+                                                           const unsigned int sliceDimensions[2],
+                                                           std::size_t pixelSize,
+                                                           const unsigned int regionIndex[2],
+                                                           const unsigned int regionSize[2]);
+
+    /** Writes the old or the new values of the changed pixels in place into the passed slice. Throws if the
+      slice does not match the size and pixel size of the slices the delta was computed from.*/
+    void ApplyTo(Image *slice, Content content) const;
+
+    /** True if both slices were identical.*/
+    bool IsEmpty() const;
+
+    /** False if the raw content of the region is stored because the run-length encoding would not be smaller.*/
+    bool IsRunLengthEncoded() const;
+
+    /** Bounding box of the changed pixels (index and size in pixels). Size is 0 for an empty delta.*/
+    unsigned int GetRegionIndex(unsigned int axis) const;
+    unsigned int GetRegionSize(unsigned int axis) const;
+
+    /** Memory (in bytes) occupied by the delta.*/
+    std::size_t GetMemorySize() const;
+
+  private:
+    SparseSliceDelta();
+
+    /** Determines the bounding box of the changed pixels of a block of the slice and encodes it.
+      rowBytes is the distance between two rows in the passed buffers, blockX/blockY the position of the
+      block in the slice.*/
+    void EncodeBlock(const char *oldData,
+                     const char *newData,
+                     std::size_t rowBytes,
+                     std::size_t blockX,
+                     std::size_t blockY,
+                     std::size_t width,
+                     std::size_t height);
+
+    struct Run
+    {
+      std::uint32_t Count;
+      std::uint64_t OldValue;
+      std::uint64_t NewValue;
+    };
+
+    /** Dimensions of the slices the delta belongs to.*/
+    unsigned int m_SliceDimensions[2];
+    /** Size of one pixel in bytes.*/
+    std::size_t m_PixelSize;
+    /** Size of the elements that are run-length encoded; the pixel size, if it is at most 8 bytes, otherwise 1.*/
+    std::size_t m_ElementSize;
+
+    unsigned int m_RegionIndex[2];
+    unsigned int m_RegionSize[2];
+
+    /** Runs of the old and new values of the region elements (row by row).*/
+    std::vector<Run> m_Runs;
+
+    /** Old and new content of the region (row by row) if it is not run-length encoded.*/
+    std::vector<char> m_OldRegion;
+    std::vector<char> m_NewRegion;
+  };
+}
+
+#endif
@@ -14,15 +14,19 @@ found in the LICENSE file.
 
 #include "mitkImageCast.h"
 #include "mitkImageReadAccessor.h"
-#include "mitkImageTimeSelector.h"
 #include <mitkExtractSliceFilter.h>
 #include <mitkImageAccessByItk.h>
+#include <mitkPixelTypeMultiplex.h>
 //#include <mitkPlaneGeometry.h>
 
 #include <itkCommand.h>
 #include <itkImage.h>
 #include <itkImageSliceConstIteratorWithIndex.h>
+#include <itkMultiThreaderBase.h>
 
+#include <algorithm>
+#include <functional>
+#include <memory>
 #include <thread>
 
 namespace
@@ -37,11 +41,21 @@ namespace
       object->RemoveObserver(observerTag);
     }
   }
+
+  // Maximum number of labels whose counts are kept
+  constexpr std::size_t MaxNumberOfStoredLabelCounts = 32;
+  // Maximum number of labels whose masks are kept; masks are as large as the segmentation
+  constexpr std::size_t MaxNumberOfStoredLabelMasks = 2;
+
+  unsigned long LabelMaskUseCount = 0;
 }
 
 mitk::SegmentationInterpolationController::InterpolatorMapType
   mitk::SegmentationInterpolationController::s_InterpolatorForImage; // static member initialization
 
+mitk::SegmentationInterpolationController::LabelMaskCacheType
+  mitk::SegmentationInterpolationController::s_LabelMaskCache; // static member initialization
+
 mitk::SegmentationInterpolationController *mitk::SegmentationInterpolationController::InterpolatorForImage(
   const Image *image)
 {
@@ -107,6 +121,84 @@ void mitk::SegmentationInterpolationController::BlockModified(bool block)
 }
 
 void mitk::SegmentationInterpolationController::SetSegmentationVolume(const Image *segmentation)
+{
+  this->InitializeSegmentationVolume(segmentation, nullptr);
+}
+
+void mitk::SegmentationInterpolationController::SetSegmentationVolume(LabelSetImage *labelSetImage,
+                                                                      Label::PixelType labelValue)
+{
+  if (nullptr == labelSetImage || !labelSetImage->IsInitialized())
+  {
+    this->InitializeSegmentationVolume(nullptr, nullptr);
+    return;
+  }
+
+  // Modification times are unique, so a new label set image at the address of a deleted one never matches.
+  const auto key = std::make_tuple(labelSetImage, labelSetImage->GetActiveLayer(), labelValue);
+  const auto modifiedTime = labelSetImage->GetMTime();
+  const auto writeCount = labelSetImage->GetWriteCount();
+
+  auto iter = s_LabelMaskCache.find(key);
+  if (iter != s_LabelMaskCache.end() && iter->second.ModifiedTime == modifiedTime && iter->second.WriteCount == writeCount)
+  {
+    auto &entry = iter->second;
+    if (entry.Mask.IsNull())
+      entry.Mask = labelSetImage->CreateLabelMask(labelValue, true, 0);
+
+    entry.LastUse = ++LabelMaskUseCount;
+    this->InitializeSegmentationVolume(entry.Mask, &entry.Counts);
+  }
+  else
+  {
+    auto mask = labelSetImage->CreateLabelMask(labelValue, true, 0);
+    this->InitializeSegmentationVolume(mask, nullptr);
+
+    if (m_Segmentation.IsNull())
+    {
+      if (iter != s_LabelMaskCache.end())
+        s_LabelMaskCache.erase(iter);
+      return;
+    }
+
+    if (iter == s_LabelMaskCache.end() && MaxNumberOfStoredLabelCounts <= s_LabelMaskCache.size())
+    {
+      // drop the least recently used label
+      s_LabelMaskCache.erase(std::min_element(s_LabelMaskCache.begin(),
+                                              s_LabelMaskCache.end(),
+                                              [](const auto &lhs, const auto &rhs)
+                                              { return lhs.second.LastUse < rhs.second.LastUse; }));
+    }
+
+    s_LabelMaskCache[key] = { modifiedTime, writeCount, ++LabelMaskUseCount, mask, m_SegmentationCountInSlice };
+  }
+
+  // release the masks of all but the most recently used labels, their counts stay valid
+  std::vector<LabelMaskCacheEntry *> entriesWithMask;
+  for (auto &cacheEntry : s_LabelMaskCache)
+  {
+    if (cacheEntry.second.Mask.IsNotNull())
+      entriesWithMask.push_back(&cacheEntry.second);
+  }
+
+  if (entriesWithMask.size() > MaxNumberOfStoredLabelMasks)
+  {
+    std::sort(entriesWithMask.begin(),
+              entriesWithMask.end(),
+              [](const auto *lhs, const auto *rhs) { return lhs->LastUse > rhs->LastUse; });
+
+    for (auto entry = entriesWithMask.begin() + MaxNumberOfStoredLabelMasks; entry != entriesWithMask.end(); ++entry)
+      (*entry)->Mask = nullptr;
+  }
+}
+
+const mitk::Image *mitk::SegmentationInterpolationController::GetSegmentation() const
+{
+  return m_Segmentation;
+}
+
+void mitk::SegmentationInterpolationController::InitializeSegmentationVolume(const Image *segmentation,
+                                                                             const TimeResolvedDirtyVectorType *counts)
 {
   // clear old information (remove all time steps
   m_SegmentationCountInSlice.clear();
@@ -157,16 +249,22 @@ void mitk::SegmentationInterpolationController::SetSegmentationVolume(const Imag
 
   s_InterpolatorForImage.insert(std::make_pair(m_Segmentation, this));
 
-  // for all timesteps
-  // scan whole image
-  for (unsigned int timeStep = 0; timeStep < m_Segmentation->GetTimeSteps(); ++timeStep)
+  // use the passed counts if they fit the image, otherwise scan the whole image (all time steps)
+  bool countsFit = nullptr != counts && counts->size() == m_SegmentationCountInSlice.size();
+  for (std::size_t timeStep = 0; countsFit && timeStep < counts->size(); ++timeStep)
   {
-    ImageTimeSelector::Pointer timeSelector = ImageTimeSelector::New();
-    timeSelector->SetInput(m_Segmentation);
-    timeSelector->SetTimeNr(timeStep);
-    timeSelector->UpdateLargestPossibleRegion();
-    Image::Pointer segmentation3D = timeSelector->GetOutput();
-    AccessFixedDimensionByItk_2(segmentation3D, ScanWholeVolume, 3, m_Segmentation, timeStep);
+    for (unsigned int dim = 0; countsFit && dim < 3; ++dim)
+      countsFit = (*counts)[timeStep].size() == 3 && (*counts)[timeStep][dim].size() == m_Segmentation->GetDimension(dim);
+  }
+
+  if (countsFit)
+  {
+    m_SegmentationCountInSlice = *counts;
+  }
+  else
+  {
+    const auto pixelType = m_Segmentation->GetPixelType();
+    mitkPixelTypeMultiplex0(ScanWholeVolume, pixelType);
   }
 
   // PrintStatus();
@@ -373,24 +471,80 @@ void mitk::SegmentationInterpolationController::ScanChangedVolume(const itk::Ima
 }
 
 template <typename DATATYPE>
-void mitk::SegmentationInterpolationController::ScanWholeVolume(const itk::Image<DATATYPE, 3> *,
-                                                                const Image *volume,
-                                                                unsigned int timeStep)
+void mitk::SegmentationInterpolationController::ScanWholeVolume(const PixelType &)
 {
-  if (!volume)
-    return;
-  if (timeStep >= m_SegmentationCountInSlice.size())
+  const unsigned int timeSteps = m_SegmentationCountInSlice.size();
+  const unsigned int dimX = m_Segmentation->GetDimension(0);
+  const unsigned int dimY = m_Segmentation->GetDimension(1);
+  const unsigned int dimZ = m_Segmentation->GetDimension(2);
+
+  if (0 == timeSteps || 0 == dimX || 0 == dimY || 0 == dimZ)
     return;
 
-  ImageReadAccessor readAccess(volume, volume->GetVolumeData(timeStep));
+  // The volumes are read in place. Blocks of slices of all time steps are scanned in parallel. Each block
+  // counts its own slices and sums up its rows and columns separately; these sums are added up afterwards.
+  const unsigned int numberOfThreads = std::max(1u, std::thread::hardware_concurrency());
+  const unsigned int blocksPerTimeStep = std::min(dimZ, std::max(1u, (numberOfThreads + timeSteps - 1) / timeSteps));
+  const unsigned int numberOfBlocks = timeSteps * blocksPerTimeStep;
+
+  std::vector<std::unique_ptr<ImageReadAccessor>> readAccessors;
+  for (unsigned int timeStep = 0; timeStep < timeSteps; ++timeStep)
+    readAccessors.push_back(std::make_unique<ImageReadAccessor>(m_Segmentation, m_Segmentation->GetVolumeData(timeStep)));
+
+  std::vector<DirtyVectorType> countsX(numberOfBlocks, DirtyVectorType(dimX, 0));
+  std::vector<DirtyVectorType> countsY(numberOfBlocks, DirtyVectorType(dimY, 0));
 
-  for (unsigned int slice = 0; slice < volume->GetDimension(2); ++slice)
+  auto scanBlock = [&](itk::SizeValueType block)
   {
-    const auto *rawVolume =
-      static_cast<const DATATYPE *>(readAccess.GetData()); // we again promise not to change anything, we'll just count
-    const DATATYPE *rawSlice = rawVolume + (volume->GetDimension(0) * volume->GetDimension(1) * slice);
+    const unsigned int timeStep = block / blocksPerTimeStep;
+    const unsigned int firstSlice = (block % blocksPerTimeStep) * dimZ / blocksPerTimeStep;
+    const unsigned int endSlice = (block % blocksPerTimeStep + 1) * dimZ / blocksPerTimeStep;
 
-    ScanChangedSlice<DATATYPE>(nullptr, SetChangedSliceOptions(2, slice, 0, 1, timeStep, rawSlice));
+    // we again promise not to change anything, we'll just count
+    const auto *rawVolume = static_cast<const DATATYPE *>(readAccessors[timeStep]->GetData());
+    auto &countX = countsX[block];
+    auto &countY = countsY[block];
+    auto &countZ = m_SegmentationCountInSlice[timeStep][2];
+
+    for (unsigned int z = firstSlice; z < endSlice; ++z)
+    {
+      const DATATYPE *rawSlice = rawVolume + static_cast<std::size_t>(dimX) * dimY * z;
+      unsigned int numberOfPixels = 0;
+
+      for (unsigned int y = 0; y < dimY; ++y)
+      {
+        const DATATYPE *row = rawSlice + static_cast<std::size_t>(dimX) * y;
+        unsigned int numberOfPixelsInRow = 0;
+
+        for (unsigned int x = 0; x < dimX; ++x)
+        {
+          countX[x] = static_cast<unsigned int>(countX[x] + row[x]);
+          numberOfPixelsInRow = static_cast<unsigned int>(numberOfPixelsInRow + row[x]);
+        }
+
+        countY[y] += numberOfPixelsInRow;
+        numberOfPixels += numberOfPixelsInRow;
+      }
+
+      countZ[z] = numberOfPixels;
+    }
+  };
+
+  if (1 == numberOfBlocks)
+  {
+    scanBlock(0);
+  }
+  else
+  {
+    auto threader = itk::MultiThreaderBase::New();
+    threader->ParallelizeArray(0, numberOfBlocks, scanBlock, nullptr);
+  }
+
+  for (unsigned int block = 0; block < numberOfBlocks; ++block)
+  {
+    auto &timeStepCounts = m_SegmentationCountInSlice[block / blocksPerTimeStep];
+    std::transform(countsX[block].begin(), countsX[block].end(), timeStepCounts[0].begin(), timeStepCounts[0].begin(), std::plus<unsigned int>());
+    std::transform(countsY[block].begin(), countsY[block].end(), timeStepCounts[1].begin(), timeStepCounts[1].begin(), std::plus<unsigned int>());
   }
 }
 
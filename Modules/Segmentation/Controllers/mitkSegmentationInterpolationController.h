@@ -15,6 +15,7 @@ found in the LICENSE file.
 
 #include "mitkCommon.h"
 #include "mitkImage.h"
+#include "mitkLabelSetImage.h"
 #include <MitkSegmentationExports.h>
 #include <mitkShapeBasedInterpolationAlgorithm.h>
 
@@ -23,6 +24,7 @@ found in the LICENSE file.
 
 #include <map>
 #include <mutex>
+#include <tuple>
 #include <utility>
 #include <vector>
 
@@ -60,6 +62,11 @@ namespace mitk
     each dimension).
     Each item describes one image dimension, each vector item holds the count of pixels in "its" slice.
 
+    The initial scan reads the image in place and processes blocks of slices of all time steps in parallel.
+    To interpolate a label, pass the label set image and the label value to SetSegmentationVolume(). The mask of
+    the label and its counts are then cached and reused when the same label is selected again, as long as the
+    label set image was neither modified nor written in the meantime.
+
     $Author$
   */
   class MITKSEGMENTATION_EXPORT SegmentationInterpolationController : public itk::Object
@@ -99,6 +106,24 @@ namespace mitk
     */
     void SetSegmentationVolume(const Image *segmentation);
 
+    /**
+      \brief Initialize with the mask of a label.
+
+      Same as SetSegmentationVolume(const Image*) with the mask of the label (see LabelSetImage::CreateLabelMask()).
+      The counts of the last labels and the masks of the most recently used labels are cached. If the label set
+      image was neither modified nor written (see Image::GetWriteCount()) since the label of the active layer was
+      selected the last time, the mask is neither created nor scanned again.
+
+      \param labelSetImage Label set image the mask is created from.
+      \param labelValue Value of the label in the active layer of the label set image.
+    */
+    void SetSegmentationVolume(LabelSetImage *labelSetImage, Label::PixelType labelValue);
+
+    /**
+      \brief The segmentation that is interpolated; the label mask if initialized with a label.
+    */
+    const Image *GetSegmentation() const;
+
     /**
       \brief Set a reference image (original patient image) - optional.
 
@@ -194,6 +219,23 @@ namespace mitk
     typedef std::vector<std::vector<DirtyVectorType>> TimeResolvedDirtyVectorType;
     typedef std::map<const Image *, SegmentationInterpolationController *> InterpolatorMapType;
 
+    /** Label set image, layer and label value of a mask.*/
+    typedef std::tuple<const LabelSetImage *, unsigned int, Label::PixelType> LabelMaskKeyType;
+
+    /** Cached mask of a label and its counts.*/
+    struct LabelMaskCacheEntry
+    {
+      /** Modification time and write count of the label set image when the mask was created.*/
+      itk::ModifiedTimeType ModifiedTime;
+      itk::SizeValueType WriteCount;
+      /** Order of the last use of the entry; larger values are more recent.*/
+      unsigned long LastUse;
+      /** nullptr if the mask was released to save memory; it is then recreated from the label set image.*/
+      Image::Pointer Mask;
+      TimeResolvedDirtyVectorType Counts;
+    };
+    typedef std::map<LabelMaskKeyType, LabelMaskCacheEntry> LabelMaskCacheType;
+
     SegmentationInterpolationController(); // purposely hidden
     ~SegmentationInterpolationController() override;
 
@@ -204,8 +246,12 @@ namespace mitk
     template <typename TPixel, unsigned int VImageDimension>
     void ScanChangedVolume(const itk::Image<TPixel, VImageDimension> *, unsigned int timeStep);
 
+    /// internal scan of all time steps of m_Segmentation
     template <typename DATATYPE>
-    void ScanWholeVolume(const itk::Image<DATATYPE, 3> *, const Image *volume, unsigned int timeStep);
+    void ScanWholeVolume(const PixelType &);
+
+    /// shared implementation of both SetSegmentationVolume() variants, scans the image if counts is nullptr
+    void InitializeSegmentationVolume(const Image *segmentation, const TimeResolvedDirtyVectorType *counts);
 
     void PrintStatus();
 
@@ -227,6 +273,9 @@ namespace mitk
 
     static InterpolatorMapType s_InterpolatorForImage;
 
+    /// masks and counts of labels, see SetSegmentationVolume(LabelSetImage*, Label::PixelType)
+    static LabelMaskCacheType s_LabelMaskCache;
+
     Image::ConstPointer m_Segmentation;
     std::pair<unsigned long, bool> m_SegmentationModifiedObserverTag; // first: actual tag, second: tag assigned / valid?
     Image::ConstPointer m_ReferenceImage;
@@ -25,6 +25,8 @@ mitk::BinaryThresholdBaseTool::BinaryThresholdBaseTool()
     m_LowerThreshold(1),
     m_UpperThreshold(1)
 {
+  // ITKThresholding() only depends on the thresholds and the label value determined in UpdatePrepare()
+  this->SetConcurrentDynamicPreviews(true);
 }
 
 mitk::BinaryThresholdBaseTool::~BinaryThresholdBaseTool()
@@ -45,6 +47,8 @@ void mitk::BinaryThresholdBaseTool::SetThresholdValues(double lower, double uppe
     return;
   }
 
+  this->CancelPreviewComputation();
+
   m_LowerThreshold = lower;
   m_UpperThreshold = upper;
 
@@ -89,10 +93,18 @@ void mitk::BinaryThresholdBaseTool::InitiateToolByInput()
     }
 
     IntervalBordersChanged.Send(m_SensibleMinimumThreshold, m_SensibleMaximumThreshold, isFloatImage);
-    ThresholdingValuesChanged.Send(m_LowerThreshold, m_UpperThreshold);
+    ThresholdingValuesChanged.Send(m_LowerThreshold.load(), m_UpperThreshold.load());
   }
 }
 
+void mitk::BinaryThresholdBaseTool::UpdatePrepare()
+{
+  Superclass::UpdatePrepare();
+
+  m_ThresholdLabelValue = this->GetActiveLabelValueOfPreview();
+  this->SetSelectedLabels({ m_ThresholdLabelValue.load() });
+}
+
 void mitk::BinaryThresholdBaseTool::DoUpdatePreview(const Image* inputAtTimeStep, const Image* /*oldSegAtTimeStep*/, LabelSetImage* previewImage, TimeStepType timeStep)
 {
   if (nullptr != inputAtTimeStep && nullptr != previewImage)
@@ -110,14 +122,11 @@ void mitk::BinaryThresholdBaseTool::ITKThresholding(const itk::Image<TPixel, VIm
   typedef itk::Image<Tool::DefaultSegmentationDataType, VImageDimension> SegmentationType;
   typedef itk::BinaryThresholdImageFilter<ImageType, SegmentationType> ThresholdFilterType;
 
-  const auto activeValue = this->GetActiveLabelValueOfPreview();
-  this->SetSelectedLabels({activeValue});
-
   typename ThresholdFilterType::Pointer filter = ThresholdFilterType::New();
   filter->SetInput(inputImage);
-  filter->SetLowerThreshold(m_LowerThreshold);
-  filter->SetUpperThreshold(m_UpperThreshold);
-  filter->SetInsideValue(activeValue);
+  filter->SetLowerThreshold(m_LowerThreshold.load());
+  filter->SetUpperThreshold(m_UpperThreshold.load());
+  filter->SetInsideValue(m_ThresholdLabelValue.load());
   filter->SetOutsideValue(0);
   filter->Update();
 
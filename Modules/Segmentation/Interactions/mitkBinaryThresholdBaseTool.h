@@ -23,6 +23,8 @@ found in the LICENSE file.
 #include <itkBinaryThresholdImageFilter.h>
 #include <itkImage.h>
 
+#include <atomic>
+
 namespace mitk
 {
   /**
@@ -54,6 +56,7 @@ namespace mitk
     itkGetMacro(SensibleMaximumThreshold, ScalarType);
 
     void InitiateToolByInput() override;
+    void UpdatePrepare() override;
     void DoUpdatePreview(const Image* inputAtTimeStep, const Image* oldSegAtTimeStep, LabelSetImage* previewImage, TimeStepType timeStep) override;
 
     template <typename TPixel, unsigned int VImageDimension>
@@ -64,8 +67,12 @@ namespace mitk
   private:
     ScalarType m_SensibleMinimumThreshold;
     ScalarType m_SensibleMaximumThreshold;
-    ScalarType m_LowerThreshold;
-    ScalarType m_UpperThreshold;
+    /** Atomic, as a canceled preview computation may still read them (see CancelPreviewComputation()).*/
+    std::atomic<ScalarType> m_LowerThreshold;
+    std::atomic<ScalarType> m_UpperThreshold;
+
+    /** Label value used for the thresholded pixels, determined once per preview update.*/
+    std::atomic<LabelSetImage::LabelValueType> m_ThresholdLabelValue{0};
 
     /** Indicates if the tool should behave like a single threshold tool (true)
       or like a upper/lower threshold tool (false)*/
@@ -20,6 +20,10 @@ found in the LICENSE file.
 #include "mitkLevelWindowProperty.h"
 #include "mitkImageWriteAccessor.h"
 
+#include <algorithm>
+#include <cmath>
+#include <limits>
+
 int mitk::PaintbrushTool::m_Size = 1;
 
 mitk::PaintbrushTool::PaintbrushTool(bool startWithFillMode)
@@ -384,6 +388,7 @@ void mitk::PaintbrushTool::MouseMoved(mitk::InteractionEvent *interactionEvent,
   if (leftMouseButtonPressed)
   {
     ContourModelUtils::FillContourInSlice2(contour, m_PaintingSlice, m_InternalFillValue);
+    this->AddToDirtyRegion(contour);
 
     const double dist = indexCoordinates.EuclideanDistanceTo(m_LastPosition);
     const double radius = static_cast<double>(m_Size) / 2.0;
@@ -436,6 +441,7 @@ void mitk::PaintbrushTool::MouseMoved(mitk::InteractionEvent *interactionEvent,
       gapContour->AddVertex(vertex);
 
       ContourModelUtils::FillContourInSlice2(gapContour, m_PaintingSlice, m_InternalFillValue);
+      this->AddToDirtyRegion(gapContour);
     }
   }
   else
@@ -493,7 +499,7 @@ void mitk::PaintbrushTool::OnMouseReleased(StateMachineAction *, InteractionEven
 
   TransferLabelContentAtTimeStep(m_PaintingSlice, m_WorkingSlice, fillLabelSet, 0, LabelSetImage::UnlabeledValue, LabelSetImage::UnlabeledValue, false, { {m_InternalFillValue, activePixelValue} }, mitk::MultiLabelSegmentation::MergeStyle::Merge);
 
-  this->WriteBackSegmentationResult(positionEvent, m_WorkingSlice->Clone());
+  this->WriteBackSegmentationResult(positionEvent, m_WorkingSlice->Clone(), m_DirtyRegion);
 
   // deactivate visibility of helper node
   m_PaintingNode->SetVisibility(false);
@@ -574,6 +580,7 @@ void mitk::PaintbrushTool::ResetWorkingSlice(const InteractionPositionEvent* eve
   m_WorkingSlice = nullptr;
   m_PaintingSlice = nullptr;
   m_PaintingNode->SetData(nullptr);
+  m_DirtyRegion = itk::ImageRegion<2>();
 
   DataNode* workingNode = this->GetToolManager()->GetWorkingData(0);
   if (nullptr == workingNode)
@@ -603,6 +610,49 @@ void mitk::PaintbrushTool::ResetWorkingSlice(const InteractionPositionEvent* eve
   m_PaintingNode->SetData(m_PaintingSlice);
 }
 
+void mitk::PaintbrushTool::AddToDirtyRegion(const ContourModel* contour)
+{
+  if (contour->IsEmpty())
+  {
+    return;
+  }
+
+  double lower[2] = { std::numeric_limits<double>::max(), std::numeric_limits<double>::max() };
+  double upper[2] = { std::numeric_limits<double>::lowest(), std::numeric_limits<double>::lowest() };
+
+  for (auto it = contour->Begin(); it != contour->End(); ++it)
+  {
+    for (unsigned int d = 0; d < 2; ++d)
+    {
+      lower[d] = std::min(lower[d], (*it)->Coordinates[d]);
+      upper[d] = std::max(upper[d], (*it)->Coordinates[d]);
+    }
+  }
+
+  // one pixel margin, so that every pixel touched by the filled contour is surely covered
+  itk::Index<2> index;
+  itk::Size<2> size;
+  for (unsigned int d = 0; d < 2; ++d)
+  {
+    index[d] = static_cast<itk::IndexValueType>(std::floor(lower[d])) - 1;
+    const auto last = static_cast<itk::IndexValueType>(std::ceil(upper[d])) + 1;
+
+    if (0 != m_DirtyRegion.GetNumberOfPixels())
+    {
+      const auto dirtyLast = m_DirtyRegion.GetUpperIndex()[d];
+      index[d] = std::min(index[d], m_DirtyRegion.GetIndex(d));
+      size[d] = static_cast<itk::SizeValueType>(std::max(last, dirtyLast) - index[d] + 1);
+    }
+    else
+    {
+      size[d] = static_cast<itk::SizeValueType>(last - index[d] + 1);
+    }
+  }
+
+  m_DirtyRegion.SetIndex(index);
+  m_DirtyRegion.SetSize(size);
+}
+
 void mitk::PaintbrushTool::OnToolManagerWorkingDataModified()
 {
   // Here we simply set the current working slice to null. The next time the mouse is moved
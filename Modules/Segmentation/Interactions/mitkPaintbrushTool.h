@@ -83,6 +83,9 @@ namespace mitk
 
     void ResetWorkingSlice(const InteractionPositionEvent* event);
 
+    /** Extends m_DirtyRegion by the bounding box of the passed contour (index coordinates of the working slice).*/
+    void AddToDirtyRegion(const ContourModel* contour);
+
     void OnToolManagerWorkingDataModified();
 
     bool m_FillMode;
@@ -100,6 +103,10 @@ namespace mitk
     DataNode::Pointer m_PaintingNode;
     mitk::Point3D m_LastPosition;
 
+    /** Region of the working slice that was painted on since the slice was reset. Only this region is
+    written back into the working image.*/
+    itk::ImageRegion<2> m_DirtyRegion;
+
   };
 
 } // namespace
@@ -18,7 +18,6 @@ found in the LICENSE file.
 #include "mitkPlaneGeometry.h"
 
 // Include of the new ImageExtractor
-#include "mitkMorphologicalOperations.h"
 #include "mitkPlanarCircle.h"
 
 #include "usGetModuleContext.h"
@@ -42,14 +41,57 @@ found in the LICENSE file.
 #include "mitkLabelSetImage.h"
 
 #include "mitkContourModelUtils.h"
+#include "mitkImageReadAccessor.h"
+#include "mitkImageWriteAccessor.h"
 
 // #include <itkImageRegionIterator.h>
+#include <mitkImageAccessByItk.h>
+
+#include <itkBinaryBallStructuringElement.h>
+#include <itkBinaryErodeImageFilter.h>
+#include <itkImageRegionConstIterator.h>
+#include <itkMultiThreaderBase.h>
 
 #include <vtkAbstractArray.h>
 #include <vtkFieldData.h>
 
+#include <algorithm>
+#include <cmath>
+#include <cstdlib>
+#include <cstring>
+#include <exception>
+
 #define ROUND(a) ((a) > 0 ? (int)((a) + 0.5) : -(int)(0.5 - (a)))
 
+namespace
+{
+  /** Checks if pixels of value 1 remain after eroding the slice with a ball of the passed radius. The erosion
+   * runs with a single work unit, as it is called by the work units of UpdateSurfaceInterpolation().*/
+  template <typename TPixel, unsigned int VDimension>
+  void ItkHasPixelsAfterErosion(const itk::Image<TPixel, VDimension>* slice, int radius, bool& hasPixels)
+  {
+    typedef itk::Image<TPixel, VDimension> ImageType;
+    typedef itk::BinaryBallStructuringElement<TPixel, VDimension> BallType;
+    typedef itk::BinaryErodeImageFilter<ImageType, ImageType, BallType> ErodeFilterType;
+
+    BallType ball;
+    ball.SetRadius(radius);
+    ball.CreateStructuringElement();
+
+    auto erodeFilter = ErodeFilterType::New();
+    erodeFilter->SetKernel(ball);
+    erodeFilter->SetInput(slice);
+    erodeFilter->SetErodeValue(1);
+    erodeFilter->SetNumberOfWorkUnits(1);
+    erodeFilter->UpdateLargestPossibleRegion();
+
+    hasPixels = false;
+    itk::ImageRegionConstIterator<ImageType> it(erodeFilter->GetOutput(), erodeFilter->GetOutput()->GetLargestPossibleRegion());
+    for (it.GoToBegin(); !it.IsAtEnd() && !hasPixels; ++it)
+      hasPixels = 1 == it.Get();
+  }
+}
+
 bool mitk::SegTool2D::m_SurfaceInterpolationEnabled = true;
 
 mitk::SegTool2D::SliceInformation::SliceInformation(const mitk::Image* aSlice, const mitk::PlaneGeometry* aPlane, mitk::TimeStepType aTimestep) :
@@ -152,12 +194,23 @@ void mitk::SegTool2D::UpdateSurfaceInterpolation(const Image *slice,
   Self::UpdateSurfaceInterpolation(slices, workingImage, detectIntersection, 0, 0);
 }
 
-void  mitk::SegTool2D::RemoveContourFromInterpolator(const SliceInformation& sliceInfo)
+void mitk::SegTool2D::RemoveContoursFromInterpolator(const std::vector<SliceInformation>& sliceInfos)
 {
-  mitk::SurfaceInterpolationController::ContourPositionInformation contourInfo;
-  contourInfo.ContourNormal = sliceInfo.plane->GetNormal();
-  contourInfo.ContourPoint = sliceInfo.plane->GetOrigin();
-  mitk::SurfaceInterpolationController::GetInstance()->RemoveContour(contourInfo);
+  if (sliceInfos.empty())
+    return;
+
+  mitk::SurfaceInterpolationController::ContourPositionInformationList contourInfos;
+  contourInfos.reserve(sliceInfos.size());
+
+  for (const auto& sliceInfo : sliceInfos)
+  {
+    mitk::SurfaceInterpolationController::ContourPositionInformation contourInfo;
+    contourInfo.ContourNormal = sliceInfo.plane->GetNormal();
+    contourInfo.ContourPoint = sliceInfo.plane->GetOrigin();
+    contourInfos.push_back(contourInfo);
+  }
+
+  mitk::SurfaceInterpolationController::GetInstance()->RemoveContours(contourInfos);
 }
 
 void mitk::SegTool2D::UpdateSurfaceInterpolation(const std::vector<SliceInformation>& sliceInfos,
@@ -166,7 +219,7 @@ void mitk::SegTool2D::UpdateSurfaceInterpolation(const std::vector<SliceInformat
   unsigned int activeLayerID,
   mitk::Label::PixelType activeLabelValue)
 {
-  if (!m_SurfaceInterpolationEnabled)
+  if (!m_SurfaceInterpolationEnabled || sliceInfos.empty())
     return;
 
   //Remark: the ImageTimeSelector is just needed to extract a timestep/channel of
@@ -182,66 +235,85 @@ void mitk::SegTool2D::UpdateSurfaceInterpolation(const std::vector<SliceInformat
   if (dimRefImg != 3)
     return;
 
-  std::vector<mitk::Surface::Pointer> contourList;
-  contourList.reserve(sliceInfos.size());
-
-  ImageToContourFilter::Pointer contourExtractor = ImageToContourFilter::New();
+  // The contours of all slices are extracted concurrently. Every slice gets its own filters, so the
+  // extraction only reads the slice. The filters run with a single work unit, the slices are the only
+  // level of parallelism. Empty entries mark slices without a (relevant) contour.
+  std::vector<mitk::Surface::Pointer> extractedContours(sliceInfos.size());
+  std::vector<std::exception_ptr> extractionErrors(sliceInfos.size());
 
-  std::vector<SliceInformation> relevantSlices = sliceInfos;
-
-  if (detectIntersection)
+  auto extractContour = [&](itk::SizeValueType i)
   {
-    relevantSlices.clear();
+    const auto& sliceInfo = sliceInfos[i];
 
-    for (const auto& sliceInfo : sliceInfos)
+    try
     {
-      // Test whether there is something to extract or whether the slice just contains intersections of others
-      mitk::Image::Pointer slice2 = sliceInfo.slice->Clone();
-      mitk::MorphologicalOperations::Erode(slice2, 2, mitk::MorphologicalOperations::Ball);
+      if (detectIntersection)
+      {
+        // Test whether there is something to extract or whether the slice just contains intersections of others
+        bool hasPixels = false;
+        AccessFixedDimensionByItk_n(sliceInfo.slice, ItkHasPixelsAfterErosion, 2, (2, hasPixels));
+
+        if (!hasPixels)
+          return;
+      }
 
-      contourExtractor->SetInput(slice2);
+      auto contourExtractor = ImageToContourFilter::New();
+      contourExtractor->SetInput(sliceInfo.slice);
+      contourExtractor->SetContourValue(activeLabelValue);
+      contourExtractor->SetNumberOfWorkUnits(1);
       contourExtractor->Update();
       mitk::Surface::Pointer contour = contourExtractor->GetOutput();
 
-      if (contour->GetVtkPolyData()->GetNumberOfPoints() == 0)
+      if (contour->GetVtkPolyData()->GetNumberOfPoints() > 0)
       {
-        Self::RemoveContourFromInterpolator(sliceInfo);
-      }
-      else
-      {
-        relevantSlices.push_back(sliceInfo);
+        vtkSmartPointer<vtkIntArray> intArray = vtkSmartPointer<vtkIntArray>::New();
+        intArray->InsertNextValue(activeLabelValue);
+        intArray->InsertNextValue(activeLayerID);
+        contour->GetVtkPolyData()->GetFieldData()->AddArray(intArray);
+        contour->DisconnectPipeline();
+        extractedContours[i] = contour;
       }
     }
-  }
+    catch (...)
+    {
+      extractionErrors[i] = std::current_exception();
+    }
+  };
 
-  if (relevantSlices.empty())
-    return;
+  auto threader = itk::MultiThreaderBase::New();
+  threader->ParallelizeArray(0, sliceInfos.size(), extractContour, nullptr);
 
+  std::vector<mitk::Surface::Pointer> contourList;
   std::vector<const mitk::PlaneGeometry*> contourPlanes;
-  for (const auto& sliceInfo : relevantSlices)
-  {
-    contourExtractor->SetInput(sliceInfo.slice);
-    contourExtractor->SetContourValue(activeLabelValue);
-    contourExtractor->Update();
-    mitk::Surface::Pointer contour = contourExtractor->GetOutput();
+  std::vector<SliceInformation> slicesWithoutContour;
+  std::exception_ptr firstError;
 
-    if (contour->GetVtkPolyData()->GetNumberOfPoints() == 0)
+  for (std::size_t i = 0; i < sliceInfos.size(); ++i)
+  {
+    if (nullptr != extractionErrors[i])
+    { // the interpolation keeps the contour the slice had before
+      if (nullptr == firstError)
+        firstError = extractionErrors[i];
+    }
+    else if (extractedContours[i].IsNull())
     {
-      Self::RemoveContourFromInterpolator(sliceInfo);
+      slicesWithoutContour.push_back(sliceInfos[i]);
     }
     else
     {
-      vtkSmartPointer<vtkIntArray> intArray = vtkSmartPointer<vtkIntArray>::New();
-      intArray->InsertNextValue(activeLabelValue);
-      intArray->InsertNextValue(activeLayerID);
-      contour->GetVtkPolyData()->GetFieldData()->AddArray(intArray);
-      contour->DisconnectPipeline();
-      contourList.push_back(contour);
-      contourPlanes.push_back(sliceInfo.plane);
+      contourList.push_back(extractedContours[i]);
+      contourPlanes.push_back(sliceInfos[i].plane);
     }
   }
 
-  mitk::SurfaceInterpolationController::GetInstance()->AddNewContours(contourList, contourPlanes);
+  // all changes are handed over at once, so the interpolation is only reinitialized once
+  Self::RemoveContoursFromInterpolator(slicesWithoutContour);
+
+  if (!contourList.empty())
+    mitk::SurfaceInterpolationController::GetInstance()->AddNewContours(contourList, contourPlanes);
+
+  if (nullptr != firstError)
+    std::rethrow_exception(firstError);
 }
 
 
@@ -449,7 +521,7 @@ mitk::Image* mitk::SegTool2D::GetReferenceData() const
 }
 
 
-void mitk::SegTool2D::WriteBackSegmentationResult(const InteractionPositionEvent *positionEvent, const Image * segmentationResult)
+void mitk::SegTool2D::WriteBackSegmentationResult(const InteractionPositionEvent *positionEvent, const Image * segmentationResult, const itk::ImageRegion<2>& dirtyRegion)
 {
   if (!positionEvent)
     return;
@@ -463,7 +535,7 @@ void mitk::SegTool2D::WriteBackSegmentationResult(const InteractionPositionEvent
     const auto workingNode = this->GetWorkingDataNode();
     auto *image = dynamic_cast<Image *>(workingNode->GetData());
     const auto timeStep = positionEvent->GetSender()->GetTimeStep(image);
-    this->WriteBackSegmentationResult(planeGeometry, segmentationResult, timeStep);
+    this->WriteBackSegmentationResult(planeGeometry, segmentationResult, timeStep, dirtyRegion);
   }
 }
 
@@ -478,7 +550,8 @@ void mitk::SegTool2D::WriteBackSegmentationResult(const DataNode* workingNode, c
 
 void mitk::SegTool2D::WriteBackSegmentationResult(const PlaneGeometry *planeGeometry,
                                                   const Image * segmentationResult,
-                                                  TimeStepType timeStep)
+                                                  TimeStepType timeStep,
+                                                  const itk::ImageRegion<2>& dirtyRegion)
 {
   if (!planeGeometry || !segmentationResult)
     return;
@@ -490,6 +563,7 @@ void mitk::SegTool2D::WriteBackSegmentationResult(const PlaneGeometry *planeGeom
   unsigned int currentSlicePosition = m_LastEventSender->GetSliceNavigationController()->GetSlice()->GetPos();
   SliceInformation sliceInfo(segmentationResult, const_cast<mitk::PlaneGeometry *>(planeGeometry), timeStep);
   sliceInfo.slicePosition = currentSlicePosition;
+  sliceInfo.dirtyRegion = dirtyRegion;
   WriteBackSegmentationResults({ sliceInfo }, true);
 }
 
@@ -558,21 +632,31 @@ void mitk::SegTool2D::WriteBackSegmentationResults(const DataNode* workingNode,
     mitkThrow() << "Cannot write slice to working node. Working node does not contain an image.";
   }
 
+  std::vector<SliceInformation> changedSlices;
+  changedSlices.reserve(sliceList.size());
+
   for (const auto& sliceInfo : sliceList)
   {
     if (writeSliceToVolume && nullptr != sliceInfo.plane && sliceInfo.slice.IsNotNull())
     {
-      SegTool2D::WriteSliceToVolume(image, sliceInfo, true);
+      if (!SegTool2D::WriteSliceToVolume(image, sliceInfo, true))
+      {
+        // nothing was changed, so the contour of the slice known by the interpolation is still valid
+        continue;
+      }
     }
-  }
 
-  SegTool2D::UpdateSurfaceInterpolation(sliceList, image, false, activeLayerID, activeLabelValue);
+    changedSlices.push_back(sliceInfo);
+  }
 
   // also mark its node as modified (T27308). Can be removed if T27307
   // is properly solved
   if (workingNode != nullptr) workingNode->Modified();
 
   mitk::RenderingManager::GetInstance()->RequestUpdateAll();
+
+  // last, as it rethrows errors of the contour extraction after the written slices are shown
+  SegTool2D::UpdateSurfaceInterpolation(changedSlices, image, false, activeLayerID, activeLabelValue);
 }
 
 void mitk::SegTool2D::WriteSliceToVolume(Image* workingImage, const PlaneGeometry* planeGeometry, const Image* slice, TimeStepType timeStep, bool allowUndo)
@@ -582,26 +666,26 @@ void mitk::SegTool2D::WriteSliceToVolume(Image* workingImage, const PlaneGeometr
   WriteSliceToVolume(workingImage, sliceInfo, allowUndo);
 }
 
-void mitk::SegTool2D::WriteSliceToVolume(Image* workingImage, const SliceInformation &sliceInfo, bool allowUndo)
+bool mitk::SegTool2D::WriteSliceToVolume(Image* workingImage, const SliceInformation &sliceInfo, bool allowUndo)
 {
   if (nullptr == workingImage)
   {
     mitkThrow() << "Cannot write slice to working node. Working node does not contain an image.";
   }
 
-  DiffSliceOperation* undoOperation = nullptr;
+  bool changed = true;
+  if (Self::WriteSliceRegionToVolume(workingImage, sliceInfo, allowUndo, changed))
+  {
+    return changed;
+  }
+
+  mitk::Image::Pointer originalSlice;
 
   if (allowUndo)
   {
     /*============= BEGIN undo/redo feature block ========================*/
-    // Create undo operation by caching the not yet modified slices
-    mitk::Image::Pointer originalSlice = GetAffectedImageSliceAs2DImage(sliceInfo.plane, workingImage, sliceInfo.timestep);
-    undoOperation =
-      new DiffSliceOperation(workingImage,
-        originalSlice,
-        dynamic_cast<SlicedGeometry3D*>(originalSlice->GetGeometry()),
-        sliceInfo.timestep,
-        sliceInfo.plane);
+    // Cache the not yet modified slice to compute the undo information afterwards
+    originalSlice = GetAffectedImageSliceAs2DImage(sliceInfo.plane, workingImage, sliceInfo.timestep);
     /*============= END undo/redo feature block ========================*/
   }
 
@@ -638,13 +722,43 @@ void mitk::SegTool2D::WriteSliceToVolume(Image* workingImage, const SliceInforma
   if (allowUndo)
   {
     /*============= BEGIN undo/redo feature block ========================*/
-    // specify the redo operation with the edited slice
-    auto* doOperation =
-      new DiffSliceOperation(workingImage,
+    // Undo and redo share one delta of the slice content before and after writing.
+    // The written content is extracted again, so that it is exactly what an extraction
+    // of the slice will return when the operations are applied.
+    mitk::Image::Pointer writtenSlice = GetAffectedImageSliceAs2DImage(sliceInfo.plane, workingImage, sliceInfo.timestep);
+    auto delta = SparseSliceDelta::Compute(originalSlice, writtenSlice);
+
+    DiffSliceOperation* undoOperation = nullptr;
+    DiffSliceOperation* doOperation = nullptr;
+
+    if (nullptr != delta)
+    {
+      undoOperation = new DiffSliceOperation(workingImage,
+        delta,
+        SparseSliceDelta::Content::Old,
+        dynamic_cast<SlicedGeometry3D*>(originalSlice->GetGeometry()),
+        sliceInfo.timestep,
+        sliceInfo.plane);
+      doOperation = new DiffSliceOperation(workingImage,
+        delta,
+        SparseSliceDelta::Content::New,
+        dynamic_cast<SlicedGeometry3D*>(sliceInfo.slice->GetGeometry()),
+        sliceInfo.timestep,
+        sliceInfo.plane);
+    }
+    else
+    { // fall back to storing the complete slices
+      undoOperation = new DiffSliceOperation(workingImage,
+        originalSlice,
+        dynamic_cast<SlicedGeometry3D*>(originalSlice->GetGeometry()),
+        sliceInfo.timestep,
+        sliceInfo.plane);
+      doOperation = new DiffSliceOperation(workingImage,
         extractor->GetOutput(),
         dynamic_cast<SlicedGeometry3D*>(sliceInfo.slice->GetGeometry()),
         sliceInfo.timestep,
         sliceInfo.plane);
+    }
 
     // create an operation event for the undo stack
     OperationEvent* undoStackItem =
@@ -656,6 +770,233 @@ void mitk::SegTool2D::WriteSliceToVolume(Image* workingImage, const SliceInforma
     UndoController::GetCurrentUndoModel()->SetOperationEvent(undoStackItem);
     /*============= END undo/redo feature block ========================*/
   }
+
+  return true;
+}
+
+bool mitk::SegTool2D::WriteSliceRegionToVolume(Image* workingImage, const SliceInformation& sliceInfo, bool allowUndo, bool& changed)
+{
+  const Image* slice = sliceInfo.slice;
+
+  if (0 == sliceInfo.dirtyRegion.GetNumberOfPixels() || nullptr == slice || workingImage->GetDimension() < 3 ||
+      sliceInfo.timestep >= workingImage->GetTimeSteps() ||
+      slice->GetPixelType() != workingImage->GetPixelType())
+  {
+    return false;
+  }
+
+  const unsigned int sliceDimensions[2] = { slice->GetDimension(0), slice->GetDimension(1) };
+
+  itk::ImageRegion<2> sliceRegion;
+  sliceRegion.SetSize(0, sliceDimensions[0]);
+  sliceRegion.SetSize(1, sliceDimensions[1]);
+
+  auto region = sliceInfo.dirtyRegion;
+  if (!region.Crop(sliceRegion))
+  { // the dirty region does not cover any pixel of the slice
+    changed = false;
+    return true;
+  }
+
+  // Map the slice pixels onto voxels: the centers of the slice pixels (0,0), (1,0) and (0,1) must hit voxel centers
+  // and the slice axes must run along two different voxel axes. Otherwise the slice is resliced (see WriteSliceToVolume).
+  const auto sliceGeometry = slice->GetGeometry();
+  const auto volumeGeometry = workingImage->GetGeometry(sliceInfo.timestep);
+
+  auto computeVolumeIndex = [sliceGeometry, volumeGeometry](ScalarType x, ScalarType y)
+  {
+    Point3D sliceIndex;
+    sliceIndex[0] = x;
+    sliceIndex[1] = y;
+    sliceIndex[2] = 0;
+
+    Point3D world;
+    sliceGeometry->IndexToWorld(sliceIndex, world);
+
+    Point3D volumeIndex;
+    volumeGeometry->WorldToIndex(world, volumeIndex);
+    return volumeIndex;
+  };
+
+  const auto originIndex = computeVolumeIndex(0, 0);
+  const auto xIndex = computeVolumeIndex(1, 0);
+  const auto yIndex = computeVolumeIndex(0, 1);
+
+  constexpr ScalarType indexTolerance = 1e-3;
+  long origin[3];
+  long xStep[3];
+  long yStep[3];
+  long xStepLength = 0;
+  long yStepLength = 0;
+  long stepsProduct = 0;
+
+  for (unsigned int d = 0; d < 3; ++d)
+  {
+    origin[d] = std::lround(originIndex[d]);
+    xStep[d] = std::lround(xIndex[d] - originIndex[d]);
+    yStep[d] = std::lround(yIndex[d] - originIndex[d]);
+
+    if (std::abs(originIndex[d] - origin[d]) > indexTolerance ||
+        std::abs(xIndex[d] - originIndex[d] - xStep[d]) > indexTolerance ||
+        std::abs(yIndex[d] - originIndex[d] - yStep[d]) > indexTolerance)
+    {
+      return false;
+    }
+
+    xStepLength += std::abs(xStep[d]);
+    yStepLength += std::abs(yStep[d]);
+    stepsProduct += std::abs(xStep[d] * yStep[d]);
+  }
+
+  if (1 != xStepLength || 1 != yStepLength || 0 != stepsProduct)
+  {
+    return false;
+  }
+
+  const long volumeDimensions[3] = { static_cast<long>(workingImage->GetDimension(0)),
+                                     static_cast<long>(workingImage->GetDimension(1)),
+                                     static_cast<long>(workingImage->GetDimension(2)) };
+  const long strides[3] = { 1, volumeDimensions[0], volumeDimensions[0] * volumeDimensions[1] };
+
+  const long regionBegin[2] = { region.GetIndex(0), region.GetIndex(1) };
+  const long regionEnd[2] = { regionBegin[0] + static_cast<long>(region.GetSize(0)) - 1,
+                              regionBegin[1] + static_cast<long>(region.GetSize(1)) - 1 };
+
+  // the mapping is linear, so the region is inside the volume if its corners are
+  for (const auto x : { regionBegin[0], regionEnd[0] })
+  {
+    for (const auto y : { regionBegin[1], regionEnd[1] })
+    {
+      for (unsigned int d = 0; d < 3; ++d)
+      {
+        const auto index = origin[d] + x * xStep[d] + y * yStep[d];
+        if (index < 0 || index >= volumeDimensions[d])
+        {
+          return false;
+        }
+      }
+    }
+  }
+
+  long originOffset = 0;
+  long xOffset = 0;
+  long yOffset = 0;
+  for (unsigned int d = 0; d < 3; ++d)
+  {
+    originOffset += origin[d] * strides[d];
+    xOffset += xStep[d] * strides[d];
+    yOffset += yStep[d] * strides[d];
+  }
+
+  const std::size_t pixelSize = workingImage->GetPixelType().GetSize();
+  const std::size_t regionRowBytes = region.GetSize(0) * pixelSize;
+
+  // content of the region before and after writing, needed for the undo/redo delta
+  std::vector<char> oldContent;
+  std::vector<char> newContent;
+  if (allowUndo)
+  {
+    oldContent.resize(region.GetNumberOfPixels() * pixelSize);
+    newContent.resize(region.GetNumberOfPixels() * pixelSize);
+  }
+
+  changed = false;
+
+  {
+    ImageReadAccessor sliceAccessor(slice);
+    ImageWriteAccessor volumeAccessor(workingImage, workingImage->GetVolumeData(sliceInfo.timestep));
+    const auto sliceData = static_cast<const char*>(sliceAccessor.GetData());
+    const auto volumeData = static_cast<char*>(volumeAccessor.GetData());
+
+    for (long y = regionBegin[1]; y <= regionEnd[1]; ++y)
+    {
+      const auto row = static_cast<std::size_t>(y - regionBegin[1]);
+      const char* sliceRow = sliceData + (y * sliceDimensions[0] + regionBegin[0]) * pixelSize;
+      char* voxel = volumeData + (originOffset + regionBegin[0] * xOffset + y * yOffset) * static_cast<long>(pixelSize);
+
+      if (allowUndo)
+      {
+        std::memcpy(newContent.data() + row * regionRowBytes, sliceRow, regionRowBytes);
+      }
+
+      if (1 == xOffset)
+      { // the row is contiguous in the volume (e.g. axial slices)
+        if (0 != std::memcmp(voxel, sliceRow, regionRowBytes))
+        {
+          if (allowUndo)
+          {
+            std::memcpy(oldContent.data() + row * regionRowBytes, voxel, regionRowBytes);
+          }
+          std::memcpy(voxel, sliceRow, regionRowBytes);
+          changed = true;
+        }
+        else if (allowUndo)
+        {
+          std::memcpy(oldContent.data() + row * regionRowBytes, sliceRow, regionRowBytes);
+        }
+      }
+      else
+      {
+        for (std::size_t x = 0; x < region.GetSize(0); ++x, voxel += xOffset * static_cast<long>(pixelSize))
+        {
+          const char* slicePixel = sliceRow + x * pixelSize;
+
+          if (allowUndo)
+          {
+            std::memcpy(oldContent.data() + row * regionRowBytes + x * pixelSize, voxel, pixelSize);
+          }
+
+          if (0 != std::memcmp(voxel, slicePixel, pixelSize))
+          {
+            std::memcpy(voxel, slicePixel, pixelSize);
+            changed = true;
+          }
+        }
+      }
+    }
+  }
+
+  if (!changed)
+  {
+    return true;
+  }
+
+  // the image was modified directly, but not marked so
+  workingImage->Modified();
+  workingImage->GetVtkImageData(sliceInfo.timestep)->Modified();
+
+  if (allowUndo)
+  {
+    /*============= BEGIN undo/redo feature block ========================*/
+    const unsigned int regionIndex[2] = { static_cast<unsigned int>(regionBegin[0]), static_cast<unsigned int>(regionBegin[1]) };
+    const unsigned int regionSize[2] = { static_cast<unsigned int>(region.GetSize(0)), static_cast<unsigned int>(region.GetSize(1)) };
+    auto delta = SparseSliceDelta::Compute(oldContent.data(), newContent.data(), sliceDimensions, pixelSize, regionIndex, regionSize);
+
+    auto undoOperation = new DiffSliceOperation(workingImage,
+      delta,
+      SparseSliceDelta::Content::Old,
+      dynamic_cast<SlicedGeometry3D*>(sliceInfo.slice->GetGeometry()),
+      sliceInfo.timestep,
+      sliceInfo.plane);
+    auto doOperation = new DiffSliceOperation(workingImage,
+      delta,
+      SparseSliceDelta::Content::New,
+      dynamic_cast<SlicedGeometry3D*>(sliceInfo.slice->GetGeometry()),
+      sliceInfo.timestep,
+      sliceInfo.plane);
+
+    // create an operation event for the undo stack
+    OperationEvent* undoStackItem =
+      new OperationEvent(DiffSliceOperationApplier::GetInstance(), doOperation, undoOperation, "Segmentation");
+
+    // add it to the undo controller
+    UndoStackItem::IncCurrObjectEventId();
+    UndoStackItem::IncCurrGroupEventId();
+    UndoController::GetCurrentUndoModel()->SetOperationEvent(undoStackItem);
+    /*============= END undo/redo feature block ========================*/
+  }
+
+  return true;
 }
 
 
@@ -26,6 +26,8 @@ found in the LICENSE file.
 
 #include <mitkDiffSliceOperation.h>
 
+#include <itkImageRegion.h>
+
 namespace mitk
 {
   class BaseRenderer;
@@ -165,20 +167,27 @@ namespace mitk
       const mitk::PlaneGeometry *plane = nullptr;
       mitk::TimeStepType timestep = 0;
       unsigned int slicePosition;
+      /** Optional region (index coordinates of the slice) that contains all pixels in which the slice differs
+      from the working image, e.g. the bounding box of a brush stroke. If it is not empty, only this region is
+      written into the working image and compared for undo/redo. An empty region stands for the whole slice.*/
+      itk::ImageRegion<2> dirtyRegion;
 
       SliceInformation() = default;
       SliceInformation(const mitk::Image* aSlice, const mitk::PlaneGeometry* aPlane, mitk::TimeStepType aTimestep);
     };
 
     /**
-     * @brief Updates the surface interpolation by extracting the contour form the given slice.
+     * @brief Updates the surface interpolation by extracting the contours from the given slices.
+     * The contours of all slices are extracted concurrently and handed over to the SurfaceInterpolationController
+     * at once. The interpolation itself is still computed from all contours of the label.
+     * If the extraction fails for a slice, the contour that the interpolation had for it is kept. The other slices
+     * are updated nevertheless, then the exception of the first failed slice is rethrown.
      * @param sliceInfos vector of slice information instances from which the contours should be extracted
      * @param workingImage the segmentation image
      * @param detectIntersection if true the slice is eroded before contour extraction. If the slice is empty after the
+     *        erosion it is most likely an intersecting contour an will not be added to the SurfaceInterpolationController
      * @param activeLayerID The layer ID of the active label.
      * @param activeLabelValue The label value of the active label.
-     * erosion it is most
-     *        likely an intersecting contour an will not be added to the SurfaceInterpolationController
      */
     static void UpdateSurfaceInterpolation(const std::vector<SliceInformation>& sliceInfos,
       const Image* workingImage,
@@ -214,12 +223,14 @@ namespace mitk
     Image::Pointer GetAffectedReferenceSlice(const PlaneGeometry* planeGeometry, TimeStepType timeStep) const;
 
     /** Convenience version that can be called for a given event (which is used to deduce timepoint and plane) and a slice image.
-     * Calls non static WriteBackSegmentationResults*/
-    void WriteBackSegmentationResult(const InteractionPositionEvent *, const Image* segmentationResult);
+     * Calls non static WriteBackSegmentationResults. See SliceInformation::dirtyRegion for the optional region.*/
+    void WriteBackSegmentationResult(const InteractionPositionEvent *, const Image* segmentationResult,
+      const itk::ImageRegion<2>& dirtyRegion = itk::ImageRegion<2>());
 
     /** Convenience version that can be called for a given planeGeometry, slice image and time step.
-     * Calls non static WriteBackSegmentationResults*/
-    void WriteBackSegmentationResult(const PlaneGeometry *planeGeometry, const Image* segmentationResult, TimeStepType timeStep);
+     * Calls non static WriteBackSegmentationResults. See SliceInformation::dirtyRegion for the optional region.*/
+    void WriteBackSegmentationResult(const PlaneGeometry *planeGeometry, const Image* segmentationResult, TimeStepType timeStep,
+      const itk::ImageRegion<2>& dirtyRegion = itk::ImageRegion<2>());
 
     /** Overloaded version that calls the static version and also adds the contour markers.
      * @remark If the sliceList is empty, this function does nothing.*/
@@ -258,8 +269,10 @@ namespace mitk
     * @param allowUndo Indicates if undo/redo operations should be registered for the write operation
     * performed by this call. true: undo/redo will be generated; false: no undo/redo will be generated, so
     * this operation cannot be revoked by the user.
+    * @return false if it is known that the content of the working image did not change (only determined for slices
+    * with a dirty region), otherwise true.
     * @pre workingImage must point to a valid instance.*/
-    static void WriteSliceToVolume(Image* workingImage, const SliceInformation &sliceInfo, bool allowUndo);
+    static bool WriteSliceToVolume(Image* workingImage, const SliceInformation &sliceInfo, bool allowUndo);
 
     /**
       \brief Adds a new node called Contourmarker to the datastorage which holds a mitk::PlanarFigure.
@@ -285,7 +298,16 @@ namespace mitk
      * is set to be time point change aware, OnTimePointChanged() will be called.*/
     void OnTimePointChangedInternal();
 
-    static void  RemoveContourFromInterpolator(const SliceInformation& sliceInfo);
+    /** Removes the contours of the planes of the passed slices from the surface interpolation.*/
+    static void RemoveContoursFromInterpolator(const std::vector<SliceInformation>& sliceInfos);
+
+    /** Writes only the dirty region of the slice directly into the pixel buffer of the time step volume of the working image
+     * (see SliceInformation::dirtyRegion). This is only possible if the slice runs along the voxel grid of the
+     * working image, so that every slice pixel corresponds to exactly one voxel, and if the pixel types of the
+     * slice and the working image are equal.
+     * @param changed Set to true if at least one voxel was changed.
+     * @return false if the region cannot be written directly; nothing was written then.*/
+    static bool WriteSliceRegionToVolume(Image* workingImage, const SliceInformation& sliceInfo, bool allowUndo, bool& changed);
 
     // The prefix of the contourmarkername. Suffix is a consecutive number
     const std::string m_Contourmarkername;
@@ -27,6 +27,50 @@ found in the LICENSE file.
 #include "mitkPadImageFilter.h"
 #include "mitkNodePredicateGeometry.h"
 #include "mitkSegTool2D.h"
+#include "mitkImageReadAccessor.h"
+#include "mitkImageWriteAccessor.h"
+
+#include <mitkDedicatedThreads.h>
+
+#include <algorithm>
+#include <condition_variable>
+#include <cstring>
+#include <deque>
+#include <mutex>
+#include <thread>
+
+struct mitk::SegWithPreviewTool::PreviewComputation
+{
+  enum class State
+  {
+    Pending,
+    Running,
+    Finished
+  };
+
+  std::mutex Mutex;
+  std::condition_variable TimeStepFinished;
+  bool Canceled = false;
+
+  /** Results were transfered into the preview since its last Modified().*/
+  bool PreviewChanged = false;
+
+  std::vector<State> TimeSteps;
+
+  /** Pending time steps in the order they are computed by the workers.*/
+  std::deque<TimeStepType> Queue;
+  std::vector<std::thread> Workers;
+
+  /** Workers that have not returned yet. Workers of a canceled computation are only joined once it is zero.*/
+  std::size_t RunningWorkers = 0;
+
+  Image::ConstPointer Input;
+  Image::ConstPointer WorkingImage;
+  LabelSetImage::Pointer Preview;
+
+  /** Volumes of the preview, requested up front so that the workers never change the structure of the preview.*/
+  std::vector<Image::ImageDataItemPointer> PreviewVolumes;
+};
 
 mitk::SegWithPreviewTool::SegWithPreviewTool(bool lazyDynamicPreviews): Tool("dummy"), m_LazyDynamicPreviews(lazyDynamicPreviews)
 {
@@ -40,6 +84,8 @@ mitk::SegWithPreviewTool::SegWithPreviewTool(bool lazyDynamicPreviews, const cha
 
 mitk::SegWithPreviewTool::~SegWithPreviewTool()
 {
+  this->CancelPreviewComputation();
+  this->JoinCanceledPreviewComputations(true);
 }
 
 void mitk::SegWithPreviewTool::SetMergeStyle(MultiLabelSegmentation::MergeStyle mergeStyle)
@@ -135,6 +181,8 @@ void mitk::SegWithPreviewTool::Activated()
 
 void mitk::SegWithPreviewTool::Deactivated()
 {
+  this->CancelPreviewComputation();
+
   this->GetToolManager()->RoiDataChanged -=
     MessageDelegate<SegWithPreviewTool>(this, &SegWithPreviewTool::OnRoiDataChanged);
 
@@ -175,6 +223,7 @@ void mitk::SegWithPreviewTool::ConfirmSegmentation()
     this->UpdatePreview(true);
   }
 
+  this->FinishPreviewComputation();
   CreateResultSegmentationFromPreview();
 
   RenderingManager::GetInstance()->RequestUpdateAll();
@@ -253,6 +302,8 @@ void mitk::SegWithPreviewTool::ResetPreviewContentAtTimeStep(unsigned int timeSt
 
 void mitk::SegWithPreviewTool::ResetPreviewContent()
 {
+  this->CancelPreviewComputation();
+
   auto previewImage = this->GetPreviewSegmentation();
   if (nullptr != previewImage)
   {
@@ -270,6 +321,8 @@ void mitk::SegWithPreviewTool::ResetPreviewNode()
     mitkThrow() << "Used tool is implemented incorrectly. ResetPreviewNode is called while preview update is ongoing. Check implementation!";
   }
 
+  this->CancelPreviewComputation();
+
   itk::RGBPixel<float> previewColor;
   previewColor[0] = 0.0f;
   previewColor[1] = 1.0f;
@@ -553,6 +606,15 @@ void mitk::SegWithPreviewTool::OnTimePointChanged()
   {
     const auto timePoint = RenderingManager::GetInstance()->GetTimeNavigationController()->GetSelectedTimePoint();
 
+    if (nullptr != m_PreviewComputation)
+    { //the preview of the new time step is needed now, no matter which time steps are queued before it
+      const auto previewTimeGeometry = m_PreviewSegmentationNode->GetData()->GetTimeGeometry();
+      if (previewTimeGeometry->IsValidTimePoint(timePoint))
+      {
+        this->EnsurePreviewAtTimeStep(previewTimeGeometry->TimePointToTimeStep(timePoint));
+      }
+    }
+
     const bool isStaticSegOnDynamicImage = m_PreviewSegmentationNode->GetData()->GetTimeSteps() == 1 && m_SegmentationInputNode->GetData()->GetTimeSteps() > 1;
     if (timePoint!=m_LastTimePointOfUpdate && (isStaticSegOnDynamicImage || m_LazyDynamicPreviews))
     { //we only need to update either because we are lazzy
@@ -584,6 +646,9 @@ bool mitk::SegWithPreviewTool::EnsureUpToDateUserDefinedActiveLabel()
 
 void mitk::SegWithPreviewTool::UpdatePreview(bool ignoreLazyPreviewSetting)
 {
+  //results of a still running computation are outdated now
+  this->CancelPreviewComputation();
+
   const auto inputImage = this->GetSegmentationInput();
   auto previewImage = this->GetPreviewSegmentation();
   int progress_steps = 200;
@@ -606,26 +671,26 @@ void mitk::SegWithPreviewTool::UpdatePreview(bool ignoreLazyPreviewSetting)
 
       if (previewImage->GetTimeSteps() > 1 && (ignoreLazyPreviewSetting || !m_LazyDynamicPreviews))
       {
-        for (unsigned int timeStep = 0; timeStep < previewImage->GetTimeSteps(); ++timeStep)
-        {
-          Image::ConstPointer feedBackImage;
-          Image::ConstPointer currentSegImage;
-
-          auto previewTimePoint = previewImage->GetTimeGeometry()->TimeStepToTimePoint(timeStep);
-          auto inputTimeStep = inputImage->GetTimeGeometry()->TimePointToTimeStep(previewTimePoint);
-
-          if (nullptr != this->GetWorkingPlaneGeometry())
-          { //only extract a specific slice defined by the working plane as feedback referenceImage.
-            feedBackImage = SegTool2D::GetAffectedImageSliceAs2DImage(this->GetWorkingPlaneGeometry(), inputImage, inputTimeStep);
-            currentSegImage = SegTool2D::GetAffectedImageSliceAs2DImageByTimePoint(this->GetWorkingPlaneGeometry(), workingImage, previewTimePoint);
+        if (m_ConcurrentDynamicPreviews && nullptr == this->GetWorkingPlaneGeometry())
+        { //the current time step is computed directly, so that it can be shown at once; the others follow concurrently
+          const auto currentTimeStep = previewImage->GetTimeGeometry()->IsValidTimePoint(timePoint)
+            ? previewImage->GetTimeGeometry()->TimePointToTimeStep(timePoint)
+            : 0;
+
+          this->UpdatePreviewAtTimeStep(inputImage, workingImage, previewImage, currentTimeStep);
+          this->StartPreviewComputation(inputImage, workingImage, previewImage, currentTimeStep);
+
+          if (ignoreLazyPreviewSetting)
+          {
+            this->FinishPreviewComputation();
           }
-          else
-          { //work on the whole feedback referenceImage
-            feedBackImage = this->GetImageByTimeStep(inputImage, inputTimeStep);
-            currentSegImage = this->GetImageByTimePoint(workingImage, previewTimePoint);
+        }
+        else
+        {
+          for (unsigned int timeStep = 0; timeStep < previewImage->GetTimeSteps(); ++timeStep)
+          {
+            this->UpdatePreviewAtTimeStep(inputImage, workingImage, previewImage, timeStep);
           }
-
-          this->DoUpdatePreview(feedBackImage, currentSegImage, previewImage, timeStep);
         }
       }
       else
@@ -675,6 +740,267 @@ void mitk::SegWithPreviewTool::UpdatePreview(bool ignoreLazyPreviewSetting)
   CurrentlyBusy.Send(false);
 }
 
+void mitk::SegWithPreviewTool::UpdatePreviewAtTimeStep(const Image* inputImage, const Image* workingImage, LabelSetImage* previewImage, TimeStepType timeStep)
+{
+  Image::ConstPointer feedBackImage;
+  Image::ConstPointer currentSegImage;
+
+  auto previewTimePoint = previewImage->GetTimeGeometry()->TimeStepToTimePoint(timeStep);
+  auto inputTimeStep = inputImage->GetTimeGeometry()->TimePointToTimeStep(previewTimePoint);
+
+  if (nullptr != this->GetWorkingPlaneGeometry())
+  { //only extract a specific slice defined by the working plane as feedback referenceImage.
+    feedBackImage = SegTool2D::GetAffectedImageSliceAs2DImage(this->GetWorkingPlaneGeometry(), inputImage, inputTimeStep);
+    currentSegImage = SegTool2D::GetAffectedImageSliceAs2DImageByTimePoint(this->GetWorkingPlaneGeometry(), workingImage, previewTimePoint);
+  }
+  else
+  { //work on the whole feedback referenceImage
+    feedBackImage = this->GetImageByTimeStep(inputImage, inputTimeStep);
+    currentSegImage = this->GetImageByTimePoint(workingImage, previewTimePoint);
+  }
+
+  this->DoUpdatePreview(feedBackImage, currentSegImage, previewImage, timeStep);
+}
+
+void mitk::SegWithPreviewTool::StartPreviewComputation(const Image* inputImage, const Image* workingImage, LabelSetImage* previewImage, TimeStepType skippedTimeStep)
+{
+  const auto timeSteps = previewImage->GetTimeSteps();
+
+  auto computation = std::make_shared<PreviewComputation>();
+  computation->Input = inputImage;
+  computation->WorkingImage = workingImage;
+  computation->Preview = previewImage;
+  computation->TimeSteps.assign(timeSteps, PreviewComputation::State::Finished);
+
+  for (TimeStepType timeStep = 0; timeStep < timeSteps; ++timeStep)
+  {
+    computation->PreviewVolumes.push_back(previewImage->GetVolumeData(timeStep));
+
+    if (timeStep != skippedTimeStep)
+    {
+      computation->TimeSteps[timeStep] = PreviewComputation::State::Pending;
+      computation->Queue.push_back(timeStep);
+    }
+  }
+
+  if (computation->Queue.empty())
+  {
+    return;
+  }
+
+  //neighbors of the current time step first, they are most likely visited next
+  std::stable_sort(computation->Queue.begin(), computation->Queue.end(), [skippedTimeStep](TimeStepType lhs, TimeStepType rhs)
+  {
+    const auto lhsDistance = lhs < skippedTimeStep ? skippedTimeStep - lhs : lhs - skippedTimeStep;
+    const auto rhsDistance = rhs < skippedTimeStep ? skippedTimeStep - rhs : rhs - skippedTimeStep;
+    return lhsDistance < rhsDistance;
+  });
+
+  m_PreviewComputation = computation;
+
+  //the ITK filters used in DoUpdatePreview() use the ITK thread pool, see GetNumberOfDedicatedThreads()
+  const auto numberOfWorkers = GetNumberOfDedicatedThreads(computation->Queue.size());
+  computation->RunningWorkers = numberOfWorkers;
+
+  for (std::size_t i = 0; i < numberOfWorkers; ++i)
+  {
+    computation->Workers.emplace_back([this, computation]()
+    {
+      while (true)
+      {
+        TimeStepType timeStep = 0;
+
+        {
+          std::lock_guard<std::mutex> lock(computation->Mutex);
+          if (computation->Canceled || computation->Queue.empty())
+          {
+            --computation->RunningWorkers;
+            return;
+          }
+
+          timeStep = computation->Queue.front();
+          computation->Queue.pop_front();
+        }
+
+        this->ComputePreviewTask(*computation, timeStep);
+      }
+    });
+  }
+}
+
+void mitk::SegWithPreviewTool::ComputePreviewTask(PreviewComputation& computation, TimeStepType timeStep)
+{
+  {
+    std::lock_guard<std::mutex> lock(computation.Mutex);
+    if (computation.Canceled || PreviewComputation::State::Pending != computation.TimeSteps[timeStep])
+      return;
+
+    computation.TimeSteps[timeStep] = PreviewComputation::State::Running;
+  }
+
+  //DoUpdatePreview() writes into a temporary image covering only the time step, because writing into the
+  //preview (e.g. by Image::SetVolume()) would modify it and notify its observers on this thread.
+  LabelSetImage::Pointer previewAtTimeStep;
+
+  try
+  {
+    const auto previewTimePoint = computation.Preview->GetTimeGeometry()->TimeStepToTimePoint(timeStep);
+    const auto inputTimeStep = computation.Input->GetTimeGeometry()->TimePointToTimeStep(previewTimePoint);
+
+    auto feedBackImage = GetImageByTimeStep(computation.Input, inputTimeStep);
+    auto currentSegImage = GetImageByTimePoint(computation.WorkingImage, previewTimePoint);
+
+    previewAtTimeStep = LabelSetImage::New();
+    previewAtTimeStep->Initialize(computation.Preview->GetPixelType(), *(computation.Preview->GetTimeGeometry()->GetGeometryForTimeStep(timeStep)));
+
+    this->DoUpdatePreview(feedBackImage, currentSegImage, previewAtTimeStep, 0);
+  }
+  catch (const std::exception& e)
+  {
+    MITK_ERROR << "Preview of time step " << timeStep << " could not be computed: " << e.what();
+    previewAtTimeStep = nullptr;
+  }
+
+  std::unique_ptr<ImageReadAccessor> source;
+  std::unique_ptr<ImageWriteAccessor> target;
+
+  if (previewAtTimeStep.IsNotNull())
+  {
+    auto sourceVolume = previewAtTimeStep->GetVolumeData(0);
+    auto targetVolume = computation.PreviewVolumes[timeStep];
+
+    if (sourceVolume->GetSize() == targetVolume->GetSize())
+    {
+      //The accessors are acquired before the mutex, so that the mutex is never held while waiting for a lock
+      //of the preview. Holding the write accessor while checking for the cancellation also ensures that a
+      //canceled computation cannot overwrite the results of the computation that replaced it.
+      source = std::make_unique<ImageReadAccessor>(previewAtTimeStep.GetPointer(), sourceVolume);
+      target = std::make_unique<ImageWriteAccessor>(computation.Preview.GetPointer(), targetVolume);
+    }
+    else
+    {
+      MITK_ERROR << "Preview of time step " << timeStep << " has an unexpected size and is discarded.";
+    }
+  }
+
+  std::lock_guard<std::mutex> lock(computation.Mutex);
+  computation.TimeSteps[timeStep] = PreviewComputation::State::Finished;
+
+  if (!computation.Canceled && nullptr != target)
+  {
+    std::memcpy(target->GetData(), source->GetData(), computation.PreviewVolumes[timeStep]->GetSize());
+    computation.PreviewChanged = true;
+  }
+
+  computation.TimeStepFinished.notify_all();
+}
+
+void mitk::SegWithPreviewTool::EnsurePreviewAtTimeStep(TimeStepType timeStep)
+{
+  auto computation = m_PreviewComputation;
+  if (nullptr == computation || timeStep >= computation->TimeSteps.size())
+  {
+    return;
+  }
+
+  //computes the time step directly if no worker has claimed it yet
+  this->ComputePreviewTask(*computation, timeStep);
+
+  bool previewChanged = false;
+
+  {
+    std::unique_lock<std::mutex> lock(computation->Mutex);
+    computation->TimeStepFinished.wait(lock, [&computation, timeStep]()
+    {
+      return computation->Canceled || PreviewComputation::State::Finished == computation->TimeSteps[timeStep];
+    });
+
+    previewChanged = computation->PreviewChanged;
+    computation->PreviewChanged = false;
+  }
+
+  if (previewChanged)
+  {
+    computation->Preview->Modified();
+    RenderingManager::GetInstance()->RequestUpdateAll();
+  }
+}
+
+void mitk::SegWithPreviewTool::FinishPreviewComputation()
+{
+  auto computation = std::move(m_PreviewComputation);
+  m_PreviewComputation = nullptr;
+
+  if (nullptr == computation)
+  {
+    return;
+  }
+
+  for (auto& worker : computation->Workers)
+  {
+    worker.join();
+  }
+
+  if (computation->PreviewChanged)
+  {
+    computation->Preview->Modified();
+  }
+}
+
+void mitk::SegWithPreviewTool::CancelPreviewComputation()
+{
+  auto computation = std::move(m_PreviewComputation);
+  m_PreviewComputation = nullptr;
+
+  if (nullptr == computation)
+  {
+    return;
+  }
+
+  bool previewChanged = false;
+
+  {
+    std::lock_guard<std::mutex> lock(computation->Mutex);
+    computation->Canceled = true;
+    computation->Queue.clear();
+    previewChanged = computation->PreviewChanged;
+    computation->TimeStepFinished.notify_all();
+  }
+
+  //running time steps cannot be interrupted; their workers are not awaited here but return on their own
+  //and their results are discarded
+  this->JoinCanceledPreviewComputations(false);
+  m_CanceledPreviewComputations.push_back(computation);
+
+  //results that were transfered before the cancellation are valid previews of the old parameters
+  if (previewChanged)
+  {
+    computation->Preview->Modified();
+  }
+}
+
+void mitk::SegWithPreviewTool::JoinCanceledPreviewComputations(bool wait)
+{
+  auto joined = [wait](const std::shared_ptr<PreviewComputation>& computation)
+  {
+    if (!wait)
+    {
+      std::lock_guard<std::mutex> lock(computation->Mutex);
+      if (0 != computation->RunningWorkers)
+        return false;
+    }
+
+    for (auto& worker : computation->Workers)
+    {
+      worker.join();
+    }
+
+    return true;
+  };
+
+  m_CanceledPreviewComputations.erase(std::remove_if(m_CanceledPreviewComputations.begin(), m_CanceledPreviewComputations.end(), joined), m_CanceledPreviewComputations.end());
+}
+
 bool mitk::SegWithPreviewTool::IsUpdating() const
 {
   return m_IsUpdating;
@@ -19,6 +19,8 @@ found in the LICENSE file.
 #include "mitkToolCommand.h"
 #include <MitkSegmentationExports.h>
 
+#include <memory>
+
 namespace mitk
 {
   /**
@@ -31,6 +33,12 @@ namespace mitk
   This class also takes care to properly transfer a confirmed preview into the segementation
   result.
 
+  If previews of all time steps are generated (no lazy dynamic previews) and the derived tool
+  supports it (see SetConcurrentDynamicPreviews()), only the preview of the current time step is
+  computed directly. The other time steps are computed concurrently on a task pool. Changing the
+  current time point prioritizes the preview of the new time step, and a new UpdatePreview()
+  (e.g. because a parameter changed) cancels the computation of the previous one.
+
   \ingroup ToolManagerEtAl
   \sa mitk::Tool
   \sa QmitkInteractiveSegmentation
@@ -236,7 +244,45 @@ namespace mitk
     itkSetObjectMacro(WorkingPlaneGeometry, PlaneGeometry);
     itkGetConstObjectMacro(WorkingPlaneGeometry, PlaneGeometry);
 
+    /** Indicates if the previews of time steps may be computed concurrently. Derived classes may only
+    enable it if their DoUpdatePreview() is thread-safe: it must not change the state of the tool or
+    report progress. It is then called on worker threads with a temporary preview image that only
+    covers the passed time step (the time step is then always 0) and only the pixel data of this
+    image is transfered into the preview.*/
+    itkSetMacro(ConcurrentDynamicPreviews, bool);
+    itkGetConstMacro(ConcurrentDynamicPreviews, bool);
+
+    /** Cancels the concurrent computation of time step previews (see SetConcurrentDynamicPreviews()).
+    Computations that have not started yet are dropped. Running ones are not awaited; they finish in the
+    background and their results are discarded. Derived classes must call it before they change members
+    used by DoUpdatePreview(), and these members must tolerate being changed while a canceled computation
+    still reads them (e.g. by being atomic).*/
+    void CancelPreviewComputation();
+
   private:
+    struct PreviewComputation;
+
+    /** Computes the preview of a time step of a dynamic preview image directly.*/
+    void UpdatePreviewAtTimeStep(const Image* inputImage, const Image* workingImage, LabelSetImage* previewImage, TimeStepType timeStep);
+
+    /** Starts the concurrent computation of the previews of all time steps except the passed one.*/
+    void StartPreviewComputation(const Image* inputImage, const Image* workingImage, LabelSetImage* previewImage, TimeStepType skippedTimeStep);
+
+    /** Computes the preview of a time step with a temporary preview image and transfers it into the preview.
+    Does nothing if the time step was already claimed or the computation was canceled.*/
+    void ComputePreviewTask(PreviewComputation& computation, TimeStepType timeStep);
+
+    /** Ensures that the preview of the time step is up to date: computes it directly if its computation
+    has not started yet, otherwise waits for it. Calls Modified() of the preview if results were transfered.*/
+    void EnsurePreviewAtTimeStep(TimeStepType timeStep);
+
+    /** Waits until all time step previews are computed.*/
+    void FinishPreviewComputation();
+
+    /** Joins the workers of canceled computations. If wait is false, only computations whose workers
+    have already returned are joined.*/
+    void JoinCanceledPreviewComputations(bool wait);
+
     void TransferImageAtTimeStep(const Image* sourceImage, Image* destinationImage, const TimeStepType timeStep, const LabelMappingType& labelMapping);
 
     void CreateResultSegmentationFromPreview();
@@ -314,6 +360,14 @@ namespace mitk
     SelectedLabelVectorType m_SelectedLabels = {};
 
     LabelTransferMode m_LabelTransferMode = LabelTransferMode::MapLabel;
+
+    bool m_ConcurrentDynamicPreviews = false;
+
+    /** State of the running concurrent preview computation, shared with the tasks.*/
+    std::shared_ptr<PreviewComputation> m_PreviewComputation;
+
+    /** Canceled computations whose workers may still be running.*/
+    std::vector<std::shared_ptr<PreviewComputation>> m_CanceledPreviewComputations;
   };
 
 } // namespace
@@ -12,6 +12,10 @@ set(MODULE_TESTS
   mitkToolManagerProviderTest.cpp
   mitkManualSegmentationToSurfaceFilterTest.cpp #new cpp unit style
   mitkToolInteractionTest.cpp
+  mitkSparseSliceDeltaTest.cpp
+  mitkBinaryThresholdToolTest.cpp
+  mitkSegTool2DTest.cpp
+  mitkShowSegmentationAsSurfaceTest.cpp
 )
 
 set(MODULE_CUSTOM_TESTS
@@ -0,0 +1,163 @@
+/*============================================================================
+
+The Medical Imaging Interaction Toolkit (MITK)
+
+Copyright (c) German Cancer Research Center (DKFZ)
+All rights reserved.
+
+Use of this source code is governed by a 3-clause BSD license that can be
+found in the LICENSE file.
+
+============================================================================*/
+
+// Testing
+#include <mitkTestFixture.h>
+#include <mitkTestingMacros.h>
+
+// other
+#include <mitkBinaryThresholdULTool.h>
+#include <mitkImagePixelReadAccessor.h>
+#include <mitkImagePixelWriteAccessor.h>
+#include <mitkLabelSetImage.h>
+#include <mitkStandaloneDataStorage.h>
+#include <mitkToolManager.h>
+
+/** Thresholds a dynamic image with a tool that computes the previews of the time steps concurrently.*/
+class mitkBinaryThresholdToolTestSuite : public mitk::TestFixture
+{
+  CPPUNIT_TEST_SUITE(mitkBinaryThresholdToolTestSuite);
+  MITK_TEST(ConfirmSegmentation_4D_AllTimeStepsThresholded);
+  MITK_TEST(ConfirmSegmentation_4D_CanceledPreviewIsReplaced);
+  CPPUNIT_TEST_SUITE_END();
+
+private:
+  typedef unsigned short PixelType;
+
+  mitk::DataStorage::Pointer m_DataStorage;
+  mitk::ToolManager::Pointer m_ToolManager;
+  mitk::Image::Pointer m_ReferenceImage;
+  mitk::DataNode::Pointer m_WorkingNode;
+  mitk::BinaryThresholdULTool *m_Tool;
+
+  static PixelType GetReferenceValue(const itk::Index<3> &index, unsigned int timeStep)
+  {
+    return static_cast<PixelType>((index[0] + index[1] + index[2] + 5 * timeStep) % 20);
+  }
+
+  void CheckSegmentation(double lower, double upper)
+  {
+    auto segmentation = dynamic_cast<mitk::LabelSetImage *>(m_WorkingNode->GetData());
+    CPPUNIT_ASSERT(nullptr != segmentation);
+    CPPUNIT_ASSERT_EQUAL(m_ReferenceImage->GetTimeSteps(), segmentation->GetTimeSteps());
+
+    mitk::Label::PixelType labelValue = 0;
+
+    for (unsigned int t = 0; t < segmentation->GetTimeSteps(); ++t)
+    {
+      mitk::ImagePixelReadAccessor<mitk::Label::PixelType, 3> accessor(segmentation, segmentation->GetVolumeData(t));
+
+      itk::Index<3> index;
+      for (index[2] = 0; index[2] < static_cast<itk::IndexValueType>(segmentation->GetDimension(2)); ++index[2])
+        for (index[1] = 0; index[1] < static_cast<itk::IndexValueType>(segmentation->GetDimension(1)); ++index[1])
+          for (index[0] = 0; index[0] < static_cast<itk::IndexValueType>(segmentation->GetDimension(0)); ++index[0])
+          {
+            const auto referenceValue = GetReferenceValue(index, t);
+            const auto segmentationValue = accessor.GetPixelByIndex(index);
+
+            if (lower <= referenceValue && referenceValue <= upper)
+            {
+              if (0 == labelValue)
+                labelValue = segmentationValue;
+
+              CPPUNIT_ASSERT_MESSAGE("Pixel inside the thresholds is labeled in time step " + std::to_string(t),
+                                     0 != segmentationValue && labelValue == segmentationValue);
+            }
+            else
+            {
+              CPPUNIT_ASSERT_EQUAL_MESSAGE("Pixel outside the thresholds is not labeled in time step " + std::to_string(t),
+                                           mitk::Label::PixelType(0),
+                                           segmentationValue);
+            }
+          }
+    }
+  }
+
+public:
+  void setUp() override
+  {
+    unsigned int dimensions[4] = { 12, 10, 8, 6 };
+    m_ReferenceImage = mitk::Image::New();
+    m_ReferenceImage->Initialize(mitk::MakeScalarPixelType<PixelType>(), 4, dimensions);
+
+    for (unsigned int t = 0; t < dimensions[3]; ++t)
+    {
+      mitk::ImagePixelWriteAccessor<PixelType, 3> accessor(m_ReferenceImage, m_ReferenceImage->GetVolumeData(t));
+
+      itk::Index<3> index;
+      for (index[2] = 0; index[2] < static_cast<itk::IndexValueType>(dimensions[2]); ++index[2])
+        for (index[1] = 0; index[1] < static_cast<itk::IndexValueType>(dimensions[1]); ++index[1])
+          for (index[0] = 0; index[0] < static_cast<itk::IndexValueType>(dimensions[0]); ++index[0])
+            accessor.SetPixelByIndex(index, GetReferenceValue(index, t));
+    }
+
+    m_DataStorage = mitk::StandaloneDataStorage::New();
+    m_ToolManager = mitk::ToolManager::New(m_DataStorage);
+    m_ToolManager->InitializeTools();
+    m_ToolManager->RegisterClient();
+
+    const auto toolID = m_ToolManager->GetToolIdByToolType<mitk::BinaryThresholdULTool>();
+    m_Tool = dynamic_cast<mitk::BinaryThresholdULTool *>(m_ToolManager->GetToolById(toolID));
+    CPPUNIT_ASSERT(nullptr != m_Tool);
+    CPPUNIT_ASSERT_MESSAGE("Tool computes dynamic previews concurrently", m_Tool->GetConcurrentDynamicPreviews());
+
+    auto referenceNode = mitk::DataNode::New();
+    referenceNode->SetData(m_ReferenceImage);
+
+    mitk::Color color;
+    color.Set(1.0f, 0.0f, 0.0f);
+    m_WorkingNode = m_Tool->CreateEmptySegmentationNode(m_ReferenceImage, "test", color);
+    CPPUNIT_ASSERT(m_WorkingNode.IsNotNull());
+
+    m_DataStorage->Add(referenceNode);
+    m_DataStorage->Add(m_WorkingNode);
+
+    m_ToolManager->SetReferenceData(referenceNode);
+    m_ToolManager->SetWorkingData(m_WorkingNode);
+
+    m_Tool->SetCreateAllTimeSteps(true);
+    m_Tool->SetKeepActiveAfterAccept(true);
+    m_ToolManager->ActivateTool(toolID);
+    CPPUNIT_ASSERT(m_ToolManager->GetActiveTool() == m_Tool);
+  }
+
+  void tearDown() override
+  {
+    m_ToolManager->ActivateTool(-1);
+    m_ToolManager->UnregisterClient();
+    m_Tool = nullptr;
+    m_ToolManager = nullptr;
+    m_WorkingNode = nullptr;
+    m_DataStorage = nullptr;
+    m_ReferenceImage = nullptr;
+  }
+
+  void ConfirmSegmentation_4D_AllTimeStepsThresholded()
+  {
+    m_Tool->SetThresholdValues(5, 9);
+    m_Tool->ConfirmSegmentation();
+
+    this->CheckSegmentation(5, 9);
+  }
+
+  void ConfirmSegmentation_4D_CanceledPreviewIsReplaced()
+  {
+    // the second threshold cancels the concurrent computation of the first preview
+    m_Tool->SetThresholdValues(5, 9);
+    m_Tool->SetThresholdValues(10, 14);
+    m_Tool->ConfirmSegmentation();
+
+    this->CheckSegmentation(10, 14);
+  }
+};
+
+MITK_TEST_SUITE_REGISTRATION(mitkBinaryThresholdTool)
@@ -0,0 +1,225 @@
+/*============================================================================
+
+The Medical Imaging Interaction Toolkit (MITK)
+
+Copyright (c) German Cancer Research Center (DKFZ)
+All rights reserved.
+
+Use of this source code is governed by a 3-clause BSD license that can be
+found in the LICENSE file.
+
+============================================================================*/
+
+// Testing
+#include <mitkTestFixture.h>
+#include <mitkTestingMacros.h>
+
+// other
+#include <mitkExtractSliceFilter.h>
+#include <mitkImageReadAccessor.h>
+#include <mitkImageWriteAccessor.h>
+#include <mitkSegTool2D.h>
+#include <mitkSliceNavigationController.h>
+#include <mitkVtkImageOverwrite.h>
+
+#include <algorithm>
+#include <cstring>
+
+namespace
+{
+  /** Makes the slice writing of SegTool2D accessible for the test.*/
+  class SliceWriter : public mitk::SegTool2D
+  {
+  public:
+    using mitk::SegTool2D::SliceInformation;
+    using mitk::SegTool2D::WriteSliceToVolume;
+  };
+}
+
+/** Compares writing the dirty region of a slice directly into the working image with writing
+  the complete slice with mitkVtkImageOverwrite.*/
+class mitkSegTool2DTestSuite : public mitk::TestFixture
+{
+  CPPUNIT_TEST_SUITE(mitkSegTool2DTestSuite);
+  MITK_TEST(WriteSliceToVolume_3D_DirtyRegionEqualsOverwrite);
+  MITK_TEST(WriteSliceToVolume_4D_DirtyRegionEqualsOverwrite);
+  MITK_TEST(WriteSliceToVolume_MismatchedPixelType_Overwrite);
+  CPPUNIT_TEST_SUITE_END();
+
+private:
+  typedef mitk::Tool::DefaultSegmentationDataType PixelType;
+
+  static mitk::Image::Pointer CreateSegmentation(unsigned int timeSteps)
+  {
+    unsigned int dimensions[4] = { 14, 11, 9, timeSteps };
+    auto image = mitk::Image::New();
+    image->Initialize(mitk::MakeScalarPixelType<PixelType>(), timeSteps > 1 ? 4 : 3, dimensions);
+
+    for (unsigned int t = 0; t < timeSteps; ++t)
+    {
+      mitk::ImageWriteAccessor accessor(image, image->GetVolumeData(t));
+      auto data = static_cast<PixelType *>(accessor.GetData());
+
+      for (unsigned int z = 0; z < dimensions[2]; ++z)
+        for (unsigned int y = 0; y < dimensions[1]; ++y)
+          for (unsigned int x = 0; x < dimensions[0]; ++x)
+            *data++ = static_cast<PixelType>((x + 2 * y + 3 * z + t) % 3);
+    }
+
+    return image;
+  }
+
+  static void FillSliceRegion(mitk::Image *slice, const itk::ImageRegion<2> &region, PixelType value)
+  {
+    mitk::ImageWriteAccessor accessor(slice);
+    auto data = static_cast<PixelType *>(accessor.GetData());
+
+    for (auto y = region.GetIndex(1); y < region.GetIndex(1) + static_cast<itk::IndexValueType>(region.GetSize(1)); ++y)
+      for (auto x = region.GetIndex(0); x < region.GetIndex(0) + static_cast<itk::IndexValueType>(region.GetSize(0)); ++x)
+        data[y * slice->GetDimension(0) + x] = value;
+  }
+
+  static void OverwriteSlice(mitk::Image *image, const mitk::PlaneGeometry *plane, mitk::Image *slice, mitk::TimeStepType timeStep)
+  {
+    vtkSmartPointer<mitkVtkImageOverwrite> reslicer = vtkSmartPointer<mitkVtkImageOverwrite>::New();
+    reslicer->SetInputSlice(slice->GetVtkImageData());
+    reslicer->SetOverwriteMode(true);
+    reslicer->Modified();
+
+    auto extractor = mitk::ExtractSliceFilter::New(reslicer);
+    extractor->SetInput(image);
+    extractor->SetTimeStep(timeStep);
+    extractor->SetWorldGeometry(plane);
+    extractor->SetVtkOutputRequest(false);
+    extractor->SetResliceTransformByGeometry(image->GetGeometry(timeStep));
+    extractor->Modified();
+    extractor->Update();
+  }
+
+  static void CompareImages(mitk::Image *expected, mitk::Image *image, const std::string &message)
+  {
+    const auto volumeBytes = expected->GetDimension(0) * expected->GetDimension(1) * expected->GetDimension(2) * sizeof(PixelType);
+
+    for (unsigned int t = 0; t < expected->GetTimeSteps(); ++t)
+    {
+      mitk::ImageReadAccessor expectedAccessor(expected, expected->GetVolumeData(t));
+      mitk::ImageReadAccessor accessor(image, image->GetVolumeData(t));
+      CPPUNIT_ASSERT_MESSAGE(message + ", time step " + std::to_string(t),
+                             0 == std::memcmp(expectedAccessor.GetData(), accessor.GetData(), volumeBytes));
+    }
+  }
+
+  /** Selects the slice through the passed index along the axis of the view direction.*/
+  static mitk::PlaneGeometry::ConstPointer GetPlane(mitk::Image *image, mitk::AnatomicalPlane viewDirection, unsigned int dim, itk::IndexValueType sliceIndex)
+  {
+    auto navigationController = mitk::SliceNavigationController::New();
+    navigationController->SetInputWorldTimeGeometry(image->GetTimeGeometry());
+    navigationController->Update(viewDirection);
+
+    itk::Index<3> index = { { 0, 0, 0 } };
+    index[dim] = sliceIndex;
+    mitk::Point3D pointMM;
+    image->GetGeometry()->IndexToWorld(index, pointMM);
+    navigationController->SelectSliceByPoint(pointMM);
+    return navigationController->GetCurrentPlaneGeometry();
+  }
+
+  /** Writes a modified slice of the passed time step for all three view directions, once with a dirty region and
+    once completely with mitkVtkImageOverwrite. The slice written with the dirty region also differs outside of the
+    region, which must not be written.*/
+  void CheckDirtyRegionWrite(unsigned int timeSteps, mitk::TimeStepType timeStep)
+  {
+    auto segmentation = CreateSegmentation(timeSteps);
+    auto expectedSegmentation = CreateSegmentation(timeSteps);
+
+    const mitk::AnatomicalPlane viewDirections[3] = { mitk::AnatomicalPlane::Sagittal, mitk::AnatomicalPlane::Coronal, mitk::AnatomicalPlane::Axial };
+
+    itk::ImageRegion<2> dirtyRegion;
+    dirtyRegion.SetIndex(0, 2);
+    dirtyRegion.SetIndex(1, 3);
+    dirtyRegion.SetSize(0, 4);
+    dirtyRegion.SetSize(1, 5);
+
+    itk::ImageRegion<2> outsideRegion;
+    outsideRegion.SetIndex(0, 0);
+    outsideRegion.SetIndex(1, 0);
+    outsideRegion.SetSize(0, 2);
+    outsideRegion.SetSize(1, 2);
+
+    for (unsigned int dim = 0; dim < 3; ++dim)
+    {
+      const auto message = "View direction " + std::to_string(dim);
+
+      auto plane = GetPlane(segmentation, viewDirections[dim], dim, 3 + dim);
+
+      auto slice = mitk::SegTool2D::GetAffectedImageSliceAs2DImage(plane, segmentation, timeStep);
+      auto expectedSlice = mitk::SegTool2D::GetAffectedImageSliceAs2DImage(plane, expectedSegmentation, timeStep);
+      CPPUNIT_ASSERT(slice.IsNotNull() && expectedSlice.IsNotNull());
+
+      FillSliceRegion(slice, dirtyRegion, 5 + dim);
+      FillSliceRegion(slice, outsideRegion, 9);
+      FillSliceRegion(expectedSlice, dirtyRegion, 5 + dim);
+
+      SliceWriter::SliceInformation sliceInfo(slice, plane, timeStep);
+      sliceInfo.dirtyRegion = dirtyRegion;
+      CPPUNIT_ASSERT_MESSAGE(message + ": slice was changed", SliceWriter::WriteSliceToVolume(segmentation, sliceInfo, false));
+
+      OverwriteSlice(expectedSegmentation, plane, expectedSlice, timeStep);
+
+      CompareImages(expectedSegmentation, segmentation, message);
+    }
+  }
+
+public:
+  void WriteSliceToVolume_3D_DirtyRegionEqualsOverwrite()
+  {
+    this->CheckDirtyRegionWrite(1, 0);
+  }
+
+  void WriteSliceToVolume_4D_DirtyRegionEqualsOverwrite()
+  {
+    this->CheckDirtyRegionWrite(3, 1);
+  }
+
+  /** A slice whose pixel type only matches the working image in size must not be copied into the volume
+    directly; the whole slice is written with mitkVtkImageOverwrite instead.*/
+  void WriteSliceToVolume_MismatchedPixelType_Overwrite()
+  {
+    typedef short OtherPixelType;
+    static_assert(sizeof(OtherPixelType) == sizeof(PixelType), "The pixel types must only differ in the component type.");
+
+    auto segmentation = CreateSegmentation(1);
+    auto expectedSegmentation = CreateSegmentation(1);
+
+    auto plane = GetPlane(segmentation, mitk::AnatomicalPlane::Axial, 2, 4);
+    auto slice = mitk::SegTool2D::GetAffectedImageSliceAs2DImage(plane, segmentation, 0);
+    CPPUNIT_ASSERT(slice.IsNotNull());
+
+    auto otherSlice = mitk::Image::New();
+    otherSlice->Initialize(mitk::MakeScalarPixelType<OtherPixelType>(), slice->GetDimension(), slice->GetDimensions());
+    otherSlice->SetClonedTimeGeometry(slice->GetTimeGeometry());
+    CPPUNIT_ASSERT(otherSlice->GetPixelType().GetSize() == slice->GetPixelType().GetSize());
+
+    {
+      mitk::ImageWriteAccessor accessor(otherSlice);
+      auto data = static_cast<OtherPixelType *>(accessor.GetData());
+      std::fill_n(data, otherSlice->GetDimension(0) * otherSlice->GetDimension(1), static_cast<OtherPixelType>(7));
+    }
+
+    itk::ImageRegion<2> dirtyRegion;
+    dirtyRegion.SetIndex(0, 2);
+    dirtyRegion.SetIndex(1, 3);
+    dirtyRegion.SetSize(0, 4);
+    dirtyRegion.SetSize(1, 5);
+
+    SliceWriter::SliceInformation sliceInfo(otherSlice, plane, 0);
+    sliceInfo.dirtyRegion = dirtyRegion;
+    SliceWriter::WriteSliceToVolume(segmentation, sliceInfo, false);
+
+    OverwriteSlice(expectedSegmentation, plane, otherSlice, 0);
+
+    CompareImages(expectedSegmentation, segmentation, "Slice with mismatched pixel type");
+  }
+};
+
+MITK_TEST_SUITE_REGISTRATION(mitkSegTool2D)
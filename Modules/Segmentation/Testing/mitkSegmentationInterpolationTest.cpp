@@ -20,6 +20,7 @@ found in the LICENSE file.
 #include <mitkImage.h>
 #include <mitkImagePixelReadAccessor.h>
 #include <mitkImagePixelWriteAccessor.h>
+#include <mitkLabelSetImage.h>
 #include <mitkSegmentationInterpolationController.h>
 #include <mitkSliceNavigationController.h>
 #include <mitkTool.h>
@@ -31,6 +32,8 @@ class mitkSegmentationInterpolationTestSuite : public mitk::TestFixture
   MITK_TEST(Equal_Axial_TestInterpolationAndReferenceInterpolation_ReturnsTrue);
   MITK_TEST(Equal_Coronal_TestInterpolationAndReferenceInterpolation_ReturnsTrue);
   MITK_TEST(Equal_Sagittal_TestInterpolationAndReferenceInterpolation_ReturnsTrue);
+  MITK_TEST(SetSegmentationVolume_4D_AllTimeStepsScanned);
+  MITK_TEST(SetSegmentationVolume_Label_MaskReusedUntilWritten);
   CPPUNIT_TEST_SUITE_END();
 
 private:
@@ -144,6 +147,19 @@ private:
     }
   }
 
+  /** Fills a cube of 3x3x3 pixels into the passed time step of the segmentation.*/
+  static void FillCube(mitk::Image *segmentation, unsigned int timeStep, const itk::Index<3> &corner, mitk::Tool::DefaultSegmentationDataType value = 1)
+  {
+    mitk::ImagePixelWriteAccessor<mitk::Tool::DefaultSegmentationDataType, 3> writeAccessor(
+      segmentation, segmentation->GetVolumeData(timeStep));
+
+    itk::Index<3> index;
+    for (index[2] = corner[2]; index[2] < corner[2] + 3; ++index[2])
+      for (index[1] = corner[1]; index[1] < corner[1] + 3; ++index[1])
+        for (index[0] = corner[0]; index[0] < corner[0] + 3; ++index[0])
+          writeAccessor.SetPixelByIndex(index, value);
+  }
+
   mitk::Image::Pointer m_ReferenceImage;
   mitk::Image::Pointer m_SegmentationImage;
   itk::Index<3> m_CenterPoint;
@@ -199,6 +215,99 @@ public:
     mitk::AnatomicalPlane viewDirection = mitk::AnatomicalPlane::Sagittal;
     testRoutine(viewDirection);
   }
+
+  void SetSegmentationVolume_4D_AllTimeStepsScanned()
+  {
+    // Every time step is scanned by its own blocks of slices, so the scan always runs in parallel.
+    unsigned int dimensions[4] = { 20, 18, 24, 3 };
+    auto segmentation = mitk::Image::New();
+    segmentation->Initialize(mitk::MakeScalarPixelType<mitk::Tool::DefaultSegmentationDataType>(), 4, dimensions);
+
+    for (unsigned int t = 0; t < dimensions[3]; ++t)
+    {
+      mitk::ImageWriteAccessor accessor(segmentation, segmentation->GetVolumeData(t));
+      memset(accessor.GetData(), 0, dimensions[0] * dimensions[1] * dimensions[2] * sizeof(mitk::Tool::DefaultSegmentationDataType));
+    }
+
+    // Two cubes per time step, separated along every axis. Time step 2 stays empty.
+    const itk::Index<3> corners[2][2] = { { { { 1, 2, 3 } }, { { 12, 11, 15 } } }, { { { 4, 1, 0 } }, { { 15, 13, 19 } } } };
+    for (unsigned int t = 0; t < 2; ++t)
+    {
+      FillCube(segmentation, t, corners[t][0]);
+      FillCube(segmentation, t, corners[t][1]);
+    }
+
+    auto interpolationController = mitk::SegmentationInterpolationController::New();
+    interpolationController->SetSegmentationVolume(segmentation);
+
+    const mitk::AnatomicalPlane viewDirections[3] = { mitk::AnatomicalPlane::Sagittal, mitk::AnatomicalPlane::Coronal, mitk::AnatomicalPlane::Axial };
+
+    for (unsigned int dim = 0; dim < 3; ++dim)
+    {
+      auto navigationController = mitk::SliceNavigationController::New();
+      navigationController->SetInputWorldTimeGeometry(segmentation->GetTimeGeometry());
+      navigationController->Update(viewDirections[dim]);
+
+      for (unsigned int sliceIndex = 0; sliceIndex < dimensions[dim]; ++sliceIndex)
+      {
+        itk::Index<3> index = { { 0, 0, 0 } };
+        index[dim] = sliceIndex;
+        mitk::Point3D pointMM;
+        segmentation->GetGeometry()->IndexToWorld(index, pointMM);
+        navigationController->SelectSliceByPoint(pointMM);
+        auto plane = navigationController->GetCurrentPlaneGeometry();
+
+        for (unsigned int t = 0; t < dimensions[3]; ++t)
+        {
+          // only slices strictly between the two cubes of a time step can be interpolated
+          const bool expectInterpolation = t < 2 &&
+            static_cast<itk::IndexValueType>(sliceIndex) > corners[t][0][dim] + 2 &&
+            static_cast<itk::IndexValueType>(sliceIndex) < corners[t][1][dim];
+
+          auto interpolation = interpolationController->Interpolate(dim, sliceIndex, plane, t);
+          CPPUNIT_ASSERT_EQUAL_MESSAGE("Interpolation of dimension " + std::to_string(dim) + ", slice " + std::to_string(sliceIndex) +
+                                         ", time step " + std::to_string(t),
+                                       expectInterpolation,
+                                       interpolation.IsNotNull());
+        }
+      }
+    }
+  }
+
+  void SetSegmentationVolume_Label_MaskReusedUntilWritten()
+  {
+    unsigned int dimensions[3] = { 20, 18, 24 };
+    auto labeledImage = mitk::Image::New();
+    labeledImage->Initialize(mitk::MakeScalarPixelType<mitk::Tool::DefaultSegmentationDataType>(), 3, dimensions);
+    {
+      mitk::ImageWriteAccessor accessor(labeledImage);
+      memset(accessor.GetData(), 0, dimensions[0] * dimensions[1] * dimensions[2] * sizeof(mitk::Tool::DefaultSegmentationDataType));
+    }
+    FillCube(labeledImage, 0, { { 1, 2, 3 } }, 1);
+    FillCube(labeledImage, 0, { { 12, 11, 15 } }, 2);
+
+    auto labelSetImage = mitk::LabelSetImage::New();
+    labelSetImage->InitializeByLabeledImage(labeledImage);
+
+    auto interpolationController = mitk::SegmentationInterpolationController::New();
+    interpolationController->SetSegmentationVolume(labelSetImage, 1);
+    mitk::Image::ConstPointer mask = interpolationController->GetSegmentation();
+    CPPUNIT_ASSERT(mask.IsNotNull());
+
+    interpolationController->SetSegmentationVolume(labelSetImage, 2);
+    CPPUNIT_ASSERT(mask != interpolationController->GetSegmentation());
+
+    interpolationController->SetSegmentationVolume(labelSetImage, 1);
+    CPPUNIT_ASSERT_MESSAGE("Reselecting a label reuses its mask", mask == interpolationController->GetSegmentation());
+
+    {
+      // writing does not modify the label set image, but must invalidate its masks
+      mitk::ImageWriteAccessor accessor(labelSetImage);
+    }
+
+    interpolationController->SetSegmentationVolume(labelSetImage, 1);
+    CPPUNIT_ASSERT_MESSAGE("Reselecting a label after a write creates a new mask", mask != interpolationController->GetSegmentation());
+  }
 };
 
 MITK_TEST_SUITE_REGISTRATION(mitkSegmentationInterpolation)
@@ -0,0 +1,252 @@
+/*============================================================================
+
+The Medical Imaging Interaction Toolkit (MITK)
+
+Copyright (c) German Cancer Research Center (DKFZ)
+All rights reserved.
+
+Use of this source code is governed by a 3-clause BSD license that can be
+found in the LICENSE file.
+
+============================================================================*/
+
+// Testing
+#include <mitkTestFixture.h>
+#include <mitkTestingMacros.h>
+
+// other
+#include <mitkImagePixelWriteAccessor.h>
+#include <mitkLabelSetImage.h>
+#include <mitkShowSegmentationAsSurface.h>
+#include <mitkStandaloneDataStorage.h>
+
+#include <vtkCellLocator.h>
+#include <vtkGenericCell.h>
+#include <vtkMath.h>
+#include <vtkPointLocator.h>
+#include <vtkPolyData.h>
+#include <vtkSmartPointer.h>
+
+#include <cmath>
+#include <cstdlib>
+#include <map>
+
+namespace
+{
+  /** Creates the surfaces in the calling thread, as there is no GUI thread to report the result to.*/
+  class SurfaceCreator : public mitk::ShowSegmentationAsSurface
+  {
+  public:
+    mitkClassMacro(SurfaceCreator, mitk::ShowSegmentationAsSurface);
+    mitkAlgorithmNewMacro(SurfaceCreator);
+
+    void Run()
+    {
+      CPPUNIT_ASSERT(this->ReadyToRun());
+      CPPUNIT_ASSERT(this->ThreadedUpdateFunction());
+
+      // Balances the UnRegister() of NonBlockingAlgorithm::ThreadedUpdateSuccessful() like StartAlgorithm() does
+      this->Register();
+      this->ThreadedUpdateSuccessful();
+    }
+  };
+}
+
+/** Compares the surfaces of the labels of a multi-label segmentation, which are created from masks cropped
+  to the labels, with the surfaces created from masks of the complete image.*/
+class mitkShowSegmentationAsSurfaceTestSuite : public mitk::TestFixture
+{
+  CPPUNIT_TEST_SUITE(mitkShowSegmentationAsSurfaceTestSuite);
+  MITK_TEST(CroppedLabelMasks_Smoothed_EqualFullMasks);
+  MITK_TEST(CroppedLabelMasks_NotSmoothed_EqualFullMasks);
+  MITK_TEST(CroppedLabelMasks_Decimated_MatchFullMasks);
+  CPPUNIT_TEST_SUITE_END();
+
+private:
+  typedef mitk::LabelSetImage::PixelType PixelType;
+
+  mitk::LabelSetImage::Pointer m_Segmentation;
+
+  static PixelType GetLabel(const itk::Index<3> &index)
+  {
+    const auto dx = index[0] - 7, dy = index[1] - 8, dz = index[2] - 8;
+
+    // touches the image border in x, y and z
+    if (index[0] <= 4 && index[1] >= 12 && index[2] <= 6)
+      return 3;
+
+    if (index[0] >= 14 && index[0] <= 21 && index[1] >= 4 && index[1] <= 15 && index[2] >= 3 && index[2] <= 12)
+      return 2;
+
+    if (dx * dx + dy * dy + dz * dz <= 25)
+      return 1;
+
+    return 0;
+  }
+
+  /** Creates the surfaces of the passed image with the passed smoothing and decimation and returns them by node name.*/
+  static std::map<std::string, mitk::Surface::Pointer> CreateSurfaces(mitk::Image *image, bool smooth, bool decimate)
+  {
+    auto dataStorage = mitk::StandaloneDataStorage::New();
+    auto groupNode = mitk::DataNode::New();
+    groupNode->SetData(image);
+    groupNode->SetName("segmentation");
+    dataStorage->Add(groupNode);
+
+    auto surfaceCreator = SurfaceCreator::New();
+    surfaceCreator->SetDataStorage(*dataStorage);
+    surfaceCreator->SetPointerParameter("Input", image);
+    surfaceCreator->SetPointerParameter("Group node", groupNode);
+    surfaceCreator->SetParameter("Apply median", smooth);
+    surfaceCreator->SetParameter("Smooth", smooth);
+    surfaceCreator->SetParameter("Gaussian SD", 1.5);
+    surfaceCreator->SetParameter("Decimate mesh", decimate);
+    surfaceCreator->Run();
+
+    std::map<std::string, mitk::Surface::Pointer> surfaces;
+    auto derivations = dataStorage->GetDerivations(groupNode);
+
+    for (auto iter = derivations->Begin(); iter != derivations->End(); ++iter)
+      surfaces[iter->Value()->GetName()] = dynamic_cast<mitk::Surface *>(iter->Value()->GetData());
+
+    return surfaces;
+  }
+
+  static void CompareSurfaces(mitk::Surface *expected, mitk::Surface *surface, const std::string &message)
+  {
+    CPPUNIT_ASSERT_MESSAGE(message + ": surface exists", nullptr != expected && nullptr != surface);
+
+    auto *expectedPolyData = expected->GetVtkPolyData();
+    auto *polyData = surface->GetVtkPolyData();
+
+    CPPUNIT_ASSERT_MESSAGE(message + ": surface is not empty", expectedPolyData->GetNumberOfPoints() > 0);
+    CPPUNIT_ASSERT_EQUAL_MESSAGE(message + ": number of points", expectedPolyData->GetNumberOfPoints(), polyData->GetNumberOfPoints());
+    CPPUNIT_ASSERT_EQUAL_MESSAGE(message + ": number of cells", expectedPolyData->GetNumberOfCells(), polyData->GetNumberOfCells());
+
+    auto locator = vtkSmartPointer<vtkPointLocator>::New();
+    locator->SetDataSet(expectedPolyData);
+    locator->BuildLocator();
+
+    for (vtkIdType i = 0; i < polyData->GetNumberOfPoints(); ++i)
+    {
+      double point[3];
+      polyData->GetPoint(i, point);
+
+      double expectedPoint[3];
+      expectedPolyData->GetPoint(locator->FindClosestPoint(point), expectedPoint);
+
+      CPPUNIT_ASSERT_MESSAGE(message + ": position of point " + std::to_string(i),
+                             vtkMath::Distance2BetweenPoints(expectedPoint, point) < 1e-8);
+    }
+  }
+
+  /** The edge collapses of the decimation depend on rounding differences of the point positions of the
+    cropped and the complete mask. The decimated surfaces therefore only have to match geometrically.*/
+  static void CompareDecimatedSurfaces(mitk::Surface *expected, mitk::Surface *surface, const std::string &message)
+  {
+    CPPUNIT_ASSERT_MESSAGE(message + ": surface exists", nullptr != expected && nullptr != surface);
+
+    auto *expectedPolyData = expected->GetVtkPolyData();
+    auto *polyData = surface->GetVtkPolyData();
+
+    CPPUNIT_ASSERT_MESSAGE(message + ": surface is not empty", expectedPolyData->GetNumberOfCells() > 0);
+    CPPUNIT_ASSERT_MESSAGE(message + ": number of cells",
+                           std::abs(expectedPolyData->GetNumberOfCells() - polyData->GetNumberOfCells()) <=
+                             expectedPolyData->GetNumberOfCells() / 20);
+
+    AssertPointsCloseToSurface(polyData, expectedPolyData, message + ": point of the cropped surface");
+    AssertPointsCloseToSurface(expectedPolyData, polyData, message + ": point of the complete surface");
+  }
+
+  /** Each point has to be closer than one voxel to the other surface.*/
+  static void AssertPointsCloseToSurface(vtkPolyData *points, vtkPolyData *surface, const std::string &message)
+  {
+    auto locator = vtkSmartPointer<vtkCellLocator>::New();
+    locator->SetDataSet(surface);
+    locator->BuildLocator();
+
+    auto cell = vtkSmartPointer<vtkGenericCell>::New();
+
+    for (vtkIdType i = 0; i < points->GetNumberOfPoints(); ++i)
+    {
+      double point[3];
+      points->GetPoint(i, point);
+
+      double closestPoint[3];
+      vtkIdType cellId;
+      int subId;
+      double distance2;
+      locator->FindClosestPoint(point, closestPoint, cell, cellId, subId, distance2);
+
+      CPPUNIT_ASSERT_MESSAGE(message + " " + std::to_string(i), distance2 < 1.0);
+    }
+  }
+
+  void CheckCroppedLabelMasks(bool smooth, bool decimate = false)
+  {
+    const std::string suffix = smooth ? " (smoothed)" : "";
+    auto surfaces = CreateSurfaces(m_Segmentation, smooth, decimate);
+
+    CPPUNIT_ASSERT_EQUAL(std::size_t(3), surfaces.size());
+
+    for (PixelType label = 1; label <= 3; ++label)
+    {
+      const auto labelName = "object-" + std::to_string(label);
+      auto expectedSurfaces = CreateSurfaces(m_Segmentation->CreateLabelMask(label), smooth, decimate);
+
+      CPPUNIT_ASSERT_EQUAL(std::size_t(1), expectedSurfaces.size());
+
+      if (decimate)
+        CompareDecimatedSurfaces(expectedSurfaces.begin()->second, surfaces[labelName + suffix], labelName);
+      else
+        CompareSurfaces(expectedSurfaces.begin()->second, surfaces[labelName + suffix], labelName);
+    }
+  }
+
+public:
+  void setUp() override
+  {
+    unsigned int dimensions[3] = { 24, 20, 16 };
+    auto labeledImage = mitk::Image::New();
+    labeledImage->Initialize(mitk::MakeScalarPixelType<PixelType>(), 3, dimensions);
+
+    mitk::Point3D origin;
+    mitk::FillVector3D(origin, 10.0, -5.0, 3.0);
+    labeledImage->SetOrigin(origin);
+
+    {
+      mitk::ImagePixelWriteAccessor<PixelType, 3> accessor(labeledImage);
+
+      itk::Index<3> index;
+      for (index[2] = 0; index[2] < static_cast<itk::IndexValueType>(dimensions[2]); ++index[2])
+        for (index[1] = 0; index[1] < static_cast<itk::IndexValueType>(dimensions[1]); ++index[1])
+          for (index[0] = 0; index[0] < static_cast<itk::IndexValueType>(dimensions[0]); ++index[0])
+            accessor.SetPixelByIndex(index, GetLabel(index));
+    }
+
+    m_Segmentation = mitk::LabelSetImage::New();
+    m_Segmentation->InitializeByLabeledImage(labeledImage);
+  }
+
+  void tearDown() override
+  {
+    m_Segmentation = nullptr;
+  }
+
+  void CroppedLabelMasks_Smoothed_EqualFullMasks()
+  {
+    this->CheckCroppedLabelMasks(true);
+  }
+
+  void CroppedLabelMasks_NotSmoothed_EqualFullMasks()
+  {
+    this->CheckCroppedLabelMasks(false);
+  }
+
+  void CroppedLabelMasks_Decimated_MatchFullMasks()
+  {
+    this->CheckCroppedLabelMasks(true, true);
+  }
+};
+
+MITK_TEST_SUITE_REGISTRATION(mitkShowSegmentationAsSurface)
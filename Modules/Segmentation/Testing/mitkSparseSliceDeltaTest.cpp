@@ -0,0 +1,234 @@
+/*============================================================================
+
+The Medical Imaging Interaction Toolkit (MITK)
+
+Copyright (c) German Cancer Research Center (DKFZ)
+All rights reserved.
+
+Use of this source code is governed by a 3-clause BSD license that can be
+found in the LICENSE file.
+
+============================================================================*/
+
+// Testing
+#include "mitkTestFixture.h"
+#include "mitkTestingMacros.h"
+
+#include <mitkImagePixelReadAccessor.h>
+#include <mitkImagePixelWriteAccessor.h>
+#include <mitkSparseSliceDelta.h>
+
+#include <vector>
+
+class mitkSparseSliceDeltaTestSuite : public mitk::TestFixture
+{
+  CPPUNIT_TEST_SUITE(mitkSparseSliceDeltaTestSuite);
+  MITK_TEST(IdenticalSlices_EmptyDelta);
+  MITK_TEST(EditedSlice_RegionIsBoundingBox);
+  MITK_TEST(ApplyDelta_RestoresBothVersions);
+  MITK_TEST(IntermediateWrite_OnlyEditedPixelsAreRestored);
+  MITK_TEST(MismatchingSlices_NoDelta);
+  MITK_TEST(RegionContent_SameDeltaAsSlices);
+  MITK_TEST(NoisyEdit_RawRegionIsStored);
+  CPPUNIT_TEST_SUITE_END();
+
+private:
+  mitk::Image::Pointer m_OldSlice;
+  mitk::Image::Pointer m_NewSlice;
+
+  static mitk::Image::Pointer CreateSlice(unsigned int width, unsigned int height)
+  {
+    unsigned int dimensions[2] = { width, height };
+    auto slice = mitk::Image::New();
+    slice->Initialize(mitk::MakeScalarPixelType<unsigned short>(), 2, dimensions);
+
+    mitk::ImagePixelWriteAccessor<unsigned short, 2> accessor(slice);
+    itk::Index<2> index;
+    for (index[1] = 0; index[1] < static_cast<itk::IndexValueType>(height); ++index[1])
+      for (index[0] = 0; index[0] < static_cast<itk::IndexValueType>(width); ++index[0])
+        accessor.SetPixelByIndex(index, static_cast<unsigned short>(index[0] < 10 ? 1 : 0));
+
+    return slice;
+  }
+
+  static bool SlicesAreEqual(mitk::Image *slice1, mitk::Image *slice2)
+  {
+    mitk::ImagePixelReadAccessor<unsigned short, 2> accessor1(slice1);
+    mitk::ImagePixelReadAccessor<unsigned short, 2> accessor2(slice2);
+    itk::Index<2> index;
+    for (index[1] = 0; index[1] < static_cast<itk::IndexValueType>(slice1->GetDimension(1)); ++index[1])
+      for (index[0] = 0; index[0] < static_cast<itk::IndexValueType>(slice1->GetDimension(0)); ++index[0])
+        if (accessor1.GetPixelByIndex(index) != accessor2.GetPixelByIndex(index))
+          return false;
+    return true;
+  }
+
+public:
+  void setUp() override
+  {
+    m_OldSlice = CreateSlice(64, 48);
+    m_NewSlice = CreateSlice(64, 48);
+
+    // simulate a stroke: label 3 in a small region, partially overlapping label 1
+    mitk::ImagePixelWriteAccessor<unsigned short, 2> accessor(m_NewSlice);
+    itk::Index<2> index;
+    for (index[1] = 20; index[1] < 30; ++index[1])
+      for (index[0] = 5; index[0] < 25; ++index[0])
+        accessor.SetPixelByIndex(index, 3);
+  }
+
+  void tearDown() override
+  {
+    m_OldSlice = nullptr;
+    m_NewSlice = nullptr;
+  }
+
+  void IdenticalSlices_EmptyDelta()
+  {
+    auto delta = mitk::SparseSliceDelta::Compute(m_OldSlice, m_OldSlice);
+    CPPUNIT_ASSERT(nullptr != delta);
+    CPPUNIT_ASSERT(delta->IsEmpty());
+    CPPUNIT_ASSERT_EQUAL(0u, delta->GetRegionSize(0));
+
+    auto slice = CreateSlice(64, 48);
+    delta->ApplyTo(slice, mitk::SparseSliceDelta::Content::New);
+    CPPUNIT_ASSERT(SlicesAreEqual(slice, m_OldSlice));
+  }
+
+  void EditedSlice_RegionIsBoundingBox()
+  {
+    auto delta = mitk::SparseSliceDelta::Compute(m_OldSlice, m_NewSlice);
+    CPPUNIT_ASSERT(nullptr != delta);
+    CPPUNIT_ASSERT(!delta->IsEmpty());
+    CPPUNIT_ASSERT_EQUAL(5u, delta->GetRegionIndex(0));
+    CPPUNIT_ASSERT_EQUAL(20u, delta->GetRegionIndex(1));
+    CPPUNIT_ASSERT_EQUAL(20u, delta->GetRegionSize(0));
+    CPPUNIT_ASSERT_EQUAL(10u, delta->GetRegionSize(1));
+
+    // the delta of a stroke is much smaller than the slice
+    CPPUNIT_ASSERT(delta->GetMemorySize() < 64 * 48 * sizeof(unsigned short));
+  }
+
+  void ApplyDelta_RestoresBothVersions()
+  {
+    auto delta = mitk::SparseSliceDelta::Compute(m_OldSlice, m_NewSlice);
+
+    auto slice = m_OldSlice->Clone();
+    delta->ApplyTo(slice, mitk::SparseSliceDelta::Content::New);
+    CPPUNIT_ASSERT_MESSAGE("Applying the new content to the old slice yields the new slice", SlicesAreEqual(slice, m_NewSlice));
+
+    delta->ApplyTo(slice, mitk::SparseSliceDelta::Content::Old);
+    CPPUNIT_ASSERT_MESSAGE("Applying the old content to the new slice yields the old slice", SlicesAreEqual(slice, m_OldSlice));
+
+    delta->ApplyTo(slice, mitk::SparseSliceDelta::Content::Old);
+    CPPUNIT_ASSERT_MESSAGE("Applying the old content twice does not change the slice", SlicesAreEqual(slice, m_OldSlice));
+  }
+
+  void IntermediateWrite_OnlyEditedPixelsAreRestored()
+  {
+    auto delta = mitk::SparseSliceDelta::Compute(m_OldSlice, m_NewSlice);
+
+    // writes that do not go through the undo stack, outside and inside of the edited pixels
+    auto slice = m_NewSlice->Clone();
+    itk::Index<2> outsideIndex = { { 50, 40 } };
+    itk::Index<2> insideIndex = { { 12, 22 } };
+    {
+      mitk::ImagePixelWriteAccessor<unsigned short, 2> accessor(slice);
+      accessor.SetPixelByIndex(outsideIndex, 7);
+      accessor.SetPixelByIndex(insideIndex, 9);
+    }
+
+    auto expected = m_OldSlice->Clone();
+    {
+      mitk::ImagePixelWriteAccessor<unsigned short, 2> accessor(expected);
+      accessor.SetPixelByIndex(outsideIndex, 7);
+    }
+
+    delta->ApplyTo(slice, mitk::SparseSliceDelta::Content::Old);
+    CPPUNIT_ASSERT_MESSAGE("Undo restores the old values of the edited pixels and keeps other writes", SlicesAreEqual(slice, expected));
+
+    expected = m_NewSlice->Clone();
+    {
+      mitk::ImagePixelWriteAccessor<unsigned short, 2> accessor(expected);
+      accessor.SetPixelByIndex(outsideIndex, 7);
+    }
+
+    delta->ApplyTo(slice, mitk::SparseSliceDelta::Content::New);
+    CPPUNIT_ASSERT_MESSAGE("Redo restores the new values of the edited pixels and keeps other writes", SlicesAreEqual(slice, expected));
+  }
+
+  void MismatchingSlices_NoDelta()
+  {
+    auto otherSlice = CreateSlice(32, 48);
+    CPPUNIT_ASSERT(nullptr == mitk::SparseSliceDelta::Compute(m_OldSlice, otherSlice));
+    CPPUNIT_ASSERT(nullptr == mitk::SparseSliceDelta::Compute(m_OldSlice, nullptr));
+
+    auto delta = mitk::SparseSliceDelta::Compute(m_OldSlice, m_NewSlice);
+    CPPUNIT_ASSERT_THROW(delta->ApplyTo(otherSlice, mitk::SparseSliceDelta::Content::New), mitk::Exception);
+  }
+
+  void RegionContent_SameDeltaAsSlices()
+  {
+    // dirty region of the stroke, larger than the actually changed pixels
+    const unsigned int sliceDimensions[2] = { 64, 48 };
+    const unsigned int regionIndex[2] = { 0, 15 };
+    const unsigned int regionSize[2] = { 30, 20 };
+
+    std::vector<unsigned short> oldRegion, newRegion;
+    mitk::ImagePixelReadAccessor<unsigned short, 2> oldAccessor(m_OldSlice);
+    mitk::ImagePixelReadAccessor<unsigned short, 2> newAccessor(m_NewSlice);
+    itk::Index<2> index;
+    for (index[1] = regionIndex[1]; index[1] < static_cast<itk::IndexValueType>(regionIndex[1] + regionSize[1]); ++index[1])
+    {
+      for (index[0] = regionIndex[0]; index[0] < static_cast<itk::IndexValueType>(regionIndex[0] + regionSize[0]); ++index[0])
+      {
+        oldRegion.push_back(oldAccessor.GetPixelByIndex(index));
+        newRegion.push_back(newAccessor.GetPixelByIndex(index));
+      }
+    }
+
+    auto delta = mitk::SparseSliceDelta::Compute(oldRegion.data(), newRegion.data(), sliceDimensions, sizeof(unsigned short), regionIndex, regionSize);
+    CPPUNIT_ASSERT(nullptr != delta);
+    CPPUNIT_ASSERT_EQUAL(5u, delta->GetRegionIndex(0));
+    CPPUNIT_ASSERT_EQUAL(20u, delta->GetRegionIndex(1));
+    CPPUNIT_ASSERT_EQUAL(20u, delta->GetRegionSize(0));
+    CPPUNIT_ASSERT_EQUAL(10u, delta->GetRegionSize(1));
+
+    auto slice = m_OldSlice->Clone();
+    delta->ApplyTo(slice, mitk::SparseSliceDelta::Content::New);
+    CPPUNIT_ASSERT(SlicesAreEqual(slice, m_NewSlice));
+
+    const unsigned int outsideIndex[2] = { 50, 15 };
+    CPPUNIT_ASSERT(nullptr == mitk::SparseSliceDelta::Compute(oldRegion.data(), newRegion.data(), sliceDimensions, sizeof(unsigned short), outsideIndex, regionSize));
+  }
+
+  void NoisyEdit_RawRegionIsStored()
+  {
+    auto noisySlice = m_OldSlice->Clone();
+    {
+      // every pixel of the region gets a different value, so run-length encoding does not pay off
+      mitk::ImagePixelWriteAccessor<unsigned short, 2> accessor(noisySlice);
+      itk::Index<2> index;
+      for (index[1] = 10; index[1] < 40; ++index[1])
+        for (index[0] = 0; index[0] < 60; ++index[0])
+          accessor.SetPixelByIndex(index, static_cast<unsigned short>(100 + index[1] * 64 + index[0]));
+    }
+
+    auto delta = mitk::SparseSliceDelta::Compute(m_OldSlice, noisySlice);
+    CPPUNIT_ASSERT(nullptr != delta);
+    CPPUNIT_ASSERT(!delta->IsEmpty());
+    CPPUNIT_ASSERT(!delta->IsRunLengthEncoded());
+    CPPUNIT_ASSERT(delta->GetMemorySize() < sizeof(mitk::SparseSliceDelta) + 2 * 60 * 30 * sizeof(unsigned short) + 64);
+
+    auto slice = m_OldSlice->Clone();
+    delta->ApplyTo(slice, mitk::SparseSliceDelta::Content::New);
+    CPPUNIT_ASSERT(SlicesAreEqual(slice, noisySlice));
+    delta->ApplyTo(slice, mitk::SparseSliceDelta::Content::Old);
+    CPPUNIT_ASSERT(SlicesAreEqual(slice, m_OldSlice));
+
+    // the stroke of the other tests is still run-length encoded
+    CPPUNIT_ASSERT(mitk::SparseSliceDelta::Compute(m_OldSlice, m_NewSlice)->IsRunLengthEncoded());
+  }
+};
+
+MITK_TEST_SUITE_REGISTRATION(mitkSparseSliceDelta)
@@ -983,19 +983,17 @@ void QmitkSlicesInterpolator::AcceptAllInterpolations(mitk::SliceNavigationContr
         return;
       }
 
-      mitk::Image::Pointer activeLabelImage;
+      auto labelSetImage = dynamic_cast<mitk::LabelSetImage *>(m_Segmentation);
       try
       {
-        auto labelSetImage = dynamic_cast<mitk::LabelSetImage *>(m_Segmentation);
-        activeLabelImage = labelSetImage->CreateLabelMask(labelSetImage->GetActiveLabelSet()->GetActiveLabel()->GetValue(), true, 0);
+        m_Interpolator->SetSegmentationVolume(labelSetImage, labelSetImage->GetActiveLabelSet()->GetActiveLabel()->GetValue());
       }
       catch (const std::exception& e)
       {
         MITK_ERROR << e.what() << " | NO LABELSETIMAGE IN WORKING NODE\n";
+        m_Interpolator->SetSegmentationVolume(nullptr);
       }
 
-      m_Interpolator->SetSegmentationVolume(activeLabelImage);
-
       timeStep = geometry->TimePointToTimeStep(timePoint);
 
       auto timeSelector = mitk::ImageTimeSelector::New();
@@ -1413,8 +1411,7 @@ void QmitkSlicesInterpolator::OnInterpolationActivated(bool on)
       auto* segmentation = dynamic_cast<mitk::Image*>(workingNode->GetData());
       if (nullptr != activeLabel && nullptr != segmentation)
       {
-        auto activeLabelImage = labelSetImage->CreateLabelMask(activeLabel->GetValue(), true, 0);
-        m_Interpolator->SetSegmentationVolume(activeLabelImage);
+        m_Interpolator->SetSegmentationVolume(labelSetImage, activeLabel->GetValue());
 
         if (referenceNode)
         {
@@ -14,8 +14,12 @@ found in the LICENSE file.
 #include <mitkTestFixture.h>
 #include <mitkTestingMacros.h>
 
+#include <mitkImagePixelWriteAccessor.h>
 #include <mitkImageTimeSelector.h>
 #include <mitkLabelSetImage.h>
+#include <mitkNodePredicateProperty.h>
+#include <mitkProperties.h>
+#include <mitkStandaloneDataStorage.h>
 
 #include <vtkDebugLeaks.h>
 #include <vtkDoubleArray.h>
@@ -44,6 +48,8 @@ class mitkSurfaceInterpolationControllerTestSuite : public mitk::TestFixture
 
   MITK_TEST(TestAddNewContour);
   MITK_TEST(TestRemoveContour);
+  MITK_TEST(TestRemoveContours);
+  MITK_TEST(TestAddNewContoursComputesInteriorPoints);
   CPPUNIT_TEST_SUITE_END();
 
 private:
@@ -749,6 +755,159 @@ public:
         mitk::Equal(*(surf_1->GetVtkPolyData()), *(remainingContour->GetVtkPolyData()), 0.000001, true) && success);
   }
 
+  mitk::Surface::Pointer CreateContour(double center[3], double normal[3], int numberOfSides)
+  {
+    vtkSmartPointer<vtkRegularPolygonSource> p_source = vtkSmartPointer<vtkRegularPolygonSource>::New();
+    p_source->SetNumberOfSides(numberOfSides);
+    p_source->SetCenter(center);
+    p_source->SetRadius(4);
+    p_source->SetNormal(normal);
+    p_source->Update();
+    mitk::Surface::Pointer surf = mitk::Surface::New();
+    surf->SetVtkPolyData(p_source->GetOutput());
+    vtkSmartPointer<vtkIntArray> intArray = vtkSmartPointer<vtkIntArray>::New();
+    intArray->InsertNextValue(1);
+    intArray->InsertNextValue(0);
+    intArray->InsertNextValue(0);
+    surf->GetVtkPolyData()->GetFieldData()->AddArray(intArray);
+    vtkSmartPointer<vtkDoubleArray> doubleArray = vtkSmartPointer<vtkDoubleArray>::New();
+    doubleArray->InsertNextValue(center[0]);
+    doubleArray->InsertNextValue(center[1]);
+    doubleArray->InsertNextValue(center[2]);
+    surf->GetVtkPolyData()->GetFieldData()->AddArray(doubleArray);
+    return surf;
+  }
+
+  void TestRemoveContours()
+  {
+    // Create segmentation image
+    unsigned int dimensions1[] = {12, 12, 12};
+    mitk::LabelSetImage::Pointer segmentation_1 = createLabelSetImage(dimensions1);
+    m_Controller->SetCurrentInterpolationSession(segmentation_1);
+
+    // Create contours in three orthogonal planes
+    double center[3] = {4.0f, 4.0f, 4.0f};
+    double normal_1[3] = {0.0f, 1.0f, 0.0f};
+    double normal_2[3] = {1.0f, 0.0f, 0.0f};
+    double normal_3[3] = {0.0f, 0.0f, 1.0f};
+
+    std::vector<mitk::Surface::Pointer> surfaces;
+    surfaces.push_back(CreateContour(center, normal_1, 20));
+    surfaces.push_back(CreateContour(center, normal_2, 40));
+    surfaces.push_back(CreateContour(center, normal_3, 80));
+
+    std::vector<const mitk::PlaneGeometry*> planeGeometries;
+    for (size_t i = 0; i < surfaces.size(); ++i)
+      planeGeometries.push_back(GetPlaneGeometry());
+
+    m_Controller->AddNewContours(surfaces, planeGeometries, true);
+    CPPUNIT_ASSERT_MESSAGE("Wrong number of contours!", m_Controller->GetNumberOfContours() == 3);
+
+    mitk::SurfaceInterpolationController::ContourPositionInformationList contourInfos(3);
+    contourInfos[0].ContourNormal = normal_1;
+    contourInfos[0].ContourPoint = center;
+    contourInfos[1].ContourNormal = normal_3;
+    contourInfos[1].ContourPoint = center;
+    // Shifted plane, does not match any contour
+    contourInfos[2].ContourNormal = normal_2;
+    contourInfos[2].ContourPoint = center;
+    contourInfos[2].ContourPoint += 0.5;
+
+    auto numberOfRemovedContours = m_Controller->RemoveContours(contourInfos);
+    CPPUNIT_ASSERT_MESSAGE("Remove failed - wrong number of contours was removed!",
+                           (m_Controller->GetNumberOfContours() == 1) && numberOfRemovedContours == 2);
+
+    // The contour of the second plane has to remain
+    mitk::SurfaceInterpolationController::ContourPositionInformation contourInfo2;
+    contourInfo2.ContourNormal = normal_2;
+    contourInfo2.ContourPoint = center;
+    const mitk::Surface *remainingContour = m_Controller->GetContour(contourInfo2);
+    CPPUNIT_ASSERT_MESSAGE(
+      "Remove failed - contour was accidentally removed!",
+      nullptr != remainingContour &&
+        mitk::Equal(*(surfaces[1]->GetVtkPolyData()), *(remainingContour->GetVtkPolyData()), 0.000001, true));
+
+    CPPUNIT_ASSERT_MESSAGE("Removing an empty list has to be a no-op!",
+                           m_Controller->RemoveContours({}) == 0 && m_Controller->GetNumberOfContours() == 1);
+  }
+
+  void TestAddNewContoursComputesInteriorPoints()
+  {
+    // Create segmentation image with a labeled cube
+    unsigned int dimensions1[] = {12, 12, 12};
+    mitk::LabelSetImage::Pointer segmentation_1 = createLabelSetImage(dimensions1);
+    {
+      mitk::ImagePixelWriteAccessor<mitk::Label::PixelType, 3> writeAccessor(segmentation_1);
+      itk::Index<3> index;
+      for (index[2] = 3; index[2] < 9; ++index[2])
+        for (index[1] = 3; index[1] < 9; ++index[1])
+          for (index[0] = 3; index[0] < 9; ++index[0])
+            writeAccessor.SetPixelByIndex(index, 1);
+    }
+
+    // Contours that are not added by a reinitialization get plane geometry nodes in the data storage
+    auto dataStorage = mitk::StandaloneDataStorage::New();
+    auto segmentationNode = mitk::DataNode::New();
+    segmentationNode->SetData(segmentation_1);
+    dataStorage->Add(segmentationNode);
+    m_Controller->SetDataStorage(dataStorage.GetPointer());
+    m_Controller->SetCurrentInterpolationSession(segmentation_1);
+
+    // Create contours in parallel planes, so that their interior points are computed concurrently
+    double normal[3] = {0.0f, 0.0f, 1.0f};
+
+    std::vector<mitk::Surface::Pointer> surfaces;
+    std::vector<mitk::PlaneGeometry::Pointer> planes;
+    std::vector<const mitk::PlaneGeometry*> planeGeometries;
+    std::vector<mitk::Point3D> expectedInteriorPoints;
+
+    for (int i = 0; i < 4; ++i)
+    {
+      double center[3] = {5.5f, 5.5f, 2.0f + 2.0f * i};
+      surfaces.push_back(CreateContour(center, normal, 20 + 10 * i));
+      planes.push_back(GetPlaneGeometry());
+      planeGeometries.push_back(planes.back());
+
+      // the interior point that a serial computation yields
+      mitk::SurfaceInterpolationController::ContourPositionInformation contourInfo;
+      contourInfo.Contour = surfaces.back();
+      contourInfo.ContourNormal = normal;
+      contourInfo.LabelValue = 1;
+      expectedInteriorPoints.push_back(m_Controller->ComputeInteriorPointOfContour(contourInfo, segmentation_1));
+    }
+
+    m_Controller->AddNewContours(surfaces, planeGeometries, false);
+    CPPUNIT_ASSERT_MESSAGE("Wrong number of contours!", m_Controller->GetNumberOfContours() == 4);
+
+    for (size_t i = 0; i < surfaces.size(); ++i)
+    {
+      mitk::SurfaceInterpolationController::ContourPositionInformation contourInfo;
+      contourInfo.ContourNormal = normal;
+      contourInfo.ContourPoint = expectedInteriorPoints[i];
+      CPPUNIT_ASSERT_MESSAGE("Contour is not found at its interior point!",
+                             m_Controller->GetContour(contourInfo) == surfaces[i].GetPointer());
+    }
+
+    auto isContourPlaneGeometry = mitk::NodePredicateProperty::New("isContourPlaneGeometry", mitk::BoolProperty::New(true));
+    auto contourNodes = dataStorage->GetDerivations(segmentationNode, isContourPlaneGeometry);
+    CPPUNIT_ASSERT_MESSAGE("Wrong number of plane geometry nodes!", contourNodes->Size() == 4);
+
+    for (auto it = contourNodes->Begin(); it != contourNodes->End(); ++it)
+    {
+      mitk::Point3D point;
+      CPPUNIT_ASSERT(it->Value()->GetDoubleProperty("px", point[0]) && it->Value()->GetDoubleProperty("py", point[1]) &&
+                     it->Value()->GetDoubleProperty("pz", point[2]));
+
+      bool found = false;
+      for (const auto& expectedPoint : expectedInteriorPoints)
+        found = found || mitk::Equal(expectedPoint, point, 0.000001);
+
+      CPPUNIT_ASSERT_MESSAGE("Plane geometry node has an unexpected interior point!", found);
+    }
+
+    m_Controller->SetDataStorage(nullptr);
+  }
+
   bool AssertImagesEqual4D(mitk::LabelSetImage *img1, mitk::LabelSetImage *img2)
   {
     auto selector1 = mitk::ImageTimeSelector::New();
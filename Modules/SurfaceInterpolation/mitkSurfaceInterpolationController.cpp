@@ -26,10 +26,16 @@ found in the LICENSE file.
 #include <mitkPlaneGeometry.h>
 #include <mitkReduceContourSetFilter.h>
 
+#include <itkMultiThreaderBase.h>
+
 #include <vtkFieldData.h>
 #include <vtkMath.h>
 #include <vtkPolygon.h>
 
+#include <algorithm>
+#include <map>
+#include <tuple>
+
 // Check whether the given contours are coplanar
 bool ContoursCoplanar(mitk::SurfaceInterpolationController::ContourPositionInformation leftHandSide,
                       mitk::SurfaceInterpolationController::ContourPositionInformation rightHandSide)
@@ -186,35 +192,67 @@ void mitk::SurfaceInterpolationController::AddNewContours(const std::vector<mitk
     MITK_ERROR << "SurfaceInterpolationController::AddNewContours. contourPlanes and newContours are not of the same size.";
   }
 
-  for (size_t i = 0; i < newContours.size(); ++i)
+  const auto numberOfContours = std::min(newContours.size(), contourPlanes.size());
+
+  std::vector<size_t> nonEmptyContours;
+  nonEmptyContours.reserve(numberOfContours);
+
+  for (size_t i = 0; i < numberOfContours; ++i)
+  {
+    if (newContours[i]->GetVtkPolyData()->GetNumberOfPoints() > 0)
+      nonEmptyContours.push_back(i);
+  }
+
+  if (nonEmptyContours.empty())
+    return;
+
+  // The position information of the contours is independent of each other and only reads the
+  // segmentation, so it is computed for all contours of the batch in parallel.
+  ContourPositionInformationList contourInfos(nonEmptyContours.size());
+  auto labelSetImage = dynamic_cast<mitk::LabelSetImage*>(m_SelectedSegmentation);
+
+  auto computeContourInfo = [&](itk::SizeValueType i)
   {
-    const auto &newContour = newContours[i];
+    const auto contourIndex = nonEmptyContours[i];
+    auto contourInfo = CreateContourPositionInformation(newContours[contourIndex], contourPlanes[contourIndex]);
 
-    const mitk::PlaneGeometry * planeGeometry = contourPlanes[i];
-    if (newContour->GetVtkPolyData()->GetNumberOfPoints() > 0)
+    if (!reinitializationAction)
     {
-      auto contourInfo = CreateContourPositionInformation(newContour, planeGeometry);
-      if (!reinitializationAction)
-      {
-        contourInfo.ContourPoint = this->ComputeInteriorPointOfContour(contourInfo,
-                                              dynamic_cast<mitk::LabelSetImage*>(m_SelectedSegmentation) );
-      }
-      else
-      {
-        auto vtkPolyData = contourInfo.Contour->GetVtkPolyData();
-        auto pointVtkArray = vtkDoubleArray::SafeDownCast(vtkPolyData->GetFieldData()->GetAbstractArray(1));
-        mitk::ScalarType *ptArr = new mitk::ScalarType[3];
-        for (int i = 0; i < pointVtkArray->GetSize(); ++i)
-          ptArr[i] = pointVtkArray->GetValue(i);
-
-        mitk::Point3D pt3D;
-        pt3D.FillPoint(ptArr);
-        contourInfo.ContourPoint = pt3D;
-      }
+      contourInfo.ContourPoint = this->ComputeInteriorPointOfContour(contourInfo, labelSetImage);
+    }
+    else
+    {
+      auto vtkPolyData = contourInfo.Contour->GetVtkPolyData();
+      auto pointVtkArray = vtkDoubleArray::SafeDownCast(vtkPolyData->GetFieldData()->GetAbstractArray(1));
 
-      this->AddToInterpolationPipeline(contourInfo, reinitializationAction);
+      mitk::Point3D pt3D;
+      for (int j = 0; j < 3 && j < pointVtkArray->GetSize(); ++j)
+        pt3D[j] = pointVtkArray->GetValue(j);
+
+      contourInfo.ContourPoint = pt3D;
     }
+
+    contourInfos[i] = contourInfo;
+  };
+
+  if (1 == contourInfos.size())
+  {
+    computeContourInfo(0);
   }
+  else
+  {
+    auto threader = itk::MultiThreaderBase::New();
+    threader->ParallelizeArray(0, contourInfos.size(), computeContourInfo, nullptr);
+  }
+
+  // The contour lists are shared, so the contours are added sequentially. The plane geometry
+  // nodes of all contours are updated afterwards with a single lookup in the data storage.
+  ContourPositionInformationList planeGeometryContours;
+
+  for (auto& contourInfo : contourInfos)
+    this->AddToInterpolationPipeline(contourInfo, reinitializationAction, &planeGeometryContours);
+
+  this->AddPlaneGeometryNodesToDataStorage(planeGeometryContours);
   this->Modified();
 }
 
@@ -240,81 +278,95 @@ mitk::DataNode* mitk::SurfaceInterpolationController::GetSegmentationImageNode()
 
 void mitk::SurfaceInterpolationController::AddPlaneGeometryNodeToDataStorage(const ContourPositionInformation& contourInfo)
 {
-  auto planeGeometry = contourInfo.Plane;
-  auto planeGeometryData = mitk::PlanarCircle::New();
-  planeGeometryData->SetPlaneGeometry(planeGeometry);
-  mitk::Point2D p1;
-  planeGeometry->Map(planeGeometry->GetCenter(), p1);
-  planeGeometryData->PlaceFigure(p1);
-  planeGeometryData->SetCurrentControlPoint(p1);
-  planeGeometryData->SetProperty("initiallyplaced", mitk::BoolProperty::New(true));
-  if (planeGeometry)
-  {
-    auto segmentationNode = this->GetSegmentationImageNode();
-    auto isContourPlaneGeometry = mitk::NodePredicateProperty::New("isContourPlaneGeometry", mitk::BoolProperty::New(true));
-
-    mitk::DataStorage::SetOfObjects::ConstPointer contourNodes =
-      m_DataStorage->GetDerivations(segmentationNode, isContourPlaneGeometry);
-
-    auto contourFound = false;
-
-    //  Go through the pre-existing contours and check if the contour position matches them.
-    for (auto it = contourNodes->Begin(); it != contourNodes->End(); ++it)
-    {
-      auto layerID = dynamic_cast<mitk::UIntProperty *>(it->Value()->GetProperty("layerID"))->GetValue();
-      auto labelID = dynamic_cast<mitk::UShortProperty *>(it->Value()->GetProperty("labelID"))->GetValue();
-      auto posID = dynamic_cast<mitk::IntProperty *>(it->Value()->GetProperty("position"))->GetValue();
-      bool sameLayer = (layerID == contourInfo.LayerValue);
-      bool sameLabel = (labelID == contourInfo.LabelValue);
-      bool samePos = (posID == contourInfo.Pos);
-
-      if (samePos & sameLabel & sameLayer)
-      {
-        contourFound = true;
-        it->Value()->SetData(planeGeometryData);
-        break;
-      }
-    }
+  this->AddPlaneGeometryNodesToDataStorage({ contourInfo });
+}
 
-    if (!m_SelectedSegmentation->GetTimeGeometry()->IsValidTimePoint(m_CurrentTimePoint))
-    {
-      MITK_ERROR << "Invalid time point requested in AddPlaneGeometryNodeToDataStorage.";
-      return;
-    }
+void mitk::SurfaceInterpolationController::AddPlaneGeometryNodesToDataStorage(const ContourPositionInformationList& contourInfos)
+{
+  if (contourInfos.empty())
+    return;
 
-    const auto currentTimeStep = m_SelectedSegmentation->GetTimeGeometry()->TimePointToTimeStep(m_CurrentTimePoint);
+  if (!m_SelectedSegmentation->GetTimeGeometry()->IsValidTimePoint(m_CurrentTimePoint))
+  {
+    MITK_ERROR << "Invalid time point requested in AddPlaneGeometryNodesToDataStorage.";
+    return;
+  }
 
-    //  Go through the contourPlaneGeometry Data and add the segmentationNode to it.
-    if (!contourFound)
-    {
-      std::string contourName = "contourPlane " + std::to_string(m_ContourIndex);
+  const auto currentTimeStep = m_SelectedSegmentation->GetTimeGeometry()->TimePointToTimeStep(m_CurrentTimePoint);
 
-      auto contourPlaneGeometryDataNode = mitk::DataNode::New();
-      contourPlaneGeometryDataNode->SetData(planeGeometryData);
+  auto segmentationNode = this->GetSegmentationImageNode();
+  auto isContourPlaneGeometry = mitk::NodePredicateProperty::New("isContourPlaneGeometry", mitk::BoolProperty::New(true));
 
-      //  No need to change properties
-      contourPlaneGeometryDataNode->SetProperty("helper object", mitk::BoolProperty::New(false));
-      contourPlaneGeometryDataNode->SetProperty("hidden object", mitk::BoolProperty::New(true));
-      contourPlaneGeometryDataNode->SetProperty("isContourPlaneGeometry", mitk::BoolProperty::New(true));
-      contourPlaneGeometryDataNode->SetVisibility(false);
+  mitk::DataStorage::SetOfObjects::ConstPointer contourNodes =
+    m_DataStorage->GetDerivations(segmentationNode, isContourPlaneGeometry);
 
-      //  Need to change properties
-      contourPlaneGeometryDataNode->SetProperty("name", mitk::StringProperty::New(contourName) );
-      contourPlaneGeometryDataNode->SetProperty("layerID", mitk::UIntProperty::New(contourInfo.LayerValue));
-      contourPlaneGeometryDataNode->SetProperty("labelID", mitk::UShortProperty::New(contourInfo.LabelValue));
-      contourPlaneGeometryDataNode->SetProperty("position", mitk::IntProperty::New(contourInfo.Pos));
-      contourPlaneGeometryDataNode->SetProperty("timeStep", mitk::IntProperty::New(currentTimeStep));
+  //  Index the pre-existing contours by layer, label and position once for the whole batch.
+  using ContourNodeKey = std::tuple<unsigned int, mitk::Label::PixelType, int>;
+  std::map<ContourNodeKey, mitk::DataNode*> contourNodeMap;
 
-      contourPlaneGeometryDataNode->SetProperty("px", mitk::DoubleProperty::New(contourInfo.ContourPoint[0]));
-      contourPlaneGeometryDataNode->SetProperty("py", mitk::DoubleProperty::New(contourInfo.ContourPoint[1]));
-      contourPlaneGeometryDataNode->SetProperty("pz", mitk::DoubleProperty::New(contourInfo.ContourPoint[2]));
+  for (auto it = contourNodes->Begin(); it != contourNodes->End(); ++it)
+  {
+    auto layerID = dynamic_cast<mitk::UIntProperty *>(it->Value()->GetProperty("layerID"))->GetValue();
+    auto labelID = dynamic_cast<mitk::UShortProperty *>(it->Value()->GetProperty("labelID"))->GetValue();
+    auto posID = dynamic_cast<mitk::IntProperty *>(it->Value()->GetProperty("position"))->GetValue();
+    contourNodeMap.emplace(ContourNodeKey(layerID, labelID, posID), it->Value());
+  }
+
+  for (const auto& contourInfo : contourInfos)
+  {
+    auto planeGeometry = contourInfo.Plane;
+
+    if (nullptr == planeGeometry)
+      continue;
 
-      m_DataStorage->Add(contourPlaneGeometryDataNode, segmentationNode);
+    auto planeGeometryData = mitk::PlanarCircle::New();
+    planeGeometryData->SetPlaneGeometry(planeGeometry);
+    mitk::Point2D p1;
+    planeGeometry->Map(planeGeometry->GetCenter(), p1);
+    planeGeometryData->PlaceFigure(p1);
+    planeGeometryData->SetCurrentControlPoint(p1);
+    planeGeometryData->SetProperty("initiallyplaced", mitk::BoolProperty::New(true));
+
+    const ContourNodeKey key(contourInfo.LayerValue, contourInfo.LabelValue, contourInfo.Pos);
+    auto finding = contourNodeMap.find(key);
+
+    //  The contour position matches a pre-existing contour.
+    if (finding != contourNodeMap.end())
+    {
+      finding->second->SetData(planeGeometryData);
+      continue;
     }
+
+    std::string contourName = "contourPlane " + std::to_string(m_ContourIndex);
+
+    auto contourPlaneGeometryDataNode = mitk::DataNode::New();
+    contourPlaneGeometryDataNode->SetData(planeGeometryData);
+
+    //  No need to change properties
+    contourPlaneGeometryDataNode->SetProperty("helper object", mitk::BoolProperty::New(false));
+    contourPlaneGeometryDataNode->SetProperty("hidden object", mitk::BoolProperty::New(true));
+    contourPlaneGeometryDataNode->SetProperty("isContourPlaneGeometry", mitk::BoolProperty::New(true));
+    contourPlaneGeometryDataNode->SetVisibility(false);
+
+    //  Need to change properties
+    contourPlaneGeometryDataNode->SetProperty("name", mitk::StringProperty::New(contourName) );
+    contourPlaneGeometryDataNode->SetProperty("layerID", mitk::UIntProperty::New(contourInfo.LayerValue));
+    contourPlaneGeometryDataNode->SetProperty("labelID", mitk::UShortProperty::New(contourInfo.LabelValue));
+    contourPlaneGeometryDataNode->SetProperty("position", mitk::IntProperty::New(contourInfo.Pos));
+    contourPlaneGeometryDataNode->SetProperty("timeStep", mitk::IntProperty::New(currentTimeStep));
+
+    contourPlaneGeometryDataNode->SetProperty("px", mitk::DoubleProperty::New(contourInfo.ContourPoint[0]));
+    contourPlaneGeometryDataNode->SetProperty("py", mitk::DoubleProperty::New(contourInfo.ContourPoint[1]));
+    contourPlaneGeometryDataNode->SetProperty("pz", mitk::DoubleProperty::New(contourInfo.ContourPoint[2]));
+
+    m_DataStorage->Add(contourPlaneGeometryDataNode, segmentationNode);
+    contourNodeMap.emplace(key, contourPlaneGeometryDataNode.GetPointer());
   }
 }
 
-void mitk::SurfaceInterpolationController::AddToInterpolationPipeline(ContourPositionInformation& contourInfo, bool reinitializationAction)
+void mitk::SurfaceInterpolationController::AddToInterpolationPipeline(ContourPositionInformation& contourInfo,
+                                                                      bool reinitializationAction,
+                                                                      ContourPositionInformationList* planeGeometryContours)
 {
   if (!m_SelectedSegmentation)
     return;
@@ -394,7 +446,10 @@ void mitk::SurfaceInterpolationController::AddToInterpolationPipeline(ContourPos
 
     if (!reinitializationAction)
     {
-      this->AddPlaneGeometryNodeToDataStorage(contourInfo);
+      if (nullptr != planeGeometryContours)
+        planeGeometryContours->push_back(contourInfo);
+      else
+        this->AddPlaneGeometryNodeToDataStorage(contourInfo);
     }
     return;
   }
@@ -413,7 +468,10 @@ void mitk::SurfaceInterpolationController::AddToInterpolationPipeline(ContourPos
   }
   if (!reinitializationAction)
   {
-    this->AddPlaneGeometryNodeToDataStorage(contourInfo);
+    if (nullptr != planeGeometryContours)
+      planeGeometryContours->push_back(contourInfo);
+    else
+      this->AddPlaneGeometryNodeToDataStorage(contourInfo);
   }
 
   if (newContour->GetVtkPolyData()->GetNumberOfPoints() == 0)
@@ -428,14 +486,19 @@ void mitk::SurfaceInterpolationController::AddToInterpolationPipeline(ContourPos
 
 bool mitk::SurfaceInterpolationController::RemoveContour(ContourPositionInformation contourInfo)
 {
-  if (!m_SelectedSegmentation)
+  return this->RemoveContours(ContourPositionInformationList({ contourInfo })) > 0;
+}
+
+unsigned int mitk::SurfaceInterpolationController::RemoveContours(const ContourPositionInformationList& contourInfos)
+{
+  if (!m_SelectedSegmentation || contourInfos.empty())
   {
-    return false;
+    return 0;
   }
 
   if (!m_SelectedSegmentation->GetTimeGeometry()->IsValidTimePoint(m_CurrentTimePoint))
   {
-    return false;
+    return 0;
   }
 
   const auto currentTimeStep = m_SelectedSegmentation->GetTimeGeometry()->TimePointToTimeStep(m_CurrentTimePoint);
@@ -449,19 +512,26 @@ bool mitk::SurfaceInterpolationController::RemoveContour(ContourPositionInformat
     MITK_ERROR << e.what() << '\n';
   }
 
-  auto it = m_ListOfContours.at(m_SelectedSegmentation).at(currentTimeStep).at(currentLayerID).begin();
-  while (it != m_ListOfContours.at(m_SelectedSegmentation).at(currentTimeStep).at(currentLayerID).end())
+  auto& currentContourList = m_ListOfContours.at(m_SelectedSegmentation).at(currentTimeStep).at(currentLayerID);
+  unsigned int numberOfRemovedContours = 0;
+
+  for (const auto& contourInfo : contourInfos)
   {
-    const ContourPositionInformation &currentContour = (*it);
-    if (ContoursCoplanar(currentContour, contourInfo))
+    auto it = std::find_if(currentContourList.begin(), currentContourList.end(),
+      [&contourInfo](const ContourPositionInformation& currentContour) { return ContoursCoplanar(currentContour, contourInfo); });
+
+    if (it != currentContourList.end())
     {
-      m_ListOfContours.at(m_SelectedSegmentation).at(currentTimeStep).at(currentLayerID).erase(it);
-      this->ReinitializeInterpolation();
-      return true;
+      currentContourList.erase(it);
+      ++numberOfRemovedContours;
     }
-    ++it;
   }
-  return false;
+
+  //  The interpolation is reinitialized once for the whole batch.
+  if (numberOfRemovedContours > 0)
+    this->ReinitializeInterpolation();
+
+  return numberOfRemovedContours;
 }
 
 const mitk::Surface *mitk::SurfaceInterpolationController::GetContour(const ContourPositionInformation &contourInfo)
@@ -309,6 +309,15 @@ namespace mitk
      */
     bool RemoveContour(ContourPositionInformation contourInfo);
 
+    /**
+     * @brief Removes the contours for the given planes for the current selected segmentation.
+     *        In contrast to calling RemoveContour() for every plane, the interpolation is only
+     *        reinitialized once.
+     * @param contourInfos the contours which should be removed
+     * @return the number of contours that were found and removed
+     */
+    unsigned int RemoveContours(const ContourPositionInformationList& contourInfos);
+
     /**
      * @brief Get the Segmentation Image Node object
      *
@@ -352,6 +361,14 @@ namespace mitk
      */
     void AddPlaneGeometryNodeToDataStorage(const ContourPositionInformation& contourInfo);
 
+    /**
+     * @brief Batch version of AddPlaneGeometryNodeToDataStorage(). The pre-existing plane geometry
+     *        nodes are only looked up once for all passed contours.
+     *
+     * @param contourInfos contourInfo structs to add to data storage.
+     */
+    void AddPlaneGeometryNodesToDataStorage(const ContourPositionInformationList& contourInfos);
+
     /**
      * @brief Function that toggles active label, when the active label is changed.
      *
@@ -369,8 +386,12 @@ namespace mitk
      *
      * @param contourInfo Contour information to be added
      * @param reinitializationAction If the contour is coming from a reinitialization process or not
+     * @param planeGeometryContours If set, the contour is appended to this list instead of adding its plane
+     *        geometry node to the data storage right away (see AddPlaneGeometryNodesToDataStorage())
      */
-    void AddToInterpolationPipeline(ContourPositionInformation& contourInfo, bool reinitializationAction = false);
+    void AddToInterpolationPipeline(ContourPositionInformation& contourInfo,
+                                    bool reinitializationAction = false,
+                                    ContourPositionInformationList* planeGeometryContours = nullptr);
 
     /**
      * @brief Function to respond to layer changed